@@ -0,0 +1,637 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h> // Only the _pch include should start with DCPS/
+
+#include "AsyncLogger.h"
+
+#ifdef ACE_HAS_CPP11
+
+#include "GuidConverter.h"
+#include "LogAddr.h"
+#include "Service_Participant.h"
+#include "debug.h"
+
+#include <ace/ACE.h>
+#include <ace/Log_Record.h>
+#include <ace/OS_NS_errno.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_Thread.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  Atomic<size_t> next_logger_id(0);
+}
+
+AsyncLogger async_logger;
+
+const size_t AsyncLogRecord::MAX_ARGS;
+const size_t AsyncLogRecord::TEXT_SIZE;
+const size_t AsyncLogRecord::MAX_GUIDS;
+const size_t AsyncLogRecord::MAX_ADDRESSES;
+const size_t AsyncLogger::DEFAULT_RING_SIZE;
+
+namespace {
+
+  template <typename T>
+  void append_formatted(String& out, const char* spec, T value)
+  {
+    char buffer[128];
+    const int len = ACE_OS::snprintf(buffer, sizeof buffer, spec, value);
+    if (len < 0) {
+      return;
+    }
+    if (static_cast<size_t>(len) < sizeof buffer) {
+      out.append(buffer, len);
+      return;
+    }
+    // Only a large width or precision gets here.
+    OPENDDS_VECTOR(char) large(len + 1);
+    ACE_OS::snprintf(&large[0], large.size(), spec, value);
+    out.append(&large[0], len);
+  }
+
+  class ArgCursor {
+  public:
+    ArgCursor(const AsyncLogRecord& record)
+      : record_(record)
+      , next_(0)
+    {}
+
+    const AsyncLogArg* next()
+    {
+      return next_ < record_.arg_count ? &record_.args[next_++] : 0;
+    }
+
+    ACE_INT64 next_signed()
+    {
+      const AsyncLogArg* const arg = next();
+      if (!arg) {
+        return 0;
+      }
+      switch (arg->kind) {
+      case AsyncLogArg::KIND_SIGNED:
+        return arg->signed_value;
+      case AsyncLogArg::KIND_UNSIGNED:
+        return static_cast<ACE_INT64>(arg->unsigned_value);
+      case AsyncLogArg::KIND_DOUBLE:
+        return static_cast<ACE_INT64>(arg->double_value);
+      default:
+        return 0;
+      }
+    }
+
+    ACE_UINT64 next_unsigned()
+    {
+      return static_cast<ACE_UINT64>(next_signed());
+    }
+
+    double next_double()
+    {
+      const AsyncLogArg* const arg = next();
+      if (!arg) {
+        return 0;
+      }
+      switch (arg->kind) {
+      case AsyncLogArg::KIND_DOUBLE:
+        return arg->double_value;
+      case AsyncLogArg::KIND_SIGNED:
+        return static_cast<double>(arg->signed_value);
+      case AsyncLogArg::KIND_UNSIGNED:
+        return static_cast<double>(arg->unsigned_value);
+      default:
+        return 0;
+      }
+    }
+
+    /// The result is valid until the next call.
+    const char* next_string()
+    {
+      const AsyncLogArg* const arg = next();
+      if (!arg) {
+        return "(null)";
+      }
+      switch (arg->kind) {
+      case AsyncLogArg::KIND_STRING:
+        return record_.text + arg->string_offset;
+      case AsyncLogArg::KIND_GUID:
+        if (arg->object_index < record_.guid_count) {
+          scratch_ = LogGuid(record_.guids[arg->object_index]).conv_;
+          return scratch_.c_str();
+        }
+        return "(null)";
+      case AsyncLogArg::KIND_ADDRESS:
+        if (arg->object_index < record_.address_count) {
+          scratch_ = LogAddr(record_.addresses[arg->object_index]).str();
+          return scratch_.c_str();
+        }
+        return "(null)";
+      default:
+        return "(null)";
+      }
+    }
+
+    const void* next_pointer()
+    {
+      const AsyncLogArg* const arg = next();
+      if (!arg) {
+        return 0;
+      }
+      return arg->kind == AsyncLogArg::KIND_POINTER ? arg->pointer_value : 0;
+    }
+
+  private:
+    const AsyncLogRecord& record_;
+    size_t next_;
+    String scratch_;
+  };
+
+  size_t round_up_to_power_of_two(size_t value)
+  {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  bool is_integer_conversion(char c)
+  {
+    return c && ACE_OS::strchr("diouxX", c);
+  }
+}
+
+void AsyncLogRecord::start(ACE_Log_Priority p, const char* f)
+{
+  priority = p;
+  format = f;
+  time = ACE_OS::gettimeofday();
+  error = ACE_ERRNO_GET;
+  arg_count = 0;
+  text_size = 0;
+  guid_count = 0;
+  address_count = 0;
+}
+
+AsyncLogArg* AsyncLogRecord::next(AsyncLogArg::Kind kind)
+{
+  if (arg_count == MAX_ARGS) {
+    return 0;
+  }
+  AsyncLogArg* const arg = &args[arg_count++];
+  arg->kind = kind;
+  return arg;
+}
+
+void AsyncLogRecord::add(const char* value)
+{
+  AsyncLogArg* const arg = next(AsyncLogArg::KIND_STRING);
+  if (!arg) {
+    return;
+  }
+  if (!value) {
+    value = "(null)";
+  }
+  // Strings that don't fit are truncated, and once the text is full each
+  // one shares the terminator at the end.
+  const size_t space = TEXT_SIZE - 1 - text_size;
+  size_t len = 0;
+  while (len < space && value[len]) {
+    ++len;
+  }
+  arg->string_offset = text_size;
+  ACE_OS::memcpy(text + text_size, value, len);
+  text_size += len;
+  text[text_size] = 0;
+  if (text_size < TEXT_SIZE - 1) {
+    ++text_size;
+  }
+}
+
+#ifdef ACE_HAS_WCHAR
+void AsyncLogRecord::add(const wchar_t* value)
+{
+  add(value ? ACE_Wide_To_Ascii(value).char_rep() : static_cast<const char*>(0));
+}
+#endif
+
+void AsyncLogRecord::add(const void* value)
+{
+  if (AsyncLogArg* const arg = next(AsyncLogArg::KIND_POINTER)) {
+    arg->pointer_value = value;
+  }
+}
+
+void AsyncLogRecord::add(const GUID_t& value)
+{
+  AsyncLogArg* const arg = next(AsyncLogArg::KIND_GUID);
+  if (!arg) {
+    return;
+  }
+  arg->object_index = guid_count;
+  if (guid_count < MAX_GUIDS) {
+    guids[guid_count++] = value;
+  }
+}
+
+void AsyncLogRecord::add(const NetworkAddress& value)
+{
+  AsyncLogArg* const arg = next(AsyncLogArg::KIND_ADDRESS);
+  if (!arg) {
+    return;
+  }
+  arg->object_index = address_count;
+  if (address_count < MAX_ADDRESSES) {
+    addresses[address_count++] = value;
+  }
+}
+
+void AsyncLogRecord::add(const ACE_INET_Addr& value)
+{
+  AsyncLogArg* const arg = next(AsyncLogArg::KIND_ADDRESS);
+  if (!arg) {
+    return;
+  }
+  arg->object_index = address_count;
+  if (address_count < MAX_ADDRESSES) {
+    addresses[address_count++] = value;
+  }
+}
+
+void AsyncLogRecord::format_to(String& out, const char* thread_id) const
+{
+  ArgCursor cursor(*this);
+  char spec[32];
+
+  for (const char* f = format; *f; ++f) {
+    if (*f != '%') {
+      out += *f;
+      continue;
+    }
+
+    const char* const spec_begin = f++;
+    size_t spec_len = 0;
+    spec[spec_len++] = '%';
+
+    // Flags, width, and precision are passed on to snprintf.  A '*' takes
+    // its value from the arguments.
+    while (*f && ACE_OS::strchr("-+ #0", *f) && spec_len < sizeof spec - 8) {
+      spec[spec_len++] = *f++;
+    }
+    for (int part = 0; part < 2; ++part) {
+      if (part == 1) {
+        if (*f != '.') {
+          break;
+        }
+        spec[spec_len++] = *f++;
+      }
+      if (*f == '*') {
+        spec_len += ACE_OS::snprintf(spec + spec_len, sizeof spec - spec_len - 8,
+                                     "%d", static_cast<int>(cursor.next_signed()));
+        ++f;
+      } else {
+        while (*f >= '0' && *f <= '9' && spec_len < sizeof spec - 8) {
+          spec[spec_len++] = *f++;
+        }
+      }
+    }
+
+    // Length modifiers are dropped since arguments are stored as 64 bits.
+    // In ACE %l alone is the line number, so 'l' is only a modifier when
+    // an integer conversion follows.
+    while ((*f == 'l' && (f[1] == 'l' || is_integer_conversion(f[1]))) ||
+           (*f == 'L' && f[1] && ACE_OS::strchr("diouxXeEfFgG", f[1])) ||
+           (*f == 'h' || *f == 'z' || *f == 'j')) {
+      ++f;
+    }
+
+    const char conversion = *f;
+    spec[spec_len] = 0;
+    switch (conversion) {
+    case '%':
+      out += '%';
+      break;
+    case 'd':
+    case 'i':
+    case 'q':
+    case 'b':
+      ACE_OS::strcpy(spec + spec_len, "lld");
+      append_formatted(out, spec, static_cast<long long>(cursor.next_signed()));
+      break;
+    case 'u':
+    case 'Q':
+    case 'B':
+      ACE_OS::strcpy(spec + spec_len, "llu");
+      append_formatted(out, spec, static_cast<unsigned long long>(cursor.next_unsigned()));
+      break;
+    case 'o':
+    case 'x':
+    case 'X':
+      spec[spec_len++] = 'l';
+      spec[spec_len++] = 'l';
+      spec[spec_len++] = conversion;
+      spec[spec_len] = 0;
+      append_formatted(out, spec, static_cast<unsigned long long>(cursor.next_unsigned()));
+      break;
+    case 'c':
+      ACE_OS::strcpy(spec + spec_len, "c");
+      append_formatted(out, spec, static_cast<int>(cursor.next_signed()));
+      break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'A':
+      spec[spec_len++] = conversion == 'A' ? 'f' : conversion;
+      spec[spec_len] = 0;
+      append_formatted(out, spec, cursor.next_double());
+      break;
+    case 'C':
+    case 's':
+      ACE_OS::strcpy(spec + spec_len, "s");
+      append_formatted(out, spec, cursor.next_string());
+      break;
+    case '@':
+      ACE_OS::strcpy(spec + spec_len, "p");
+      append_formatted(out, spec, cursor.next_pointer());
+      break;
+    case 'p':
+      out += cursor.next_string();
+      out += ": ";
+      out += ACE_OS::strerror(error);
+      break;
+    case 'm':
+      out += ACE_OS::strerror(error);
+      break;
+    case 'P':
+      ACE_OS::strcpy(spec + spec_len, "d");
+      append_formatted(out, spec, static_cast<int>(ACE_OS::getpid()));
+      break;
+    case 't':
+      ACE_OS::strcpy(spec + spec_len, "s");
+      append_formatted(out, spec, thread_id);
+      break;
+    case 'D':
+    case 'T':
+      {
+        ACE_TCHAR timestamp[AceTimestampSize];
+        const ACE_TCHAR* const s =
+          ACE::timestamp(time, timestamp, AceTimestampSize, conversion == 'T');
+        if (s) {
+          out += ACE_TEXT_ALWAYS_CHAR(s);
+        }
+      }
+      break;
+    case 'M':
+      out += ACE_TEXT_ALWAYS_CHAR(ACE_Log_Record::priority_name(priority));
+      break;
+    case 'n':
+      {
+        const ACE_TCHAR* const name = ACE_Log_Msg::program_name();
+        out += name ? ACE_TEXT_ALWAYS_CHAR(name) : "<unknown>";
+      }
+      break;
+    default:
+      // Not something that can be deferred, keep it as written.
+      if (!conversion) {
+        out.append(spec_begin, f - spec_begin);
+        return;
+      }
+      out.append(spec_begin, f - spec_begin + 1);
+      break;
+    }
+  }
+}
+
+AsyncLogRing::AsyncLogRing(size_t capacity, const char* thread_id)
+  : records_(round_up_to_power_of_two(capacity))
+  , mask_(records_.size() - 1)
+  , head_(0)
+  , tail_(0)
+  , dropped_(0)
+{
+  ACE_OS::strsncpy(thread_id_, thread_id, sizeof thread_id_);
+}
+
+AsyncLogger::AsyncLogger()
+  : id_(++next_logger_id)
+  , condition_(mutex_)
+  , running_(false)
+  , stopping_(false)
+  , ring_size_(DEFAULT_RING_SIZE)
+  , removed_dropped_(0)
+  , reported_dropped_(0)
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  stop();
+}
+
+bool AsyncLogger::start(size_t ring_size, const TimeDuration& flush_interval)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (thread_) {
+    return false;
+  }
+  ring_size_ = ring_size ? ring_size : DEFAULT_RING_SIZE;
+  flush_interval_ = flush_interval;
+  stopping_ = false;
+  thread_.reset(new ThreadPool(1, run, this));
+  running_ = true;
+  return true;
+}
+
+void AsyncLogger::stop()
+{
+  unique_ptr<ThreadPool> thread;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    running_ = false;
+    stopping_ = true;
+    condition_.notify_all();
+    thread = move(thread_);
+  }
+  thread.reset();
+  flush();
+}
+
+AsyncLogger::Stats AsyncLogger::stats() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(flush_mutex_);
+  return stats_;
+}
+
+AsyncLogRing* AsyncLogger::thread_ring()
+{
+  // Loggers are told apart by id rather than address since a new one can
+  // reuse the address of one that was destroyed.
+  struct ThreadRing {
+    ThreadRing()
+      : owner(0)
+    {}
+
+    size_t owner;
+    AsyncLogRing_rch ring;
+  };
+  static thread_local ThreadRing current;
+
+  if (current.owner != id_) {
+    char thread_id[32];
+    ACE_OS::thr_id(thread_id, sizeof thread_id);
+    AsyncLogRing_rch ring = make_rch<AsyncLogRing>(ring_size_.load(), thread_id);
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(rings_mutex_);
+      rings_.push_back(ring);
+    }
+    current.ring = move(ring);
+    current.owner = id_;
+  }
+  return current.ring.get();
+}
+
+ACE_THR_FUNC_RETURN AsyncLogger::run(void* arg)
+{
+  static_cast<AsyncLogger*>(arg)->run_i();
+  return 0;
+}
+
+void AsyncLogger::run_i()
+{
+  ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
+  ThreadStatusManager::Start s(thread_status_manager, "AsyncLogger");
+
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  while (!stopping_) {
+    condition_.wait_until(MonotonicTimePoint::now() + flush_interval_, thread_status_manager);
+    guard.release();
+    flush();
+    guard.acquire();
+  }
+}
+
+namespace {
+  struct EarlierRecord {
+    template <typename Pending>
+    bool operator()(const Pending& x, const Pending& y) const
+    {
+      return x.record->time < y.record->time;
+    }
+  };
+}
+
+void AsyncLogger::flush()
+{
+  ACE_Guard<ACE_Thread_Mutex> flush_guard(flush_mutex_);
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(rings_mutex_);
+    flush_rings_ = rings_;
+  }
+
+  // Collect what each ring has now.  Records written after this are left
+  // for the next flush.
+  pending_.clear();
+  flush_counts_.resize(flush_rings_.size());
+  size_t dropped = 0;
+  for (size_t i = 0; i < flush_rings_.size(); ++i) {
+    const AsyncLogRing& ring = *flush_rings_[i];
+    size_t first = 0;
+    flush_counts_[i] = ring.available(first);
+    for (size_t j = 0; j < flush_counts_[i]; ++j) {
+      const Pending p = {&ring.at(first + j), &ring};
+      pending_.push_back(p);
+    }
+    dropped += ring.dropped();
+  }
+
+  std::stable_sort(pending_.begin(), pending_.end(), EarlierRecord());
+  for (size_t i = 0; i < pending_.size(); ++i) {
+    write(*pending_[i].record, pending_[i].ring->thread_id());
+  }
+
+  for (size_t i = 0; i < flush_rings_.size(); ++i) {
+    flush_rings_[i]->release(flush_counts_[i]);
+  }
+
+  stats_.logged += pending_.size();
+  pending_.clear();
+  flush_rings_.clear();
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(rings_mutex_);
+    // Forget rings whose threads have exited, which leaves rings_ with the
+    // only reference, once they are empty.
+    for (size_t i = 0; i < rings_.size();) {
+      size_t first = 0;
+      if (rings_[i]->ref_count() == 1 && rings_[i]->available(first) == 0) {
+        removed_dropped_ += rings_[i]->dropped();
+        dropped -= rings_[i]->dropped();
+        rings_.erase(rings_.begin() + i);
+      } else {
+        ++i;
+      }
+    }
+    stats_.threads = rings_.size();
+  }
+
+  stats_.dropped = removed_dropped_ + dropped;
+  if (stats_.dropped > reported_dropped_) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: AsyncLogger::flush: "
+                 "dropped %B message(s) because a thread's log ring was full\n",
+                 stats_.dropped - reported_dropped_));
+    }
+    reported_dropped_ = stats_.dropped;
+  }
+}
+
+namespace {
+  void write_record(const AsyncLogRecord& record, const char* thread_id, String& buffer)
+  {
+    buffer.clear();
+    record.format_to(buffer, thread_id);
+
+    ACE_Log_Record log_record(record.priority, record.time, static_cast<long>(ACE_OS::getpid()));
+    log_record.msg_data(ACE_TEXT_CHAR_TO_TCHAR(buffer.c_str()));
+    ACE_Log_Msg::instance()->log(log_record);
+  }
+}
+
+void AsyncLogger::write(const AsyncLogRecord& record, const char* thread_id)
+{
+  // The priority was checked against the logging thread's ACE_Log_Msg when
+  // the record was made, so the mask of this thread doesn't apply.
+  write_record(record, thread_id, buffer_);
+}
+
+void AsyncLogger::write_now(const AsyncLogRecord& record)
+{
+  char thread_id[32];
+  ACE_OS::thr_id(thread_id, sizeof thread_id);
+  String buffer;
+  write_record(record, thread_id, buffer);
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_CPP11 */
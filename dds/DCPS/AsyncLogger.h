@@ -0,0 +1,373 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_ASYNC_LOGGER_H
+#define OPENDDS_DCPS_ASYNC_LOGGER_H
+
+#include "Definitions.h"
+#include "dcps_export.h"
+
+#include <ace/Log_Msg.h>
+
+#ifdef ACE_HAS_CPP11
+#  include "Atomic.h"
+#  include "ConditionVariable.h"
+#  include "GuidUtils.h"
+#  include "NetworkAddress.h"
+#  include "PoolAllocator.h"
+#  include "RcObject.h"
+#  include "ThreadPool.h"
+#  include "TimeTypes.h"
+#  include "unique_ptr.h"
+
+#  include <ace/Log_Priority.h>
+#  include <ace/Thread_Mutex.h>
+#  include <ace/Time_Value.h>
+
+#  include <type_traits>
+#else
+#  include "GuidConverter.h"
+#  include "LogAddr.h"
+#endif
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+/**
+ * Log a message like ACE_DEBUG, but if the asynchronous logger is running
+ * only record the format string and arguments on the calling thread and
+ * leave formatting and output to the logger's thread.  The format string
+ * must outlive the logger, so it should be a literal.  GUIDs and addresses
+ * wrapped in OPENDDS_ASYNC_LOG_GUID and OPENDDS_ASYNC_LOG_ADDR are printed
+ * by %C and are only converted to text when the message is formatted.
+ *
+ *   if (log_level >= LogLevel::Debug) {
+ *     OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) Foo::bar: %C %C %d\n",
+ *                        OPENDDS_ASYNC_LOG_GUID(guid), name.c_str(), count));
+ *   }
+ */
+#ifdef ACE_HAS_CPP11
+#  define OPENDDS_ASYNC_LOG(X) \
+  do { \
+    if (OpenDDS::DCPS::async_logger.running()) { \
+      OpenDDS::DCPS::async_logger.log X; \
+    } else { \
+      OpenDDS::DCPS::AsyncLogger::log_now X; \
+    } \
+  } while (0)
+#  define OPENDDS_ASYNC_LOG_GUID(G) (G)
+#  define OPENDDS_ASYNC_LOG_ADDR(A) (A)
+#else
+#  define OPENDDS_ASYNC_LOG(X) ACE_DEBUG(X)
+#  define OPENDDS_ASYNC_LOG_GUID(G) OpenDDS::DCPS::LogGuid(G).c_str()
+#  define OPENDDS_ASYNC_LOG_ADDR(A) OpenDDS::DCPS::LogAddr(A).c_str()
+#endif
+
+#ifdef ACE_HAS_CPP11
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// One unformatted argument of an AsyncLogRecord.
+struct AsyncLogArg {
+  enum Kind {
+    KIND_SIGNED,
+    KIND_UNSIGNED,
+    KIND_DOUBLE,
+    KIND_STRING,
+    KIND_POINTER,
+    KIND_GUID,
+    KIND_ADDRESS
+  };
+
+  Kind kind;
+  union {
+    ACE_INT64 signed_value;
+    ACE_UINT64 unsigned_value;
+    double double_value;
+    size_t string_offset; ///< Offset into AsyncLogRecord::text
+    const void* pointer_value;
+    size_t object_index; ///< Index into AsyncLogRecord::guids or addresses
+  };
+};
+
+/**
+ * A log message as recorded by the logging thread: the format string, which
+ * identifies the message, and its arguments.  Strings are copied into the
+ * record since they are usually temporaries.  GUIDs and addresses are kept
+ * in binary form.  Arguments past MAX_ARGS and string bytes past TEXT_SIZE
+ * are dropped, and GUIDs past MAX_GUIDS and addresses past MAX_ADDRESSES
+ * print as "(null)".
+ */
+struct OpenDDS_Dcps_Export AsyncLogRecord {
+  static const size_t MAX_ARGS = 12;
+  static const size_t TEXT_SIZE = 256;
+  static const size_t MAX_GUIDS = 4;
+  static const size_t MAX_ADDRESSES = 2;
+
+  ACE_Log_Priority priority;
+  const char* format;
+  ACE_Time_Value time;
+  int error;
+  size_t arg_count;
+  size_t text_size;
+  size_t guid_count;
+  size_t address_count;
+  AsyncLogArg args[MAX_ARGS];
+  char text[TEXT_SIZE];
+  GUID_t guids[MAX_GUIDS];
+  NetworkAddress addresses[MAX_ADDRESSES];
+
+  void start(ACE_Log_Priority p, const char* f);
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+  add(T value)
+  {
+    if (AsyncLogArg* const arg = next(AsyncLogArg::KIND_SIGNED)) {
+      arg->signed_value = value;
+    }
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+  add(T value)
+  {
+    if (AsyncLogArg* const arg = next(AsyncLogArg::KIND_UNSIGNED)) {
+      arg->unsigned_value = value;
+    }
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_enum<T>::value>::type
+  add(T value)
+  {
+    if (AsyncLogArg* const arg = next(AsyncLogArg::KIND_SIGNED)) {
+      arg->signed_value = static_cast<ACE_INT64>(value);
+    }
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  add(T value)
+  {
+    if (AsyncLogArg* const arg = next(AsyncLogArg::KIND_DOUBLE)) {
+      arg->double_value = static_cast<double>(value);
+    }
+  }
+
+  void add(const char* value);
+#ifdef ACE_HAS_WCHAR
+  void add(const wchar_t* value);
+#endif
+  void add(const void* value);
+  void add(const GUID_t& value);
+  void add(const NetworkAddress& value);
+  void add(const ACE_INET_Addr& value);
+
+  /// Append the formatted message to out, handling the conversions that
+  /// ACE_Log_Msg does.  thread_id is what %t prints.
+  void format_to(String& out, const char* thread_id) const;
+
+private:
+  AsyncLogArg* next(AsyncLogArg::Kind kind);
+};
+
+/**
+ * Single-producer single-consumer ring of records.  The producer is the
+ * thread that owns it and the consumer is AsyncLogger::flush.  When the
+ * ring is full new records are counted and dropped.
+ */
+class OpenDDS_Dcps_Export AsyncLogRing : public virtual RcObject {
+public:
+  AsyncLogRing(size_t capacity, const char* thread_id);
+
+  /// Returns the record to fill in or null if the ring is full.
+  AsyncLogRecord* begin_write()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return 0;
+    }
+    return &records_[head & mask_];
+  }
+
+  void end_write()
+  {
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// Number of records ready for the consumer, starting at first.
+  size_t available(size_t& first) const
+  {
+    first = tail_.load(std::memory_order_relaxed);
+    return head_.load(std::memory_order_acquire) - first;
+  }
+
+  const AsyncLogRecord& at(size_t index) const
+  {
+    return records_[index & mask_];
+  }
+
+  void release(size_t count)
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  size_t capacity() const { return mask_ + 1; }
+  const char* thread_id() const { return thread_id_; }
+
+private:
+  OPENDDS_VECTOR(AsyncLogRecord) records_;
+  const size_t mask_;
+  Atomic<size_t> head_;
+  Atomic<size_t> tail_;
+  Atomic<size_t> dropped_;
+  char thread_id_[32];
+};
+
+typedef RcHandle<AsyncLogRing> AsyncLogRing_rch;
+
+/**
+ * Asynchronous logging backend.
+ *
+ * Logging threads write records into their own AsyncLogRing without taking
+ * a lock or formatting anything.  A background thread wakes up every flush
+ * interval, formats the pending records of all threads in time order, and
+ * passes them to ACE_Log_Msg, so output goes wherever ACE logging is
+ * configured to go.  Use it through OPENDDS_ASYNC_LOG, which falls back to
+ * ACE_DEBUG when the logger isn't running.  The global instance is
+ * controlled by DCPSLogAsync.
+ */
+class OpenDDS_Dcps_Export AsyncLogger {
+public:
+  static const size_t DEFAULT_RING_SIZE = 256;
+
+  struct Stats {
+    Stats()
+      : logged(0)
+      , dropped(0)
+      , threads(0)
+    {}
+
+    size_t logged;
+    size_t dropped;
+    size_t threads;
+  };
+
+  AsyncLogger();
+  ~AsyncLogger();
+
+  /// Start the background thread.  ring_size is the number of records
+  /// each thread can have pending and applies to threads that haven't
+  /// logged through this logger yet.
+  bool start(size_t ring_size = DEFAULT_RING_SIZE,
+             const TimeDuration& flush_interval = TimeDuration::from_msec(10));
+
+  /// Stop the background thread and write any pending records.
+  void stop();
+
+  bool running() const { return running_.load(std::memory_order_relaxed); }
+
+  /// Format and write all pending records on the calling thread.
+  void flush();
+
+  /// Counts as of the last flush.
+  Stats stats() const;
+
+  /// Record a message for the logger's thread.  The priority is checked
+  /// against the calling thread's ACE_Log_Msg.
+  template <typename... Args>
+  void log(ACE_Log_Priority priority, const char* format, const Args&... args)
+  {
+    if (!ACE_LOG_MSG->log_priority_enabled(priority)) {
+      return;
+    }
+    AsyncLogRing* const ring = thread_ring();
+    AsyncLogRecord* const record = ring ? ring->begin_write() : 0;
+    if (record) {
+      record->start(priority, format);
+      capture(*record, args...);
+      ring->end_write();
+    }
+  }
+
+  /// Format and write a message on the calling thread.  Used when no
+  /// logger is running so that the same arguments can be passed.
+  template <typename... Args>
+  static void log_now(ACE_Log_Priority priority, const char* format, const Args&... args)
+  {
+    if (!ACE_LOG_MSG->log_priority_enabled(priority)) {
+      return;
+    }
+    AsyncLogRecord record;
+    record.start(priority, format);
+    capture(record, args...);
+    write_now(record);
+  }
+
+private:
+  static void capture(AsyncLogRecord&) {}
+
+  template <typename T, typename... Rest>
+  static void capture(AsyncLogRecord& record, const T& first, const Rest&... rest)
+  {
+    record.add(first);
+    capture(record, rest...);
+  }
+
+  AsyncLogRing* thread_ring();
+
+  static ACE_THR_FUNC_RETURN run(void* arg);
+  void run_i();
+
+  void write(const AsyncLogRecord& record, const char* thread_id);
+  static void write_now(const AsyncLogRecord& record);
+
+  const size_t id_;
+  mutable ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> condition_;
+  unique_ptr<ThreadPool> thread_;
+  Atomic<bool> running_;
+  bool stopping_;
+  Atomic<size_t> ring_size_;
+  TimeDuration flush_interval_;
+
+  /// Protects rings_.  Only taken when a thread logs for the first time.
+  mutable ACE_Thread_Mutex rings_mutex_;
+  OPENDDS_VECTOR(AsyncLogRing_rch) rings_;
+
+  /// Serializes consumers and protects the members below it.
+  mutable ACE_Thread_Mutex flush_mutex_;
+  struct Pending {
+    const AsyncLogRecord* record;
+    const AsyncLogRing* ring;
+  };
+  OPENDDS_VECTOR(AsyncLogRing_rch) flush_rings_;
+  OPENDDS_VECTOR(size_t) flush_counts_;
+  OPENDDS_VECTOR(Pending) pending_;
+  String buffer_;
+  Stats stats_;
+  size_t removed_dropped_;
+  size_t reported_dropped_;
+};
+
+extern OpenDDS_Dcps_Export AsyncLogger async_logger;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* ACE_HAS_CPP11 */
+
+#endif /* OPENDDS_DCPS_ASYNC_LOGGER_H */
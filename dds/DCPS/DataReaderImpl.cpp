@@ -86,6 +86,9 @@ DataReaderImpl::DataReaderImpl()
   , statistics_enabled_(false)
   , raw_latency_buffer_size_(0)
   , raw_latency_buffer_type_(DataCollector<double>::KeepOldest)
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  , query_generation_(0)
+#endif
   , transport_disabled_(false)
   , mb_alloc_(DEFAULT_TRANSPORT_RECEIVE_BUFFERS)
 {
@@ -787,6 +790,18 @@ DDS::QueryCondition_ptr DataReaderImpl::create_querycondition(
     }
     DDS::ReadCondition_var rc = DDS::ReadCondition::_duplicate(qc);
     read_conditions_.insert(rc);
+
+    QueryConditionImpl* const qci = dynamic_cast<QueryConditionImpl*>(qc.in());
+    size_t slot = 0;
+    while (slot < query_conditions_.size() && query_conditions_[slot]) {
+      ++slot;
+    }
+    if (slot == query_conditions_.size()) {
+      query_conditions_.push_back(qci);
+    } else {
+      query_conditions_[slot] = qci;
+    }
+    qci->attach(slot);
     return qc._retn();
   } catch (const std::exception& e) {
     if (DCPS_debug_level) {
@@ -812,18 +827,68 @@ DDS::ReturnCode_t DataReaderImpl::delete_readcondition(
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->sample_lock_,
       DDS::RETCODE_OUT_OF_RESOURCES);
   DDS::ReadCondition_var rc = DDS::ReadCondition::_duplicate(a_condition);
-  return read_conditions_.erase(rc)
-      ? DDS::RETCODE_OK : DDS::RETCODE_PRECONDITION_NOT_MET;
+  if (!read_conditions_.erase(rc)) {
+    return DDS::RETCODE_PRECONDITION_NOT_MET;
+  }
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  detach_query_condition(a_condition);
+#endif
+  return DDS::RETCODE_OK;
 }
 
 DDS::ReturnCode_t DataReaderImpl::delete_contained_entities()
 {
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->sample_lock_,
       DDS::RETCODE_OUT_OF_RESOURCES);
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  for (ReadConditionSet::iterator it = read_conditions_.begin(); it != read_conditions_.end(); ++it) {
+    detach_query_condition(it->in());
+  }
+#endif
   read_conditions_.clear();
   return DDS::RETCODE_OK;
 }
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+void DataReaderImpl::detach_query_condition(DDS::ReadCondition_ptr condition)
+{
+  //sample lock already held
+  QueryConditionImpl* const qci = dynamic_cast<QueryConditionImpl*>(condition);
+  if (!qci) {
+    return;
+  }
+  for (size_t slot = 0; slot < query_conditions_.size(); ++slot) {
+    if (query_conditions_[slot] == qci) {
+      query_conditions_[slot] = 0;
+      qci->detach();
+      break;
+    }
+  }
+  while (!query_conditions_.empty() && !query_conditions_.back()) {
+    query_conditions_.pop_back();
+  }
+}
+
+void DataReaderImpl::query_conditions_sample_added(ReceivedDataElement* sample)
+{
+  for (size_t slot = 0; slot < query_conditions_.size(); ++slot) {
+    if (query_conditions_[slot]) {
+      query_conditions_[slot]->sample_added(sample);
+    }
+  }
+}
+
+void DataReaderImpl::query_conditions_sample_removed(ReceivedDataElement* sample)
+{
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
+  for (size_t slot = 0; slot < query_conditions_.size(); ++slot) {
+    if (query_conditions_[slot]) {
+      query_conditions_[slot]->sample_removed(sample);
+    }
+  }
+}
+#endif
+
 DDS::ReturnCode_t DataReaderImpl::set_qos(const DDS::DataReaderQos& qos)
 {
   OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE_COMPATIBILITY_CHECK(qos, DDS::RETCODE_UNSUPPORTED);
@@ -1729,6 +1794,33 @@ bool DataReaderImpl::contains_sample(DDS::SampleStateMask sample_states,
   return lookup_matching_instances(sample_states, view_states, instance_states).size();
 }
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+bool DataReaderImpl::contains_sample_filtered(DDS::SampleStateMask sample_states,
+    DDS::ViewStateMask view_states, DDS::InstanceStateMask instance_states,
+    QueryConditionImpl& condition)
+{
+  ACE_Guard<ACE_Recursive_Thread_Mutex> sample_guard(sample_lock_);
+  ACE_Guard<ACE_Recursive_Thread_Mutex> instance_guard(instances_lock_);
+
+  const HandleSet& matches = lookup_matching_instances(sample_states, view_states, instance_states);
+  for (HandleSet::const_iterator it = matches.begin(), next = it; it != matches.end(); it = next) {
+    ++next; // pre-increment iterator, in case updates cause changes to match set
+    const SubscriptionInstance_rch inst = get_handle_instance(*it);
+    if (!inst) continue;
+
+    for (ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0); item;
+         item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
+      // Uses the result kept with the sample when the query hasn't changed.
+      if (condition.filter(item)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+#endif
+
 DDS::DataReaderListener_ptr
 DataReaderImpl::listener_for(DDS::StatusKind kind)
 {
@@ -3563,7 +3655,7 @@ const DataReaderImpl::HandleSet& DataReaderImpl::lookup_matching_instances(CORBA
   return ci->second;
 }
 
-void DataReaderImpl::schedule_deadline(SubscriptionInstance_rch instance,
+void DataReaderImpl::schedule_deadline(const SubscriptionInstance_rch& instance,
                                        bool timer_called)
 {
   // Should be called with sample_lock_.
@@ -3583,7 +3675,7 @@ void DataReaderImpl::schedule_deadline(SubscriptionInstance_rch instance,
   }
 }
 
-void DataReaderImpl::cancel_deadline(SubscriptionInstance_rch instance)
+void DataReaderImpl::cancel_deadline(const SubscriptionInstance_rch& instance)
 {
   // Should be called with sample_lock_.
   if (instance->deadline_ != MonotonicTimePoint::zero_value) {
@@ -3597,7 +3689,7 @@ void DataReaderImpl::cancel_deadline(SubscriptionInstance_rch instance)
   }
 }
 
-void DataReaderImpl::process_deadline(SubscriptionInstance_rch instance,
+void DataReaderImpl::process_deadline(const SubscriptionInstance_rch& instance,
                                       const MonotonicTimePoint& now,
                                       bool timer_called)
 {
@@ -3695,7 +3787,7 @@ void DataReaderImpl::reset_deadline_period(const TimeDuration& deadline_period)
   }
 }
 
-void DataReaderImpl::reschedule_deadline(SubscriptionInstance_rch instance,
+void DataReaderImpl::reschedule_deadline(const SubscriptionInstance_rch& instance,
                                          const MonotonicTimePoint& now)
 {
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
@@ -3731,7 +3823,8 @@ void DataReaderImpl::deadline_task(const MonotonicTimePoint& now)
 
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
   for (DeadlineQueue::iterator pos = deadline_queue_.begin(), limit = deadline_queue_.end(); pos != limit && pos->first <= now;) {
-    SubscriptionInstance_rch instance = pos->second;
+    SubscriptionInstance_rch instance;
+    instance.swap(pos->second);
     deadline_queue_.erase(pos++);
     // pos is no longer valid.
     process_deadline(instance, now, true);
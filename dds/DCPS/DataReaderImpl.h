@@ -72,6 +72,7 @@ class TopicDescriptionImpl;
 class Monitor;
 class DataReaderImpl;
 class FilterEvaluator;
+class QueryConditionImpl;
 
 typedef Cached_Allocator_With_Overflow<ReceivedDataElementMemoryBlock, ACE_Thread_Mutex>
 ReceivedDataAllocator;
@@ -372,12 +373,18 @@ public:
                        DDS::ViewStateMask view_states,
                        DDS::InstanceStateMask instance_states);
 
-#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
-  virtual bool contains_sample_filtered(DDS::SampleStateMask sample_states,
-                                        DDS::ViewStateMask view_states,
-                                        DDS::InstanceStateMask instance_states,
-                                        const FilterEvaluator& evaluator,
-                                        const DDS::StringSeq& params) = 0;
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  bool contains_sample_filtered(DDS::SampleStateMask sample_states,
+                                DDS::ViewStateMask view_states,
+                                DDS::InstanceStateMask instance_states,
+                                QueryConditionImpl& condition);
+
+  /// Evaluate the QueryConditions for a sample added to an instance.  The
+  /// sample_lock_ must be held.
+  void query_conditions_sample_added(ReceivedDataElement* sample);
+
+  /// Remove a sample from the ORDER BY indexes of the QueryConditions.
+  void query_conditions_sample_removed(ReceivedDataElement* sample);
 #endif
 
   virtual void dds_demarshal(const ReceivedDataSample& sample,
@@ -965,15 +972,15 @@ private:
   typedef PmfSporadicTask<DataReaderImpl> DRISporadicTask;
   RcHandle<DRISporadicTask> deadline_task_;
 
-  void schedule_deadline(SubscriptionInstance_rch instance,
+  void schedule_deadline(const SubscriptionInstance_rch& instance,
                          bool timer_called);
   void reset_deadline_period(const TimeDuration& deadline_period);
-  void reschedule_deadline(SubscriptionInstance_rch instance,
+  void reschedule_deadline(const SubscriptionInstance_rch& instance,
                            const MonotonicTimePoint& now);
-  void cancel_deadline(SubscriptionInstance_rch instance);
+  void cancel_deadline(const SubscriptionInstance_rch& instance);
   void cancel_all_deadlines();
   void deadline_task(const MonotonicTimePoint& now);
-  void process_deadline(SubscriptionInstance_rch instance,
+  void process_deadline(const SubscriptionInstance_rch& instance,
                         const MonotonicTimePoint& now,
                         bool timer_called);
 
@@ -1009,6 +1016,16 @@ private:
   typedef OPENDDS_SET_CMP(DDS::ReadCondition_var,  RCCompLess) ReadConditionSet;
   ReadConditionSet read_conditions_;
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  /// QueryConditions by their slot for results in ReceivedDataElement, with
+  /// null for unused slots
+  OPENDDS_VECTOR(QueryConditionImpl*) query_conditions_;
+  /// Source of QueryConditionImpl generations
+  unsigned long query_generation_;
+
+  void detach_query_condition(DDS::ReadCondition_ptr condition);
+#endif
+
   /// Monitor object for this entity
   unique_ptr<Monitor> monitor_;
 
@@ -702,41 +702,6 @@ namespace OpenDDS {
   }
 
 #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
-  bool contains_sample_filtered(DDS::SampleStateMask sample_states,
-                                DDS::ViewStateMask view_states,
-                                DDS::InstanceStateMask instance_states,
-                                const FilterEvaluator& evaluator,
-                                const DDS::StringSeq& params)
-  {
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, sample_lock_, false);
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, instance_guard, instances_lock_, false);
-
-    TopicDescriptionPtr<TopicImpl> topic(topic_servant_);
-    TypeSupport* const ts = topic->get_type_support();
-    TypeSupportImpl* const type_support = dynamic_cast<TypeSupportImpl*>(ts);
-    const bool filter_has_non_key_fields = type_support ? evaluator.has_non_key_fields(*type_support) : true;
-
-    const HandleSet& matches = lookup_matching_instances(sample_states, view_states, instance_states);
-    for (HandleSet::const_iterator it = matches.begin(), next = it; it != matches.end(); it = next) {
-      ++next; // pre-increment iterator, in case updates cause changes to match set
-      const DDS::InstanceHandle_t handle = *it;
-      const SubscriptionInstance_rch inst = get_handle_instance(handle);
-      if (!inst) continue;
-
-      for (ReceivedDataElement* item = inst->rcvd_samples_.get_next_match(sample_states, 0); item;
-           item = inst->rcvd_samples_.get_next_match(sample_states, item)) {
-        if (!item->registered_data_ || (!item->valid_data_ && filter_has_non_key_fields)) {
-          continue;
-        }
-        if (evaluator.eval(*static_cast<MessageType*>(item->registered_data_), params)) {
-          return true;
-        }
-      }
-    }
-
-    return false;
-  }
-
   DDS::ReturnCode_t read_generic(GenericBundle& gen,
                                  DDS::SampleStateMask sample_states,
                                  DDS::ViewStateMask view_states,
@@ -2125,6 +2090,9 @@ void finish_store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_da
   instance_ptr->last_sequence_ = header.sequence_;
 
   instance_ptr->rcvd_strategy_->add(ptr);
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  query_conditions_sample_added(ptr);
+#endif
 
   if (! is_dispose_msg  && ! is_unregister_msg
       && instance_ptr->rcvd_samples_.size() > get_depth())
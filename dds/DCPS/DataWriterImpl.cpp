@@ -2350,6 +2350,53 @@ DataWriterImpl::filter_out(const DataSampleElement& elt,
     return false;
   }
 }
+
+void
+DataWriterImpl::filter_out(const OPENDDS_VECTOR(const DataSampleElement*)& elements,
+                           const OPENDDS_STRING& filterClassName,
+                           const FilterEvaluator& evaluator,
+                           const DDS::StringSeq& expression_params,
+                           FilterEvaluator::BatchResults& filtered) const
+{
+  filtered.assign(elements.size(), 0);
+  if (!type_support_ || (filterClassName != "DDSSQL" && filterClassName != "OPENDDSSQL")) {
+    for (size_t i = 0; i < elements.size(); ++i) {
+      filtered[i] = filter_out(*elements[i], filterClassName, evaluator, expression_params);
+    }
+    return;
+  }
+
+  const bool non_key_fields = evaluator.has_non_key_fields(*type_support_);
+  OPENDDS_VECTOR(ACE_Message_Block*) samples;
+  OPENDDS_VECTOR(size_t) positions;
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (!elements[i]->get_header().valid_data() && non_key_fields) {
+      filtered[i] = 1;
+    } else {
+      samples.push_back(elements[i]->get_sample()->cont());
+      positions.push_back(i);
+    }
+  }
+  if (samples.empty()) {
+    return;
+  }
+
+  FilterEvaluator::BatchResults matches;
+  try {
+    evaluator.eval(&samples[0], samples.size(), encoding_mode_.encoding(),
+                   *type_support_, expression_params, matches);
+  } catch (const std::runtime_error&) {
+    // Evaluate each sample so only the ones that fail aren't filtered.
+    for (size_t i = 0; i < positions.size(); ++i) {
+      filtered[positions[i]] = filter_out(*elements[positions[i]], filterClassName,
+                                          evaluator, expression_params);
+    }
+    return;
+  }
+  for (size_t i = 0; i < positions.size(); ++i) {
+    filtered[positions[i]] = !matches[i];
+  }
+}
 #endif
 
 bool
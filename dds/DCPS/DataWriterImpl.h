@@ -472,6 +472,14 @@ public:
                   const OPENDDS_STRING& filterClassName,
                   const FilterEvaluator& evaluator,
                   const DDS::StringSeq& expression_params) const;
+
+  /// Set filtered[i] to 1 if elements[i] should be filtered out, evaluating
+  /// the filter for all of the elements at once.
+  void filter_out(const OPENDDS_VECTOR(const DataSampleElement*)& elements,
+                  const OPENDDS_STRING& filterClassName,
+                  const FilterEvaluator& evaluator,
+                  const DDS::StringSeq& expression_params,
+                  FilterEvaluator::BatchResults& filtered) const;
 #endif
 
   DataBlockLockPool::DataBlockLock* get_db_lock()
@@ -15,6 +15,10 @@
 #include <algorithm>
 #include <iterator>
 
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
 #ifndef __ACE_INLINE__
 # include "DisjointSequence.inl"
 #endif /* __ACE_INLINE__ */
@@ -97,45 +101,33 @@ DisjointSequence::insert(SequenceNumber value, ACE_CDR::ULong num_bits,
   const SequenceNumber::Value val = value.getValue();
 
   // See RTPS v2.1 section 9.4.2.6 SequenceNumberSet
-  for (ACE_CDR::ULong i = 0, x = 0, bit = 0; i < num_bits; ++i, ++bit) {
-
-    if (bit == 32) bit = 0;
-
-    if (bit == 0) {
-      x = static_cast<ACE_CDR::ULong>(bits[i / 32]);
-      if (x == 0) {
-        // skip an entire Long if it's all 0's (adds 32 due to ++i)
-        i += 31;
-        bit = 31;
-        //FUTURE: this could be generalized with something like the x86 "bsr"
-        //        instruction using compiler intrinsics, VC++ _BitScanReverse()
-        //        and GCC __builtin_clz()
-        continue;
-      }
+  // Runs of 1's are located a word at a time by counting the leading zeros
+  // (or the leading ones, using the complement) of the remaining bits.
+  for (ACE_CDR::ULong word = 0, base = 0; base < num_bits; ++word, base += 32) {
+    const ACE_CDR::ULong x = static_cast<ACE_CDR::ULong>(bits[word]);
+    const ACE_CDR::ULong valid_bits = (std::min)(num_bits - base, ACE_CDR::ULong(32));
+
+    if (!range_start_is_valid && x == 0) {
+      continue;
     }
 
-    if (x & (1 << (31 - bit))) {
-      if (!range_start_is_valid) {
-        range_start = val + i;
-        range_start_is_valid = true;
-      }
-    } else if (range_start_is_valid) {
-      // this is a "0" bit and we've previously seen a "1": insert a range
-      const SequenceNumber::Value to_insert = val + i - 1;
-      if (insert_bitmap_range(iter, SequenceRange(range_start, to_insert))) {
-        inserted = true;
-      }
-      range_start = 0;
-      range_start_is_valid = false;
-
-      if (iter != sequences_.ranges_.end() && iter->second.getValue() != to_insert) {
-        // skip ahead: next gap in sequence must be past iter->second
-        ACE_CDR::ULong next_i = ACE_CDR::ULong(iter->second.getValue() - val);
-        bit = next_i % 32;
-        if (next_i / 32 != i / 32 && next_i < num_bits) {
-          x = static_cast<ACE_CDR::ULong>(bits[next_i / 32]);
+    for (ACE_CDR::ULong bit = 0; bit < valid_bits;) {
+      const ACE_CDR::ULong rest = x << bit;
+      if (range_start_is_valid) {
+        bit += (std::min)(leading_zeros(~rest), valid_bits - bit);
+        if (bit < valid_bits) {
+          // this is a "0" bit and we've previously seen a "1": insert a range
+          if (insert_bitmap_range(iter, SequenceRange(range_start, val + base + bit - 1))) {
+            inserted = true;
+          }
+          range_start_is_valid = false;
+        }
+      } else {
+        bit += (std::min)(leading_zeros(rest), valid_bits - bit);
+        if (bit < valid_bits) {
+          range_start = val + base + bit;
+          range_start_is_valid = true;
         }
-        i = next_i;
       }
     }
   }
@@ -144,7 +136,7 @@ DisjointSequence::insert(SequenceNumber value, ACE_CDR::ULong num_bits,
     // iteration finished before we saw a "0" (inside a range)
     SequenceNumber range_end = (value + num_bits).previous();
     if (insert_bitmap_range(iter, SequenceRange(range_start, range_end))) {
-      return true;
+      inserted = true;
     }
   }
   return inserted;
@@ -326,6 +318,29 @@ DisjointSequence::dump() const
   }
 }
 
+ACE_CDR::ULong
+DisjointSequence::leading_zeros(ACE_CDR::ULong x)
+{
+  if (x == 0) {
+    return 32;
+  }
+#if defined __GNUC__
+  return static_cast<ACE_CDR::ULong>(__builtin_clz(x));
+#elif defined _MSC_VER
+  unsigned long index;
+  _BitScanReverse(&index, x);
+  return 31 - static_cast<ACE_CDR::ULong>(index);
+#else
+  ACE_CDR::ULong n = 0;
+  if (!(x & 0xFFFF0000)) { n += 16; x <<= 16; }
+  if (!(x & 0xFF000000)) { n += 8; x <<= 8; }
+  if (!(x & 0xF0000000)) { n += 4; x <<= 4; }
+  if (!(x & 0xC0000000)) { n += 2; x <<= 2; }
+  if (!(x & 0x80000000)) { n += 1; }
+  return n;
+#endif
+}
+
 ACE_CDR::ULong
 DisjointSequence::bitmap_num_longs(const SequenceNumber& low, const SequenceNumber& high)
 {
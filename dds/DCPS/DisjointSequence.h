@@ -299,6 +299,9 @@ public:
                                 ACE_CDR::Long bitmap[], ACE_CDR::ULong length,
                                 ACE_CDR::ULong& num_bits, ACE_CDR::ULong& cumulative_bits_added);
 
+  /// Number of consecutive 0 bits starting at the msb of x (32 if x is 0).
+  static ACE_CDR::ULong leading_zeros(ACE_CDR::ULong x);
+
   /// Return the number of CORBA::Longs required for the bitmap representation of
   /// sequence numbers between low and high, inclusive (maximum 8 longs).
   static ACE_CDR::ULong bitmap_num_longs(const SequenceNumber& low, const SequenceNumber& high);
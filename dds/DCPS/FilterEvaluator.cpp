@@ -98,6 +98,12 @@ public:
 
   virtual Value eval(DataForEval& data) = 0;
 
+  /// Evaluate for the samples of the batch that are selected, which are the
+  /// ones that aren't decided by an enclosing AND or OR.  Nodes that can't
+  /// evaluate whole columns evaluate each selected sample in turn.
+  virtual void eval_batch(BatchForEval& batch, const BatchResults& selected,
+                          BatchResults& results);
+
 private:
   static void deleteChild(EvalNode* child)
   {
@@ -111,8 +117,44 @@ protected:
 class FilterEvaluator::Operand : public FilterEvaluator::EvalNode {
 public:
   virtual bool isParameter() const { return false; }
+
+  /// The operand has the same value for every sample.
+  virtual bool isConstant() const { return false; }
+
+  /// Values of the operand for a batch, or null if it isn't a field.
+  virtual const OPENDDS_VECTOR(Value)* column(BatchForEval&) const { return 0; }
 };
 
+/// Values of the fields used by the filter, one column per field with a
+/// value for each sample.  lookup returns the value for the current row.
+struct FilterEvaluator::BatchForEval : DataForEval {
+  BatchForEval(const MetaStruct& meta, const DDS::StringSeq& params, size_t count)
+    : DataForEval(meta, params), count_(count), row_(0) {}
+
+  Value lookup(const char* field) const
+  {
+    const Columns::const_iterator iter = columns_.find(field);
+    if (iter == columns_.end()) {
+      throw std::runtime_error("FilterEvaluator::BatchForEval::lookup: "
+        "field is not in the batch");
+    }
+    return iter->second[row_];
+  }
+
+  typedef OPENDDS_MAP(OPENDDS_STRING, OPENDDS_VECTOR(Value)) Columns;
+  Columns columns_;
+  const size_t count_;
+  size_t row_;
+};
+
+void FilterEvaluator::EvalNode::eval_batch(BatchForEval& batch, const BatchResults& selected,
+                                           BatchResults& results)
+{
+  for (batch.row_ = 0; batch.row_ < batch.count_; ++batch.row_) {
+    results[batch.row_] = selected[batch.row_] && eval(batch).b_;
+  }
+}
+
 Value
 FilterEvaluator::DeserializedForEval::lookup(const char* field) const
 {
@@ -181,6 +223,105 @@ bool FilterEvaluator::has_non_key_fields(const TypeSupportImpl& ts) const
 
 namespace {
 
+  bool any_selected(const FilterEvaluator::BatchResults& selected)
+  {
+    return std::find(selected.begin(), selected.end(), 1) != selected.end();
+  }
+
+  enum ColumnOp {COL_EQ, COL_NEQ, COL_LT, COL_LTEQ, COL_GT, COL_GTEQ};
+
+  void value_of(const Value& v, int& out) { out = v.i_; }
+  void value_of(const Value& v, unsigned int& out) { out = v.u_; }
+  void value_of(const Value& v, ACE_INT64& out) { out = v.l_; }
+  void value_of(const Value& v, ACE_UINT64& out) { out = v.m_; }
+  void value_of(const Value& v, char& out) { out = v.c_; }
+  void value_of(const Value& v, double& out) { out = v.f_; }
+
+  /// Compare "column op constant" for all of the column using the same
+  /// expressions as Comparison::eval.  The values are copied into an array
+  /// first so the loops can be vectorized by the compiler.
+  template <typename T>
+  void compare_array(const OPENDDS_VECTOR(Value)& column, const Value& constant,
+                     ColumnOp op, unsigned char* out)
+  {
+    const size_t n = column.size();
+    OPENDDS_VECTOR(T) values(n);
+    for (size_t i = 0; i < n; ++i) {
+      value_of(column[i], values[i]);
+    }
+    T c;
+    value_of(constant, c);
+    const T* const in = &values[0];
+
+    switch (op) {
+    case COL_EQ:
+      for (size_t i = 0; i < n; ++i) out[i] = in[i] == c;
+      break;
+    case COL_NEQ:
+      for (size_t i = 0; i < n; ++i) out[i] = !(in[i] == c);
+      break;
+    case COL_LT:
+      for (size_t i = 0; i < n; ++i) out[i] = in[i] < c;
+      break;
+    case COL_LTEQ:
+      for (size_t i = 0; i < n; ++i) out[i] = !(c < in[i]);
+      break;
+    case COL_GT:
+      for (size_t i = 0; i < n; ++i) out[i] = c < in[i];
+      break;
+    case COL_GTEQ:
+      for (size_t i = 0; i < n; ++i) out[i] = !(in[i] < c);
+      break;
+    }
+  }
+
+  /// Returns false if the column can't be compared as an array because its
+  /// values aren't all the same numeric or char type as the constant after
+  /// the conversion done for each sample.
+  bool compare_column(const OPENDDS_VECTOR(Value)& column, const Value& constant,
+                      ColumnOp op, FilterEvaluator::BatchResults& results)
+  {
+    if (column.empty()) {
+      return true;
+    }
+    const Value::Type type = column[0].type_;
+    for (size_t i = 1; i < column.size(); ++i) {
+      if (column[i].type_ != type) {
+        return false;
+      }
+    }
+    Value field = column[0];
+    Value converted = constant;
+    Value::conversion(field, converted);
+    if (field.type_ != type || converted.type_ != type) {
+      return false;
+    }
+
+    unsigned char* const out = &results[0];
+    switch (type) {
+    case Value::VAL_INT:
+      compare_array<int>(column, converted, op, out);
+      return true;
+    case Value::VAL_UINT:
+      compare_array<unsigned int>(column, converted, op, out);
+      return true;
+    case Value::VAL_I64:
+      compare_array<ACE_INT64>(column, converted, op, out);
+      return true;
+    case Value::VAL_UI64:
+      compare_array<ACE_UINT64>(column, converted, op, out);
+      return true;
+    case Value::VAL_CHAR:
+      compare_array<char>(column, converted, op, out);
+      return true;
+    case Value::VAL_FLOAT:
+      compare_array<double>(column, converted, op, out);
+      return true;
+    default:
+      return false;
+    }
+  }
+
   class FieldLookup : public FilterEvaluator::Operand {
   public:
     explicit FieldLookup(AstNode* fnNode)
@@ -193,6 +334,13 @@ namespace {
       return data.lookup(fieldName_.c_str());
     }
 
+    const OPENDDS_VECTOR(Value)* column(FilterEvaluator::BatchForEval& batch) const
+    {
+      const FilterEvaluator::BatchForEval::Columns::const_iterator iter =
+        batch.columns_.find(fieldName_);
+      return iter == batch.columns_.end() ? 0 : &iter->second;
+    }
+
     bool has_non_key_fields(const TypeSupportImpl& ts) const
     {
       return !ts.is_dcps_key(fieldName_.c_str());
@@ -226,6 +374,8 @@ namespace {
       }
     }
 
+    bool isConstant() const { return true; }
+
     Value eval(FilterEvaluator::DataForEval&)
     {
       return value_;
@@ -240,6 +390,8 @@ namespace {
       : value_(toString(fnNode)[1])
     {}
 
+    bool isConstant() const { return true; }
+
     Value eval(FilterEvaluator::DataForEval&)
     {
       return Value(value_, true);
@@ -254,6 +406,8 @@ namespace {
       : value_(std::atof(toString(fnNode).c_str()))
     {}
 
+    bool isConstant() const { return true; }
+
     Value eval(FilterEvaluator::DataForEval&)
     {
       return Value(value_, true);
@@ -270,6 +424,8 @@ namespace {
       value_.erase(value_.length() - 1); // trim right '
     }
 
+    bool isConstant() const { return true; }
+
     Value eval(FilterEvaluator::DataForEval&)
     {
       return Value(value_.c_str(), true);
@@ -286,6 +442,8 @@ namespace {
 
     bool isParameter() const { return true; }
 
+    bool isConstant() const { return true; }
+
     Value eval(FilterEvaluator::DataForEval& data)
     {
       return Value(data.params_[static_cast<CORBA::ULong>(param_)], true);
@@ -335,7 +493,60 @@ namespace {
       return false; // not reached
     }
 
+    void eval_batch(FilterEvaluator::BatchForEval& batch,
+                    const FilterEvaluator::BatchResults& selected,
+                    FilterEvaluator::BatchResults& results)
+    {
+      if (!any_selected(selected)) {
+        return;
+      }
+      ColumnOp op;
+      if (column_op(false, op)) {
+        const OPENDDS_VECTOR(Value)* const column = left_->column(batch);
+        if (column && right_->isConstant() &&
+            compare_column(*column, right_->eval(batch), op, results)) {
+          return;
+        }
+      }
+      if (column_op(true, op)) {
+        const OPENDDS_VECTOR(Value)* const column = right_->column(batch);
+        if (column && left_->isConstant() &&
+            compare_column(*column, left_->eval(batch), op, results)) {
+          return;
+        }
+      }
+      EvalNode::eval_batch(batch, selected, results);
+    }
+
   private:
+    /// The operator for comparing a column with a constant, which is on the
+    /// left if swapped.
+    bool column_op(bool swapped, ColumnOp& op) const
+    {
+      switch (oper_type_) {
+      case OPER_EQ:
+        op = COL_EQ;
+        return true;
+      case OPER_NEQ:
+        op = COL_NEQ;
+        return true;
+      case OPER_LT:
+        op = swapped ? COL_GT : COL_LT;
+        return true;
+      case OPER_GT:
+        op = swapped ? COL_LT : COL_GT;
+        return true;
+      case OPER_LTEQ:
+        op = swapped ? COL_GTEQ : COL_LTEQ;
+        return true;
+      case OPER_GTEQ:
+        op = swapped ? COL_LTEQ : COL_GTEQ;
+        return true;
+      default:
+        return false;
+      }
+    }
+
     void setOperator(AstNode* node)
     {
       if (node->TypeMatches<OP_EQ>()) {
@@ -384,6 +595,28 @@ namespace {
       return invert_ ? !btwn : btwn;
     }
 
+    void eval_batch(FilterEvaluator::BatchForEval& batch,
+                    const FilterEvaluator::BatchResults& selected,
+                    FilterEvaluator::BatchResults& results)
+    {
+      if (!any_selected(selected)) {
+        return;
+      }
+      const OPENDDS_VECTOR(Value)* const column = field_->column(batch);
+      if (column && left_->isConstant() && right_->isConstant()) {
+        FilterEvaluator::BatchResults high(results.size());
+        if (compare_column(*column, left_->eval(batch), COL_GTEQ, results) &&
+            compare_column(*column, right_->eval(batch), COL_LTEQ, high)) {
+          const unsigned char invert = invert_;
+          for (size_t i = 0; i < results.size(); ++i) {
+            results[i] = (results[i] & high[i]) ^ invert;
+          }
+          return;
+        }
+      }
+      EvalNode::eval_batch(batch, selected, results);
+    }
+
   private:
     bool invert_;
     FilterEvaluator::Operand* field_;
@@ -468,6 +701,33 @@ namespace {
       return children_[1]->eval(data);
     }
 
+    void eval_batch(FilterEvaluator::BatchForEval& batch,
+                    const FilterEvaluator::BatchResults& selected,
+                    FilterEvaluator::BatchResults& results)
+    {
+      const size_t n = results.size();
+      children_[0]->eval_batch(batch, selected, results);
+      if (op_ == LG_NOT) {
+        for (size_t i = 0; i < n; ++i) {
+          results[i] = !results[i];
+        }
+        return;
+      }
+
+      // Like eval, the right side is only evaluated for the samples that
+      // aren't decided by the left side.
+      const unsigned char decided = op_ == LG_OR;
+      FilterEvaluator::BatchResults right_selected(n);
+      for (size_t i = 0; i < n; ++i) {
+        right_selected[i] = selected[i] & (results[i] ^ decided);
+      }
+      FilterEvaluator::BatchResults right(n);
+      children_[1]->eval_batch(batch, right_selected, right);
+      for (size_t i = 0; i < n; ++i) {
+        results[i] = right_selected[i] ? right[i] : results[i];
+      }
+    }
+
   private:
     LogicalOp op_;
   };
@@ -529,7 +789,11 @@ FilterEvaluator::Operand*
 FilterEvaluator::walkOperand(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<FieldName>()) {
-    return new FieldLookup(node);
+    FieldLookup* const field = new FieldLookup(node);
+    if (std::find(fields_.begin(), fields_.end(), field->fieldName_) == fields_.end()) {
+      fields_.push_back(field->fieldName_);
+    }
+    return field;
   } else if (node->TypeMatches<IntVal>()) {
     return new LiteralInt(node);
   } else if (node->TypeMatches<CharVal>()) {
@@ -567,6 +831,55 @@ FilterEvaluator::eval_i(DataForEval& data) const
   return filter_root_->eval(data).b_;
 }
 
+void
+FilterEvaluator::eval_batch_i(BatchForEval& batch, BatchResults& results) const
+{
+  results.assign(batch.count_, 0);
+  if (batch.count_) {
+    const BatchResults all(batch.count_, 1);
+    filter_root_->eval_batch(batch, all, results);
+  }
+}
+
+void
+FilterEvaluator::eval(const void* const* samples, size_t count, const MetaStruct& meta,
+                      const DDS::StringSeq& params, BatchResults& results) const
+{
+  BatchForEval batch(meta, params, count);
+  for (OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator field = fields_.begin();
+       field != fields_.end(); ++field) {
+    OPENDDS_VECTOR(Value)& column = batch.columns_[*field];
+    column.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      column.push_back(meta.getValue(samples[i], field->c_str()));
+    }
+  }
+  eval_batch_i(batch, results);
+}
+
+void
+FilterEvaluator::eval(ACE_Message_Block* const* serializedSamples, size_t count,
+                      Encoding encoding, TypeSupportImpl& typeSupport,
+                      const DDS::StringSeq& params, BatchResults& results) const
+{
+  BatchForEval batch(typeSupport.getMetaStructForType(), params, count);
+  OPENDDS_VECTOR(OPENDDS_VECTOR(Value)*) columns;
+  for (OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator field = fields_.begin();
+       field != fields_.end(); ++field) {
+    columns.push_back(&batch.columns_[*field]);
+    columns.back()->reserve(count);
+  }
+  // Values are read by column, but SerializedForEval::lookup reads each field
+  // of a sample from the start of its serialized data.
+  for (size_t i = 0; i < count; ++i) {
+    SerializedForEval data(serializedSamples[i], typeSupport, params, encoding);
+    for (size_t f = 0; f < fields_.size(); ++f) {
+      columns[f]->push_back(data.lookup(fields_[f].c_str()));
+    }
+  }
+  eval_batch_i(batch, results);
+}
+
 OPENDDS_VECTOR(OPENDDS_STRING)
 FilterEvaluator::getOrderBys() const
 {
@@ -120,6 +120,17 @@ public:
     return eval_i(data);
   }
 
+  /**
+   * Returns true if the unserialized sample, described by meta, matches the
+   * filter.
+   */
+  bool eval(const void* sample, const MetaStruct& meta,
+            const DDS::StringSeq& params) const
+  {
+    DeserializedForEval data(sample, meta, params);
+    return eval_i(data);
+  }
+
   /**
    * Returns true if the serialized sample matches the filter.
    */
@@ -131,8 +142,29 @@ public:
     return eval_i(data);
   }
 
+  /// Result for each sample of a batch: 1 if it matches the filter, else 0
+  typedef OPENDDS_VECTOR(unsigned char) BatchResults;
+
+  /**
+   * Evaluates the filter for a batch of unserialized samples described by
+   * meta.  Each field used by the filter is extracted into a column with a
+   * value for every sample, and comparisons of a column with a literal or
+   * parameter are evaluated for the whole column at once.  Throws
+   * std::runtime_error in the same cases as evaluating each sample.
+   */
+  void eval(const void* const* samples, size_t count, const MetaStruct& meta,
+            const DDS::StringSeq& params, BatchResults& results) const;
+
+  /**
+   * Evaluates the filter for a batch of serialized samples.
+   */
+  void eval(ACE_Message_Block* const* serializedSamples, size_t count,
+            Encoding encoding, TypeSupportImpl& typeSupport,
+            const DDS::StringSeq& params, BatchResults& results) const;
+
   class EvalNode;
   class Operand;
+  struct BatchForEval;
 
   struct OpenDDS_Dcps_Export DataForEval {
     DataForEval(const MetaStruct& meta, const DDS::StringSeq& params)
@@ -174,8 +206,11 @@ private:
   };
 
   bool eval_i(DataForEval& data) const;
+  void eval_batch_i(BatchForEval& batch, BatchResults& results) const;
 
   bool extended_grammar_;
+  /// Names of the fields used by the filter, which are the columns of a batch
+  OPENDDS_VECTOR(OPENDDS_STRING) fields_;
   EvalNode* filter_root_;
   OPENDDS_VECTOR(OPENDDS_STRING) order_bys_;
   /// Number of parameters used in the filter, this should
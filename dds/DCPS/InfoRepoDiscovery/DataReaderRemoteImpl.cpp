@@ -6,6 +6,7 @@
  */
 
 #include "DataReaderRemoteImpl.h"
+#include "InfoRepoDiscovery.h"
 
 #include "dds/DCPS/DataReaderCallbacks.h"
 #include "dds/DCPS/debug.h"
@@ -16,8 +17,10 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-DataReaderRemoteImpl::DataReaderRemoteImpl(DataReaderCallbacks& parent)
+DataReaderRemoteImpl::DataReaderRemoteImpl(DataReaderCallbacks& parent,
+                                           InfoRepoDiscovery& discovery)
   : parent_(parent)
+  , discovery_(discovery)
 {
 }
 
@@ -32,6 +35,12 @@ DataReaderRemoteImpl::detach_parent()
 {
 }
 
+DataReaderCallbacks_rch
+DataReaderRemoteImpl::parent() const
+{
+  return parent_.lock();
+}
+
 void
 DataReaderRemoteImpl::add_association(const WriterAssociation& writer,
                                       bool active)
@@ -43,6 +52,37 @@ DataReaderRemoteImpl::add_association(const WriterAssociation& writer,
   }
 }
 
+void
+DataReaderRemoteImpl::add_associations(const WriterAssociationSeq& writers,
+                                       bool active)
+{
+  // the local copy of parent_ is necessary to prevent race condition
+  RcHandle<DataReaderCallbacks> parent = parent_.lock();
+  if (parent) {
+    for (CORBA::ULong i = 0; i < writers.length(); ++i) {
+      parent->add_association(writers[i], active);
+    }
+  }
+}
+
+void
+DataReaderRemoteImpl::add_association_to_readers(const ReaderIdSeq& readers,
+                                                 const WriterAssociation& writer,
+                                                 bool active)
+{
+  // The InfoRepo sends the association for all of the readers of this
+  // participant through this one.
+  RcHandle<InfoRepoDiscovery> discovery = discovery_.lock();
+  if (discovery) {
+    for (CORBA::ULong i = 0; i < readers.length(); ++i) {
+      const DataReaderCallbacks_rch reader = discovery->reader_callbacks(readers[i]);
+      if (reader) {
+        reader->add_association(writer, active);
+      }
+    }
+  }
+}
+
 void
 DataReaderRemoteImpl::remove_associations(const WriterIdSeq& writers,
                                           CORBA::Boolean notify_lost)
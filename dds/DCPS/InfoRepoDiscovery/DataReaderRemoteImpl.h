@@ -24,6 +24,8 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+class InfoRepoDiscovery;
+
 /**
 * @class DataReaderRemoteImpl
 *
@@ -32,16 +34,23 @@ namespace DCPS {
 *
 */
 class DataReaderRemoteImpl
-  : public virtual POA_OpenDDS::DCPS::DataReaderRemote {
+  : public virtual POA_OpenDDS::DCPS::DataReaderRemoteBatch {
 public:
 
-  explicit DataReaderRemoteImpl(DataReaderCallbacks& parent);
+  DataReaderRemoteImpl(DataReaderCallbacks& parent, InfoRepoDiscovery& discovery);
 
   virtual ~DataReaderRemoteImpl();
 
   virtual void add_association(const WriterAssociation& writer,
                                bool active);
 
+  virtual void add_associations(const WriterAssociationSeq& writers,
+                                bool active);
+
+  virtual void add_association_to_readers(const ReaderIdSeq& readers,
+                                          const WriterAssociation& writer,
+                                          bool active);
+
   virtual void remove_associations(const WriterIdSeq& writers,
                                    CORBA::Boolean callback);
 
@@ -49,8 +58,11 @@ public:
 
   void detach_parent();
 
+  DataReaderCallbacks_rch parent() const;
+
 private:
   WeakRcHandle<DataReaderCallbacks> parent_;
+  WeakRcHandle<InfoRepoDiscovery> discovery_;
 };
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
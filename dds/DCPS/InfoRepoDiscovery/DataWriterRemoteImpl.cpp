@@ -6,6 +6,7 @@
  */
 
 #include "DataWriterRemoteImpl.h"
+#include "InfoRepoDiscovery.h"
 
 #include "dds/DCPS/DataWriterCallbacks.h"
 #include "dds/DCPS/debug.h"
@@ -16,8 +17,10 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-DataWriterRemoteImpl::DataWriterRemoteImpl(DataWriterCallbacks& parent)
+DataWriterRemoteImpl::DataWriterRemoteImpl(DataWriterCallbacks& parent,
+                                           InfoRepoDiscovery& discovery)
   : parent_(parent)
+  , discovery_(discovery)
 {
 }
 
@@ -32,6 +35,12 @@ DataWriterRemoteImpl::detach_parent()
 {
 }
 
+DataWriterCallbacks_rch
+DataWriterRemoteImpl::parent() const
+{
+  return parent_.lock();
+}
+
 void
 DataWriterRemoteImpl::add_association(const ReaderAssociation& reader,
                                       bool active)
@@ -43,6 +52,37 @@ DataWriterRemoteImpl::add_association(const ReaderAssociation& reader,
   }
 }
 
+void
+DataWriterRemoteImpl::add_associations(const ReaderAssociationSeq& readers,
+                                       bool active)
+{
+  // the local copy of parent_ is necessary to prevent race condition
+  RcHandle<DataWriterCallbacks> parent = parent_.lock();
+  if (parent.in()) {
+    for (CORBA::ULong i = 0; i < readers.length(); ++i) {
+      parent->add_association(readers[i], active);
+    }
+  }
+}
+
+void
+DataWriterRemoteImpl::add_association_to_writers(const WriterIdSeq& writers,
+                                                 const ReaderAssociation& reader,
+                                                 bool active)
+{
+  // The InfoRepo sends the association for all of the writers of this
+  // participant through this one.
+  RcHandle<InfoRepoDiscovery> discovery = discovery_.lock();
+  if (discovery.in()) {
+    for (CORBA::ULong i = 0; i < writers.length(); ++i) {
+      const DataWriterCallbacks_rch writer = discovery->writer_callbacks(writers[i]);
+      if (writer.in()) {
+        writer->add_association(reader, active);
+      }
+    }
+  }
+}
+
 void
 DataWriterRemoteImpl::remove_associations(const ReaderIdSeq& readers,
                                           CORBA::Boolean notify_lost)
@@ -21,23 +21,31 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+class InfoRepoDiscovery;
 
 /**
 * @class DataWriterRemoteImpl
 *
-* @brief Implements the OpenDDS::DCPS::DataWriterRemote interface.
+* @brief Implements the OpenDDS::DCPS::DataWriterRemoteBatch interface.
 *
 */
 class DataWriterRemoteImpl
-  : public virtual POA_OpenDDS::DCPS::DataWriterRemote {
+  : public virtual POA_OpenDDS::DCPS::DataWriterRemoteBatch {
 public:
-  explicit DataWriterRemoteImpl(DataWriterCallbacks& parent);
+  DataWriterRemoteImpl(DataWriterCallbacks& parent, InfoRepoDiscovery& discovery);
 
   virtual ~DataWriterRemoteImpl();
 
   virtual void add_association(const ReaderAssociation& readers,
                                bool active);
 
+  virtual void add_associations(const ReaderAssociationSeq& readers,
+                                bool active);
+
+  virtual void add_association_to_writers(const WriterIdSeq& writers,
+                                          const ReaderAssociation& reader,
+                                          bool active);
+
   virtual void remove_associations(const ReaderIdSeq& readers,
                                    CORBA::Boolean callback);
 
@@ -48,8 +56,11 @@ public:
 
   void detach_parent();
 
+  DataWriterCallbacks_rch parent() const;
+
 private:
   WeakRcHandle<DataWriterCallbacks> parent_;
+  WeakRcHandle<InfoRepoDiscovery> discovery_;
 };
 
 } // namespace DCPS
@@ -672,7 +672,7 @@ InfoRepoDiscovery::add_publication(DDS::DomainId_t domainId,
   try {
     DCPS::DataWriterRemoteImpl* writer_remote_impl = 0;
     ACE_NEW_RETURN(writer_remote_impl,
-                   DataWriterRemoteImpl(*publication),
+                   DataWriterRemoteImpl(*publication, *this),
                    false);
 
     //this is taking ownership of the DataWriterRemoteImpl (server side) allocated above
@@ -782,7 +782,7 @@ InfoRepoDiscovery::add_subscription(DDS::DomainId_t domainId,
   try {
     DCPS::DataReaderRemoteImpl* reader_remote_impl = 0;
     ACE_NEW_RETURN(reader_remote_impl,
-                   DataReaderRemoteImpl(*subscription),
+                   DataReaderRemoteImpl(*subscription, *this),
                    false);
 
     //this is taking ownership of the DataReaderRemoteImpl (server side) allocated above
@@ -895,6 +895,44 @@ InfoRepoDiscovery::update_subscription_params(DDS::DomainId_t domainId,
 
 // Managing reader/writer associations:
 
+DataWriterCallbacks_rch
+InfoRepoDiscovery::writer_callbacks(const GUID_t& publicationId) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, DataWriterCallbacks_rch());
+  DataWriterMap::const_iterator dwr = dataWriterMap_.find(publicationId);
+  if (dwr == dataWriterMap_.end()) {
+    return DataWriterCallbacks_rch();
+  }
+
+  try {
+    DataWriterRemoteImpl* impl =
+      remote_reference_to_servant<DataWriterRemoteImpl>(dwr->second.in(), orb_, use_bidir_giop_);
+    return impl ? impl->parent() : DataWriterCallbacks_rch();
+  } catch (const CORBA::Exception& ex) {
+    ex._tao_print_exception("ERROR: InfoRepoDiscovery::writer_callbacks: ");
+    return DataWriterCallbacks_rch();
+  }
+}
+
+DataReaderCallbacks_rch
+InfoRepoDiscovery::reader_callbacks(const GUID_t& subscriptionId) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, lock_, DataReaderCallbacks_rch());
+  DataReaderMap::const_iterator drr = dataReaderMap_.find(subscriptionId);
+  if (drr == dataReaderMap_.end()) {
+    return DataReaderCallbacks_rch();
+  }
+
+  try {
+    DataReaderRemoteImpl* impl =
+      remote_reference_to_servant<DataReaderRemoteImpl>(drr->second.in(), orb_, use_bidir_giop_);
+    return impl ? impl->parent() : DataReaderCallbacks_rch();
+  } catch (const CORBA::Exception& ex) {
+    ex._tao_print_exception("ERROR: InfoRepoDiscovery::reader_callbacks: ");
+    return DataReaderCallbacks_rch();
+  }
+}
+
 void
 InfoRepoDiscovery::removeDataReaderRemote(const GUID_t& subscriptionId)
 {
@@ -218,6 +218,16 @@ public:
     const OpenDDS::DCPS::GUID_t& subscriptionId,
     const DDS::StringSeq& params);
 
+  // Used by the DataWriterRemote and DataReaderRemote servants when the
+  // InfoRepo tells several entities of a participant about an
+  // association in one call:
+
+  /// The local DataWriter with the id, or null if it was removed
+  DataWriterCallbacks_rch writer_callbacks(const GUID_t& publicationId) const;
+
+  /// The local DataReader with the id, or null if it was removed
+  DataReaderCallbacks_rch reader_callbacks(const GUID_t& subscriptionId) const;
+
 private:
   const String name_;
   const String config_prefix_;
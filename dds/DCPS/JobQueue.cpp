@@ -16,30 +16,183 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-JobQueue::JobQueue(ACE_Reactor* reactor)
+const size_t JobQueue::DEFAULT_BUDGET;
+
+JobQueue::JobQueue(ACE_Reactor* reactor, size_t budget)
+  : head_(new Node)
+  , tail_(0)
+  , depth_(0)
+  , notified_(0)
+  , budget_(budget)
+  , latency_stats_(false)
+  , freed_(0)
+  , spare_(0)
+  , nodes_(1)
 {
+  tail_ = head_;
   this->reactor(reactor);
 }
 
+JobQueue::~JobQueue()
+{
+  destroy(tail_);
+  destroy(freed_);
+  destroy(spare_);
+}
+
+void JobQueue::destroy(Node* list)
+{
+  while (list) {
+    Node* const next = list->next;
+    delete list;
+    list = next;
+  }
+}
+
+JobQueue::Node* JobQueue::allocate()
+{
+  Node* const list = spare_.exchange(0);
+  if (!list) {
+    ++nodes_;
+    return new Node;
+  }
+
+  Node* const rest = list->next;
+  list->next = 0;
+  if (rest) {
+    // Put the rest back.  If the consumer handed over more nodes in the
+    // meantime this thread now owns them and they are released.
+    Node* const other = spare_.exchange(rest);
+    if (other) {
+      for (Node* n = other; n; n = n->next) {
+        --nodes_;
+      }
+      destroy(other);
+    }
+  }
+  return list;
+}
+
+void JobQueue::recycle()
+{
+  if (freed_) {
+    // Take back whatever producers left so nothing is lost.
+    freed_ = spare_.exchange(freed_);
+  }
+}
+
+void JobQueue::enqueue(JobPtr job)
+{
+  Node* const node = allocate();
+  node->job = job;
+  if (latency_stats_) {
+    node->enqueued = MonotonicTimePoint::now();
+  }
+  ++depth_;
+
+  // Vyukov MPSC queue: claim the head, then link the previous head to us.
+  // Until the link is made the consumer sees the queue as empty but
+  // head_ != tail_, which handle_exception treats as pending work.
+  Node* const prev = head_.exchange(node);
+  prev->next = node;
+
+  if (notified_.exchange(1) == 0) {
+    notify();
+  }
+}
+
+JobQueue::Stats JobQueue::stats() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(stats_mutex_);
+  Stats stats = stats_;
+  stats.depth = depth_;
+  stats.nodes = nodes_;
+  return stats;
+}
+
+void JobQueue::reset_stats()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(stats_mutex_);
+  stats_ = Stats();
+}
+
+bool JobQueue::pop(JobPtr& job, MonotonicTimePoint& enqueued)
+{
+  Node* const tail = tail_;
+  Node* const next = tail->next;
+  if (!next) {
+    return false;
+  }
+  tail_ = next;
+  job.swap(next->job);
+  enqueued = next->enqueued;
+  next->enqueued = MonotonicTimePoint::zero_value;
+  // No producer refers to the old stub once its next is set.
+  tail->next = freed_;
+  freed_ = tail;
+  --depth_;
+  return true;
+}
+
+void JobQueue::notify()
+{
+  if (reactor()->notify(this) == -1) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: JobQueue::notify: reactor notify failed\n"));
+    }
+    // Let the next enqueue try again.
+    notified_ = 0;
+  }
+}
+
 int JobQueue::handle_exception(ACE_HANDLE /*fd*/)
 {
   ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
-  Queue q;
+  // Only one notification is outstanding at a time so this is the only
+  // consumer until it either clears notified_ or notifies again.
+
+  const size_t budget = budget_;
+  size_t executed = 0;
+  size_t max_depth = 0;
+  LatencyHistogram latency;
+
+  JobPtr job;
+  MonotonicTimePoint enqueued;
+  while ((budget == 0 || executed < budget) && pop(job, enqueued)) {
+    const size_t depth = depth_ + 1;
+    if (depth > max_depth) {
+      max_depth = depth;
+    }
+    if (!enqueued.is_zero()) {
+      latency.record(MonotonicTimePoint::now() - enqueued);
+    }
+    ++executed;
+    job->execute();
+    job.reset();
+  }
+  recycle();
 
   {
-    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, -1);
-    q.swap(job_queue_);
+    ACE_Guard<ACE_Thread_Mutex> guard(stats_mutex_);
+    ++stats_.wakeups;
+    stats_.executed += executed;
+    if (max_depth > stats_.max_depth) {
+      stats_.max_depth = max_depth;
+    }
+    stats_.latency += latency;
   }
 
-  for (Queue::const_iterator pos = q.begin(), limit = q.end(); pos != limit; ++pos) {
-    (*pos)->execute();
+  if (head_ != tail_) {
+    // Out of budget (or a producer is mid-enqueue): let the reactor
+    // service other handlers and come back.
+    notify();
+    return 0;
   }
 
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, -1);
-  if (!job_queue_.empty()) {
-    guard.release();
-    reactor()->notify(this);
+  notified_ = 0;
+  if (head_ != tail_ && notified_.exchange(1) == 0) {
+    notify();
   }
 
   return 0;
@@ -8,8 +8,11 @@
 #ifndef OPENDDS_DCPS_JOB_QUEUE_H
 #define OPENDDS_DCPS_JOB_QUEUE_H
 
+#include "Atomic.h"
+#include "LatencyHistogram.h"
 #include "RcEventHandler.h"
 #include "PoolAllocator.h"
+#include "TimeTypes.h"
 #include "dcps_export.h"
 
 #include <ace/Reactor.h>
@@ -54,27 +57,103 @@ private:
   }
 };
 
+/**
+ * Runs jobs on a reactor thread.
+ *
+ * Any thread may enqueue jobs; they are linked into a lock-free
+ * multi-producer single-consumer list and at most one reactor notification
+ * is outstanding at a time no matter how many jobs are queued.  Each
+ * notification runs at most budget() jobs and then notifies again if more
+ * are waiting so the reactor can service I/O between batches.
+ *
+ * List nodes are recycled by the reactor thread and handed back to
+ * producers in batches, so a steady stream of jobs doesn't allocate.  The
+ * queue keeps as many nodes as it has ever held jobs at once.
+ */
 class OpenDDS_Dcps_Export JobQueue : public virtual RcEventHandler {
 public:
-  explicit JobQueue(ACE_Reactor* reactor);
-
-  void enqueue(JobPtr job)
-  {
-    ACE_GUARD(ACE_Thread_Mutex, guard, mutex_);
-    const bool empty = job_queue_.empty();
-    job_queue_.push_back(job);
-    if (empty) {
-      guard.release();
-      reactor()->notify(this);
-    }
-  }
+  /// Default number of jobs run per reactor notification.
+  static const size_t DEFAULT_BUDGET = 256;
+
+  struct Stats {
+    Stats()
+      : depth(0)
+      , max_depth(0)
+      , wakeups(0)
+      , executed(0)
+      , nodes(0)
+    {}
+
+    /// Jobs waiting to run.
+    size_t depth;
+    /// Largest depth seen by the reactor thread.
+    size_t max_depth;
+    /// Reactor notifications handled.
+    size_t wakeups;
+    /// Jobs run.
+    size_t executed;
+    /// List nodes allocated, including ones waiting to be reused.
+    size_t nodes;
+    /// Time between enqueue and the start of execute.  Only recorded while
+    /// latency stats are enabled.
+    LatencyHistogram latency;
+  };
+
+  explicit JobQueue(ACE_Reactor* reactor, size_t budget = DEFAULT_BUDGET);
+  virtual ~JobQueue();
+
+  void enqueue(JobPtr job);
+
+  /// Maximum number of jobs run per notification (0 means no limit).
+  size_t budget() const { return budget_; }
+  void budget(size_t budget) { budget_ = budget; }
+
+  /// Record the latency of each job.  Off by default since it reads the
+  /// clock twice per job.
+  bool latency_stats() const { return latency_stats_; }
+  void latency_stats(bool enabled) { latency_stats_ = enabled; }
+
+  Stats stats() const;
+  void reset_stats();
 
 private:
-  ACE_Thread_Mutex mutex_;
-  typedef OPENDDS_VECTOR(JobPtr) Queue;
-  Queue job_queue_;
+  struct Node {
+    Node()
+      : next(0)
+    {}
+
+    JobPtr job;
+    MonotonicTimePoint enqueued;
+    Atomic<Node*> next;
+  };
+
+  Node* allocate();
+  void recycle();
+  static void destroy(Node* list);
+
+  bool pop(JobPtr& job, MonotonicTimePoint& enqueued);
+  void notify();
 
   int handle_exception(ACE_HANDLE /*fd*/);
+
+  /// Producers swap themselves in here; the consumer reads from tail_.
+  Atomic<Node*> head_;
+  Node* tail_;
+  Atomic<size_t> depth_;
+  /// Non-zero while a notification is outstanding or being handled.
+  Atomic<size_t> notified_;
+  Atomic<size_t> budget_;
+  Atomic<bool> latency_stats_;
+
+  /// Nodes freed by the consumer, not yet handed to producers.
+  Node* freed_;
+  /// Nodes for producers, linked by next.  Whoever exchanges a list out of
+  /// here owns all of it, which avoids the ABA problem of a shared stack.
+  Atomic<Node*> spare_;
+  Atomic<size_t> nodes_;
+
+  mutable ACE_Thread_Mutex stats_mutex_;
+  Stats stats_;
 };
 
 typedef RcHandle<JobQueue> JobQueue_rch;
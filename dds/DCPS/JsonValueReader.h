@@ -96,6 +96,10 @@ public:
   bool read_long_enum(ACE_CDR::Long& value, const EnumHelper& helper);
   bool read_bitmask(ACE_CDR::ULongLong& value, const BitmaskHelper& helper);
 
+  /// Prepare to read the next of a series of JSON values separated by
+  /// whitespace, such as JSON Lines.  Returns false at the end of the input.
+  bool next_value();
+
   bool Null() { token_type_ = kNull; return true; }
   bool Bool(bool b) { token_type_ = kBool; bool_value_ = b; return true; }
   bool Int(int i) { token_type_ = kInt; int_value_ = i; return true; }
@@ -107,11 +111,11 @@ public:
   bool String(const Ch* str, rapidjson::SizeType length, bool /* copy */)
   {
     token_type_ = kString;
-    string_value_ = std::string(str, length);
+    string_value_.assign(str, length);
     return true;
   }
   bool StartObject() { token_type_ = kStartObject; return true; }
-  bool Key(const Ch* str, rapidjson::SizeType /* length */, bool /* copy */) { token_type_ = kKey; key_value_ = str; return true; }
+  bool Key(const Ch* str, rapidjson::SizeType length, bool /* copy */) { token_type_ = kKey; key_value_.assign(str, length); return true; }
   bool EndObject(rapidjson::SizeType /* memberCount */) { token_type_ = kEndObject; return true; }
   bool StartArray() { token_type_ = kStartArray; return true; }
   bool EndArray(rapidjson::SizeType /* elementCount */) { token_type_ = kEndArray; return true; }
@@ -504,7 +508,7 @@ bool JsonValueReader<InputStream>::read_float32(ACE_CDR::Float& value)
     return consume(kInt64);
   case kInt:
     value = ACE_CDR::Float(int_value_);
-    return consume(kUint);
+    return consume(kInt);
   default:
     return false;
   }
@@ -528,7 +532,7 @@ bool JsonValueReader<InputStream>::read_float64(ACE_CDR::Double& value)
     return consume(kInt64);
   case kInt:
     value = int_value_;
-    return consume(kUint);
+    return consume(kInt);
   default:
     return false;
   }
@@ -564,7 +568,7 @@ bool JsonValueReader<InputStream>::read_float128(ACE_CDR::LongDouble& value)
     return consume(kInt64);
   case kInt:
     ACE_CDR_LONG_DOUBLE_ASSIGNMENT(value, int_value_);
-    return consume(kUint);
+    return consume(kInt);
   default:
     return false;
   }
@@ -617,7 +621,8 @@ template <typename InputStream>
 bool JsonValueReader<InputStream>::read_string(std::string& value)
 {
   if (peek() == kString) {
-    value = string_value_;
+    // The token is consumed, so its buffer can be handed over.
+    value.swap(string_value_);
     return consume(kString);
   }
   return false;
@@ -686,6 +691,18 @@ bool JsonValueReader<InputStream>::read_bitmask(ACE_CDR::ULongLong& value, const
   }
 }
 
+template <typename InputStream>
+bool JsonValueReader<InputStream>::next_value()
+{
+  rapidjson::SkipWhitespace(input_stream_);
+  if (input_stream_.Peek() == '\0') {
+    return false;
+  }
+  reader_.IterativeParseInit();
+  token_type_ = kUnknown;
+  return true;
+}
+
 template<typename T, typename InputStream>
 bool from_json(T& value, InputStream& stream)
 {
@@ -694,6 +711,23 @@ bool from_json(T& value, InputStream& stream)
   return vread(jvr, value);
 }
 
+/// Read JSON values separated by whitespace, such as JSON Lines, and assign
+/// them to out.  One reader and its buffers are used for all the values.
+template<typename T, typename InputStream, typename OutputIterator>
+bool from_json_lines(InputStream& stream, OutputIterator out)
+{
+  JsonValueReader<InputStream> jvr(stream);
+  T value;
+  while (jvr.next_value()) {
+    set_default(value);
+    if (!vread(jvr, value)) {
+      return false;
+    }
+    *out++ = value;
+  }
+  return true;
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -6,15 +6,10 @@
 #ifndef OPENDDS_DCPS_JSON_VALUE_WRITER_H
 #define OPENDDS_DCPS_JSON_VALUE_WRITER_H
 
-#if defined OPENDDS_RAPIDJSON && !defined OPENDDS_SAFETY_PROFILE
-#  define OPENDDS_HAS_JSON_VALUE_WRITER 1
-#else
-#  define OPENDDS_HAS_JSON_VALUE_WRITER 0
-#endif
+#include "ValueWriter.h"
 
 #if OPENDDS_HAS_JSON_VALUE_WRITER
 
-#include "ValueWriter.h"
 #include "ValueHelper.h"
 #include "RapidJsonWrapper.h"
 #include "dcps_export.h"
@@ -87,7 +82,30 @@ public:
   bool write_bitmask(ACE_CDR::ULongLong value, const BitmaskHelper& helper);
   bool write_absent_value();
 
+  using ValueWriter::write_string;
+  using ValueWriter::write_wstring;
+  using ValueWriter::write_enum;
+  using ValueWriter::write_bitmask;
+
+  bool write_boolean_array(const ACE_CDR::Boolean* x, ACE_CDR::ULong length);
+  bool write_byte_array(const ACE_CDR::Octet* x, ACE_CDR::ULong length);
+#if OPENDDS_HAS_EXPLICIT_INTS
+  bool write_int8_array(const ACE_CDR::Int8* x, ACE_CDR::ULong length);
+  bool write_uint8_array(const ACE_CDR::UInt8* x, ACE_CDR::ULong length);
+#endif
+  bool write_int16_array(const ACE_CDR::Short* x, ACE_CDR::ULong length);
+  bool write_uint16_array(const ACE_CDR::UShort* x, ACE_CDR::ULong length);
+  bool write_int32_array(const ACE_CDR::Long* x, ACE_CDR::ULong length);
+  bool write_uint32_array(const ACE_CDR::ULong* x, ACE_CDR::ULong length);
+  bool write_int64_array(const ACE_CDR::LongLong* x, ACE_CDR::ULong length);
+  bool write_uint64_array(const ACE_CDR::ULongLong* x, ACE_CDR::ULong length);
+  bool write_float32_array(const ACE_CDR::Float* x, ACE_CDR::ULong length);
+  bool write_float64_array(const ACE_CDR::Double* x, ACE_CDR::ULong length);
+
 private:
+  template <typename T, typename W, typename U>
+  bool write_array_common(const T* x, ACE_CDR::ULong length, bool (W::*pmf)(U));
+
   Writer& writer_;
 };
 
@@ -343,6 +361,95 @@ bool JsonValueWriter<Writer>::write_absent_value()
   return writer_.Null();
 }
 
+// The arrays are written directly instead of through the virtual write
+// function for each element.
+template <typename Writer>
+template <typename T, typename W, typename U>
+bool JsonValueWriter<Writer>::write_array_common(const T* x, ACE_CDR::ULong length,
+                                                 bool (W::*pmf)(U))
+{
+  for (ACE_CDR::ULong i = 0; i != length; ++i) {
+    if (!(writer_.*pmf)(x[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_boolean_array(const ACE_CDR::Boolean* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Bool);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_byte_array(const ACE_CDR::Octet* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Uint);
+}
+
+#if OPENDDS_HAS_EXPLICIT_INTS
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_int8_array(const ACE_CDR::Int8* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Int);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_uint8_array(const ACE_CDR::UInt8* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Uint);
+}
+#endif
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_int16_array(const ACE_CDR::Short* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Int);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_uint16_array(const ACE_CDR::UShort* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Uint);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_int32_array(const ACE_CDR::Long* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Int);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_uint32_array(const ACE_CDR::ULong* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Uint);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_int64_array(const ACE_CDR::LongLong* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Int64);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_uint64_array(const ACE_CDR::ULongLong* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Uint64);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_float32_array(const ACE_CDR::Float* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Double);
+}
+
+template <typename Writer>
+bool JsonValueWriter<Writer>::write_float64_array(const ACE_CDR::Double* x, ACE_CDR::ULong length)
+{
+  return write_array_common(x, length, &Writer::Double);
+}
+
 template<typename T>
 std::string to_json(const T& sample)
 {
@@ -392,6 +499,83 @@ std::string to_json(const DDS::TopicDescription_ptr topic,
   return buffer.GetString();
 }
 
+/// The output of a JsonEncoder.  It's a separate base so that it's
+/// constructed before JsonEncoder's JsonValueWriter base.
+class JsonEncoderOutput {
+protected:
+  JsonEncoderOutput()
+    : json_writer_(json_buffer_)
+  {}
+
+  rapidjson::StringBuffer json_buffer_;
+  rapidjson::Writer<rapidjson::StringBuffer> json_writer_;
+};
+
+/**
+ * Encodes samples as JSON into a buffer that's kept from one sample to the
+ * next, so encoding many samples doesn't allocate for each one.
+ *
+ * opendds_idl generates vwrite overloads that take a JsonEncoder.  Because
+ * the class is final, the calls for the values in those overloads aren't
+ * virtual and can be inlined.  Types without those overloads use the
+ * ValueWriter ones.
+ */
+class JsonEncoder
+#ifdef ACE_HAS_CPP11
+  final
+#endif
+  : private JsonEncoderOutput
+  , public JsonValueWriter<rapidjson::Writer<rapidjson::StringBuffer> > {
+public:
+  JsonEncoder()
+    : JsonValueWriter<rapidjson::Writer<rapidjson::StringBuffer> >(json_writer_)
+  {}
+
+  /// Discard the output but keep its memory.
+  void clear()
+  {
+    json_buffer_.Clear();
+    json_writer_.Reset(json_buffer_);
+  }
+
+  /// Replace the output with sample.
+  template <typename T>
+  bool encode(const T& sample)
+  {
+    clear();
+    return vwrite(*this, sample);
+  }
+
+  /// Append sample followed by a newline, as in JSON Lines.
+  template <typename T>
+  bool encode_line(const T& sample)
+  {
+    json_writer_.Reset(json_buffer_);
+    if (!vwrite(*this, sample)) {
+      return false;
+    }
+    json_buffer_.Put('\n');
+    return true;
+  }
+
+  /// Replace the output with the samples from a DataReader take or read
+  /// that have valid data, one per line.
+  template <typename Sequence>
+  bool encode_lines(const Sequence& samples, const DDS::SampleInfoSeq& infos)
+  {
+    clear();
+    for (ACE_CDR::ULong i = 0; i != infos.length(); ++i) {
+      if (infos[i].valid_data && !encode_line(samples[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const char* c_str() const { return json_buffer_.GetString(); }
+  size_t size() const { return json_buffer_.GetSize(); }
+};
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -0,0 +1,148 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+#define OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+
+#include "TimeDuration.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Counts durations in power-of-two microsecond buckets.  Bucket 0 holds
+ * durations under 1us and bucket i holds durations in [2^(i-1), 2^i) us.
+ * The last bucket also holds everything longer.  Not thread safe.
+ */
+class LatencyHistogram {
+public:
+  enum { BUCKET_COUNT = 32 };
+
+  LatencyHistogram()
+  {
+    reset();
+  }
+
+  void record(const TimeDuration& duration)
+  {
+    const ACE_UINT64 usec = duration < TimeDuration::zero_value ? 0 : to_usec(duration);
+    ++buckets_[bucket(usec)];
+    if (count_ == 0 || usec < min_usec_) {
+      min_usec_ = usec;
+    }
+    if (usec > max_usec_) {
+      max_usec_ = usec;
+    }
+    sum_usec_ += usec;
+    ++count_;
+  }
+
+  void reset()
+  {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      buckets_[i] = 0;
+    }
+    count_ = 0;
+    sum_usec_ = 0;
+    min_usec_ = 0;
+    max_usec_ = 0;
+  }
+
+  ACE_UINT64 count() const { return count_; }
+  ACE_UINT64 bucket_count(size_t i) const { return i < BUCKET_COUNT ? buckets_[i] : 0; }
+
+  /// Exclusive upper bound of bucket i in microseconds.
+  static ACE_UINT64 bucket_limit_usec(size_t i)
+  {
+    return ACE_UINT64(1) << i;
+  }
+
+  TimeDuration min() const { return from_usec(min_usec_); }
+  TimeDuration max() const { return from_usec(max_usec_); }
+  TimeDuration mean() const { return count_ ? from_usec(sum_usec_ / count_) : TimeDuration::zero_value; }
+
+  /// Upper bound of the bucket holding the given percentile (0 to 100),
+  /// clamped to the largest recorded duration.  The last bucket has no
+  /// upper bound, so the largest recorded duration is used for it.
+  TimeDuration percentile(double pct) const
+  {
+    if (count_ == 0) {
+      return TimeDuration::zero_value;
+    }
+    const double target = pct / 100.0 * static_cast<double>(count_);
+    ACE_UINT64 seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      seen += buckets_[i];
+      if (buckets_[i] && static_cast<double>(seen) >= target) {
+        if (i == BUCKET_COUNT - 1) {
+          break;
+        }
+        const ACE_UINT64 limit = bucket_limit_usec(i);
+        return from_usec(limit < max_usec_ ? limit : max_usec_);
+      }
+    }
+    return max();
+  }
+
+  LatencyHistogram& operator+=(const LatencyHistogram& other)
+  {
+    if (other.count_ == 0) {
+      return *this;
+    }
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    if (count_ == 0 || other.min_usec_ < min_usec_) {
+      min_usec_ = other.min_usec_;
+    }
+    if (other.max_usec_ > max_usec_) {
+      max_usec_ = other.max_usec_;
+    }
+    sum_usec_ += other.sum_usec_;
+    count_ += other.count_;
+    return *this;
+  }
+
+private:
+  static ACE_UINT64 to_usec(const TimeDuration& duration)
+  {
+    const ACE_Time_Value& tv = duration.value();
+    return static_cast<ACE_UINT64>(tv.sec()) * 1000000 + static_cast<ACE_UINT64>(tv.usec());
+  }
+
+  static TimeDuration from_usec(ACE_UINT64 usec)
+  {
+    return TimeDuration(static_cast<time_t>(usec / 1000000), static_cast<suseconds_t>(usec % 1000000));
+  }
+
+  static size_t bucket(ACE_UINT64 usec)
+  {
+    size_t i = 0;
+    while (usec && i < BUCKET_COUNT - 1) {
+      usec >>= 1;
+      ++i;
+    }
+    return i;
+  }
+
+  ACE_UINT64 buckets_[BUCKET_COUNT];
+  ACE_UINT64 count_;
+  ACE_UINT64 sum_usec_;
+  ACE_UINT64 min_usec_;
+  ACE_UINT64 max_usec_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_LATENCY_HISTOGRAM_H
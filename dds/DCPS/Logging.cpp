@@ -8,6 +8,7 @@
 
 #include "Logging.h"
 
+#include "AsyncLogger.h"
 #include "GuidConverter.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -23,8 +24,8 @@ void OpenDDS_Dcps_Export log_progress(const char* activity,
                                       const MonotonicTime_t& start_time,
                                       const GUID_t& reference)
 {
-  ACE_DEBUG((LM_INFO, "(%P|%t) {transport_debug.log_progress} local: %C remote: %C reference: %C time(ms): %Lu activity: %C\n",
-             DCPS::LogGuid(local).c_str(), DCPS::LogGuid(remote).c_str(), DCPS::LogGuid(reference).c_str(),
+  OPENDDS_ASYNC_LOG((LM_INFO, "(%P|%t) {transport_debug.log_progress} local: %C remote: %C reference: %C time(ms): %Lu activity: %C\n",
+             OPENDDS_ASYNC_LOG_GUID(local), OPENDDS_ASYNC_LOG_GUID(remote), OPENDDS_ASYNC_LOG_GUID(reference),
              duration_to_time_value(MonotonicTimePoint::now().to_idl_struct() - start_time).msec(),
              activity));
 }
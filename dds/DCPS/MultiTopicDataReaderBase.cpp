@@ -16,6 +16,7 @@
 #include "TypeSupportImpl.h"
 #include "DCPS_Utils.h"
 
+#include <limits>
 #include <stdexcept>
 
 namespace {
@@ -29,6 +30,25 @@ namespace {
     const OPENDDS_STRING& look_for_;
   };
 
+  template <typename T>
+  void append_bytes(OPENDDS_STRING& str, const T& value)
+  {
+    str.append(reinterpret_cast<const char*>(&value), sizeof value);
+  }
+
+  template <typename KeyMap>
+  void erase_instance(KeyMap& instances, const OPENDDS_STRING& key,
+                      DDS::InstanceHandle_t instance)
+  {
+    const typename KeyMap::iterator found = instances.find(key);
+    if (found != instances.end()) {
+      found->second.erase(instance);
+      if (found->second.empty()) {
+        instances.erase(found);
+      }
+    }
+  }
+
   class Listener
     : public virtual OpenDDS::DCPS::LocalObject<DDS::DataReaderListener> {
   public:
@@ -88,6 +108,18 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+MultiTopicDataReaderBase::JoinStats::JoinStats()
+  : samples(0)
+  , index_lookups(0)
+  , instance_lookups(0)
+  , scans(0)
+  , instances_read(0)
+  , matches(0)
+  , indexes(0)
+  , indexed_instances(0)
+{
+}
+
 void MultiTopicDataReaderBase::init(const DDS::DataReaderQos& dr_qos,
   DDS::DataReaderListener_ptr a_listener, DDS::StatusMask mask,
   SubscriberImpl* parent, MultiTopicImpl* multitopic)
@@ -216,6 +248,202 @@ void MultiTopicDataReaderBase::init(const DDS::DataReaderQos& dr_qos,
       }
     }
   }
+
+  // Joins with a topic on its complete key use lookup_instance, the others
+  // use an index of its instances by the fields that are joined on.
+  ACE_GUARD(ACE_Thread_Mutex, guard, join_lock_);
+  for (std::map<OPENDDS_STRING, QueryPlan>::iterator it = query_plans_.begin();
+       it != query_plans_.end(); ++it) {
+    QueryPlan& qp = it->second;
+    const MetaStruct& meta = metaStructFor(qp.data_reader_);
+    typedef multimap<OPENDDS_STRING, OPENDDS_STRING>::const_iterator join_iter_t;
+    for (join_iter_t iter = qp.adjacent_joins_.begin(); iter != qp.adjacent_joins_.end();) {
+      const join_iter_t range_end = qp.adjacent_joins_.upper_bound(iter->first);
+      vector<OPENDDS_STRING> keys;
+      for (; iter != range_end; ++iter) {
+        keys.push_back(iter->second);
+      }
+      if (meta.numDcpsKeys() != keys.size()) {
+        qp.join_indexes_[keys];
+      }
+    }
+  }
+}
+
+MultiTopicDataReaderBase::JoinStats MultiTopicDataReaderBase::join_stats() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, join_lock_, JoinStats());
+  JoinStats stats = join_stats_;
+  for (std::map<OPENDDS_STRING, QueryPlan>::const_iterator it = query_plans_.begin();
+       it != query_plans_.end(); ++it) {
+    const std::map<std::vector<OPENDDS_STRING>, JoinIndex>& indexes = it->second.join_indexes_;
+    for (std::map<std::vector<OPENDDS_STRING>, JoinIndex>::const_iterator index = indexes.begin();
+         index != indexes.end(); ++index) {
+      if (index->second.usable_) {
+        ++stats.indexes;
+        stats.indexed_instances += index->second.keys_.size();
+      }
+    }
+  }
+  return stats;
+}
+
+bool MultiTopicDataReaderBase::join_key(OPENDDS_STRING& key,
+  const MetaStruct& meta, const void* sample,
+  const std::vector<OPENDDS_STRING>& key_names)
+{
+  key.clear();
+  try {
+    for (size_t i = 0; i < key_names.size(); ++i) {
+      Value val = meta.getValue(sample, key_names[i].c_str());
+      switch (val.type_) {
+      case Value::VAL_BOOL:
+        key += val.b_ ? '\1' : '\0';
+        break;
+      case Value::VAL_INT:
+        append_bytes(key, val.i_);
+        break;
+      case Value::VAL_UINT:
+        append_bytes(key, val.u_);
+        break;
+      case Value::VAL_I64:
+        append_bytes(key, val.l_);
+        break;
+      case Value::VAL_UI64:
+        append_bytes(key, val.m_);
+        break;
+      case Value::VAL_FLOAT:
+        if (val.f_ == 0) {
+          val.f_ = 0; // -0.0 compares equal to 0.0
+        }
+        append_bytes(key, val.f_);
+        break;
+      case Value::VAL_CHAR:
+        key += val.c_;
+        break;
+      case Value::VAL_STRING:
+        key += val.s_;
+        key += '\0';
+        break;
+      default:
+        return false;
+      }
+    }
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+  return true;
+}
+
+void MultiTopicDataReaderBase::index_sample(QueryPlan& qp,
+  DDS::InstanceHandle_t instance, const void* sample, const MetaStruct& meta)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, join_lock_);
+  ++join_stats_.samples;
+  typedef std::map<std::vector<OPENDDS_STRING>, JoinIndex>::iterator index_iter_t;
+  for (index_iter_t it = qp.join_indexes_.begin(); it != qp.join_indexes_.end(); ++it) {
+    JoinIndex& index = it->second;
+    if (!index.usable_) {
+      continue;
+    }
+
+    OPENDDS_STRING key;
+    if (!join_key(key, meta, sample, it->first)) {
+      if (DCPS_debug_level > 1) {
+        ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) MultiTopicDataReaderBase::index_sample: ")
+                   ACE_TEXT("join fields starting with %C can't be indexed, ")
+                   ACE_TEXT("joins on them will read every instance\n"),
+                   it->first.front().c_str()));
+      }
+      index.usable_ = false;
+      index.instances_.clear();
+      index.keys_.clear();
+      continue;
+    }
+
+    // The fields joined on aren't always part of the DCPS key, so they can
+    // change from one sample of the instance to the next.
+    const std::pair<std::map<DDS::InstanceHandle_t, OPENDDS_STRING>::iterator, bool> inserted =
+      index.keys_.insert(std::make_pair(instance, key));
+    if (!inserted.second) {
+      if (inserted.first->second == key) {
+        continue;
+      }
+      erase_instance(index.instances_, inserted.first->second, instance);
+      inserted.first->second = key;
+    }
+    index.instances_[key].insert(instance);
+  }
+}
+
+void MultiTopicDataReaderBase::unindex_instance(QueryPlan& qp,
+  DDS::InstanceHandle_t instance)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, join_lock_);
+  typedef std::map<std::vector<OPENDDS_STRING>, JoinIndex>::iterator index_iter_t;
+  for (index_iter_t it = qp.join_indexes_.begin(); it != qp.join_indexes_.end(); ++it) {
+    JoinIndex& index = it->second;
+    const std::map<DDS::InstanceHandle_t, OPENDDS_STRING>::iterator found =
+      index.keys_.find(instance);
+    if (found != index.keys_.end()) {
+      erase_instance(index.instances_, found->second, instance);
+      index.keys_.erase(found);
+    }
+  }
+}
+
+bool MultiTopicDataReaderBase::lookup_join_index(
+  std::vector<DDS::InstanceHandle_t>& instances, const OPENDDS_STRING& topic,
+  const std::vector<OPENDDS_STRING>& key_names, const void* key_data,
+  const MetaStruct& meta)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, join_lock_, false);
+  const std::map<OPENDDS_STRING, QueryPlan>::const_iterator qp = query_plans_.find(topic);
+  if (qp == query_plans_.end()) {
+    return false;
+  }
+  const std::map<std::vector<OPENDDS_STRING>, JoinIndex>::const_iterator index =
+    qp->second.join_indexes_.find(key_names);
+  OPENDDS_STRING key;
+  if (index == qp->second.join_indexes_.end() || !index->second.usable_ ||
+      !join_key(key, meta, key_data, key_names)) {
+    return false;
+  }
+  const JoinIndex::KeyMap::const_iterator found = index->second.instances_.find(key);
+  if (found != index->second.instances_.end()) {
+    instances.assign(found->second.begin(), found->second.end());
+  }
+  return true;
+}
+
+void MultiTopicDataReaderBase::count_join(JoinKind kind, size_t instances_read,
+                                          size_t matches)
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, join_lock_);
+  switch (kind) {
+  case JOIN_INDEX:
+    ++join_stats_.index_lookups;
+    break;
+  case JOIN_INSTANCE:
+    ++join_stats_.instance_lookups;
+    break;
+  case JOIN_SCAN:
+    ++join_stats_.scans;
+    break;
+  }
+  join_stats_.instances_read += instances_read;
+  join_stats_.matches += matches;
+}
+
+bool MultiTopicDataReaderBase::keys_match(const MetaStruct& meta,
+  const void* lhs, const void* rhs, const std::vector<OPENDDS_STRING>& key_names)
+{
+  for (size_t i = 0; i < key_names.size(); ++i) {
+    if (!meta.compare(lhs, rhs, key_names[i].c_str())) {
+      return false;
+    }
+  }
+  return true;
 }
 
 OPENDDS_STRING MultiTopicDataReaderBase::topicNameFor(DDS::DataReader_ptr reader)
@@ -262,16 +490,21 @@ void MultiTopicDataReaderBase::data_available(DDS::DataReader_ptr reader)
 
   try {
     const MetaStruct& meta = metaStructFor(reader);
-    const QueryPlan& qp = query_plans_[topic];
+    QueryPlan& qp = query_plans_[topic];
     for (CORBA::ULong i = 0; i < gen.samples_.size(); ++i) {
       const SampleInfo& si = gen.info_[i];
       if (si.valid_data) {
+        // Index before joining so that a sample of an adjacent topic that's
+        // joined concurrently can find this one.
+        index_sample(qp, si.instance_handle, gen.samples_[i], meta);
         incoming_sample(gen.samples_[i], si, topic.c_str(), meta);
       } else if (si.instance_state != ALIVE_INSTANCE_STATE) {
+        unindex_instance(qp, si.instance_handle);
         DataReaderImpl* resulting_impl = dynamic_cast<DataReaderImpl*>(resulting_reader_.in());
         if (resulting_impl) {
-          set<pair<InstanceHandle_t, InstanceHandle_t> >::const_iterator iter = qp.instances_.begin();
-          while (iter != qp.instances_.end() && iter->first != si.instance_handle) ++iter;
+          set<pair<InstanceHandle_t, InstanceHandle_t> >::const_iterator iter =
+            qp.instances_.lower_bound(make_pair(si.instance_handle,
+                                                numeric_limits<InstanceHandle_t>::min()));
           for (; iter != qp.instances_.end() && iter->first == si.instance_handle; ++iter) {
             resulting_impl->set_instance_state(iter->second, si.instance_state);
           }
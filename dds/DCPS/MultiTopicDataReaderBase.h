@@ -13,6 +13,7 @@
 #include "dds/DdsDcpsSubscriptionExtC.h"
 #include "ZeroCopySeq_T.h"
 #include "MultiTopicImpl.h"
+#include "Hash.h"
 #include "PoolAllocator.h"
 #include "unique_ptr.h"
 
@@ -32,6 +33,30 @@ class OpenDDS_Dcps_Export MultiTopicDataReaderBase
 public:
   MultiTopicDataReaderBase() {}
 
+  /// Statistics of the joins done for the samples of the constituent topics
+  struct OpenDDS_Dcps_Export JoinStats {
+    JoinStats();
+
+    /// Valid samples received from the constituent topics
+    size_t samples;
+    /// Joins that found the instances to combine with in a join index
+    size_t index_lookups;
+    /// Joins on the complete key of the other topic, using lookup_instance
+    size_t instance_lookups;
+    /// Joins that read every instance of the other topic, which are
+    /// cross-joins and joins whose index isn't usable
+    size_t scans;
+    /// Instances read by all joins
+    size_t instances_read;
+    /// Instances that were combined with a partial result
+    size_t matches;
+    /// Join indexes and the number of instances in them
+    size_t indexes;
+    size_t indexed_instances;
+  };
+
+  JoinStats join_stats() const;
+
   void init(const DDS::DataReaderQos& dr_qos,
     DDS::DataReaderListener_ptr a_listener, DDS::StatusMask mask,
     SubscriberImpl* parent, MultiTopicImpl* multitopic);
@@ -138,6 +163,52 @@ protected:
 
   typedef MultiTopicImpl::SubjectFieldSpec SubjectFieldSpec;
 
+#ifdef ACE_HAS_CPP11
+  struct JoinKeyHash {
+    std::size_t operator()(const OPENDDS_STRING& key) const
+    {
+      return static_cast<std::size_t>(one_at_a_time_hash(
+        reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+    }
+  };
+#endif
+
+  typedef std::set<DDS::InstanceHandle_t> InstanceSet;
+
+  /// Instances of a constituent reader by the values of the fields it's
+  /// joined on with an adjacent topic.  Indexes are updated as samples are
+  /// received and instances stop being alive, so a join with a partial key
+  /// only reads the instances that can match instead of all of them.
+  struct JoinIndex {
+    JoinIndex() : usable_(true) {}
+
+#ifdef ACE_HAS_CPP11
+    typedef OPENDDS_UNORDERED_MAP_CHASH(OPENDDS_STRING, InstanceSet, JoinKeyHash) KeyMap;
+#else
+    typedef OPENDDS_MAP(OPENDDS_STRING, InstanceSet) KeyMap;
+#endif
+    KeyMap instances_;
+    std::map<DDS::InstanceHandle_t, OPENDDS_STRING> keys_;
+    /// False if a field can't be indexed, then joins read every instance
+    bool usable_;
+  };
+
+  enum JoinKind { JOIN_INDEX, JOIN_INSTANCE, JOIN_SCAN };
+
+  // Find the instances of the reader for 'topic' that may match 'key_data'
+  // (with MetaStruct 'meta') on the fields named in 'key_names', in order of
+  // their instance handles.  Returns false if there's no usable index.
+  bool lookup_join_index(std::vector<DDS::InstanceHandle_t>& instances,
+                         const OPENDDS_STRING& topic,
+                         const std::vector<OPENDDS_STRING>& key_names,
+                         const void* key_data, const MetaStruct& meta);
+
+  void count_join(JoinKind kind, size_t instances_read, size_t matches);
+
+  static bool keys_match(const MetaStruct& meta, const void* lhs,
+                         const void* rhs,
+                         const std::vector<OPENDDS_STRING>& key_names);
+
   struct QueryPlan {
     DDS::DataReader_var data_reader_;
     std::vector<SubjectFieldSpec> projection_;
@@ -145,13 +216,34 @@ protected:
     std::multimap<OPENDDS_STRING, OPENDDS_STRING> adjacent_joins_; // topic -> key
     std::set<std::pair<DDS::InstanceHandle_t /*of this data_reader_*/,
       DDS::InstanceHandle_t /*of the resulting DR*/> > instances_;
+    // key: names of the fields joined on with adjacent topics, only for
+    // those that aren't the complete key of data_reader_
+    std::map<std::vector<OPENDDS_STRING>, JoinIndex> join_indexes_;
   };
   mutable ACE_RW_Thread_Mutex qp_lock_;
 
+  // Protects the join_indexes_ of the query_plans_ and join_stats_
+  mutable ACE_Thread_Mutex join_lock_;
+  JoinStats join_stats_;
+
   // key: topicName for this reader
   OPENDDS_MAP(OPENDDS_STRING, QueryPlan) query_plans_;
 
   OPENDDS_DELETED_COPY_MOVE_CTOR_ASSIGN(MultiTopicDataReaderBase)
+
+private:
+  // Make 'key' from the values of the fields named in 'key_names', so that
+  // samples with equal values for them have equal keys.  Returns false for
+  // fields that can't be indexed.
+  static bool join_key(OPENDDS_STRING& key, const MetaStruct& meta,
+                       const void* sample,
+                       const std::vector<OPENDDS_STRING>& key_names);
+
+  // Keep the join indexes of 'qp' up to date with a sample or a change of
+  // instance state of its data_reader_.
+  void index_sample(QueryPlan& qp, DDS::InstanceHandle_t instance,
+                    const void* sample, const MetaStruct& meta);
+  void unindex_instance(QueryPlan& qp, DDS::InstanceHandle_t instance);
 };
 
 }
@@ -94,6 +94,7 @@ MultiTopicDataReader_T<Sample, TypedDataReader>::join(
   CORBA::String_var other_topic = other_td->get_name();
   const QueryPlan& other_qp = query_plans_[other_topic.in()];
   const size_t n_keys = key_names.size();
+  const size_t n_resulting = resulting.size();
 
   if (n_keys > 0 && other_meta.numDcpsKeys() == n_keys) { // complete key
     InstanceHandle_t ih = other_dri->lookup_instance_generic(key_data);
@@ -117,40 +118,62 @@ MultiTopicDataReader_T<Sample, TypedDataReader>::join(
       resulting.back().combine(SampleWithInfo(other_topic.in(), info));
       assign_fields(resulting.back().sample_, other_data.ptr_, other_qp, other_meta);
     }
-  } else { // incomplete key or cross-join (0 key fields)
-    ReturnCode_t ret = RETCODE_OK;
-    for (InstanceHandle_t ih = HANDLE_NIL; ret != RETCODE_NO_DATA;) {
+    count_join(JOIN_INSTANCE, ih != HANDLE_NIL ? 1 : 0, resulting.size() - n_resulting);
+    return true;
+  }
+
+  std::vector<InstanceHandle_t> instances;
+  if (n_keys > 0 && lookup_join_index(instances, other_topic.in(), key_names,
+                                      key_data, other_meta)) { // incomplete key
+    for (size_t i = 0; i < instances.size(); ++i) {
       GenericData other_data(other_meta, false);
       SampleInfo info;
-      const ReturnCode_t ret = other_dri->read_next_instance_generic(other_data.ptr_,
-        info, ih, READ_SAMPLE_STATE, ANY_VIEW_STATE, ALIVE_INSTANCE_STATE);
-      if (ret != RETCODE_OK && ret != RETCODE_NO_DATA) {
-        if (log_level >= LogLevel::Notice) {
-          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: MultiTopicDataReader_T::join:"
-                     " read_next_instance_generic for topic %C returns %C\n",
-                     other_topic.in(), retcode_to_string(ret)));
-        }
-        return false;
-      }
-      if (ret == RETCODE_NO_DATA || !info.valid_data) {
-        break;
-      }
-      ih = info.instance_handle;
-
-      bool match = true;
-      for (size_t i = 0; match && i < key_names.size(); ++i) {
-        if (!other_meta.compare(key_data, other_data.ptr_, key_names[i].c_str())) {
-          match = false;
-        }
+      const ReturnCode_t ret = other_dri->read_instance_generic(other_data.ptr_,
+        info, instances[i], READ_SAMPLE_STATE, ANY_VIEW_STATE, ALIVE_INSTANCE_STATE);
+      // The instance may have stopped being alive since it was indexed.
+      if (ret != RETCODE_OK || !info.valid_data) {
+        continue;
       }
 
-      if (match) {
+      if (keys_match(other_meta, key_data, other_data.ptr_, key_names)) {
         resulting.push_back(prototype);
         resulting.back().combine(SampleWithInfo(other_topic.in(), info));
         assign_fields(resulting.back().sample_, other_data.ptr_, other_qp, other_meta);
       }
     }
+    count_join(JOIN_INDEX, instances.size(), resulting.size() - n_resulting);
+    return true;
+  }
+
+  // cross-join (0 key fields) or incomplete key without a usable index
+  size_t instances_read = 0;
+  ReturnCode_t ret = RETCODE_OK;
+  for (InstanceHandle_t ih = HANDLE_NIL; ret != RETCODE_NO_DATA;) {
+    GenericData other_data(other_meta, false);
+    SampleInfo info;
+    const ReturnCode_t ret = other_dri->read_next_instance_generic(other_data.ptr_,
+      info, ih, READ_SAMPLE_STATE, ANY_VIEW_STATE, ALIVE_INSTANCE_STATE);
+    if (ret != RETCODE_OK && ret != RETCODE_NO_DATA) {
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: MultiTopicDataReader_T::join:"
+                   " read_next_instance_generic for topic %C returns %C\n",
+                   other_topic.in(), retcode_to_string(ret)));
+      }
+      return false;
+    }
+    if (ret == RETCODE_NO_DATA || !info.valid_data) {
+      break;
+    }
+    ih = info.instance_handle;
+    ++instances_read;
+
+    if (keys_match(other_meta, key_data, other_data.ptr_, key_names)) {
+      resulting.push_back(prototype);
+      resulting.back().combine(SampleWithInfo(other_topic.in(), info));
+      assign_fields(resulting.back().sample_, other_data.ptr_, other_qp, other_meta);
+    }
   }
+  count_join(JOIN_SCAN, instances_read, resulting.size() - n_resulting);
   return true;
 }
 
@@ -139,7 +139,10 @@ private:
   // Starting with a 'prototype' sample, fill a 'resulting' vector with all
   // data from 'other_dr' (with MetaStruct 'other_meta') such that all key
   // fields named in 'key_names' match the values in 'key_data'.  The struct
-  // pointed-to by 'key_data' is of the type used by the 'other_dr'.
+  // pointed-to by 'key_data' is of the type used by the 'other_dr'.  The
+  // instances to read are found with lookup_instance for the complete key,
+  // with the join index of 'other_dr' for an incomplete key, and by reading
+  // every instance otherwise.
   bool join(SampleVec& resulting, const SampleWithInfo& prototype,
             const std::vector<OPENDDS_STRING>& key_names,
             const void* key_data, DDS::DataReader_ptr other_dr,
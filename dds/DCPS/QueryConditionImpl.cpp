@@ -16,6 +16,22 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  class AnySample : public ReceivedDataFilter {
+  public:
+    bool operator()(ReceivedDataElement*) { return true; }
+  };
+
+  class CollectSamples : public ReceivedDataOperation {
+  public:
+    explicit CollectSamples(QueryConditionImpl::Samples& samples) : samples_(samples) {}
+    void operator()(ReceivedDataElement* sample) { samples_.push_back(sample); }
+
+  private:
+    QueryConditionImpl::Samples& samples_;
+  };
+}
+
 QueryConditionImpl::QueryConditionImpl(
   DataReaderImpl* dr, DDS::SampleStateMask sample_states,
   DDS::ViewStateMask view_states, DDS::InstanceStateMask instance_states,
@@ -23,7 +39,29 @@ QueryConditionImpl::QueryConditionImpl(
   : ReadConditionImpl(dr, sample_states, view_states, instance_states)
   , query_expression_(query_expression)
   , evaluator_(query_expression, true)
+  , type_support_(get_type_support())
+  , has_non_key_fields_(false)
+  , slot_(0)
+  , attached_(false)
+  , generation_(0)
+  , order_index_valid_(false)
 {
+  if (type_support_ && evaluator_.hasFilter()) {
+    has_non_key_fields_ = evaluator_.has_non_key_fields(*type_support_);
+  }
+
+  const std::vector<OPENDDS_STRING> order_bys = evaluator_.getOrderBys();
+  if (type_support_ && !order_bys.empty()) {
+    // Iterate in reverse over the comma-separated fields so that the
+    // top-level comparison is the leftmost.  The others will be chained.
+    const MetaStruct& meta = type_support_->getMetaStructForType();
+    for (size_t i = order_bys.size(); i > 0; --i) {
+      order_cmp_ = meta.create_qc_comparator(order_bys[i - 1].c_str(), order_cmp_);
+    }
+    OrderIndex index((OrderLess(order_cmp_)));
+    order_index_.swap(index);
+  }
+
   if (DCPS_debug_level > 5) {
     ACE_DEBUG((LM_DEBUG,
       ACE_TEXT("(%P|%t) QueryConditionImpl::QueryConditionImpl() - ")
@@ -48,7 +86,8 @@ QueryConditionImpl::get_query_parameters(DDS::StringSeq& query_parameters)
 DDS::ReturnCode_t
 QueryConditionImpl::set_query_parameters(const DDS::StringSeq& query_parameters)
 {
-  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, false);
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard2, parent_->sample_lock_, DDS::RETCODE_ERROR);
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, DDS::RETCODE_ERROR);
 
   // Check sequence of strings that give values to the ‘parameters’ (i.e., "%n" tokens)
   // in the query_expression matches the size of the parameter sequence.
@@ -65,6 +104,12 @@ QueryConditionImpl::set_query_parameters(const DDS::StringSeq& query_parameters)
   }
 
   query_parameters_ = query_parameters;
+  guard.release();
+
+  invalidate();
+  if (attached_) {
+    reevaluate();
+  }
   return DDS::RETCODE_OK;
 }
 
@@ -84,15 +129,180 @@ CORBA::Boolean
 QueryConditionImpl::get_trigger_value()
 {
   if (hasFilter()) {
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard2, parent_->sample_lock_, false);
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, false);
+    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, parent_->sample_lock_, false);
     return parent_->contains_sample_filtered(sample_states_, view_states_,
-      instance_states_, evaluator_, query_parameters_);
+      instance_states_, *this);
   } else {
     return ReadConditionImpl::get_trigger_value();
   }
 }
 
+bool QueryConditionImpl::filter(ReceivedDataElement* sample)
+{
+  if (!sample->registered_data_) {
+    return false;
+  }
+  if (!hasFilter()) {
+    return true;
+  }
+  if (!attached_) {
+    return evaluate(sample);
+  }
+
+  ReceivedDataElement::QueryResult& result = cached_result(sample);
+  if (result.generation != generation_) {
+    result.match = evaluate(sample);
+    result.generation = generation_;
+  }
+  return result.match;
+}
+
+ReceivedDataElement::QueryResult& QueryConditionImpl::cached_result(ReceivedDataElement* sample) const
+{
+  if (sample->query_results_.size() <= slot_) {
+    sample->query_results_.resize(slot_ + 1);
+  }
+  return sample->query_results_[slot_];
+}
+
+bool QueryConditionImpl::evaluate(const ReceivedDataElement* sample) const
+{
+  ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, false);
+  /*
+   * Omit the sample from results if the query references non-key fields
+   * and the sample only has key fields.
+   */
+  if (!type_support_ || (!sample->valid_data_ && has_non_key_fields_)) {
+    if (DCPS_debug_level > 8) {
+      ACE_DEBUG((LM_DEBUG,
+        ACE_TEXT("(%P|%t) QueryConditionImpl::evaluate: ")
+        ACE_TEXT("Sample has been filtered because the query ")
+        ACE_TEXT("references fields that are not readable\n")
+      ));
+    }
+    return false;
+  }
+  return evaluator_.eval(sample->registered_data_,
+    type_support_->getMetaStructForType(), query_parameters_);
+}
+
+void QueryConditionImpl::evaluate(const Samples& samples)
+{
+  if (!attached_ || !hasFilter() || !type_support_) {
+    return;
+  }
+
+  Samples stale;
+  OPENDDS_VECTOR(const void*) data;
+  for (Samples::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+    ReceivedDataElement* const sample = *it;
+    if (sample->registered_data_ && (sample->valid_data_ || !has_non_key_fields_) &&
+        cached_result(sample).generation != generation_) {
+      stale.push_back(sample);
+      data.push_back(sample->registered_data_);
+    }
+  }
+  if (data.empty()) {
+    return;
+  }
+
+  FilterEvaluator::BatchResults matches;
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+    try {
+      evaluator_.eval(&data[0], data.size(), type_support_->getMetaStructForType(),
+                      query_parameters_, matches);
+    } catch (const std::runtime_error&) {
+      // Leave them to be evaluated one at a time when they're used.
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < stale.size(); ++i) {
+    ReceivedDataElement::QueryResult& result = cached_result(stale[i]);
+    result.match = matches[i];
+    result.generation = generation_;
+  }
+}
+
+const QueryConditionImpl::OrderIndex* QueryConditionImpl::order_index()
+{
+  if (!attached_ || !order_cmp_) {
+    return 0;
+  }
+  if (!order_index_valid_) {
+    reevaluate();
+  }
+  return &order_index_;
+}
+
+void QueryConditionImpl::attach(size_t slot)
+{
+  slot_ = slot;
+  attached_ = true;
+  invalidate();
+}
+
+void QueryConditionImpl::detach()
+{
+  attached_ = false;
+  invalidate();
+}
+
+void QueryConditionImpl::invalidate()
+{
+  // Results kept in samples for an older generation are ignored, and the
+  // index is rebuilt when it's next used.
+  generation_ = ++parent_->query_generation_;
+  order_index_.clear();
+  order_positions_.clear();
+  order_index_valid_ = false;
+}
+
+void QueryConditionImpl::reevaluate()
+{
+  Samples samples;
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, parent_->instances_lock_);
+    AnySample any;
+    CollectSamples collect(samples);
+    for (DataReaderImpl::SubscriptionInstanceMapType::iterator it = parent_->instances_.begin();
+         it != parent_->instances_.end(); ++it) {
+      it->second->rcvd_samples_.apply_all(any, collect);
+    }
+  }
+
+  evaluate(samples);
+
+  if (order_cmp_) {
+    order_index_valid_ = true;
+    for (Samples::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+      sample_added(*it);
+    }
+  }
+}
+
+void QueryConditionImpl::sample_added(ReceivedDataElement* sample)
+{
+  if (!attached_) {
+    return;
+  }
+  const bool match = filter(sample);
+  if (match && order_index_valid_) {
+    order_positions_[sample] = order_index_.insert(sample);
+    sample->query_indexed_ = true;
+  }
+}
+
+void QueryConditionImpl::sample_removed(ReceivedDataElement* sample)
+{
+  const OrderPositions::iterator pos = order_positions_.find(sample);
+  if (pos != order_positions_.end()) {
+    order_index_.erase(pos->second);
+    order_positions_.erase(pos);
+  }
+}
+
 TypeSupportImpl* QueryConditionImpl::get_type_support() const
 {
   DDS::TopicDescription_var td = parent_->get_topicdescription();
@@ -12,8 +12,10 @@
 
 #include "dds/DdsDcpsSubscriptionC.h"
 #include "ReadConditionImpl.h"
+#include "Comparator_T.h"
 #include "FilterEvaluator.h"
 #include "PoolAllocator.h"
+#include "ReceivedDataElementList.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -53,38 +55,76 @@ public:
   bool hasFilter() const;
 
   /**
-   * Returns true if the sample matches the query.
+   * Returns true if the sample matches the query.  The result is kept with
+   * the sample, so the query is only evaluated again for it if the
+   * parameters change.  The reader's sample_lock_ must be held.
    */
-  template<typename Sample>
-  bool filter(const Sample& s, bool sample_only_has_key_fields) const
-  {
-    ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, lock_, false);
-    /*
-     * Omit the sample from results if the query references non-key fields
-     * and the sample only has key fields.
-     */
-    TypeSupportImpl* const ts = get_type_support();
-    if (!ts || (sample_only_has_key_fields && evaluator_.has_non_key_fields(*ts))) {
-      if (DCPS_debug_level > 8) {
-        ACE_DEBUG((LM_DEBUG,
-          ACE_TEXT("(%P|%t) QueryConditionImpl::filter: ")
-          ACE_TEXT("Sample has been filtered because the query ")
-          ACE_TEXT("references fields that are not readable\n")
-        ));
-      }
-      return false;
+  bool filter(ReceivedDataElement* sample);
+
+  /// Comparator for the ORDER BY fields, or null if there are none
+  ComparatorBase::Ptr order_comparator() const { return order_cmp_; }
+
+  struct OrderLess {
+    explicit OrderLess(ComparatorBase::Ptr cmp = ComparatorBase::Ptr()) : cmp_(cmp) {}
+
+    bool operator()(const ReceivedDataElement* lhs, const ReceivedDataElement* rhs) const
+    {
+      return cmp_->compare(lhs->registered_data_, rhs->registered_data_);
     }
-    return evaluator_.eval(s, query_parameters_);
-  }
+
+  private:
+    ComparatorBase::Ptr cmp_;
+  };
+
+  typedef OPENDDS_MULTISET_CMP(ReceivedDataElement*, OrderLess) OrderIndex;
+
+  /**
+   * Returns the samples in the reader that match the query in ORDER BY
+   * order, or null if there's no ORDER BY or the condition isn't attached to
+   * the reader.  The reader's sample_lock_ must be held.
+   */
+  const OrderIndex* order_index();
+
+  /// Called by the reader with its sample_lock_ held.
+  void attach(size_t slot);
+  void detach();
+  void sample_added(ReceivedDataElement* sample);
+  void sample_removed(ReceivedDataElement* sample);
+
+  typedef OPENDDS_VECTOR(ReceivedDataElement*) Samples;
 
 private:
   TypeSupportImpl* get_type_support() const;
+  ReceivedDataElement::QueryResult& cached_result(ReceivedDataElement* sample) const;
+  bool evaluate(const ReceivedDataElement* sample) const;
+
+  /// Evaluate the samples without a current result as a batch.
+  void evaluate(const Samples& samples);
+
+  /// Evaluate all the samples in the reader and rebuild the ORDER BY index.
+  void reevaluate();
+  void invalidate();
 
   CORBA::String_var query_expression_;
   DDS::StringSeq query_parameters_;
   FilterEvaluator evaluator_;
   /// Concurrent access to query_parameters_
   mutable ACE_Recursive_Thread_Mutex lock_;
+
+  TypeSupportImpl* const type_support_;
+  bool has_non_key_fields_;
+  ComparatorBase::Ptr order_cmp_;
+
+  /// Position of this condition's results in ReceivedDataElement::query_results_
+  size_t slot_;
+  bool attached_;
+  /// Results of the sample with a different generation are out of date.
+  unsigned long generation_;
+
+  OrderIndex order_index_;
+  typedef OPENDDS_MAP(ReceivedDataElement*, OrderIndex::iterator) OrderPositions;
+  OrderPositions order_positions_;
+  bool order_index_valid_;
 };
 
 } // namespace DCPS
@@ -59,6 +59,7 @@ struct DiscoveredParticipant {
     , have_sedp_info_(false)
     , have_auth_req_msg_(false)
     , have_handshake_msg_(false)
+    , have_pending_handshake_msg_(false)
     , handshake_resend_falloff_(DCPS::TimeDuration::zero_value)
     , auth_state_(AUTH_STATE_HANDSHAKE)
     , handshake_state_(HANDSHAKE_STATE_BEGIN_HANDSHAKE_REQUEST)
@@ -93,6 +94,7 @@ struct DiscoveredParticipant {
     , have_sedp_info_(false)
     , have_auth_req_msg_(false)
     , have_handshake_msg_(false)
+    , have_pending_handshake_msg_(false)
     , handshake_resend_falloff_(resend_period)
     , auth_state_(AUTH_STATE_HANDSHAKE)
     , handshake_state_(HANDSHAKE_STATE_BEGIN_HANDSHAKE_REQUEST)
@@ -175,6 +177,8 @@ struct DiscoveredParticipant {
   DDS::Security::ParticipantStatelessMessage auth_req_msg_;
   bool have_handshake_msg_;
   DDS::Security::ParticipantStatelessMessage handshake_msg_;
+  bool have_pending_handshake_msg_;
+  DDS::Security::ParticipantStatelessMessage pending_handshake_msg_;
   DCPS::FibonacciSequence<DCPS::TimeDuration> handshake_resend_falloff_;
   DCPS::MonotonicTimePoint stateless_msg_deadline_;
 
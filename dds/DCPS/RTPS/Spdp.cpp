@@ -56,6 +56,11 @@ namespace {
   const Encoding encoding_plain_big(Encoding::KIND_XCDR1, ENDIAN_BIG);
   const Encoding encoding_plain_native(Encoding::KIND_XCDR1);
 
+#if OPENDDS_CONFIG_SECURITY
+  // How often to check on a handshake message being verified asynchronously.
+  const TimeDuration handshake_retry_period = TimeDuration::from_msec(5);
+#endif
+
   bool disposed(const ParameterList& inlineQos)
   {
     for (CORBA::ULong i = 0; i < inlineQos.length(); ++i) {
@@ -1686,98 +1691,136 @@ Spdp::handle_handshake_message(const DDS::Security::ParticipantStatelessMessage&
     return;
   }
 
-  case HANDSHAKE_STATE_PROCESS_HANDSHAKE: {
-    DDS::Security::ParticipantStatelessMessage reply = DDS::Security::ParticipantStatelessMessage();
-    reply.message_identity.source_guid = guid_;
-    reply.message_identity.sequence_number = 0;
-    reply.message_class_id = DDS::Security::GMCLASSID_SECURITY_AUTH_HANDSHAKE;
-    reply.related_message_identity = msg.message_identity;
-    reply.destination_participant_guid = src_participant;
-    reply.destination_endpoint_guid = GUID_UNKNOWN;
-    reply.source_endpoint_guid = GUID_UNKNOWN;
-    reply.message_data.length(1);
+  case HANDSHAKE_STATE_PROCESS_HANDSHAKE:
+    process_handshake(iter, msg);
+    return;
+  }
+}
 
-    DDS::Security::ValidationResult_t vr = auth->process_handshake(reply.message_data[0], msg.message_data[0],
-                                                                   dp.handshake_handle_, se);
-    switch (vr) {
-    case DDS::Security::VALIDATION_FAILED: {
-      if (DCPS::security_debug.auth_warn) {
-        ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: ")
-                   ACE_TEXT("Spdp::handle_handshake_message() - ")
-                   ACE_TEXT("Failed to process incoming handshake message when ")
-                   ACE_TEXT("expecting %C from %C. Security Exception[%d.%d]: %C\n"),
-                   dp.is_requester_ ? "final" : "reply",
-                   DCPS::LogGuid(src_participant).c_str(),
-                   se.code, se.minor_code, se.message.in()));
-      }
-      return;
+void
+Spdp::process_handshake(DiscoveredParticipantIter iter, const DDS::Security::ParticipantStatelessMessage& msg)
+{
+  DDS::Security::SecurityException se = {"", 0, 0};
+  Security::Authentication_var auth = security_config_->get_authentication();
+  const GUID_t& src_participant = iter->first;
+  DiscoveredParticipant& dp = iter->second;
+  dp.have_pending_handshake_msg_ = false;
+
+  DDS::Security::ParticipantStatelessMessage reply = DDS::Security::ParticipantStatelessMessage();
+  reply.message_identity.source_guid = guid_;
+  reply.message_identity.sequence_number = 0;
+  reply.message_class_id = DDS::Security::GMCLASSID_SECURITY_AUTH_HANDSHAKE;
+  reply.related_message_identity = msg.message_identity;
+  reply.destination_participant_guid = src_participant;
+  reply.destination_endpoint_guid = GUID_UNKNOWN;
+  reply.source_endpoint_guid = GUID_UNKNOWN;
+  reply.message_data.length(1);
+
+  DDS::Security::ValidationResult_t vr = auth->process_handshake(reply.message_data[0], msg.message_data[0],
+                                                                 dp.handshake_handle_, se);
+  switch (vr) {
+  case DDS::Security::VALIDATION_FAILED: {
+    if (DCPS::security_debug.auth_warn) {
+      ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: ")
+                 ACE_TEXT("Spdp::handle_handshake_message() - ")
+                 ACE_TEXT("Failed to process incoming handshake message when ")
+                 ACE_TEXT("expecting %C from %C. Security Exception[%d.%d]: %C\n"),
+                 dp.is_requester_ ? "final" : "reply",
+                 DCPS::LogGuid(src_participant).c_str(),
+                 se.code, se.minor_code, se.message.in()));
     }
-    case DDS::Security::VALIDATION_PENDING_RETRY: {
+    return;
+  }
+  case DDS::Security::VALIDATION_PENDING_RETRY: {
+    // The plugin is verifying the message on one of its threads.  Keep the
+    // message to pick up the result without waiting for a resend.
+    if (&msg != &dp.pending_handshake_msg_) {
+      dp.pending_handshake_msg_ = msg;
+    }
+    dp.have_pending_handshake_msg_ = true;
+    tport_->handshake_retry_task_->schedule(handshake_retry_period);
+    return;
+  }
+  case DDS::Security::VALIDATION_PENDING_HANDSHAKE_REQUEST: {
+    if (DCPS::security_debug.auth_warn) {
+      ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: Spdp::handle_handshake_message() - ")
+                 ACE_TEXT("Unexpected validation pending handshake request\n")));
+    }
+    return;
+  }
+  case DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE: {
+    // Theoretically, this shouldn't happen unless handshakes can involve more than 3 messages
+    if (send_handshake_message(src_participant, dp, reply) != DDS::RETCODE_OK) {
       if (DCPS::security_debug.auth_warn) {
         ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: Spdp::handle_handshake_message() - ")
-                   ACE_TEXT("Unexpected validation pending retry\n")));
+                   ACE_TEXT("Unable to write stateless message for handshake reply.\n")));
       }
       return;
+    } else {
+      if (DCPS::security_debug.auth_debug) {
+        ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {auth_debug} DEBUG: Spdp::handle_handshake_message() - ")
+                   ACE_TEXT("Sent handshake unknown message for participant: %C\n"),
+                   DCPS::LogGuid(src_participant).c_str()));
+      }
     }
-    case DDS::Security::VALIDATION_PENDING_HANDSHAKE_REQUEST: {
+    return;
+  }
+  case DDS::Security::VALIDATION_OK_FINAL_MESSAGE: {
+    set_auth_state(dp, AUTH_STATE_AUTHENTICATED);
+    dp.handshake_state_ = HANDSHAKE_STATE_DONE;
+    // Install the shared secret before sending the final so that
+    // we are prepared to receive the crypto tokens from the
+    // replier.
+
+    // Send the final first because match_authenticated takes forever.
+    if (send_handshake_message(src_participant, iter->second, reply) != DDS::RETCODE_OK) {
       if (DCPS::security_debug.auth_warn) {
         ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: Spdp::handle_handshake_message() - ")
-                   ACE_TEXT("Unexpected validation pending handshake request\n")));
+                   ACE_TEXT("Unable to write stateless message for final message.\n")));
       }
       return;
-    }
-    case DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE: {
-      // Theoretically, this shouldn't happen unless handshakes can involve more than 3 messages
-      if (send_handshake_message(src_participant, dp, reply) != DDS::RETCODE_OK) {
-        if (DCPS::security_debug.auth_warn) {
-          ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: Spdp::handle_handshake_message() - ")
-                     ACE_TEXT("Unable to write stateless message for handshake reply.\n")));
-        }
-        return;
-      } else {
-        if (DCPS::security_debug.auth_debug) {
-          ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {auth_debug} DEBUG: Spdp::handle_handshake_message() - ")
-                     ACE_TEXT("Sent handshake unknown message for participant: %C\n"),
-                     DCPS::LogGuid(src_participant).c_str()));
-        }
+    } else {
+      if (DCPS::security_debug.auth_debug) {
+        ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {auth_debug} DEBUG: Spdp::handle_handshake_message() - ")
+                   ACE_TEXT("Sent handshake final for participant: %C\n"),
+                   DCPS::LogGuid(src_participant).c_str()));
       }
-      return;
     }
-    case DDS::Security::VALIDATION_OK_FINAL_MESSAGE: {
-      set_auth_state(dp, AUTH_STATE_AUTHENTICATED);
-      dp.handshake_state_ = HANDSHAKE_STATE_DONE;
-      // Install the shared secret before sending the final so that
-      // we are prepared to receive the crypto tokens from the
-      // replier.
 
-      // Send the final first because match_authenticated takes forever.
-      if (send_handshake_message(src_participant, iter->second, reply) != DDS::RETCODE_OK) {
-        if (DCPS::security_debug.auth_warn) {
-          ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) {auth_warn} WARNING: Spdp::handle_handshake_message() - ")
-                     ACE_TEXT("Unable to write stateless message for final message.\n")));
-        }
-        return;
-      } else {
-        if (DCPS::security_debug.auth_debug) {
-          ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {auth_debug} DEBUG: Spdp::handle_handshake_message() - ")
-                     ACE_TEXT("Sent handshake final for participant: %C\n"),
-                     DCPS::LogGuid(src_participant).c_str()));
-        }
-      }
+    purge_handshake_deadlines(iter);
+    match_authenticated(src_participant, iter);
+    return;
+  }
+  case DDS::Security::VALIDATION_OK: {
+    set_auth_state(dp, AUTH_STATE_AUTHENTICATED);
+    dp.handshake_state_ = HANDSHAKE_STATE_DONE;
+    purge_handshake_deadlines(iter);
+    match_authenticated(src_participant, iter);
+    return;
+  }
+  }
+}
 
-      purge_handshake_deadlines(iter);
-      match_authenticated(src_participant, iter);
-      return;
-    }
-    case DDS::Security::VALIDATION_OK: {
-      set_auth_state(dp, AUTH_STATE_AUTHENTICATED);
-      dp.handshake_state_ = HANDSHAKE_STATE_DONE;
-      purge_handshake_deadlines(iter);
-      match_authenticated(src_participant, iter);
-      return;
+void
+Spdp::process_handshake_retries(const DCPS::MonotonicTimePoint& /*now*/)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, lock_);
+
+  if (!initialized_flag_ || shutdown_flag_) {
+    return;
+  }
+
+  for (DiscoveredParticipantIter pos = participants_.begin(); pos != participants_.end(); ++pos) {
+    DiscoveredParticipant& dp = pos->second;
+    if (!dp.have_pending_handshake_msg_) {
+      continue;
     }
+    if (dp.handshake_state_ != HANDSHAKE_STATE_PROCESS_HANDSHAKE) {
+      dp.have_pending_handshake_msg_ = false;
+      continue;
     }
-  }
+    // match_authenticated doesn't add or remove participants.
+    process_handshake(pos, dp.pending_handshake_msg_);
   }
 }
 
@@ -2482,6 +2525,9 @@ Spdp::SpdpTransport::open(const DCPS::ReactorTask_rch& reactor_task,
   handshake_resend_task_ =
     DCPS::make_rch<SpdpSporadic>(TheServiceParticipant->time_source(), reactor_task->interceptor(),
                                  rchandle_from(this), &SpdpTransport::process_handshake_resends);
+  handshake_retry_task_ =
+    DCPS::make_rch<SpdpSporadic>(TheServiceParticipant->time_source(), reactor_task->interceptor(),
+                                 rchandle_from(this), &SpdpTransport::process_handshake_retries);
 
   relay_spdp_task_ =
     DCPS::make_rch<SpdpSporadic>(TheServiceParticipant->time_source(), reactor_task->interceptor(),
@@ -2658,6 +2704,9 @@ Spdp::SpdpTransport::close(const DCPS::ReactorTask_rch& reactor_task)
   if (handshake_resend_task_) {
     handshake_resend_task_->cancel();
   }
+  if (handshake_retry_task_) {
+    handshake_retry_task_->cancel();
+  }
   if (relay_spdp_task_) {
     relay_spdp_task_->cancel();
   }
@@ -4505,6 +4554,14 @@ void Spdp::SpdpTransport::process_handshake_resends(const DCPS::MonotonicTimePoi
   outer->process_handshake_resends(now);
 }
 
+void Spdp::SpdpTransport::process_handshake_retries(const DCPS::MonotonicTimePoint& now)
+{
+  DCPS::RcHandle<Spdp> outer = outer_.lock();
+  if (!outer) return;
+
+  outer->process_handshake_retries(now);
+}
+
 void Spdp::purge_handshake_deadlines(DiscoveredParticipantIter iter)
 {
   if (iter == participants_.end()) {
@@ -4530,6 +4587,7 @@ void Spdp::purge_handshake_resends(DiscoveredParticipantIter iter)
 
   iter->second.have_auth_req_msg_ = false;
   iter->second.have_handshake_msg_ = false;
+  iter->second.have_pending_handshake_msg_ = false;
   iter->second.handshake_resend_falloff_.set(auth_resend_period_);
 
   std::pair<TimeQueue::iterator, TimeQueue::iterator> range = handshake_resends_.equal_range(iter->second.stateless_msg_deadline_);
@@ -148,6 +148,7 @@ public:
 #if OPENDDS_CONFIG_SECURITY
   void process_handshake_deadlines(const DCPS::MonotonicTimePoint& tv);
   void process_handshake_resends(const DCPS::MonotonicTimePoint& tv);
+  void process_handshake_retries(const DCPS::MonotonicTimePoint& tv);
 
   /**
    * Write Secured Updated DP QOS
@@ -431,6 +432,9 @@ private:
                                            DiscoveredParticipant& dp,
                                            const DDS::Security::ParticipantStatelessMessage& msg);
   DCPS::MonotonicTimePoint schedule_handshake_resend(const DCPS::TimeDuration& time, const DCPS::GUID_t& guid);
+  /// Process a handshake reply or final from the peer.  lock_ must be held.
+  void process_handshake(DiscoveredParticipantIter iter,
+                         const DDS::Security::ParticipantStatelessMessage& msg);
   bool match_authenticated(const DCPS::GUID_t& guid, DiscoveredParticipantIter& iter);
   void attempt_authentication(const DiscoveredParticipantIter& iter, bool from_discovery);
   void update_agent_info(const DCPS::GUID_t& local_guid, const ICE::AgentInfo& agent_info);
@@ -554,6 +558,8 @@ private:
     DCPS::RcHandle<SpdpSporadic> handshake_deadline_task_;
     void process_handshake_resends(const DCPS::MonotonicTimePoint& now);
     DCPS::RcHandle<SpdpSporadic> handshake_resend_task_;
+    void process_handshake_retries(const DCPS::MonotonicTimePoint& now);
+    DCPS::RcHandle<SpdpSporadic> handshake_retry_task_;
     void send_relay(const DCPS::MonotonicTimePoint& now);
     DCPS::RcHandle<SpdpSporadic> relay_spdp_task_;
     void relay_stun_task(const DCPS::MonotonicTimePoint& now);
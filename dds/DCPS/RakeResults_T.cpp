@@ -34,6 +34,8 @@ RakeResults<MessageType>::RakeResults(DataReaderImpl* reader,
   , max_samples_(max_samples)
 #ifndef OPENDDS_NO_QUERY_CONDITION
   , cond_(cond)
+  , qci_(0)
+  , order_index_(0)
 #endif
   , oper_(oper)
   , do_sort_(false)
@@ -42,30 +44,23 @@ RakeResults<MessageType>::RakeResults(DataReaderImpl* reader,
 #ifndef OPENDDS_NO_QUERY_CONDITION
 
   if (cond_) {
-    const QueryConditionImpl* qci = dynamic_cast<QueryConditionImpl*>(cond_);
-    if (!qci) {
+    qci_ = dynamic_cast<QueryConditionImpl*>(cond_);
+    if (!qci_) {
       ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RakeResults(): ")
         ACE_TEXT("failed to obtain QueryConditionImpl\n")));
       return;
     }
-    do_filter_ = qci->hasFilter();
-    std::vector<String> order_bys = qci->getOrderBys();
-    do_sort_ = order_bys.size() > 0;
+    do_filter_ = qci_->hasFilter();
 
-    if (do_sort_) {
-      ComparatorBase::Ptr cmp;
-
-      // Iterate in reverse over the comma-separated fields so that the
-      // top-level comparison is the leftmost.  The others will be chained.
-      for (size_t i = order_bys.size(); i > 0; --i) {
-        const String& fieldspec = order_bys[i - 1];
-        //FUTURE: handle ASC / DESC as an extension to the DDS spec?
-        cmp = getMetaStruct<MessageType>().create_qc_comparator(fieldspec.c_str(), cmp);
-      }
+    // The condition builds the comparator for its ORDER BY fields once.
+    const ComparatorBase::Ptr cmp = qci_->order_comparator();
+    do_sort_ = cmp.in() != 0;
 
+    if (do_sort_) {
       SortedSetCmp comparator(cmp);
       SortedSet actual_sort(comparator);
       sorted_.swap(actual_sort);
+      order_index_ = qci_->order_index();
     }
 
   } else {
@@ -86,12 +81,8 @@ bool RakeResults<MessageType>::insert_sample(ReceivedDataElement* sample,
 {
 #ifndef OPENDDS_NO_QUERY_CONDITION
 
-  if (do_filter_) {
-    const QueryConditionImpl* qci = dynamic_cast<QueryConditionImpl*>(cond_);
-    const MessageType* typed_sample = static_cast<MessageType*>(sample->registered_data_);
-    if (!qci || !typed_sample || !qci->filter(*typed_sample, !sample->valid_data_)) {
-      return false;
-    }
+  if (do_filter_ && !qci_->filter(sample)) {
+    return false;
   }
 
 #endif
@@ -104,6 +95,12 @@ bool RakeResults<MessageType>::insert_sample(ReceivedDataElement* sample,
 #endif
 
     RakeData rd = {sample, rdel, instance, index_in_instance};
+#ifndef OPENDDS_NO_QUERY_CONDITION
+    if (order_index_) {
+      candidates_.insert(std::make_pair(sample, rd));
+      return true;
+    }
+#endif
     sorted_.insert(rd);
 
   } else {
@@ -227,6 +224,15 @@ bool RakeResults<MessageType>::copy_to_user()
 {
   MessageSequenceAdapterType received_data_p(received_data_);
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  if (order_index_ && select_from_index()) {
+    size_t len = unsorted_.size(); //can't be larger than max_samples_
+    received_data_p.internal_set_length(static_cast<CORBA::ULong>(len));
+    info_seq_.length(static_cast<CORBA::ULong>(len));
+    return copy_into(unsorted_.begin(), unsorted_.end(), received_data_p);
+  }
+#endif
+
   if (do_sort_) {
     size_t len = std::min(static_cast<size_t>(sorted_.size()),
                           static_cast<size_t>(max_samples_));
@@ -242,6 +248,36 @@ bool RakeResults<MessageType>::copy_to_user()
   }
 }
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+template <class MessageType>
+bool RakeResults<MessageType>::select_from_index()
+{
+  // Walking the index visits the matching samples that aren't candidates,
+  // so sorting is cheaper when the candidates are a small part of it, for
+  // example when the sample states only select the samples not yet read.
+  static const size_t index_walk_ratio = 8;
+  const size_t wanted = std::min(candidates_.size(), static_cast<size_t>(max_samples_));
+  if (candidates_.size() * index_walk_ratio >= order_index_->size()) {
+    for (QueryConditionImpl::OrderIndex::const_iterator it = order_index_->begin();
+         it != order_index_->end() && unsorted_.size() < wanted; ++it) {
+      const typename Candidates::const_iterator pos = candidates_.find(*it);
+      if (pos != candidates_.end()) {
+        unsorted_.push_back(pos->second);
+      }
+    }
+    if (unsorted_.size() == wanted) {
+      return true;
+    }
+    unsorted_.clear();
+  }
+
+  for (typename Candidates::const_iterator it = candidates_.begin(); it != candidates_.end(); ++it) {
+    sorted_.insert(it->second);
+  }
+  return false;
+}
+#endif
+
 } // namespace DCPS
 } // namespace OpenDDS
 
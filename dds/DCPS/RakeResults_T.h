@@ -13,6 +13,7 @@
 
 #include "Comparator_T.h"
 #include "PoolAllocator.h"
+#include "QueryConditionImpl.h"
 #include "RakeData.h"
 #include "TypeSupportImpl.h"
 
@@ -60,6 +61,12 @@ private:
   bool copy_into(FwdIter begin, FwdIter end,
                  MessageSequenceAdapterType& received_data_p);
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  /// Put the candidates in unsorted_ in the order of order_index_.  Returns
+  /// false if they were put in sorted_ instead.
+  bool select_from_index();
+#endif
+
   RakeResults(const RakeResults&); // no copy construction
   RakeResults& operator=(const RakeResults&); // no assignment
 
@@ -69,6 +76,9 @@ private:
   CORBA::ULong max_samples_;
 #ifndef OPENDDS_NO_QUERY_CONDITION
   DDS::QueryCondition_ptr cond_;
+  QueryConditionImpl* qci_;
+  /// Samples that match cond_ in ORDER BY order, kept by the condition
+  const QueryConditionImpl::OrderIndex* order_index_;
 #endif
   Operation_t oper_;
 
@@ -101,6 +111,12 @@ private:
   // Contains data for all other use cases
   OPENDDS_VECTOR(RakeData) unsorted_;
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  // Contains data for QueryCondition with an ORDER BY index
+  typedef OPENDDS_MAP(ReceivedDataElement*, RakeData) Candidates;
+  Candidates candidates_;
+#endif
+
   // data structures used by copy_into()
   typedef OPENDDS_VECTOR(CORBA::ULong) IndexList;
   struct InstanceData {
@@ -10,6 +10,10 @@
 #include "Definitions.h"
 #include "unique_ptr.h"
 
+#ifdef ACE_HAS_CPP11
+#  include <utility>
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -58,6 +62,21 @@ public:
     this->bump_up();
   }
 
+#ifdef ACE_HAS_CPP11
+  // Moving a handle transfers its reference without touching the count.
+  RcHandle(RcHandle&& b)
+    : ptr_(b.ptr_)
+  {
+    b.ptr_ = 0;
+  }
+
+  template <typename U>
+  RcHandle(RcHandle<U>&& other)
+    : ptr_(other._retn())
+  {
+  }
+#endif
+
   ~RcHandle()
   {
     this->bump_down();
@@ -91,6 +110,23 @@ public:
     return *this;
   }
 
+#ifdef ACE_HAS_CPP11
+  RcHandle& operator=(RcHandle&& b)
+  {
+    RcHandle tmp(std::move(b));
+    swap(tmp);
+    return *this;
+  }
+
+  template <class U>
+  RcHandle& operator=(RcHandle<U>&& b)
+  {
+    RcHandle<T> tmp(std::move(b));
+    swap(tmp);
+    return *this;
+  }
+#endif
+
   template <typename U>
   RcHandle& operator=(unique_ptr<U> b)
   {
@@ -216,6 +252,26 @@ RcHandle<T> dynamic_rchandle_cast(const RcHandle<U>& h)
   return RcHandle<T>(dynamic_cast<T*>(h.in()), inc_count());
 }
 
+#ifdef ACE_HAS_CPP11
+template <typename T, typename U>
+RcHandle<T> static_rchandle_cast(RcHandle<U>&& h)
+{
+  return RcHandle<T>(static_cast<T*>(h._retn()), keep_count());
+}
+
+template <typename T, typename U>
+RcHandle<T> dynamic_rchandle_cast(RcHandle<U>&& h)
+{
+  T* const p = dynamic_cast<T*>(h.in());
+  if (!p) {
+    // h keeps its reference and releases it as usual.
+    return RcHandle<T>();
+  }
+  h._retn();
+  return RcHandle<T>(p, keep_count());
+}
+#endif
+
 
 template< class T >
 class reference_wrapper{
@@ -23,39 +23,91 @@ namespace DCPS {
 
   class RcObject;
 
+  /**
+   * Control block shared by an RcObject and its WeakRcHandles.
+   *
+   * It holds the strong count of the RcObject so that WeakRcHandle::lock
+   * can check for expiration without touching an object that may already
+   * be deleted.  With C++11 the counts are lock-free: increments are
+   * relaxed since a new reference can only be made from an existing one,
+   * decrements are acquire-release so the thread that deletes the object
+   * sees all writes made through other references, and lock only
+   * increments a count that isn't already zero.
+   */
   class OpenDDS_Dcps_Export WeakObject : public PoolAllocationBase
   {
   public:
 
-    WeakObject(RcObject* ptr)
+    explicit WeakObject(RcObject* ptr)
       : ptr_(ptr)
-      , ref_count_(1)
+      , strong_count_(1)
+      , weak_count_(1)
     {
     }
 
     void _add_ref()
     {
-      ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
-      ++ref_count_;
+#ifdef ACE_HAS_CPP11
+      weak_count_.fetch_add(1, std::memory_order_relaxed);
+#else
+      ++weak_count_;
+#endif
     }
 
     void _remove_ref()
     {
-      ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
-      const long new_count = --ref_count_;
-      if (new_count == 0) {
-        guard.release();
+#ifdef ACE_HAS_CPP11
+      if (weak_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+#else
+      if (--weak_count_ == 0) {
+#endif
         delete this;
       }
     }
 
     RcObject* lock();
-    bool check_expire(Atomic<long>& count);
 
   private:
+    friend class RcObject;
+
+    void add_strong_ref()
+    {
+#ifdef ACE_HAS_CPP11
+      strong_count_.fetch_add(1, std::memory_order_relaxed);
+#else
+      ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
+      ++strong_count_;
+#endif
+    }
+
+    /// Returns true if this removed the last strong reference.
+    bool remove_strong_ref()
+    {
+#ifdef ACE_HAS_CPP11
+      return strong_count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#else
+      ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
+      return --strong_count_ == 0;
+#endif
+    }
+
+    long strong_ref_count() const
+    {
+#ifdef ACE_HAS_CPP11
+      return strong_count_.load(std::memory_order_relaxed);
+#else
+      return strong_count_;
+#endif
+    }
+
+#ifndef ACE_HAS_CPP11
+    /// Without compare-and-swap, lock and remove_strong_ref are serialized
+    /// so an expiring object isn't revived.
     mutable ACE_SYNCH_MUTEX mx_;
-    RcObject* ptr_;
-    long ref_count_;
+#endif
+    RcObject* const ptr_;
+    Atomic<long> strong_count_;
+    Atomic<long> weak_count_;
   };
 
   class OpenDDS_Dcps_Export RcObject : public PoolAllocationBase {
@@ -68,19 +120,19 @@ namespace DCPS {
 
     virtual void _add_ref()
     {
-      ++ref_count_;
+      weak_object_->add_strong_ref();
     }
 
     virtual void _remove_ref()
     {
-      if (weak_object_->check_expire(ref_count_)) {
+      if (weak_object_->remove_strong_ref()) {
         delete this;
       }
     }
 
     long ref_count() const
     {
-      return ref_count_;
+      return weak_object_->strong_ref_count();
     }
 
     WeakObject* _get_weak_object() const
@@ -91,13 +143,11 @@ namespace DCPS {
 
   protected:
     RcObject()
-      : ref_count_(1)
-      , weak_object_(new WeakObject(this))
+      : weak_object_(new WeakObject(this))
     {}
 
   private:
-    Atomic<long> ref_count_;
-    WeakObject* weak_object_;
+    WeakObject* const weak_object_;
 
     RcObject(const RcObject&);
     RcObject& operator=(const RcObject&);
@@ -105,22 +155,24 @@ namespace DCPS {
 
   inline RcObject* WeakObject::lock()
   {
-    ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
-    if (ptr_) {
-      ptr_->_add_ref();
+#ifdef ACE_HAS_CPP11
+    long count = strong_count_.load(std::memory_order_relaxed);
+    while (count != 0) {
+      if (strong_count_.compare_exchange_weak(count, count + 1,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+        return ptr_;
+      }
     }
-    return ptr_;
-  }
-
-  inline bool WeakObject::check_expire(Atomic<long>& count)
-  {
+    return 0;
+#else
     ACE_Guard<ACE_SYNCH_MUTEX> guard(mx_);
-    const long new_count = --count;
-    if (new_count == 0 && ptr_) {
-      ptr_ = 0;
-      return true;
+    if (strong_count_ == 0) {
+      return 0;
     }
-    return false;
+    ++strong_count_;
+    return ptr_;
+#endif
   }
 
   template <typename T>
@@ -154,6 +206,16 @@ namespace DCPS {
       }
     }
 
+#ifdef ACE_HAS_CPP11
+    WeakRcHandle(WeakRcHandle&& other)
+      : weak_object_(other.weak_object_)
+      , cached_(other.cached_)
+    {
+      other.weak_object_ = 0;
+      other.cached_ = 0;
+    }
+#endif
+
     ~WeakRcHandle()
     {
       if (weak_object_) {
@@ -169,6 +231,16 @@ namespace DCPS {
        return *this;
     }
 
+#ifdef ACE_HAS_CPP11
+    WeakRcHandle& operator=(WeakRcHandle&& other)
+    {
+       WeakRcHandle tmp(static_cast<WeakRcHandle&&>(other));
+       std::swap(weak_object_, tmp.weak_object_);
+       std::swap(cached_, tmp.cached_);
+       return *this;
+    }
+#endif
+
     WeakRcHandle& operator=(const RcHandle<T>& other)
     {
        WeakRcHandle tmp(other);
@@ -12,6 +12,7 @@
 #include "ReactorTask.inl"
 #endif /* __ACE_INLINE__ */
 
+#include "ConfigStoreImpl.h"
 #include "Service_Participant.h"
 #include "Timers.h"
 
@@ -21,6 +22,7 @@
 #include <ace/Proactor_Impl.h>
 #include <ace/WIN32_Proactor.h>
 #include <ace/OS_NS_Thread.h>
+#include <ace/OS_NS_sched.h>
 
 #include <exception>
 #include <cstring>
@@ -50,6 +52,48 @@ ReactorTask::~ReactorTask()
   cleanup();
 }
 
+bool ReactorTask::parse_cpu_list(const String& list, OPENDDS_VECTOR(size_t)& cpus)
+{
+  cpus.clear();
+  const OPENDDS_VECTOR(String) ranges = split(list, ", ", true, true);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const String& range = ranges[i];
+    const String::size_type dash = range.find('-');
+    size_t first = 0;
+    size_t last = 0;
+    if (dash == String::npos) {
+      if (!convertToInteger(range, first)) {
+        return false;
+      }
+      last = first;
+    } else if (!convertToInteger(range.substr(0, dash), first) ||
+               !convertToInteger(range.substr(dash + 1), last) ||
+               last < first) {
+      return false;
+    }
+    for (size_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return true;
+}
+
+bool ReactorTask::parse_scheduler(const String& name, long& sched_flags)
+{
+  if (name.empty()) {
+    sched_flags = 0;
+  } else if (name == "SCHED_OTHER") {
+    sched_flags = THR_SCHED_DEFAULT;
+  } else if (name == "SCHED_RR") {
+    sched_flags = THR_SCHED_RR;
+  } else if (name == "SCHED_FIFO") {
+    sched_flags = THR_SCHED_FIFO;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 void ReactorTask::wait_for_startup_i() const
 {
   while (state_ == STATE_UNINITIALIZED || state_ == STATE_OPENING) {
@@ -78,7 +122,8 @@ void ReactorTask::cleanup()
 }
 
 int ReactorTask::open_reactor_task(ThreadStatusManager* thread_status_manager,
-                                   const String& name)
+                                   const String& name,
+                                   const ThreadOptions& thread_options)
 {
   GuardType guard(lock_);
 
@@ -88,6 +133,7 @@ int ReactorTask::open_reactor_task(ThreadStatusManager* thread_status_manager,
   // thread status reporting support
   thread_status_manager_ = thread_status_manager;
   name_ = name;
+  thread_options_ = thread_options;
 
   // Set our reactor and proactor pointers to a new reactor/proactor objects.
 #ifdef OPENDDS_REACTOR_TASK_ASYNC
@@ -112,7 +158,20 @@ int ReactorTask::open_reactor_task(ThreadStatusManager* thread_status_manager,
   state_ = STATE_OPENING;
   condition_.notify_all();
 
-  if (activate(THR_NEW_LWP | THR_JOINABLE, 1) != 0) {
+  const long flags = THR_NEW_LWP | THR_JOINABLE;
+  bool activated = false;
+  if (thread_options_.sched_flags != 0) {
+    activated = activate(flags | thread_options_.sched_flags, 1, 0, thread_options_.priority) == 0;
+    if (!activated && log_level >= LogLevel::Warning) {
+      // Usually because the process isn't allowed to use the class.
+      ACE_ERROR((LM_WARNING,
+                 "(%P|%t) WARNING: ReactorTask::open_reactor_task: "
+                 "could not set scheduling class of %C (%p), using the default\n",
+                 name_.c_str(), ACE_TEXT("activate")));
+    }
+  }
+
+  if (!activated && activate(flags, 1) != 0) {
     ACE_ERROR_RETURN((LM_ERROR,
                       "(%P|%t) ERROR: ReactorTask Failed to activate "
                       "itself.\n"),
@@ -153,6 +212,8 @@ int ReactorTask::svc()
     }
     reactor_owner_ = ACE_Thread_Manager::instance()->thr_self();
 
+    apply_cpu_affinity();
+
     interceptor_ = make_rch<Interceptor>(this, reactor_, reactor_owner_);
 
     // Advance the state.
@@ -186,6 +247,38 @@ int ReactorTask::svc()
   return 0;
 }
 
+void ReactorTask::apply_cpu_affinity()
+{
+  if (thread_options_.cpus.empty()) {
+    return;
+  }
+
+#ifdef ACE_HAS_SCHED_SETAFFINITY
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (size_t i = 0; i < thread_options_.cpus.size(); ++i) {
+    if (thread_options_.cpus[i] < static_cast<size_t>(CPU_SETSIZE)) {
+      CPU_SET(thread_options_.cpus[i], &cpu_set);
+    }
+  }
+
+  // A pid of 0 is the calling thread.
+  if (ACE_OS::sched_setaffinity(0, sizeof cpu_set, &cpu_set) != 0 && log_level >= LogLevel::Warning) {
+    ACE_ERROR((LM_WARNING,
+               "(%P|%t) WARNING: ReactorTask::apply_cpu_affinity: "
+               "could not set CPU affinity of %C: %p\n",
+               name_.c_str(), ACE_TEXT("sched_setaffinity")));
+  }
+#else
+  if (log_level >= LogLevel::Warning) {
+    ACE_ERROR((LM_WARNING,
+               "(%P|%t) WARNING: ReactorTask::apply_cpu_affinity: "
+               "CPU affinity is not supported on this platform, ignoring it for %C\n",
+               name_.c_str()));
+  }
+#endif
+}
+
 int ReactorTask::close(u_long flags)
 {
   ACE_UNUSED_ARG(flags);
@@ -9,6 +9,8 @@
 #define OPENDDS_DCPS_REACTORTASK_H
 
 #include "dcps_export.h"
+#include "Atomic.h"
+#include "PoolAllocator.h"
 #include "RcObject.h"
 #include "TimeTypes.h"
 #include "ReactorInterceptor.h"
@@ -39,9 +41,31 @@ public:
   explicit ReactorTask(bool useAsyncSend);
   virtual ~ReactorTask();
 
+  /// Scheduling class, priority, and CPU placement of the reactor thread.
+  struct ThreadOptions {
+    ThreadOptions()
+      : sched_flags(0)
+      , priority(ACE_DEFAULT_THREAD_PRIORITY)
+    {}
+
+    /// THR_SCHED_* flag for activate(), 0 to inherit the creating thread's.
+    long sched_flags;
+    long priority;
+    /// CPUs the thread may run on, empty to not restrict it.
+    OPENDDS_VECTOR(size_t) cpus;
+  };
+
+  /// Parse a CPU list like "0,2,4-7".  An empty list is valid.
+  static bool parse_cpu_list(const String& list, OPENDDS_VECTOR(size_t)& cpus);
+
+  /// Parse SCHED_OTHER, SCHED_RR, or SCHED_FIFO into a THR_SCHED_* flag.
+  /// An empty name is valid and results in 0.
+  static bool parse_scheduler(const String& name, long& sched_flags);
+
 public:
   int open_reactor_task(ThreadStatusManager* thread_status_manager = 0,
-                        const String& name = "");
+                        const String& name = "",
+                        const ThreadOptions& thread_options = ThreadOptions());
 
   virtual int open(void*) { return open_reactor_task(); }
   virtual int svc();
@@ -72,6 +96,7 @@ private:
 
   void cleanup();
   void wait_for_startup_i() const;
+  void apply_cpu_affinity();
 
   typedef ACE_SYNCH_MUTEX LockType;
   typedef ACE_Guard<LockType> GuardType;
@@ -116,6 +141,42 @@ private:
   // thread status reporting
   String name_;
   ThreadStatusManager* thread_status_manager_;
+
+  ThreadOptions thread_options_;
+};
+
+/// Reactor tasks that are handed out round robin, so that each DataLink
+/// is serviced by one thread and links are spread over all of them.
+class ReactorTaskPool {
+public:
+  ReactorTaskPool()
+    : next_(0)
+  {}
+
+  /// Not thread safe; tasks are added before the pool is used.
+  void add(const RcHandle<ReactorTask>& task) { tasks_.push_back(task); }
+
+  size_t size() const { return tasks_.size(); }
+
+  /// The next task, or a nil handle if the pool is empty.
+  RcHandle<ReactorTask> next()
+  {
+    if (tasks_.empty()) {
+      return RcHandle<ReactorTask>();
+    }
+    return tasks_[next_++ % tasks_.size()];
+  }
+
+  void stop()
+  {
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+      tasks_[i]->stop();
+    }
+  }
+
+private:
+  OPENDDS_VECTOR(RcHandle<ReactorTask>) tasks_;
+  Atomic<size_t> next_;
 };
 
 } // namespace DCPS
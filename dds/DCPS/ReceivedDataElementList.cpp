@@ -149,6 +149,16 @@ OpenDDS::DCPS::ReceivedDataElementList::remove(ReceivedDataElement* item)
 
   bool released = false;
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  if (item->query_indexed_) {
+    const DataReaderImpl_rch reader = reader_.lock();
+    if (reader) {
+      reader->query_conditions_sample_removed(item);
+    }
+    item->query_indexed_ = false;
+  }
+#endif
+
   size_--;
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   if (!item->coherent_change_)
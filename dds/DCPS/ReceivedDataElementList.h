@@ -14,6 +14,7 @@
 #include "Definitions.h"
 #include "GuidUtils.h"
 #include "InstanceState.h"
+#include "PoolAllocator.h"
 #include "Time_Helper.h"
 #include "unique_ptr.h"
 
@@ -49,6 +50,9 @@ public:
       sequence_(header.sequence_),
       previous_data_sample_(0),
       next_data_sample_(0),
+#ifndef OPENDDS_NO_QUERY_CONDITION
+      query_indexed_(false),
+#endif
       ref_count_(1),
       mx_(mx)
   {
@@ -136,6 +140,22 @@ public:
   /// the next data sample in the ReceivedDataElementList
   ReceivedDataElement* next_data_sample_;
 
+#ifndef OPENDDS_NO_QUERY_CONDITION
+  /// Result of evaluating a QueryCondition for this data sample.  It's only
+  /// current if generation matches the generation of the condition.
+  struct QueryResult {
+    QueryResult() : generation(0), match(false) {}
+    unsigned long generation;
+    bool match;
+  };
+
+  /// Results of the reader's QueryConditions, indexed by the condition's slot
+  OPENDDS_VECTOR(QueryResult) query_results_;
+
+  /// The data sample is in the ORDER BY index of a QueryCondition
+  bool query_indexed_;
+#endif
+
   void* operator new(size_t size, ACE_New_Allocator& pool);
   void operator delete(void* memory);
   void operator delete(void* memory, ACE_New_Allocator& pool);
@@ -0,0 +1,759 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h> // Only the _pch include should start with DCPS/
+
+#ifndef OPENDDS_SAFETY_PROFILE
+#include "RecordLog.h"
+
+#include "debug.h"
+#include "GuidConverter.h"
+#include "PeriodicTask.h"
+#include "Serializer.h"
+
+#include <dds/DdsDcpsCoreTypeSupportImpl.h>
+#include <dds/DdsDcpsGuidTypeSupportImpl.h>
+
+#include <ace/ACE.h>
+#include <ace/Mem_Map.h>
+#include <ace/OS_NS_fcntl.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  const char magic[] = {'O', 'D', 'D', 'S', 'R', 'L', 'O', 'G'};
+  const ACE_CDR::ULong version = 1;
+  /// magic, version, and segment number
+  const size_t segment_header_size = sizeof magic + 2 * uint32_cdr_size;
+  /// kind and payload length
+  const size_t frame_size = 2 * uint32_cdr_size;
+  const size_t min_buffer_size = 4096;
+
+  /// Encoding of the segment header, record frames, and sample records.
+  /// Writer records use the TypeObject encoding.
+  const Encoding& record_encoding()
+  {
+    static const Encoding encoding(Encoding::KIND_UNALIGNED_CDR, ENDIAN_LITTLE);
+    return encoding;
+  }
+
+  String segment_path(const String& directory, const String& prefix, unsigned long segment)
+  {
+    char name[32];
+    ACE_OS::snprintf(name, sizeof name, "-%06lu.rlog", segment);
+    return directory + ACE_DIRECTORY_SEPARATOR_STR_A + prefix + name;
+  }
+
+  void info_serialized_size(const Encoding& encoding, size_t& size, const RecordLogWriterInfo& info)
+  {
+    serialized_size(encoding, size, info.writer);
+    primitive_serialized_size_ulong(encoding, size);
+    size += info.topic_name.size() + 1;
+    primitive_serialized_size_ulong(encoding, size);
+    size += info.type_name.size() + 1;
+    serialized_size(encoding, size, info.publisher_qos);
+    serialized_size(encoding, size, info.writer_qos);
+    serialized_size(encoding, size, info.type_info);
+    serialized_size(encoding, size, info.type_objects);
+  }
+
+  bool write_info(Serializer& ser, const RecordLogWriterInfo& info)
+  {
+    return (ser << info.writer)
+      && (ser << info.topic_name)
+      && (ser << info.type_name)
+      && (ser << info.publisher_qos)
+      && (ser << info.writer_qos)
+      && (ser << info.type_info)
+      && (ser << info.type_objects);
+  }
+
+  bool read_info(Serializer& ser, RecordLogWriterInfo& info)
+  {
+    return (ser >> info.writer)
+      && (ser >> info.topic_name)
+      && (ser >> info.type_name)
+      && (ser >> info.publisher_qos)
+      && (ser >> info.writer_qos)
+      && (ser >> info.type_info)
+      && (ser >> info.type_objects);
+  }
+}
+
+RecordLogWriterInfo::RecordLogWriterInfo()
+  : writer(GUID_UNKNOWN)
+{
+}
+
+RecordLogWriter::Config::Config()
+  : directory(".")
+  , prefix("record")
+  , segment_size(64 * 1024 * 1024)
+  , batch_size(1024 * 1024)
+  , sync(false)
+  , flush_interval(1)
+{
+}
+
+RecordLogWriter::Stats::Stats()
+  : segments(0)
+  , writers(0)
+  , samples(0)
+  , bytes(0)
+  , commits(0)
+{
+}
+
+RecordLogWriter::RecordLogWriter(const Config& config)
+  : config_(config)
+  , handle_(ACE_INVALID_HANDLE)
+  , segment_(0)
+  , segment_bytes_(0)
+  , segment_samples_(0)
+  , buffer_a_((std::max)(config.batch_size, min_buffer_size))
+  , buffer_b_((std::max)(config.batch_size, min_buffer_size))
+  , buffer_(&buffer_a_)
+  , spare_(&buffer_b_)
+{
+}
+
+RecordLogWriter::~RecordLogWriter()
+{
+  close();
+}
+
+bool RecordLogWriter::open()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  if (handle_ != ACE_INVALID_HANDLE) {
+    return true;
+  }
+
+  // The directory may already exist.
+  ACE_OS::mkdir(config_.directory.c_str());
+
+  ACE_stat st;
+  while (ACE_OS::stat(segment_path(config_.directory, config_.prefix, segment_).c_str(), &st) == 0) {
+    ++segment_;
+  }
+  if (!next_segment_i()) {
+    return false;
+  }
+
+  if (config_.interceptor && !config_.flush_interval.is_zero()) {
+    flush_task_ = make_rch<FlushTask>(config_.interceptor, *this, &RecordLogWriter::flush_task);
+    // Checking twice per interval keeps the wait under 1.5 intervals.
+    flush_task_->enable(false, config_.flush_interval / 2.0);
+  }
+  return true;
+}
+
+void RecordLogWriter::close()
+{
+  RcHandle<FlushTask> flush_task;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+    commit_i();
+    close_i();
+    flush_task.swap(flush_task_);
+  }
+  if (flush_task) {
+    flush_task->disable();
+  }
+}
+
+bool RecordLogWriter::write_writer(const RecordLogWriterInfo& info)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  writers_[info.writer] = info;
+  stats_.writers = writers_.size();
+  // If the log isn't open yet the writer is written when the segment is started.
+  return handle_ == ACE_INVALID_HANDLE || append_writer_i(info);
+}
+
+bool RecordLogWriter::write_sample(const RawDataSample& sample, const SystemTimePoint& recorded)
+{
+  const Encoding& encoding = record_encoding();
+  const size_t header_size = sample.header_.get_serialized_size();
+  const size_t data_size = sample.sample_ ? sample.sample_->total_length() : 0;
+
+  // recorded time, writer, encoding kind, header, and data
+  size_t size = 0;
+  primitive_serialized_size_ulong(encoding, size, 2);
+  serialized_size(encoding, size, sample.publication_id_);
+  primitive_serialized_size_ulong(encoding, size, 3);
+  size += header_size + data_size;
+
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  if (handle_ == ACE_INVALID_HANDLE || !reserve_i(size, &g)) {
+    return false;
+  }
+
+  const DDS::Time_t time = recorded.to_idl_struct();
+  Serializer ser(buffer_, encoding);
+  if (!(ser << ACE_CDR::ULong(RECORD_LOG_SAMPLE)) || !(ser << ACE_CDR::ULong(size)) ||
+      !(ser << time.sec) || !(ser << time.nanosec) ||
+      !(ser << sample.publication_id_) ||
+      !(ser << ACE_CDR::ULong(sample.encoding_kind_)) ||
+      !(ser << ACE_CDR::ULong(header_size)) ||
+      !(*buffer_ << sample.header_)) {
+    return false;
+  }
+
+  Serializer data_ser(buffer_, encoding);
+  if (!(data_ser << ACE_CDR::ULong(data_size))) {
+    return false;
+  }
+  for (const ACE_Message_Block* mb = sample.sample_.get(); mb; mb = mb->cont()) {
+    buffer_->copy(mb->rd_ptr(), mb->length());
+  }
+
+  ++stats_.samples;
+  ++segment_samples_;
+  return buffer_->length() < config_.batch_size || commit_i(&g);
+}
+
+bool RecordLogWriter::flush()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  return commit_i(&g);
+}
+
+bool RecordLogWriter::flush_if_due(const MonotonicTimePoint& now)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  if (buffer_->length() == 0 || config_.flush_interval.is_zero() ||
+      now - first_buffered_ < config_.flush_interval) {
+    return true;
+  }
+  return commit_i(&g);
+}
+
+void RecordLogWriter::flush_task(const MonotonicTimePoint& now)
+{
+  flush_if_due(now);
+}
+
+RecordLogWriter::Stats RecordLogWriter::stats() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, Stats());
+  return stats_;
+}
+
+bool RecordLogWriter::next_segment_i()
+{
+  close_i();
+
+  const String path = segment_path(config_.directory, config_.prefix, segment_);
+  {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, file_mutex_, false);
+    handle_ = ACE_OS::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, ACE_DEFAULT_FILE_PERMS);
+  }
+  if (handle_ == ACE_INVALID_HANDLE) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RecordLogWriter::next_segment_i: "
+                 "failed to open %C: %m\n", path.c_str()));
+    }
+    return false;
+  }
+
+  if (DCPS_debug_level >= 4) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) RecordLogWriter::next_segment_i: started %C\n", path.c_str()));
+  }
+
+  segment_bytes_ = 0;
+  segment_samples_ = 0;
+  ++stats_.segments;
+
+  first_buffered_ = MonotonicTimePoint::now();
+  Serializer ser(buffer_, record_encoding());
+  if (!ser.write_char_array(magic, sizeof magic) ||
+      !(ser << version) ||
+      !(ser << ACE_CDR::ULong(segment_++))) {
+    return false;
+  }
+
+  for (WriterInfoMap::const_iterator it = writers_.begin(); it != writers_.end(); ++it) {
+    if (!append_writer_i(it->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RecordLogWriter::reserve_i(size_t payload_size, Guard* unlock)
+{
+  const size_t size = frame_size + payload_size;
+  // Other threads can add records while the lock is released by commit_i,
+  // so check again after each commit.
+  while (handle_ != ACE_INVALID_HANDLE) {
+    if (segment_samples_ && segment_bytes_ + buffer_->length() + size > config_.segment_size) {
+      // The lock is kept so that the segment header comes first.
+      if (!commit_i() || !next_segment_i()) {
+        return false;
+      }
+    }
+    if (buffer_->space() >= size) {
+      if (buffer_->length() == 0) {
+        first_buffered_ = MonotonicTimePoint::now();
+      }
+      return true;
+    }
+    if (buffer_->length() == 0) {
+      if (buffer_->size(size) != 0) {
+        return false;
+      }
+      first_buffered_ = MonotonicTimePoint::now();
+      return true;
+    }
+    if (!commit_i(unlock)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool RecordLogWriter::append_writer_i(const RecordLogWriterInfo& info)
+{
+  const Encoding& encoding = XTypes::get_typeobject_encoding();
+  size_t size = 0;
+  info_serialized_size(encoding, size, info);
+  if (!reserve_i(size)) {
+    return false;
+  }
+
+  Serializer frame(buffer_, record_encoding());
+  if (!(frame << ACE_CDR::ULong(RECORD_LOG_WRITER)) || !(frame << ACE_CDR::ULong(size))) {
+    return false;
+  }
+  Serializer ser(buffer_, encoding);
+  return write_info(ser, info);
+}
+
+bool RecordLogWriter::commit_i(Guard* unlock)
+{
+  const size_t length = buffer_->length();
+  if (length == 0 || handle_ == ACE_INVALID_HANDLE) {
+    return true;
+  }
+
+  // Waits for the previous commit, after which spare_ is empty.
+  Guard file_guard(file_mutex_);
+  std::swap(buffer_, spare_);
+  segment_bytes_ += length;
+  const unsigned segment = static_cast<unsigned>(segment_ - 1);
+  if (unlock) {
+    unlock->release();
+  }
+
+  const bool ok = ACE::write_n(handle_, spare_->rd_ptr(), length) == static_cast<ssize_t>(length);
+  if (!ok) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RecordLogWriter::commit_i: "
+                 "failed to write %B bytes to segment %u: %m\n", length, segment));
+    }
+  } else if (config_.sync) {
+    ACE_OS::fsync(handle_);
+  }
+  spare_->reset();
+  file_guard.release();
+
+  if (unlock) {
+    unlock->acquire();
+  }
+  if (ok) {
+    stats_.bytes += length;
+    ++stats_.commits;
+  }
+  return ok;
+}
+
+void RecordLogWriter::close_i()
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, file_mutex_);
+  if (handle_ != ACE_INVALID_HANDLE) {
+    ACE_OS::close(handle_);
+    handle_ = ACE_INVALID_HANDLE;
+  }
+}
+
+const size_t RecordLogReader::npos = static_cast<size_t>(-1);
+
+RecordLogReader::RecordLogReader(const String& directory, const String& prefix)
+  : directory_(directory)
+  , prefix_(prefix)
+{
+}
+
+RecordLogReader::~RecordLogReader()
+{
+  close();
+}
+
+bool RecordLogReader::open()
+{
+  close();
+
+  ACE_stat st;
+  for (unsigned long number = 0;
+       ACE_OS::stat(segment_path(directory_, prefix_, number).c_str(), &st) == 0; ++number) {
+    const String path = segment_path(directory_, prefix_, number);
+    Segment segment = {0, 0, 0};
+    if (st.st_size > 0) {
+      segment.map = new ACE_Mem_Map;
+      if (segment.map->map(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()), static_cast<size_t>(-1),
+                           O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) != 0) {
+        if (log_level >= LogLevel::Error) {
+          ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RecordLogReader::open: "
+                     "failed to map %C: %m\n", path.c_str()));
+        }
+        delete segment.map;
+        return false;
+      }
+      segment.data = static_cast<const char*>(segment.map->addr());
+      segment.size = segment.map->size();
+    }
+    segments_.push_back(segment);
+    if (!scan(segments_.size() - 1)) {
+      if (log_level >= LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordLogReader::open: "
+                   "%C is not a record log segment\n", path.c_str()));
+      }
+    }
+  }
+
+  std::stable_sort(entries_.begin(), entries_.end(), EntryLessThan());
+
+  topic_positions_.resize(topics_.size());
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (entries_[i].topic != npos) {
+      topic_positions_[entries_[i].topic].push_back(i);
+    }
+    writer_positions_[entries_[i].writer].push_back(i);
+  }
+
+  if (DCPS_debug_level >= 4) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) RecordLogReader::open: indexed %B samples of %B topics "
+               "in %B segments\n", entries_.size(), topics_.size(), segments_.size()));
+  }
+  return true;
+}
+
+void RecordLogReader::close()
+{
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    delete segments_[i].map;
+  }
+  segments_.clear();
+  entries_.clear();
+  topics_.clear();
+  topic_positions_.clear();
+  writers_.clear();
+  writer_positions_.clear();
+}
+
+size_t RecordLogReader::topic(const String& topic_name) const
+{
+  const OPENDDS_VECTOR(String)::const_iterator it =
+    std::find(topics_.begin(), topics_.end(), topic_name);
+  return it == topics_.end() ? npos : it - topics_.begin();
+}
+
+const RecordLogWriterInfo* RecordLogReader::writer_info(const GUID_t& writer) const
+{
+  const WriterInfoMap::const_iterator it = writers_.find(writer);
+  return it == writers_.end() ? 0 : &it->second;
+}
+
+const RecordLogReader::Positions& RecordLogReader::topic_positions(size_t topic) const
+{
+  return topic < topic_positions_.size() ? topic_positions_[topic] : empty_;
+}
+
+const RecordLogReader::Positions& RecordLogReader::writer_positions(const GUID_t& writer) const
+{
+  const WriterPositionsMap::const_iterator it = writer_positions_.find(writer);
+  return it == writer_positions_.end() ? empty_ : it->second;
+}
+
+size_t RecordLogReader::seek(const SystemTimePoint& time) const
+{
+  Entry entry;
+  entry.recorded = time;
+  return std::lower_bound(entries_.begin(), entries_.end(), entry, EntryLessThan()) - entries_.begin();
+}
+
+size_t RecordLogReader::seek(const Positions& positions, const SystemTimePoint& time) const
+{
+  size_t begin = 0;
+  size_t count = positions.size();
+  while (count) {
+    const size_t step = count / 2;
+    if (entries_[positions[begin + step]].recorded < time) {
+      begin += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return begin;
+}
+
+bool RecordLogReader::read(size_t position, RawDataSample& sample) const
+{
+  if (position >= entries_.size()) {
+    return false;
+  }
+  const Entry& entry = entries_[position];
+  const Segment& segment = segments_[entry.segment];
+  const Encoding& encoding = record_encoding();
+
+  ACE_Message_Block mb(segment.data + entry.offset, entry.length);
+  mb.wr_ptr(entry.length);
+  Serializer ser(&mb, encoding);
+  ACE_CDR::Long sec;
+  ACE_CDR::ULong nanosec, kind, header_size;
+  GUID_t writer;
+  if (!(ser >> sec) || !(ser >> nanosec) || !(ser >> writer) ||
+      !(ser >> kind) || !(ser >> header_size) || header_size > mb.length()) {
+    return false;
+  }
+
+  ACE_Message_Block header_mb(mb.rd_ptr(), header_size);
+  header_mb.wr_ptr(header_size);
+  const DataSampleHeader header(header_mb);
+  if (header_mb.length() != 0) {
+    return false;
+  }
+  mb.rd_ptr(header_size);
+
+  Serializer data_ser(&mb, encoding);
+  ACE_CDR::ULong data_size;
+  if (!(data_ser >> data_size) || data_size > mb.length()) {
+    return false;
+  }
+  const Message_Block_Ptr data(new ACE_Message_Block(data_size));
+  data->copy(mb.rd_ptr(), data_size);
+
+  RawDataSample result(header,
+                       static_cast<MessageId>(header.message_id_),
+                       header.source_timestamp_sec_,
+                       header.source_timestamp_nanosec_,
+                       header.publication_id_,
+                       header.byte_order_,
+                       data.get(),
+                       static_cast<Encoding::Kind>(kind));
+  swap(sample, result);
+  return true;
+}
+
+bool RecordLogReader::scan(size_t index)
+{
+  const Segment& segment = segments_[index];
+  if (segment.size < segment_header_size ||
+      ACE_OS::memcmp(segment.data, magic, sizeof magic) != 0) {
+    return false;
+  }
+
+  const Encoding& encoding = record_encoding();
+  ACE_Message_Block header_mb(segment.data + sizeof magic, uint32_cdr_size);
+  header_mb.wr_ptr(uint32_cdr_size);
+  Serializer header_ser(&header_mb, encoding);
+  ACE_CDR::ULong segment_version;
+  if (!(header_ser >> segment_version) || segment_version != version) {
+    return false;
+  }
+
+  size_t pos = segment_header_size;
+  while (pos + frame_size <= segment.size) {
+    ACE_Message_Block frame_mb(segment.data + pos, frame_size);
+    frame_mb.wr_ptr(frame_size);
+    Serializer frame(&frame_mb, encoding);
+    ACE_CDR::ULong kind, length;
+    if (!(frame >> kind) || !(frame >> length)) {
+      return false;
+    }
+    const size_t payload = pos + frame_size;
+    if (payload + length > segment.size) {
+      // The writer stopped before the whole record was written.
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: RecordLogReader::scan: "
+                   "ignoring incomplete record at the end of segment %B\n", index));
+      }
+      break;
+    }
+
+    if (kind == RECORD_LOG_WRITER) {
+      RecordLogWriterInfo info;
+      if (read_writer(segment.data + payload, length, info)) {
+        if (topic(info.topic_name) == npos) {
+          topics_.push_back(info.topic_name);
+        }
+        writers_[info.writer] = info;
+      }
+
+    } else if (kind == RECORD_LOG_SAMPLE) {
+      ACE_Message_Block mb(segment.data + payload, length);
+      mb.wr_ptr(length);
+      Serializer ser(&mb, encoding);
+      DDS::Time_t recorded;
+      Entry entry;
+      if (ser >> recorded.sec && ser >> recorded.nanosec && ser >> entry.writer) {
+        entry.recorded = SystemTimePoint(recorded);
+        const RecordLogWriterInfo* const info = writer_info(entry.writer);
+        entry.topic = info ? topic(info->topic_name) : npos;
+        entry.segment = index;
+        entry.offset = payload;
+        entry.length = length;
+        entries_.push_back(entry);
+      }
+    }
+    // Other kinds are skipped so newer logs can add them.
+
+    pos = payload + length;
+  }
+  return true;
+}
+
+bool RecordLogReader::read_writer(const char* data, size_t length, RecordLogWriterInfo& info) const
+{
+  ACE_Message_Block mb(data, length);
+  mb.wr_ptr(length);
+  Serializer ser(&mb, XTypes::get_typeobject_encoding());
+  if (!read_info(ser, info)) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordLogReader::read_writer: "
+                 "failed to deserialize writer record\n"));
+    }
+    return false;
+  }
+  return true;
+}
+
+RecordLogPlayer::RecordLogPlayer(const RecordLogReader& reader)
+  : reader_(reader)
+  , replayers_(reader.topics().size())
+  , started_(false)
+{
+}
+
+void RecordLogPlayer::add_replayer(const String& topic_name, Replayer_ptr replayer)
+{
+  const size_t topic = reader_.topic(topic_name);
+  if (topic != RecordLogReader::npos) {
+    replayers_[topic] = Replayer::_duplicate(replayer);
+  }
+}
+
+size_t RecordLogPlayer::play(double speed, size_t begin, size_t end)
+{
+  end = (std::min)(end, reader_.size());
+  started_ = false;
+  size_t count = 0;
+  for (size_t position = begin; position < end; ++position) {
+    if (write(position, speed)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+size_t RecordLogPlayer::play(const RecordLogReader::Positions& positions, double speed)
+{
+  started_ = false;
+  size_t count = 0;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    if (write(positions[i], speed)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void RecordLogPlayer::wait(const SystemTimePoint& recorded, double speed)
+{
+  if (!started_) {
+    started_ = true;
+    start_ = MonotonicTimePoint::now();
+    first_ = recorded;
+    return;
+  }
+  if (speed <= 0) {
+    return;
+  }
+
+  const MonotonicTimePoint due = start_ + (recorded - first_) / speed;
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  if (now < due) {
+    ACE_OS::sleep((due - now).value());
+  }
+}
+
+bool RecordLogPlayer::write(size_t position, double speed)
+{
+  const size_t topic = reader_[position].topic;
+  if (topic == RecordLogReader::npos || !replayers_[topic].in()) {
+    return false;
+  }
+  wait(reader_[position].recorded, speed);
+
+  RawDataSample sample;
+  if (!reader_.read(position, sample)) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RecordLogPlayer::write: "
+                 "failed to read sample %B\n", position));
+    }
+    return false;
+  }
+  return replayers_[topic]->write(sample) == DDS::RETCODE_OK;
+}
+
+RecordLogListener::RecordLogListener(const RecordLogWriter_rch& log,
+                                     const String& topic_name, const String& type_name)
+  : log_(log)
+  , topic_name_(topic_name)
+  , type_name_(type_name)
+{
+}
+
+void RecordLogListener::on_sample_data_received(Recorder*, const RawDataSample& sample)
+{
+  log_->write_sample(sample);
+}
+
+void RecordLogListener::on_recorder_matched(Recorder*, const DDS::SubscriptionMatchedStatus&)
+{
+}
+
+void RecordLogListener::on_writer_associated(Recorder* recorder, const WriterAssociation& writer)
+{
+  RecordLogWriterInfo info;
+  info.writer = writer.writerId;
+  info.topic_name = topic_name_;
+  info.type_name = type_name_;
+  info.publisher_qos = writer.pubQos;
+  info.writer_qos = writer.writerQos;
+  if (writer.serializedTypeInfo.length() &&
+      XTypes::deserialize_type_info(info.type_info, writer.serializedTypeInfo)) {
+    recorder->get_type_objects(info.type_info, info.type_objects);
+  }
+  log_->write_writer(info);
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
@@ -0,0 +1,328 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_RECORD_LOG_H
+#define OPENDDS_DCPS_RECORD_LOG_H
+
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include "dcps_export.h"
+
+#include "GuidUtils.h"
+#include "PoolAllocator.h"
+#include "RawDataSample.h"
+#include "RcHandle_T.h"
+#include "RcObject.h"
+#include "ReactorInterceptor.h"
+#include "Recorder.h"
+#include "Replayer.h"
+#include "TimeTypes.h"
+
+#include "XTypes/TypeObject.h"
+
+#include <dds/DdsDcpsCoreC.h>
+#include <dds/DdsDcpsInfoUtilsC.h>
+
+#include <ace/Message_Block.h>
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Mem_Map;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+template <typename Delegate>
+class PmfPeriodicTask;
+
+/**
+ * A record log is a directory of numbered segment files named
+ * <prefix>-<number>.rlog.  Each segment starts with a header followed by
+ * records, which are a kind, a length, and that many bytes of payload.
+ *
+ * Writer records hold the discovery data of a DataWriter: its topic, type,
+ * QoS, and the complete TypeObjects of its type.  Sample records hold the
+ * time the sample was recorded, its DataSampleHeader, and its serialized
+ * data.  A segment repeats the writer records of all writers known when it
+ * was started so that each segment can be read on its own.
+ */
+enum RecordLogRecordKind {
+  RECORD_LOG_WRITER = 1,
+  RECORD_LOG_SAMPLE = 2
+};
+
+/// Discovery data of a DataWriter whose samples are in a record log
+struct OpenDDS_Dcps_Export RecordLogWriterInfo {
+  RecordLogWriterInfo();
+
+  GUID_t writer;
+  String topic_name;
+  String type_name;
+  DDS::PublisherQos publisher_qos;
+  DDS::DataWriterQos writer_qos;
+  XTypes::TypeInformation type_info;
+  /// Complete TypeObjects of the writer's type and the types it depends on
+  XTypes::TypeIdentifierTypeObjectPairSeq type_objects;
+};
+
+/**
+ * Appends records to a record log.
+ *
+ * Records are encoded into a buffer and written to the segment file in a
+ * single write once the buffer reaches batch_size, so many samples
+ * recorded by transport threads share one system call.  There are two
+ * buffers: the full one is written and synced without holding the lock that
+ * recording threads need, while they add records to the other.  flush
+ * writes the buffer immediately, and buffered records are written after
+ * flush_interval even if the buffer isn't full.  A new segment is started
+ * when the current one would go over segment_size.
+ */
+class OpenDDS_Dcps_Export RecordLogWriter : public virtual RcObject {
+public:
+  struct OpenDDS_Dcps_Export Config {
+    Config();
+
+    String directory;
+    String prefix;
+    /// Size in bytes at which a new segment is started
+    size_t segment_size;
+    /// Size in bytes of the buffer that's written at once
+    size_t batch_size;
+    /// Sync the segment to disk after every write
+    bool sync;
+    /// Buffered records are written once the oldest has waited about this
+    /// long, even if the buffer isn't full.  Zero turns it off.
+    TimeDuration flush_interval;
+    /// Runs the flush_interval timer, for example
+    /// TheServiceParticipant->interceptor().  Without it buffered records
+    /// are only written when the buffer is full or by flush and
+    /// flush_if_due.
+    ReactorInterceptor_rch interceptor;
+  };
+
+  struct OpenDDS_Dcps_Export Stats {
+    Stats();
+
+    size_t segments;
+    size_t writers;
+    size_t samples;
+    size_t bytes;
+    /// Number of writes to segment files
+    size_t commits;
+  };
+
+  explicit RecordLogWriter(const Config& config);
+  ~RecordLogWriter();
+
+  /// Start a new segment after the last existing segment in the directory.
+  bool open();
+
+  /// Flush and close the current segment.
+  void close();
+
+  bool write_writer(const RecordLogWriterInfo& info);
+
+  bool write_sample(const RawDataSample& sample,
+                    const SystemTimePoint& recorded = SystemTimePoint::now());
+
+  /// Write buffered records to the segment.
+  bool flush();
+
+  /// Write buffered records if the oldest was buffered flush_interval or
+  /// more before now.
+  bool flush_if_due(const MonotonicTimePoint& now);
+
+  Stats stats() const;
+
+private:
+  typedef ACE_Guard<ACE_Thread_Mutex> Guard;
+
+  bool next_segment_i();
+  bool reserve_i(size_t payload_size, Guard* unlock = 0);
+  bool append_writer_i(const RecordLogWriterInfo& info);
+  /// Write the buffer to the segment.  If unlock isn't null, mutex_ is
+  /// released while writing and other threads can change the state.
+  bool commit_i(Guard* unlock = 0);
+  void close_i();
+  void flush_task(const MonotonicTimePoint& now);
+
+  typedef OPENDDS_MAP_CMP(GUID_t, RecordLogWriterInfo, GUID_tKeyLessThan) WriterInfoMap;
+  typedef PmfPeriodicTask<RecordLogWriter> FlushTask;
+
+  const Config config_;
+  mutable ACE_Thread_Mutex mutex_;
+  /// Held while writing to the segment file and while changing handle_.
+  /// Taken after mutex_.
+  ACE_Thread_Mutex file_mutex_;
+  ACE_HANDLE handle_;
+  unsigned long segment_;
+  size_t segment_bytes_;
+  size_t segment_samples_;
+  ACE_Message_Block buffer_a_;
+  ACE_Message_Block buffer_b_;
+  /// Records are added to buffer_.  spare_ is being written or is empty.
+  ACE_Message_Block* buffer_;
+  ACE_Message_Block* spare_;
+  MonotonicTimePoint first_buffered_;
+  RcHandle<FlushTask> flush_task_;
+  WriterInfoMap writers_;
+  Stats stats_;
+};
+
+typedef RcHandle<RecordLogWriter> RecordLogWriter_rch;
+
+/**
+ * Reads a record log.
+ *
+ * The segments are mapped into memory and scanned when the log is opened to
+ * build an index of the samples sorted by the time they were recorded,
+ * along with the positions of the samples of each topic and each writer.
+ * Samples are only decoded when they are read.
+ */
+class OpenDDS_Dcps_Export RecordLogReader {
+public:
+  struct Entry {
+    SystemTimePoint recorded;
+    GUID_t writer;
+    size_t topic;
+    size_t segment;
+    /// Offset and length of the sample record's payload in the segment
+    size_t offset;
+    size_t length;
+  };
+
+  /// Positions in the index
+  typedef OPENDDS_VECTOR(size_t) Positions;
+
+  RecordLogReader(const String& directory, const String& prefix = "record");
+  ~RecordLogReader();
+
+  /// Map the segments and build the index.
+  bool open();
+
+  void close();
+
+  size_t size() const { return entries_.size(); }
+
+  const Entry& operator[](size_t position) const { return entries_[position]; }
+
+  const OPENDDS_VECTOR(String)& topics() const { return topics_; }
+
+  /// Return the index of topic in topics() or npos.
+  size_t topic(const String& topic_name) const;
+
+  const RecordLogWriterInfo* writer_info(const GUID_t& writer) const;
+
+  /// Positions of the samples of a topic or writer, in recorded order
+  const Positions& topic_positions(size_t topic) const;
+  const Positions& writer_positions(const GUID_t& writer) const;
+
+  /// Return the position of the first sample recorded at or after time.
+  size_t seek(const SystemTimePoint& time) const;
+
+  /// Return the index into positions of the first sample recorded at or
+  /// after time.
+  size_t seek(const Positions& positions, const SystemTimePoint& time) const;
+
+  bool read(size_t position, RawDataSample& sample) const;
+
+  static const size_t npos;
+
+private:
+  struct Segment {
+    ACE_Mem_Map* map;
+    const char* data;
+    size_t size;
+  };
+
+  bool scan(size_t segment);
+  bool read_writer(const char* data, size_t length, RecordLogWriterInfo& info) const;
+
+  struct EntryLessThan {
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+      return a.recorded < b.recorded;
+    }
+  };
+
+  typedef OPENDDS_MAP_CMP(GUID_t, RecordLogWriterInfo, GUID_tKeyLessThan) WriterInfoMap;
+  typedef OPENDDS_MAP_CMP(GUID_t, Positions, GUID_tKeyLessThan) WriterPositionsMap;
+
+  const String directory_;
+  const String prefix_;
+  OPENDDS_VECTOR(Segment) segments_;
+  OPENDDS_VECTOR(Entry) entries_;
+  OPENDDS_VECTOR(String) topics_;
+  OPENDDS_VECTOR(Positions) topic_positions_;
+  WriterInfoMap writers_;
+  WriterPositionsMap writer_positions_;
+  const Positions empty_;
+};
+
+/**
+ * Writes the samples of a record log with Replayers.
+ *
+ * speed scales the time between samples: 1 replays them at the rate they
+ * were recorded, 2 twice as fast, and 0 or less as fast as possible.
+ */
+class OpenDDS_Dcps_Export RecordLogPlayer {
+public:
+  explicit RecordLogPlayer(const RecordLogReader& reader);
+
+  /// Replay the samples of a topic with replayer.  Samples of topics without
+  /// a replayer are skipped.
+  void add_replayer(const String& topic_name, Replayer_ptr replayer);
+
+  /// Replay the samples in [begin, end) and return how many were written.
+  size_t play(double speed = 1.0, size_t begin = 0,
+              size_t end = RecordLogReader::npos);
+
+  /// Replay the samples at positions and return how many were written.
+  size_t play(const RecordLogReader::Positions& positions, double speed = 1.0);
+
+private:
+  void wait(const SystemTimePoint& recorded, double speed);
+  bool write(size_t position, double speed);
+
+  const RecordLogReader& reader_;
+  OPENDDS_VECTOR(Replayer_var) replayers_;
+  bool started_;
+  MonotonicTimePoint start_;
+  SystemTimePoint first_;
+};
+
+/// Writes the samples a Recorder receives to a record log.
+class OpenDDS_Dcps_Export RecordLogListener : public RecorderListener {
+public:
+  RecordLogListener(const RecordLogWriter_rch& log,
+                    const String& topic_name, const String& type_name);
+
+  void on_sample_data_received(Recorder* recorder, const RawDataSample& sample);
+
+  void on_recorder_matched(Recorder* recorder, const DDS::SubscriptionMatchedStatus& status);
+
+  void on_writer_associated(Recorder* recorder, const WriterAssociation& writer);
+
+private:
+  RecordLogWriter_rch log_;
+  const String topic_name_;
+  const String type_name_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
+
+#endif // OPENDDS_DCPS_RECORD_LOG_H
@@ -19,6 +19,10 @@ RecorderListener::~RecorderListener()
 {
 }
 
+void RecorderListener::on_writer_associated(Recorder*, const WriterAssociation&)
+{
+}
+
 Recorder::~Recorder()
 {
 }
@@ -29,6 +33,20 @@ Recorder_ptr Recorder::_duplicate(Recorder_ptr obj)
   return obj;
 }
 
+#ifndef OPENDDS_SAFETY_PROFILE
+DDS::ReturnCode_t Recorder::transcode(const RawDataSample&, const Encoding&,
+                                      RawDataSample&, DDS::DynamicType_ptr)
+{
+  return DDS::RETCODE_UNSUPPORTED;
+}
+
+bool Recorder::get_type_objects(const XTypes::TypeInformation&,
+                                XTypes::TypeIdentifierTypeObjectPairSeq&)
+{
+  return false;
+}
+#endif
+
 }
 }
 
@@ -14,6 +14,9 @@
 #include "RawDataSample.h"
 #include "RcHandle_T.h"
 
+#include "XTypes/TypeObject.h"
+
+#include <dds/DdsDcpsInfoUtilsC.h>
 #include <dds/DdsDcpsInfrastructureC.h>
 
 #include <dds/DdsDynamicDataC.h>
@@ -51,6 +54,15 @@ public:
    */
   virtual void on_recorder_matched(Recorder*                              recorder,
                                    const DDS::SubscriptionMatchedStatus & status) = 0;
+
+  /**
+   *  Callback for when the Recorder is associated with a DataWriter, before
+   *  any samples from it are received.  The default does nothing.
+   *  @param recorder Recorder that received the association
+   *  @param writer the discovery data of the DataWriter
+   */
+  virtual void on_writer_associated(Recorder*                recorder,
+                                    const WriterAssociation& writer);
 };
 
 typedef RcHandle<RecorderListener> RecorderListener_rch;
@@ -105,6 +117,23 @@ public:
 
 #ifndef OPENDDS_SAFETY_PROFILE
   virtual DDS::DynamicData_ptr get_dynamic_data(const RawDataSample& sample) = 0;
+
+  /**
+   * Convert a recorded sample to encoding without going through DynamicData.
+   * If to_type is given the sample is also converted to that version of its
+   * type, which must be assignable from the type the writer used.
+   * The default returns RETCODE_UNSUPPORTED.
+   */
+  virtual DDS::ReturnCode_t transcode(const RawDataSample& sample, const Encoding& encoding,
+                                      RawDataSample& result, DDS::DynamicType_ptr to_type = 0);
+
+  /**
+   * Get the complete TypeObjects of the type described by type_info and of
+   * the types it depends on, so they can be stored with recorded samples.
+   * The default returns false.
+   */
+  virtual bool get_type_objects(const XTypes::TypeInformation& type_info,
+                                XTypes::TypeIdentifierTypeObjectPairSeq& types);
 #endif
 
   virtual void check_encap(bool b) = 0;
@@ -32,6 +32,7 @@
 #endif
 
 #include "XTypes/DynamicDataXcdrReadImpl.h"
+#include "XTypes/XcdrTranscoder.h"
 
 #include "transport/framework/EntryExit.h"
 #include "transport/framework/TransportExceptions.h"
@@ -277,6 +278,13 @@ RecorderImpl::add_association(const WriterAssociation& writer,
   //   return;
   // }
 
+  // Let the listener see the writer before any of its samples arrive.  No
+  // locks are held so the listener can call back into the Recorder.
+  const RecorderListener_rch listener = listener_;
+  if (!is_bit_ && listener) {
+    listener->on_writer_associated(this, writer);
+  }
+
   //
   // We do the following while holding the publication_handle_lock_.
   //
@@ -545,11 +553,13 @@ RecorderImpl::remove_associations_i(const WriterIdSeq& writers,
       GUID_t writer_id = writers[i];
 
 #ifndef OPENDDS_SAFETY_PROFILE
-      if (dt_map_.erase(writer_id) == 0) {
-        if (DCPS_debug_level >= 4) {
-          ACE_DEBUG((LM_DEBUG, "(%P|%t) RecorderImpl::remove_associations_i: -"
-            "failed to find writer_id in the DynamicTypeByPubId map.\n"));
-        }
+      const DynamicTypeByPubId::iterator dt_found = dt_map_.find(writer_id);
+      if (dt_found != dt_map_.end()) {
+        transcoders_.erase(dt_found->second);
+        dt_map_.erase(dt_found);
+      } else if (DCPS_debug_level >= 4) {
+        ACE_DEBUG((LM_DEBUG, "(%P|%t) RecorderImpl::remove_associations_i: -"
+          "failed to find writer_id in the DynamicTypeByPubId map.\n"));
       }
 #endif
 
@@ -1021,6 +1031,59 @@ DDS::DynamicData_ptr RecorderImpl::get_dynamic_data(const RawDataSample& sample)
   }
   return dd_var._retn();
 }
+
+DDS::ReturnCode_t RecorderImpl::transcode(const RawDataSample& sample, const Encoding& encoding,
+                                          RawDataSample& result, DDS::DynamicType_ptr to_type)
+{
+  const DynamicTypeByPubId::const_iterator dt_found = dt_map_.find(sample.publication_id_);
+  if (dt_found == dt_map_.end()) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RecorderImpl::transcode: "
+        "failed to find GUID: %C in DynamicTypeByPubId.\n", LogGuid(sample.publication_id_).c_str()));
+    }
+    return DDS::RETCODE_PRECONDITION_NOT_MET;
+  }
+
+  const Encoding enc(sample.encoding_kind_, sample.sample_byte_order_ ? ENDIAN_LITTLE : ENDIAN_BIG);
+  const XTypes::XcdrTranscoder_rch transcoder =
+    transcoders_.get(dt_found->second, to_type ? to_type : dt_found->second.in());
+  Message_Block_Ptr data;
+  if (!sample.sample_ || !transcoder->transcode(*sample.sample_, enc, encoding, data)) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: RecorderImpl::transcode: "
+        "failed to transcode sample from %C to %C\n",
+        enc.to_string().c_str(), encoding.to_string().c_str()));
+    }
+    return DDS::RETCODE_ERROR;
+  }
+
+  result = sample;
+  result.sample_.reset(data.release());
+  result.encoding_kind_ = encoding.kind();
+  result.sample_byte_order_ = encoding.endianness() == ENDIAN_LITTLE;
+  result.header_.byte_order_ = result.sample_byte_order_;
+  return DDS::RETCODE_OK;
+}
+
+bool RecorderImpl::get_type_objects(const XTypes::TypeInformation& type_info,
+                                    XTypes::TypeIdentifierTypeObjectPairSeq& types)
+{
+  const XTypes::TypeIdentifier& ti = type_info.complete.typeid_with_size.type_id;
+  if (ti.kind() == XTypes::TK_NONE) {
+    return false;
+  }
+
+  XTypes::TypeLookupService_rch tls = participant_servant_->get_type_lookup_service();
+  XTypes::TypeIdentifierSeq type_ids;
+  type_ids.append(ti);
+  XTypes::TypeIdentifierWithSizeSeq dependencies;
+  tls->get_type_dependencies(type_ids, dependencies);
+  for (unsigned i = 0; i < dependencies.length(); ++i) {
+    type_ids.append(dependencies[i].type_id);
+  }
+  tls->get_type_objects(type_ids, types);
+  return types.length() != 0;
+}
 #endif
 
 } // namespace DCPS
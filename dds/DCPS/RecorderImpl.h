@@ -16,6 +16,9 @@
 #include "EntityImpl.h"
 #include "TopicImpl.h"
 #include "OwnershipManager.h"
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include "XTypes/XcdrTranscoder.h"
+#endif
 
 #include "transport/framework/TransportClient.h"
 #include "transport/framework/TransportDefs.h"
@@ -157,6 +160,10 @@ private:
 
 #ifndef OPENDDS_SAFETY_PROFILE
   DDS::DynamicData_ptr get_dynamic_data(const RawDataSample& sample);
+  DDS::ReturnCode_t transcode(const RawDataSample& sample, const Encoding& encoding,
+                              RawDataSample& result, DDS::DynamicType_ptr to_type = 0);
+  bool get_type_objects(const XTypes::TypeInformation& type_info,
+                        XTypes::TypeIdentifierTypeObjectPairSeq& types);
 #endif
   void check_encap(bool b) { check_encap_ = b; }
   bool check_encap() const { return check_encap_; }
@@ -208,6 +215,7 @@ private:
 #ifndef OPENDDS_SAFETY_PROFILE
   typedef OPENDDS_MAP(GUID_t, DDS::DynamicType_var) DynamicTypeByPubId;
   DynamicTypeByPubId dt_map_;
+  XTypes::XcdrTranscoderCache transcoders_;
 #endif
   bool check_encap_;
 
@@ -32,6 +32,13 @@ Replayer_ptr Replayer::_duplicate(Replayer_ptr obj)
   return obj;
 }
 
+#ifndef OPENDDS_SAFETY_PROFILE
+DDS::ReturnCode_t Replayer::write(const RawDataSample&, DDS::DynamicType_ptr)
+{
+  return DDS::RETCODE_UNSUPPORTED;
+}
+#endif
+
 }
 }
 
@@ -16,6 +16,9 @@
 #include "LocalObject.h"
 
 #include <dds/DdsDcpsInfrastructureC.h>
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include <dds/DdsDynamicDataC.h>
+#endif
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -74,6 +77,18 @@ public:
    */
   virtual DDS::ReturnCode_t write (const RawDataSample& sample) = 0;
 
+#ifndef OPENDDS_SAFETY_PROFILE
+  /**
+   * Send a sample that was recorded with sample_type, converting it to the
+   * data representation of the Replayer and the type of its topic.
+   * The default returns RETCODE_UNSUPPORTED.
+   *
+   * @note Only samples of type SAMPLE_DATA should be sent.
+   */
+  virtual DDS::ReturnCode_t write (const RawDataSample& sample,
+                                   DDS::DynamicType_ptr sample_type);
+#endif
+
   /**
    * Send the sample to the specified DataReader.
    *
@@ -22,6 +22,9 @@
 #include "MonitorFactory.h"
 #include "TypeSupportImpl.h"
 #include "DCPS_Utils.h"
+#include "EncapsulationHeader.h"
+#include "debug.h"
+#include "XTypes/XcdrTranscoder.h"
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
 #include "CoherentChangeControl.h"
 #endif
@@ -65,6 +68,9 @@ ReplayerImpl::ReplayerImpl()
   // data_container_(0),
   // liveliness_lost_(false),
   // last_deadline_missed_total_count_(0),
+#ifndef OPENDDS_SAFETY_PROFILE
+  transcoders_(max_transcoders),
+#endif
   is_bit_(false),
   empty_condition_(lock_),
   pending_write_count_(0)
@@ -120,6 +126,10 @@ ReplayerImpl::cleanup()
     // remove_association may lost.
     this->remove_all_associations();
 
+#ifndef OPENDDS_SAFETY_PROFILE
+    transcoders_.clear();
+#endif
+
     // release our Topic_var
     topic_objref_ = DDS::Topic::_nil();
     topic_servant_ = 0;
@@ -944,6 +954,58 @@ ReplayerImpl::write(const RawDataSample& sample)
   return this->write(&sample, 1, 0);
 }
 
+#ifndef OPENDDS_SAFETY_PROFILE
+DDS::ReturnCode_t
+ReplayerImpl::write(const RawDataSample& sample, DDS::DynamicType_ptr sample_type)
+{
+  TypeSupportImpl* const ts = dynamic_cast<TypeSupportImpl*>(topic_servant_->get_type_support());
+  Encoding::Kind kind;
+  if (!ts || !sample_type || !sample.sample_ || qos_.representation.value.length() == 0 ||
+      !repr_to_encoding_kind(qos_.representation.value[0], kind)) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: ReplayerImpl::write: "
+                 "sample can't be converted for this replayer\n"));
+    }
+    return DDS::RETCODE_PRECONDITION_NOT_MET;
+  }
+
+  const Encoding from(sample.encoding_kind_, sample.sample_byte_order_ ? ENDIAN_LITTLE : ENDIAN_BIG);
+  const Encoding to(kind);
+  const DDS::DynamicType_var topic_type = ts->get_type();
+  const XTypes::XcdrTranscoder_rch transcoder = transcoders_.get(sample_type, topic_type);
+  Message_Block_Ptr data;
+  if (!transcoder->transcode(*sample.sample_, from, to, data)) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: ReplayerImpl::write: "
+                 "failed to transcode sample from %C to %C\n",
+                 from.to_string().c_str(), to.to_string().c_str()));
+    }
+    return DDS::RETCODE_ERROR;
+  }
+
+  RawDataSample transcoded(sample);
+  transcoded.encoding_kind_ = kind;
+  transcoded.sample_byte_order_ = to.endianness() == ENDIAN_LITTLE;
+  if (cdr_encapsulation()) {
+    const EncapsulationHeader encap(to, ts->base_extensibility());
+    Message_Block_Ptr encap_block(new ACE_Message_Block(EncapsulationHeader::serialized_size));
+    Serializer ser(encap_block.get(), to);
+    if (!encap.is_good() || !(ser << encap)) {
+      if (log_level >= LogLevel::Error) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: ReplayerImpl::write: "
+                   "failed to write encapsulation header\n"));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+    encap_block->cont(data.release());
+    transcoded.sample_.reset(encap_block.release());
+  } else {
+    transcoded.sample_.reset(data.release());
+  }
+  return write(&transcoded, 1, 0);
+}
+#endif
+
 DDS::ReturnCode_t
 ReplayerImpl::create_sample_data_message(Message_Block_Ptr   data,
                                          DataSampleHeader&   header_data,
@@ -22,6 +22,9 @@
 #  include "FilterEvaluator.h"
 #endif
 #include "ConditionVariable.h"
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include "XTypes/XcdrTranscoder.h"
+#endif
 #include "transport/framework/TransportSendListener.h"
 #include "transport/framework/TransportClient.h"
 
@@ -87,6 +90,10 @@ public:
 
   // Implement Replayer
   virtual DDS::ReturnCode_t write (const RawDataSample& sample );
+#ifndef OPENDDS_SAFETY_PROFILE
+  virtual DDS::ReturnCode_t write (const RawDataSample& sample,
+                                   DDS::DynamicType_ptr sample_type);
+#endif
   virtual DDS::ReturnCode_t write_to_reader (DDS::InstanceHandle_t subscription,
                                              const RawDataSample&  sample );
   virtual DDS::ReturnCode_t write_to_reader (DDS::InstanceHandle_t    subscription,
@@ -284,6 +291,13 @@ private:
   /// objects.
   unique_ptr<DataSampleElementAllocator> sample_list_element_allocator_;
 
+#ifndef OPENDDS_SAFETY_PROFILE
+  /// Transcoders from the types of the samples passed to write.  The types
+  /// come from the caller, so only the most recently used are kept.
+  static const size_t max_transcoders = 16;
+  XTypes::XcdrTranscoderCache transcoders_;
+#endif
+
   /// The orb's reactor to be used to register the liveliness
   /// timer.
   // ACE_Reactor_Timer_Interface* reactor_;
@@ -0,0 +1,77 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_ROUND_TRIP_TIME_ESTIMATOR_H
+#define OPENDDS_DCPS_ROUND_TRIP_TIME_ESTIMATOR_H
+
+#include "TimeDuration.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Maintains a smoothed round-trip time and round-trip time variation from
+ * individual measurements using the estimator from RFC 6298 section 2.
+ */
+class RoundTripTimeEstimator {
+public:
+  RoundTripTimeEstimator()
+    : valid_(false)
+  {}
+
+  void sample(const TimeDuration& rtt)
+  {
+    if (rtt < TimeDuration::zero_value) {
+      return;
+    }
+
+    if (!valid_) {
+      srtt_ = rtt;
+      rttvar_ = rtt / 2.0;
+      valid_ = true;
+      return;
+    }
+
+    const TimeDuration delta = srtt_ < rtt ? rtt - srtt_ : srtt_ - rtt;
+    rttvar_ = 0.75 * rttvar_ + 0.25 * delta;
+    srtt_ = 0.875 * srtt_ + 0.125 * rtt;
+  }
+
+  bool valid() const { return valid_; }
+
+  /// Smoothed round-trip time.  Only meaningful if valid().
+  const TimeDuration& srtt() const { return srtt_; }
+
+  /// Round-trip time variation.  Only meaningful if valid().
+  const TimeDuration& rttvar() const { return rttvar_; }
+
+  /// Time after which a response should have been received.
+  TimeDuration rto() const { return srtt_ + 4.0 * rttvar_; }
+
+  void reset()
+  {
+    valid_ = false;
+    srtt_ = TimeDuration::zero_value;
+    rttvar_ = TimeDuration::zero_value;
+  }
+
+private:
+  bool valid_;
+  TimeDuration srtt_;
+  TimeDuration rttvar_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_ROUND_TRIP_TIME_ESTIMATOR_H */
@@ -7,6 +7,7 @@
 
 #include "Service_Participant.h"
 
+#include "AsyncLogger.h"
 #include "BuiltInTopicUtils.h"
 #include "DataDurabilityCache.h"
 #include "DefaultNetworkConfigMonitor.h"
@@ -202,6 +203,10 @@ Service_Participant::~Service_Participant()
   }
 
   config_topic_->disconnect(config_reader_);
+
+#ifdef ACE_HAS_CPP11
+  async_logger.stop();
+#endif
 }
 
 Service_Participant*
@@ -2327,6 +2332,27 @@ Service_Participant::printer_value_writer_indent(unsigned int value)
   config_store_->set_uint32(COMMON_PRINTER_VALUE_WRITER_INDENT, value);
 }
 
+void
+Service_Participant::configure_async_logging()
+{
+#ifdef ACE_HAS_CPP11
+  async_logger.stop();
+  if (config_store_->get_boolean(COMMON_DCPS_LOG_ASYNC, COMMON_DCPS_LOG_ASYNC_default)) {
+    async_logger.start(config_store_->get_uint32(COMMON_DCPS_LOG_ASYNC_RING_SIZE,
+                                                 COMMON_DCPS_LOG_ASYNC_RING_SIZE_default),
+                       config_store_->get(COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL,
+                                          COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL_default,
+                                          ConfigStoreImpl::Format_IntegerMilliseconds));
+  }
+#else
+  if (config_store_->get_boolean(COMMON_DCPS_LOG_ASYNC, COMMON_DCPS_LOG_ASYNC_default) &&
+      log_level >= LogLevel::Warning) {
+    ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: Service_Participant::configure_async_logging: "
+               "DCPSLogAsync requires C++11 and is ignored\n"));
+  }
+#endif
+}
+
 void
 Service_Participant::ConfigReaderListener::on_data_available(InternalDataReader_rch reader)
 {
@@ -2364,6 +2390,10 @@ Service_Participant::ConfigReaderListener::on_data_available(InternalDataReader_
 #endif
       } else if (p.key() == COMMON_DCPS_LOG_LEVEL) {
         log_level.set_from_string(p.value().c_str());
+      } else if (p.key() == COMMON_DCPS_LOG_ASYNC ||
+                 p.key() == COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL ||
+                 p.key() == COMMON_DCPS_LOG_ASYNC_RING_SIZE) {
+        service_participant_.configure_async_logging();
       } else if (p.key() == COMMON_DCPS_PENDING_TIMEOUT) {
         ACE_GUARD(ACE_Thread_Mutex, guard, service_participant_.cached_config_mutex_);
         service_participant_.pending_timeout_ =
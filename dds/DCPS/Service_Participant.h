@@ -105,6 +105,15 @@ const char COMMON_DCPS_INFO_REPO[] = "COMMON_DCPS_INFO_REPO";
 const char COMMON_DCPS_LIVELINESS_FACTOR[] = "COMMON_DCPS_LIVELINESS_FACTOR";
 const int COMMON_DCPS_LIVELINESS_FACTOR_default = 80;
 
+const char COMMON_DCPS_LOG_ASYNC[] = "COMMON_DCPS_LOG_ASYNC";
+const bool COMMON_DCPS_LOG_ASYNC_default = false;
+
+const char COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL[] = "COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL";
+const TimeDuration COMMON_DCPS_LOG_ASYNC_FLUSH_INTERVAL_default(0, 10000);
+
+const char COMMON_DCPS_LOG_ASYNC_RING_SIZE[] = "COMMON_DCPS_LOG_ASYNC_RING_SIZE";
+const unsigned int COMMON_DCPS_LOG_ASYNC_RING_SIZE_default = 256;
+
 const char COMMON_DCPS_LOG_LEVEL[] = "COMMON_DCPS_LOG_LEVEL";
 
 const char COMMON_DCPS_MONITOR[] = "COMMON_DCPS_MONITOR";
@@ -541,6 +550,12 @@ public:
   void configure_pool();
 #endif
 
+  /**
+   * Start, restart, or stop the asynchronous logger according to
+   * DCPSLogAsync and its related options.
+   */
+  void configure_async_logging();
+
   /**
    * Set a configuration file to use if -DCPSConfigFile wasn't passed to
    * TheParticipantFactoryWithArgs. Must be used before
@@ -21,11 +21,21 @@
 #include <cstring>
 #include <cwchar>
 
+#if defined OPENDDS_RAPIDJSON && !defined OPENDDS_SAFETY_PROFILE
+#  define OPENDDS_HAS_JSON_VALUE_WRITER 1
+#else
+#  define OPENDDS_HAS_JSON_VALUE_WRITER 0
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+#if OPENDDS_HAS_JSON_VALUE_WRITER
+class JsonEncoder;
+#endif
+
 struct MemberParam {
   MemberParam()
     : id()
@@ -0,0 +1,416 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "WorkStealingEventDispatcher.h"
+
+#include "debug.h"
+#include "Service_Participant.h"
+
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_Thread.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+WorkStealingEventDispatcher::Worker::Worker()
+ : cv_(mutex_)
+ , next_timer_seq_(0)
+ , accepting_(true)
+ , stealable_(0)
+ , idle_(0)
+ , thread_()
+{
+}
+
+WorkStealingEventDispatcher::WorkStealingEventDispatcher(size_t count)
+ : count_(count ? count : 1)
+ , workers_(make_workers(count_))
+ , next_worker_(0)
+ , next_index_(0)
+ , steal_count_(0)
+ , stop_when_empty_(0)
+ , running_(1)
+ , state_cv_(state_mutex_)
+ , running_threads_(0)
+ , started_threads_(0)
+ , pool_(count_, run, this)
+{
+  // Wait for every thread to record its id so current_worker() can read them without locking.
+  ACE_Guard<ACE_Thread_Mutex> guard(state_mutex_);
+  while (started_threads_ != count_) {
+    state_cv_.wait(TheServiceParticipant->get_thread_status_manager());
+  }
+}
+
+WorkStealingEventDispatcher::~WorkStealingEventDispatcher()
+{
+  shutdown();
+}
+
+WorkStealingEventDispatcher::WorkerVector WorkStealingEventDispatcher::make_workers(size_t count)
+{
+  WorkerVector workers;
+  workers.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    workers.push_back(make_rch<Worker>());
+  }
+  return workers;
+}
+
+void WorkStealingEventDispatcher::shutdown(bool immediate)
+{
+  if (immediate) {
+    running_ = 0;
+  }
+  stop_when_empty_ = 1;
+
+  EventQueue canceled;
+  for (size_t i = 0; i < count_; ++i) {
+    Worker& worker = *workers_[i];
+    ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+    worker.accepting_ = false;
+    for (TimerQueueMap::iterator it = worker.timer_queue_map_.begin(); it != worker.timer_queue_map_.end(); ++it) {
+      canceled.push_back(it->second.event);
+    }
+    worker.timer_queue_map_.clear();
+    worker.timer_id_map_.clear();
+    worker.cv_.notify_all();
+  }
+
+  for (EventQueue::iterator it = canceled.begin(); it != canceled.end(); ++it) {
+    (*it)->handle_cancel();
+    (*it)->_remove_ref();
+  }
+  canceled.clear();
+
+  if (pool_.contains(ACE_Thread::self())) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: WorkStealingEventDispatcher::shutdown: Contained Thread Attempting To Call Shutdown.\n"));
+    }
+    return;
+  }
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(state_mutex_);
+    while (running_threads_) {
+      state_cv_.wait(TheServiceParticipant->get_thread_status_manager());
+    }
+  }
+
+  // Anything left was dropped by an immediate shutdown.
+  for (size_t i = 0; i < count_; ++i) {
+    Worker& worker = *workers_[i];
+    ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+    canceled.insert(canceled.end(), worker.pinned_.begin(), worker.pinned_.end());
+    canceled.insert(canceled.end(), worker.local_.begin(), worker.local_.end());
+    worker.pinned_.clear();
+    worker.local_.clear();
+    worker.stealable_ = 0;
+  }
+
+  for (EventQueue::iterator it = canceled.begin(); it != canceled.end(); ++it) {
+    (*it)->handle_cancel();
+    (*it)->_remove_ref();
+  }
+}
+
+bool WorkStealingEventDispatcher::dispatch(EventBase_rch event)
+{
+  if (!event) {
+    return false;
+  }
+  size_t index = current_worker();
+  if (index == count_) {
+    index = next_worker();
+  }
+  return enqueue(index, event.in(), false);
+}
+
+bool WorkStealingEventDispatcher::dispatch(EventBase_rch event, size_t affinity)
+{
+  if (!event) {
+    return false;
+  }
+  return enqueue(affinity % count_, event.in(), true);
+}
+
+long WorkStealingEventDispatcher::schedule(EventBase_rch event, const MonotonicTimePoint& expiration)
+{
+  if (!event) {
+    return -1;
+  }
+  size_t index = current_worker();
+  if (index == count_) {
+    index = next_worker();
+  }
+  return add_timer(index, event.in(), expiration, false);
+}
+
+long WorkStealingEventDispatcher::schedule(EventBase_rch event, const MonotonicTimePoint& expiration, size_t affinity)
+{
+  if (!event) {
+    return -1;
+  }
+  return add_timer(affinity % count_, event.in(), expiration, true);
+}
+
+size_t WorkStealingEventDispatcher::cancel(long id)
+{
+  if (id <= 0) {
+    return 0;
+  }
+
+  // Timer ids encode the index of the worker holding the timer.
+  Worker& worker = *workers_[static_cast<size_t>(id) % count_];
+  EventBase* event = 0;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+    const TimerIdMap::iterator pos = worker.timer_id_map_.find(id);
+    if (pos == worker.timer_id_map_.end()) {
+      return 0;
+    }
+    event = pos->second->second.event;
+    worker.timer_queue_map_.erase(pos->second);
+    worker.timer_id_map_.erase(pos);
+  }
+
+  event->handle_cancel();
+  event->_remove_ref();
+  return 1;
+}
+
+ACE_THR_FUNC_RETURN WorkStealingEventDispatcher::run(void* arg)
+{
+  WorkStealingEventDispatcher& dispatcher = *static_cast<WorkStealingEventDispatcher*>(arg);
+  dispatcher.run_event_loop(dispatcher.next_index_++);
+  return 0;
+}
+
+void WorkStealingEventDispatcher::run_event_loop(size_t index)
+{
+  ThreadStatusManager& tsm = TheServiceParticipant->get_thread_status_manager();
+  Worker& worker = *workers_[index];
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(state_mutex_);
+    worker.thread_ = ACE_Thread::self();
+    ++running_threads_;
+    ++started_threads_;
+    state_cv_.notify_all();
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+  while (running_) {
+
+    // Logical Order:
+    // - Move expired timer events into the queues
+    // - Run from the pinned queue, then the local queue, then steal
+    // - Wait until the next timer if there's nothing to do
+
+    size_t promoted = 0;
+    if (worker.accepting_ && !worker.timer_queue_map_.empty()) {
+      promoted = promote_timers(worker, MonotonicTimePoint::now());
+    }
+
+    EventBase* event = 0;
+    if (!worker.pinned_.empty()) {
+      event = worker.pinned_.front();
+      worker.pinned_.pop_front();
+    } else if (!worker.local_.empty()) {
+      event = worker.local_.front();
+      worker.local_.pop_front();
+      --worker.stealable_;
+    }
+
+    if (!event) {
+      guard.release();
+      const bool stolen = steal(index, event);
+      guard.acquire();
+
+      if (!stolen) {
+        if (!worker.pinned_.empty() || !worker.local_.empty()) {
+          continue;
+        }
+        // Dispatchers check idle_ after queuing so either they see it set
+        // or the checks below see their event.
+        worker.idle_ = 1;
+        if (stop_when_empty_ && !any_stealable()) {
+          worker.idle_ = 0;
+          break;
+        }
+        if (running_ && !any_stealable()) {
+          if (worker.accepting_ && !worker.timer_queue_map_.empty()) {
+            const MonotonicTimePoint deadline(worker.timer_queue_map_.begin()->first);
+            worker.cv_.wait_until(deadline, tsm);
+          } else {
+            worker.cv_.wait(tsm);
+          }
+        }
+        worker.idle_ = 0;
+        continue;
+      }
+    }
+
+    guard.release();
+    if (promoted > 1) {
+      wake_idle(index);
+    }
+    (*event)();
+    guard.acquire();
+  }
+  guard.release();
+
+  ACE_Guard<ACE_Thread_Mutex> state_guard(state_mutex_);
+  --running_threads_;
+  state_cv_.notify_all();
+}
+
+bool WorkStealingEventDispatcher::enqueue(size_t index, EventBase* event, bool pinned)
+{
+  Worker& worker = *workers_[index];
+  bool was_idle;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+    if (!worker.accepting_) {
+      return false;
+    }
+    // Released by EventBase::operator() or when canceled
+    event->_add_ref();
+    if (pinned) {
+      worker.pinned_.push_back(event);
+    } else {
+      worker.local_.push_back(event);
+      ++worker.stealable_;
+    }
+    was_idle = worker.idle_;
+    if (was_idle) {
+      worker.cv_.notify_one();
+    }
+  }
+
+  if (!pinned && !was_idle) {
+    wake_idle(index);
+  }
+  return true;
+}
+
+long WorkStealingEventDispatcher::add_timer(size_t index, EventBase* event, const MonotonicTimePoint& expiration, bool pinned)
+{
+  Worker& worker = *workers_[index];
+  ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+  if (!worker.accepting_) {
+    return -1;
+  }
+
+  const Timer timer = { event, 0, pinned };
+  const TimerQueueMap::iterator pos = worker.timer_queue_map_.insert(std::make_pair(expiration, timer));
+
+  // Ids are seq * count_ + index so cancel() only has to lock one worker.
+  const unsigned long max_seq = static_cast<unsigned long>(LONG_MAX) / count_ - 1;
+  const unsigned long starting_seq = worker.next_timer_seq_;
+  long id = 0;
+  do {
+    worker.next_timer_seq_ = worker.next_timer_seq_ >= max_seq ? 1 : worker.next_timer_seq_ + 1;
+    if (worker.next_timer_seq_ == starting_seq) {
+      worker.timer_queue_map_.erase(pos);
+      return -1; // all ids in use ?!
+    }
+    id = static_cast<long>(worker.next_timer_seq_ * count_ + index);
+    pos->second.id = id;
+  } while (worker.timer_id_map_.insert(std::make_pair(id, pos)).second == false);
+
+  // Released by EventBase::operator() or when canceled
+  event->_add_ref();
+  if (pos == worker.timer_queue_map_.begin()) {
+    worker.cv_.notify_one();
+  }
+  return id;
+}
+
+size_t WorkStealingEventDispatcher::current_worker() const
+{
+  const ACE_thread_t self = ACE_Thread::self();
+  for (size_t i = 0; i < count_; ++i) {
+    if (ACE_OS::thr_equal(workers_[i]->thread_, self)) {
+      return i;
+    }
+  }
+  return count_;
+}
+
+size_t WorkStealingEventDispatcher::next_worker()
+{
+  return next_worker_++ % count_;
+}
+
+bool WorkStealingEventDispatcher::steal(size_t thief, EventBase*& event)
+{
+  for (size_t offset = 1; offset < count_; ++offset) {
+    Worker& victim = *workers_[(thief + offset) % count_];
+    if (!victim.stealable_) {
+      continue;
+    }
+    ACE_Guard<ACE_Thread_Mutex> guard(victim.mutex_);
+    if (!victim.local_.empty()) {
+      event = victim.local_.back();
+      victim.local_.pop_back();
+      --victim.stealable_;
+      ++steal_count_;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingEventDispatcher::any_stealable() const
+{
+  for (size_t i = 0; i < count_; ++i) {
+    if (workers_[i]->stealable_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingEventDispatcher::wake_idle(size_t except)
+{
+  for (size_t offset = 1; offset < count_; ++offset) {
+    Worker& worker = *workers_[(except + offset) % count_];
+    if (worker.idle_) {
+      ACE_Guard<ACE_Thread_Mutex> guard(worker.mutex_);
+      worker.cv_.notify_one();
+      return;
+    }
+  }
+}
+
+size_t WorkStealingEventDispatcher::promote_timers(Worker& worker, const MonotonicTimePoint& now)
+{
+  size_t promoted = 0;
+  const TimerQueueMap::iterator last = worker.timer_queue_map_.upper_bound(now);
+  for (TimerQueueMap::iterator it = worker.timer_queue_map_.begin(); it != last; ++it) {
+    if (it->second.pinned) {
+      worker.pinned_.push_back(it->second.event);
+    } else {
+      worker.local_.push_back(it->second.event);
+      ++worker.stealable_;
+      ++promoted;
+    }
+    worker.timer_id_map_.erase(it->second.id);
+  }
+  worker.timer_queue_map_.erase(worker.timer_queue_map_.begin(), last);
+  return promoted;
+}
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
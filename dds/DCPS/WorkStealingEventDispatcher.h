@@ -0,0 +1,141 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_WORK_STEALING_EVENT_DISPATCHER_H
+#define OPENDDS_DCPS_WORK_STEALING_EVENT_DISPATCHER_H
+
+#include "Atomic.h"
+#include "ConditionVariable.h"
+#include "EventDispatcher.h"
+#include "PoolAllocator.h"
+#include "ThreadPool.h"
+
+#include <ace/Thread_Mutex.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * WorkStealingEventDispatcher is an EventDispatcher for several threads.
+ *
+ * Unlike ServiceEventDispatcher, which shares one queue, one timer map, and
+ * one lock between all of its threads, each thread here owns a queue and a
+ * timer map guarded by its own lock.  Events dispatched from outside the
+ * pool are spread over the threads and events dispatched from a pool thread
+ * stay on that thread.  Idle threads steal queued events from busy ones.
+ *
+ * Events dispatched or scheduled with an affinity key always run on the
+ * thread selected by that key and are never stolen, so events sharing a key
+ * are serialized and run in the order they were dispatched.
+ *
+ * Timers are kept by the thread that will dispatch them and expire when that
+ * thread next looks at its queue, so a long running event delays the timers
+ * of its own thread but not those of the other threads.
+ */
+class OpenDDS_Dcps_Export WorkStealingEventDispatcher : public EventDispatcher {
+public:
+  /**
+   * Create a WorkStealingEventDispatcher
+   * @param count the number of threads (at least 1)
+   */
+  explicit WorkStealingEventDispatcher(size_t count = 1);
+  virtual ~WorkStealingEventDispatcher();
+
+  void shutdown(bool immediate = false);
+
+  bool dispatch(EventBase_rch event);
+
+  /**
+   * Dispatch an event that must not run concurrently with other events
+   * that use the same affinity key.
+   */
+  bool dispatch(EventBase_rch event, size_t affinity);
+
+  long schedule(EventBase_rch event, const MonotonicTimePoint& expiration = MonotonicTimePoint::now());
+
+  /// Schedule an event that will be dispatched with the given affinity key.
+  long schedule(EventBase_rch event, const MonotonicTimePoint& expiration, size_t affinity);
+
+  size_t cancel(long id);
+
+  size_t thread_count() const { return count_; }
+
+  /// Number of events that ran on a thread other than the one they were queued on.
+  size_t steal_count() const { return steal_count_; }
+
+private:
+  typedef OPENDDS_DEQUE(EventBase*) EventQueue;
+
+  struct Timer {
+    EventBase* event;
+    long id;
+    bool pinned;
+  };
+  typedef OPENDDS_MULTIMAP(MonotonicTimePoint, Timer) TimerQueueMap;
+  typedef OPENDDS_MAP(long, TimerQueueMap::iterator) TimerIdMap;
+
+  struct Worker : RcObject {
+    Worker();
+
+    mutable ACE_Thread_Mutex mutex_;
+    ConditionVariable<ACE_Thread_Mutex> cv_;
+    /// Events any thread may run.  The owner takes from the front and
+    /// thieves take from the back.
+    EventQueue local_;
+    /// Events with an affinity key, only run by the owner.
+    EventQueue pinned_;
+    TimerQueueMap timer_queue_map_;
+    TimerIdMap timer_id_map_;
+    unsigned long next_timer_seq_;
+    bool accepting_;
+    /// Readable without the lock to find work to steal and threads to wake.
+    Atomic<size_t> stealable_;
+    Atomic<size_t> idle_;
+    ACE_thread_t thread_;
+  };
+  typedef RcHandle<Worker> Worker_rch;
+  typedef OPENDDS_VECTOR(Worker_rch) WorkerVector;
+
+  static ACE_THR_FUNC_RETURN run(void* arg);
+  void run_event_loop(size_t index);
+
+  static WorkerVector make_workers(size_t count);
+
+  bool enqueue(size_t index, EventBase* event, bool pinned);
+  long add_timer(size_t index, EventBase* event, const MonotonicTimePoint& expiration, bool pinned);
+  size_t current_worker() const;
+  size_t next_worker();
+  bool steal(size_t thief, EventBase*& event);
+  bool any_stealable() const;
+  void wake_idle(size_t except);
+  size_t promote_timers(Worker& worker, const MonotonicTimePoint& now);
+
+  const size_t count_;
+  WorkerVector workers_;
+  Atomic<size_t> next_worker_;
+  Atomic<size_t> next_index_;
+  Atomic<size_t> steal_count_;
+  Atomic<size_t> stop_when_empty_;
+  Atomic<size_t> running_;
+
+  mutable ACE_Thread_Mutex state_mutex_;
+  mutable ConditionVariable<ACE_Thread_Mutex> state_cv_;
+  size_t running_threads_;
+  size_t started_threads_;
+
+  ThreadPool pool_;
+};
+typedef RcHandle<WorkStealingEventDispatcher> WorkStealingEventDispatcher_rch;
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_WORK_STEALING_EVENT_DISPATCHER_H
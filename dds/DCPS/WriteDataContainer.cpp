@@ -1378,45 +1378,60 @@ WriteDataContainer::copy_and_prepend(SendStateDataSampleList& list,
 #endif
                                      ssize_t& max_resend_samples)
 {
-  for (SendStateDataSampleList::const_reverse_iterator cur = appended.rbegin();
-       cur != appended.rend() && max_resend_samples; ++cur) {
+  OPENDDS_VECTOR(const DataSampleElement*) candidates;
+  SendStateDataSampleList::const_reverse_iterator next = appended.rbegin();
+  while (max_resend_samples > 0 && next != appended.rend()) {
+    // Each candidate is resent at most once, so only take as many as could
+    // still be resent.  Another batch is taken if the filter rejects some.
+    candidates.clear();
+    for (; next != appended.rend() && candidates.size() < static_cast<size_t>(max_resend_samples); ++next) {
+      // Control messages don't have an instance.
+      const PublicationInstance_rch inst = next->get_handle();
+      if (inst && inst->durable_samples_remaining_ && !resend_data_expired(*next, lifespan)) {
+        candidates.push_back(&*next);
+      }
+    }
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    // Evaluate the filter for the batch at once.
+    FilterEvaluator::BatchResults filtered;
+    if (eval) {
+      writer_->filter_out(candidates, filterClassName, *eval, params, filtered);
+    }
+#endif
 
-    if (resend_data_expired(*cur, lifespan))
-      continue;
+    for (size_t i = 0; i < candidates.size() && max_resend_samples; ++i) {
+      const DataSampleElement* const cur = candidates[i];
 
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
-    if (eval && writer_->filter_out(*cur, filterClassName, *eval, params))
-      continue;
+      if (eval && filtered[i])
+        continue;
 #endif
 
-    PublicationInstance_rch inst = cur->get_handle();
+      PublicationInstance_rch inst = cur->get_handle();
 
-    if (!inst) {
-      // *cur is a control message, just skip it
-      continue;
-    }
+      if (inst->durable_samples_remaining_ == 0)
+        continue;
+      --inst->durable_samples_remaining_;
 
-    if (inst->durable_samples_remaining_ == 0)
-      continue;
-    --inst->durable_samples_remaining_;
+      DataSampleElement* element = 0;
+      ACE_NEW_MALLOC(element,
+                     static_cast<DataSampleElement*>(
+                       sample_list_element_allocator_.malloc(
+                         sizeof(DataSampleElement))),
+                     DataSampleElement(*cur));
 
-    DataSampleElement* element = 0;
-    ACE_NEW_MALLOC(element,
-                   static_cast<DataSampleElement*>(
-                     sample_list_element_allocator_.malloc(
-                       sizeof(DataSampleElement))),
-                   DataSampleElement(*cur));
+      element->set_num_subs(1);
+      element->set_sub_id(0, reader_id);
 
-    element->set_num_subs(1);
-    element->set_sub_id(0, reader_id);
+      if (DCPS_debug_level > 9) {
+        ACE_DEBUG((LM_DEBUG, "(%P|%t) WriteDataContainer::copy_and_prepend added seq# %q\n",
+                   cur->get_header().sequence_.getValue()));
+      }
 
-    if (DCPS_debug_level > 9) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) WriteDataContainer::copy_and_prepend added seq# %q\n",
-                 cur->get_header().sequence_.getValue()));
+      list.enqueue_head(element);
+      --max_resend_samples;
     }
-
-    list.enqueue_head(element);
-    --max_resend_samples;
   }
 }
 
@@ -8,8 +8,10 @@
 #ifndef OPENDDS_SAFETY_PROFILE
 #  include "DynamicDataImpl.h"
 
+#  include "DynamicDataXcdrReadImpl.h"
 #  include "DynamicTypeMemberImpl.h"
 #  include "Utils.h"
+#  include "XcdrTranscoder.h"
 
 #  include <dds/DCPS/DisjointSequence.h>
 #  include <dds/DCPS/DCPS_Utils.h>
@@ -26,12 +28,63 @@ using DCPS::LogLevel;
 using DCPS::log_level;
 using DCPS::retcode_to_string;
 
+const size_t DynamicDataLayout::NO_SLOT;
+
+DCPS::RcHandle<DynamicDataLayout> DynamicDataLayout::compile(DDS::DynamicType_ptr type)
+{
+  const DDS::DynamicType_var base = get_base_type(type);
+  DDS::TypeDescriptor_var td;
+  if (!base || base->get_kind() != TK_STRUCTURE || base->get_descriptor(td) != DDS::RETCODE_OK ||
+      td->extensibility_kind() == DDS::MUTABLE) {
+    return DCPS::RcHandle<DynamicDataLayout>();
+  }
+
+  DCPS::RcHandle<DynamicDataLayout> layout = DCPS::make_rch<DynamicDataLayout>();
+  const ACE_CDR::ULong count = base->get_member_count();
+  layout->ids_.reserve(count);
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    DDS::DynamicTypeMember_var dtm;
+    DDS::MemberDescriptor_var md;
+    if (base->get_member_by_index(dtm, i) != DDS::RETCODE_OK ||
+        dtm->get_descriptor(md) != DDS::RETCODE_OK) {
+      return DCPS::RcHandle<DynamicDataLayout>();
+    }
+    const DDS::DynamicType_var member_type = get_base_type(md->type());
+    if (!member_type || member_type->get_kind() == TK_UNION) {
+      return DCPS::RcHandle<DynamicDataLayout>();
+    }
+    layout->ids_.push_back(md->id());
+  }
+
+  size_t table_size = 2;
+  while (table_size < 2 * count) {
+    table_size *= 2;
+  }
+  layout->table_.assign(table_size, 0);
+  layout->mask_ = table_size - 1;
+  for (size_t slot = 0; slot < count; ++slot) {
+    size_t i = layout->hash(layout->ids_[slot]);
+    while (layout->table_[i] != 0) {
+      i = (i + 1) & layout->mask_;
+    }
+    layout->table_[i] = slot + 1;
+  }
+  return layout;
+}
+
 DynamicDataImpl::DynamicDataImpl(DDS::DynamicType_ptr type,
                                  DDS::DynamicData_ptr backing_store)
   : DynamicDataBase(type)
   , container_(type_, this)
   , backing_store_(DDS::DynamicData::_duplicate(backing_store))
 {
+  DynamicTypeImpl* const type_impl = dynamic_cast<DynamicTypeImpl*>(type_.in());
+  if (type_impl) {
+    const DCPS::RcHandle<DynamicDataLayout> layout = type_impl->flat_data_layout();
+    if (layout) {
+      container_.use_layout(layout);
+    }
+  }
 }
 
 DynamicDataImpl::DynamicDataImpl(const DynamicDataImpl& other)
@@ -882,7 +935,7 @@ DynamicDataImpl::SingleValue::SingleValue(ACE_OutputCDR::from_boolean value)
 {}
 
 DynamicDataImpl::SingleValue::SingleValue(const char* str)
-  : kind_(TK_STRING8), active_(0), str_(CORBA::string_dup(str))
+  : kind_(TK_STRING8), active_(0), str_(dup_string(str))
 {}
 
 #ifdef DDS_HAS_WCHAR
@@ -891,11 +944,44 @@ DynamicDataImpl::SingleValue::SingleValue(ACE_OutputCDR::from_wchar value)
 {}
 
 DynamicDataImpl::SingleValue::SingleValue(const CORBA::WChar* wstr)
-  : kind_(TK_STRING16), active_(0), wstr_(CORBA::wstring_dup(wstr))
+  : kind_(TK_STRING16), active_(0), wstr_(dup_wstring(wstr))
 {}
 #endif
 
+const char* DynamicDataImpl::SingleValue::dup_string(const char* str)
+{
+  if (!str) {
+    return 0;
+  }
+  const size_t len = ACE_OS::strlen(str);
+  if (len < sizeof short_str_) {
+    ACE_OS::memcpy(short_str_, str, len + 1);
+    return short_str_;
+  }
+  return CORBA::string_dup(str);
+}
+
+#ifdef DDS_HAS_WCHAR
+const CORBA::WChar* DynamicDataImpl::SingleValue::dup_wstring(const CORBA::WChar* wstr)
+{
+  if (!wstr) {
+    return 0;
+  }
+  const size_t len = ACE_OS::strlen(wstr);
+  if (len < sizeof short_wstr_ / sizeof short_wstr_[0]) {
+    ACE_OS::memcpy(short_wstr_, wstr, (len + 1) * sizeof(CORBA::WChar));
+    return short_wstr_;
+  }
+  return CORBA::wstring_dup(wstr);
+}
+#endif
+
 DynamicDataImpl::SingleValue::~SingleValue()
+{
+  destroy();
+}
+
+void DynamicDataImpl::SingleValue::destroy()
 {
 #define SINGLE_VALUE_DESTRUCT(T) static_cast<ACE_OutputCDR::T*>(active_)->~T(); break
   switch (kind_) {
@@ -910,13 +996,17 @@ DynamicDataImpl::SingleValue::~SingleValue()
   case TK_BOOLEAN:
     SINGLE_VALUE_DESTRUCT(from_boolean);
   case TK_STRING8:
-    CORBA::string_free((char*)str_);
+    if (str_ != short_str_) {
+      CORBA::string_free((char*)str_);
+    }
     break;
 #ifdef DDS_HAS_WCHAR
   case TK_CHAR16:
     SINGLE_VALUE_DESTRUCT(from_wchar);
   case TK_STRING16:
-    CORBA::wstring_free((CORBA::WChar*)wstr_);
+    if (wstr_ != short_wstr_) {
+      CORBA::wstring_free((CORBA::WChar*)wstr_);
+    }
     break;
 #endif
   }
@@ -1019,14 +1109,14 @@ void DynamicDataImpl::SingleValue::copy(const SingleValue& other)
     active_ = new(char8_) ACE_OutputCDR::from_char(other.get<ACE_OutputCDR::from_char>());
     break;
   case TK_STRING8:
-    str_ = CORBA::string_dup(other.str_);
+    str_ = dup_string(other.str_);
     break;
 #ifdef DDS_HAS_WCHAR
   case TK_CHAR16:
     active_ = new(char16_) ACE_OutputCDR::from_wchar(other.get<ACE_OutputCDR::from_wchar>());
     break;
   case TK_STRING16:
-    wstr_ = CORBA::wstring_dup(other.wstr_);
+    wstr_ = dup_wstring(other.wstr_);
     break;
 #endif
   }
@@ -1042,12 +1132,19 @@ DynamicDataImpl::SingleValue::SingleValue(const SingleValue& other)
 
 DynamicDataImpl::SingleValue& DynamicDataImpl::SingleValue::operator=(const SingleValue& other)
 {
-  kind_ = other.kind_;
-  active_ = 0;
-  copy(other);
+  if (this != &other) {
+    destroy();
+    kind_ = other.kind_;
+    active_ = 0;
+    copy(other);
+  }
   return *this;
 }
 
+DynamicDataImpl::SequenceValue::SequenceValue()
+  : elem_kind_(TK_NONE), active_(0)
+{}
+
 DynamicDataImpl::SequenceValue::SequenceValue(const DDS::Int32Seq& int32_seq)
   : elem_kind_(TK_INT32), active_(new(int32_seq_) DDS::Int32Seq(int32_seq))
 {}
@@ -1120,6 +1217,22 @@ DynamicDataImpl::SequenceValue::SequenceValue(const DDS::WstringSeq& wstr_seq)
 
 DynamicDataImpl::SequenceValue::SequenceValue(const SequenceValue& rhs)
   : elem_kind_(rhs.elem_kind_), active_(0)
+{
+  copy(rhs);
+}
+
+DynamicDataImpl::SequenceValue& DynamicDataImpl::SequenceValue::operator=(const SequenceValue& rhs)
+{
+  if (this != &rhs) {
+    destroy();
+    elem_kind_ = rhs.elem_kind_;
+    active_ = 0;
+    copy(rhs);
+  }
+  return *this;
+}
+
+void DynamicDataImpl::SequenceValue::copy(const SequenceValue& rhs)
 {
 #define SEQUENCE_VALUE_PLACEMENT_NEW(T, N)  active_ = new(N) DDS::T(reinterpret_cast<const DDS::T&>(rhs.N)); break;
   switch (elem_kind_) {
@@ -1164,6 +1277,11 @@ DynamicDataImpl::SequenceValue::SequenceValue(const SequenceValue& rhs)
 }
 
 DynamicDataImpl::SequenceValue::~SequenceValue()
+{
+  destroy();
+}
+
+void DynamicDataImpl::SequenceValue::destroy()
 {
 #define SEQUENCE_VALUE_DESTRUCT(T) static_cast<DDS::T*>(active_)->~T(); break
   switch (elem_kind_) {
@@ -2130,8 +2248,38 @@ DDS::ReturnCode_t DynamicDataImpl::set_wstring_value(DDS::MemberId id, const COR
 #endif
 }
 
+const DynamicDataXcdrReadImpl* DynamicDataImpl::unmodified_backing_store(DCPS::Sample::Extent ext) const
+{
+  if (!container_.single_map_.empty() || !container_.sequence_map_.empty() ||
+      !container_.complex_map_.empty()) {
+    return 0;
+  }
+  const DynamicDataXcdrReadImpl* const bs =
+    dynamic_cast<const DynamicDataXcdrReadImpl*>(backing_store_.in());
+  return bs && bs->extent() == ext ? bs : 0;
+}
+
+XcdrTranscoder_rch DynamicDataImpl::backing_store_transcoder() const
+{
+  const DDS::DynamicType_var bs_type = backing_store_->type();
+  if (bs_type.in() == type_.in()) {
+    return identity_transcoder(type_);
+  }
+  // The backing store was made for another type, which DynamicSample and
+  // DynamicDataReaderImpl don't do, so this isn't cached.
+  return DCPS::make_rch<XcdrTranscoder>(bs_type.in(), type_.in());
+}
+
 bool DynamicDataImpl::serialized_size(const DCPS::Encoding& enc, size_t& size, DCPS::Sample::Extent ext) const
 {
+  if (const DynamicDataXcdrReadImpl* const bs = unmodified_backing_store(ext)) {
+    // Nothing was set, so the sample is what the backing store read.
+    const XcdrTranscoder_rch transcoder = backing_store_transcoder();
+    if (transcoder->is_valid()) {
+      return bs->transcoded_size(*transcoder, enc, size);
+    }
+  }
+
   DynamicDataImpl* non_const_this = const_cast<DynamicDataImpl*>(this);
   if (ext == DCPS::Sample::Full) {
     return DCPS::serialized_size(enc, size, non_const_this);
@@ -2144,6 +2292,13 @@ bool DynamicDataImpl::serialized_size(const DCPS::Encoding& enc, size_t& size, D
 
 bool DynamicDataImpl::serialize(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const
 {
+  if (const DynamicDataXcdrReadImpl* const bs = unmodified_backing_store(ext)) {
+    const XcdrTranscoder_rch transcoder = backing_store_transcoder();
+    if (transcoder->is_valid()) {
+      return bs->transcode(*transcoder, ser);
+    }
+  }
+
   DynamicDataImpl* non_const_this = const_cast<DynamicDataImpl*>(this);
   if (ext == DCPS::Sample::Full) {
     return ser << non_const_this;
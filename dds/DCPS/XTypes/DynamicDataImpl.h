@@ -13,16 +13,68 @@
 #  include <dds/DCPS/Sample.h>
 #  include <dds/DCPS/ValueWriter.h>
 
+#  include <iterator>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 
 namespace XTypes {
 class DynamicDataImpl;
+class DynamicDataXcdrReadImpl;
+class XcdrTranscoder;
 }
 
 namespace XTypes {
 
+// Slot layout for the DynamicDataImpl of a final or appendable struct type
+// without union members, compiled once per type (see
+// DynamicTypeImpl::use_flat_data_layout). Each member is given the slot of its
+// index in the type, so the values of a struct sit in a fixed-size vector in
+// member order, and an open-addressed table maps any member ID, dense or not,
+// to its slot in constant time.
+class DynamicDataLayout : public DCPS::RcObject {
+public:
+  static const size_t NO_SLOT = ~size_t(0);
+
+  // Null if the type can't use a slot layout.
+  static DCPS::RcHandle<DynamicDataLayout> compile(DDS::DynamicType_ptr type);
+
+  DynamicDataLayout()
+    : mask_(0)
+  {}
+
+  size_t slot_count() const { return ids_.size(); }
+  DDS::MemberId id_at(size_t slot) const { return ids_[slot]; }
+
+  // Slot of the member with the given ID, or NO_SLOT if there isn't one.
+  size_t slot(DDS::MemberId id) const
+  {
+    for (size_t i = hash(id); ; i = (i + 1) & mask_) {
+      const size_t entry = table_[i];
+      if (entry == 0) {
+        return NO_SLOT;
+      }
+      if (ids_[entry - 1] == id) {
+        return entry - 1;
+      }
+    }
+  }
+
+private:
+  size_t hash(DDS::MemberId id) const
+  {
+    return static_cast<ACE_CDR::ULong>(id * 2654435761u) & mask_;
+  }
+
+  // Member IDs by slot.
+  OPENDDS_VECTOR(DDS::MemberId) ids_;
+  // Hash table of slot + 1, with 0 for an empty entry. It's at least twice the
+  // number of members so there is always an empty entry to end a probe.
+  OPENDDS_VECTOR(size_t) table_;
+  size_t mask_;
+};
+
 class OpenDDS_Dcps_Export DynamicDataImpl : public DynamicDataBase {
 public:
   // An optional, read-only backing store can be passed as a last resort for reading data.
@@ -217,6 +269,11 @@ public:
   bool serialize(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const;
 
 private:
+  /// The backing store if nothing was set on this object and the backing
+  /// store can be serialized directly with the given extent.
+  const DynamicDataXcdrReadImpl* unmodified_backing_store(DCPS::Sample::Extent ext) const;
+  DCPS::RcHandle<XcdrTranscoder> backing_store_transcoder() const;
+
   CORBA::ULong get_string_item_count() const;
   CORBA::ULong get_sequence_item_count() const;
   bool has_member(DDS::MemberId id) const;
@@ -486,6 +543,7 @@ private:
     SingleValue(const SingleValue& other);
     SingleValue& operator=(const SingleValue& other);
     void copy(const SingleValue& other);
+    void destroy();
 
     ~SingleValue();
 
@@ -522,9 +580,26 @@ private:
       const CORBA::WChar* wstr_;
 #endif
     };
+
+  private:
+    // Short strings are kept here instead of on the heap, with str_ or wstr_
+    // pointing into the buffer.
+    enum { SHORT_STRING_BYTES = 16 };
+    union {
+      char short_str_[SHORT_STRING_BYTES];
+#ifdef DDS_HAS_WCHAR
+      CORBA::WChar short_wstr_[SHORT_STRING_BYTES / sizeof(CORBA::WChar)];
+#endif
+    };
+
+    const char* dup_string(const char* str);
+#ifdef DDS_HAS_WCHAR
+    const CORBA::WChar* dup_wstring(const CORBA::WChar* wstr);
+#endif
   };
 
   struct SequenceValue {
+    SequenceValue();
     SequenceValue(const DDS::Int32Seq& int32_seq);
     SequenceValue(const DDS::UInt32Seq& uint32_seq);
     SequenceValue(const DDS::Int8Seq& int8_seq);
@@ -546,6 +621,10 @@ private:
 #endif
 
     SequenceValue(const SequenceValue& rhs);
+    SequenceValue& operator=(const SequenceValue& rhs);
+    void copy(const SequenceValue& rhs);
+    void destroy();
+
     ~SequenceValue();
 
     template<typename T> const T& get() const;
@@ -575,14 +654,229 @@ private:
 #endif
 #undef SEQUENCE_VALUE_MEMBER
     };
+  };
+
+  // Flat storage for the values in a DataContainer, with the subset of the
+  // std::map interface used here.
+  //
+  // By default it's a vector of (ID, value) pairs kept sorted by ID. Members of
+  // a struct usually have sequential IDs from 0 and elements of a collection
+  // use the index as the ID, so once the leading members or elements are set,
+  // the value with ID n is at position n and lookup is a single check instead
+  // of a tree walk. Otherwise it falls back to a binary search. Values set in ID
+  // order are appended, and iterating visits them contiguously.
+  //
+  // With a DynamicDataLayout the vector instead has one entry per member of the
+  // struct, allocated on the first insert, and a member's value is always at
+  // the member's slot. Lookup of any member ID is constant time, and iterating
+  // skips the members that aren't set.
+  template<typename Value>
+  class MemberMap {
+  public:
+    typedef std::pair<DDS::MemberId, Value> value_type;
+
+    class const_iterator {
+    public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef std::pair<DDS::MemberId, Value> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+
+      const_iterator()
+        : map_(0)
+        , pos_(0)
+      {}
+
+      const_iterator(const MemberMap* map, size_t pos)
+        : map_(map)
+        , pos_(pos)
+      {}
+
+      reference operator*() const { return map_->values_[pos_]; }
+      pointer operator->() const { return &map_->values_[pos_]; }
+
+      const_iterator& operator++()
+      {
+        pos_ = map_->next(pos_);
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const const_iterator prev(*this);
+        ++*this;
+        return prev;
+      }
+
+      const_iterator& operator--()
+      {
+        pos_ = map_->prev(pos_);
+        return *this;
+      }
+
+      const_iterator operator--(int)
+      {
+        const const_iterator next(*this);
+        --*this;
+        return next;
+      }
+
+      bool operator==(const const_iterator& other) const { return pos_ == other.pos_; }
+      bool operator!=(const const_iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+      const MemberMap* map_;
+      size_t pos_;
+    };
+    friend class const_iterator;
+
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    MemberMap()
+      : count_(0)
+    {}
+
+    // Store values in the slots of the given layout. Call only while empty.
+    void use_layout(const DCPS::RcHandle<DynamicDataLayout>& layout) { layout_ = layout; }
+
+    const_iterator begin() const
+    {
+      size_t pos = 0;
+      while (pos < values_.size() && !present(pos)) {
+        ++pos;
+      }
+      return const_iterator(this, pos);
+    }
+
+    const_iterator end() const { return const_iterator(this, values_.size()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    bool empty() const { return size() == 0; }
+    size_t size() const { return layout_ ? count_ : values_.size(); }
+
+    void clear()
+    {
+      values_.clear();
+      present_.clear();
+      count_ = 0;
+    }
+
+    const_iterator find(DDS::MemberId id) const
+    {
+      if (layout_) {
+        const size_t slot = layout_->slot(id);
+        return slot < present_.size() && present_[slot] ? const_iterator(this, slot) : end();
+      }
+      const size_t pos = lower_bound(id);
+      return pos < values_.size() && values_[pos].first == id ? const_iterator(this, pos) : end();
+    }
+
+    std::pair<const_iterator, bool> insert(const value_type& value)
+    {
+      if (layout_) {
+        const size_t slot = layout_->slot(value.first);
+        if (slot == DynamicDataLayout::NO_SLOT) {
+          return std::make_pair(end(), false);
+        }
+        if (values_.empty()) {
+          allocate_slots();
+        }
+        if (present_[slot]) {
+          return std::make_pair(const_iterator(this, slot), false);
+        }
+        values_[slot].second = value.second;
+        present_[slot] = true;
+        ++count_;
+        return std::make_pair(const_iterator(this, slot), true);
+      }
+      const size_t pos = lower_bound(value.first);
+      if (pos < values_.size() && values_[pos].first == value.first) {
+        return std::make_pair(const_iterator(this, pos), false);
+      }
+      values_.insert(values_.begin() + pos, value);
+      return std::make_pair(const_iterator(this, pos), true);
+    }
+
+    size_t erase(DDS::MemberId id)
+    {
+      if (layout_) {
+        const size_t slot = layout_->slot(id);
+        if (slot >= present_.size() || !present_[slot]) {
+          return 0;
+        }
+        values_[slot].second = Value();
+        present_[slot] = false;
+        --count_;
+        return 1;
+      }
+      const size_t pos = lower_bound(id);
+      if (pos == values_.size() || values_[pos].first != id) {
+        return 0;
+      }
+      values_.erase(values_.begin() + pos);
+      return 1;
+    }
 
   private:
-    SequenceValue& operator=(const SequenceValue& rhs);
+    bool present(size_t pos) const { return !layout_ || present_[pos]; }
+
+    size_t next(size_t pos) const
+    {
+      do {
+        ++pos;
+      } while (pos < values_.size() && !present(pos));
+      return pos;
+    }
+
+    size_t prev(size_t pos) const
+    {
+      do {
+        --pos;
+      } while (pos > 0 && !present(pos));
+      return pos;
+    }
+
+    void allocate_slots()
+    {
+      const size_t count = layout_->slot_count();
+      values_.resize(count);
+      present_.assign(count, false);
+      for (size_t i = 0; i < count; ++i) {
+        values_[i].first = layout_->id_at(i);
+      }
+    }
+
+    // Position of the first value with an ID not less than id.
+    size_t lower_bound(DDS::MemberId id) const
+    {
+      if (id < values_.size() && values_[id].first == id) {
+        return id;
+      }
+      if (values_.empty() || values_.back().first < id) {
+        return values_.size();
+      }
+      size_t low = 0, high = values_.size();
+      while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (values_[mid].first < id) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      return low;
+    }
+
+    OPENDDS_VECTOR(value_type) values_;
+    DCPS::RcHandle<DynamicDataLayout> layout_;
+    // Which slots are set, only used with a layout.
+    OPENDDS_VECTOR(bool) present_;
+    size_t count_;
   };
 
-  typedef OPENDDS_MAP(DDS::MemberId, SingleValue)::const_iterator const_single_iterator;
-  typedef OPENDDS_MAP(DDS::MemberId, SequenceValue)::const_iterator const_sequence_iterator;
-  typedef OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var)::const_iterator const_complex_iterator;
+  typedef MemberMap<SingleValue>::const_iterator const_single_iterator;
+  typedef MemberMap<SequenceValue>::const_iterator const_sequence_iterator;
+  typedef MemberMap<DDS::DynamicData_var>::const_iterator const_complex_iterator;
 
   // Container for all data written to this DynamicData object.
   // At anytime, there can be at most 1 entry for any given MemberId in all maps.
@@ -605,6 +899,13 @@ private:
 
     void clear();
 
+    void use_layout(const DCPS::RcHandle<DynamicDataLayout>& layout)
+    {
+      single_map_.use_layout(layout);
+      sequence_map_.use_layout(layout);
+      complex_map_.use_layout(layout);
+    }
+
     // Get the largest index of all elements in each map.
     // Call only for collection-like types (sequence, string, etc).
     // Must be called with a non-empty map.
@@ -622,9 +923,9 @@ private:
     bool get_largest_index_basic_sequence(CORBA::ULong& index) const;
 
     // Internal data
-    OPENDDS_MAP(DDS::MemberId, SingleValue) single_map_;
-    OPENDDS_MAP(DDS::MemberId, SequenceValue) sequence_map_;
-    OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var) complex_map_;
+    MemberMap<SingleValue> single_map_;
+    MemberMap<SequenceValue> sequence_map_;
+    MemberMap<DDS::DynamicData_var> complex_map_;
 
     const DDS::DynamicType_var& type_;
     const DDS::TypeDescriptor_var& type_desc_;
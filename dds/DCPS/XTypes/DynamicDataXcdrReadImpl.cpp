@@ -10,6 +10,7 @@
 
 #  include "DynamicTypeMemberImpl.h"
 #  include "Utils.h"
+#  include "XcdrTranscoder.h"
 
 #  include <dds/DCPS/debug.h>
 #  include <dds/DCPS/FilterEvaluator.h>
@@ -40,6 +41,7 @@
 
 #  include <ace/OS_NS_string.h>
 
+#  include <algorithm>
 #  include <stdexcept>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -132,6 +134,9 @@ void DynamicDataXcdrReadImpl::copy(const DynamicDataXcdrReadImpl& other)
   strm_ = other.strm_;
   type_ = other.type_;
   item_count_ = other.item_count_;
+  offset_index_ = other.offset_index_;
+  ACE_Guard<ACE_Thread_Mutex> guard(sizes_mutex_);
+  sizes_.clear();
 }
 
 DDS::ReturnCode_t DynamicDataXcdrReadImpl::set_descriptor(MemberId, DDS::MemberDescriptor*)
@@ -1094,22 +1099,29 @@ bool DynamicDataXcdrReadImpl::skip_to_sequence_element(MemberId id, DDS::Dynamic
     return (strm_ >> length) &&
       get_index_from_id(id, index, length) &&
       strm_.skip(index, size);
-  } else {
-    ACE_CDR::ULong length, index;
+  } else if (skip_all) {
+    ACE_CDR::ULong length;
     if (!strm_.skip_delimiter() || !(strm_ >> length)) {
       return false;
     }
-    if (skip_all) {
-      index = length;
-    } else if (!get_index_from_id(id, index, length)) {
-      return false;
-    }
-    for (ACE_CDR::ULong i = 0; i < index; ++i) {
+    for (ACE_CDR::ULong i = 0; i < length; ++i) {
       if (!skip_member(elem_type)) {
         return false;
       }
     }
     return true;
+  } else {
+    if (!offset_index_.valid) {
+      ACE_CDR::ULong length;
+      if (!strm_.skip_delimiter() || !(strm_ >> length)) {
+        return false;
+      }
+      offset_index_.start(strm_.rpos(), 0);
+      offset_index_.length = length;
+    }
+    ACE_CDR::ULong index;
+    return get_index_from_id(id, index, offset_index_.length) &&
+      skip_to_indexed_element(index, elem_type);
   }
 }
 
@@ -1134,22 +1146,28 @@ bool DynamicDataXcdrReadImpl::skip_to_array_element(MemberId id, DDS::DynamicTyp
   if (get_primitive_size(elem_type, size)) {
     ACE_CDR::ULong index;
     return get_index_from_id(id, index, length) && strm_.skip(index, size);
-  } else {
+  } else if (skip_all) {
     if (!strm_.skip_delimiter()) {
       return false;
     }
+    for (ACE_CDR::ULong i = 0; i < length; ++i) {
+      if (!skip_member(elem_type)) {
+        return false;
+      }
+    }
+    return true;
+  } else {
     ACE_CDR::ULong index;
-    if (skip_all) {
-      index = length;
-    } else if (!get_index_from_id(id, index, length)) {
+    if (!get_index_from_id(id, index, length)) {
       return false;
     }
-    for (ACE_CDR::ULong i = 0; i < index; ++i) {
-      if (!skip_member(elem_type)) {
+    if (!offset_index_.valid) {
+      if (!strm_.skip_delimiter()) {
         return false;
       }
+      offset_index_.start(strm_.rpos(), 0);
     }
-    return true;
+    return skip_to_indexed_element(index, elem_type);
   }
 }
 
@@ -1173,22 +1191,42 @@ bool DynamicDataXcdrReadImpl::skip_to_map_element(MemberId id)
     }
     return strm_.skip(1, key_size);
   } else {
-    size_t dheader;
     ACE_CDR::ULong index;
-    if (!strm_.read_delimiter(dheader) || !get_index_from_id(id, index, ACE_UINT32_MAX)) {
+    if (!get_index_from_id(id, index, ACE_UINT32_MAX)) {
       return false;
     }
-    const size_t end_of_map = strm_.rpos() + dheader;
-
-    for (ACE_CDR::ULong i = 0; i < index; ++i) {
-      if (strm_.rpos() >= end_of_map || !skip_member(key_type) || !skip_member(elem_type)) {
+    if (!offset_index_.valid) {
+      size_t dheader;
+      if (!strm_.read_delimiter(dheader)) {
         return false;
       }
+      offset_index_.start(strm_.rpos(), strm_.rpos() + dheader);
     }
-    return (strm_.rpos() < end_of_map) && skip_member(key_type);
+    return skip_to_indexed_element(index, elem_type, key_type) &&
+      (strm_.rpos() < offset_index_.end) && skip_member(key_type);
   }
 }
 
+bool DynamicDataXcdrReadImpl::skip_to_indexed_element(ACE_CDR::ULong index,
+                                                      DDS::DynamicType_ptr elem_type,
+                                                      DDS::DynamicType_ptr key_type)
+{
+  ACE_CDR::ULong i = (std::min)(index, static_cast<ACE_CDR::ULong>(offset_index_.positions.size() - 1));
+  if (!seek(offset_index_.positions[i])) {
+    return false;
+  }
+  for (; i < index; ++i) {
+    if (key_type && (strm_.rpos() >= offset_index_.end || !skip_member(key_type))) {
+      return false;
+    }
+    if (!skip_member(elem_type)) {
+      return false;
+    }
+    offset_index_.add(i + 1, strm_.rpos());
+  }
+  return true;
+}
+
 template<TypeKind ElementTypeKind, typename ElementType>
 bool DynamicDataXcdrReadImpl::get_value_from_collection(ElementType& value, MemberId id, TypeKind collection_tk,
                                                         TypeKind enum_or_bitmask, LBound lower, LBound upper)
@@ -1248,6 +1286,21 @@ void DynamicDataXcdrReadImpl::setup_stream(ACE_Message_Block* chain)
   }
 }
 
+bool DynamicDataXcdrReadImpl::seek(size_t rpos)
+{
+  const size_t current = strm_.rpos();
+  if (rpos < current) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::seek: "
+                 "Can't move back from %B to %B\n", current, rpos));
+    }
+    return false;
+  }
+  // Skipping bytes without alignment keeps the alignment state the same as
+  // if the skipped values had been read.
+  return strm_.skip(rpos - current);
+}
+
 template<TypeKind ValueTypeKind, typename ValueType>
 DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_single_value(ValueType& value, MemberId id,
                                                             TypeKind enum_or_bitmask, LBound lower, LBound upper)
@@ -2156,6 +2209,55 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_wstring_values(DDS::WstringSeq& v
 #endif
 }
 
+bool DynamicDataXcdrReadImpl::serialized_size(const DCPS::Encoding& enc, size_t& size,
+                                              DCPS::Sample::Extent ext) const
+{
+  return ext == extent_ && transcoded_size(*identity_transcoder(type_), enc, size);
+}
+
+bool DynamicDataXcdrReadImpl::serialize(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const
+{
+  return ext == extent_ && transcode(*identity_transcoder(type_), ser);
+}
+
+bool DynamicDataXcdrReadImpl::transcoded_size(const XcdrTranscoder& transcoder,
+                                              const DCPS::Encoding& enc, size_t& size) const
+{
+  if (!chain_) {
+    return false;
+  }
+  const DCPS::Message_Block_Ptr dup(chain_->duplicate());
+  DCPS::Serializer in(dup.get(), encoding_);
+  if (reset_align_state_) {
+    in.rdstate(align_state_);
+  }
+  XcdrTranscoder::Sizes sizes;
+  if (!transcoder.serialized_size(in, enc, size, extent_, &sizes)) {
+    return false;
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(sizes_mutex_);
+  sizes_.swap(sizes);
+  return true;
+}
+
+bool DynamicDataXcdrReadImpl::transcode(const XcdrTranscoder& transcoder, DCPS::Serializer& ser) const
+{
+  if (!chain_) {
+    return false;
+  }
+  const DCPS::Message_Block_Ptr dup(chain_->duplicate());
+  DCPS::Serializer in(dup.get(), encoding_);
+  if (reset_align_state_) {
+    in.rdstate(align_state_);
+  }
+  XcdrTranscoder::Sizes sizes;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(sizes_mutex_);
+    sizes_.swap(sizes);
+  }
+  return transcoder.transcode(in, ser, extent_, &sizes);
+}
+
 DDS::DynamicType_ptr DynamicDataXcdrReadImpl::type()
 {
   return DDS::DynamicType::_duplicate(type_);
@@ -2178,19 +2280,31 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
 {
   const DDS::ExtensibilityKind ek = type_desc_->extensibility_kind();
   if (ek == DDS::FINAL || ek == DDS::APPENDABLE) {
-    size_t dheader = 0;
     const bool xcdr2_appendable = encoding_.xcdr_version() == DCPS::Encoding::XCDR_VERSION_2 &&
       ek == DDS::APPENDABLE;
-    if (xcdr2_appendable && !strm_.read_delimiter(dheader)) {
-      if (log_level >= LogLevel::Notice) {
-        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member: "
-                   "Failed to read DHEADER for member ID %d\n", id));
+    if (!offset_index_.valid) {
+      size_t dheader = 0;
+      if (xcdr2_appendable && !strm_.read_delimiter(dheader)) {
+        if (log_level >= LogLevel::Notice) {
+          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member: "
+                     "Failed to read DHEADER for member ID %d\n", id));
+        }
+        return DDS::RETCODE_ERROR;
       }
+      offset_index_.start(strm_.rpos(), strm_.rpos() + dheader);
+    }
+    const size_t end_of_struct = offset_index_.end;
+
+    const ACE_CDR::ULong index = member_desc->index();
+    ACE_CDR::ULong i = (std::min)(index, static_cast<ACE_CDR::ULong>(offset_index_.positions.size() - 1));
+    if (!seek(offset_index_.positions[i])) {
       return DDS::RETCODE_ERROR;
     }
-    const size_t end_of_struct = strm_.rpos() + dheader;
+    if (i > 0 && xcdr2_appendable && strm_.rpos() >= end_of_struct) {
+      return DDS::RETCODE_NO_DATA;
+    }
 
-    for (ACE_CDR::ULong i = 0; i < member_desc->index(); ++i) {
+    for (; i < index; ++i) {
       DDS::DynamicTypeMember_var dtm;
       DDS::ReturnCode_t rc = type_->get_member_by_index(dtm, i);
       if (rc != DDS::RETCODE_OK) {
@@ -2211,6 +2325,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
       }
       if (exclude_member(extent_, md->is_key(), has_explicit_keys(type_))) {
         // This member is not present in the sample, don't need to do anything.
+        offset_index_.add(i + 1, strm_.rpos());
         continue;
       }
 
@@ -2222,6 +2337,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         }
         return DDS::RETCODE_ERROR;
       }
+      offset_index_.add(i + 1, strm_.rpos());
       if (xcdr2_appendable && strm_.rpos() >= end_of_struct) {
         return DDS::RETCODE_NO_DATA;
       }
@@ -2243,18 +2359,31 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
 
     return DDS::RETCODE_OK;
   } else {
-    size_t dheader = 0;
-    if (!strm_.read_delimiter(dheader)) {
-      if (DCPS::DCPS_debug_level >= 1) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
-                   ACE_TEXT(" Failed to read DHEADER for member ID %d\n"), id));
+    if (!offset_index_.valid) {
+      size_t dheader = 0;
+      if (!strm_.read_delimiter(dheader)) {
+        if (DCPS::DCPS_debug_level >= 1) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                     ACE_TEXT(" Failed to read DHEADER for member ID %d\n"), id));
+        }
+        return DDS::RETCODE_ERROR;
       }
-      return DDS::RETCODE_ERROR;
+      offset_index_.start(strm_.rpos(), strm_.rpos() + dheader);
     }
 
-    const size_t end_of_struct = strm_.rpos() + dheader;
+    // Members found by an earlier search don't need to be searched for again.
+    const OPENDDS_MAP(MemberId, size_t)::const_iterator found = offset_index_.member_positions.find(id);
+    if (found != offset_index_.member_positions.end()) {
+      return seek(found->second) ? DDS::RETCODE_OK : DDS::RETCODE_ERROR;
+    }
+
+    const size_t end_of_struct = offset_index_.end;
+    if (!offset_index_.scan_done && !seek(offset_index_.scan_pos)) {
+      return DDS::RETCODE_ERROR;
+    }
     while (true) {
-      if (strm_.rpos() >= end_of_struct) {
+      if (offset_index_.scan_done || strm_.rpos() >= end_of_struct) {
+        offset_index_.scan_done = true;
         if (DCPS::DCPS_debug_level >= 1) {
           ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
                      ACE_TEXT(" Could not find a member with ID %d\n"), id));
@@ -2273,6 +2402,10 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return DDS::RETCODE_ERROR;
       }
 
+      // Like the search itself, the index keeps the first occurrence of an ID.
+      offset_index_.member_positions.insert(std::make_pair(member_id, strm_.rpos()));
+      offset_index_.scan_pos = strm_.rpos() + member_size;
+
       if (member_id == id) {
         return DDS::RETCODE_OK;
       }
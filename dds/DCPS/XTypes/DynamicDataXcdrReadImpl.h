@@ -9,6 +9,7 @@
 #ifndef OPENDDS_SAFETY_PROFILE
 #  include "DynamicDataBase.h"
 #  include "TypeObject.h"
+#  include "XcdrTranscoder.h"
 
 #  include <dds/DCPS/PoolAllocator.h>
 #  include <dds/DCPS/Sample.h>
@@ -340,17 +341,19 @@ public:
 
   CORBA::Boolean equals(DDS::DynamicData_ptr other);
 
-  bool serialized_size(const DCPS::Encoding&, size_t&, DCPS::Sample::Extent) const
-  {
-    // Not supported.
-    return false;
-  }
+  bool serialized_size(const DCPS::Encoding& enc, size_t& size, DCPS::Sample::Extent ext) const;
+  bool serialize(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const;
 
-  bool serialize(DCPS::Serializer&, DCPS::Sample::Extent) const
-  {
-    // Not supported.
-    return false;
-  }
+  DCPS::Sample::Extent extent() const { return extent_; }
+
+  /// Serialize the sample by transcoding the backing message block, which
+  /// avoids reading it member by member.  The transcoder must be from the
+  /// type of this object and the sample is written with its own extent.
+  /// The header sizes computed by transcoded_size are kept for the next
+  /// transcode with the same transcoder.
+  bool transcoded_size(const XcdrTranscoder& transcoder, const DCPS::Encoding& enc,
+                       size_t& size) const;
+  bool transcode(const XcdrTranscoder& transcoder, DCPS::Serializer& ser) const;
 
 private:
 
@@ -461,6 +464,15 @@ private:
   /// element is also skipped.
   bool skip_to_map_element(MemberId id);
 
+  /// Skip to the element (or the key-element pair of a map) at @a index of a
+  /// non-primitive collection, resuming from the closest position recorded in
+  /// offset_index_ and recording the positions of the elements it skips.
+  bool skip_to_indexed_element(ACE_CDR::ULong index, DDS::DynamicType_ptr elem_type,
+                               DDS::DynamicType_ptr key_type = 0);
+
+  /// Move a Serializer that was just set up by setup_stream forward to @a rpos.
+  bool seek(size_t rpos);
+
   /// Read a sequence with element type @a elem_tk and store the result in @a value,
   /// which is a sequence of primitives or strings or wstrings. Sequence of enums or
   /// bitmasks are read as a sequence of signed and unsigned integers, respectively.
@@ -550,6 +562,10 @@ private:
   DCPS::Encoding encoding_;
   DCPS::Sample::Extent extent_;
 
+  /// Header sizes from the last transcoded_size.
+  mutable ACE_Thread_Mutex sizes_mutex_;
+  mutable XcdrTranscoder::Sizes sizes_;
+
   /// Indicate whether the alignment state of a Serializer object associated
   /// with this DynamicData needs to be reset.
   bool reset_align_state_;
@@ -572,6 +588,57 @@ private:
 
   /// Cache the number of items (i.e., members or elements) in the data it holds.
   ACE_CDR::ULong item_count_;
+
+  /// Read positions (Serializer::rpos) of members and elements found while skipping
+  /// through the data.  It's filled in by the skip_to_* methods as they go so that
+  /// later calls resume from the closest known position instead of skipping from the
+  /// start of the data every time, which makes reading every member O(N) instead of
+  /// O(N^2).  Only lookups that start at the beginning of the data use it.
+  struct OffsetIndex {
+    OffsetIndex()
+      : valid(false)
+      , end(0)
+      , length(0)
+      , scan_pos(0)
+      , scan_done(false)
+    {}
+
+    void start(size_t start_pos, size_t end_pos)
+    {
+      valid = true;
+      positions.push_back(start_pos);
+      end = end_pos;
+      scan_pos = start_pos;
+    }
+
+    void add(ACE_CDR::ULong index, size_t pos)
+    {
+      if (positions.size() == index) {
+        positions.push_back(pos);
+      }
+    }
+
+    bool valid;
+
+    /// Start of each member of a final or appendable struct by member index, or
+    /// start of each element (key-element pair for maps) of a collection.
+    OPENDDS_VECTOR(size_t) positions;
+
+    /// End of an XCDR2 appendable or mutable struct or of a non-primitive map.
+    size_t end;
+
+    /// Length of a non-primitive sequence.
+    ACE_CDR::ULong length;
+
+    /// Position right after the EMHEADER of each member of a mutable struct.
+    OPENDDS_MAP(MemberId, size_t) member_positions;
+
+    /// Where the search for EMHEADERs in a mutable struct stopped and whether it
+    /// reached the end of the struct.
+    size_t scan_pos;
+    bool scan_done;
+  };
+  OffsetIndex offset_index_;
 };
 
 OpenDDS_Dcps_Export bool print_dynamic_data(DDS::DynamicData_ptr dd,
@@ -0,0 +1,444 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h>
+
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include "DynamicTypeCache.h"
+
+#  include "DynamicTypeImpl.h"
+#  include "DynamicTypeMemberImpl.h"
+#  include "MemberDescriptorImpl.h"
+#  include "TypeDescriptorImpl.h"
+
+#  include <dds/DCPS/debug.h>
+
+#  include <ace/Singleton.h>
+
+#  include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+namespace {
+  struct InstanceHolder {
+    InstanceHolder()
+      : cache(DCPS::make_rch<DynamicTypeCache>())
+    {}
+
+    DynamicTypeCache_rch cache;
+  };
+
+  size_t string_bytes(const char* str)
+  {
+    return str ? std::strlen(str) + 1 : 0;
+  }
+
+  // Rough cost of a node in a std::map of the members of a DynamicTypeImpl
+  const size_t map_node_bytes = 4 * sizeof(void*) + sizeof(DDS::DynamicTypeMember_var);
+
+  typedef OPENDDS_VECTOR(DDS::MemberDescriptor_var) DescriptorVec;
+}
+
+DynamicTypeCache::Stats::Stats()
+  : types(0)
+  , users(0)
+  , member_descriptors(0)
+  , bytes(0)
+  , hits(0)
+  , misses(0)
+  , evictions(0)
+  , shared_member_descriptors(0)
+{
+}
+
+DynamicTypeCache::Entry::Entry()
+  : built(false)
+  , bytes(0)
+{
+}
+
+DynamicTypeCache::DescriptorKey::DescriptorKey(DDS::MemberDescriptor* md)
+  : name(md->name() ? md->name() : "")
+  , default_value(md->default_value() ? md->default_value() : "")
+  , id(md->id())
+  , type(md->type())
+  , index(md->index())
+  , try_construct_kind(md->try_construct_kind())
+  , flags((md->is_key() ? 1 : 0) | (md->is_optional() ? 2 : 0) |
+          (md->is_must_understand() ? 4 : 0) | (md->is_shared() ? 8 : 0) |
+          (md->is_default_label() ? 16 : 0))
+{
+  const DDS::UnionCaseLabelSeq& label = md->label();
+  labels.reserve(label.length());
+  for (ACE_CDR::ULong i = 0; i < label.length(); ++i) {
+    labels.push_back(label[i]);
+  }
+}
+
+bool DynamicTypeCache::DescriptorKey::operator<(const DescriptorKey& other) const
+{
+  if (id != other.id) {
+    return id < other.id;
+  }
+  if (index != other.index) {
+    return index < other.index;
+  }
+  if (type != other.type) {
+    return type < other.type;
+  }
+  if (flags != other.flags) {
+    return flags < other.flags;
+  }
+  if (try_construct_kind != other.try_construct_kind) {
+    return try_construct_kind < other.try_construct_kind;
+  }
+  if (name != other.name) {
+    return name < other.name;
+  }
+  if (default_value != other.default_value) {
+    return default_value < other.default_value;
+  }
+  return labels < other.labels;
+}
+
+DynamicTypeCache::DynamicTypeCache()
+  : last_owner_(0)
+  , type_bytes_(0)
+  , descriptor_bytes_(0)
+  , hits_(0)
+  , misses_(0)
+  , evictions_(0)
+  , shared_descriptors_(0)
+{
+}
+
+DynamicTypeCache::~DynamicTypeCache()
+{
+  for (EntryMap::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    DynamicTypeImpl* const impl = dynamic_cast<DynamicTypeImpl*>(it->second.type.in());
+    if (impl) {
+      impl->clear();
+    }
+  }
+}
+
+DynamicTypeCache_rch DynamicTypeCache::instance()
+{
+  return ACE_Singleton<InstanceHolder, ACE_SYNCH_MUTEX>::instance()->cache;
+}
+
+unsigned long DynamicTypeCache::new_owner()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  return ++last_owner_;
+}
+
+DDS::DynamicType_ptr DynamicTypeCache::find_built(const TypeIdentifier& ti, const User& user)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const EntryMap::iterator found = entries_.find(ti);
+  if (found == entries_.end() || !complete_i(ti)) {
+    return 0;
+  }
+  ++hits_;
+  add_user_i(ti, user);
+  return DDS::DynamicType::_duplicate(found->second.type);
+}
+
+bool DynamicTypeCache::complete_i(const TypeIdentifier& ti) const
+{
+  // A type that's part of a recursive type can be finished before the types
+  // that refer back to it, so its dependencies are checked too.
+  TypeIdentifierSet visited;
+  OPENDDS_VECTOR(const TypeIdentifier*) pending;
+  pending.push_back(&ti);
+  while (!pending.empty()) {
+    const TypeIdentifier* const id = pending.back();
+    pending.pop_back();
+    if (!visited.insert(*id).second) {
+      continue;
+    }
+    const EntryMap::const_iterator it = entries_.find(*id);
+    if (it == entries_.end() || !it->second.built) {
+      return false;
+    }
+    for (TypeIdentifierVec::const_iterator dep = it->second.deps.begin();
+         dep != it->second.deps.end(); ++dep) {
+      pending.push_back(&*dep);
+    }
+  }
+  return true;
+}
+
+DDS::DynamicType_ptr DynamicTypeCache::find_or_insert(const TypeIdentifier& ti, const User& user,
+                                                      DDS::DynamicType_ptr candidate)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const EntryMap::iterator found = entries_.find(ti);
+  if (found != entries_.end()) {
+    ++hits_;
+    add_user_i(ti, user);
+    return DDS::DynamicType::_duplicate(found->second.type);
+  }
+
+  ++misses_;
+  Entry& entry = entries_[ti];
+  entry.type = DDS::DynamicType::_duplicate(candidate);
+  entry.users.insert(user);
+  users_[user].insert(ti);
+  type_ids_[candidate] = ti;
+  return 0;
+}
+
+void DynamicTypeCache::add_user_i(const TypeIdentifier& ti, const User& user)
+{
+  OPENDDS_VECTOR(const TypeIdentifier*) pending;
+  pending.push_back(&ti);
+  while (!pending.empty()) {
+    const TypeIdentifier* const id = pending.back();
+    pending.pop_back();
+    const EntryMap::iterator it = entries_.find(*id);
+    if (it == entries_.end() || !it->second.users.insert(user).second) {
+      // Types this user already has also have their dependencies.
+      continue;
+    }
+    users_[user].insert(*id);
+    for (TypeIdentifierVec::const_iterator dep = it->second.deps.begin();
+         dep != it->second.deps.end(); ++dep) {
+      pending.push_back(&*dep);
+    }
+  }
+}
+
+void DynamicTypeCache::built(const TypeIdentifier& ti)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const EntryMap::iterator found = entries_.find(ti);
+  if (found == entries_.end() || found->second.built) {
+    return;
+  }
+  Entry& entry = found->second;
+
+  OPENDDS_VECTOR(DDS::DynamicType_var) refs;
+  DDS::TypeDescriptor_var td;
+  if (entry.type->get_descriptor(td) == DDS::RETCODE_OK) {
+    refs.push_back(DDS::DynamicType::_duplicate(td->base_type()));
+    refs.push_back(DDS::DynamicType::_duplicate(td->discriminator_type()));
+    refs.push_back(DDS::DynamicType::_duplicate(td->element_type()));
+    refs.push_back(DDS::DynamicType::_duplicate(td->key_element_type()));
+  }
+  const ACE_CDR::ULong count = entry.type->get_member_count();
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    DDS::DynamicTypeMember_var dtm;
+    DDS::MemberDescriptor_var md;
+    if (entry.type->get_member_by_index(dtm, i) == DDS::RETCODE_OK &&
+        dtm->get_descriptor(md) == DDS::RETCODE_OK) {
+      refs.push_back(DDS::DynamicType::_duplicate(md->type()));
+    }
+  }
+
+  TypeIdentifierSet deps;
+  for (size_t i = 0; i < refs.size(); ++i) {
+    const TypeIdMap::const_iterator dep = type_ids_.find(refs[i].in());
+    if (dep != type_ids_.end() && dep->second != ti) {
+      deps.insert(dep->second);
+    }
+  }
+  entry.deps.assign(deps.begin(), deps.end());
+  entry.bytes = type_bytes(entry.type);
+  entry.built = true;
+  type_bytes_ += entry.bytes;
+
+  const UserSet users = entry.users;
+  for (UserSet::const_iterator user = users.begin(); user != users.end(); ++user) {
+    for (TypeIdentifierSet::const_iterator dep = deps.begin(); dep != deps.end(); ++dep) {
+      add_user_i(*dep, *user);
+    }
+  }
+}
+
+void DynamicTypeCache::remove(const TypeIdentifier& ti)
+{
+  DDS::DynamicType_var type;
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const EntryMap::iterator found = entries_.find(ti);
+  if (found == entries_.end()) {
+    return;
+  }
+  type = found->second.type;
+  for (UserSet::const_iterator user = found->second.users.begin();
+       user != found->second.users.end(); ++user) {
+    const UserMap::iterator u = users_.find(*user);
+    if (u != users_.end()) {
+      u->second.erase(ti);
+      if (u->second.empty()) {
+        users_.erase(u);
+      }
+    }
+  }
+  type_bytes_ -= found->second.bytes;
+  type_ids_.erase(type.in());
+  entries_.erase(found);
+}
+
+DDS::MemberDescriptor* DynamicTypeCache::intern(DDS::MemberDescriptor* md)
+{
+  const DescriptorKey key(md);
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const DescriptorMap::iterator found = descriptors_.find(key);
+  if (found != descriptors_.end()) {
+    ++shared_descriptors_;
+    CORBA::add_ref(found->second.md.in());
+    return found->second.md.in();
+  }
+
+  Interned& interned = descriptors_[key];
+  CORBA::add_ref(md);
+  interned.md = md;
+  interned.bytes = descriptor_bytes(md);
+  descriptor_bytes_ += interned.bytes;
+  CORBA::add_ref(md);
+  return md;
+}
+
+void DynamicTypeCache::release_i(const User& user, DynamicTypeVec& evicted)
+{
+  const UserMap::iterator u = users_.find(user);
+  if (u == users_.end()) {
+    return;
+  }
+  for (TypeIdentifierSet::const_iterator ti = u->second.begin(); ti != u->second.end(); ++ti) {
+    const EntryMap::iterator found = entries_.find(*ti);
+    if (found == entries_.end()) {
+      continue;
+    }
+    found->second.users.erase(user);
+    if (found->second.users.empty()) {
+      evicted.push_back(found->second.type);
+      type_bytes_ -= found->second.bytes;
+      type_ids_.erase(found->second.type.in());
+      entries_.erase(found);
+      ++evictions_;
+    }
+  }
+  users_.erase(u);
+}
+
+void DynamicTypeCache::release(const User& user)
+{
+  DynamicTypeVec evicted;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    release_i(user, evicted);
+  }
+  clear_evicted(evicted);
+}
+
+void DynamicTypeCache::release_owner(unsigned long owner)
+{
+  DynamicTypeVec evicted;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    OPENDDS_VECTOR(User) owned;
+    for (UserMap::const_iterator it = users_.lower_bound(User(owner, DCPS::GUID_UNKNOWN));
+         it != users_.end() && it->first.first == owner; ++it) {
+      owned.push_back(it->first);
+    }
+    for (size_t i = 0; i < owned.size(); ++i) {
+      release_i(owned[i], evicted);
+    }
+  }
+  clear_evicted(evicted);
+}
+
+void DynamicTypeCache::clear_evicted(DynamicTypeVec& evicted)
+{
+  if (evicted.empty()) {
+    return;
+  }
+
+  // Clearing breaks the cycles of recursive types, which releases the member
+  // descriptors they used.
+  for (size_t i = 0; i < evicted.size(); ++i) {
+    DynamicTypeImpl* const impl = dynamic_cast<DynamicTypeImpl*>(evicted[i].in());
+    if (impl) {
+      impl->clear();
+    }
+  }
+  evicted.clear();
+
+  // Releasing a descriptor can release the last reference to a type that
+  // wasn't cached and through it more descriptors, so repeat until there
+  // aren't any unused ones.
+  for (;;) {
+    DescriptorVec unused;
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      for (DescriptorMap::iterator it = descriptors_.begin(); it != descriptors_.end();) {
+        MemberDescriptorImpl* const impl = dynamic_cast<MemberDescriptorImpl*>(it->second.md.in());
+        if (impl && impl->_refcount_value() == 1) {
+          unused.push_back(it->second.md);
+          descriptor_bytes_ -= it->second.bytes;
+          descriptors_.erase(it++);
+        } else {
+          ++it;
+        }
+      }
+    }
+    if (unused.empty()) {
+      break;
+    }
+  }
+
+  if (DCPS::DCPS_debug_level >= 4) {
+    const Stats s = stats();
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) DynamicTypeCache::clear_evicted: "
+      "%B types, %B member descriptors, %B bytes after evictions\n",
+      s.types, s.member_descriptors, s.bytes));
+  }
+}
+
+DynamicTypeCache::Stats DynamicTypeCache::stats() const
+{
+  Stats s;
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  s.types = entries_.size();
+  s.users = users_.size();
+  s.member_descriptors = descriptors_.size();
+  s.bytes = type_bytes_ + descriptor_bytes_;
+  s.hits = hits_;
+  s.misses = misses_;
+  s.evictions = evictions_;
+  s.shared_member_descriptors = shared_descriptors_;
+  return s;
+}
+
+size_t DynamicTypeCache::type_bytes(DDS::DynamicType_ptr type)
+{
+  size_t bytes = sizeof(DynamicTypeImpl) + sizeof(TypeDescriptorImpl);
+  DDS::TypeDescriptor_var td;
+  if (type->get_descriptor(td) == DDS::RETCODE_OK) {
+    bytes += string_bytes(td->name()) + td->bound().length() * sizeof(ACE_CDR::ULong);
+  }
+  // The member descriptors are counted when they're interned.
+  bytes += type->get_member_count() * (sizeof(DynamicTypeMemberImpl) + 3 * map_node_bytes);
+  return bytes;
+}
+
+size_t DynamicTypeCache::descriptor_bytes(DDS::MemberDescriptor* md)
+{
+  return sizeof(MemberDescriptorImpl) + string_bytes(md->name()) +
+    string_bytes(md->default_value()) + md->label().length() * sizeof(ACE_CDR::Long);
+}
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
@@ -0,0 +1,188 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_XTYPES_DYNAMIC_TYPE_CACHE_H
+#define OPENDDS_DCPS_XTYPES_DYNAMIC_TYPE_CACHE_H
+
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include "TypeObject.h"
+
+#  include <dds/DCPS/GuidUtils.h>
+#  include <dds/DCPS/PoolAllocator.h>
+#  include <dds/DCPS/RcObject.h>
+
+#  include <dds/DdsDynamicDataC.h>
+
+#  include <ace/Recursive_Thread_Mutex.h>
+#  include <ace/Thread_Mutex.h>
+
+#  if !defined (ACE_LACKS_PRAGMA_ONCE)
+#    pragma once
+#  endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+/**
+ * Process-wide cache of the DynamicTypes that TypeLookupServices build from
+ * TypeObjects, keyed by TypeIdentifier.  A type that's used by many remote
+ * endpoints is converted once and shared by all of them.
+ *
+ * Each cached type records its users, which are pairs of an owner (one per
+ * TypeLookupService) and the GUID the type was requested for.  A user of a
+ * type is also a user of every cached type it depends on.  When a user is
+ * released, types that no longer have any users are evicted and cleared so
+ * recursive types don't leak.
+ *
+ * Member descriptors are interned so that equal members of different types,
+ * for example the same member in two versions of a type, share one
+ * descriptor.
+ *
+ * TypeLookupServices hold a reference to the cache so that it outlives all
+ * of them even when the process-wide instance is destroyed first.
+ */
+class OpenDDS_Dcps_Export DynamicTypeCache : public virtual DCPS::RcObject {
+public:
+  typedef std::pair<unsigned long, DCPS::GUID_t> User;
+
+  struct Stats {
+    Stats();
+
+    /// Number of cached types
+    size_t types;
+    /// Number of (owner, GUID) pairs that are using cached types
+    size_t users;
+    /// Number of interned member descriptors
+    size_t member_descriptors;
+    /// Approximate bytes held by cached types and interned member descriptors
+    size_t bytes;
+    /// Lookups that found a cached type
+    size_t hits;
+    /// Lookups that had to build a type
+    size_t misses;
+    /// Types evicted because they had no users left
+    size_t evictions;
+    /// Member descriptors that were replaced by an interned one
+    size_t shared_member_descriptors;
+  };
+
+  DynamicTypeCache();
+  ~DynamicTypeCache();
+
+  static DCPS::RcHandle<DynamicTypeCache> instance();
+
+  /// Return a new owner ID to use in Users.
+  unsigned long new_owner();
+
+  /// Held while building types so that a type is only built once and isn't
+  /// used by other threads before it's finished.  It's recursive because
+  /// building a type builds the types it depends on.
+  ACE_Recursive_Thread_Mutex& build_lock() { return build_lock_; }
+
+  /// If ti and every cached type it depends on are finished, add user to
+  /// ti and return it.  Otherwise return nil.  This doesn't need the build
+  /// lock, so threads looking up types that are already cached don't wait
+  /// for other types to be built.
+  DDS::DynamicType_ptr find_built(const TypeIdentifier& ti, const User& user);
+
+  /// If ti is cached, add user to it and return it.  Otherwise cache
+  /// candidate as ti and return nil.  The caller must then build candidate
+  /// and call built(ti) or remove(ti) if that failed.
+  DDS::DynamicType_ptr find_or_insert(const TypeIdentifier& ti, const User& user,
+                                      DDS::DynamicType_ptr candidate);
+
+  /// ti is finished.  Record the cached types it refers to and give them
+  /// the users of ti.
+  void built(const TypeIdentifier& ti);
+
+  /// Remove ti without clearing it.
+  void remove(const TypeIdentifier& ti);
+
+  /// Return a new reference to an interned member descriptor that's equal to
+  /// md, which is interned if there isn't one yet.
+  DDS::MemberDescriptor* intern(DDS::MemberDescriptor* md);
+
+  /// Remove user from every type.  Types without users are evicted.
+  void release(const User& user);
+
+  /// Release every user of owner.
+  void release_owner(unsigned long owner);
+
+  Stats stats() const;
+
+private:
+  typedef OPENDDS_SET(User) UserSet;
+  typedef OPENDDS_VECTOR(TypeIdentifier) TypeIdentifierVec;
+  typedef OPENDDS_VECTOR(DDS::DynamicType_var) DynamicTypeVec;
+
+  struct Entry {
+    Entry();
+
+    DDS::DynamicType_var type;
+    bool built;
+    UserSet users;
+    /// Cached types that type refers to directly
+    TypeIdentifierVec deps;
+    size_t bytes;
+  };
+  typedef OPENDDS_MAP(TypeIdentifier, Entry) EntryMap;
+  typedef OPENDDS_MAP(const DDS::DynamicType*, TypeIdentifier) TypeIdMap;
+  typedef OPENDDS_SET(TypeIdentifier) TypeIdentifierSet;
+  typedef OPENDDS_MAP(User, TypeIdentifierSet) UserMap;
+
+  /// The values of a member descriptor that make it distinct
+  struct DescriptorKey {
+    explicit DescriptorKey(DDS::MemberDescriptor* md);
+    bool operator<(const DescriptorKey& other) const;
+
+    DCPS::String name;
+    DCPS::String default_value;
+    DDS::MemberId id;
+    const DDS::DynamicType* type;
+    ACE_CDR::ULong index;
+    int try_construct_kind;
+    unsigned flags;
+    OPENDDS_VECTOR(ACE_CDR::Long) labels;
+  };
+  struct Interned {
+    DDS::MemberDescriptor_var md;
+    size_t bytes;
+  };
+  typedef OPENDDS_MAP(DescriptorKey, Interned) DescriptorMap;
+
+  void add_user_i(const TypeIdentifier& ti, const User& user);
+  bool complete_i(const TypeIdentifier& ti) const;
+  void release_i(const User& user, DynamicTypeVec& evicted);
+  void clear_evicted(DynamicTypeVec& evicted);
+  static size_t type_bytes(DDS::DynamicType_ptr type);
+  static size_t descriptor_bytes(DDS::MemberDescriptor* md);
+
+  mutable ACE_Thread_Mutex mutex_;
+  ACE_Recursive_Thread_Mutex build_lock_;
+  unsigned long last_owner_;
+  EntryMap entries_;
+  TypeIdMap type_ids_;
+  UserMap users_;
+  DescriptorMap descriptors_;
+  size_t type_bytes_;
+  size_t descriptor_bytes_;
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
+  size_t shared_descriptors_;
+};
+
+typedef DCPS::RcHandle<DynamicTypeCache> DynamicTypeCache_rch;
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
+
+#endif // OPENDDS_DCPS_XTYPES_DYNAMIC_TYPE_CACHE_H
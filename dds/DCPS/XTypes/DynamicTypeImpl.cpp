@@ -4,7 +4,9 @@
 
 #include "DynamicTypeImpl.h"
 
+#include "DynamicDataImpl.h"
 #include "DynamicTypeMemberImpl.h"
+#include "XcdrTranscoder.h"
 
 #include <dds/DCPS/debug.h>
 
@@ -19,6 +21,8 @@ namespace XTypes {
 
 DynamicTypeImpl::DynamicTypeImpl()
   : preset_type_info_set_(false)
+  , flat_data_layout_enabled_(false)
+  , flat_data_layout_compiled_(false)
 {}
 
 DynamicTypeImpl::~DynamicTypeImpl()
@@ -172,6 +176,66 @@ void DynamicTypeImpl::clear()
   member_by_id_.clear();
   member_by_index_.clear();
   descriptor_ = 0;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(transcoder_mutex_);
+    identity_transcoder_.reset();
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(layout_mutex_);
+  flat_data_layout_enabled_ = false;
+  flat_data_layout_compiled_ = false;
+  flat_data_layout_.reset();
+}
+
+DCPS::RcHandle<XcdrTranscoder> DynamicTypeImpl::identity_transcoder()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(transcoder_mutex_);
+  if (!identity_transcoder_) {
+    identity_transcoder_ = DCPS::make_rch<XcdrTranscoder>(this, this);
+  }
+  return identity_transcoder_;
+}
+
+namespace {
+  void enable_flat_data_layout(DDS::DynamicType_ptr type)
+  {
+    const DDS::DynamicType_var base = get_base_type(type);
+    DynamicTypeImpl* const impl = dynamic_cast<DynamicTypeImpl*>(base.in());
+    if (impl) {
+      impl->use_flat_data_layout();
+    }
+  }
+}
+
+void DynamicTypeImpl::use_flat_data_layout()
+{
+  // Returning if already enabled ends the recursion for recursive types.
+  if (flat_data_layout_enabled_.exchange(true)) {
+    return;
+  }
+
+  for (DynamicTypeMembersByIndex::const_iterator it = member_by_index_.begin();
+       it != member_by_index_.end(); ++it) {
+    DDS::MemberDescriptor_var md;
+    if ((*it)->get_descriptor(md) == DDS::RETCODE_OK) {
+      enable_flat_data_layout(md->type());
+    }
+  }
+  if (descriptor_.in()) {
+    enable_flat_data_layout(descriptor_->element_type());
+  }
+}
+
+DCPS::RcHandle<DynamicDataLayout> DynamicTypeImpl::flat_data_layout()
+{
+  if (!flat_data_layout_enabled_) {
+    return DCPS::RcHandle<DynamicDataLayout>();
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(layout_mutex_);
+  if (!flat_data_layout_compiled_) {
+    flat_data_layout_ = DynamicDataLayout::compile(this);
+    flat_data_layout_compiled_ = true;
+  }
+  return flat_data_layout_;
 }
 
 DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type)
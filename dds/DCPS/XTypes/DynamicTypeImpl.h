@@ -6,15 +6,21 @@
 #include "TypeDescriptorImpl.h"
 #include "MemberDescriptorImpl.h"
 
+#include <dds/DCPS/Atomic.h>
 #include <dds/DCPS/RcHandle_T.h>
 #include <dds/DCPS/RcObject.h>
 #include <dds/DdsDynamicDataC.h>
 
+#include <ace/Thread_Mutex.h>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace XTypes {
 
+class XcdrTranscoder;
+class DynamicDataLayout;
+
 // This will eventually be replaced by a map.
 class DynamicTypeMembersByNameImpl : public DDS::DynamicTypeMembersByName  {
 private:
@@ -171,6 +177,18 @@ public:
     return preset_type_info_set_ ? &preset_type_info_ : 0;
   }
 
+  /// Transcoder from this type to itself, compiled on first use.
+  DCPS::RcHandle<XcdrTranscoder> identity_transcoder();
+
+  /// Opt the DynamicDataImpl of this type, and of the types of its members and
+  /// elements, into a flat slot layout. This applies to final and appendable
+  /// structs without union members, the other types keep the default storage.
+  void use_flat_data_layout();
+
+  /// Slot layout for the DynamicDataImpl of this type, compiled on first use,
+  /// or null if the type didn't opt in or can't use one.
+  DCPS::RcHandle<DynamicDataLayout> flat_data_layout();
+
 private:
   DynamicTypeMembersByNameImpl member_by_name_;
   DynamicTypeMembersByIdImpl member_by_id_;
@@ -184,6 +202,14 @@ private:
   TypeMap complete_tm_;
   bool preset_type_info_set_;
   TypeInformation preset_type_info_;
+
+  ACE_Thread_Mutex transcoder_mutex_;
+  DCPS::RcHandle<XcdrTranscoder> identity_transcoder_;
+
+  DCPS::Atomic<bool> flat_data_layout_enabled_;
+  ACE_Thread_Mutex layout_mutex_;
+  bool flat_data_layout_compiled_;
+  DCPS::RcHandle<DynamicDataLayout> flat_data_layout_;
 };
 
 OpenDDS_Dcps_Export DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type);
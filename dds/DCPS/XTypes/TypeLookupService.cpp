@@ -35,25 +35,39 @@ namespace OpenDDS {
 namespace XTypes {
 
 TypeLookupService::TypeLookupService()
+#ifndef OPENDDS_SAFETY_PROFILE
+  : dynamic_type_cache_(DynamicTypeCache::instance())
+  , cache_owner_(dynamic_type_cache_->new_owner())
+#endif
 {
-  to_empty_.minimal.kind = TK_NONE;
-  to_empty_.complete.kind = TK_NONE;
+  init();
+}
 
-  type_info_empty_.minimal.typeid_with_size.type_id = TypeIdentifier(TK_NONE);
-  type_info_empty_.complete.typeid_with_size.type_id = TypeIdentifier(TK_NONE);
+#ifndef OPENDDS_SAFETY_PROFILE
+TypeLookupService::TypeLookupService(const DynamicTypeCache_rch& cache)
+  : dynamic_type_cache_(cache)
+  , cache_owner_(dynamic_type_cache_->new_owner())
+{
+  init();
 }
+#endif
 
 TypeLookupService::~TypeLookupService()
 {
 #ifndef OPENDDS_SAFETY_PROFILE
-  for (GuidTypeMap::const_iterator pos = gt_map_.begin(), limit = gt_map_.end(); pos != limit; ++pos) {
-    for (DynamicTypeMap::const_iterator pos2 = pos->second.begin(), limit2 = pos->second.end(); pos2 != limit2; ++pos2) {
-      pos2->second->clear();
-    }
-  }
+  dynamic_type_cache_->release_owner(cache_owner_);
 #endif
 }
 
+void TypeLookupService::init()
+{
+  to_empty_.minimal.kind = TK_NONE;
+  to_empty_.complete.kind = TK_NONE;
+
+  type_info_empty_.minimal.typeid_with_size.type_id = TypeIdentifier(TK_NONE);
+  type_info_empty_.complete.typeid_with_size.type_id = TypeIdentifier(TK_NONE);
+}
+
 void TypeLookupService::get_type_objects(const TypeIdentifierSeq& type_ids,
                                          TypeIdentifierTypeObjectPairSeq& types) const
 {
@@ -692,6 +706,15 @@ namespace {
 
 }
 
+void TypeLookupService::insert_member(DynamicTypeImpl* dt, DDS::MemberDescriptor* md)
+{
+  const DDS::MemberDescriptor_var interned = dynamic_type_cache_->intern(md);
+  DynamicTypeMemberImpl* dtm = new DynamicTypeMemberImpl();
+  DDS::DynamicTypeMember_var dtm_var = dtm;
+  dtm->set_descriptor(interned);
+  dt->insert_dynamic_member(dtm);
+}
+
 void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
                                               const CompleteTypeObject& cto,
                                               const DCPS::GUID_t& guid)
@@ -740,8 +763,6 @@ void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
     const DDS::DynamicType_var temp = type_identifier_to_dynamic(TypeIdentifier(TK_BOOLEAN), guid);
     td->element_type(temp);
     for (ACE_CDR::ULong i = 0; i < cto.bitmask_type.flag_seq.length(); ++i) {
-      DynamicTypeMemberImpl* dtm = new DynamicTypeMemberImpl();
-      DDS::DynamicTypeMember_var dtm_var = dtm;
       MemberDescriptorImpl* md = new MemberDescriptorImpl();
       DDS::MemberDescriptor_var md_var = md;
       md->name(cto.bitmask_type.flag_seq[i].detail.name.c_str());
@@ -750,8 +771,7 @@ void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
       const DDS::DynamicType_var temp = type_identifier_to_dynamic(TypeIdentifier(TK_BOOLEAN), guid);
       md->type(temp);
       md->index(i);
-      dtm->set_descriptor(md);
-      dt->insert_dynamic_member(dtm);
+      insert_member(dt, md);
     }
     }
     break;
@@ -762,10 +782,7 @@ void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
       DDS::MemberDescriptor_var md = complete_annotation_member_to_member_descriptor(cto.annotation_type.member_seq[i], guid);
       md->index(i);
       md->id(i);
-      DynamicTypeMemberImpl* dtm = new DynamicTypeMemberImpl();
-      DDS::DynamicTypeMember_var dtm_var = dtm;
-      dtm->set_descriptor(md);
-      dt->insert_dynamic_member(dtm);
+      insert_member(dt, md);
     }
     break;
   case TK_STRUCTURE: {
@@ -778,12 +795,9 @@ void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
     td->extensibility_kind(type_flags_to_extensibility(cto.struct_type.struct_flags));
     td->is_nested(cto.struct_type.struct_flags & IS_NESTED);
     for (ACE_CDR::ULong i = 0; i < cto.struct_type.member_seq.length(); ++i) {
-      DynamicTypeMemberImpl* dtm = new DynamicTypeMemberImpl();
-      DDS::DynamicTypeMember_var dtm_var = dtm;
       DDS::MemberDescriptor_var md = complete_struct_member_to_member_descriptor(cto.struct_type.member_seq[i], guid);
       md->index(i);
-      dtm->set_descriptor(md);
-      dt->insert_dynamic_member(dtm);
+      insert_member(dt, md);
     }
     }
     break;
@@ -802,18 +816,12 @@ void TypeLookupService::complete_to_dynamic_i(DynamicTypeImpl* dt,
     disc_md->type(disc_type);
     disc_md->id(DISCRIMINATOR_ID);
     disc_md->index(DISCRIMINATOR_ID);
-    DynamicTypeMemberImpl* disc_dtm = new DynamicTypeMemberImpl();
-    DDS::DynamicTypeMember_var disc_dtm_var = disc_dtm;
-    disc_dtm->set_descriptor(disc_md);
-    dt->insert_dynamic_member(disc_dtm);
+    insert_member(dt, disc_md);
 
     for (ACE_CDR::ULong i = 0; i < cto.union_type.member_seq.length(); ++i) {
       DDS::MemberDescriptor_var md = complete_union_member_to_member_descriptor(cto.union_type.member_seq[i], guid);
       md->index(i);
-      DynamicTypeMemberImpl* dtm = new DynamicTypeMemberImpl();
-      DDS::DynamicTypeMember_var dtm_var = dtm;
-      dtm->set_descriptor(md);
-      dt->insert_dynamic_member(dtm);
+      insert_member(dt, md);
     }
     }
     break;
@@ -872,25 +880,27 @@ DDS::DynamicType_ptr TypeLookupService::type_identifier_to_dynamic(const TypeIde
     }
     return 0;
   }
+  const DynamicTypeCache::User user(cache_owner_, guid);
+  {
+    DDS::DynamicType_var cached = dynamic_type_cache_->find_built(ti, user);
+    if (cached) {
+      return cached._retn();
+    }
+  }
+
+  // Types are built once for all users of the cache.  While a type is being
+  // built it's already in the cache so recursive references to it resolve.
+  ACE_Guard<ACE_Recursive_Thread_Mutex> build_guard(dynamic_type_cache_->build_lock());
   DynamicTypeImpl* dt = new DynamicTypeImpl();
   DDS::DynamicType_var dt_var = dt;
-  DDS::TypeDescriptor_var td = new TypeDescriptorImpl();
   {
-    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-    const GuidTypeMap::iterator guid_found = gt_map_.find(guid);
-    if (guid_found != gt_map_.end()) {
-      const DynamicTypeMap::const_iterator ti_found = guid_found->second.find(ti);
-      if (ti_found != guid_found->second.end()) {
-        return DDS::DynamicType::_duplicate(ti_found->second);
-      } else {
-        guid_found->second.insert(std::make_pair(ti, dt_var));
-      }
-    } else {
-      DynamicTypeMap dt_map;
-      dt_map.insert(std::make_pair(ti, dt_var));
-      gt_map_.insert(std::make_pair(guid, dt_map));
+    DDS::DynamicType_var cached =
+      dynamic_type_cache_->find_or_insert(ti, user, dt);
+    if (cached) {
+      return cached._retn();
     }
   }
+  DDS::TypeDescriptor_var td = new TypeDescriptorImpl();
 
   switch (ti.kind()) {
   case TK_BOOLEAN:
@@ -1085,6 +1095,10 @@ DDS::DynamicType_ptr TypeLookupService::type_identifier_to_dynamic(const TypeIde
       if (to.kind == TK_NONE) {
         ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) TypeLookupService::type_identifier_to_dynamic -")
                    ACE_TEXT(" get_type_object_i returned TK_NONE\n")));
+        // Another TypeLookupService might have the TypeObject, so don't share
+        // the empty type with it.
+        dynamic_type_cache_->remove(ti);
+        return dt_var._retn();
       } else {
         complete_to_dynamic_i(dt, to.complete, guid);
       }
@@ -1103,6 +1117,7 @@ DDS::DynamicType_ptr TypeLookupService::type_identifier_to_dynamic(const TypeIde
     break;
   }
 
+  dynamic_type_cache_->built(ti);
   return dt_var._retn();
 }
 #endif // OPENDDS_SAFETY_PROFILE
@@ -1171,17 +1186,10 @@ bool TypeLookupService::extensibility(TypeFlag extensibility_mask, const TypeIde
 #ifndef OPENDDS_SAFETY_PROFILE
 void TypeLookupService::remove_guid_from_dynamic_map(const DCPS::GUID_t& guid)
 {
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  const GuidTypeMap::iterator g_found = gt_map_.find(guid);
-  if (g_found != gt_map_.end()) {
-    for (DynamicTypeMap::const_iterator pos2 = g_found->second.begin(), limit2 = g_found->second.end(); pos2 != limit2; ++pos2) {
-      pos2->second->clear();
-    }
-    gt_map_.erase(g_found);
-    if (DCPS::DCPS_debug_level >= 4) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) TypeLookupService::remove_guid_from_dynamic_map: ",
-        "Alerted to removal of %C, removing GUID from GuidTypeMap.\n", DCPS::to_string(guid).c_str()));
-    }
+  dynamic_type_cache_->release(DynamicTypeCache::User(cache_owner_, guid));
+  if (DCPS::DCPS_debug_level >= 4) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) TypeLookupService::remove_guid_from_dynamic_map: "
+      "Alerted to removal of %C, releasing its DynamicTypes.\n", DCPS::to_string(guid).c_str()));
   }
 }
 
@@ -11,6 +11,7 @@
 #include "MemberDescriptorImpl.h"
 #include "TypeDescriptorImpl.h"
 #include "DynamicTypeImpl.h"
+#include "DynamicTypeCache.h"
 
 #include <dds/DCPS/RcObject.h>
 #include <dds/DCPS/GuidUtils.h>
@@ -29,6 +30,10 @@ namespace XTypes {
 class OpenDDS_Dcps_Export TypeLookupService : public virtual DCPS::RcObject {
 public:
   TypeLookupService();
+#ifndef OPENDDS_SAFETY_PROFILE
+  /// Use cache instead of DynamicTypeCache::instance()
+  explicit TypeLookupService(const DynamicTypeCache_rch& cache);
+#endif
   ~TypeLookupService();
 
   /// For TypeAssignability
@@ -47,13 +52,13 @@ public:
   ///@}
 
 #ifndef OPENDDS_SAFETY_PROFILE
-  typedef OPENDDS_MAP(TypeIdentifier, DDS::DynamicType_var) DynamicTypeMap;
-  typedef OPENDDS_MAP(DCPS::GUID_t, DynamicTypeMap) GuidTypeMap;
   DDS::DynamicType_ptr complete_to_dynamic(const CompleteTypeObject& cto, const DCPS::GUID_t& guid);
   void remove_guid_from_dynamic_map(const DCPS::GUID_t& guid);
 
   bool has_complete(const TypeIdentifier& ti) const;
   DDS::DynamicType_ptr type_identifier_to_dynamic(const TypeIdentifier& ti, const DCPS::GUID_t& guid);
+
+  const DynamicTypeCache_rch& dynamic_type_cache() const { return dynamic_type_cache_; }
 #endif // OPENDDS_SAFETY_PROFILE
 
   /// For TypeLookup_getTypeDependencies
@@ -76,6 +81,7 @@ public:
   const TypeInformation& get_type_info(const DDS::BuiltinTopicKey_t& key) const;
 
 private:
+  void init();
   const TypeObject& get_type_object_i(const TypeIdentifier& type_id) const;
   void get_type_dependencies_i(const TypeIdentifierSeq& type_ids,
     TypeIdentifierWithSizeSeq& dependencies) const;
@@ -116,7 +122,12 @@ private:
   DDS::MemberDescriptor* complete_union_member_to_member_descriptor(const CompleteUnionMember& cm, const DCPS::GUID_t& guid);
   DDS::MemberDescriptor* complete_annotation_member_to_member_descriptor(const CompleteAnnotationParameter& cm, const DCPS::GUID_t& guid);
   void complete_to_dynamic_i(DynamicTypeImpl* dt, const CompleteTypeObject& cto, const DCPS::GUID_t& guid);
-  GuidTypeMap gt_map_;
+  void insert_member(DynamicTypeImpl* dt, DDS::MemberDescriptor* md);
+
+  /// DynamicTypes are shared with other TypeLookupServices through the
+  /// cache.  Each GUID of this service is a separate user of the types.
+  const DynamicTypeCache_rch dynamic_type_cache_;
+  const unsigned long cache_owner_;
 #endif
   /// Map from BuiltinTopicKey_t of remote endpoint to its TypeInformation.
   typedef OPENDDS_MAP_CMP(DDS::BuiltinTopicKey_t, TypeInformation,
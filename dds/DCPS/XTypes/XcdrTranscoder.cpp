@@ -0,0 +1,1305 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h>
+
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include "XcdrTranscoder.h"
+
+#  include "DynamicTypeImpl.h"
+#  include "Utils.h"
+
+#  include <dds/DCPS/Atomic.h>
+#  include <dds/DCPS/debug.h>
+
+#  include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+using DCPS::Encoding;
+using DCPS::LogLevel;
+using DCPS::log_level;
+using DCPS::Sample;
+using DCPS::Serializer;
+
+namespace {
+  DCPS::Atomic<size_t> next_transcoder_id(0);
+
+  bool is_primitive_like(DDS::TypeKind kind)
+  {
+    return is_primitive(kind) || kind == TK_ENUM || kind == TK_BITMASK;
+  }
+
+  bool is_integral(DDS::TypeKind kind)
+  {
+    return is_primitive(kind) && kind != TK_FLOAT32 && kind != TK_FLOAT64 && kind != TK_FLOAT128;
+  }
+
+  /// Number of bytes a primitive takes on the wire.
+  size_t wire_size(DDS::TypeKind kind)
+  {
+    switch (kind) {
+    case TK_BOOLEAN:
+    case TK_BYTE:
+    case TK_INT8:
+    case TK_UINT8:
+    case TK_CHAR8:
+      return 1;
+    case TK_INT16:
+    case TK_UINT16:
+    case TK_CHAR16:
+      return 2;
+    case TK_INT32:
+    case TK_UINT32:
+    case TK_FLOAT32:
+      return 4;
+    case TK_INT64:
+    case TK_UINT64:
+    case TK_FLOAT64:
+      return 8;
+    case TK_FLOAT128:
+      return 16;
+    }
+    return 0;
+  }
+
+  /// Number of bytes a primitive takes in memory when it's read as a block.
+  size_t memory_size(size_t width)
+  {
+    return width == DCPS::float128_cdr_size ? sizeof(ACE_CDR::LongDouble) : width;
+  }
+
+  /// Kind that enums and bitmasks are serialized as.
+  bool wire_kind(DDS::DynamicType_ptr type, DDS::TypeKind& kind)
+  {
+    kind = type->get_kind();
+    if (kind == TK_ENUM) {
+      return enum_bound(type, kind) == DDS::RETCODE_OK;
+    }
+    if (kind == TK_BITMASK) {
+      return bitmask_bound(type, kind) == DDS::RETCODE_OK;
+    }
+    return true;
+  }
+
+  bool enum_default(DDS::DynamicType_ptr enum_type, ACE_CDR::Long& value)
+  {
+    // Default enum value is the first enumerator.
+    DDS::DynamicTypeMember_var first_dtm;
+    if (enum_type->get_member_by_index(first_dtm, 0) != DDS::RETCODE_OK) {
+      return false;
+    }
+    DDS::MemberDescriptor_var first_md;
+    if (first_dtm->get_descriptor(first_md) != DDS::RETCODE_OK) {
+      return false;
+    }
+    value = static_cast<ACE_CDR::Long>(first_md->id());
+    return true;
+  }
+
+  typedef OPENDDS_VECTOR(DDS::MemberDescriptor_var) MemberDescriptors;
+
+  bool get_members(DDS::DynamicType_ptr type, MemberDescriptors& mds)
+  {
+    if (!type) {
+      return true;
+    }
+    const ACE_CDR::ULong count = type->get_member_count();
+    mds.reserve(count);
+    for (ACE_CDR::ULong i = 0; i < count; ++i) {
+      DDS::DynamicTypeMember_var dtm;
+      if (type->get_member_by_index(dtm, i) != DDS::RETCODE_OK) {
+        return false;
+      }
+      if (dtm->get_id() == DISCRIMINATOR_ID) {
+        continue;
+      }
+      DDS::MemberDescriptor_var md;
+      if (dtm->get_descriptor(md) != DDS::RETCODE_OK) {
+        return false;
+      }
+      mds.push_back(md);
+    }
+    return true;
+  }
+}
+
+XcdrTranscoder::Member::Member()
+  : id(0)
+  , in_from(false)
+  , in_to(false)
+  , key(false)
+  , optional(false)
+  , must_understand(false)
+  , node(0)
+  , from_default(false)
+  , to_default(false)
+{}
+
+XcdrTranscoder::Node::Node()
+  : kind(NODE_INVALID)
+  , in_from(false)
+  , in_to(false)
+  , from_wire(TK_NONE)
+  , to_wire(TK_NONE)
+  , default_value(0)
+  , extensibility(DDS::FINAL)
+  , explicit_keys(false)
+  , delimited(false)
+  , array_size(0)
+  , element(0)
+  , discriminator(0)
+  , disc_must_understand(false)
+{}
+
+XcdrTranscoder::XcdrTranscoder(DDS::DynamicType_ptr from_type, DDS::DynamicType_ptr to_type)
+  : root_(0)
+  , valid_(from_type && to_type)
+  , id_(++next_transcoder_id)
+{
+  if (valid_) {
+    root_ = build(from_type, to_type);
+  }
+  // Only needed to find nodes that were already built.
+  node_map_.clear();
+}
+
+size_t XcdrTranscoder::build(DDS::DynamicType_ptr from, DDS::DynamicType_ptr to)
+{
+  const DDS::DynamicType_var from_base = from ? get_base_type(from) : DDS::DynamicType_var();
+  const DDS::DynamicType_var to_base = to ? get_base_type(to) : DDS::DynamicType_var();
+  const TypePair key(from_base.in(), to_base.in());
+  const OPENDDS_MAP(TypePair, size_t)::const_iterator it = node_map_.find(key);
+  if (it != node_map_.end()) {
+    return it->second;
+  }
+
+  // Add the node before describing it so recursive types can refer to it.
+  const size_t index = nodes_.size();
+  nodes_.push_back(Node());
+  node_map_[key] = index;
+
+  Node node;
+  if (!describe(node, from_base, to_base)) {
+    node.kind = NODE_INVALID;
+    valid_ = false;
+  }
+  nodes_[index] = node;
+  return index;
+}
+
+bool XcdrTranscoder::describe(Node& node, DDS::DynamicType_ptr from, DDS::DynamicType_ptr to)
+{
+  node.in_from = from != 0;
+  node.in_to = to != 0;
+  DDS::DynamicType_ptr const type = to ? to : from;
+  const DDS::TypeKind tk = type->get_kind();
+  if (from && to && from->get_kind() != tk
+      && !(is_primitive_like(from->get_kind()) && is_primitive_like(tk))) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe: "
+                 "Can't transcode %C to %C\n",
+                 typekind_to_string(from->get_kind()), typekind_to_string(tk)));
+    }
+    return false;
+  }
+
+  DDS::TypeDescriptor_var from_td;
+  DDS::TypeDescriptor_var to_td;
+  if ((from && from->get_descriptor(from_td) != DDS::RETCODE_OK) ||
+      (to && to->get_descriptor(to_td) != DDS::RETCODE_OK)) {
+    return false;
+  }
+  const DDS::TypeDescriptor_var& td = to ? to_td : from_td;
+
+  switch (tk) {
+  case TK_STRING8:
+    node.kind = NODE_STRING;
+    return true;
+  case TK_STRING16:
+    node.kind = NODE_WSTRING;
+    return true;
+
+  case TK_STRUCTURE:
+  case TK_UNION:
+    node.kind = tk == TK_STRUCTURE ? NODE_STRUCTURE : NODE_UNION;
+    node.extensibility = td->extensibility_kind();
+    if (from && to && from_td->extensibility_kind() != node.extensibility) {
+      if (log_level >= LogLevel::Notice) {
+        const CORBA::String_var name = type->get_name();
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe: "
+                   "Versions of %C have different extensibility\n", name.in()));
+      }
+      return false;
+    }
+    node.explicit_keys = has_explicit_keys(type);
+    if (tk == TK_UNION) {
+      node.discriminator = build(from ? from_td->discriminator_type() : 0,
+                                 to ? to_td->discriminator_type() : 0);
+      if (nodes_[node.discriminator].kind != NODE_PRIMITIVE) {
+        return false;
+      }
+      DDS::DynamicTypeMember_var dtm;
+      DDS::MemberDescriptor_var md;
+      if (type->get_member(dtm, DISCRIMINATOR_ID) != DDS::RETCODE_OK ||
+          dtm->get_descriptor(md) != DDS::RETCODE_OK) {
+        return false;
+      }
+      node.disc_must_understand = md->is_must_understand() || md->is_key();
+    }
+    return describe_members(node, from, to);
+
+  case TK_SEQUENCE:
+  case TK_ARRAY: {
+    node.kind = tk == TK_SEQUENCE ? NODE_SEQUENCE : NODE_ARRAY;
+    const DDS::DynamicType_var elem_type = get_base_type(td->element_type());
+    node.delimited = !is_primitive(elem_type->get_kind());
+    if (tk == TK_ARRAY) {
+      node.array_size = bound_total(td);
+      if (from && to && bound_total(from_td) != node.array_size) {
+        if (log_level >= LogLevel::Notice) {
+          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe: "
+                     "Arrays have different sizes\n"));
+        }
+        return false;
+      }
+    }
+    node.element = build(from ? from_td->element_type() : 0, to ? to_td->element_type() : 0);
+    return true;
+  }
+
+  default:
+    if (!is_primitive_like(tk)) {
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe: "
+                   "Unsupported type kind %C\n", typekind_to_string(tk)));
+      }
+      return false;
+    }
+    node.kind = NODE_PRIMITIVE;
+    if ((from && !wire_kind(from, node.from_wire)) || (to && !wire_kind(to, node.to_wire))) {
+      return false;
+    }
+    if (from && to && node.from_wire != node.to_wire &&
+        !(is_integral(node.from_wire) && is_integral(node.to_wire))) {
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe: "
+                   "Can't transcode %C to %C\n",
+                   typekind_to_string(node.from_wire), typekind_to_string(node.to_wire)));
+      }
+      return false;
+    }
+    return !to || tk != TK_ENUM || enum_default(to, node.default_value);
+  }
+}
+
+bool XcdrTranscoder::describe_members(Node& node, DDS::DynamicType_ptr from, DDS::DynamicType_ptr to)
+{
+  MemberDescriptors from_mds;
+  MemberDescriptors to_mds;
+  if (!get_members(from, from_mds) || !get_members(to, to_mds)) {
+    return false;
+  }
+
+  // Pairs of from and to members in the order they are processed.  Members
+  // of mutable types and union branches are paired by ID.  Members of final
+  // and appendable structures are serialized in order, so they are paired
+  // by position and a mismatch is read as one member and written as another.
+  typedef std::pair<DDS::MemberDescriptor_var, DDS::MemberDescriptor_var> MemberPair;
+  OPENDDS_VECTOR(MemberPair) pairs;
+  if (node.kind == NODE_STRUCTURE && node.extensibility != DDS::MUTABLE) {
+    const size_t count = (std::max)(from_mds.size(), to_mds.size());
+    for (size_t i = 0; i < count; ++i) {
+      const DDS::MemberDescriptor_var fm = i < from_mds.size() ? from_mds[i] : DDS::MemberDescriptor_var();
+      const DDS::MemberDescriptor_var tm = i < to_mds.size() ? to_mds[i] : DDS::MemberDescriptor_var();
+      if (fm && tm && fm->id() != tm->id()) {
+        pairs.push_back(MemberPair(fm, DDS::MemberDescriptor_var()));
+        pairs.push_back(MemberPair(DDS::MemberDescriptor_var(), tm));
+      } else {
+        pairs.push_back(MemberPair(fm, tm));
+      }
+    }
+  } else {
+    OPENDDS_VECTOR(bool) from_paired(from_mds.size(), false);
+    for (size_t t = 0; t < to_mds.size(); ++t) {
+      DDS::MemberDescriptor_var fm;
+      for (size_t f = 0; f < from_mds.size(); ++f) {
+        if (from_mds[f]->id() == to_mds[t]->id()) {
+          fm = from_mds[f];
+          from_paired[f] = true;
+          break;
+        }
+      }
+      pairs.push_back(MemberPair(fm, to_mds[t]));
+    }
+    for (size_t f = 0; f < from_mds.size(); ++f) {
+      if (!from_paired[f]) {
+        pairs.push_back(MemberPair(from_mds[f], DDS::MemberDescriptor_var()));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    const DDS::MemberDescriptor_var& fm = pairs[i].first;
+    const DDS::MemberDescriptor_var& tm = pairs[i].second;
+    const DDS::MemberDescriptor_var& md = tm ? tm : fm;
+    if (fm && tm && fm->is_optional() != tm->is_optional()) {
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::describe_members: "
+                   "Member %u is optional in only one of the types\n", md->id()));
+      }
+      return false;
+    }
+
+    Member member;
+    member.id = md->id();
+    member.in_from = fm.in() != 0;
+    member.in_to = tm.in() != 0;
+    member.key = md->is_key();
+    member.optional = md->is_optional();
+    member.must_understand = md->is_must_understand() || md->is_key();
+    if (fm) {
+      member.from_labels = fm->label();
+      member.from_default = fm->is_default_label();
+    }
+    if (tm) {
+      member.to_labels = tm->label();
+      member.to_default = tm->is_default_label();
+    }
+    member.node = build(fm ? fm->type() : 0, tm ? tm->type() : 0);
+    if (member.in_from) {
+      node.member_index[member.id] = node.members.size();
+    }
+    node.members.push_back(member);
+  }
+  return true;
+}
+
+/// State of one pass over a sample.  The size pass reads the sample and
+/// records the sizes of delimited types and mutable members in the order
+/// they are written.  The write pass reads the sample again and writes the
+/// headers from those sizes.
+class XcdrTranscoder::Pass {
+public:
+  Pass(const XcdrTranscoder& plan, const Encoding& encoding)
+    : plan_(plan)
+    , in_(0)
+    , out_(0)
+    , encoding_(encoding)
+    , in_xcdr2_(false)
+    , out_xcdr2_(encoding.xcdr_version() == Encoding::XCDR_VERSION_2)
+    , size_(0)
+    , running_size_(0)
+    , cache_pos_(0)
+  {}
+
+  /// Use sizes computed earlier instead of calling compute_sizes.
+  void swap_sizes(OPENDDS_VECTOR(size_t)& sizes)
+  {
+    size_cache_.swap(sizes);
+  }
+
+  /// offset is where the output starts, which only matters for the total
+  /// size.  The sizes in headers don't depend on it because XCDR2 headers
+  /// are aligned to the maximum alignment and XCDR1 parameter IDs reset it.
+  bool compute_sizes(Serializer& in, Sample::Extent ext, size_t offset = 0)
+  {
+    start(in, 0);
+    size_ = offset;
+    running_size_ = 0;
+    size_cache_.clear();
+    return value(plan_.nodes_[plan_.root_], ext, true, true);
+  }
+
+  bool write(Serializer& in, Serializer& out, Sample::Extent ext)
+  {
+    start(in, &out);
+    cache_pos_ = 0;
+    return value(plan_.nodes_[plan_.root_], ext, true, true) && cache_pos_ == size_cache_.size();
+  }
+
+  size_t total_size() const { return running_size_ + size_; }
+
+private:
+  /// Where a delimited type or a mutable member started in the size pass
+  /// and where its size goes in the size cache.
+  struct Header {
+    Header() : cache_index(0), start(0) {}
+    size_t cache_index;
+    size_t start;
+  };
+
+  /// Copy this many bytes of primitives at a time.
+  static const size_t block_size = 4096;
+
+  /// Members of mutable types that fit in the stack buffer for tracking
+  /// which members were present.
+  static const size_t seen_buffer_size = 64;
+
+  void start(Serializer& in, Serializer* out)
+  {
+    in_ = &in;
+    out_ = out;
+    in_xcdr2_ = in.encoding().xcdr_version() == Encoding::XCDR_VERSION_2;
+  }
+
+  size_t position() const { return running_size_ + size_; }
+
+  bool value(const Node& node, Sample::Extent ext, bool read, bool write);
+  bool primitives(const Node& node, size_t count, bool read, bool write);
+  bool string_value(const Node& node, bool read, bool write);
+  bool struct_value(const Node& node, Sample::Extent ext, bool read, bool write);
+  bool mutable_members(const Node& node, Sample::Extent ext, bool read, bool write,
+                       bool has_end, size_t end);
+  bool union_value(const Node& node, Sample::Extent ext, bool read, bool write);
+  bool collection_value(const Node& node, Sample::Extent ext, bool read, bool write);
+
+  static const Member* select_branch(const Node& node, ACE_CDR::Long disc, bool from);
+
+  // Input
+  bool read_end(size_t& end);
+  bool read_member_header(bool is_mutable, size_t& member_end);
+  bool finish_member(bool is_mutable, size_t member_end);
+  bool skip_to(size_t end);
+  bool skip_primitives(size_t width, size_t count);
+  bool read_int(DDS::TypeKind kind, ACE_CDR::LongLong& value);
+  bool read_block(size_t width, char* data, ACE_CDR::ULong count);
+
+  // Output
+  bool begin_delimited(Header& header);
+  bool end_delimited(const Header& header);
+  bool begin_member(Header& header, DDS::MemberId id, bool must_understand);
+  bool end_member(const Header& header, DDS::MemberId id);
+  bool end_member_list();
+  bool next_size(size_t& size);
+  void add_primitives(size_t width, size_t count);
+  bool write_int(DDS::TypeKind kind, ACE_CDR::LongLong value);
+  bool write_block(size_t width, const char* data, ACE_CDR::ULong count);
+  bool write_zeros(size_t width, size_t count);
+  bool copy_primitives(size_t width, size_t count);
+  char* block(size_t bytes);
+
+  const XcdrTranscoder& plan_;
+  Serializer* in_;
+  Serializer* out_; ///< Null in the size pass
+  const Encoding encoding_;
+  bool in_xcdr2_;
+  const bool out_xcdr2_;
+
+  /// Size pass: output position since the last alignment reset and the
+  /// total size before that reset, like the size and running size of
+  /// serialized_size_parameter_id.
+  size_t size_;
+  size_t running_size_;
+
+  /// Sizes needed by DHEADERs, EMHEADERs, and XCDR1 parameter IDs.
+  OPENDDS_VECTOR(size_t) size_cache_;
+  size_t cache_pos_;
+
+  /// Aligned storage for copying blocks of primitives.
+  OPENDDS_VECTOR(ACE_CDR::ULongLong) buffer_;
+};
+
+bool XcdrTranscoder::Pass::value(const Node& node, Sample::Extent ext, bool read, bool write)
+{
+  switch (node.kind) {
+  case NODE_PRIMITIVE:
+    return primitives(node, 1, read, write);
+  case NODE_STRING:
+  case NODE_WSTRING:
+    return string_value(node, read, write);
+  case NODE_STRUCTURE:
+    return struct_value(node, ext, read, write);
+  case NODE_UNION:
+    return union_value(node, ext, read, write);
+  case NODE_SEQUENCE:
+  case NODE_ARRAY:
+    return collection_value(node, ext, read, write);
+  default:
+    return false;
+  }
+}
+
+bool XcdrTranscoder::Pass::primitives(const Node& node, size_t count, bool read, bool write)
+{
+  if (read && write && node.from_wire != node.to_wire) {
+    // Integers of different sizes, for example enums with different bit bounds.
+    for (size_t i = 0; i < count; ++i) {
+      ACE_CDR::LongLong value = 0;
+      if (!read_int(node.from_wire, value) || !write_int(node.to_wire, value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (read) {
+    const size_t width = wire_size(node.from_wire);
+    return write ? copy_primitives(width, count) : skip_primitives(width, count);
+  }
+
+  if (write) {
+    if (node.default_value) {
+      for (size_t i = 0; i < count; ++i) {
+        if (!write_int(node.to_wire, node.default_value)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    return write_zeros(wire_size(node.to_wire), count);
+  }
+  return true;
+}
+
+bool XcdrTranscoder::Pass::string_value(const Node& node, bool read, bool write)
+{
+  const bool wide = node.kind == NODE_WSTRING;
+
+  // The length is in bytes and narrow strings include the null terminator,
+  // so the default empty string is 1 for narrow strings and 0 for wide ones.
+  ACE_CDR::ULong length = wide ? 0 : 1;
+  if (read && !(*in_ >> length)) {
+    return false;
+  }
+  if (write && !write_int(TK_UINT32, length)) {
+    return false;
+  }
+
+  const size_t width = wide ? DCPS::char16_cdr_size : DCPS::char8_cdr_size;
+  const size_t count = length / width;
+  if (read) {
+    return write ? copy_primitives(width, count) : skip_primitives(width, count);
+  }
+  return !write || write_zeros(width, count);
+}
+
+bool XcdrTranscoder::Pass::struct_value(const Node& node, Sample::Extent ext, bool read, bool write)
+{
+  const bool delimited = node.extensibility != DDS::FINAL;
+  size_t end = 0;
+  const bool has_end = read && delimited && in_xcdr2_;
+  if (has_end && !read_end(end)) {
+    return false;
+  }
+  Header header;
+  if (write && delimited && !begin_delimited(header)) {
+    return false;
+  }
+
+  if (node.extensibility == DDS::MUTABLE) {
+    if (!mutable_members(node, ext, read, write, has_end, end)) {
+      return false;
+    }
+  } else {
+    const Sample::Extent nested_ext = nested(ext);
+    for (MemberVec::const_iterator it = node.members.begin(); it != node.members.end(); ++it) {
+      const bool r = read && it->in_from;
+      const bool w = write && it->in_to;
+      if ((!r && !w) || exclude_member(ext, it->key, node.explicit_keys)) {
+        continue;
+      }
+      if (it->optional) {
+        ACE_CDR::Boolean present = false;
+        if (r && !(*in_ >> ACE_InputCDR::to_boolean(present))) {
+          return false;
+        }
+        if (w && !write_int(TK_BOOLEAN, present ? 1 : 0)) {
+          return false;
+        }
+        if (!present) {
+          continue;
+        }
+      }
+      if (!value(plan_.nodes_[it->node], nested_ext, r, w)) {
+        return false;
+      }
+    }
+  }
+
+  // Anything left was appended to the type by a version we don't know.
+  if (has_end && !skip_to(end)) {
+    return false;
+  }
+  return !(write && delimited) || end_delimited(header);
+}
+
+bool XcdrTranscoder::Pass::mutable_members(const Node& node, Sample::Extent ext, bool read,
+                                           bool write, bool has_end, size_t end)
+{
+  const Sample::Extent nested_ext = nested(ext);
+  const size_t count = node.members.size();
+  char seen_buffer[seen_buffer_size];
+  OPENDDS_VECTOR(char) seen_vector;
+  char* seen = seen_buffer;
+  if (count > seen_buffer_size) {
+    seen_vector.resize(count);
+    seen = &seen_vector[0];
+  }
+  std::fill(seen, seen + count, 0);
+
+  while (read) {
+    if (has_end && in_->rpos() >= end) {
+      break;
+    }
+    unsigned id;
+    size_t size;
+    bool must_understand;
+    if (!in_->read_parameter_id(id, size, must_understand)) {
+      return false;
+    }
+    if (!has_end && id == Serializer::pid_list_end) {
+      break;
+    }
+    const size_t member_end = in_->rpos() + size;
+
+    const OPENDDS_MAP(DDS::MemberId, size_t)::const_iterator it = node.member_index.find(id);
+    if (it != node.member_index.end()) {
+      const Member& member = node.members[it->second];
+      if (!exclude_member(ext, member.key, node.explicit_keys)) {
+        const bool w = write && member.in_to;
+        Header header;
+        if ((w && !begin_member(header, member.id, member.must_understand)) ||
+            !value(plan_.nodes_[member.node], nested_ext, true, w) ||
+            (w && !end_member(header, member.id))) {
+          return false;
+        }
+        seen[it->second] = 1;
+      }
+    }
+    // Skips members the destination doesn't have and any data appended to
+    // members by a version of their type we don't know.
+    if (!skip_to(member_end)) {
+      return false;
+    }
+  }
+
+  if (!write) {
+    return true;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const Member& member = node.members[i];
+    if (seen[i] || !member.in_to || member.optional ||
+        exclude_member(ext, member.key, node.explicit_keys)) {
+      continue;
+    }
+    Header header;
+    if (!begin_member(header, member.id, member.must_understand) ||
+        !value(plan_.nodes_[member.node], nested_ext, false, true) ||
+        !end_member(header, member.id)) {
+      return false;
+    }
+  }
+  return end_member_list();
+}
+
+const XcdrTranscoder::Member* XcdrTranscoder::Pass::select_branch(
+  const Node& node, ACE_CDR::Long disc, bool from)
+{
+  const Member* default_branch = 0;
+  for (MemberVec::const_iterator it = node.members.begin(); it != node.members.end(); ++it) {
+    if (!(from ? it->in_from : it->in_to)) {
+      continue;
+    }
+    const DDS::UnionCaseLabelSeq& labels = from ? it->from_labels : it->to_labels;
+    for (ACE_CDR::ULong i = 0; i < labels.length(); ++i) {
+      if (labels[i] == disc) {
+        return &*it;
+      }
+    }
+    if (from ? it->from_default : it->to_default) {
+      default_branch = &*it;
+    }
+  }
+  return default_branch;
+}
+
+bool XcdrTranscoder::Pass::union_value(const Node& node, Sample::Extent ext, bool read, bool write)
+{
+  const bool delimited = node.extensibility != DDS::FINAL;
+  const bool is_mutable = node.extensibility == DDS::MUTABLE;
+  size_t end = 0;
+  const bool has_end = read && delimited && in_xcdr2_;
+  if (has_end && !read_end(end)) {
+    return false;
+  }
+  Header header;
+  if (write && delimited && !begin_delimited(header)) {
+    return false;
+  }
+
+  if (ext != Sample::KeyOnly || node.explicit_keys) {
+    const Node& disc_node = plan_.nodes_[node.discriminator];
+    ACE_CDR::LongLong disc = disc_node.default_value;
+    size_t member_end = 0;
+    Header member_header;
+    if ((read && !read_member_header(is_mutable, member_end)) ||
+        (write && is_mutable &&
+         !begin_member(member_header, DISCRIMINATOR_SERIALIZED_ID, node.disc_must_understand)) ||
+        (read && !read_int(disc_node.from_wire, disc)) ||
+        (write && !write_int(disc_node.to_wire, disc)) ||
+        (write && is_mutable && !end_member(member_header, DISCRIMINATOR_SERIALIZED_ID)) ||
+        (read && !finish_member(is_mutable, member_end))) {
+      return false;
+    }
+
+    if (ext == Sample::Full) {
+      const ACE_CDR::Long label = static_cast<ACE_CDR::Long>(disc);
+      const Member* const from_branch = read ? select_branch(node, label, true) : 0;
+      const Member* const to_branch = write ? select_branch(node, label, false) : 0;
+      if (from_branch && to_branch && from_branch != to_branch) {
+        if (log_level >= LogLevel::Notice) {
+          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::Pass::union_value: "
+                     "Discriminator %d selects branch %u in the source type and %u in the "
+                     "destination type\n", label, from_branch->id, to_branch->id));
+        }
+        return false;
+      }
+      const Member* const branch = from_branch ? from_branch : to_branch;
+      const bool r = from_branch != 0;
+      const bool w = to_branch != 0;
+      if (branch &&
+          ((r && !read_member_header(is_mutable, member_end)) ||
+           (w && is_mutable && !begin_member(member_header, branch->id, branch->must_understand)) ||
+           !value(plan_.nodes_[branch->node], nested(ext), r, w) ||
+           (w && is_mutable && !end_member(member_header, branch->id)) ||
+           (r && !finish_member(is_mutable, member_end)))) {
+        return false;
+      }
+    }
+  }
+
+  if (has_end && !skip_to(end)) {
+    return false;
+  }
+  return !(write && delimited) || end_delimited(header);
+}
+
+bool XcdrTranscoder::Pass::collection_value(const Node& node, Sample::Extent ext, bool read, bool write)
+{
+  size_t end = 0;
+  const bool has_end = read && node.delimited && in_xcdr2_;
+  if (has_end && !read_end(end)) {
+    return false;
+  }
+  Header header;
+  if (write && node.delimited && !begin_delimited(header)) {
+    return false;
+  }
+
+  ACE_CDR::ULong count = node.array_size;
+  if (node.kind == NODE_SEQUENCE) {
+    count = 0;
+    if ((read && !(*in_ >> count)) || (write && !write_int(TK_UINT32, count))) {
+      return false;
+    }
+  }
+
+  const Node& element = plan_.nodes_[node.element];
+  if (element.kind == NODE_PRIMITIVE) {
+    if (!primitives(element, count, read, write)) {
+      return false;
+    }
+  } else {
+    const Sample::Extent nested_ext = nested(ext);
+    for (ACE_CDR::ULong i = 0; i < count; ++i) {
+      if (!value(element, nested_ext, read, write)) {
+        return false;
+      }
+    }
+  }
+
+  if (has_end && !skip_to(end)) {
+    return false;
+  }
+  return !(write && node.delimited) || end_delimited(header);
+}
+
+bool XcdrTranscoder::Pass::read_end(size_t& end)
+{
+  size_t size = 0;
+  if (!in_->read_delimiter(size)) {
+    return false;
+  }
+  end = in_->rpos() + size;
+  return true;
+}
+
+bool XcdrTranscoder::Pass::read_member_header(bool is_mutable, size_t& member_end)
+{
+  if (!is_mutable) {
+    return true;
+  }
+  unsigned id;
+  size_t size;
+  bool must_understand;
+  if (!in_->read_parameter_id(id, size, must_understand)) {
+    return false;
+  }
+  member_end = in_->rpos() + size;
+  return true;
+}
+
+bool XcdrTranscoder::Pass::finish_member(bool is_mutable, size_t member_end)
+{
+  return !is_mutable || skip_to(member_end);
+}
+
+bool XcdrTranscoder::Pass::skip_to(size_t end)
+{
+  const size_t pos = in_->rpos();
+  if (pos > end) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: XcdrTranscoder::Pass::skip_to: "
+                 "Read past the end of a delimited type or member\n"));
+    }
+    return false;
+  }
+  return pos == end || in_->skip(end - pos);
+}
+
+bool XcdrTranscoder::Pass::skip_primitives(size_t width, size_t count)
+{
+  return count == 0 || in_->skip(count, static_cast<int>(width));
+}
+
+bool XcdrTranscoder::Pass::read_int(DDS::TypeKind kind, ACE_CDR::LongLong& value)
+{
+  switch (kind) {
+  case TK_BOOLEAN:
+  case TK_BYTE:
+  case TK_UINT8:
+  case TK_CHAR8: {
+    ACE_CDR::Octet x;
+    if (!(*in_ >> ACE_InputCDR::to_octet(x))) {
+      return false;
+    }
+    value = x;
+    return true;
+  }
+  case TK_INT8: {
+    ACE_CDR::Octet x;
+    if (!(*in_ >> ACE_InputCDR::to_octet(x))) {
+      return false;
+    }
+    value = static_cast<signed char>(x);
+    return true;
+  }
+  case TK_INT16: {
+    ACE_CDR::Short x;
+    if (!(*in_ >> x)) {
+      return false;
+    }
+    value = x;
+    return true;
+  }
+  case TK_UINT16:
+  case TK_CHAR16: {
+    ACE_CDR::UShort x;
+    if (!(*in_ >> x)) {
+      return false;
+    }
+    value = x;
+    return true;
+  }
+  case TK_INT32: {
+    ACE_CDR::Long x;
+    if (!(*in_ >> x)) {
+      return false;
+    }
+    value = x;
+    return true;
+  }
+  case TK_UINT32: {
+    ACE_CDR::ULong x;
+    if (!(*in_ >> x)) {
+      return false;
+    }
+    value = x;
+    return true;
+  }
+  case TK_INT64:
+    return *in_ >> value;
+  case TK_UINT64: {
+    ACE_CDR::ULongLong x;
+    if (!(*in_ >> x)) {
+      return false;
+    }
+    value = static_cast<ACE_CDR::LongLong>(x);
+    return true;
+  }
+  }
+  return false;
+}
+
+bool XcdrTranscoder::Pass::read_block(size_t width, char* data, ACE_CDR::ULong count)
+{
+  switch (width) {
+  case 1:
+    return in_->read_octet_array(reinterpret_cast<ACE_CDR::Octet*>(data), count);
+  case 2:
+    return in_->read_ushort_array(reinterpret_cast<ACE_CDR::UShort*>(data), count);
+  case 4:
+    return in_->read_ulong_array(reinterpret_cast<ACE_CDR::ULong*>(data), count);
+  case 8:
+    return in_->read_ulonglong_array(reinterpret_cast<ACE_CDR::ULongLong*>(data), count);
+  case 16:
+    return in_->read_longdouble_array(reinterpret_cast<ACE_CDR::LongDouble*>(data), count);
+  }
+  return false;
+}
+
+bool XcdrTranscoder::Pass::next_size(size_t& size)
+{
+  if (cache_pos_ >= size_cache_.size()) {
+    return false;
+  }
+  size = size_cache_[cache_pos_++];
+  return true;
+}
+
+bool XcdrTranscoder::Pass::begin_delimited(Header& header)
+{
+  if (!out_xcdr2_) {
+    return true;
+  }
+  if (out_) {
+    size_t size;
+    return next_size(size) && out_->write_delimiter(size);
+  }
+  encoding_.align(size_, DCPS::uint32_cdr_size);
+  header.start = position();
+  size_ += DCPS::uint32_cdr_size;
+  header.cache_index = size_cache_.size();
+  size_cache_.push_back(0);
+  return true;
+}
+
+bool XcdrTranscoder::Pass::end_delimited(const Header& header)
+{
+  if (out_xcdr2_ && !out_) {
+    // Includes the delimiter, which is what write_delimiter expects.
+    size_cache_[header.cache_index] = position() - header.start;
+  }
+  return true;
+}
+
+bool XcdrTranscoder::Pass::begin_member(Header& header, DDS::MemberId id, bool must_understand)
+{
+  if (out_) {
+    size_t size;
+    return next_size(size) && out_->write_parameter_id(id, size, must_understand);
+  }
+  encoding_.align(size_, DCPS::xcdr1_pid_alignment);
+  size_ += DCPS::uint32_cdr_size;
+  if (!out_xcdr2_) {
+    // XCDR1 parameter IDs reset the alignment.
+    running_size_ += size_;
+    size_ = 0;
+  }
+  header.start = position();
+  header.cache_index = size_cache_.size();
+  size_cache_.push_back(0);
+  return true;
+}
+
+bool XcdrTranscoder::Pass::end_member(const Header& header, DDS::MemberId id)
+{
+  if (out_) {
+    return true;
+  }
+  // The member's size decides how long its header is, so the rest of the
+  // header is counted after the member.  The member itself starts at a
+  // position where that doesn't change its alignment.
+  const size_t size = position() - header.start;
+  size_cache_[header.cache_index] = size;
+  if (out_xcdr2_) {
+    if (size != 1 && size != 2 && size != 4 && size != 8) {
+      size_ += DCPS::uint32_cdr_size; // NEXTINT
+    }
+  } else if (id > (1 << 14) || size > (1 << 16)) {
+    running_size_ += 2 * DCPS::uint32_cdr_size; // Extended parameter ID and size
+  }
+  return true;
+}
+
+bool XcdrTranscoder::Pass::end_member_list()
+{
+  if (out_xcdr2_) {
+    return true;
+  }
+  if (out_) {
+    return out_->write_list_end_parameter_id();
+  }
+  encoding_.align(size_, DCPS::xcdr1_pid_alignment);
+  size_ += DCPS::uint32_cdr_size;
+  return true;
+}
+
+void XcdrTranscoder::Pass::add_primitives(size_t width, size_t count)
+{
+  encoding_.align(size_, width);
+  size_ += width * count;
+}
+
+bool XcdrTranscoder::Pass::write_int(DDS::TypeKind kind, ACE_CDR::LongLong value)
+{
+  if (!out_) {
+    add_primitives(wire_size(kind), 1);
+    return true;
+  }
+  switch (kind) {
+  case TK_BOOLEAN:
+  case TK_BYTE:
+  case TK_INT8:
+  case TK_UINT8:
+  case TK_CHAR8:
+    return *out_ << ACE_OutputCDR::from_octet(static_cast<ACE_CDR::Octet>(value));
+  case TK_INT16:
+    return *out_ << static_cast<ACE_CDR::Short>(value);
+  case TK_UINT16:
+  case TK_CHAR16:
+    return *out_ << static_cast<ACE_CDR::UShort>(value);
+  case TK_INT32:
+    return *out_ << static_cast<ACE_CDR::Long>(value);
+  case TK_UINT32:
+    return *out_ << static_cast<ACE_CDR::ULong>(value);
+  case TK_INT64:
+    return *out_ << value;
+  case TK_UINT64:
+    return *out_ << static_cast<ACE_CDR::ULongLong>(value);
+  }
+  return false;
+}
+
+bool XcdrTranscoder::Pass::write_block(size_t width, const char* data, ACE_CDR::ULong count)
+{
+  switch (width) {
+  case 1:
+    return out_->write_octet_array(reinterpret_cast<const ACE_CDR::Octet*>(data), count);
+  case 2:
+    return out_->write_ushort_array(reinterpret_cast<const ACE_CDR::UShort*>(data), count);
+  case 4:
+    return out_->write_ulong_array(reinterpret_cast<const ACE_CDR::ULong*>(data), count);
+  case 8:
+    return out_->write_ulonglong_array(reinterpret_cast<const ACE_CDR::ULongLong*>(data), count);
+  case 16:
+    return out_->write_longdouble_array(reinterpret_cast<const ACE_CDR::LongDouble*>(data), count);
+  }
+  return false;
+}
+
+char* XcdrTranscoder::Pass::block(size_t bytes)
+{
+  const size_t words = (bytes + sizeof(ACE_CDR::ULongLong) - 1) / sizeof(ACE_CDR::ULongLong);
+  if (buffer_.size() < words) {
+    buffer_.resize(words);
+  }
+  return reinterpret_cast<char*>(&buffer_[0]);
+}
+
+bool XcdrTranscoder::Pass::write_zeros(size_t width, size_t count)
+{
+  if (count == 0) {
+    return true;
+  }
+  if (!out_) {
+    add_primitives(width, count);
+    return true;
+  }
+  const size_t per_block = (std::max)(block_size / memory_size(width), size_t(1));
+  char* const data = block(per_block * memory_size(width));
+  std::fill(buffer_.begin(), buffer_.end(), 0);
+  for (size_t done = 0; done < count;) {
+    const size_t n = (std::min)(per_block, count - done);
+    if (!write_block(width, data, static_cast<ACE_CDR::ULong>(n))) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool XcdrTranscoder::Pass::copy_primitives(size_t width, size_t count)
+{
+  if (count == 0) {
+    return true;
+  }
+  if (!out_) {
+    // The size pass only needs to know where the run ends.
+    if (!in_->skip(count, static_cast<int>(width))) {
+      return false;
+    }
+    add_primitives(width, count);
+    return true;
+  }
+  // Runs are contiguous in both encodings, so copying them a block at a time
+  // only swaps bytes if the byte orders differ.
+  const size_t per_block = (std::max)(block_size / memory_size(width), size_t(1));
+  char* const data = block(per_block * memory_size(width));
+  for (size_t done = 0; done < count;) {
+    const ACE_CDR::ULong n = static_cast<ACE_CDR::ULong>((std::min)(per_block, count - done));
+    if (!read_block(width, data, n) || !write_block(width, data, n)) {
+      return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool XcdrTranscoder::serialized_size(Serializer& in, const Encoding& encoding, size_t& size,
+                                     Sample::Extent ext, Sizes* sizes) const
+{
+  if (sizes) {
+    sizes->clear();
+  }
+  if (!valid_ || !in.current() || encoding.xcdr_version() == Encoding::XCDR_VERSION_NONE) {
+    return false;
+  }
+  const DCPS::Message_Block_Ptr dup(in.current()->duplicate());
+  Serializer sizing_in(dup.get(), in.encoding());
+  sizing_in.rdstate(in.rdstate());
+
+  Pass pass(*this, encoding);
+  if (!pass.compute_sizes(sizing_in, ext, size)) {
+    return false;
+  }
+  size = pass.total_size();
+  if (sizes) {
+    pass.swap_sizes(sizes->headers_);
+    sizes->transcoder_id_ = id_;
+    sizes->xcdr_version_ = encoding.xcdr_version();
+    sizes->ext_ = ext;
+  }
+  return true;
+}
+
+bool XcdrTranscoder::transcode(Serializer& in, Serializer& out, Sample::Extent ext,
+                               Sizes* sizes) const
+{
+  if (!valid_ || !in.current() || in.encoding().xcdr_version() == Encoding::XCDR_VERSION_NONE ||
+      out.encoding().xcdr_version() == Encoding::XCDR_VERSION_NONE) {
+    if (sizes) {
+      sizes->clear();
+    }
+    return false;
+  }
+
+  Pass pass(*this, out.encoding());
+  if (sizes && sizes->transcoder_id_ == id_ &&
+      sizes->xcdr_version_ == out.encoding().xcdr_version() && sizes->ext_ == ext) {
+    pass.swap_sizes(sizes->headers_);
+    sizes->clear();
+    return pass.write(in, out, ext);
+  }
+  if (sizes) {
+    sizes->clear();
+  }
+
+  const DCPS::Message_Block_Ptr dup(in.current()->duplicate());
+  Serializer sizing_in(dup.get(), in.encoding());
+  sizing_in.rdstate(in.rdstate());
+  return pass.compute_sizes(sizing_in, ext) && pass.write(in, out, ext);
+}
+
+bool XcdrTranscoder::transcode(const ACE_Message_Block& in, const Encoding& from_encoding,
+                               const Encoding& to_encoding, DCPS::Message_Block_Ptr& out,
+                               Sample::Extent ext) const
+{
+  if (!valid_ || from_encoding.xcdr_version() == Encoding::XCDR_VERSION_NONE ||
+      to_encoding.xcdr_version() == Encoding::XCDR_VERSION_NONE) {
+    return false;
+  }
+  Pass pass(*this, to_encoding);
+  {
+    const DCPS::Message_Block_Ptr dup(in.duplicate());
+    Serializer sizing_in(dup.get(), from_encoding);
+    if (!pass.compute_sizes(sizing_in, ext)) {
+      return false;
+    }
+  }
+
+  out.reset(new ACE_Message_Block(pass.total_size()));
+  const DCPS::Message_Block_Ptr dup(in.duplicate());
+  Serializer ser_in(dup.get(), from_encoding);
+  Serializer ser_out(out.get(), to_encoding);
+  if (!pass.write(ser_in, ser_out, ext)) {
+    out.reset();
+    return false;
+  }
+  return true;
+}
+
+XcdrTranscoderCache::XcdrTranscoderCache(size_t max_size)
+  : max_size_(max_size)
+  , uses_(0)
+{}
+
+XcdrTranscoder_rch XcdrTranscoderCache::get(DDS::DynamicType_ptr from_type,
+                                            DDS::DynamicType_ptr to_type)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  const TypePair key(from_type, to_type);
+  const Map::iterator pos = map_.find(key);
+  if (pos != map_.end()) {
+    pos->second.last_use = ++uses_;
+    return pos->second.transcoder;
+  }
+  if (max_size_ && map_.size() >= max_size_) {
+    Map::iterator lru = map_.begin();
+    for (Map::iterator it = map_.begin(); it != map_.end(); ++it) {
+      if (it->second.last_use < lru->second.last_use) {
+        lru = it;
+      }
+    }
+    map_.erase(lru);
+  }
+  Entry& entry = map_[key];
+  entry.from_type = DDS::DynamicType::_duplicate(from_type);
+  entry.to_type = DDS::DynamicType::_duplicate(to_type);
+  entry.transcoder = DCPS::make_rch<XcdrTranscoder>(from_type, to_type);
+  entry.last_use = ++uses_;
+  return entry.transcoder;
+}
+
+void XcdrTranscoderCache::erase(DDS::DynamicType_ptr type)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  for (Map::iterator pos = map_.begin(); pos != map_.end();) {
+    if (pos->first.first == type || pos->first.second == type) {
+      map_.erase(pos++);
+    } else {
+      ++pos;
+    }
+  }
+}
+
+void XcdrTranscoderCache::clear()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  map_.clear();
+}
+
+size_t XcdrTranscoderCache::size() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  return map_.size();
+}
+
+XcdrTranscoder_rch identity_transcoder(DDS::DynamicType_ptr type)
+{
+  DynamicTypeImpl* const impl = dynamic_cast<DynamicTypeImpl*>(type);
+  return impl ? impl->identity_transcoder() : DCPS::make_rch<XcdrTranscoder>(type, type);
+}
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
@@ -0,0 +1,225 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_XTYPES_XCDR_TRANSCODER_H
+#define OPENDDS_DCPS_XTYPES_XCDR_TRANSCODER_H
+
+#ifndef OPENDDS_SAFETY_PROFILE
+#  include <dds/DCPS/Message_Block_Ptr.h>
+#  include <dds/DCPS/PoolAllocator.h>
+#  include <dds/DCPS/RcObject.h>
+#  include <dds/DCPS/Sample.h>
+#  include <dds/DCPS/Serializer.h>
+
+#  include <dds/DdsDynamicDataC.h>
+
+#  include <ace/Thread_Mutex.h>
+
+#  include <utility>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+/**
+ * Converts serialized samples between XCDR1 and XCDR2, between byte orders,
+ * and between assignable versions of a type without creating DynamicData.
+ *
+ * The constructor walks the source and destination DynamicTypes once and
+ * compiles a plan that matches members by ID.  Members the destination
+ * doesn't have are skipped and members the source doesn't have are written
+ * with their default values.  Transcoding reads the sample twice: once to
+ * compute the sizes that XCDR2 delimiters and parameter headers need and
+ * once to write it.  Runs of primitives, such as primitive sequences and
+ * arrays and the characters of strings, are copied as blocks.
+ *
+ * The plan isn't modified after construction, so one XcdrTranscoder can be
+ * used from multiple threads at the same time.  Compiling the plan walks
+ * both types, so callers that transcode more than one sample should keep
+ * the transcoder, for example in an XcdrTranscoderCache.
+ */
+class OpenDDS_Dcps_Export XcdrTranscoder : public virtual DCPS::RcObject {
+public:
+  /// The sizes that the delimiters and parameter headers of one sample need,
+  /// as computed by serialized_size.  Passing them to transcode for the same
+  /// sample saves reading it a third time.
+  class Sizes {
+  public:
+    Sizes()
+      : transcoder_id_(0)
+      , xcdr_version_(DCPS::Encoding::XCDR_VERSION_NONE)
+      , ext_(DCPS::Sample::Full)
+    {}
+
+    void clear()
+    {
+      transcoder_id_ = 0;
+      headers_.clear();
+    }
+
+    void swap(Sizes& other)
+    {
+      std::swap(transcoder_id_, other.transcoder_id_);
+      std::swap(xcdr_version_, other.xcdr_version_);
+      std::swap(ext_, other.ext_);
+      headers_.swap(other.headers_);
+    }
+
+  private:
+    friend class XcdrTranscoder;
+
+    size_t transcoder_id_;
+    DCPS::Encoding::XcdrVersion xcdr_version_;
+    DCPS::Sample::Extent ext_;
+    OPENDDS_VECTOR(size_t) headers_;
+  };
+
+  XcdrTranscoder(DDS::DynamicType_ptr from_type, DDS::DynamicType_ptr to_type);
+
+  /// False if the types can't be transcoded, for example if they have
+  /// different extensibilities or kinds.
+  bool is_valid() const { return valid_; }
+
+  /// Compute the size of the sample at the current position of in once it's
+  /// transcoded to encoding.  in isn't advanced.  If sizes isn't null, the
+  /// header sizes are stored there for transcode.
+  bool serialized_size(DCPS::Serializer& in, const DCPS::Encoding& encoding, size_t& size,
+                       DCPS::Sample::Extent ext = DCPS::Sample::Full, Sizes* sizes = 0) const;
+
+  /// Read a sample from in and write it to out.  If sizes were computed by
+  /// this transcoder for the same sample, encoding version, and extent,
+  /// they are used instead of reading the sample to compute them.  sizes is
+  /// cleared either way.
+  bool transcode(DCPS::Serializer& in, DCPS::Serializer& out,
+                 DCPS::Sample::Extent ext = DCPS::Sample::Full, Sizes* sizes = 0) const;
+
+  /// Transcode the sample in the message block chain in into a new message
+  /// block that's exactly the size of the result.
+  bool transcode(const ACE_Message_Block& in, const DCPS::Encoding& from_encoding,
+                 const DCPS::Encoding& to_encoding, DCPS::Message_Block_Ptr& out,
+                 DCPS::Sample::Extent ext = DCPS::Sample::Full) const;
+
+private:
+  class Pass;
+  friend class Pass;
+
+  enum NodeKind {
+    NODE_INVALID,
+    NODE_PRIMITIVE, ///< Includes enums and bitmasks
+    NODE_STRING,
+    NODE_WSTRING,
+    NODE_STRUCTURE,
+    NODE_UNION,
+    NODE_SEQUENCE,
+    NODE_ARRAY
+  };
+
+  /// A member of a structure or a branch of a union.  in_from and in_to say
+  /// which of the types have it.
+  struct Member {
+    Member();
+
+    DDS::MemberId id;
+    bool in_from;
+    bool in_to;
+    bool key;
+    bool optional;
+    bool must_understand;
+    size_t node;
+    DDS::UnionCaseLabelSeq from_labels;
+    DDS::UnionCaseLabelSeq to_labels;
+    bool from_default;
+    bool to_default;
+  };
+  typedef OPENDDS_VECTOR(Member) MemberVec;
+
+  /// The plan for a pair of types.  Either of them can be missing, in which
+  /// case the node is only used to skip or to write default values.
+  struct Node {
+    Node();
+
+    NodeKind kind;
+    bool in_from;
+    bool in_to;
+    DDS::TypeKind from_wire;
+    DDS::TypeKind to_wire;
+    ACE_CDR::Long default_value;
+    DDS::ExtensibilityKind extensibility;
+    bool explicit_keys;
+    bool delimited;
+    ACE_CDR::ULong array_size;
+    size_t element;
+    size_t discriminator;
+    bool disc_must_understand;
+    MemberVec members;
+    OPENDDS_MAP(DDS::MemberId, size_t) member_index;
+  };
+
+  size_t build(DDS::DynamicType_ptr from, DDS::DynamicType_ptr to);
+  bool describe(Node& node, DDS::DynamicType_ptr from, DDS::DynamicType_ptr to);
+  bool describe_members(Node& node, DDS::DynamicType_ptr from, DDS::DynamicType_ptr to);
+
+  typedef std::pair<DDS::DynamicType_ptr, DDS::DynamicType_ptr> TypePair;
+  OPENDDS_MAP(TypePair, size_t) node_map_;
+  OPENDDS_VECTOR(Node) nodes_;
+  size_t root_;
+  bool valid_;
+  /// Identifies the transcoder that computed a Sizes, which is safer than
+  /// its address since another transcoder could reuse that.
+  const size_t id_;
+};
+
+typedef DCPS::RcHandle<XcdrTranscoder> XcdrTranscoder_rch;
+
+/**
+ * Compiled transcoders looked up by their source and destination types.
+ * The cache holds references to the types, so it shouldn't be owned by one
+ * of them.
+ */
+class OpenDDS_Dcps_Export XcdrTranscoderCache {
+public:
+  /// If max_size isn't 0, the least recently used transcoder is dropped
+  /// when a new one would exceed it.
+  explicit XcdrTranscoderCache(size_t max_size = 0);
+
+  /// The transcoder from from_type to to_type, compiled on first use.
+  XcdrTranscoder_rch get(DDS::DynamicType_ptr from_type, DDS::DynamicType_ptr to_type);
+
+  /// Forget the transcoders from or to type.
+  void erase(DDS::DynamicType_ptr type);
+
+  void clear();
+
+  size_t size() const;
+
+private:
+  typedef std::pair<DDS::DynamicType_ptr, DDS::DynamicType_ptr> TypePair;
+  struct Entry {
+    DDS::DynamicType_var from_type;
+    DDS::DynamicType_var to_type;
+    XcdrTranscoder_rch transcoder;
+    unsigned long last_use;
+  };
+  typedef OPENDDS_MAP(TypePair, Entry) Map;
+
+  const size_t max_size_;
+  mutable ACE_Thread_Mutex mutex_;
+  Map map_;
+  unsigned long uses_;
+};
+
+/// The transcoder that reads and writes type, which is compiled once per
+/// DynamicTypeImpl.
+OpenDDS_Dcps_Export XcdrTranscoder_rch identity_transcoder(DDS::DynamicType_ptr type);
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_SAFETY_PROFILE
+
+#endif // OPENDDS_DCPS_XTYPES_XCDR_TRANSCODER_H
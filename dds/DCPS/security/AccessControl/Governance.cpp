@@ -229,6 +229,7 @@ int Governance::load(const SSL::SignedDocument& doc)
           return -1;
         }
       }
+      domain_rule.topic_index.insert(t_rules.topic_expression, domain_rule.topic_rules.size());
       domain_rule.topic_rules.push_back(t_rules);
     }
 
@@ -7,6 +7,7 @@
 #define OPENDDS_DCPS_SECURITY_ACCESSCONTROL_GOVERNANCE_H
 
 #include "DomainIdSet.h"
+#include "TopicIndex.h"
 
 #include <dds/DCPS/security/SSL/SignedDocument.h>
 #include <dds/DCPS/RcObject.h>
@@ -39,6 +40,8 @@ public:
     DomainIdSet domains;
     DDS::Security::ParticipantSecurityAttributes domain_attrs;
     TopicAccessRules topic_rules;
+    /// Maps topic names to positions in topic_rules.
+    TopicIndex topic_index;
   };
 
   typedef std::vector<DomainRule> GovernanceAccessRules;
@@ -9,6 +9,10 @@
 
 #include <dds/DCPS/security/AccessControlBuiltInImpl.h>
 
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -16,6 +20,11 @@ namespace Security {
 
 using OpenDDS::DCPS::security_debug;
 
+namespace {
+  // Bound on the per-grant decision cache; it's cleared when full.
+  const size_t DECISION_CACHE_CAPACITY = 4096;
+}
+
 int Permissions::load(const SSL::SignedDocument& doc)
 {
   using XML::XStr;
@@ -211,6 +220,7 @@ int Permissions::load(const SSL::SignedDocument& doc)
           ACE_TEXT("Ignoring grant with duplicate subject name.\n")));
       }
     } else {
+      grant->compile();
       grants_.push_back(grant);
     }
   } // grant_rules
@@ -299,6 +309,87 @@ bool Permissions::Action::partitions_match(const DDS::StringSeq& entity_partitio
   return allow_or_deny == ALLOW;
 }
 
+void Permissions::Grant::compile()
+{
+  action_refs_.clear();
+  topic_index_.clear();
+  for (size_t r = 0; r < rules.size(); ++r) {
+    for (size_t a = 0; a < rules[r].actions.size(); ++a) {
+      action_refs_.push_back(ActionRef(r, a));
+      const std::vector<std::string>& topics = rules[r].actions[a].topics;
+      for (vsiter_t it = topics.begin(); it != topics.end(); ++it) {
+        topic_index_.insert(*it, action_refs_.size() - 1);
+      }
+    }
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(decisions_mutex_);
+  decisions_.clear();
+}
+
+bool Permissions::Grant::DecisionKey::operator<(const DecisionKey& other) const
+{
+  if (domain_id != other.domain_id) {
+    return domain_id < other.domain_id;
+  }
+  if (pub_or_sub != other.pub_or_sub) {
+    return pub_or_sub < other.pub_or_sub;
+  }
+  if (topic != other.topic) {
+    return topic < other.topic;
+  }
+  return partitions < other.partitions;
+}
+
+void Permissions::Grant::find_actions(const char* topic,
+                                      DDS::Security::DomainId_t domain_id,
+                                      PublishSubscribe_t pub_or_sub,
+                                      const DDS::StringSeq& partitions,
+                                      TopicIndex::Matches& out) const
+{
+  DecisionKey key;
+  key.domain_id = domain_id;
+  key.pub_or_sub = pub_or_sub;
+  key.topic = topic;
+  // Matching partitions is a set operation so the order of the endpoint's
+  // partitions doesn't matter.
+  key.partitions.reserve(partitions.length());
+  for (unsigned int i = 0; i < partitions.length(); ++i) {
+    key.partitions.push_back(partitions[i].in());
+  }
+  std::sort(key.partitions.begin(), key.partitions.end());
+  key.partitions.erase(std::unique(key.partitions.begin(), key.partitions.end()), key.partitions.end());
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(decisions_mutex_);
+    const DecisionCache::const_iterator pos = decisions_.find(key);
+    if (pos != decisions_.end()) {
+      out.insert(out.end(), pos->second.begin(), pos->second.end());
+      return;
+    }
+  }
+
+  TopicIndex::Matches candidates;
+  topic_index_.find(topic, candidates);
+
+  const size_t start = out.size();
+  for (TopicIndex::Matches::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+    const Rule& rule = rule_of(*it);
+    const Action& act = action(*it);
+    if (act.ps_type == pub_or_sub &&
+        rule.domains.has(domain_id) &&
+        act.partitions_match(partitions, rule.ad_type)) {
+      out.push_back(*it);
+    }
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(decisions_mutex_);
+  if (decisions_.size() >= DECISION_CACHE_CAPACITY) {
+    decisions_.clear();
+  }
+  decisions_[key].assign(out.begin() + start, out.end());
+}
+
 bool Permissions::Action::valid(time_t now_utc) const
 {
   if (validity.not_before != 0 && now_utc < validity.not_before) {
@@ -7,6 +7,7 @@
 #define OPENDDS_DCPS_SECURITY_ACCESSCONTROL_PERMISSIONS_H
 
 #include "DomainIdSet.h"
+#include "TopicIndex.h"
 
 #include <dds/DCPS/security/SSL/SignedDocument.h>
 #include <dds/DCPS/security/SSL/SubjectName.h>
@@ -17,6 +18,9 @@
 #include <dds/DdsSecurityCoreC.h>
 #include <dds/DdsSecurityParamsC.h>
 
+#include <ace/Thread_Mutex.h>
+
+#include <map>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -85,12 +89,68 @@ struct OpenDDS_Security_Export Permissions : DCPS::RcObject {
 
   typedef std::vector<Rule> Rules;
 
-  struct Grant : DCPS::RcObject {
+  /// Position of an Action within Grant::rules.
+  struct ActionRef {
+    size_t rule;
+    size_t action;
+
+    ActionRef(size_t r, size_t a)
+      : rule(r)
+      , action(a)
+    {}
+  };
+
+  struct OpenDDS_Security_Export Grant : DCPS::RcObject {
     std::string name;
     SSL::SubjectName subject;
     Validity_t validity;
     AllowDeny_t default_permission;
     Rules rules;
+
+    /// Index the topic expressions of all actions.  Called once the rules
+    /// are loaded; the rules must not change afterwards.
+    void compile();
+
+    /// Find the actions that apply to an endpoint in rule order, ignoring
+    /// their validity dates.  The topic is looked up in the compiled index
+    /// and the result is cached per (domain, pub/sub, topic, partitions).
+    void find_actions(const char* topic,
+                      DDS::Security::DomainId_t domain_id,
+                      PublishSubscribe_t pub_or_sub,
+                      const DDS::StringSeq& partitions,
+                      TopicIndex::Matches& out) const;
+
+    /// Find the actions whose topic expressions match 'topic' in rule order.
+    void find_topic_actions(const char* topic, TopicIndex::Matches& out) const
+    {
+      topic_index_.find(topic, out);
+    }
+
+    const ActionRef& action_ref(size_t i) const { return action_refs_[i]; }
+
+    const Action& action(size_t i) const
+    {
+      return rules[action_refs_[i].rule].actions[action_refs_[i].action];
+    }
+
+    const Rule& rule_of(size_t i) const { return rules[action_refs_[i].rule]; }
+
+  private:
+    std::vector<ActionRef> action_refs_;
+    TopicIndex topic_index_;
+
+    struct DecisionKey {
+      DDS::Security::DomainId_t domain_id;
+      PublishSubscribe_t pub_or_sub;
+      std::string topic;
+      std::vector<std::string> partitions;
+
+      bool operator<(const DecisionKey& other) const;
+    };
+    typedef std::map<DecisionKey, TopicIndex::Matches> DecisionCache;
+
+    mutable ACE_Thread_Mutex decisions_mutex_;
+    mutable DecisionCache decisions_;
   };
 
   typedef DCPS::RcHandle<Grant> Grant_rch;
@@ -0,0 +1,102 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.OpenDDS.org/license.html
+ */
+
+#include "TopicIndex.h"
+
+#include <dds/DCPS/security/AccessControlBuiltInImpl.h>
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+namespace {
+  // Characters with a special meaning to AccessControlBuiltInImpl::pattern_match.
+  const char* const special_chars = "*?[]\\";
+}
+
+TopicIndex::TopicIndex()
+  : trie_(1)
+  , size_(0)
+{}
+
+void TopicIndex::insert(const std::string& expression, size_t id)
+{
+  ++size_;
+  const size_t special = expression.find_first_of(special_chars);
+
+  if (special == std::string::npos) {
+    exact_[expression].push_back(id);
+    return;
+  }
+
+  if (special == expression.size() - 1 && expression[special] == '*') {
+    size_t node = 0;
+    for (size_t i = 0; i < special; ++i) {
+      const std::map<char, size_t>::const_iterator pos = trie_[node].children.find(expression[i]);
+      if (pos == trie_[node].children.end()) {
+        trie_.push_back(TrieNode());
+        trie_[node].children[expression[i]] = trie_.size() - 1;
+        node = trie_.size() - 1;
+      } else {
+        node = pos->second;
+      }
+    }
+    trie_[node].ids.push_back(id);
+    return;
+  }
+
+  globs_.push_back(std::make_pair(expression, id));
+}
+
+void TopicIndex::clear()
+{
+  exact_.clear();
+  trie_.assign(1, TrieNode());
+  globs_.clear();
+  size_ = 0;
+}
+
+void TopicIndex::find(const char* name, Matches& out) const
+{
+  const size_t start = out.size();
+  if (!name || size_ == 0) {
+    return;
+  }
+
+  const ExactMap::const_iterator exact = exact_.find(name);
+  if (exact != exact_.end()) {
+    out.insert(out.end(), exact->second.begin(), exact->second.end());
+  }
+
+  size_t node = 0;
+  for (const char* c = name; ; ++c) {
+    out.insert(out.end(), trie_[node].ids.begin(), trie_[node].ids.end());
+    if (!*c) {
+      break;
+    }
+    const std::map<char, size_t>::const_iterator pos = trie_[node].children.find(*c);
+    if (pos == trie_[node].children.end()) {
+      break;
+    }
+    node = pos->second;
+  }
+
+  for (size_t i = 0; i < globs_.size(); ++i) {
+    if (AccessControlBuiltInImpl::pattern_match(name, globs_[i].first.c_str())) {
+      out.push_back(globs_[i].second);
+    }
+  }
+
+  std::sort(out.begin() + start, out.end());
+  out.erase(std::unique(out.begin() + start, out.end()), out.end());
+}
+
+}
+}
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
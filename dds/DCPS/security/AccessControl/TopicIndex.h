@@ -0,0 +1,73 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.OpenDDS.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SECURITY_ACCESSCONTROL_TOPICINDEX_H
+#define OPENDDS_DCPS_SECURITY_ACCESSCONTROL_TOPICINDEX_H
+
+#include <dds/DCPS/security/OpenDDS_Security_Export.h>
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/Versioned_Namespace.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+/**
+ * @class TopicIndex
+ *
+ * @brief Finds which of a list of topic or partition expressions match a name
+ * without running fnmatch against every expression.
+ *
+ * Expressions are compiled into an exact-name hash, a prefix trie for
+ * expressions of the form "prefix*", and a residual list for everything else.
+ * Each expression is inserted with an id (normally its position in the
+ * document) and find() returns the ids of all matching expressions in
+ * ascending order so callers can keep the document's first-match semantics.
+ */
+class OpenDDS_Security_Export TopicIndex {
+public:
+  typedef std::vector<size_t> Matches;
+
+  TopicIndex();
+
+  void insert(const std::string& expression, size_t id);
+  void clear();
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  /// Append the ids of all expressions matching 'name' to 'out', sorted and
+  /// without duplicates.
+  void find(const char* name, Matches& out) const;
+
+private:
+  struct TrieNode {
+    std::map<char, size_t> children;
+    Matches ids;
+  };
+
+#ifdef ACE_HAS_CPP11
+  typedef OPENDDS_UNORDERED_MAP(std::string, Matches) ExactMap;
+#else
+  typedef OPENDDS_MAP(std::string, Matches) ExactMap;
+#endif
+
+  ExactMap exact_;
+  std::vector<TrieNode> trie_;
+  std::vector<std::pair<std::string, size_t> > globs_;
+  size_t size_;
+};
+
+}
+}
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif
@@ -38,7 +38,6 @@ using DCPS::TimeDuration;
 typedef Governance::GovernanceAccessRules::iterator gov_iter;
 typedef Permissions::Grants::iterator grant_iter;
 typedef Permissions::Rules::iterator perm_topic_rules_iter;
-typedef Permissions::Actions::iterator perm_topic_actions_iter;
 
 static const std::string PermissionsTokenClassId("DDS:Access:Permissions:1.0");
 static const std::string AccessControl_Plugin_Name("DDS:Access:Permissions");
@@ -47,6 +46,9 @@ static const std::string AccessControl_Minor_Version("0");
 
 static const std::string PermissionsCredentialTokenClassId("DDS:Access:PermissionsCredential");
 
+static const size_t VERIFIED_PERMISSIONS_CAPACITY = 1024;
+static const time_t VERIFIED_PERMISSIONS_MAX_AGE_SEC = 60;
+
 bool AccessControlBuiltInImpl::pattern_match(const char* string, const char* pattern)
 {
   return ACE::wild_match(string, pattern, true, true);
@@ -56,6 +58,7 @@ AccessControlBuiltInImpl::AccessControlBuiltInImpl()
   : handle_mutex_()
   , gen_handle_mutex_()
   , next_handle_(1)
+  , verified_permissions_(VERIFIED_PERMISSIONS_CAPACITY, DCPS::TimeDuration(VERIFIED_PERMISSIONS_MAX_AGE_SEC))
   , listener_ptr_(0)
 {  }
 
@@ -206,31 +209,43 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
 
   // permissions file
   TokenReader remote_perm_wrapper(remote_credential_token);
-  SSL::SignedDocument remote_perm_doc(remote_perm_wrapper.get_bin_property_value("c.perm"));
+  const DDS::OctetSeq& remote_perm_bytes = remote_perm_wrapper.get_bin_property_value("c.perm");
 
   const LocalAccessCredentialData::shared_ptr& local_access_credential_data = piter->second.local_access_credential_data;
 
   // Validate the signature of the remote permissions
   const SSL::Certificate& local_ca = local_access_credential_data->get_ca_cert();
-  std::string ca_subject;
 
-  local_ca.subject_name_to_str(ca_subject);
+  Permissions::shared_ptr remote_permissions = DCPS::make_rch<Permissions>();
 
-  if (!remote_perm_doc.verify(local_ca)) {
-    CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::validate_remote_permissions: Remote permissions signature not verified");
-    return DDS::HANDLE_NIL;
-  }
+  // Participants commonly share a permissions document, so the signature
+  // check and parse are skipped for one that was already verified.
+  DigestCache<Permissions::Grants>::Digest digest;
+  const bool have_digest =
+    DigestCache<Permissions::Grants>::digest(digest, local_ca.original_bytes(), remote_perm_bytes);
 
-  // The remote permissions signature is verified
-  if (DCPS::DCPS_debug_level) {
-    ACE_DEBUG((LM_DEBUG, ACE_TEXT(
-      "(%P|%t) AccessControlBuiltInImpl::validate_remote_permissions: Remote permissions document verified.\n")));
-  }
+  if (!have_digest || !verified_permissions_.find(digest, remote_permissions->grants_)) {
+    SSL::SignedDocument remote_perm_doc(remote_perm_bytes);
 
-  Permissions::shared_ptr remote_permissions = DCPS::make_rch<Permissions>();
-  if (remote_permissions->load(remote_perm_doc)) {
-    CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::validate_remote_permissions: Invalid permission file");
-    return DDS::HANDLE_NIL;
+    if (!remote_perm_doc.verify(local_ca)) {
+      CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::validate_remote_permissions: Remote permissions signature not verified");
+      return DDS::HANDLE_NIL;
+    }
+
+    // The remote permissions signature is verified
+    if (DCPS::DCPS_debug_level) {
+      ACE_DEBUG((LM_DEBUG, ACE_TEXT(
+        "(%P|%t) AccessControlBuiltInImpl::validate_remote_permissions: Remote permissions document verified.\n")));
+    }
+
+    if (remote_permissions->load(remote_perm_doc)) {
+      CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::validate_remote_permissions: Invalid permission file");
+      return DDS::HANDLE_NIL;
+    }
+
+    if (have_digest) {
+      verified_permissions_.insert(digest, remote_permissions->grants_);
+    }
   }
 
   //Extract and compare the remote subject name for validation
@@ -377,13 +392,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_write_protected) {
+          return true;
         }
       }
     }
@@ -442,13 +457,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_read_protected) {
+          return true;
         }
       }
     }
@@ -512,13 +527,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_to_find)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected || !tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_read_protected || !topic_rule.topic_attrs.is_write_protected) {
+          return true;
         }
       }
     }
@@ -536,30 +551,23 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
 
   Permissions::PublishSubscribe_t denied_type;
   bool found_deny = false;
-  // Iterate over allow / deny rules
-  for (perm_topic_rules_iter ptr_iter = grant->rules.begin(); ptr_iter != grant->rules.end(); ++ptr_iter) {
-
-    if (ptr_iter->domains.has(domain_to_find)) {
-
-      perm_topic_actions_iter tpsr_iter;
-      for (tpsr_iter = ptr_iter->actions.begin(); tpsr_iter != ptr_iter->actions.end(); ++tpsr_iter) {
-
-        std::vector<std::string>::iterator tl_iter;
-        for (tl_iter = tpsr_iter->topics.begin(); tl_iter != tpsr_iter->topics.end(); ++tl_iter) {
-
-          if (pattern_match(topic_name, tl_iter->c_str())) {
-            if (ptr_iter->ad_type == Permissions::ALLOW) {
-              return true;
-            }
-            if (found_deny && denied_type != tpsr_iter->ps_type) {
-              return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_topic: Both publish and subscribe are denied for this topic.");
-            } else if (!found_deny) {
-              found_deny = true;
-              denied_type = tpsr_iter->ps_type;
-            }
-          }
-        }
-      }
+  // Iterate over allow / deny actions for this topic in rule order
+  TopicIndex::Matches actions;
+  grant->find_topic_actions(topic_name, actions);
+  for (TopicIndex::Matches::const_iterator a_iter = actions.begin(); a_iter != actions.end(); ++a_iter) {
+    const Permissions::Rule& rule = grant->rule_of(*a_iter);
+    if (!rule.domains.has(domain_to_find)) {
+      continue;
+    }
+    const Permissions::Action& action = grant->action(*a_iter);
+    if (rule.ad_type == Permissions::ALLOW) {
+      return true;
+    }
+    if (found_deny && denied_type != action.ps_type) {
+      return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_create_topic: Both publish and subscribe are denied for this topic.");
+    } else if (!found_deny) {
+      found_deny = true;
+      denied_type = action.ps_type;
     }
   }
 
@@ -719,13 +727,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(publication_data.base.base.topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(publication_data.base.base.topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_write_protected) {
+          return true;
         }
       }
     }
@@ -781,13 +789,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(subscription_data.base.base.topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(subscription_data.base.base.topic_name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_read_protected) {
+          return true;
         }
       }
     }
@@ -884,13 +892,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_data.name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_data.name, tr_iter->topic_expression.c_str())) {
-          if (!tr_iter->topic_attrs.is_read_protected || !tr_iter->topic_attrs.is_write_protected) {
-            return true;
-          }
+      for (TopicIndex::Matches::const_iterator m = matches.begin(); m != matches.end(); ++m) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[*m];
+        if (!topic_rule.topic_attrs.is_read_protected || !topic_rule.topic_attrs.is_write_protected) {
+          return true;
         }
       }
     }
@@ -908,34 +916,27 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
 
   Permissions::PublishSubscribe_t denied_type;
   bool found_deny = false;
-  for (perm_topic_rules_iter ptr_iter = grant->rules.begin(); ptr_iter != grant->rules.end(); ++ptr_iter) {
+  // Iterate over pub / sub actions for this topic in rule order
+  TopicIndex::Matches actions;
+  grant->find_topic_actions(topic_data.name, actions);
+  for (TopicIndex::Matches::const_iterator a_iter = actions.begin(); a_iter != actions.end(); ++a_iter) {
+    const Permissions::Rule& rule = grant->rule_of(*a_iter);
+    if (!rule.domains.has(domain_id)) {
+      continue;
+    }
+    const Permissions::Action& action = grant->action(*a_iter);
 
-    if (ptr_iter->domains.has(domain_id)) {
-
-      // Iterate over pub / sub rules
-      perm_topic_actions_iter tpsr_iter;
-      for (tpsr_iter = ptr_iter->actions.begin(); tpsr_iter != ptr_iter->actions.end(); ++tpsr_iter) {
-
-        // Check to make sure they can publish or subscribe to the topic
-        // TODO Add support for relay permissions once relay only key exchange is supported
-        if (tpsr_iter->ps_type == Permissions::PUBLISH || tpsr_iter->ps_type == Permissions::SUBSCRIBE) {
-
-          std::vector<std::string>::iterator tl_iter;
-          for (tl_iter = tpsr_iter->topics.begin(); tl_iter != tpsr_iter->topics.end(); ++tl_iter) {
-
-            if (pattern_match(topic_data.name, tl_iter->c_str())) {
-              if (ptr_iter->ad_type == Permissions::ALLOW) {
-                return true;
-              }
-              if (found_deny && denied_type != tpsr_iter->ps_type) {
-                return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_topic: Both publish and subscribe are denied for this topic.");
-              } else if (!found_deny) {
-                found_deny = true;
-                denied_type = tpsr_iter->ps_type;
-              }
-            }
-          }
-        }
+    // Check to make sure they can publish or subscribe to the topic
+    // TODO Add support for relay permissions once relay only key exchange is supported
+    if (action.ps_type == Permissions::PUBLISH || action.ps_type == Permissions::SUBSCRIBE) {
+      if (rule.ad_type == Permissions::ALLOW) {
+        return true;
+      }
+      if (found_deny && denied_type != action.ps_type) {
+        return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl::check_remote_topic: Both publish and subscribe are denied for this topic.");
+      } else if (!found_deny) {
+        found_deny = true;
+        denied_type = action.ps_type;
       }
     }
   }
@@ -1195,13 +1196,13 @@ AccessControlBuiltInImpl::~AccessControlBuiltInImpl()
   for (gov_iter giter = begin; giter != end; ++giter) {
 
     if (giter->domains.has(piter->second.domain_id)) {
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
-          attributes = tr_iter->topic_attrs;
-          return true;
-        }
+      if (!matches.empty()) {
+        // The first matching rule in the document applies
+        attributes = giter->topic_rules[matches.front()].topic_attrs;
+        return true;
       }
     }
   }
@@ -1433,53 +1434,53 @@ CORBA::Boolean AccessControlBuiltInImpl::get_sec_attributes(::DDS::Security::Per
         return true;
       }
 
-      Governance::TopicAccessRules::iterator tr_iter;
+      TopicIndex::Matches matches;
+      giter->topic_index.find(topic_name, matches);
 
-      for (tr_iter = giter->topic_rules.begin(); tr_iter != giter->topic_rules.end(); ++tr_iter) {
-        if (pattern_match(topic_name, tr_iter->topic_expression.c_str())) {
+      if (!matches.empty()) {
+        const Governance::TopicAccessRule& topic_rule = giter->topic_rules[matches.front()];
 
-          // Process the TopicSecurityAttributes base
-          attributes.base.is_write_protected = tr_iter->topic_attrs.is_write_protected;
-          attributes.base.is_read_protected = tr_iter->topic_attrs.is_read_protected;
-          attributes.base.is_liveliness_protected = tr_iter->topic_attrs.is_liveliness_protected;
-          attributes.base.is_discovery_protected = tr_iter->topic_attrs.is_discovery_protected;
-
-          // Process metadata protection attributes
-          if (tr_iter->metadata_protection_kind == "NONE") {
-            attributes.is_submessage_protected = false;
-          }
-          else {
-            attributes.is_submessage_protected = true;
-
-            if (tr_iter->metadata_protection_kind == "ENCRYPT" ||
-              tr_iter->metadata_protection_kind == "ENCRYPT_WITH_ORIGIN_AUTHENTICATION") {
-              attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ENCRYPTED;
-            }
-
-            if (tr_iter->metadata_protection_kind == "SIGN_WITH_ORIGIN_AUTHENTICATION" ||
-              tr_iter->metadata_protection_kind == "ENCRYPT_WITH_ORIGIN_AUTHENTICATION") {
-              attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ORIGIN_AUTHENTICATED;
-            }
-          }
+        // Process the TopicSecurityAttributes base
+        attributes.base.is_write_protected = topic_rule.topic_attrs.is_write_protected;
+        attributes.base.is_read_protected = topic_rule.topic_attrs.is_read_protected;
+        attributes.base.is_liveliness_protected = topic_rule.topic_attrs.is_liveliness_protected;
+        attributes.base.is_discovery_protected = topic_rule.topic_attrs.is_discovery_protected;
 
-          // Process data protection attributes
+        // Process metadata protection attributes
+        if (topic_rule.metadata_protection_kind == "NONE") {
+          attributes.is_submessage_protected = false;
+        }
+        else {
+          attributes.is_submessage_protected = true;
 
-          if (tr_iter->data_protection_kind == "NONE") {
-            attributes.is_payload_protected = false;
-            attributes.is_key_protected = false;
-          }
-          else if (tr_iter->data_protection_kind == "SIGN") {
-            attributes.is_payload_protected = true;
-            attributes.is_key_protected = false;
+          if (topic_rule.metadata_protection_kind == "ENCRYPT" ||
+            topic_rule.metadata_protection_kind == "ENCRYPT_WITH_ORIGIN_AUTHENTICATION") {
+            attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ENCRYPTED;
           }
-          else if (tr_iter->data_protection_kind == "ENCRYPT") {
-            attributes.is_payload_protected = true;
-            attributes.is_key_protected = true;
-            attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED;
+
+          if (topic_rule.metadata_protection_kind == "SIGN_WITH_ORIGIN_AUTHENTICATION" ||
+            topic_rule.metadata_protection_kind == "ENCRYPT_WITH_ORIGIN_AUTHENTICATION") {
+            attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ORIGIN_AUTHENTICATED;
           }
+        }
 
-          return true;
+        // Process data protection attributes
+
+        if (topic_rule.data_protection_kind == "NONE") {
+          attributes.is_payload_protected = false;
+          attributes.is_key_protected = false;
+        }
+        else if (topic_rule.data_protection_kind == "SIGN") {
+          attributes.is_payload_protected = true;
+          attributes.is_key_protected = false;
         }
+        else if (topic_rule.data_protection_kind == "ENCRYPT") {
+          attributes.is_payload_protected = true;
+          attributes.is_key_protected = true;
+          attributes.plugin_endpoint_attributes |= ::DDS::Security::PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED;
+        }
+
+        return true;
       }
     }
   }
@@ -1498,22 +1499,19 @@ bool AccessControlBuiltInImpl::search_permissions(
   time_t& expiration_time,
   DDS::Security::SecurityException& ex)
 {
-  for (Permissions::Rules::const_iterator rit = grant.rules.begin(); rit != grant.rules.end(); ++rit) {
-    if (rit->domains.has(domain_id)) {
-      for (Permissions::Actions::const_iterator ait = rit->actions.begin(); ait != rit->actions.end(); ++ait) {
-        if (ait->ps_type == pub_or_sub &&
-            ait->topic_matches(topic_name) &&
-            ait->partitions_match(partition.name, rit->ad_type) &&
-            ait->valid(now_utc)) {
-          if (rit->ad_type == Permissions::ALLOW) {
-            if (ait->validity.not_after != 0) {
-              expiration_time = std::min(expiration_time, ait->validity.not_after);
-            }
-            return true;
-          } else {
-            return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl: DENY rule matched");
-          }
+  // Only validity depends on the time so the rest of the matching is cached by the grant
+  TopicIndex::Matches actions;
+  grant.find_actions(topic_name, domain_id, pub_or_sub, partition.name, actions);
+  for (TopicIndex::Matches::const_iterator a_iter = actions.begin(); a_iter != actions.end(); ++a_iter) {
+    const Permissions::Action& action = grant.action(*a_iter);
+    if (action.valid(now_utc)) {
+      if (grant.rule_of(*a_iter).ad_type == Permissions::ALLOW) {
+        if (action.validity.not_after != 0) {
+          expiration_time = std::min(expiration_time, action.validity.not_after);
         }
+        return true;
+      } else {
+        return CommonUtilities::set_security_error(ex, -1, 0, "AccessControlBuiltInImpl: DENY rule matched");
       }
     }
   }
@@ -12,6 +12,7 @@
 #include "AccessControl/LocalAccessCredentialData.h"
 #include "AccessControl/Governance.h"
 #include "AccessControl/Permissions.h"
+#include "DigestCache.h"
 #include "SSL/SubjectName.h"
 
 #include <dds/DCPS/Service_Participant.h>
@@ -291,6 +292,10 @@ private:
 
   int next_handle_;
 
+  /// Grants of remote permissions documents whose signature was verified,
+  /// keyed by the digest of the local CA and the document.
+  DigestCache<Permissions::Grants> verified_permissions_;
+
   DDS::Security::AccessControlListener_ptr listener_ptr_;
 
   RevokePermissionsTask_rch& make_task(RevokePermissionsTask_rch& task);
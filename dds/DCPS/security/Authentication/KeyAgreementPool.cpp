@@ -0,0 +1,199 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.OpenDDS.org/license.html
+ */
+
+#include "KeyAgreementPool.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Reverse_Lock_T.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+KeyAgreementPool::KeyAgreementPool()
+  : cv_(mutex_)
+  , depth_(0)
+  , running_(false)
+  , running_threads_(0)
+{
+}
+
+KeyAgreementPool::~KeyAgreementPool()
+{
+  shutdown();
+}
+
+void KeyAgreementPool::start(size_t threads, size_t depth)
+{
+  if (threads == 0 || depth == 0) {
+    return;
+  }
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (running_ || pool_) {
+      return;
+    }
+    running_ = true;
+    depth_ = depth;
+  }
+
+  pool_.reset(new DCPS::ThreadPool(threads, run, this));
+}
+
+void KeyAgreementPool::shutdown()
+{
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    running_ = false;
+    cv_.notify_all();
+    while (running_threads_) {
+      cv_.wait(tsm_);
+    }
+  }
+
+  // Joins the workers, which have all left run_i().
+  pool_.reset();
+
+  std::deque<DCPS::JobPtr> jobs;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    for (SlotMap::iterator it = slots_.begin(); it != slots_.end(); ++it) {
+      for (size_t i = 0; i < it->second.ready.size(); ++i) {
+        delete it->second.ready[i];
+      }
+    }
+    slots_.clear();
+    jobs.swap(jobs_);
+  }
+  // Jobs are released without the lock in case they own anything that
+  // posts to the pool.
+}
+
+bool KeyAgreementPool::running() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  return running_;
+}
+
+bool KeyAgreementPool::post(const DCPS::JobPtr& job)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!running_) {
+    return false;
+  }
+  jobs_.push_back(job);
+  cv_.notify_one();
+  return true;
+}
+
+void KeyAgreementPool::prepare(const DDS::OctetSeq& kagree_algo)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!running_) {
+    return;
+  }
+  const std::string k = key(kagree_algo);
+  if (slots_.find(k) == slots_.end()) {
+    slots_[k].kagree_algo = kagree_algo;
+    cv_.notify_all();
+  }
+}
+
+SSL::DiffieHellman* KeyAgreementPool::take(const DDS::OctetSeq& kagree_algo)
+{
+  const std::string k = key(kagree_algo);
+  bool known = false;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (running_) {
+      const SlotMap::iterator pos = slots_.find(k);
+      if (pos != slots_.end()) {
+        known = true;
+        if (!pos->second.ready.empty()) {
+          SSL::DiffieHellman* const dh = pos->second.ready.front();
+          pos->second.ready.pop_front();
+          cv_.notify_one();
+          return dh;
+        }
+      }
+    }
+  }
+
+  SSL::DiffieHellman* const dh = SSL::DiffieHellman::factory(kagree_algo);
+  if (dh && !known) {
+    // Only supported algorithms get a slot, so workers never spin on one
+    // the factory rejects.
+    prepare(kagree_algo);
+  }
+  return dh;
+}
+
+std::string KeyAgreementPool::key(const DDS::OctetSeq& kagree_algo)
+{
+  return std::string(reinterpret_cast<const char*>(kagree_algo.get_buffer()), kagree_algo.length());
+}
+
+KeyAgreementPool::Slot* KeyAgreementPool::next_slot()
+{
+  for (SlotMap::iterator it = slots_.begin(); it != slots_.end(); ++it) {
+    if (it->second.ready.size() + it->second.pending < depth_) {
+      return &it->second;
+    }
+  }
+  return 0;
+}
+
+ACE_THR_FUNC_RETURN KeyAgreementPool::run(void* arg)
+{
+  static_cast<KeyAgreementPool*>(arg)->run_i();
+  return 0;
+}
+
+void KeyAgreementPool::run_i()
+{
+  ACE_Reverse_Lock<ACE_Thread_Mutex> rev_lock(mutex_);
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ++running_threads_;
+  while (running_) {
+    if (!jobs_.empty()) {
+      DCPS::JobPtr job = jobs_.front();
+      jobs_.pop_front();
+      {
+        ACE_Guard<ACE_Reverse_Lock<ACE_Thread_Mutex> > rev_guard(rev_lock);
+        job->execute();
+        job.reset();
+      }
+      continue;
+    }
+
+    Slot* const slot = next_slot();
+    if (!slot) {
+      cv_.wait(tsm_);
+      continue;
+    }
+
+    ++slot->pending;
+    const DDS::OctetSeq kagree_algo = slot->kagree_algo;
+    SSL::DiffieHellman* dh = 0;
+    {
+      ACE_Guard<ACE_Reverse_Lock<ACE_Thread_Mutex> > rev_guard(rev_lock);
+      dh = SSL::DiffieHellman::factory(kagree_algo);
+    }
+    // Slots are only removed by shutdown(), which waits for this thread.
+    --slot->pending;
+    if (dh) {
+      slot->ready.push_back(dh);
+    }
+  }
+  --running_threads_;
+  cv_.notify_all();
+}
+
+} // namespace Security
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
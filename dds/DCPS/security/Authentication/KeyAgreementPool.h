@@ -0,0 +1,99 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.OpenDDS.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SECURITY_AUTHENTICATION_KEYAGREEMENTPOOL_H
+#define OPENDDS_DCPS_SECURITY_AUTHENTICATION_KEYAGREEMENTPOOL_H
+
+#include "dds/DCPS/security/SSL/DiffieHellman.h"
+
+#include "dds/DCPS/ConditionVariable.h"
+#include "dds/DCPS/JobQueue.h"
+#include "dds/DCPS/ThreadPool.h"
+#include "dds/DCPS/ThreadStatusManager.h"
+#include "dds/DCPS/unique_ptr.h"
+
+#include <ace/Thread_Mutex.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+/**
+ * @class KeyAgreementPool
+ *
+ * @brief Generates Diffie-Hellman key pairs ahead of time on worker threads.
+ *
+ * Key pair generation is the most expensive step of beginning a handshake
+ * that doesn't depend on the peer, so it can be moved off the discovery
+ * thread.  Only algorithms that have been asked for are generated, and up
+ * to 'depth' pairs of each are kept ready.  Until started, or when no pair
+ * is ready, take() generates one on the calling thread.
+ *
+ * The workers also run jobs given to post(), ahead of generating pairs, so
+ * that other handshake steps can be moved off the discovery thread too.
+ */
+class OpenDDS_Security_Export KeyAgreementPool {
+public:
+  KeyAgreementPool();
+  ~KeyAgreementPool();
+
+  /// Start 'threads' workers.  Has no effect if already started.
+  void start(size_t threads, size_t depth);
+
+  /// Stop and join the workers and discard any pairs that are ready and
+  /// any jobs that haven't started.
+  void shutdown();
+
+  bool running() const;
+
+  /// Run 'job' on a worker.  Returns false, without running it, if the
+  /// workers aren't running.
+  bool post(const DCPS::JobPtr& job);
+
+  /// Ask for pairs of 'kagree_algo' to be generated before they are needed.
+  void prepare(const DDS::OctetSeq& kagree_algo);
+
+  /// Return a new key pair for 'kagree_algo', or 0 if it's not supported.
+  /// The caller owns the returned object.
+  SSL::DiffieHellman* take(const DDS::OctetSeq& kagree_algo);
+
+private:
+  struct Slot {
+    DDS::OctetSeq kagree_algo;
+    std::deque<SSL::DiffieHellman*> ready;
+    size_t pending;
+
+    Slot() : pending(0) {}
+  };
+  typedef std::map<std::string, Slot> SlotMap;
+
+  static std::string key(const DDS::OctetSeq& kagree_algo);
+  Slot* next_slot();
+
+  static ACE_THR_FUNC_RETURN run(void* arg);
+  void run_i();
+
+  mutable ACE_Thread_Mutex mutex_;
+  DCPS::ConditionVariable<ACE_Thread_Mutex> cv_;
+  DCPS::ThreadStatusManager tsm_;
+  SlotMap slots_;
+  std::deque<DCPS::JobPtr> jobs_;
+  size_t depth_;
+  bool running_;
+  size_t running_threads_;
+  DCPS::unique_ptr<DCPS::ThreadPool> pool_;
+};
+
+} // namespace Security
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif
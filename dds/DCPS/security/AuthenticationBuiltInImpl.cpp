@@ -12,6 +12,7 @@
 #include "TokenWriter.h"
 #include "SSL/Utils.h"
 
+#include "dds/DCPS/GuidConverter.h"
 #include "dds/DCPS/GuidUtils.h"
 #include "dds/DCPS/LocalObject.h"
 #include "dds/DCPS/Serializer.h"
@@ -21,6 +22,7 @@
 
 #include "ace/config-macros.h"
 #include "ace/Guard_T.h"
+#include "ace/OS_NS_stdlib.h"
 
 #include <sstream>
 #include <vector>
@@ -52,6 +54,25 @@ const std::string Handshake_Reply_Class_Ext("Reply");
 const std::string Handshake_Final_Class_Ext("Final");
 
 const char* AuthenticationBuiltInImpl::PROPERTY_HANDSHAKE_DEBUG = "opendds.sec.auth.handshake_debug";
+const char* AuthenticationBuiltInImpl::PROPERTY_HANDSHAKE_THREADS = "opendds.sec.auth.handshake_threads";
+
+namespace {
+  // Key pairs kept ready per algorithm and worker thread.
+  const size_t KEY_AGREEMENT_DEPTH_PER_THREAD = 4;
+
+  // Certificate validation also checks validity dates and so only holds
+  // for a limited time.
+  const size_t VERIFIED_CERTIFICATES_CAPACITY = 4096;
+  const time_t VERIFIED_CERTIFICATES_MAX_AGE_SEC = 60;
+
+  DDS::OctetSeq ecdh_kagree_algo()
+  {
+    DDS::OctetSeq algo;
+    algo.length(sizeof SSL::ECDH_PRIME_256_V1_CEUM_STR);
+    std::memcpy(algo.get_buffer(), SSL::ECDH_PRIME_256_V1_CEUM_STR, sizeof SSL::ECDH_PRIME_256_V1_CEUM_STR);
+    return algo;
+  }
+}
 
 struct SharedSecret : DCPS::LocalObject<DDS::Security::SharedSecretHandle> {
 
@@ -76,11 +97,14 @@ AuthenticationBuiltInImpl::AuthenticationBuiltInImpl()
 , handshake_mutex_()
 , handle_mutex_()
 , next_handle_(1)
+, verified_certificates_(VERIFIED_CERTIFICATES_CAPACITY, DCPS::TimeDuration(VERIFIED_CERTIFICATES_MAX_AGE_SEC))
 {
 }
 
 AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl()
 {
+  key_agreement_pool_.shutdown();
+
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                ACE_TEXT("AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl local_participants_ %B handshake_data_ %B\n"),
@@ -120,6 +144,15 @@ AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl()
           if (std::strcmp(PROPERTY_HANDSHAKE_DEBUG,
                           participant_qos.property.value[i].name.in()) == 0) {
             local_participant->handshake_debug = true;
+          } else if (std::strcmp(PROPERTY_HANDSHAKE_THREADS,
+                                 participant_qos.property.value[i].name.in()) == 0) {
+            const int threads = ACE_OS::atoi(participant_qos.property.value[i].value.in());
+            if (threads > 0) {
+              key_agreement_pool_.start(static_cast<size_t>(threads),
+                                        static_cast<size_t>(threads) * KEY_AGREEMENT_DEPTH_PER_THREAD);
+              // Every handshake request uses ECDH.
+              key_agreement_pool_.prepare(ecdh_kagree_algo());
+            }
           }
         }
 
@@ -318,6 +351,8 @@ AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl()
   const ::DDS::OctetSeq & serialized_local_participant_data,
   ::DDS::Security::SecurityException & ex)
 {
+  const DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+
   if (serialized_local_participant_data.length() == 0) {
     set_security_error(ex, -1, 0, "No participant data provided");
     return DDS::Security::VALIDATION_FAILED;
@@ -342,7 +377,11 @@ AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl()
 
   const LocalAuthCredentialData& local_credential_data = *local_data.credentials;
 
-  SSL::DiffieHellman::unique_ptr diffie_hellman(new SSL::DiffieHellman(new SSL::ECDH_PRIME_256_V1_CEUM));
+  SSL::DiffieHellman::unique_ptr diffie_hellman(key_agreement_pool_.take(ecdh_kagree_algo()));
+  if (!diffie_hellman) {
+    set_security_error(ex, -1, 0, "Failed to generate Diffie-Hellman key pair");
+    return DDS::Security::VALIDATION_FAILED;
+  }
 
   OpenDDS::Security::TokenWriter message_out(handshake_message, build_class_id(Handshake_Request_Class_Ext));
 
@@ -400,11 +439,14 @@ AuthenticationBuiltInImpl::~AuthenticationBuiltInImpl()
   remote_data.reply = DDS::Security::Token();
   remote_data.diffie_hellman = DCPS::move(diffie_hellman);
   remote_data.hash_c1 = hash_c1;
+  remote_data.handshake_started = start;
 
   if (handshake_handle == DDS::HANDLE_NIL) {
     handshake_handle = get_next_handle();
   }
 
+  record_latency(&HandshakeLatency::begin_request, start);
+
   {
     ACE_Guard<ACE_Thread_Mutex> identity_data_guard(handshake_mutex_);
     handshake_data_[handshake_handle] = handshake_data;
@@ -617,6 +659,8 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   using OpenDDS::Security::TokenWriter;
   using OpenDDS::Security::TokenReader;
 
+  const DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+
   ACE_Guard<ACE_Thread_Mutex> identity_data_guard(identity_mutex_);
 
   // Copy the "in" part of the inout param
@@ -675,7 +719,7 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   if (cid.length() > 0) {
 
     remote_cert->deserialize(cid);
-    if (X509_V_OK != remote_cert->validate(local_credential_data.get_ca_cert()))
+    if (!validate_certificate(*remote_cert, cid, local_credential_data.get_ca_cert()))
     {
       set_security_error(ex, -1, 0, "Certificate validation failed");
       return Failure;
@@ -703,7 +747,11 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   cperm = message_in.get_bin_property_value("c.perm");
 
   const DDS::OctetSeq& dh_algo = message_in.get_bin_property_value("c.kagree_algo");
-  diffie_hellman.reset(SSL::DiffieHellman::factory(dh_algo));
+  diffie_hellman.reset(key_agreement_pool_.take(dh_algo));
+  if (!diffie_hellman) {
+    set_security_error(ex, -1, 0, "Unsupported 'c.kagree_algo' supplied");
+    return Failure;
+  }
 
   /* Compute hash_c1 and store for later */
 
@@ -803,11 +851,14 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   remote_data.request = request_token;
   remote_data.hash_c1 = hash_c1;
   remote_data.hash_c2 = hash_c2;
+  remote_data.handshake_started = start;
 
   if (handshake_handle == DDS::HANDLE_NIL) {
     handshake_handle = get_next_handle();
   }
 
+  record_latency(&HandshakeLatency::begin_reply, start);
+
   {
     ACE_Guard<ACE_Thread_Mutex> guard(handshake_mutex_);
     handshake_data_[handshake_handle] = handshake_data;
@@ -827,17 +878,124 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   const ::DDS::Security::HandshakeMessageToken & handshake_message_in,
   ::DDS::Security::HandshakeHandle handshake_handle,
   ::DDS::Security::SecurityException & ex)
+{
+  const DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+
+  if (!key_agreement_pool_.running()) {
+    return process_handshake_i(handshake_message_out, handshake_message_in, handshake_handle, start, ex);
+  }
+
+  // Verify the message on a handshake thread.  The caller retries with the
+  // same handle until the result is ready.
+  HandshakeJob_rch job;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(pending_mutex_);
+    const PendingHandshakeMap::iterator pos = pending_handshakes_.find(handshake_handle);
+    if (pos != pending_handshakes_.end()) {
+      if (!pos->second->done) {
+        return DDS::Security::VALIDATION_PENDING_RETRY;
+      }
+      handshake_message_out = pos->second->message_out;
+      ex = pos->second->ex;
+      const DDS::Security::ValidationResult_t result = pos->second->result;
+      pending_handshakes_.erase(pos);
+      return result;
+    }
+    job = DCPS::make_rch<HandshakeJob>(this, handshake_message_in, handshake_handle, start);
+    pending_handshakes_[handshake_handle] = job;
+  }
+
+  if (key_agreement_pool_.post(job)) {
+    return DDS::Security::VALIDATION_PENDING_RETRY;
+  }
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(pending_mutex_);
+    pending_handshakes_.erase(handshake_handle);
+  }
+  return process_handshake_i(handshake_message_out, handshake_message_in, handshake_handle, start, ex);
+}
+
+DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_handshake_i(
+  DDS::Security::HandshakeMessageToken& handshake_message_out,
+  const DDS::Security::HandshakeMessageToken& handshake_message_in,
+  DDS::Security::HandshakeHandle handshake_handle,
+  const DCPS::MonotonicTimePoint& start,
+  DDS::Security::SecurityException& ex)
 {
   const std::string incoming_class_ext = get_extension(handshake_message_in.class_id);
 
   if (Handshake_Reply_Class_Ext == incoming_class_ext) {
-    return process_handshake_reply(handshake_message_out, handshake_message_in, handshake_handle, ex);
+    const DDS::Security::ValidationResult_t result =
+      process_handshake_reply(handshake_message_out, handshake_message_in, handshake_handle, ex);
+    if (result == DDS::Security::VALIDATION_OK_FINAL_MESSAGE) {
+      record_latency(&HandshakeLatency::process_reply, start);
+    }
+    return result;
 
   } else if (Handshake_Final_Class_Ext == incoming_class_ext) {
-    return process_final_handshake(handshake_message_in, handshake_handle, ex);
+    const DDS::Security::ValidationResult_t result =
+      process_final_handshake(handshake_message_in, handshake_handle, ex);
+    if (result == DDS::Security::VALIDATION_OK) {
+      record_latency(&HandshakeLatency::process_final, start);
+    }
+    return result;
+  }
+
+  set_security_error(ex, -1, 0, "Unexpected handshake message class");
+  return DDS::Security::VALIDATION_FAILED;
+}
+
+AuthenticationBuiltInImpl::HandshakeJob::HandshakeJob(AuthenticationBuiltInImpl* impl,
+                                                      const DDS::Security::HandshakeMessageToken& message_in,
+                                                      DDS::Security::HandshakeHandle handle,
+                                                      const DCPS::MonotonicTimePoint& posted)
+  : impl(impl)
+  , message_in(message_in)
+  , handle(handle)
+  , posted(posted)
+  , result(DDS::Security::VALIDATION_FAILED)
+  , done(false)
+{
+  ex.message = "";
+  ex.code = 0;
+  ex.minor_code = 0;
+}
+
+void AuthenticationBuiltInImpl::HandshakeJob::execute()
+{
+  DDS::Security::HandshakeMessageToken out;
+  DDS::Security::SecurityException se = {"", 0, 0};
+  const DDS::Security::ValidationResult_t vr = impl->process_handshake_i(out, message_in, handle, posted, se);
+
+  ACE_Guard<ACE_Thread_Mutex> guard(impl->pending_mutex_);
+  message_out = out;
+  ex = se;
+  result = vr;
+  done = true;
+}
+
+bool AuthenticationBuiltInImpl::begin_processing(DDS::Security::HandshakeHandle handshake_handle,
+                                                 HandshakeDataPair& handshake_data,
+                                                 LocalAuthCredentialData::shared_ptr& credentials,
+                                                 DDS::Security::SecurityException& ex)
+{
+  ACE_Guard<ACE_Thread_Mutex> identity_data_guard(identity_mutex_);
+  ACE_Guard<ACE_Thread_Mutex> handshake_data_guard(handshake_mutex_);
+
+  handshake_data = get_handshake_data(handshake_handle);
+  if (!handshake_data.first || !handshake_data.second) {
+    set_security_error(ex, -1, 0, "Unknown handshake handle");
+    return false;
+  }
+
+  if (handshake_data.second->state != DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE) {
+    set_security_error(ex, -1, 0, "Handshake state is not valid");
+    return false;
   }
 
-  return DDS::Security::VALIDATION_PENDING_RETRY;
+  credentials = handshake_data.first->credentials;
+  return true;
 }
 
 ::DDS::Security::SharedSecretHandle* AuthenticationBuiltInImpl::get_shared_secret(
@@ -965,6 +1123,12 @@ static void make_final_signature_sequence(const DDS::OctetSeq& hash_c1,
   ::DDS::Security::HandshakeHandle handshake_handle,
   ::DDS::Security::SecurityException & ex)
 {
+  {
+    // A job that is still running finishes on its own copy of the data.
+    ACE_Guard<ACE_Thread_Mutex> guard(pending_mutex_);
+    pending_handshakes_.erase(handshake_handle);
+  }
+
   ACE_Guard<ACE_Thread_Mutex> guard(handshake_mutex_);
 
   HandshakeDataMap::iterator found = handshake_data_.find(handshake_handle);
@@ -1069,29 +1233,23 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_handshake_r
   DDS::Security::HandshakeHandle handshake_handle,
   DDS::Security::SecurityException & ex)
 {
-  ACE_Guard<ACE_Thread_Mutex> identity_data_guard(identity_mutex_);
-  ACE_Guard<ACE_Thread_Mutex> handshake_data_guard(handshake_mutex_);
-
   DDS::OctetSeq challenge1, hash_c2;
   SSL::Certificate::unique_ptr remote_cert(new SSL::Certificate);
 
   const DDS::Security::ValidationResult_t Failure = DDS::Security::VALIDATION_FAILED;
   const DDS::Security::ValidationResult_t FinalMessage = DDS::Security::VALIDATION_OK_FINAL_MESSAGE;
 
-  HandshakeDataPair handshake_data = get_handshake_data(handshake_handle);
-  if (!handshake_data.first || !handshake_data.second) {
-    set_security_error(ex, -1, 0, "Unknown handshake handle");
+  HandshakeDataPair handshake_data;
+  LocalAuthCredentialData::shared_ptr credentials;
+  if (!begin_processing(handshake_handle, handshake_data, credentials, ex)) {
     return Failure;
   }
 
-  LocalParticipantData& local_data = *(handshake_data.first);
+  // Only this handshake uses the data below until it is committed, so the
+  // certificate, signature, and key agreement work runs without the locks.
+  const LocalParticipantData& local_data = *(handshake_data.first);
   RemoteParticipantData& remote_data = *(handshake_data.second);
 
-  if (remote_data.state != DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE) {
-    set_security_error(ex, -1, 0, "Handshake state is not valid");
-    return Failure;
-  }
-
   TokenReader message_in(handshake_message_in);
   if (message_in.is_nil()) {
     set_security_error(ex, -1, 0, "Handshake_message_in must not be nil");
@@ -1110,14 +1268,14 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_handshake_r
     }
   }
 
-  const LocalAuthCredentialData& local_credential_data = *(local_data.credentials);
+  const LocalAuthCredentialData& local_credential_data = *credentials;
 
   const DDS::OctetSeq& cid = message_in.get_bin_property_value("c.id");
   if (cid.length() > 0) {
 
       remote_cert->deserialize(cid);
 
-    if (X509_V_OK != remote_cert->validate(local_credential_data.get_ca_cert()))
+    if (!validate_certificate(*remote_cert, cid, local_credential_data.get_ca_cert()))
     {
       set_security_error(ex, -1, 0, "Certificate validation failed");
       return Failure;
@@ -1228,6 +1386,7 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_handshake_r
   SSL::sign_serialized(sign_these, local_credential_data.get_participant_private_key(), tmp);
   final_msg.add_bin_property("signature", tmp);
 
+  ACE_Guard<ACE_Thread_Mutex> handshake_data_guard(handshake_mutex_);
   remote_data.certificate = DCPS::move(remote_cert);
   remote_data.state = FinalMessage;
   remote_data.c_perm = message_in.get_bin_property_value("c.perm");
@@ -1235,6 +1394,7 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_handshake_r
   remote_data.shared_secret = new SharedSecret(challenge1,
                                                challenge2,
                                                remote_data.diffie_hellman->get_shared_secret());
+  record_latency(&HandshakeLatency::complete, remote_data.handshake_started, &remote_data);
   return FinalMessage;
 }
 
@@ -1262,22 +1422,15 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_final_hands
   const DDS::Security::ValidationResult_t Failure = DDS::Security::VALIDATION_FAILED;
   const DDS::Security::ValidationResult_t ValidationOkay = DDS::Security::VALIDATION_OK;
 
-  ACE_Guard<ACE_Thread_Mutex> identity_data_guard(identity_mutex_);
-  ACE_Guard<ACE_Thread_Mutex> handshake_data_guard(handshake_mutex_);
-
-  HandshakeDataPair handshake_data = get_handshake_data(handshake_handle);
-  if (!handshake_data.first || !handshake_data.second) {
-    set_security_error(ex, -1, 0, "Unknown handshake handle");
+  HandshakeDataPair handshake_data;
+  LocalAuthCredentialData::shared_ptr credentials;
+  if (!begin_processing(handshake_handle, handshake_data, credentials, ex)) {
     return Failure;
   }
 
+  // See process_handshake_reply.
   RemoteParticipantData& remote_data = *(handshake_data.second);
 
-  if (remote_data.state != DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE) {
-    set_security_error(ex, -1, 0, "Handshake state is not valid");
-    return Failure;
-  }
-
   /* Check challenge1 and challenge2 match what was sent with the reply-message-token */
 
   TokenReader handshake_final_token(handshake_message_in);
@@ -1340,14 +1493,70 @@ DDS::Security::ValidationResult_t AuthenticationBuiltInImpl::process_final_hands
     return Failure;
   }
 
+  ACE_Guard<ACE_Thread_Mutex> handshake_data_guard(handshake_mutex_);
   remote_data.state = DDS::Security::VALIDATION_OK;
   remote_data.shared_secret = new SharedSecret(challenge1_reply,
                                                  challenge2_reply,
                                                  remote_data.diffie_hellman->get_shared_secret());
+  record_latency(&HandshakeLatency::complete, remote_data.handshake_started, &remote_data);
 
   return ValidationOkay;
 }
 
+AuthenticationBuiltInImpl::HandshakeLatency AuthenticationBuiltInImpl::handshake_latency() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(latency_mutex_);
+  return latency_;
+}
+
+void AuthenticationBuiltInImpl::reset_handshake_latency()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(latency_mutex_);
+  latency_ = HandshakeLatency();
+}
+
+void AuthenticationBuiltInImpl::record_latency(DCPS::LatencyHistogram HandshakeLatency::* step,
+                                               const DCPS::MonotonicTimePoint& start,
+                                               const RemoteParticipantData* completed)
+{
+  if (start.is_zero()) {
+    return;
+  }
+
+  const DCPS::TimeDuration elapsed = DCPS::MonotonicTimePoint::now() - start;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(latency_mutex_);
+    (latency_.*step).record(elapsed);
+  }
+
+  if (completed && DCPS::security_debug.auth_debug) {
+    ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {auth_debug} DEBUG: AuthenticationBuiltInImpl::record_latency ")
+               ACE_TEXT("handshake with %C completed in %C\n"),
+               DCPS::LogGuid(completed->participant_guid).c_str(), elapsed.str().c_str()));
+  }
+}
+
+bool AuthenticationBuiltInImpl::validate_certificate(const SSL::Certificate& cert,
+                                                     const DDS::OctetSeq& cid,
+                                                     const SSL::Certificate& ca)
+{
+  DigestCache<bool>::Digest digest;
+  const bool have_digest = DigestCache<bool>::digest(digest, ca.original_bytes(), cid);
+  bool valid = false;
+  if (have_digest && verified_certificates_.find(digest, valid)) {
+    return valid;
+  }
+
+  if (X509_V_OK != cert.validate(ca)) {
+    return false;
+  }
+
+  if (have_digest) {
+    verified_certificates_.insert(digest, true);
+  }
+  return true;
+}
+
 AuthenticationBuiltInImpl::LocalParticipantData::shared_ptr
 AuthenticationBuiltInImpl::get_local_participant(DDS::Security::IdentityHandle handle)
 {
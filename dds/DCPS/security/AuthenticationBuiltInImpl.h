@@ -11,13 +11,17 @@
 #define OPENDDS_DCPS_SECURITY_AUTHENTICATIONBUILTINIMPL_H
 
 #include "OpenDDS_Security_Export.h"
+#include "Authentication/KeyAgreementPool.h"
 #include "Authentication/LocalAuthCredentialData.h"
+#include "DigestCache.h"
 #include "SSL/DiffieHellman.h"
 
 #include <dds/DdsSecurityCoreC.h>
 #include <dds/Versioned_Namespace.h>
 #include <dds/DCPS/dcps_export.h>
 #include <dds/DCPS/GuidUtils.h>
+#include <dds/DCPS/LatencyHistogram.h>
+#include <dds/DCPS/TimeTypes.h>
 
 #include <ace/Thread_Mutex.h>
 
@@ -63,6 +67,23 @@ public:
   /// include in PropertyQosPolicy to add optional properties to Handshake tokens
   static const char* PROPERTY_HANDSHAKE_DEBUG;
 
+  /// include in PropertyQosPolicy to generate Diffie-Hellman key pairs on
+  /// this many worker threads instead of during the handshake
+  static const char* PROPERTY_HANDSHAKE_THREADS;
+
+  /// Time spent in each handshake step that succeeded and the time from
+  /// beginning a handshake to its completion, for all local participants.
+  struct HandshakeLatency {
+    DCPS::LatencyHistogram begin_request;
+    DCPS::LatencyHistogram begin_reply;
+    DCPS::LatencyHistogram process_reply;
+    DCPS::LatencyHistogram process_final;
+    DCPS::LatencyHistogram complete;
+  };
+
+  HandshakeLatency handshake_latency() const;
+  void reset_handshake_latency();
+
   AuthenticationBuiltInImpl();
   virtual ~AuthenticationBuiltInImpl();
 
@@ -183,6 +204,7 @@ private:
     DDS::OctetSeq c_perm;
     DDS::OctetSeq hash_c1;
     DDS::OctetSeq hash_c2;
+    DCPS::MonotonicTimePoint handshake_started;
 
     RemoteParticipantData()
       : participant_guid(DCPS::GUID_UNKNOWN)
@@ -231,6 +253,43 @@ private:
   HandshakeDataPair make_handshake_pair(DDS::Security::IdentityHandle h1,
                                         DDS::Security::IdentityHandle h2);
 
+  /// Check that handshake_handle is waiting for a message and get its data
+  /// and the local credentials under the locks.
+  bool begin_processing(DDS::Security::HandshakeHandle handshake_handle,
+                        HandshakeDataPair& handshake_data,
+                        LocalAuthCredentialData::shared_ptr& credentials,
+                        DDS::Security::SecurityException& ex);
+
+  DDS::Security::ValidationResult_t process_handshake_i(
+    DDS::Security::HandshakeMessageToken& handshake_message_out,
+    const DDS::Security::HandshakeMessageToken& handshake_message_in,
+    DDS::Security::HandshakeHandle handshake_handle,
+    const DCPS::MonotonicTimePoint& start,
+    DDS::Security::SecurityException& ex);
+
+  /// process_handshake() running on a handshake thread.
+  struct HandshakeJob : public DCPS::Job {
+    HandshakeJob(AuthenticationBuiltInImpl* impl,
+                 const DDS::Security::HandshakeMessageToken& message_in,
+                 DDS::Security::HandshakeHandle handle,
+                 const DCPS::MonotonicTimePoint& posted);
+
+    void execute();
+
+    AuthenticationBuiltInImpl* const impl;
+    const DDS::Security::HandshakeMessageToken message_in;
+    const DDS::Security::HandshakeHandle handle;
+    const DCPS::MonotonicTimePoint posted;
+
+    // Protected by pending_mutex_.
+    DDS::Security::HandshakeMessageToken message_out;
+    DDS::Security::SecurityException ex;
+    DDS::Security::ValidationResult_t result;
+    bool done;
+  };
+  typedef DCPS::RcHandle<HandshakeJob> HandshakeJob_rch;
+  typedef std::map<DDS::Security::HandshakeHandle, HandshakeJob_rch> PendingHandshakeMap;
+
   DDS::Security::ValidationResult_t process_handshake_reply(
     DDS::Security::HandshakeMessageToken & handshake_message_out,
     const DDS::Security::HandshakeMessageToken & handshake_message_in,
@@ -252,6 +311,16 @@ private:
 
   CORBA::Long get_next_handle();
 
+  /// Validate 'cert' (deserialized from 'cid') against 'ca', reusing the
+  /// result of an earlier validation of the same bytes.
+  bool validate_certificate(const SSL::Certificate& cert,
+                            const DDS::OctetSeq& cid,
+                            const SSL::Certificate& ca);
+
+  void record_latency(DCPS::LatencyHistogram HandshakeLatency::* step,
+                      const DCPS::MonotonicTimePoint& start,
+                      const RemoteParticipantData* completed = 0);
+
   struct was_guid_validated
   {
     was_guid_validated(const DCPS::GUID_t& expected) : expected_(expected) {}
@@ -285,6 +354,14 @@ private:
 
   CORBA::Long next_handle_;
 
+  KeyAgreementPool key_agreement_pool_;
+  ACE_Thread_Mutex pending_mutex_;
+  PendingHandshakeMap pending_handshakes_;
+  DigestCache<bool> verified_certificates_;
+
+  mutable ACE_Thread_Mutex latency_mutex_;
+  HandshakeLatency latency_;
+
 };
 } // namespace Security
 } // namespace OpenDDS
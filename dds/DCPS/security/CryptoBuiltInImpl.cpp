@@ -63,7 +63,7 @@ CryptoBuiltInImpl::~CryptoBuiltInImpl()
                keys_.size(),
                encrypt_options_.size(),
                participant_to_entity_.size(),
-               sessions_.size(),
+               session_count(),
                derived_key_handles_.size()));
   }
 
@@ -89,7 +89,7 @@ bool CryptoBuiltInImpl::marshal(TAO_OutputCDR&)
 
 NativeCryptoHandle CryptoBuiltInImpl::generate_handle()
 {
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   return generate_handle_i();
 }
 
@@ -164,7 +164,7 @@ ParticipantCryptoHandle CryptoBuiltInImpl::register_local_participant(
   KeySeq keys;
   DCPS::push_back(keys, key);
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -369,7 +369,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_local_datawriter(
     }
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -416,7 +416,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_matched_remote_datareader(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataWriter Crypto Handle");
@@ -462,11 +462,15 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_matched_remote_datareader(
                  keys_.size()));
     }
     if (existing_handle_iter != derived_key_handles_.end()) {
-      sessions_.erase(std::make_pair(h, submessage_key_index));
+      {
+        SessionShard& shard = session_shard(h);
+        ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
+        shard.sessions_.erase(std::make_pair(h, submessage_key_index));
+      }
       if (DCPS::security_debug.bookkeeping) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                    ACE_TEXT("CryptoBuiltInImpl::register_matched_remote_datareader sessions_ (total %B)\n"),
-                   sessions_.size()));
+                   session_count()));
       }
     } else {
       derived_key_handles_[input_handles] = h;
@@ -522,7 +526,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_local_datareader(
     DCPS::push_back(keys, key);
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -568,7 +572,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_matched_remote_datawriter(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataReader Crypto Handle");
@@ -614,11 +618,15 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_matched_remote_datawriter(
                  keys_.size()));
     }
     if (existing_handle_iter != derived_key_handles_.end()) {
-      sessions_.erase(std::make_pair(h, submessage_key_index));
+      {
+        SessionShard& shard = session_shard(h);
+        ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
+        shard.sessions_.erase(std::make_pair(h, submessage_key_index));
+      }
       if (DCPS::security_debug.bookkeeping) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                    ACE_TEXT("CryptoBuiltInImpl::register_matched_remote_datawriter sessions_ (total %B)\n"),
-                   sessions_.size()));
+                   session_count()));
       }
     } else {
       derived_key_handles_[input_handles] = h;
@@ -652,7 +660,7 @@ bool CryptoBuiltInImpl::unregister_participant(ParticipantCryptoHandle handle, S
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_common_data(handle);
   for (DerivedKeyIndex_t::iterator it = derived_key_handles_.lower_bound(std::make_pair(handle, 0));
        it != derived_key_handles_.end() && it->first.first == handle; derived_key_handles_.erase(it++)) {
@@ -673,17 +681,30 @@ void CryptoBuiltInImpl::clear_common_data(NativeCryptoHandle handle)
                ACE_TEXT("CryptoBuiltInImpl::clear_common_data keys_ (total %B)\n"),
                keys_.size()));
   }
-  for (SessionTable_t::iterator st_iter = sessions_.lower_bound(std::make_pair(handle, 0));
-       st_iter != sessions_.end() && st_iter->first.first == handle;
-       sessions_.erase(st_iter++)) {
+  SessionShard& shard = session_shard(handle);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
+  SessionTable_t& sessions = shard.sessions_;
+  for (SessionTable_t::iterator st_iter = sessions.lower_bound(std::make_pair(handle, 0));
+       st_iter != sessions.end() && st_iter->first.first == handle;
+       sessions.erase(st_iter++)) {
     if (DCPS::security_debug.bookkeeping) {
       ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
                  ACE_TEXT("CryptoBuiltInImpl::clear_common_data sessions_ (total %B)\n"),
-                 sessions_.size()));
+                 sessions.size()));
     }
   }
 }
 
+size_t CryptoBuiltInImpl::session_count()
+{
+  size_t count = 0;
+  for (size_t i = 0; i < SESSION_SHARDS; ++i) {
+    ACE_Guard<ACE_Thread_Mutex> shard_guard(session_shards_[i].mutex_);
+    count += session_shards_[i].sessions_.size();
+  }
+  return count;
+}
+
 void CryptoBuiltInImpl::clear_endpoint_data(NativeCryptoHandle handle)
 {
   clear_common_data(handle);
@@ -715,7 +736,7 @@ bool CryptoBuiltInImpl::unregister_datawriter(DatawriterCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -726,7 +747,7 @@ bool CryptoBuiltInImpl::unregister_datareader(DatareaderCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -808,7 +829,7 @@ bool CryptoBuiltInImpl::create_local_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter != keys_.end()) {
     local_participant_crypto_tokens = keys_to_tokens(iter->second);
@@ -831,7 +852,7 @@ bool CryptoBuiltInImpl::have_local_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -852,7 +873,7 @@ bool CryptoBuiltInImpl::set_remote_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_participant_crypto] = tokens_to_keys(remote_participant_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -873,7 +894,7 @@ bool CryptoBuiltInImpl::have_remote_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -894,7 +915,7 @@ bool CryptoBuiltInImpl::create_local_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote reader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter != keys_.end()) {
     local_datawriter_crypto_tokens = keys_to_tokens(iter->second);
@@ -916,7 +937,7 @@ bool CryptoBuiltInImpl::have_local_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -937,7 +958,7 @@ bool CryptoBuiltInImpl::set_remote_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datawriter_crypto] = tokens_to_keys(remote_datawriter_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -958,7 +979,7 @@ bool CryptoBuiltInImpl::have_remote_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -979,7 +1000,7 @@ bool CryptoBuiltInImpl::create_local_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote writer handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter != keys_.end()) {
     local_datareader_crypto_tokens = keys_to_tokens(iter->second);
@@ -1001,7 +1022,7 @@ bool CryptoBuiltInImpl::have_local_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1022,7 +1043,7 @@ bool CryptoBuiltInImpl::set_remote_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datareader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datareader_crypto] = tokens_to_keys(remote_datareader_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -1043,7 +1064,7 @@ bool CryptoBuiltInImpl::have_remote_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1076,13 +1097,6 @@ namespace {
           kind[TransformKindIndex] == CRYPTO_TRANSFORMATION_KIND_AES256_GMAC);
   }
 
-  struct CipherContext {
-    EVP_CIPHER_CTX* ctx_;
-    CipherContext() : ctx_(EVP_CIPHER_CTX_new()) {}
-    operator EVP_CIPHER_CTX*() { return ctx_; }
-    ~CipherContext() { EVP_CIPHER_CTX_free(ctx_); }
-  };
-
   bool inc32(unsigned char* a)
   {
     for (int i = 0; i < 4; ++i) {
@@ -1110,7 +1124,7 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator keys_iter = keys_.find(sending_datawriter_crypto);
   const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(sending_datawriter_crypto);
   if (eo_iter == encrypt_options_.end()) {
@@ -1135,14 +1149,16 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   // see register_local_datawriter for the assignment of key indexes in the seq
   const unsigned int key_idx = keyseq.length() >= 2 ? 1 : 0;
   const KeyId_t sKey = std::make_pair(sending_datawriter_crypto, key_idx);
+  SessionShard& shard = session_shard(sending_datawriter_crypto);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
 
   if (encrypts(keyseq[key_idx])) {
-    ok = encrypt(keyseq[key_idx], sessions_[sKey], plain_buffer,
+    ok = encrypt(keyseq[key_idx], shard.sessions_[sKey], plain_buffer,
                  header, footer, out, ex);
     pOut = &out;
 
   } else if (authenticates(keyseq[key_idx])) {
-    ok = authtag(keyseq[key_idx], sessions_[sKey], plain_buffer,
+    ok = authtag(keyseq[key_idx], shard.sessions_[sKey], plain_buffer,
                  header, footer, ex);
 
   } else {
@@ -1176,6 +1192,73 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   return ser.good_bit();
 }
 
+CryptoBuiltInImpl::Session::Session()
+  : counter_(0)
+  , encrypt_ctx_(0)
+  , decrypt_ctx_(0)
+{
+  std::memset(id_, 0, sizeof id_);
+  std::memset(iv_suffix_, 0, sizeof iv_suffix_);
+}
+
+CryptoBuiltInImpl::Session::Session(const Session& other)
+  : key_(other.key_)
+  , counter_(other.counter_)
+  , encrypt_ctx_(0)
+  , decrypt_ctx_(0)
+{
+  std::memcpy(id_, other.id_, sizeof id_);
+  std::memcpy(iv_suffix_, other.iv_suffix_, sizeof iv_suffix_);
+}
+
+CryptoBuiltInImpl::Session& CryptoBuiltInImpl::Session::operator=(const Session& other)
+{
+  if (this != &other) {
+    release_ciphers();
+    std::memcpy(id_, other.id_, sizeof id_);
+    std::memcpy(iv_suffix_, other.iv_suffix_, sizeof iv_suffix_);
+    key_ = other.key_;
+    counter_ = other.counter_;
+  }
+  return *this;
+}
+
+CryptoBuiltInImpl::Session::~Session()
+{
+  release_ciphers();
+}
+
+void CryptoBuiltInImpl::Session::release_ciphers()
+{
+  EVP_CIPHER_CTX_free(encrypt_ctx_);
+  encrypt_ctx_ = 0;
+  EVP_CIPHER_CTX_free(decrypt_ctx_);
+  decrypt_ctx_ = 0;
+}
+
+EVP_CIPHER_CTX* CryptoBuiltInImpl::Session::cipher(bool encrypt, const unsigned char* iv)
+{
+  EVP_CIPHER_CTX*& ctx = encrypt ? encrypt_ctx_ : decrypt_ctx_;
+  const int enc = encrypt ? 1 : 0;
+
+  if (ctx) {
+    // Keep the expanded key, only start over with the new IV.
+    if (EVP_CipherInit_ex(ctx, 0, 0, 0, iv, enc) == 1) {
+      return ctx;
+    }
+    EVP_CIPHER_CTX_free(ctx);
+    ctx = 0;
+    return 0;
+  }
+
+  ctx = EVP_CIPHER_CTX_new();
+  if (ctx && EVP_CipherInit_ex(ctx, EVP_aes_256_gcm(), 0, key_.get_buffer(), iv, enc) != 1) {
+    EVP_CIPHER_CTX_free(ctx);
+    ctx = 0;
+  }
+  return ctx;
+}
+
 bool CryptoBuiltInImpl::Session::create_key(const KeyMaterial& master, SecurityException& ex)
 {
   RAND_bytes(id_, sizeof id_);
@@ -1258,9 +1341,8 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
     return true;
   }
 
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  EVP_CIPHER_CTX* const ctx = sess.cipher(true, iv);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1301,9 +1383,8 @@ bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
   std::memcpy(iv, &sess.id_, sizeof sess.id_);
   std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
 
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  EVP_CIPHER_CTX* const ctx = sess.cipher(true, iv);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1417,9 +1498,11 @@ bool CryptoBuiltInImpl::encode_submessage(
   const DDS::OctetSeq* pOut = &plain_rtps_submessage;
   const KeyId_t sKey = std::make_pair(sender_handle, submessage_key_index);
   bool authOnly = false;
+  SessionShard& shard = session_shard(sender_handle);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
 
   if (encrypts(keyseq[submessage_key_index])) {
-    ok = encrypt(keyseq[submessage_key_index], sessions_[sKey], plain_rtps_submessage,
+    ok = encrypt(keyseq[submessage_key_index], shard.sessions_[sKey], plain_rtps_submessage,
                  header, footer, out, ex);
     pOut = &out;
 
@@ -1429,7 +1512,7 @@ bool CryptoBuiltInImpl::encode_submessage(
     if (setOctetsToNextHeader(out, plain_rtps_submessage)) {
       pOut = &out;
     }
-    ok = authtag(keyseq[submessage_key_index], sessions_[sKey], *pOut,
+    ok = authtag(keyseq[submessage_key_index], shard.sessions_[sKey], *pOut,
                  header, footer, ex);
     authOnly = true;
 
@@ -1513,7 +1596,7 @@ bool CryptoBuiltInImpl::encode_datawriter_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datawriter_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(encode_handle);
   if (eo_iter == encrypt_options_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
@@ -1561,7 +1644,7 @@ bool CryptoBuiltInImpl::encode_datareader_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datareader_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   if (receiving_datawriter_crypto_list.length() == 1) {
     const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
     if (iter != keys_.end()) {
@@ -1592,7 +1675,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "No entry for sending_participant_crypto");
@@ -1619,9 +1702,11 @@ bool CryptoBuiltInImpl::encode_rtps_message(
   const DDS::OctetSeq* pOut = &transformed;
   const KeyMaterial& key = keyseq[0];
   const KeyId_t sKey = std::make_pair(sending_participant_crypto, 0);
+  SessionShard& shard = session_shard(sending_participant_crypto);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
 
   if (encrypts(key)) {
-    ok = encrypt(key, sessions_[sKey], transformed, cryptoHdr, cryptoFooter, out, ex);
+    ok = encrypt(key, shard.sessions_[sKey], transformed, cryptoHdr, cryptoFooter, out, ex);
     pOut = &out;
     addSecBody = true;
 
@@ -1632,7 +1717,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     if (offsetFinal && setOctetsToNextHeader(out, transformed, offsetFinal)) {
       pOut = &out;
     }
-    ok = authtag(key, sessions_[sKey], *pOut, cryptoHdr, cryptoFooter, ex);
+    ok = authtag(key, shard.sessions_[sKey], *pOut, cryptoHdr, cryptoFooter, ex);
 
   } else {
     return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
@@ -1722,7 +1807,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
       "Could not deserializer CyptoHeader\n"));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   typedef std::multimap<ParticipantCryptoHandle, EntityInfo>::iterator iter_t;
   const std::pair<iter_t, iter_t> iters =
     participant_to_entity_.equal_range(sending_participant_crypto);
@@ -1783,7 +1868,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
   return false;
 }
 
-KeyOctetSeq
+const KeyOctetSeq&
 CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
                                     const CryptoHeader& header,
                                     SecurityException& ex)
@@ -1799,6 +1884,9 @@ CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
 
 bool CryptoBuiltInImpl::Session::derive_key(const KeyMaterial& master, SecurityException& ex)
 {
+  // Cached ciphers were keyed with the previous session key.
+  release_ciphers();
+
   PrivateKey pkey(master.master_sender_key);
   DigestContext ctx;
   const EVP_MD* md = EVP_get_digestbyname("SHA256");
@@ -1850,7 +1938,7 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  const KeyOctetSeq& sess_key = sess.get_key(master, header, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1869,10 +1957,9 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
     return true;
   }
 
-  CipherContext ctx;
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = sess.cipher(false, header.session_id);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::decrypt - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1905,7 +1992,7 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
                                SecurityException& ex)
 
 {
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  const KeyOctetSeq& sess_key = sess.get_key(master, header, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1918,10 +2005,9 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
     return CommonUtilities::set_security_error(ex, -1, 0, "unsupported transformation kind");
   }
 
-  CipherContext ctx;
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = sess.cipher(false, header.session_id);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::verify - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
@@ -2030,7 +2116,7 @@ bool CryptoBuiltInImpl::decode_rtps_message(
     return CommonUtilities::set_security_error(ex, -9, 0, "Failed to find SRTPS_PREFIX/POSTFIX wrapper");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 2, "No key for Sending Participant handle");
@@ -2038,6 +2124,8 @@ bool CryptoBuiltInImpl::decode_rtps_message(
   const KeySeq& keyseq = iter->second;
   bool foundKey = false;
   DDS::OctetSeq transformed;
+  SessionShard& shard = session_shard(sending_participant_crypto);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
   for (unsigned int i = 0; !foundKey && i < keyseq.length(); ++i) {
     if (matches(keyseq[i], ch)) {
       const KeyId_t sKey = std::make_pair(sending_participant_crypto, i);
@@ -2047,14 +2135,14 @@ bool CryptoBuiltInImpl::decode_rtps_message(
           return CommonUtilities::set_security_error(ex, -15, 0, "Failed to find SEC_BODY submessage");
         }
         foundKey = true;
-        if (!decrypt(keyseq[i], sessions_[sKey], encrypted, sizeOfEncrypted,
+        if (!decrypt(keyseq[i], shard.sessions_[sKey], encrypted, sizeOfEncrypted,
                      ch, cf, transformed, ex)) {
           return false;
         }
 
       } else if (authenticates(keyseq[i])) {
         foundKey = true;
-        if (!verify(keyseq[i], sessions_[sKey], afterSrtpsPrefix, sizeOfAuthenticated,
+        if (!verify(keyseq[i], shard.sessions_[sKey], afterSrtpsPrefix, sizeOfAuthenticated,
                     ch, cf, transformed, ex)) {
           return false;
         }
@@ -2149,13 +2237,15 @@ bool CryptoBuiltInImpl::decode_submessage(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator keys_iter = keys_.find(sender_handle);
   if (keys_iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -2, 3, "Crypto Key not found");
   }
 
   const KeySeq& keyseq = keys_iter->second;
+  SessionShard& shard = session_shard(sender_handle);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
   for (unsigned int i = 0; i < keyseq.length(); ++i) {
     if (matches(keyseq[i], ch)) {
       const KeyId_t sKey = std::make_pair(sender_handle, i);
@@ -2169,11 +2259,11 @@ bool CryptoBuiltInImpl::decode_submessage(
             "Failed to deserialize content size(?)\n"));
           return false;
         }
-        return decrypt(keyseq[i], sessions_[sKey], mb_in.rd_ptr(), n, ch, cf,
+        return decrypt(keyseq[i], shard.sessions_[sKey], mb_in.rd_ptr(), n, ch, cf,
                        plain_rtps_submessage, ex);
 
       } else if (authenticates(keyseq[i])) {
-        return verify(keyseq[i], sessions_[sKey], mb_in.rd_ptr() - RTPS::SMHDR_SZ,
+        return verify(keyseq[i], shard.sessions_[sKey], mb_in.rd_ptr() - RTPS::SMHDR_SZ,
                       RTPS::SMHDR_SZ + octetsToNext, ch, cf, plain_rtps_submessage, ex);
 
       } else {
@@ -2258,7 +2348,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
       sending_datawriter_crypto, receiving_datareader_crypto));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_datawriter_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 1, "No key for DataWriter crypto handle");
@@ -2287,6 +2377,8 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
   }
 
   const KeySeq& keyseq = iter->second;
+  SessionShard& shard = session_shard(sending_datawriter_crypto);
+  ACE_Guard<ACE_Thread_Mutex> shard_guard(shard.mutex_);
   for (unsigned int i = 0; i < keyseq.length(); ++i) {
     if (matches(keyseq[i], ch)) {
       const KeyId_t sKey = std::make_pair(sending_datawriter_crypto, i);
@@ -2303,7 +2395,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
         if (!(de_ser >> cf)) {
           return CommonUtilities::set_security_error(ex, -3, 6, "Failed to deserialize CryptoFooter");
         }
-        return decrypt(keyseq[i], sessions_[sKey], ciphertext, n, ch, cf, plain_buffer, ex);
+        return decrypt(keyseq[i], shard.sessions_[sKey], ciphertext, n, ch, cf, plain_buffer, ex);
 
       } else if (authenticates(keyseq[i])) {
         return CommonUtilities::set_security_error(ex, -3, 3, "Auth-only payload "
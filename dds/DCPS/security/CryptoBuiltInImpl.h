@@ -14,6 +14,7 @@
 
 #include <tao/LocalObject.h>
 
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
 
 #include <map>
@@ -24,6 +25,8 @@
 
 class DDS_TEST;
 
+struct evp_cipher_ctx_st;
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -245,7 +248,10 @@ private:
   DDS::Security::NativeCryptoHandle generate_handle();
   DDS::Security::NativeCryptoHandle generate_handle_i();
 
-  ACE_Thread_Mutex mutex_;
+  /// Held for writing while keys and handles are registered or changed.
+  /// The transform operations only read these tables, so they hold it for
+  /// reading and serialize on the session shard instead.
+  ACE_RW_Thread_Mutex mutex_;
   int next_handle_;
 
   typedef KeyMaterial_AES_GCM_GMAC KeyMaterial;
@@ -287,16 +293,48 @@ private:
     KeyOctetSeq key_;
     ACE_UINT64 counter_;
 
-    KeyOctetSeq get_key(const KeyMaterial& master, const CryptoHeader& header,
-                        DDS::Security::SecurityException& ex);
+    Session();
+    Session(const Session& other);
+    Session& operator=(const Session& other);
+    ~Session();
+
+    const KeyOctetSeq& get_key(const KeyMaterial& master, const CryptoHeader& header,
+                               DDS::Security::SecurityException& ex);
     bool create_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool derive_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool next_id(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     void inc_iv();
+
+    /// Return a cipher context for key_ that is ready for a message using iv.
+    /// The key schedule is computed once per session key, after that only
+    /// the IV is reset.  Returns null on failure.
+    evp_cipher_ctx_st* cipher(bool encrypt, const unsigned char* iv);
+
+  private:
+    void release_ciphers();
+
+    // Cached contexts are never shared between copies of a Session.
+    evp_cipher_ctx_st* encrypt_ctx_;
+    evp_cipher_ctx_st* decrypt_ctx_;
   };
   typedef std::pair<DDS::Security::NativeCryptoHandle, unsigned int> KeyId_t;
   typedef std::map<KeyId_t, Session> SessionTable_t;
-  SessionTable_t sessions_;
+
+  /// Sessions are sharded by crypto handle so that encoding and decoding for
+  /// different entities doesn't contend on one lock.
+  struct SessionShard {
+    ACE_Thread_Mutex mutex_;
+    SessionTable_t sessions_;
+  };
+  static const size_t SESSION_SHARDS = 16;
+  SessionShard session_shards_[SESSION_SHARDS];
+
+  SessionShard& session_shard(DDS::Security::NativeCryptoHandle handle)
+  {
+    return session_shards_[static_cast<size_t>(handle) % SESSION_SHARDS];
+  }
+
+  size_t session_count();
 
   void clear_endpoint_data(DDS::Security::NativeCryptoHandle handle);
   void clear_common_data(DDS::Security::NativeCryptoHandle handle);
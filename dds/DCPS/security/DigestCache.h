@@ -0,0 +1,160 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SECURITY_DIGESTCACHE_H
+#define OPENDDS_DCPS_SECURITY_DIGESTCACHE_H
+
+#include "SSL/Utils.h"
+
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+/**
+ * @class DigestCache
+ *
+ * @brief Remembers the outcome of an expensive check on a set of documents,
+ * keyed by their SHA-256 digest.
+ *
+ * Used to skip re-verifying certificates and signed documents that were
+ * already verified against the same trust anchor.  Entries expire after
+ * max_age so revocation and expiry are noticed, and the oldest entries are
+ * evicted once capacity is reached.  Thread safe.
+ */
+template <typename T>
+class DigestCache {
+public:
+  typedef std::string Digest;
+
+  DigestCache(size_t capacity, const DCPS::TimeDuration& max_age)
+    : capacity_(capacity)
+    , max_age_(max_age)
+    , next_generation_(0)
+  {}
+
+  /// Digest of the concatenation of 'anchor' and 'document'.
+  /// @return false if the digest couldn't be computed.
+  static bool digest(Digest& out, const DDS::OctetSeq& anchor, const DDS::OctetSeq& document)
+  {
+    std::vector<const DDS::OctetSeq*> src;
+    src.push_back(&anchor);
+    src.push_back(&document);
+    DDS::OctetSeq hash;
+    if (SSL::hash(src, hash)) {
+      return false;
+    }
+    out.assign(reinterpret_cast<const char*>(hash.get_buffer()), hash.length());
+    return true;
+  }
+
+  bool find(const Digest& key, T& value)
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    const typename Map::iterator pos = entries_.find(key);
+    if (pos == entries_.end()) {
+      return false;
+    }
+    if (pos->second.expires < DCPS::MonotonicTimePoint::now()) {
+      entries_.erase(pos);
+      return false;
+    }
+    value = pos->second.value;
+    return true;
+  }
+
+  void insert(const Digest& key, const T& value)
+  {
+    if (capacity_ == 0) {
+      return;
+    }
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    Entry& entry = entries_[key];
+    if (entry.expires.is_zero()) {
+      // A key erased on expiry and inserted again is queued again, so tag
+      // each queued key with the generation of the entry it was queued for.
+      entry.generation = next_generation_++;
+      order_.push_back(std::make_pair(key, entry.generation));
+    }
+    entry.value = value;
+    entry.expires = DCPS::MonotonicTimePoint::now() + max_age_;
+
+    while (entries_.size() > capacity_ && !order_.empty()) {
+      if (is_live(order_.front())) {
+        entries_.erase(order_.front().first);
+      }
+      order_.pop_front();
+    }
+    if (order_.size() > 2 * capacity_) {
+      // Drop queued keys whose entries are gone or were replaced.
+      Order live;
+      for (size_t i = 0; i < order_.size(); ++i) {
+        if (is_live(order_[i])) {
+          live.push_back(order_[i]);
+        }
+      }
+      order_.swap(live);
+    }
+  }
+
+  size_t size() const
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return entries_.size();
+  }
+
+  void clear()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    entries_.clear();
+    order_.clear();
+  }
+
+private:
+  struct Entry {
+    T value;
+    DCPS::MonotonicTimePoint expires;
+    unsigned long generation;
+
+    Entry() : generation(0) {}
+  };
+  typedef std::map<Digest, Entry> Map;
+  typedef std::deque<std::pair<Digest, unsigned long> > Order;
+
+  bool is_live(const typename Order::value_type& queued) const
+  {
+    const typename Map::const_iterator pos = entries_.find(queued.first);
+    return pos != entries_.end() && pos->second.generation == queued.second;
+  }
+
+  mutable ACE_Thread_Mutex mutex_;
+  Map entries_;
+  Order order_;
+  const size_t capacity_;
+  const DCPS::TimeDuration max_age_;
+  unsigned long next_generation_;
+};
+
+} // namespace Security
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif
@@ -104,6 +104,11 @@ private:
 
   /// lock and copy map for lock-free access
   void copy_map_to(MapType& target);
+
+  typedef OPENDDS_VECTOR(std::pair<DataLinkIdType, DataLink_rch>) LinkVec;
+
+  /// lock and copy the links without allocating a map node per link
+  void copy_links_to(LinkVec& target);
 };
 
 } // namespace DCPS
@@ -30,15 +30,12 @@ OpenDDS::DCPS::DataLinkSet::send(DataSampleElement* sample)
     DataSampleHeader::test_flag(CONTENT_FILTER_FLAG, sample->get_sample());
 #endif
 
-  MapType map_copy;
-  {
-    GuardType guard(lock_);
-    map_copy = map_;
-  }
+  LinkVec links;
+  copy_links_to(links);
 
-  if (map_copy.size()) {
-    TransportSendElement* send_element = new TransportSendElement(static_cast<int>(map_copy.size()), sample);
-    for (MapType::iterator itr = map_copy.begin(); itr != map_copy.end(); ++itr) {
+  if (links.size()) {
+    TransportSendElement* send_element = new TransportSendElement(static_cast<int>(links.size()), sample);
+    for (LinkVec::iterator itr = links.begin(); itr != links.end(); ++itr) {
 
 #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
       if (customHeader) {
@@ -82,16 +79,13 @@ OpenDDS::DCPS::DataLinkSet::send_control(DataSampleElement* sample)
 {
   DBG_ENTRY_LVL("DataLinkSet", "send_control", 6);
   VDBG((LM_DEBUG, "(%P|%t) DBG: DataLinkSet::send_control %@.\n", sample));
-  MapType map_copy;
-  {
-    GuardType guard(lock_);
-    map_copy = map_;
-  }
+  LinkVec links;
+  copy_links_to(links);
 
   TransportSendControlElement* send_element =
-    new TransportSendControlElement(static_cast<int>(map_copy.size()), sample);
+    new TransportSendControlElement(static_cast<int>(links.size()), sample);
 
-  for (MapType::iterator itr = map_copy.begin(); itr != map_copy.end(); ++itr) {
+  for (LinkVec::iterator itr = links.begin(); itr != links.end(); ++itr) {
     itr->second->send(send_element);
   }
 }
@@ -269,6 +263,16 @@ OpenDDS::DCPS::DataLinkSet::copy_map_to(MapType& target)
   }
 }
 
+ACE_INLINE void
+OpenDDS::DCPS::DataLinkSet::copy_links_to(LinkVec& target)
+{
+  GuardType guard(lock_);
+  target.reserve(map_.size());
+  for (MapType::const_iterator itr = map_.begin(); itr != map_.end(); ++itr) {
+    target.push_back(LinkVec::value_type(itr->first, itr->second));
+  }
+}
+
 ACE_INLINE void
 OpenDDS::DCPS::DataLinkSet::send_final_acks(const GUID_t& readerid)
 {
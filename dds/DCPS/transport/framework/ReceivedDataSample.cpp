@@ -151,6 +151,30 @@ void ReceivedDataSample::replace(const char* data, size_t size)
   blocks_.push_back(MessageBlock(data, size));
 }
 
+void ReceivedDataSample::allocate(size_t size)
+{
+  clear();
+  blocks_.push_back(MessageBlock(size));
+  blocks_.back().write(size);
+}
+
+bool ReceivedDataSample::overwrite(size_t offset, const ReceivedDataSample& src, size_t size)
+{
+  if (blocks_.size() != 1 || offset > blocks_[0].len() || size > blocks_[0].len() - offset
+      || src.data_length() < size) {
+    return false;
+  }
+  char* out_iter = blocks_[0].rd_ptr() + offset;
+  for (size_t i = 0; size > 0 && i < src.blocks_.size(); ++i) {
+    const MessageBlock& element = src.blocks_[i];
+    const size_t len = (std::min)(element.len(), size);
+    std::memcpy(out_iter, element.rd_ptr(), len);
+    out_iter += len;
+    size -= len;
+  }
+  return true;
+}
+
 ReceivedDataSample
 ReceivedDataSample::get_fragment_range(FragmentNumber start_frag, FragmentNumber end_frag)
 {
@@ -90,6 +90,18 @@ public:
   /// @param size number of bytes to use as the payload
   void replace(const char* data, size_t size);
 
+  /// @brief Replace all payload bytes with a single newly allocated block
+  /// of size bytes, to be filled in using overwrite()
+  /// @param size number of bytes in the payload
+  void allocate(size_t size);
+
+  /// @brief Copy payload bytes from src into the block created by allocate()
+  /// @param offset position in this payload of the first byte copied
+  /// @param src the source ReceivedDataSample, its data is not modified
+  /// @param size number of bytes to copy from the start of src
+  /// @returns false if src is too short or the bytes don't fit
+  bool overwrite(size_t offset, const ReceivedDataSample& src, size_t size);
+
   ReceivedDataSample get_fragment_range(FragmentNumber start_frag, FragmentNumber end_frag = INVALID_FRAGMENT);
 
 private:
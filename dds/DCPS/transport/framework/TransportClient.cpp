@@ -753,7 +753,8 @@ TransportClient::disassociate(const GUID_t& peerId)
     return;
   }
 
-  const DataLink_rch link = found->second;
+  DataLink_rch link;
+  link.swap(found->second);
 
   //now that an _rch is created for the link, remove the iterator from data_link_index_ while still holding lock
   //otherwise it could be removed in transport_detached()
@@ -66,6 +66,8 @@ TransportImpl::shutdown()
     this->reactor_task_->stop();
   }
 
+  link_reactor_tasks_.stop();
+
   event_dispatcher_->shutdown(true);
 
   // Tell our subclass about the "shutdown event".
@@ -99,19 +101,72 @@ TransportImpl::add_pending_connection(const TransportClient_rch& client, DataLin
 }
 
 void
-TransportImpl::create_reactor_task(bool useAsyncSend, const OPENDDS_STRING& name)
+TransportImpl::create_reactor_task(bool useAsyncSend, const OPENDDS_STRING& name, bool link_pool)
 {
   if (is_shut_down_ || this->reactor_task_.in()) {
     return;
   }
 
+  ReactorTask::ThreadOptions options;
+  size_t threads = 1;
+  TransportInst_rch cfg = config();
+  if (cfg) {
+    threads = cfg->reactor_threads();
+    if (threads > 1 && !link_pool) {
+      if (log_level >= LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING,
+                   "(%P|%t) WARNING: TransportImpl::create_reactor_task: "
+                   "reactor_threads=%B for %C is only supported by the udp and multicast transports, "
+                   "using 1\n",
+                   threads, cfg->name().c_str()));
+      }
+      threads = 1;
+    }
+    const String scheduler = cfg->reactor_scheduler();
+    if (!ReactorTask::parse_scheduler(scheduler, options.sched_flags) && log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING,
+                 "(%P|%t) WARNING: TransportImpl::create_reactor_task: "
+                 "unknown reactor_scheduler \"%C\" for %C, using the default\n",
+                 scheduler.c_str(), cfg->name().c_str()));
+    }
+    options.priority = cfg->reactor_priority();
+    const String affinity = cfg->reactor_cpu_affinity();
+    if (!ReactorTask::parse_cpu_list(affinity, options.cpus) && log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING,
+                 "(%P|%t) WARNING: TransportImpl::create_reactor_task: "
+                 "invalid reactor_cpu_affinity \"%C\" for %C, not restricting CPUs\n",
+                 affinity.c_str(), cfg->name().c_str()));
+      options.cpus.clear();
+    }
+  }
+
   this->reactor_task_= make_rch<ReactorTask>(useAsyncSend);
 
-  if (reactor_task_->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), name)) {
+  if (reactor_task_->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), name, options)) {
     throw Transport::MiscProblem(); // error already logged by TRT::open()
   }
+
+  if (threads < 2) {
+    return;
+  }
+
+  link_reactor_tasks_.add(reactor_task_);
+  for (size_t i = 1; i < threads; ++i) {
+    ReactorTask_rch task = make_rch<ReactorTask>(useAsyncSend);
+    if (task->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(),
+                                name + "_" + to_dds_string(unsigned(i)), options)) {
+      throw Transport::MiscProblem();
+    }
+    link_reactor_tasks_.add(task);
+  }
 }
 
+ReactorTask_rch
+TransportImpl::link_reactor_task()
+{
+  const ReactorTask_rch task = link_reactor_tasks_.next();
+  return task ? task : reactor_task_;
+}
 
 void
 TransportImpl::unbind_link(DataLink*)
@@ -121,8 +121,11 @@ public:
   bool is_shut_down() const;
 
   /// Create the reactor task using sync send or optionally async send
-  /// by parameter on supported Windows platforms only.
-  void create_reactor_task(bool useAsyncSend = false, const OPENDDS_STRING& name = "");
+  /// by parameter on supported Windows platforms only.  Transports that
+  /// assign their DataLinks with link_reactor_task() pass link_pool to
+  /// create the additional threads configured with reactor_threads.
+  void create_reactor_task(bool useAsyncSend = false, const OPENDDS_STRING& name = "",
+                           bool link_pool = false);
 
   /// Diagnostic aid.
   void dump();
@@ -176,6 +179,11 @@ public:
   /// returned.
   ReactorTask_rch reactor_task();
 
+  /// Reactor task for a new DataLink.  When the transport is configured
+  /// with more than one reactor thread, each call selects the next thread
+  /// of the pool so the link's handlers always run on the same thread.
+  ReactorTask_rch link_reactor_task();
+
   EventDispatcher_rch event_dispatcher() { return event_dispatcher_; }
 
   DDS::DomainId_t domain() const { return domain_; }
@@ -286,6 +294,10 @@ private:
   /// subclass (of TransportImpl) doesn't require a reactor.
   ReactorTask_rch reactor_task_;
 
+  /// reactor_task_ and the additional reactor threads when
+  /// reactor_threads is greater than 1, empty otherwise.
+  ReactorTaskPool link_reactor_tasks_;
+
   struct DoClear : EventBase {
     explicit DoClear(RcHandle<DataLink> link) : link_(link) {}
     void handle_event()
@@ -84,6 +84,9 @@ TransportInst::dump_to_str(DDS::DomainId_t) const
   ret += formatNameForDump("fragment_reassembly_timeout") + fragment_reassembly_timeout().str() + '\n';
   ret += formatNameForDump("receive_preallocated_message_blocks") + to_dds_string(unsigned(receive_preallocated_message_blocks())) + '\n';
   ret += formatNameForDump("receive_preallocated_data_blocks") + to_dds_string(unsigned(receive_preallocated_data_blocks())) + '\n';
+  ret += formatNameForDump("reactor_threads")         + to_dds_string(unsigned(reactor_threads())) + '\n';
+  ret += formatNameForDump("reactor_cpu_affinity")    + reactor_cpu_affinity() + '\n';
+  ret += formatNameForDump("reactor_scheduler")       + reactor_scheduler() + '\n';
   return ret;
 }
 
@@ -211,6 +214,55 @@ TransportInst::receive_preallocated_data_blocks() const
   return TheServiceParticipant->config_store()->get_uint32(config_key("RECEIVE_PREALLOCATED_DATA_BLOCKS").c_str(), 0);
 }
 
+void
+TransportInst::reactor_threads(size_t rt)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("REACTOR_THREADS").c_str(), static_cast<DDS::UInt32>(rt));
+}
+
+size_t
+TransportInst::reactor_threads() const
+{
+  const size_t configured = TheServiceParticipant->config_store()->get_uint32(config_key("REACTOR_THREADS").c_str(), 1);
+  return configured ? configured : 1;
+}
+
+void
+TransportInst::reactor_cpu_affinity(const String& rca)
+{
+  TheServiceParticipant->config_store()->set(config_key("REACTOR_CPU_AFFINITY").c_str(), rca);
+}
+
+String
+TransportInst::reactor_cpu_affinity() const
+{
+  return TheServiceParticipant->config_store()->get(config_key("REACTOR_CPU_AFFINITY").c_str(), "");
+}
+
+void
+TransportInst::reactor_scheduler(const String& rs)
+{
+  TheServiceParticipant->config_store()->set(config_key("REACTOR_SCHEDULER").c_str(), rs);
+}
+
+String
+TransportInst::reactor_scheduler() const
+{
+  return TheServiceParticipant->config_store()->get(config_key("REACTOR_SCHEDULER").c_str(), "");
+}
+
+void
+TransportInst::reactor_priority(long rp)
+{
+  TheServiceParticipant->config_store()->set_int32(config_key("REACTOR_PRIORITY").c_str(), static_cast<DDS::Int32>(rp));
+}
+
+long
+TransportInst::reactor_priority() const
+{
+  return TheServiceParticipant->config_store()->get_int32(config_key("REACTOR_PRIORITY").c_str(), ACE_DEFAULT_THREAD_PRIORITY);
+}
+
 void
 TransportInst::drop_messages(bool flag)
 {
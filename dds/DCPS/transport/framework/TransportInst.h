@@ -126,6 +126,24 @@ public:
   void receive_preallocated_data_blocks(size_t rpdb);
   size_t receive_preallocated_data_blocks() const;
 
+  /// Number of reactor threads.  DataLinks are pinned to one of them
+  /// round robin.  The default value is 1.
+  void reactor_threads(size_t rt);
+  size_t reactor_threads() const;
+
+  /// CPUs the reactor threads may run on, for example "2,3" or "4-7".
+  /// The default (empty) does not restrict them.
+  void reactor_cpu_affinity(const String& rca);
+  String reactor_cpu_affinity() const;
+
+  /// Scheduling class (SCHED_OTHER, SCHED_RR, or SCHED_FIFO) and
+  /// priority of the reactor threads.  The default (empty) scheduler
+  /// inherits the class of the thread that creates the transport.
+  void reactor_scheduler(const String& rs);
+  String reactor_scheduler() const;
+  void reactor_priority(long rp);
+  long reactor_priority() const;
+
   /// Does the transport as configured support RELIABLE_RELIABILITY_QOS?
   virtual bool is_reliable() const = 0;
 
@@ -33,8 +33,10 @@ TransportReassembly::FragSample::FragSample(const FragmentRange& fragRange,
 {
 }
 
-TransportReassembly::TransportReassembly(const TimeDuration& timeout)
+TransportReassembly::TransportReassembly(const TimeDuration& timeout,
+                                         size_t contiguous_max_size)
   : timeout_(timeout)
+  , contiguous_max_size_(contiguous_max_size)
 {
 }
 
@@ -77,6 +79,10 @@ TransportReassembly::get_gaps(const SequenceNumber& seq, const GUID_t& pub_id,
     return 0;
   }
 
+  if (iter->second.contiguous()) {
+    return iter->second.contiguous_gaps(bitmap, length, numBits);
+  }
+
   // RTPS's FragmentNumbers are 32-bit values, so we'll only be using the
   // low 32 bits of the 64-bit generalized sequence numbers in
   // FragSample::frag_range_.
@@ -130,10 +136,11 @@ TransportReassembly::get_gaps(const SequenceNumber& seq, const GUID_t& pub_id,
 bool
 TransportReassembly::reassemble(const FragmentRange& fragRange,
                                 ReceivedDataSample& data,
-                                ACE_UINT32 total_frags)
+                                ACE_UINT32 total_frags,
+                                ACE_UINT32 sample_size)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  return reassemble_i(fragRange, fragRange.first == 1, data, total_frags);
+  return reassemble_i(fragRange, fragRange.first == 1, data, total_frags, sample_size);
 }
 
 bool
@@ -147,11 +154,24 @@ TransportReassembly::reassemble(const SequenceNumber& transportSeq,
                       firstFrag, data, total_frags);
 }
 
+bool
+TransportReassembly::use_contiguous(const ReceivedDataSample& data,
+                                    ACE_UINT32 total_frags,
+                                    ACE_UINT32 sample_size) const
+{
+  if (sample_size == 0 || sample_size > contiguous_max_size_ || data.fragment_size_ == 0) {
+    return false;
+  }
+  const ACE_UINT64 fsize = data.fragment_size_;
+  return total_frags == (sample_size + fsize - 1) / fsize;
+}
+
 bool
 TransportReassembly::reassemble_i(const FragmentRange& fragRange,
                                   bool firstFrag,
                                   ReceivedDataSample& data,
-                                  ACE_UINT32 total_frags)
+                                  ACE_UINT32 total_frags,
+                                  ACE_UINT32 sample_size)
 {
   if (Transport_debug_level > 5) {
     LogGuid logger(data.header_.publication_id_);
@@ -168,7 +188,22 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
   FragInfoMap::iterator iter = fragments_.find(key);
   const MonotonicTimePoint expiration = now + timeout_;
 
-  if (iter == fragments_.end()) {
+  if (iter == fragments_.end() && use_contiguous(data, total_frags, sample_size)) {
+    const CompletedMap::const_iterator citer = completed_.find(key.publication_);
+    if (citer != completed_.end() && citer->second.contains(key.data_sample_seq_)) {
+      // already completed, don't allocate a buffer for a late fragment
+      return false;
+    }
+    iter = fragments_.insert(std::make_pair(key, FragInfo(firstFrag, FragInfo::FragSampleList(),
+                                                          total_frags, expiration))).first;
+    iter->second.allocate_contiguous(sample_size, data.fragment_size_);
+    expiration_queue_.push_back(std::make_pair(expiration, key));
+    if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
+      ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::reassemble_i: "
+                 "allocated %u byte contiguous buffer with %B fragments\n",
+                 sample_size, fragments_.size()));
+    }
+  } else if (iter == fragments_.end()) {
     FragInfo& finfo = fragments_[key];
     finfo = FragInfo(firstFrag, FragInfo::FragSampleList(), total_frags, expiration);
     finfo.insert(fragRange, data);
@@ -190,12 +225,34 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
     if (firstFrag) {
       iter->second.have_first_ = true;
     }
-    if (iter->second.total_frags_ < total_frags) {
+    if (iter->second.total_frags_ < total_frags && !iter->second.contiguous()) {
       iter->second.total_frags_ = total_frags;
     }
     iter->second.expiration_ = expiration;
   }
 
+  if (iter->second.contiguous()) {
+    if (!iter->second.insert_contiguous(fragRange, data)) {
+      return false;
+    }
+    if (!iter->second.contiguous_complete()) {
+      VDBG((LM_DEBUG, "(%P|%t) TransportReassembly::reassemble_i: "
+        "returning false (incomplete contiguous)\n"));
+      return false;
+    }
+    std::swap(data, iter->second.contiguous_);
+    data.header_.more_fragments_ = false;
+    data.header_.message_length_ = static_cast<ACE_UINT32>(data.data_length());
+    fragments_.erase(iter);
+    completed_[key.publication_].insert(key.data_sample_seq_);
+    if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
+      ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::reassemble_i: "
+                 "removed contiguous frag, returning true (complete) with %B fragments\n",
+                 fragments_.size()));
+    }
+    return true;
+  }
+
   if (!iter->second.insert(fragRange, data)) {
     // error condition, already logged by insert()
     return false;
@@ -236,6 +293,10 @@ TransportReassembly::data_unavailable(const FragmentRange& dropped)
        ++iter) {
     const FragKey& key = iter->first;
     FragInfo& finfo = iter->second;
+    if (finfo.contiguous()) {
+      // transport sequence numbers don't apply to contiguous reassembly
+      continue;
+    }
     FragInfo::FragSampleList& flist = finfo.sample_list_;
 
     ReceivedDataSample dummy;
@@ -311,6 +372,7 @@ void TransportReassembly::check_expirations(const MonotonicTimePoint& now)
 TransportReassembly::FragInfo::FragInfo()
   : have_first_(false)
   , total_frags_(0)
+  , received_count_(0)
 {}
 
 TransportReassembly::FragInfo::FragInfo(bool hf, const FragSampleList& rl, ACE_UINT32 tf, const MonotonicTimePoint& expiration)
@@ -318,6 +380,7 @@ TransportReassembly::FragInfo::FragInfo(bool hf, const FragSampleList& rl, ACE_U
   , sample_list_(rl)
   , total_frags_(tf)
   , expiration_(expiration)
+  , received_count_(0)
 {
   for (FragSampleList::iterator it = sample_list_.begin(), prev = it; it != sample_list_.end(); ++it) {
     sample_finder_[it->frag_range_.second] = it;
@@ -345,6 +408,9 @@ TransportReassembly::FragInfo::operator=(const FragInfo& rhs)
     gap_list_ = rhs.gap_list_;
     total_frags_ = rhs.total_frags_;
     expiration_ = rhs.expiration_;
+    contiguous_ = rhs.contiguous_;
+    received_ = rhs.received_;
+    received_count_ = rhs.received_count_;
     sample_finder_.clear();
     gap_finder_.clear();
     for (FragSampleList::iterator it = sample_list_.begin(); it != sample_list_.end(); ++it) {
@@ -476,6 +542,107 @@ TransportReassembly::FragInfo::insert(const FragmentRange& fragRange, ReceivedDa
   return true;
 }
 
+void
+TransportReassembly::FragInfo::allocate_contiguous(ACE_UINT32 sample_size, ACE_UINT32 fragment_size)
+{
+  contiguous_.allocate(sample_size);
+  contiguous_.fragment_size_ = fragment_size;
+  received_.assign((total_frags_ + 31) / 32, 0);
+  received_count_ = 0;
+}
+
+bool
+TransportReassembly::FragInfo::has_fragment(FragmentNumber frag) const
+{
+  const size_t i = static_cast<size_t>(frag - 1);
+  return received_[i / 32] & (0x80000000u >> (i % 32));
+}
+
+bool
+TransportReassembly::FragInfo::insert_contiguous(const FragmentRange& fragRange, ReceivedDataSample& data)
+{
+  const SequenceNumber::Value sn = data.header_.sequence_.getValue();
+  const size_t fsize = contiguous_.fragment_size_;
+
+  if (fragRange.first < 1 || fragRange.first > fragRange.second
+      || fragRange.second > total_frags_ || data.fragment_size_ != fsize) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: TransportReassembly::FragInfo::insert_contiguous: "
+               "(SN: %q) fragments %q-%q of size %u don't match %u fragments of size %B\n",
+               sn, fragRange.first, fragRange.second, data.fragment_size_, total_frags_, fsize));
+    return false;
+  }
+
+  bool missing = false;
+  for (FragmentNumber frag = fragRange.first; frag <= fragRange.second && !missing; ++frag) {
+    missing = !has_fragment(frag);
+  }
+  if (!missing) {
+    VDBG((LM_DEBUG, "(%P|%t) TransportReassembly::insert_contiguous: (SN: %q) duplicate fragment range %q-%q, dropping\n", sn, fragRange.first, fragRange.second));
+    return false;
+  }
+
+  const size_t offset = static_cast<size_t>(fragRange.first - 1) * fsize;
+  const size_t end = (std::min)(static_cast<size_t>(fragRange.second) * fsize, contiguous_.data_length());
+  if (!contiguous_.overwrite(offset, data, end - offset)) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: TransportReassembly::FragInfo::insert_contiguous: "
+               "(SN: %q) fragments %q-%q have %B bytes, expected %B\n",
+               sn, fragRange.first, fragRange.second, data.data_length(), end - offset));
+    return false;
+  }
+
+  // The sample's header is the header of its first fragment, the same as
+  // for the list of fragments.  Completion requires fragment 1.
+  if (fragRange.first == 1) {
+    contiguous_.header_ = data.header_;
+  }
+
+  for (FragmentNumber frag = fragRange.first; frag <= fragRange.second; ++frag) {
+    if (!has_fragment(frag)) {
+      const size_t i = static_cast<size_t>(frag - 1);
+      received_[i / 32] |= 0x80000000u >> (i % 32);
+      ++received_count_;
+    }
+  }
+
+  VDBG((LM_DEBUG, "(%P|%t) TransportReassembly::insert_contiguous: (SN: %q) copied %q-%q at offset %B, have %u of %u\n", sn, fragRange.first, fragRange.second, offset, received_count_, total_frags_));
+  data.clear();
+  return true;
+}
+
+CORBA::ULong
+TransportReassembly::FragInfo::contiguous_gaps(CORBA::Long bitmap[], CORBA::ULong length,
+                                               CORBA::ULong& numBits) const
+{
+  // The first missing fragment is the base, skip fully received words
+  CORBA::ULong base = 0;
+  for (size_t w = 0; w < received_.size(); ++w) {
+    const ACE_UINT32 missing = ~received_[w];
+    if (missing) {
+      base = static_cast<CORBA::ULong>(w * 32 + DisjointSequence::leading_zeros(missing) + 1);
+      break;
+    }
+  }
+  if (base == 0 || base > total_frags_) {
+    return 0;
+  }
+
+  const CORBA::ULong limit = (std::min)(total_frags_, base + length * 32 - 1);
+  for (CORBA::ULong frag = base; frag <= limit; ++frag) {
+    if (has_fragment(frag)) {
+      continue;
+    }
+    CORBA::ULong high = frag;
+    while (high < limit && !has_fragment(high + 1)) {
+      ++high;
+    }
+    ACE_CDR::ULong bits_added = 0;
+    DisjointSequence::fill_bitmap_range(frag - base, high - base, bitmap, length, numBits, bits_added);
+    frag = high;
+  }
+
+  return base;
+}
+
 }
 }
 
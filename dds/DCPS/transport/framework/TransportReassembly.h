@@ -64,7 +64,11 @@ typedef std::pair<FragmentNumber, FragmentNumber> FragmentRange;
 
 class OpenDDS_Dcps_Export TransportReassembly : public virtual RcObject {
 public:
-  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300));
+  /// Samples of at most contiguous_max_size bytes whose sample size is known
+  /// from the first fragment received are reassembled directly into a single
+  /// preallocated buffer.  The default (0) disables this.
+  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300),
+                               size_t contiguous_max_size = 0);
 
   /// Called by TransportReceiveStrategy if the fragmentation header flag
   /// is set.  Returns true/false to indicate if data should be delivered to
@@ -72,7 +76,10 @@ public:
   bool reassemble(const SequenceNumber& transportSeq, bool firstFrag,
                   ReceivedDataSample& data, ACE_UINT32 total_frags = 0);
 
-  bool reassemble(const FragmentRange& fragRange, ReceivedDataSample& data, ACE_UINT32 total_frags = 0);
+  /// If sample_size is nonzero, 'data.fragment_size_' must be set and the
+  /// fragment numbers are used to locate 'data' within the sample.
+  bool reassemble(const FragmentRange& fragRange, ReceivedDataSample& data,
+                  ACE_UINT32 total_frags = 0, ACE_UINT32 sample_size = 0);
 
   /// Called by TransportReceiveStrategy to indicate that we can
   /// stop tracking partially-reassembled messages when we know the
@@ -108,7 +115,11 @@ public:
 private:
 
   bool reassemble_i(const FragmentRange& fragRange, bool firstFrag,
-                    ReceivedDataSample& data, ACE_UINT32 total_frags);
+                    ReceivedDataSample& data, ACE_UINT32 total_frags,
+                    ACE_UINT32 sample_size = 0);
+
+  bool use_contiguous(const ReceivedDataSample& data, ACE_UINT32 total_frags,
+                      ACE_UINT32 sample_size) const;
 
   // A FragSample represents a chunk of a partially-reassembled message.
   // The frag_range_ range is the range of transport sequence numbers
@@ -136,6 +147,17 @@ private:
 
     bool insert(const FragmentRange& fragRange, ReceivedDataSample& data);
 
+    /// Switch to contiguous mode: the payload is copied into a single buffer
+    /// of sample_size bytes and the fragments received are tracked in a
+    /// bitmap instead of sample_list_.
+    void allocate_contiguous(ACE_UINT32 sample_size, ACE_UINT32 fragment_size);
+    bool contiguous() const { return contiguous_.has_data(); }
+    bool insert_contiguous(const FragmentRange& fragRange, ReceivedDataSample& data);
+    bool contiguous_complete() const { return received_count_ == total_frags_; }
+    bool has_fragment(FragmentNumber frag) const;
+    CORBA::ULong contiguous_gaps(CORBA::Long bitmap[], CORBA::ULong length,
+                                 CORBA::ULong& numBits) const;
+
     bool have_first_;
     FragSampleList sample_list_;
     FragSampleListIterMap sample_finder_;
@@ -143,6 +165,10 @@ private:
     FragGapListIterMap gap_finder_;
     ACE_UINT32 total_frags_;
     MonotonicTimePoint expiration_;
+
+    ReceivedDataSample contiguous_;
+    OPENDDS_VECTOR(ACE_UINT32) received_;
+    ACE_UINT32 received_count_;
   };
 
   mutable ACE_Thread_Mutex mutex_;
@@ -162,6 +188,7 @@ private:
   CompletedMap completed_;
 
   TimeDuration timeout_;
+  size_t contiguous_max_size_;
 
   void check_expirations(const MonotonicTimePoint& now);
 };
@@ -73,7 +73,7 @@ MulticastTransport::make_datalink(const GUID_t& local_id,
                                                          session_factory,
                                                          local_peer,
                                                          ref(cfg),
-                                                         reactor_task(),
+                                                         link_reactor_task(),
                                                          active));
 
   // Join multicast group:
@@ -378,7 +378,7 @@ MulticastTransport::configure_i(const MulticastInst_rch& config)
                       this, LogAddr::ip(config->group_address().to_addr()).c_str()), false);
   }
 
-  this->create_reactor_task(config->async_send(), "MulticastTransport" + config->name());
+  this->create_reactor_task(config->async_send(), "MulticastTransport" + config->name(), true);
 
   return true;
 }
@@ -0,0 +1,78 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ACKNACKBATCH_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ACKNACKBATCH_H
+
+#include "dds/DCPS/PoolAllocator.h"
+#include "dds/Versioned_Namespace.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Writers whose "acked by all" processing has been deferred while
+ * processing received RTPS messages.
+ *
+ * A batch belongs to the receive strategy that processes the messages and is
+ * only used by the thread doing so, so it has no lock.  Batches nest: the
+ * writers are returned when the outermost batch ends.
+ */
+template <typename WriterPtr>
+class AckNackBatch {
+public:
+  typedef OPENDDS_SET(WriterPtr) WriterSet;
+
+  AckNackBatch()
+    : depth_(0)
+  {}
+
+  void begin()
+  {
+    ++depth_;
+  }
+
+  /// End a batch.  If it was the outermost batch, writers receives the
+  /// writers that were deferred during it.
+  /// Returns true if the outermost batch ended.
+  bool end(WriterSet& writers)
+  {
+    if (depth_ == 0 || --depth_ != 0) {
+      return false;
+    }
+    writers.swap(writers_);
+    writers_.clear();
+    return true;
+  }
+
+  /// Defer the writer to the end of the batch.
+  /// Returns false if no batch has begun.
+  bool defer(const WriterPtr& writer)
+  {
+    if (depth_ == 0) {
+      return false;
+    }
+    writers_.insert(writer);
+    return true;
+  }
+
+  bool active() const
+  {
+    return depth_ != 0;
+  }
+
+private:
+  size_t depth_;
+  WriterSet writers_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ACKNACKBATCH_H */
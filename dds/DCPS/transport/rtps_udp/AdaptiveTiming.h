@@ -0,0 +1,94 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ADAPTIVETIMING_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ADAPTIVETIMING_H
+
+#include <dds/DCPS/RoundTripTimeEstimator.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Heartbeat and NACK response timing for one remote reader, derived from
+ * the round-trip time of the directed HEARTBEATs that the reader reflects
+ * in its ACKNACKs.
+ *
+ * Without congestion the intervals follow the round-trip time and stay
+ * within [min, configured].  A HEARTBEAT that is still unanswered when the
+ * next one is sent is taken as a sign of loss or congestion and doubles
+ * the intervals, up to MAX_BACKOFF times, which can take them past the
+ * configured values.  The next answered HEARTBEAT clears the backoff.
+ */
+class AdaptiveTiming {
+public:
+  static const unsigned int MAX_BACKOFF = 8;
+
+  AdaptiveTiming()
+    : backoff_(1)
+  {}
+
+  /// A HEARTBEAT requiring an ACKNACK is being sent at now.
+  void heartbeat_sent(const MonotonicTimePoint& now)
+  {
+    if (!sent_.is_zero() && backoff_ < MAX_BACKOFF) {
+      backoff_ *= 2;
+    }
+    sent_ = now;
+  }
+
+  /// The ACKNACK reflecting the last HEARTBEAT was received at now.
+  void acknack_received(const MonotonicTimePoint& now)
+  {
+    if (sent_.is_zero()) {
+      return;
+    }
+    rtt_.sample(now - sent_);
+    sent_ = MonotonicTimePoint::zero_value;
+    backoff_ = 1;
+  }
+
+  /// Delay before responding to a NACK.  Within a fraction of the round
+  /// trip so that NACKs from readers on similar paths can still be combined
+  /// into one response.
+  TimeDuration nack_response_delay(const TimeDuration& configured,
+                                   const TimeDuration& min) const
+  {
+    if (!rtt_.valid()) {
+      return configured;
+    }
+    return static_cast<double>(backoff_) * std::max(min, std::min(configured, rtt_.srtt() / 2.0));
+  }
+
+  /// Interval before the next HEARTBEAT to this reader.
+  TimeDuration heartbeat_interval(const TimeDuration& configured,
+                                  const TimeDuration& min) const
+  {
+    if (!rtt_.valid()) {
+      return configured;
+    }
+    return static_cast<double>(backoff_) * std::max(min, std::min(configured, 2.0 * rtt_.rto()));
+  }
+
+  const RoundTripTimeEstimator& rtt() const { return rtt_; }
+  unsigned int backoff() const { return backoff_; }
+
+private:
+  RoundTripTimeEstimator rtt_;
+  MonotonicTimePoint sent_;
+  unsigned int backoff_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_ADAPTIVETIMING_H */
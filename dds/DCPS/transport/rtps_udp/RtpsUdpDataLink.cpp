@@ -768,7 +768,8 @@ void RtpsUdpDataLink::client_stop(const GUID_t& localId)
         }
       }
 
-      RtpsReader_rch reader = rr->second;
+      RtpsReader_rch reader;
+      reader.swap(rr->second);
       readers_.erase(rr);
       gr.release();
 
@@ -1468,15 +1469,17 @@ RtpsUdpDataLink::RtpsWriter::send_heartbeats(const MonotonicTimePoint& /*now*/)
     gather_heartbeats_i(meta_submessages);
   }
 
+  update_heartbeat_base_i();
+
   if (!preassociation_readers_.empty() || !lagging_readers_.empty()) {
     heartbeat_->schedule(fallback_.get());
     if (not_sending) {
       fallback_.advance();
     } else {
-      fallback_.set(initial_fallback_);
+      fallback_.set(heartbeat_base_);
     }
   } else {
-    fallback_.set(initial_fallback_);
+    fallback_.set(heartbeat_base_);
   }
 
   g.release();
@@ -1484,6 +1487,38 @@ RtpsUdpDataLink::RtpsWriter::send_heartbeats(const MonotonicTimePoint& /*now*/)
   link->queue_submessages(meta_submessages);
 }
 
+void
+RtpsUdpDataLink::RtpsWriter::update_heartbeat_base_i()
+{
+  if (!adaptive_timing_) {
+    return;
+  }
+
+  // Heartbeats are only useful to readers that have not acknowledged
+  // everything.  Pace them by the slowest of those readers.
+  TimeDuration interval = TimeDuration::zero_value;
+  for (SNRIS::const_iterator snris_pos = lagging_readers_.begin(), snris_limit = lagging_readers_.end();
+       snris_pos != snris_limit; ++snris_pos) {
+    for (ReaderInfoSet::const_iterator pos = snris_pos->second->readers.begin(),
+           limit = snris_pos->second->readers.end(); pos != limit; ++pos) {
+      interval = std::max(interval, (*pos)->timing_.heartbeat_interval(initial_fallback_, adaptive_timing_min_delay_));
+    }
+  }
+
+  heartbeat_base_ = interval.is_zero() ? initial_fallback_ : interval;
+}
+
+TimeDuration
+RtpsUdpDataLink::RtpsWriter::nack_response_delay_i(const ReaderInfo_rch& reader,
+                                                   const TimeDuration& configured) const
+{
+  if (!adaptive_timing_) {
+    return configured;
+  }
+
+  return reader->timing_.nack_response_delay(configured, adaptive_timing_min_delay_);
+}
+
 void
 RtpsUdpDataLink::RtpsWriter::send_nack_responses(const MonotonicTimePoint& /*now*/)
 {
@@ -1718,7 +1753,7 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
 
     } else if (writer->recvd_.contains(seq)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_data_i: %C -> %C duplicate sample\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_data_i: %C -> %C duplicate sample\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
       }
       if (Transport_debug_level > 5) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpDataLink::process_data_i(DataSubmessage) -")
@@ -1766,7 +1801,7 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
 
   } else {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_data_i: %C -> %C unknown remote writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_data_i: %C -> %C unknown remote writer\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     if (Transport_debug_level > 5) {
       ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpDataLink::process_data_i(DataSubmessage) -")
@@ -1817,7 +1852,7 @@ RtpsUdpDataLink::RtpsReader::process_gap_i(const RTPS::GapSubmessage& gap,
   const WriterInfoMap::iterator wi = remote_writers_.find(src);
   if (wi == remote_writers_.end()) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_gap_i: %C -> %C unknown remote writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_gap_i: %C -> %C unknown remote writer\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -1826,7 +1861,7 @@ RtpsUdpDataLink::RtpsReader::process_gap_i(const RTPS::GapSubmessage& gap,
 
   if (writer->recvd_.empty()) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_gap_i: %C -> %C preassociation writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_gap_i: %C -> %C preassociation writer\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -1940,7 +1975,7 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
   const WriterInfoMap::iterator wi = remote_writers_.find(src);
   if (wi == remote_writers_.end()) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i: %C -> %C unknown remote writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i: %C -> %C unknown remote writer\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -1950,8 +1985,8 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
   if (!compare_and_update_counts(heartbeat.count.value, writer->heartbeat_recvd_count_)) {
     if (transport_debug.log_dropped_messages) {
       const GUID_t dst = heartbeat.readerId == DCPS::ENTITYID_UNKNOWN ? GUID_UNKNOWN : id_;
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i: %C -> %C stale/duplicate message (%d vs %d)\n",
-        LogGuid(src).c_str(), LogGuid(dst).c_str(), heartbeat.count.value, writer->heartbeat_recvd_count_));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i: %C -> %C stale/duplicate message (%d vs %d)\n",
+        OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(dst), heartbeat.count.value, writer->heartbeat_recvd_count_));
     }
     VDBG((LM_WARNING, "(%P|%t) RtpsUdpDataLink::process_heartbeat_i "
           "WARNING Count indicates duplicate, dropping\n"));
@@ -1965,8 +2000,8 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
   bool first_ever_hb = false;
 
   if (!is_final && transport_debug.log_nonfinal_messages) {
-    ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i - %C -> %C first %q last %q count %d\n",
-      LogGuid(src).c_str(), LogGuid(id_).c_str(), hb_first.getValue(), hb_last.getValue(), heartbeat.count.value));
+    OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_i - %C -> %C first %q last %q count %d\n",
+      OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_), hb_first.getValue(), hb_last.getValue(), heartbeat.count.value));
   }
 
   // Only valid heartbeats (see spec) will be "fully" applied to writer info
@@ -2063,7 +2098,7 @@ RtpsUdpDataLink::RtpsWriter::add_reader(const ReaderInfo_rch& reader)
       return false;
     }
 
-    fallback_.set(initial_fallback_);
+    fallback_.set(heartbeat_base_);
     heartbeat_->schedule(fallback_.get());
     // Durable readers will get their heartbeat from end historic samples.
     if (!reader->durable_) {
@@ -2719,6 +2754,25 @@ RtpsUdpDataLink::disable_response_queue(bool send_immediately)
 
 }
 
+void
+RtpsUdpDataLink::begin_acknack_batch(RtpsWriterBatch& batch)
+{
+  batch.begin();
+}
+
+void
+RtpsUdpDataLink::end_acknack_batch(RtpsWriterBatch& batch)
+{
+  RtpsWriterBatch::WriterSet writers;
+  if (!batch.end(writers)) {
+    return;
+  }
+
+  for (RtpsWriterBatch::WriterSet::const_iterator pos = writers.begin(), limit = writers.end(); pos != limit; ++pos) {
+    (*pos)->process_acked_by_all();
+  }
+}
+
 void
 RtpsUdpDataLink::queue_submessages(MetaSubmessageVec& in)
 {
@@ -2839,8 +2893,8 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
           if (transport_debug.log_nonfinal_messages && !(heartbeat.smHeader.flags & RTPS::FLAG_F)) {
             const SequenceNumber hb_first = to_opendds_seqnum(heartbeat.firstSN);
             const SequenceNumber hb_last = to_opendds_seqnum(heartbeat.lastSN);
-            ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: HEARTBEAT: %C -> %C first %q last %q count %d\n",
-              LogGuid(res.src_guid_).c_str(), LogGuid(res.dst_guid_).c_str(), hb_first.getValue(), hb_last.getValue(), heartbeat.count.value));
+            OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: HEARTBEAT: %C -> %C first %q last %q count %d\n",
+              OPENDDS_ASYNC_LOG_GUID(res.src_guid_), OPENDDS_ASYNC_LOG_GUID(res.dst_guid_), hb_first.getValue(), hb_last.getValue(), heartbeat.count.value));
           }
           break;
         }
@@ -2848,8 +2902,8 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
           const AckNackSubmessage& acknack = res.sm_.acknack_sm();
           if (transport_debug.log_nonfinal_messages && !(acknack.smHeader.flags & RTPS::FLAG_F)) {
             const SequenceNumber ack = to_opendds_seqnum(acknack.readerSNState.bitmapBase);
-            ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: ACKNACK: %C -> %C base %q bits %u count %d\n",
-              LogGuid(res.src_guid_).c_str(), LogGuid(res.dst_guid_).c_str(), ack.getValue(), acknack.readerSNState.numBits, acknack.count.value));
+            OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: ACKNACK: %C -> %C base %q bits %u count %d\n",
+              OPENDDS_ASYNC_LOG_GUID(res.src_guid_), OPENDDS_ASYNC_LOG_GUID(res.dst_guid_), ack.getValue(), acknack.readerSNState.numBits, acknack.count.value));
           }
           break;
         }
@@ -2862,8 +2916,8 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
           // All NackFrag messages are technically 'non-final' since they are only used to negatively acknowledge fragments and expect a response
           if (transport_debug.log_nonfinal_messages) {
             const SequenceNumber seq = to_opendds_seqnum(nackfrag.writerSN);
-            ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: NACKFRAG: %C -> %C seq %q base %u bits %u\n",
-              LogGuid(res.src_guid_).c_str(), LogGuid(res.dst_guid_).c_str(), seq.getValue(), nackfrag.fragmentNumberState.bitmapBase.value, nackfrag.fragmentNumberState.numBits));
+            OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::bundle_and_send_submessages: NACKFRAG: %C -> %C seq %q base %u bits %u\n",
+              OPENDDS_ASYNC_LOG_GUID(res.src_guid_), OPENDDS_ASYNC_LOG_GUID(res.dst_guid_), seq.getValue(), nackfrag.fragmentNumberState.bitmapBase.value, nackfrag.fragmentNumberState.numBits));
           }
           break;
         }
@@ -3025,7 +3079,7 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i(const RTPS::HeartBeatFragS
   if (wi == remote_writers_.end()) {
     // we may not be associated yet, even if the writer thinks we are
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i: %C -> %C unknown remote writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i: %C -> %C unknown remote writer\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -3034,7 +3088,7 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i(const RTPS::HeartBeatFragS
 
   if (!compare_and_update_counts(hb_frag.count.value, writer->hb_frag_recvd_count_)) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i: %C -> %C stale/duplicate message\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i: %C -> %C stale/duplicate message\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     VDBG((LM_WARNING, "(%P|%t) RtpsUdpDataLink::process_heartbeat_frag_i "
           "WARNING Count indicates duplicate, dropping\n"));
@@ -3063,7 +3117,8 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i(const RTPS::HeartBeatFragS
 void
 RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
                           const GuidPrefix_t& src_prefix,
-                          const NetworkAddress& remote_addr)
+                          const NetworkAddress& remote_addr,
+                          RtpsWriterBatch& batch)
 {
   // local side is DW
   const GUID_t local = make_id(local_prefix_, acknack.writerId); // can't be ENTITYID_UNKNOWN
@@ -3095,7 +3150,27 @@ RtpsUdpDataLink::received(const RTPS::AckNackSubmessage& acknack,
     callbacks[i]->reader_exists(remote, local);
   }
 
-  datawriter_dispatch(acknack, src_prefix, &RtpsWriter::process_acknack);
+  const RtpsWriter_rch writer = dispatch_writer(local, remote);
+  if (!writer) {
+    return;
+  }
+  MetaSubmessageVec meta_submessages;
+  writer->process_acknack(acknack, remote, meta_submessages, batch.defer(writer));
+  queue_submessages(meta_submessages);
+}
+
+RtpsUdpDataLink::RtpsWriter_rch
+RtpsUdpDataLink::dispatch_writer(const GUID_t& local, const GUID_t& src)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, writers_lock_, RtpsWriter_rch());
+  const RtpsWriterMap::iterator rw = writers_.find(local);
+  if (rw == writers_.end()) {
+    if (transport_debug.log_dropped_messages) {
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datawriter_dispatch - %C -> %C unknown local writer\n", OPENDDS_ASYNC_LOG_GUID(local), OPENDDS_ASYNC_LOG_GUID(src)));
+    }
+    return RtpsWriter_rch();
+  }
+  return rw->second;
 }
 
 void
@@ -3157,7 +3232,8 @@ RtpsUdpDataLink::RtpsWriter::gather_gaps_i(const ReaderInfo_rch& reader,
 void
 RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& acknack,
                                              const GUID_t& src,
-                                             MetaSubmessageVec&)
+                                             MetaSubmessageVec&,
+                                             bool acked_by_all_deferred)
 {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
 
@@ -3181,7 +3257,7 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
   ReaderInfoMap::iterator ri = remote_readers_.find(src);
   if (ri == remote_readers_.end()) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C unknown remote reader\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C unknown remote reader\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     VDBG((LM_WARNING, "(%P|%t) RtpsUdpDataLink::received(ACKNACK) "
       "WARNING ReaderInfo not found\n"));
@@ -3193,10 +3269,10 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
   const SequenceNumber sn_received_by_reader = ack.previous();
   if (sn_received_by_reader > max_sn) {
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} "
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} "
                  "RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C "
                  "Received sequence number (%q) > expected max sequence number (%q)\n",
-                 LogGuid(src).c_str(), LogGuid(id_).c_str(), sn_received_by_reader.getValue(), max_sn.getValue()));
+                 OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_), sn_received_by_reader.getValue(), max_sn.getValue()));
     }
     return;
   }
@@ -3210,7 +3286,7 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
     if (!compare_and_update_counts(acknack.count.value, reader->acknack_recvd_count_) &&
         (!reader->reflects_heartbeat_count() || acknack.count.value != 0 || reader->acknack_recvd_count_ != 0)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C stale/duplicate message\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C stale/duplicate message\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
       }
       VDBG((LM_WARNING, "(%P|%t) RtpsUdpDataLink::received(ACKNACK) "
             "WARNING Count indicates duplicate, dropping\n"));
@@ -3220,14 +3296,16 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
     if (reader->reflects_heartbeat_count()) {
       if (acknack.count.value < reader->required_acknack_count_) {
         if (transport_debug.log_dropped_messages) {
-          ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C stale message (reflect %d < %d)\n", LogGuid(src).c_str(), LogGuid(id_).c_str(), acknack.count.value, reader->required_acknack_count_));
+          OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C stale message (reflect %d < %d)\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_), acknack.count.value, reader->required_acknack_count_));
         }
         dont_schedule_nack_response = true;
+      } else if (adaptive_timing_ && acknack.count.value == reader->required_acknack_count_) {
+        reader->timing_.acknack_received(MonotonicTimePoint::now());
       }
     }
   }
 
-  fallback_.set(initial_fallback_);
+  fallback_.set(heartbeat_base_);
 
   const bool is_final = acknack.smHeader.flags & RTPS::FLAG_F;
   const bool is_postassociation = count_is_not_zero && (is_final || bitmapNonEmpty(acknack.readerSNState) || ack != 1);
@@ -3249,8 +3327,8 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
   OPENDDS_MAP(SequenceNumber, TransportQueueElement*) pendingCallbacks;
 
   if (!is_final && transport_debug.log_nonfinal_messages) {
-    ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C base %q bits %u count %d\n",
-      LogGuid(src).c_str(), LogGuid(id_).c_str(), ack.getValue(), acknack.readerSNState.numBits, acknack.count.value));
+    OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsWriter::process_acknack: %C -> %C base %q bits %u count %d\n",
+      OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_), ack.getValue(), acknack.readerSNState.numBits, acknack.count.value));
   }
 
   // Process the ack.
@@ -3362,7 +3440,9 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
   }
 
   TqeSet to_deliver;
-  acked_by_all_helper_i(to_deliver);
+  if (!acked_by_all_deferred) {
+    acked_by_all_helper_i(to_deliver);
+  }
 
 #if OPENDDS_CONFIG_SECURITY
   if (is_pvs_writer_ &&
@@ -3387,7 +3467,7 @@ RtpsUdpDataLink::RtpsWriter::process_acknack(const RTPS::AckNackSubmessage& ackn
 
   if (!dont_schedule_nack_response && schedule_nack_response) {
     RtpsUdpTransport_rch tport = link->transport();
-    nack_response_->schedule(tport ? tport->core().nak_response_delay() : TimeDuration(0, RtpsUdpInst::DEFAULT_NAK_RESPONSE_DELAY_USEC));
+    nack_response_->schedule(nack_response_delay_i(reader, tport ? tport->core().nak_response_delay() : TimeDuration(0, RtpsUdpInst::DEFAULT_NAK_RESPONSE_DELAY_USEC)));
   }
 
   TransportClient_rch client = client_.lock();
@@ -3444,8 +3524,8 @@ void RtpsUdpDataLink::RtpsWriter::process_nackfrag(const RTPS::NackFragSubmessag
   const ReaderInfoMap::iterator ri = remote_readers_.find(src);
   if (ri == remote_readers_.end()) {
     if (Transport_debug_level > 5 || transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C unknown remote reader\n",
-        LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C unknown remote reader\n",
+        OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -3454,8 +3534,8 @@ void RtpsUdpDataLink::RtpsWriter::process_nackfrag(const RTPS::NackFragSubmessag
 
   if (!compare_and_update_counts(nackfrag.count.value, reader->nackfrag_recvd_count_)) {
     if (Transport_debug_level > 5 || transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C stale/duplicate message\n",
-        LogGuid(src).c_str(), LogGuid(id_).c_str()));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C stale/duplicate message\n",
+        OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_)));
     }
     return;
   }
@@ -3464,8 +3544,8 @@ void RtpsUdpDataLink::RtpsWriter::process_nackfrag(const RTPS::NackFragSubmessag
 
   // All NackFrag messages are technically 'non-final' since they are only used to negatively acknowledge fragments and expect a response
   if (transport_debug.log_nonfinal_messages) {
-    ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C seq %q base %u bits %u\n",
-      LogGuid(src).c_str(), LogGuid(id_).c_str(), seq.getValue(), nackfrag.fragmentNumberState.bitmapBase.value, nackfrag.fragmentNumberState.numBits));
+    OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_nonfinal_messages} RtpsUdpDataLink::RtpsWriter::process_nackfrag: %C -> %C seq %q base %u bits %u\n",
+      OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(id_), seq.getValue(), nackfrag.fragmentNumberState.bitmapBase.value, nackfrag.fragmentNumberState.numBits));
   }
 
   reader->requested_frags_[seq][nackfrag.fragmentNumberState.bitmapBase.value] = nackfrag.fragmentNumberState;
@@ -3744,6 +3824,9 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
       meta_submessage.sm_.heartbeat_sm().smHeader.flags |= RTPS::OPENDDS_FLAG_R;
       gather_directed_heartbeat_i(proxy, meta_submessages, meta_submessage, reader);
       reader->required_acknack_count_ = heartbeat_count_;
+      if (adaptive_timing_) {
+        reader->timing_.heartbeat_sent(MonotonicTimePoint::now());
+      }
       meta_submessage.sm_.heartbeat_sm().smHeader.flags &= ~RTPS::OPENDDS_FLAG_R;
     } else {
       gather_directed_heartbeat_i(proxy, meta_submessages, meta_submessage, reader);
@@ -4468,7 +4551,10 @@ RtpsUdpDataLink::RtpsWriter::RtpsWriter(const TransportClient_rch& client, const
  , heartbeat_(make_rch<SporadicEvent>(link->event_dispatcher(), make_rch<PmfNowEvent<RtpsWriter> >(rchandle_from(this), &RtpsWriter::send_heartbeats)))
  , nack_response_(make_rch<SporadicEvent>(link->event_dispatcher(), make_rch<PmfNowEvent<RtpsWriter> >(rchandle_from(this), &RtpsWriter::send_nack_responses)))
  , initial_fallback_(link->config()->heartbeat_period())
+ , heartbeat_base_(initial_fallback_)
  , fallback_(initial_fallback_)
+ , adaptive_timing_(link->config()->adaptive_timing())
+ , adaptive_timing_min_delay_(link->config()->adaptive_timing_min_delay())
 {
   send_buff_->bind(link->send_strategy().in());
 }
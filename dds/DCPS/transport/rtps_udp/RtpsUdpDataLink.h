@@ -7,6 +7,8 @@
 #define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_RTPSUDPDATALINK_H
 
 #include "Rtps_Udp_Export.h"
+#include "AckNackBatch.h"
+#include "AdaptiveTiming.h"
 #include "BundlingCacheKey.h"
 #include "LocatorCacheKey.h"
 #include "RtpsCustomizedElement.h"
@@ -22,6 +24,7 @@
 #include <dds/DCPS/transport/framework/TransportStatistics.h>
 
 #include <dds/DCPS/AddressCache.h>
+#include <dds/DCPS/AsyncLogger.h>
 #include <dds/DCPS/DataBlockLockPool.h>
 #include <dds/DCPS/DataSampleElement.h>
 #include <dds/DCPS/DiscoveryListener.h>
@@ -56,6 +59,8 @@
 #include <ace/SOCK_Dgram.h>
 #include <ace/SOCK_Dgram_Mcast.h>
 
+#include <iterator>
+
 #ifdef ACE_HAS_CPP11
 #  include <functional>
 #endif
@@ -145,10 +150,6 @@ public:
                 bool directed,
                 const NetworkAddress& remote_addr);
 
-  void received(const RTPS::AckNackSubmessage& acknack,
-                const GuidPrefix_t& src_prefix,
-                const NetworkAddress& remote_addr);
-
   void received(const RTPS::NackFragSubmessage& nackfrag,
                 const GuidPrefix_t& src_prefix,
                 const NetworkAddress& remote_addr);
@@ -351,6 +352,9 @@ private:
     const bool durable_;
     const ACE_CDR::ULong participant_flags_;
     ACE_CDR::Long required_acknack_count_;
+    /// Started when the HEARTBEAT that sets required_acknack_count_ is
+    /// gathered, the reflected ACKNACK provides a round-trip time sample.
+    AdaptiveTiming timing_;
     OPENDDS_MAP(SequenceNumber, TransportQueueElement*) durable_data_;
     MonotonicTimePoint durable_timestamp_;
     const SequenceNumber start_sn_;
@@ -464,7 +468,16 @@ private:
     RcHandle<SporadicEvent> nack_response_;
 
     const TimeDuration initial_fallback_;
+    /// First heartbeat interval after progress is made.  Equal to
+    /// initial_fallback_ unless adaptive timing is enabled.
+    TimeDuration heartbeat_base_;
     FibonacciSequence<TimeDuration> fallback_;
+    const bool adaptive_timing_;
+    const TimeDuration adaptive_timing_min_delay_;
+
+    void update_heartbeat_base_i();
+    TimeDuration nack_response_delay_i(const ReaderInfo_rch& reader,
+                                       const TimeDuration& configured) const;
 
     void send_heartbeats(const MonotonicTimePoint& now);
     void send_nack_responses(const MonotonicTimePoint& now);
@@ -554,9 +567,12 @@ private:
                                                           MetaSubmessageVec& meta_submessages,
                                                           bool& deliver_after_send);
 
+    /// If acked_by_all_deferred is true, the caller calls
+    /// process_acked_by_all() later instead.
     void process_acknack(const RTPS::AckNackSubmessage& acknack,
                          const GUID_t& src,
-                         MetaSubmessageVec& meta_submessages);
+                         MetaSubmessageVec& meta_submessages,
+                         bool acked_by_all_deferred);
     void process_nackfrag(const RTPS::NackFragSubmessage& nackfrag,
                           const GUID_t& src,
                           MetaSubmessageVec& meta_submessages);
@@ -583,7 +599,25 @@ private:
 #endif
   RtpsWriterMap writers_;
 
+public:
+  /// Writers with deferred ACKNACK processing.  The batch is owned by the
+  /// receive strategy, which serializes the processing of received messages.
+  typedef AckNackBatch<RtpsWriter_rch> RtpsWriterBatch;
+
+  /// ACKNACKs received between these calls (typically the submessages of one
+  /// RTPS message) are processed as a batch.  Each local writer applies the
+  /// per-reader updates as the ACKNACKs arrive but computes what has been
+  /// acknowledged by all readers, and delivers the corresponding samples, only
+  /// once when the batch ends.
+  void begin_acknack_batch(RtpsWriterBatch& batch);
+  void end_acknack_batch(RtpsWriterBatch& batch);
 
+  void received(const RTPS::AckNackSubmessage& acknack,
+                const GuidPrefix_t& src_prefix,
+                const NetworkAddress& remote_addr,
+                RtpsWriterBatch& batch);
+
+private:
   // RTPS reliability support for local readers:
 
   struct WriterInfo : RcObject {
@@ -786,6 +820,10 @@ private:
                                const DisjointSequence& fragments,
                                SequenceNumber& lastFragment);
 
+  /// The local writer that a submessage from src is dispatched to, nil if
+  /// there is none.
+  RtpsWriter_rch dispatch_writer(const GUID_t& local, const GUID_t& src);
+
   template<typename T, typename FN>
   void datawriter_dispatch(const T& submessage, const GuidPrefix_t& src_prefix,
                            const FN& func)
@@ -793,23 +831,12 @@ private:
     const GUID_t local = make_id(local_prefix_, submessage.writerId);
     const GUID_t src = make_id(src_prefix, submessage.readerId);
 
-    OPENDDS_VECTOR(RtpsWriter_rch) to_call;
-    {
-      ACE_GUARD(ACE_Thread_Mutex, g, writers_lock_);
-      const RtpsWriterMap::iterator rw = writers_.find(local);
-      if (rw == writers_.end()) {
-        if (transport_debug.log_dropped_messages) {
-          ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datawriter_dispatch - %C -> %C unknown local writer\n", LogGuid(local).c_str(), LogGuid(src).c_str()));
-        }
-        return;
-      }
-      to_call.push_back(rw->second);
+    const RtpsWriter_rch writer = dispatch_writer(local, src);
+    if (!writer) {
+      return;
     }
     MetaSubmessageVec meta_submessages;
-    for (OPENDDS_VECTOR(RtpsWriter_rch)::const_iterator it = to_call.begin(); it < to_call.end(); ++it) {
-      RtpsWriter& writer = **it;
-      (writer.*func)(submessage, src, meta_submessages);
-    }
+    ((*writer).*func)(submessage, src, meta_submessages);
     queue_submessages(meta_submessages);
   }
 
@@ -827,12 +854,14 @@ private:
       ACE_GUARD(ACE_Thread_Mutex, g, readers_lock_);
       if (local.entityId == ENTITYID_UNKNOWN) {
         typedef std::pair<RtpsReaderMultiMap::iterator, RtpsReaderMultiMap::iterator> RRMM_IterRange;
-        for (RRMM_IterRange iters = readers_of_writer_.equal_range(src); iters.first != iters.second; ++iters.first) {
-          to_call.push_back(iters.first->second);
+        const RRMM_IterRange iters = readers_of_writer_.equal_range(src);
+        to_call.reserve(std::distance(iters.first, iters.second));
+        for (RtpsReaderMultiMap::iterator it = iters.first; it != iters.second; ++it) {
+          to_call.push_back(it->second);
         }
         if (to_call.empty()) {
           if (transport_debug.log_dropped_messages) {
-            ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datawreader_dispatch - %C -> X no local readers\n", LogGuid(src).c_str()));
+            OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datawreader_dispatch - %C -> X no local readers\n", OPENDDS_ASYNC_LOG_GUID(src)));
           }
           return;
         }
@@ -840,7 +869,7 @@ private:
         const RtpsReaderMap::iterator rr = readers_.find(local);
         if (rr == readers_.end()) {
           if (transport_debug.log_dropped_messages) {
-            ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datareader_dispatch - %C -> %C unknown local reader\n", LogGuid(src).c_str(), LogGuid(local).c_str()));
+            OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::datareader_dispatch - %C -> %C unknown local reader\n", OPENDDS_ASYNC_LOG_GUID(src), OPENDDS_ASYNC_LOG_GUID(local)));
           }
           return;
         }
@@ -41,6 +41,11 @@ RtpsUdpInst::RtpsUdpInst(const OPENDDS_STRING& name,
   , receive_address_duration_(*this, &RtpsUdpInst::receive_address_duration, &RtpsUdpInst::receive_address_duration)
   , responsive_mode_(*this, &RtpsUdpInst::responsive_mode, &RtpsUdpInst::responsive_mode)
   , send_delay_(*this, &RtpsUdpInst::send_delay, &RtpsUdpInst::send_delay)
+  , adaptive_timing_(*this, &RtpsUdpInst::adaptive_timing, &RtpsUdpInst::adaptive_timing)
+  , adaptive_timing_min_delay_(*this, &RtpsUdpInst::adaptive_timing_min_delay, &RtpsUdpInst::adaptive_timing_min_delay)
+  , contiguous_reassembly_max_size_(*this, &RtpsUdpInst::contiguous_reassembly_max_size, &RtpsUdpInst::contiguous_reassembly_max_size)
+  , busy_poll_(*this, &RtpsUdpInst::busy_poll, &RtpsUdpInst::busy_poll)
+  , busy_poll_usec_(*this, &RtpsUdpInst::busy_poll_usec, &RtpsUdpInst::busy_poll_usec)
   , opendds_discovery_guid_(GUID_UNKNOWN)
   , actual_local_address_(NetworkAddress::default_IPV4)
 #ifdef ACE_HAS_IPV6
@@ -234,6 +239,70 @@ RtpsUdpInst::send_delay() const
                                                     ConfigStoreImpl::Format_IntegerMilliseconds);
 }
 
+void
+RtpsUdpInst::adaptive_timing(bool at)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("ADAPTIVE_TIMING").c_str(), at);
+}
+
+bool
+RtpsUdpInst::adaptive_timing() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("ADAPTIVE_TIMING").c_str(), false);
+}
+
+void
+RtpsUdpInst::adaptive_timing_min_delay(const TimeDuration& atmd)
+{
+  TheServiceParticipant->config_store()->set(config_key("ADAPTIVE_TIMING_MIN_DELAY").c_str(),
+                                             atmd,
+                                             ConfigStoreImpl::Format_IntegerMilliseconds);
+}
+
+TimeDuration
+RtpsUdpInst::adaptive_timing_min_delay() const
+{
+  return TheServiceParticipant->config_store()->get(config_key("ADAPTIVE_TIMING_MIN_DELAY").c_str(),
+                                                    TimeDuration(0, 1000),
+                                                    ConfigStoreImpl::Format_IntegerMilliseconds);
+}
+
+void
+RtpsUdpInst::contiguous_reassembly_max_size(size_t crms)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_SIZE").c_str(), static_cast<DDS::UInt32>(crms));
+}
+
+size_t
+RtpsUdpInst::contiguous_reassembly_max_size() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_SIZE").c_str(), 0);
+}
+
+void
+RtpsUdpInst::busy_poll(bool bp)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("BUSY_POLL").c_str(), bp);
+}
+
+bool
+RtpsUdpInst::busy_poll() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("BUSY_POLL").c_str(), false);
+}
+
+void
+RtpsUdpInst::busy_poll_usec(ACE_UINT32 bpu)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("BUSY_POLL_USEC").c_str(), bpu);
+}
+
+ACE_UINT32
+RtpsUdpInst::busy_poll_usec() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("BUSY_POLL_USEC").c_str(), 0);
+}
+
 RTPS::PortMode RtpsUdpInst::port_mode() const
 {
   return get_port_mode(config_key("PORT_MODE"), RTPS::PortMode_System);
@@ -643,6 +712,11 @@ RtpsUdpInst::dump_to_str(DDS::DomainId_t domain) const
   ret += formatNameForDump("nak_response_delay") + nak_response_delay().str() + '\n';
   ret += formatNameForDump("heartbeat_period") + heartbeat_period().str() + '\n';
   ret += formatNameForDump("responsive_mode") + (responsive_mode() ? "true" : "false") + '\n';
+  ret += formatNameForDump("adaptive_timing") + (adaptive_timing() ? "true" : "false") + '\n';
+  ret += formatNameForDump("adaptive_timing_min_delay") + adaptive_timing_min_delay().str() + '\n';
+  ret += formatNameForDump("contiguous_reassembly_max_size") + to_dds_string(unsigned(contiguous_reassembly_max_size())) + '\n';
+  ret += formatNameForDump("busy_poll") + (busy_poll() ? "true" : "false") + '\n';
+  ret += formatNameForDump("busy_poll_usec") + to_dds_string(unsigned(busy_poll_usec())) + '\n';
   ret += formatNameForDump("multicast_group_address") + LogAddr(multicast_group_address(domain)).str() + '\n';
   ret += formatNameForDump("local_address") + LogAddr(local_address()).str() + '\n';
   ret += formatNameForDump("advertised_address") + LogAddr(advertised_address()).str() + '\n';
@@ -85,6 +85,35 @@ public:
   void send_delay(const TimeDuration& sd);
   TimeDuration send_delay() const;
 
+  /// Derive heartbeat intervals and NACK response delays from the measured
+  /// round-trip time to each remote reader instead of using
+  /// heartbeat_period and nak_response_delay directly.
+  ConfigValue<RtpsUdpInst, bool> adaptive_timing_;
+  void adaptive_timing(bool at);
+  bool adaptive_timing() const;
+
+  ConfigValueRef<RtpsUdpInst, TimeDuration> adaptive_timing_min_delay_;
+  void adaptive_timing_min_delay(const TimeDuration& atmd);
+  TimeDuration adaptive_timing_min_delay() const;
+
+  /// Fragmented samples up to this size (in bytes) are reassembled into a
+  /// single buffer allocated when the first fragment arrives.  0 disables.
+  ConfigValue<RtpsUdpInst, size_t> contiguous_reassembly_max_size_;
+  void contiguous_reassembly_max_size(size_t crms);
+  size_t contiguous_reassembly_max_size() const;
+
+  /// Receive on a dedicated thread that polls the sockets without blocking
+  /// instead of waiting in the reactor.  The thread keeps a core busy.
+  ConfigValue<RtpsUdpInst, bool> busy_poll_;
+  void busy_poll(bool bp);
+  bool busy_poll() const;
+
+  /// SO_BUSY_POLL (in microseconds) for the unicast sockets when busy_poll
+  /// is enabled.  0 leaves the socket option alone.
+  ConfigValue<RtpsUdpInst, ACE_UINT32> busy_poll_usec_;
+  void busy_poll_usec(ACE_UINT32 bpu);
+  ACE_UINT32 busy_poll_usec() const;
+
   /// Diagnostic aid.
   virtual OPENDDS_STRING dump_to_str(DDS::DomainId_t domain) const;
 
@@ -13,6 +13,7 @@
 #include "dds/DCPS/RTPS/MessageUtils.h"
 #include "dds/DCPS/RTPS/MessageTypes.h"
 
+#include <dds/DCPS/AsyncLogger.h>
 #include <dds/DCPS/GuidUtils.h>
 #include <dds/DCPS/LogAddr.h>
 #include <dds/DCPS/Util.h>
@@ -21,6 +22,7 @@
 
 #include <dds/OpenDDSConfigWrapper.h>
 
+#include "ace/ACE.h"
 #include "ace/Reactor.h"
 
 #include <algorithm>
@@ -41,9 +43,15 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
   , recvd_sample_(0)
   , fragment_size_(0)
   , total_frags_(0)
-  , reassembly_(link->config()->fragment_reassembly_timeout())
+  , sample_size_(0)
+  , reassembly_(link->config()->fragment_reassembly_timeout(),
+                link->config()->contiguous_reassembly_max_size())
   , receiver_(local_prefix)
   , thread_status_manager_(thread_status_manager)
+  , busy_poll_(false)
+  , busy_poll_stop_(false)
+  , recv_flags_(0)
+  , would_block_(false)
 #if OPENDDS_CONFIG_SECURITY
   , secure_sample_()
   , encoded_rtps_(false)
@@ -80,8 +88,16 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
 int
 RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
-  ThreadStatusManager::Event ev(thread_status_manager_);
+  if (busy_poll_) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, input_lock_, -1);
+    return handle_input_i(fd);
+  }
+  return handle_input_i(fd);
+}
 
+int
+RtpsUdpReceiveStrategy::handle_input_i(ACE_HANDLE fd)
+{
   // Since BUFFER_COUNT is 1, the index will always be 0
   const size_t INDEX = 0;
 
@@ -109,6 +125,14 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
                                           fd,
                                           stop);
 
+  if (bytes_remaining < 0 && recv_flags_ && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    // Nothing to read; not an event for the thread status.
+    would_block_ = true;
+    return 0;
+  }
+
+  ThreadStatusManager::Event ev(thread_status_manager_);
+
   if (stop) {
     return 0;
   }
@@ -226,10 +250,11 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
                                              DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
 #endif
                                              RtpsUdpTransport& tport,
-                                             bool& stop)
+                                             bool& stop,
+                                             int flags)
 {
   ACE_INET_Addr local_address;
-  const ssize_t ret = socket.recv(iov, n, remote_address, 0
+  const ssize_t ret = socket.recv(iov, n, remote_address, flags
 #if defined(ACE_RECVPKTINFO) || defined(ACE_RECVPKTINFO6)
                                   , &local_address
 #endif
@@ -344,7 +369,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
 #ifdef ACE_LACKS_SENDMSG
   ACE_UNUSED_ARG(stop);
   char buffer[0x10000];
-  ssize_t scatter = socket.recv(buffer, sizeof buffer, remote_address);
+  ssize_t scatter = socket.recv(buffer, sizeof buffer, remote_address, recv_flags_);
   char* iter = buffer;
   for (int i = 0; scatter > 0 && i < n; ++i) {
     const size_t chunk = std::min(static_cast<size_t>(iov[i].iov_len), // int on LynxOS
@@ -359,7 +384,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
 #if OPENDDS_CONFIG_SECURITY
                                            link_->get_ice_agent(), link_->get_ice_endpoint(),
 #endif
-                                           *link_->transport(), stop);
+                                           *link_->transport(), stop, recv_flags_);
 #endif
   remote_address_ = remote_address;
 
@@ -385,16 +410,24 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     }
 
     const unsigned int encLen = static_cast<unsigned int>(ret);
-    DDS::OctetSeq encoded(encLen);
-    encoded.length(encLen);
-    unsigned char* const encBuf = encoded.get_buffer();
+    DDS::OctetSeq encoded;
     size_t copied = 0;
-    for (int i = 0; i < n && copied < encLen; ++i) {
-      const size_t chunk = std::min(static_cast<size_t>(iov[i].iov_len),
-                                    static_cast<size_t>(encLen - copied));
-      std::memcpy(encBuf + copied, iov[i].iov_base, chunk);
-      copied += chunk;
+    if (n > 0 && iov[0].iov_len >= encLen) {
+      // The whole datagram landed in the first buffer, let the plugin read
+      // it from there.  The plaintext is only copied back after decoding.
+      encoded.replace(encLen, encLen, reinterpret_cast<CORBA::Octet*>(static_cast<char*>(iov[0].iov_base)), false);
+      copied = encLen;
+    } else {
+      encoded.length(encLen);
+      unsigned char* const buf = encoded.get_buffer();
+      for (int i = 0; i < n && copied < encLen; ++i) {
+        const size_t chunk = std::min(static_cast<size_t>(iov[i].iov_len),
+                                      static_cast<size_t>(encLen - copied));
+        std::memcpy(buf + copied, iov[i].iov_base, chunk);
+        copied += chunk;
+      }
     }
+    const unsigned char* const encBuf = encoded.get_buffer();
 
     if (copied != encLen) {
       return recv_err("received bytes didn't fit in iovec array", remote_address, peer, stop);
@@ -412,7 +445,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
       link_->handle_registry()->get_remote_participant_crypto_handle(peer);
     if (sender == DDS::HANDLE_NIL) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::receive_bytes - decode error from %C\n", LogGuid(peer).c_str()));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::receive_bytes - decode error from %C\n", OPENDDS_ASYNC_LOG_GUID(peer)));
       }
       if (security_debug.encdec_warn) {
         ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) {encdec_warn} RtpsUdpReceiveStrategy::receive_bytes: ")
@@ -427,7 +460,7 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     SecurityException ex = {"", 0, 0};
     if (!crypto->decode_rtps_message(plain, encoded, receiver, sender, ex)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::receive_bytes - decode error from %C\n", LogGuid(peer).c_str()));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::receive_bytes - decode error from %C\n", OPENDDS_ASYNC_LOG_GUID(peer)));
       }
       if (security_debug.encdec_warn) {
         ACE_ERROR((LM_WARNING, "(%P|%t) {encdec_warn} decode_rtps_message SecurityException [%d.%d]: %C\n",
@@ -513,7 +546,7 @@ RtpsUdpReceiveStrategy::deliver_sample(ReceivedDataSample& sample,
                   sizeof(GuidPrefix_t))) {
     // Not our message, we may be on multicast listening to all the others.
     if (transport_debug.log_dropped_messages) {
-      ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample - not destination\n"));
+      OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample - not destination\n"));
     }
     return;
   }
@@ -565,7 +598,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
     const DataSubmessage& data = submessage.data_sm();
     if (!check_encoded(data.writerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -573,7 +606,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
 #if OPENDDS_CONFIG_SECURITY
     if (!decode_payload(sample, data)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -671,7 +704,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
   case GAP:
     if (!check_encoded(submessage.gap_sm().writerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -681,7 +714,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
   case HEARTBEAT:
     if (!check_encoded(submessage.heartbeat_sm().writerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -698,17 +731,17 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
   case ACKNACK:
     if (!check_encoded(submessage.acknack_sm().readerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
-    link_->received(submessage.acknack_sm(), receiver_.source_guid_prefix_, remote_addr);
+    link_->received(submessage.acknack_sm(), receiver_.source_guid_prefix_, remote_addr, acknack_batch_);
     break;
 
   case HEARTBEAT_FRAG:
     if (!check_encoded(submessage.hb_frag_sm().writerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -718,7 +751,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
   case NACK_FRAG:
     if (!check_encoded(submessage.nack_frag_sm().readerId)) {
       if (transport_debug.log_dropped_messages) {
-        ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
+        OPENDDS_ASYNC_LOG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpReceiveStrategy::deliver_sample_i - decode error\n"));
       }
       break;
     }
@@ -763,7 +796,7 @@ RtpsUdpReceiveStrategy::deliver_from_secure(const RTPS::Submessage& submessage,
     link_->local_crypto_handle() :
     link_->handle_registry()->get_remote_participant_crypto_handle(peer);
 
-  DDS::OctetSeq encoded_submsg, plain_submsg;
+  DDS::OctetSeq encoded_submsg;
   if (!sec_submsg_to_octets(encoded_submsg, submessage)) {
     if (security_debug.encdec_warn) {
       ACE_ERROR((LM_WARNING, ACE_TEXT("(%P|%t) {encdec_warn} RtpsUdpReceiveStrategy: ")
@@ -772,6 +805,15 @@ RtpsUdpReceiveStrategy::deliver_from_secure(const RTPS::Submessage& submessage,
     }
     return;
   }
+
+  // Let the plugin decode directly into the block that is delivered.  The
+  // plaintext is no longer than the encoded submessage, but the builtin
+  // plugin's cipher may write up to one key length past it before trimming.
+  static const size_t decode_reserve = 32;
+  ACE_Message_Block mb(encoded_submsg.length() + decode_reserve);
+  DDS::OctetSeq plain_submsg;
+  plain_submsg.replace(static_cast<CORBA::ULong>(mb.size()), 0,
+                       reinterpret_cast<CORBA::Octet*>(mb.wr_ptr()), false);
   secure_prefix_.smHeader.submessageId = SUBMESSAGE_NONE;
   secure_sample_ = ReceivedDataSample();
 
@@ -826,8 +868,16 @@ RtpsUdpReceiveStrategy::deliver_from_secure(const RTPS::Submessage& submessage,
     return;
   }
 
-  ACE_Message_Block mb(plain_submsg.length());
-  mb.copy(reinterpret_cast<const char*>(plain_submsg.get_buffer()), mb.size());
+  const CORBA::Octet* const plain = plain_submsg.get_buffer();
+  if (plain == reinterpret_cast<const CORBA::Octet*>(mb.wr_ptr())) {
+    mb.wr_ptr(plain_submsg.length());
+  } else {
+    // The plugin replaced the buffer.
+    if (mb.size(plain_submsg.length()) != 0) {
+      return;
+    }
+    mb.copy(reinterpret_cast<const char*>(plain), plain_submsg.length());
+  }
 
   if (Transport_debug_level > 5) {
     ACE_HEX_DUMP((LM_DEBUG, mb.rd_ptr(), mb.length(),
@@ -882,7 +932,9 @@ RtpsUdpReceiveStrategy::sec_submsg_to_octets(DDS::OctetSeq& encoded,
   }
   serialized_size(encoding, size, postfix);
 
-  ACE_Message_Block mb(size);
+  // Serialize straight into the sequence handed to the plugin.
+  encoded.length(static_cast<unsigned int>(size));
+  ACE_Message_Block mb(reinterpret_cast<const char*>(encoded.get_buffer()), size);
   Serializer ser(&mb, encoding);
   if (!(ser << secure_prefix_)) {
     return false;
@@ -911,7 +963,6 @@ RtpsUdpReceiveStrategy::sec_submsg_to_octets(DDS::OctetSeq& encoded,
   }
 
   encoded.length(static_cast<unsigned int>(mb.length()));
-  std::memcpy(encoded.get_buffer(), mb.rd_ptr(), mb.length());
   secure_submessages_.resize(0);
 
   return true;
@@ -988,6 +1039,21 @@ bool RtpsUdpReceiveStrategy::decode_payload(ReceivedDataSample& sample,
 int
 RtpsUdpReceiveStrategy::start_i()
 {
+  RtpsUdpInst_rch cfg = link_->config();
+  busy_poll_ = cfg && cfg->busy_poll();
+  if (busy_poll_) {
+    const ACE_UINT32 usec = cfg->busy_poll_usec();
+    if (usec) {
+      set_busy_poll_option(link_->unicast_socket(), usec);
+#ifdef ACE_HAS_IPV6
+      set_busy_poll_option(link_->ipv6_unicast_socket(), usec);
+#endif
+    }
+    busy_poll_stop_ = false;
+    busy_poll_thread_.reset(new ThreadPool(1, busy_poll, this));
+    return 0;
+  }
+
   ReactorInterceptor_rch ri = link_->get_reactor_interceptor();
   ri->execute_or_enqueue(make_rch<RegisterHandler>(link_->unicast_socket().get_handle(), this, static_cast<ACE_Reactor_Mask>(ACE_Event_Handler::READ_MASK)));
 #ifdef ACE_HAS_IPV6
@@ -1001,10 +1067,15 @@ void
 RtpsUdpReceiveStrategy::stop_i()
 {
   ReactorInterceptor_rch ri = link_->get_reactor_interceptor();
-  ri->execute_or_enqueue(make_rch<RemoveHandler>(link_->unicast_socket().get_handle(), static_cast<ACE_Reactor_Mask>(ACE_Event_Handler::READ_MASK)));
+  if (busy_poll_thread_) {
+    busy_poll_stop_ = true;
+    busy_poll_thread_.reset();
+  } else {
+    ri->execute_or_enqueue(make_rch<RemoveHandler>(link_->unicast_socket().get_handle(), static_cast<ACE_Reactor_Mask>(ACE_Event_Handler::READ_MASK)));
 #ifdef ACE_HAS_IPV6
-  ri->execute_or_enqueue(make_rch<RemoveHandler>(link_->ipv6_unicast_socket().get_handle(), static_cast<ACE_Reactor_Mask>(ACE_Event_Handler::READ_MASK)));
+    ri->execute_or_enqueue(make_rch<RemoveHandler>(link_->ipv6_unicast_socket().get_handle(), static_cast<ACE_Reactor_Mask>(ACE_Event_Handler::READ_MASK)));
 #endif
+  }
 
   RtpsUdpInst_rch cfg = link_->config();
   if (cfg && cfg->use_multicast()) {
@@ -1015,6 +1086,94 @@ RtpsUdpReceiveStrategy::stop_i()
   }
 }
 
+void
+RtpsUdpReceiveStrategy::set_busy_poll_option(const ACE_SOCK_Dgram& socket, ACE_UINT32 usec)
+{
+  if (socket.get_handle() == ACE_INVALID_HANDLE) {
+    return;
+  }
+#ifdef SO_BUSY_POLL
+  int value = static_cast<int>(usec);
+  if (socket.set_option(SOL_SOCKET, SO_BUSY_POLL, &value, sizeof value) != 0 && log_level >= LogLevel::Warning) {
+    ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RtpsUdpReceiveStrategy::set_busy_poll_option: "
+               "%p\n", ACE_TEXT("set_option(SO_BUSY_POLL)")));
+  }
+#else
+  ACE_UNUSED_ARG(usec);
+  if (log_level >= LogLevel::Warning) {
+    ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RtpsUdpReceiveStrategy::set_busy_poll_option: "
+               "SO_BUSY_POLL is not supported on this platform\n"));
+  }
+#endif
+}
+
+ACE_THR_FUNC_RETURN
+RtpsUdpReceiveStrategy::busy_poll(void* arg)
+{
+  static_cast<RtpsUdpReceiveStrategy*>(arg)->busy_poll_loop();
+  return 0;
+}
+
+void
+RtpsUdpReceiveStrategy::busy_poll_loop()
+{
+  ThreadStatusManager::Start s(thread_status_manager_, "RtpsUdpReceiveStrategy busy poll");
+
+  OPENDDS_VECTOR(ACE_HANDLE) handles;
+  handles.push_back(link_->unicast_socket().get_handle());
+#ifdef ACE_HAS_IPV6
+  if (link_->ipv6_unicast_socket().get_handle() != ACE_INVALID_HANDLE) {
+    handles.push_back(link_->ipv6_unicast_socket().get_handle());
+  }
+#endif
+
+  // The thread never blocks, so report it as alive while nothing arrives.
+  const TimeDuration status_period = thread_status_manager_.thread_status_interval() / 2.0;
+  MonotonicTimePoint last_status = MonotonicTimePoint::now();
+  unsigned int idle_spins = 0;
+
+  while (!busy_poll_stop_) {
+    bool received = false;
+    for (size_t i = 0; i < handles.size(); ++i) {
+      // Drain the socket before moving on.
+      while (!busy_poll_stop_ && poll_input(handles[i])) {
+        received = true;
+      }
+    }
+
+    if (received) {
+      idle_spins = 0;
+      last_status = MonotonicTimePoint::now();
+    } else if (thread_status_manager_.update_thread_status() && ++idle_spins % 1024 == 0) {
+      const MonotonicTimePoint now = MonotonicTimePoint::now();
+      if (now - last_status >= status_period) {
+        ThreadStatusManager::Event ev(thread_status_manager_);
+        last_status = now;
+      }
+    }
+  }
+}
+
+bool
+RtpsUdpReceiveStrategy::poll_input(ACE_HANDLE fd)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, input_lock_, false);
+#ifdef MSG_DONTWAIT
+  // One non-blocking recv instead of a poll followed by a recv.
+  recv_flags_ = MSG_DONTWAIT;
+  would_block_ = false;
+  handle_input_i(fd);
+  recv_flags_ = 0;
+  return !would_block_;
+#else
+  if (ACE::handle_read_ready(fd, &ACE_Time_Value::zero) != 1) {
+    return false;
+  }
+  handle_input_i(fd);
+  return true;
+#endif
+}
+
 bool
 RtpsUdpReceiveStrategy::check_header(const RtpsTransportHeader& header)
 {
@@ -1050,6 +1209,7 @@ RtpsUdpReceiveStrategy::check_header(const RtpsSampleHeader& header)
     frags_.second = RtpsSampleHeader::last_fragment(rtps);
     fragment_size_ = rtps.fragmentSize;
     total_frags_ = RtpsSampleHeader::total_fragments(rtps);
+    sample_size_ = rtps.sampleSize;
   }
 
   return header.valid();
@@ -1059,11 +1219,13 @@ void
 RtpsUdpReceiveStrategy::begin_transport_header_processing()
 {
   link_->enable_response_queue();
+  link_->begin_acknack_batch(acknack_batch_);
 }
 
 void
 RtpsUdpReceiveStrategy::end_transport_header_processing()
 {
+  link_->end_acknack_batch(acknack_batch_);
   link_->disable_response_queue(false);
 }
 
@@ -1103,7 +1265,7 @@ bool RtpsUdpReceiveStrategy::reassemble_i(ReceivedDataSample& data, RtpsSampleHe
   using namespace RTPS;
   receiver_.fill_header(data.header_); // set publication_id_.guidPrefix
   data.fragment_size_ = fragment_size_;
-  if (link_->is_target(data.header_.publication_id_) && reassembly_.reassemble(frags_, data, total_frags_)) {
+  if (link_->is_target(data.header_.publication_id_) && reassembly_.reassemble(frags_, data, total_frags_, sample_size_)) {
 
     // Reassembly was successful, replace DataFrag with Data.  This doesn't have
     // to be a fully-formed DataSubmessage, just enough for this class to use
@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_RTPSUDPRECEIVESTRATEGY_H
 
 #include "Rtps_Udp_Export.h"
+#include "RtpsUdpDataLink.h"
 #include "RtpsTransportHeader.h"
 #include "RtpsSampleHeader.h"
 
@@ -17,8 +18,11 @@
 #include "dds/DCPS/RTPS/RtpsCoreC.h"
 #include "dds/DCPS/RTPS/ICE/Ice.h"
 
+#include "dds/DCPS/AtomicBool.h"
 #include "dds/DCPS/NetworkAddress.h"
 #include "dds/DCPS/RcEventHandler.h"
+#include "dds/DCPS/ThreadPool.h"
+#include "dds/DCPS/unique_ptr.h"
 
 #include <dds/OpenDDSConfigWrapper.h>
 
@@ -37,7 +41,6 @@ namespace ICE {
 namespace DCPS {
 
 class RtpsUdpTransport;
-class RtpsUdpDataLink;
 class ReceivedDataSample;
 
 class OpenDDS_Rtps_Udp_Export RtpsUdpReceiveStrategy
@@ -86,7 +89,8 @@ public:
                                       DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
 #endif
                                       RtpsUdpTransport& tport,
-                                      bool& stop);
+                                      bool& stop,
+                                      int flags = 0);
 
   virtual void begin_transport_header_processing();
   virtual void end_transport_header_processing();
@@ -96,6 +100,16 @@ private:
 
   const ACE_SOCK_Dgram& choose_recv_socket(ACE_HANDLE fd) const;
 
+  int handle_input_i(ACE_HANDLE fd);
+
+  /// Busy-poll mode: the unicast sockets are read by a dedicated thread
+  /// instead of the reactor.
+  static ACE_THR_FUNC_RETURN busy_poll(void* arg);
+  void busy_poll_loop();
+  /// Receive and process one datagram from fd if there is one.
+  bool poll_input(ACE_HANDLE fd);
+  void set_busy_poll_option(const ACE_SOCK_Dgram& socket, ACE_UINT32 usec);
+
   virtual ssize_t receive_bytes(iovec iov[],
                                 int n,
                                 ACE_INET_Addr& remote_address,
@@ -143,6 +157,7 @@ private:
   ACE_UINT16 fragment_size_;
   FragmentRange frags_;
   ACE_UINT32 total_frags_;
+  ACE_UINT32 sample_size_;
   TransportReassembly reassembly_;
 
   struct MessageReceiver {
@@ -177,6 +192,20 @@ private:
   ACE_INET_Addr remote_address_;
   RTPS::Message message_;
 
+  bool busy_poll_;
+  AtomicBool busy_poll_stop_;
+  /// In busy-poll mode the multicast sockets are still read by the reactor,
+  /// this serializes them with the polling thread.
+  ACE_Thread_Mutex input_lock_;
+  unique_ptr<ThreadPool> busy_poll_thread_;
+  /// Flags for recv and whether it found no datagram, protected by
+  /// input_lock_ in busy-poll mode.
+  int recv_flags_;
+  bool would_block_;
+  /// ACKNACKs of the message being processed.  Only used while processing
+  /// input, which is serialized like the rest of the parsing state.
+  RtpsUdpDataLink::RtpsWriterBatch acknack_batch_;
+
 #if OPENDDS_CONFIG_SECURITY
   RTPS::SecuritySubmessage secure_prefix_;
   OPENDDS_VECTOR(RTPS::Submessage) secure_submessages_;
@@ -353,17 +353,19 @@ RtpsUdpSendStrategy::add_delayed_notification(TransportQueueElement* element)
 }
 
 #if OPENDDS_CONFIG_SECURITY
-namespace {
-  DDS::OctetSeq toSeq(const ACE_Message_Block* mb)
-  {
-    DDS::OctetSeq out;
-    out.length(static_cast<unsigned int>(mb->total_length()));
-    unsigned char* const buffer = out.get_buffer();
-    for (unsigned int i = 0; mb; mb = mb->cont()) {
-      std::memcpy(buffer + i, mb->rd_ptr(), mb->length());
-      i += static_cast<unsigned int>(mb->length());
-    }
-    return out;
+void
+RtpsUdpSendStrategy::to_octets(DDS::OctetSeq& out, const ACE_Message_Block* mb)
+{
+  const unsigned int len = static_cast<unsigned int>(mb->total_length());
+  if (!mb->cont()) {
+    out.replace(len, len, reinterpret_cast<CORBA::Octet*>(mb->rd_ptr()), false);
+    return;
+  }
+  out.length(len);
+  unsigned char* const buffer = out.get_buffer();
+  for (unsigned int i = 0; mb; mb = mb->cont()) {
+    std::memcpy(buffer + i, mb->rd_ptr(), mb->length());
+    i += static_cast<unsigned int>(mb->length());
   }
 }
 
@@ -387,7 +389,8 @@ RtpsUdpSendStrategy::encode_payload(const GUID_t& pub_id,
     return;
   }
 
-  const DDS::OctetSeq plain = toSeq(payload.get());
+  DDS::OctetSeq plain;
+  to_octets(plain, payload.get());
   DDS::OctetSeq encoded, iQos;
   DDS::Security::SecurityException ex = {"", 0, 0};
 
@@ -462,8 +465,8 @@ ACE_Message_Block*
 RtpsUdpSendStrategy::encode_rtps_message(const ACE_Message_Block* plain, DDS::Security::CryptoTransform* crypto)
 {
   using namespace DDS::Security;
-  DDS::OctetSeq encoded_rtps_message;
-  const DDS::OctetSeq plain_rtps_message = toSeq(plain);
+  DDS::OctetSeq encoded_rtps_message, plain_rtps_message;
+  to_octets(plain_rtps_message, plain);
   const ParticipantCryptoHandle send_handle = link_->local_crypto_handle();
   const ParticipantCryptoHandleSeq recv_handles; // unused
   int idx = 0; // unused
@@ -487,14 +490,25 @@ RtpsUdpSendStrategy::encode_rtps_message(const ACE_Message_Block* plain, DDS::Se
 }
 
 namespace {
-  DDS::OctetSeq toSeq(Serializer& ser1, RTPS::SubmessageHeader smHdr, CORBA::ULong dataExtra,
-                      EntityId_t readerId, EntityId_t writerId, unsigned int remain)
+  void toSeq(DDS::OctetSeq& out, Serializer& ser1, const char* submessage_start,
+             RTPS::SubmessageHeader smHdr, CORBA::ULong dataExtra,
+             EntityId_t readerId, EntityId_t writerId, unsigned int remain)
   {
     const int msgId = smHdr.submessageId;
     const unsigned int octetsToNextHeader = smHdr.submessageLength;
     const bool shortMsg = (msgId == RTPS::PAD || msgId == RTPS::INFO_TS);
     const CORBA::ULong size = RTPS::SMHDR_SZ + ((octetsToNextHeader == 0 && !shortMsg) ? remain : octetsToNextHeader);
-    DDS::OctetSeq out(size);
+
+    // When the whole submessage is in the block being parsed, hand the
+    // plugin the original bytes instead of re-serializing a copy of them.
+    // The caller skips over the submessage content afterwards.
+    const ACE_Message_Block* const cur = ser1.current();
+    if (cur && submessage_start >= cur->base() && submessage_start <= cur->rd_ptr() &&
+        size <= static_cast<size_t>(cur->wr_ptr() - submessage_start)) {
+      out.replace(size, size, reinterpret_cast<CORBA::Octet*>(const_cast<char*>(submessage_start)), false);
+      return;
+    }
+
     out.length(size);
     ACE_Message_Block mb(reinterpret_cast<const char*>(out.get_buffer()), size);
     Serializer ser2(&mb, ser1.encoding());
@@ -508,7 +522,6 @@ namespace {
     ser2 << writerId;
     ser1.read_octet_array(reinterpret_cast<CORBA::Octet*>(mb.wr_ptr()),
                           static_cast<unsigned int>(mb.space()));
-    return out;
   }
 
   void log_encode_error(CORBA::Octet msgId,
@@ -687,7 +700,8 @@ RtpsUdpSendStrategy::encode_submessages(const ACE_Message_Block* plain,
       }
 
       check_stateless_volatile(sender.entityId, stateless_or_volatile);
-      DDS::OctetSeq plainSm(toSeq(parser.serializer(), smhdr, dataExtra, receiver.entityId, sender.entityId, remaining));
+      DDS::OctetSeq plainSm;
+      toSeq(plainSm, parser.serializer(), submessage_start, smhdr, dataExtra, receiver.entityId, sender.entityId, remaining);
       if (!encode_writer_submessage(sender, receiver, replacements, crypto, plainSm,
                                     link_->handle_registry()->get_local_datawriter_crypto_handle(sender), submessage_start, smhdr.submessageId)) {
         ok = false;
@@ -706,7 +720,8 @@ RtpsUdpSendStrategy::encode_submessages(const ACE_Message_Block* plain,
       }
 
       check_stateless_volatile(receiver.entityId, stateless_or_volatile);
-      DDS::OctetSeq plainSm(toSeq(parser.serializer(), smhdr, 0, sender.entityId, receiver.entityId, remaining));
+      DDS::OctetSeq plainSm;
+      toSeq(plainSm, parser.serializer(), submessage_start, smhdr, 0, sender.entityId, receiver.entityId, remaining);
       if (!encode_reader_submessage(sender, receiver, replacements, crypto, plainSm,
                                     link_->handle_registry()->get_local_datareader_crypto_handle(sender), submessage_start, smhdr.submessageId)) {
         ok = false;
@@ -60,6 +60,11 @@ public:
 #if OPENDDS_CONFIG_SECURITY
   void encode_payload(const GUID_t& pub_id, Message_Block_Ptr& payload,
                       RTPS::SubmessageSeq& submessages);
+
+  /// Make 'out' refer to the bytes of 'mb' for the crypto plugin.  A single
+  /// block is aliased without copying, so 'out' must not outlive 'mb'.  A
+  /// chain is copied.
+  static void to_octets(DDS::OctetSeq& out, const ACE_Message_Block* mb);
 #endif
 
   // NOTE: The header and footer sizes are dependent on the built-in crypto plugin.
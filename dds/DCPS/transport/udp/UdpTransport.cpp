@@ -52,7 +52,7 @@ UdpDataLink_rch
 UdpTransport::make_datalink(const ACE_INET_Addr& remote_address,
                             Priority priority, bool active)
 {
-  UdpDataLink_rch link(make_rch<UdpDataLink>(rchandle_from(this), priority, reactor_task(), active));
+  UdpDataLink_rch link(make_rch<UdpDataLink>(rchandle_from(this), priority, link_reactor_task(), active));
   // Configure link with transport configuration and reactor task:
 
   // Open logical connection:
@@ -177,7 +177,7 @@ UdpTransport::configure_i(const UdpInst_rch& config)
   if (!config) {
     return false;
   }
-  create_reactor_task(false, "UdpTransport" + config->name());
+  create_reactor_task(false, "UdpTransport" + config->name(), true);
 
   // Our "server side" data link is created here, similar to the acceptor_
   // in the TcpTransport implementation.  This establishes a socket as an
@@ -36,6 +36,23 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace {
   const ACE_CDR::ULong transportContextDefault = 0xffffffff;
+
+  /// Get the batch interface of a DataWriterRemote or DataReaderRemote,
+  /// or nil if the client was built before it existed.  This can make a
+  /// remote call, so it's done before taking lock_.
+  template <typename Batch>
+  typename Batch::_ptr_type narrow_batch(CORBA::Object_ptr remote)
+  {
+    try {
+      return Batch::_narrow(remote);
+    } catch (const CORBA::Exception& ex) {
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ex._tao_print_exception(
+          "(%P|%t) WARNING: TAO_DDS_DCPSInfo_i: failed checking for the batch interface:");
+      }
+      return Batch::_nil();
+    }
+  }
 }
 
 // constructor
@@ -419,6 +436,28 @@ bool TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     return false;
   }
 
+  OpenDDS::DCPS::DataWriterRemote_var dispatchingPublication =
+    OpenDDS::DCPS::DataWriterRemote::_duplicate(publication);
+
+  if (dispatchingOrb_) {
+    // Remarshall the remote reference onto the dispatching orb.
+    CORBA::String_var pubStr = orb_->object_to_string(dispatchingPublication);
+    CORBA::Object_var pubObj = dispatchingOrb_->string_to_object(pubStr);
+    if (CORBA::is_nil(pubObj))  {
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ACE_DEBUG((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
+                   ACE_TEXT("failure marshalling publication on dispatching orb.\n")));
+      }
+      return false;
+    }
+
+    dispatchingPublication = OpenDDS::DCPS::DataWriterRemote::_unchecked_narrow(pubObj);
+  }
+
+  const OpenDDS::DCPS::DataWriterRemoteBatch_var batchPublication =
+    narrow_batch<OpenDDS::DCPS::DataWriterRemoteBatch>(dispatchingPublication.in());
+
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
 
   // Grab the domain.
@@ -442,31 +481,13 @@ bool TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
     throw OpenDDS::DCPS::Invalid_Topic();
   }
 
-  OpenDDS::DCPS::DataWriterRemote_var dispatchingPublication =
-    OpenDDS::DCPS::DataWriterRemote::_duplicate(publication);
-
-  if (dispatchingOrb_) {
-    // Remarshall the remote reference onto the dispatching orb.
-    CORBA::String_var pubStr = orb_->object_to_string(dispatchingPublication);
-    CORBA::Object_var pubObj = dispatchingOrb_->string_to_object(pubStr);
-    if (CORBA::is_nil(pubObj))  {
-      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-        ACE_DEBUG((LM_WARNING,
-                   ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
-                   ACE_TEXT("failure marshalling publication on dispatching orb.\n")));
-      }
-      return false;
-    }
-
-    dispatchingPublication = OpenDDS::DCPS::DataWriterRemote::_unchecked_narrow(pubObj);
-  }
-
   OpenDDS::DCPS::unique_ptr<DCPS_IR_Publication> pubPtr(
     new DCPS_IR_Publication(
                    pubId,
                    partPtr,
                    topic,
                    dispatchingPublication.in(),
+                   batchPublication.in(),
                    qos,
                    transInfo,
                    transportContextDefault,
@@ -525,6 +546,21 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
                                     const DDS::OctetSeq & serializedTypeInfo,
                                     bool associate)
 {
+  CORBA::Object_var obj = (dispatchingOrb_ ? dispatchingOrb_ : orb_)->string_to_object(pub_str);
+  if (CORBA::is_nil(obj.in())) {
+    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+      ACE_DEBUG((LM_WARNING,
+                 ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
+                 ACE_TEXT("failure converting string %C to objref\n"),
+                 pub_str));
+    }
+    return false;
+  }
+
+  OpenDDS::DCPS::DataWriterRemote_var publication = OpenDDS::DCPS::DataWriterRemote::_unchecked_narrow(obj.in());
+  const OpenDDS::DCPS::DataWriterRemoteBatch_var batchPublication =
+    narrow_batch<OpenDDS::DCPS::DataWriterRemoteBatch>(obj.in());
+
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
 
   // Grab the domain.
@@ -572,25 +608,13 @@ TAO_DDS_DCPSInfo_i::add_publication(DDS::DomainId_t domainId,
 
   /// @TODO: Check if this is already stored.  If so, just clear the callback IOR.
 
-  CORBA::Object_var obj = (dispatchingOrb_ ? dispatchingOrb_ : orb_)->string_to_object(pub_str);
-  if (CORBA::is_nil(obj.in())) {
-    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-      ACE_DEBUG((LM_WARNING,
-                 ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_publication: ")
-                 ACE_TEXT("failure converting string %C to objref\n"),
-                 pub_str));
-    }
-    return false;
-  }
-
-  OpenDDS::DCPS::DataWriterRemote_var publication = OpenDDS::DCPS::DataWriterRemote::_unchecked_narrow(obj.in());
-
   OpenDDS::DCPS::unique_ptr<DCPS_IR_Publication> pubPtr(
     new DCPS_IR_Publication(
                    pubId,
                    partPtr,
                    topic,
                    publication.in(),
+                   batchPublication.in(),
                    qos,
                    transInfo,
                    transportContext,
@@ -755,6 +779,27 @@ bool TAO_DDS_DCPSInfo_i::add_subscription(DDS::DomainId_t domainId,
     return false;
   }
 
+  OpenDDS::DCPS::DataReaderRemote_var dispatchingSubscription (
+    OpenDDS::DCPS::DataReaderRemote::_duplicate(subscription));
+
+  if (dispatchingOrb_) {
+    // Remarshall the remote reference onto the dispatching orb.
+    CORBA::String_var subStr = orb_->object_to_string(dispatchingSubscription);
+    CORBA::Object_var subObj = dispatchingOrb_->string_to_object(subStr);
+    if (CORBA::is_nil(subObj.in())) {
+      if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+        ACE_DEBUG((LM_WARNING,
+                   ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
+                   ACE_TEXT("failure marshalling subscription on dispatching orb.\n")));
+      }
+      return false;
+    }
+    dispatchingSubscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(subObj);
+  }
+
+  const OpenDDS::DCPS::DataReaderRemoteBatch_var batchSubscription =
+    narrow_batch<OpenDDS::DCPS::DataReaderRemoteBatch>(dispatchingSubscription.in());
+
   DCPS_IR_Domain* domainPtr;
   DCPS_IR_Participant* partPtr;
   DCPS_IR_Topic* topic;
@@ -783,30 +828,13 @@ bool TAO_DDS_DCPSInfo_i::add_subscription(DDS::DomainId_t domainId,
       throw OpenDDS::DCPS::Invalid_Topic();
     }
 
-    OpenDDS::DCPS::DataReaderRemote_var dispatchingSubscription (
-      OpenDDS::DCPS::DataReaderRemote::_duplicate(subscription));
-
-    if (dispatchingOrb_) {
-      // Remarshall the remote reference onto the dispatching orb.
-      CORBA::String_var subStr = orb_->object_to_string(dispatchingSubscription);
-      CORBA::Object_var subObj = dispatchingOrb_->string_to_object(subStr);
-      if (CORBA::is_nil(subObj.in())) {
-        if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-          ACE_DEBUG((LM_WARNING,
-                     ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
-                     ACE_TEXT("failure marshalling subscription on dispatching orb.\n")));
-        }
-        return false;
-      }
-      dispatchingSubscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(subObj);
-    }
-
     subPtr.reset(
       new DCPS_IR_Subscription(
                      subId,
                      partPtr,
                      topic,
                      dispatchingSubscription.in(),
+                     batchSubscription.in(),
                      qos,
                      transInfo,
                      transportContextDefault,
@@ -877,6 +905,21 @@ TAO_DDS_DCPSInfo_i::add_subscription(
   const DDS::OctetSeq & serializedTypeInfo,
   bool associate)
 {
+  CORBA::Object_var obj = (dispatchingOrb_ ? dispatchingOrb_ : orb_) ->string_to_object(sub_str);
+  if (CORBA::is_nil(obj.in())) {
+    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
+      ACE_DEBUG((LM_WARNING,
+                 ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
+                 ACE_TEXT("failure converting string %C to objref\n"),
+                 sub_str));
+    }
+    return false;
+  }
+
+  OpenDDS::DCPS::DataReaderRemote_var subscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(obj.in());
+  const OpenDDS::DCPS::DataReaderRemoteBatch_var batchSubscription =
+    narrow_batch<OpenDDS::DCPS::DataReaderRemoteBatch>(obj.in());
+
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, this->lock_, false);
 
   // Grab the domain.
@@ -925,25 +968,13 @@ TAO_DDS_DCPSInfo_i::add_subscription(
     return false;
   }
 
-  CORBA::Object_var obj = (dispatchingOrb_ ? dispatchingOrb_ : orb_) ->string_to_object(sub_str);
-  if (CORBA::is_nil(obj.in())) {
-    if (OpenDDS::DCPS::DCPS_debug_level > 4) {
-      ACE_DEBUG((LM_WARNING,
-                 ACE_TEXT("(%P|%t) WARNING: TAO_DDS_DCPSInfo_i:add_subscription: ")
-                 ACE_TEXT("failure converting string %C to objref\n"),
-                 sub_str));
-    }
-    return false;
-  }
-
-  OpenDDS::DCPS::DataReaderRemote_var subscription = OpenDDS::DCPS::DataReaderRemote::_unchecked_narrow(obj.in());
-
   OpenDDS::DCPS::unique_ptr<DCPS_IR_Subscription> subPtr(
     new DCPS_IR_Subscription(
                    subId,
                    partPtr,
                    topic,
                    subscription.in(),
+                   batchSubscription.in(),
                    qos,
                    transInfo,
                    transportContext,
@@ -27,6 +27,7 @@ DCPS_IR_Publication::DCPS_IR_Publication(const OpenDDS::DCPS::GUID_t& id,
                                          DCPS_IR_Participant* participant,
                                          DCPS_IR_Topic* topic,
                                          OpenDDS::DCPS::DataWriterRemote_ptr writer,
+                                         OpenDDS::DCPS::DataWriterRemoteBatch_ptr batch_writer,
                                          const DDS::DataWriterQos& qos,
                                          const OpenDDS::DCPS::TransportLocatorSeq& info,
                                          ACE_CDR::ULong transportContext,
@@ -37,6 +38,7 @@ DCPS_IR_Publication::DCPS_IR_Publication(const OpenDDS::DCPS::GUID_t& id,
     topic_(topic),
     handle_(0),
     isBIT_(0),
+    batch_writer_(OpenDDS::DCPS::DataWriterRemoteBatch::_duplicate(batch_writer)),
     qos_(qos),
     info_(info),
     transportContext_(transportContext),
@@ -63,15 +65,7 @@ int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
   case 0: {
     // inform the datawriter about the association
     OpenDDS::DCPS::ReaderAssociation association;
-    association.readerTransInfo = sub->get_transportLocatorSeq();
-    association.transportContext = sub->get_transportContext();
-    association.readerId = sub->get_id();
-    association.subQos = *(sub->get_subscriber_qos());
-    association.readerQos = *(sub->get_datareader_qos());
-    association.filterClassName = sub->get_filter_class_name().c_str();
-    association.filterExpression = sub->get_filter_expression().c_str();
-    association.exprParams = sub->get_expr_params();
-    association.serializedTypeInfo = sub->get_serialized_type_info();
+    sub->get_reader_association(association);
 
     if (participant_->is_alive() && this->participant_->isOwner()) {
       try {
@@ -128,6 +122,146 @@ int DCPS_IR_Publication::add_associated_subscription(DCPS_IR_Subscription* sub,
   return status;
 }
 
+int DCPS_IR_Publication::add_associated_subscriptions(const DCPS_IR_Subscription_Vec& subs,
+                                                      bool active)
+{
+  OpenDDS::DCPS::ReaderAssociationSeq associations;
+  associations.length(static_cast<CORBA::ULong>(subs.size()));
+  CORBA::ULong count = 0;
+
+  for (DCPS_IR_Subscription_Vec::const_iterator iter = subs.begin();
+       iter != subs.end(); ++iter) {
+    DCPS_IR_Subscription* const sub = *iter;
+
+    // keep track of the association locally
+    const int status = associations_.insert(sub);
+
+    if (status == 0) {
+      sub->get_reader_association(associations[count++]);
+
+    } else {
+      OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
+      OpenDDS::DCPS::RepoIdConverter sub_converter(sub->get_id());
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: DCPS_IR_Publication::add_associated_subscriptions: ")
+                 ACE_TEXT("publication %C %C subscription %C.\n"),
+                 std::string(pub_converter).c_str(),
+                 status == 1 ? "attempted to re-add" : "failed to add",
+                 std::string(sub_converter).c_str()));
+    }
+  }
+
+  associations.length(count);
+
+  // inform the datawriter about all of the associations at once
+  if (count && participant_->is_alive() && this->participant_->isOwner()) {
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter pub_converter(id_);
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscriptions:")
+                   ACE_TEXT(" publication %C adding %u subscriptions.\n"),
+                   std::string(pub_converter).c_str(),
+                   count));
+      }
+
+      if (CORBA::is_nil(batch_writer_.in())) {
+        for (CORBA::ULong i = 0; i < count; ++i) {
+          writer_->add_association(associations[i], active);
+        }
+      } else {
+        batch_writer_->add_associations(associations, active);
+      }
+
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Publication::add_associated_subscriptions:");
+      participant_->mark_dead();
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int DCPS_IR_Publication::add_associated_subscription(const DCPS_IR_Publication_Vec& pubs,
+                                                     DCPS_IR_Subscription* sub,
+                                                     bool active)
+{
+  DCPS_IR_Publication_Vec added;
+  added.reserve(pubs.size());
+
+  for (DCPS_IR_Publication_Vec::const_iterator iter = pubs.begin();
+       iter != pubs.end(); ++iter) {
+    DCPS_IR_Publication* const pub = *iter;
+
+    // keep track of the association locally
+    const int status = pub->associations_.insert(sub);
+
+    if (status == 0) {
+      added.push_back(pub);
+
+    } else {
+      OpenDDS::DCPS::RepoIdConverter pub_converter(pub->id_);
+      OpenDDS::DCPS::RepoIdConverter sub_converter(sub->get_id());
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: DCPS_IR_Publication::add_associated_subscription: ")
+                 ACE_TEXT("publication %C %C subscription %C.\n"),
+                 std::string(pub_converter).c_str(),
+                 status == 1 ? "attempted to re-add" : "failed to add",
+                 std::string(sub_converter).c_str()));
+    }
+  }
+
+  if (added.empty()) {
+    return 0;
+  }
+
+  DCPS_IR_Publication* const first = added.front();
+  DCPS_IR_Participant* const participant = first->participant_;
+
+  // inform all of the participant's datawriters at once
+  if (participant->is_alive() && participant->isOwner()) {
+    OpenDDS::DCPS::ReaderAssociation association;
+    sub->get_reader_association(association);
+
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter part_converter(participant->get_id());
+        OpenDDS::DCPS::RepoIdConverter sub_converter(sub->get_id());
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Publication::add_associated_subscription:")
+                   ACE_TEXT(" %B publications of participant %C adding subscription %C.\n"),
+                   added.size(),
+                   std::string(part_converter).c_str(),
+                   std::string(sub_converter).c_str()));
+      }
+
+      if (CORBA::is_nil(first->batch_writer_.in())) {
+        for (DCPS_IR_Publication_Vec::const_iterator iter = added.begin();
+             iter != added.end(); ++iter) {
+          (*iter)->writer_->add_association(association, active);
+        }
+      } else {
+        OpenDDS::DCPS::WriterIdSeq writers;
+        writers.length(static_cast<CORBA::ULong>(added.size()));
+        for (CORBA::ULong i = 0; i < writers.length(); ++i) {
+          writers[i] = added[i]->id_;
+        }
+        first->batch_writer_->add_association_to_writers(writers, association, active);
+      }
+
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Publication::add_associated_subscription:");
+      participant->mark_dead();
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 int DCPS_IR_Publication::remove_associated_subscription(DCPS_IR_Subscription* sub,
                                                         CORBA::Boolean sendNotify,
                                                         CORBA::Boolean notify_lost,
@@ -581,6 +715,16 @@ DDS::PublisherQos* DCPS_IR_Publication::get_publisher_qos()
   return &publisherQos_;
 }
 
+void DCPS_IR_Publication::get_writer_association(OpenDDS::DCPS::WriterAssociation& association)
+{
+  association.writerTransInfo = info_;
+  association.transportContext = transportContext_;
+  association.writerId = id_;
+  association.pubQos = publisherQos_;
+  association.writerQos = qos_;
+  association.serializedTypeInfo = serializedTypeInfo_;
+}
+
 OpenDDS::DCPS::TransportLocatorSeq DCPS_IR_Publication::get_transportLocatorSeq() const
 {
   return info_;
@@ -17,6 +17,8 @@
 #include /**/ "ace/Unbounded_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 
+#include <vector>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -30,6 +32,10 @@ class DCPS_IR_Topic_Description;
 
 class DCPS_IR_Subscription;
 typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
+typedef std::vector<DCPS_IR_Subscription*> DCPS_IR_Subscription_Vec;
+
+class DCPS_IR_Publication;
+typedef std::vector<DCPS_IR_Publication*> DCPS_IR_Publication_Vec;
 
 /**
  * @class DCPS_IR_Publication
@@ -45,6 +51,7 @@ public:
                       DCPS_IR_Participant* participant,
                       DCPS_IR_Topic* topic,
                       OpenDDS::DCPS::DataWriterRemote_ptr writer,
+                      OpenDDS::DCPS::DataWriterRemoteBatch_ptr batch_writer,
                       const DDS::DataWriterQos& qos,
                       const OpenDDS::DCPS::TransportLocatorSeq& info,
                       ACE_CDR::ULong transportContext,
@@ -60,6 +67,25 @@ public:
   /// Returns 0 if added, 1 if already exists, -1 other failure
   int add_associated_subscription(DCPS_IR_Subscription* sub, bool active);
 
+  /// Associate with each of the subscriptions
+  /// Same as add_associated_subscription() for each subscription, but
+  ///  the datawriter is told about all of the added subscriptions in
+  ///  a single call
+  /// This method can mark the participant dead
+  /// Returns 0 if successful, -1 if the datawriter couldn't be told
+  int add_associated_subscriptions(const DCPS_IR_Subscription_Vec& subs,
+                                   bool active);
+
+  /// Associate each of the publications with the subscription
+  /// Same as add_associated_subscription() on each publication, but
+  ///  the publications all belong to one participant and their
+  ///  datawriters are told about the subscription in a single call
+  /// This method can mark the participant dead
+  /// Returns 0 if successful, -1 if the datawriters couldn't be told
+  static int add_associated_subscription(const DCPS_IR_Publication_Vec& pubs,
+                                         DCPS_IR_Subscription* sub,
+                                         bool active);
+
   /// Remove the associated subscription
   /// Removes the subscription from the list of associated
   ///  subscriptions if return successful
@@ -115,6 +141,10 @@ public:
   /// Publication retains ownership
   DDS::PublisherQos* get_publisher_qos();
 
+  /// Fill in what a datareader needs to know to associate with
+  ///  this publication
+  void get_writer_association(OpenDDS::DCPS::WriterAssociation& association);
+
   /// Update the DataWriter or Publisher qos and also publish the qos changes
   /// to datawriter BIT.
   bool set_qos(const DDS::DataWriterQos & qos,
@@ -174,7 +204,6 @@ public:
   const DDS::OctetSeq& get_serialized_type_info() const;
 
 private:
-
   OpenDDS::DCPS::GUID_t id_;
   DCPS_IR_Participant* participant_;
   DCPS_IR_Topic* topic_;
@@ -183,6 +212,8 @@ private:
 
   /// the corresponding DataWriterRemote object
   OpenDDS::DCPS::DataWriterRemote_var writer_;
+  /// writer_ as a DataWriterRemoteBatch, or nil if the client doesn't support it
+  OpenDDS::DCPS::DataWriterRemoteBatch_var batch_writer_;
   DDS::DataWriterQos qos_;
   OpenDDS::DCPS::TransportLocatorSeq info_;
   ACE_CDR::ULong transportContext_;
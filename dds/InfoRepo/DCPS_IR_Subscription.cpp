@@ -26,6 +26,7 @@ DCPS_IR_Subscription::DCPS_IR_Subscription(const OpenDDS::DCPS::GUID_t& id,
                                            DCPS_IR_Participant* participant,
                                            DCPS_IR_Topic* topic,
                                            OpenDDS::DCPS::DataReaderRemote_ptr reader,
+                                           OpenDDS::DCPS::DataReaderRemoteBatch_ptr batch_reader,
                                            const DDS::DataReaderQos& qos,
                                            const OpenDDS::DCPS::TransportLocatorSeq& info,
                                            ACE_CDR::ULong transportContext,
@@ -39,6 +40,7 @@ DCPS_IR_Subscription::DCPS_IR_Subscription(const OpenDDS::DCPS::GUID_t& id,
     topic_(topic),
     handle_(0),
     isBIT_(0),
+    batch_reader_(OpenDDS::DCPS::DataReaderRemoteBatch::_duplicate(batch_reader)),
     qos_(qos),
     info_(info),
     transportContext_(transportContext),
@@ -68,12 +70,7 @@ int DCPS_IR_Subscription::add_associated_publication(DCPS_IR_Publication* pub,
   case 0: {
     // inform the datareader about the association
     OpenDDS::DCPS::WriterAssociation association;
-    association.writerTransInfo = pub->get_transportLocatorSeq();
-    association.transportContext = pub->get_transportContext();
-    association.writerId = pub->get_id();
-    association.pubQos = *(pub->get_publisher_qos());
-    association.writerQos = *(pub->get_datawriter_qos());
-    association.serializedTypeInfo = pub->get_serialized_type_info();
+    pub->get_writer_association(association);
     if (participant_->is_alive() && this->participant_->isOwner()) {
       try {
         if (OpenDDS::DCPS::DCPS_debug_level > 0) {
@@ -130,6 +127,146 @@ int DCPS_IR_Subscription::add_associated_publication(DCPS_IR_Publication* pub,
   return status;
 }
 
+int DCPS_IR_Subscription::add_associated_publications(const DCPS_IR_Publication_Vec& pubs,
+                                                      bool active)
+{
+  OpenDDS::DCPS::WriterAssociationSeq associations;
+  associations.length(static_cast<CORBA::ULong>(pubs.size()));
+  CORBA::ULong count = 0;
+
+  for (DCPS_IR_Publication_Vec::const_iterator iter = pubs.begin();
+       iter != pubs.end(); ++iter) {
+    DCPS_IR_Publication* const pub = *iter;
+
+    // keep track of the association locally
+    const int status = associations_.insert(pub);
+
+    if (status == 0) {
+      pub->get_writer_association(associations[count++]);
+
+    } else {
+      OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
+      OpenDDS::DCPS::RepoIdConverter pub_converter(pub->get_id());
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: DCPS_IR_Subscription::add_associated_publications: ")
+                 ACE_TEXT("subscription %C %C publication %C\n"),
+                 std::string(sub_converter).c_str(),
+                 status == 1 ? "attempted to re-add" : "failed to add",
+                 std::string(pub_converter).c_str()));
+    }
+  }
+
+  associations.length(count);
+
+  // inform the datareader about all of the associations at once
+  if (count && participant_->is_alive() && this->participant_->isOwner()) {
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter sub_converter(id_);
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publications:")
+                   ACE_TEXT(" subscription %C adding %u publications.\n"),
+                   std::string(sub_converter).c_str(),
+                   count));
+      }
+
+      if (CORBA::is_nil(batch_reader_.in())) {
+        for (CORBA::ULong i = 0; i < count; ++i) {
+          reader_->add_association(associations[i], active);
+        }
+      } else {
+        batch_reader_->add_associations(associations, active);
+      }
+
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Subscription::add_associated_publications:");
+      participant_->mark_dead();
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int DCPS_IR_Subscription::add_associated_publication(const DCPS_IR_Subscription_Vec& subs,
+                                                     DCPS_IR_Publication* pub,
+                                                     bool active)
+{
+  DCPS_IR_Subscription_Vec added;
+  added.reserve(subs.size());
+
+  for (DCPS_IR_Subscription_Vec::const_iterator iter = subs.begin();
+       iter != subs.end(); ++iter) {
+    DCPS_IR_Subscription* const sub = *iter;
+
+    // keep track of the association locally
+    const int status = sub->associations_.insert(pub);
+
+    if (status == 0) {
+      added.push_back(sub);
+
+    } else {
+      OpenDDS::DCPS::RepoIdConverter sub_converter(sub->id_);
+      OpenDDS::DCPS::RepoIdConverter pub_converter(pub->get_id());
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: DCPS_IR_Subscription::add_associated_publication: ")
+                 ACE_TEXT("subscription %C %C publication %C\n"),
+                 std::string(sub_converter).c_str(),
+                 status == 1 ? "attempted to re-add" : "failed to add",
+                 std::string(pub_converter).c_str()));
+    }
+  }
+
+  if (added.empty()) {
+    return 0;
+  }
+
+  DCPS_IR_Subscription* const first = added.front();
+  DCPS_IR_Participant* const participant = first->participant_;
+
+  // inform all of the participant's datareaders at once
+  if (participant->is_alive() && participant->isOwner()) {
+    OpenDDS::DCPS::WriterAssociation association;
+    pub->get_writer_association(association);
+
+    try {
+      if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+        OpenDDS::DCPS::RepoIdConverter part_converter(participant->get_id());
+        OpenDDS::DCPS::RepoIdConverter pub_converter(pub->get_id());
+        ACE_DEBUG((LM_DEBUG,
+                   ACE_TEXT("(%P|%t) DCPS_IR_Subscription::add_associated_publication:")
+                   ACE_TEXT(" %B subscriptions of participant %C adding publication %C.\n"),
+                   added.size(),
+                   std::string(part_converter).c_str(),
+                   std::string(pub_converter).c_str()));
+      }
+
+      if (CORBA::is_nil(first->batch_reader_.in())) {
+        for (DCPS_IR_Subscription_Vec::const_iterator iter = added.begin();
+             iter != added.end(); ++iter) {
+          (*iter)->reader_->add_association(association, active);
+        }
+      } else {
+        OpenDDS::DCPS::ReaderIdSeq readers;
+        readers.length(static_cast<CORBA::ULong>(added.size()));
+        for (CORBA::ULong i = 0; i < readers.length(); ++i) {
+          readers[i] = added[i]->id_;
+        }
+        first->batch_reader_->add_association_to_readers(readers, association, active);
+      }
+
+    } catch (const CORBA::Exception& ex) {
+      ex._tao_print_exception(
+        "(%P|%t) ERROR: Exception caught in DCPS_IR_Subscription::add_associated_publication:");
+      participant->mark_dead();
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 int DCPS_IR_Subscription::remove_associated_publication(DCPS_IR_Publication* pub,
                                                         CORBA::Boolean sendNotify,
                                                         CORBA::Boolean notify_lost,
@@ -495,6 +632,19 @@ const DDS::SubscriberQos* DCPS_IR_Subscription::get_subscriber_qos()
   return &subscriberQos_;
 }
 
+void DCPS_IR_Subscription::get_reader_association(OpenDDS::DCPS::ReaderAssociation& association)
+{
+  association.readerTransInfo = info_;
+  association.transportContext = transportContext_;
+  association.readerId = id_;
+  association.subQos = subscriberQos_;
+  association.readerQos = qos_;
+  association.filterClassName = filterClassName_.c_str();
+  association.filterExpression = filterExpression_.c_str();
+  association.exprParams = exprParams_;
+  association.serializedTypeInfo = serializedTypeInfo_;
+}
+
 using OpenDDS::DCPS::operator==;
 
 void
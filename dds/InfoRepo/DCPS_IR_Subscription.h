@@ -17,6 +17,8 @@
 #include /**/ "ace/Unbounded_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 
+#include <vector>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -26,6 +28,10 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 // forward declarations
 class DCPS_IR_Publication;
 typedef ACE_Unbounded_Set<DCPS_IR_Publication*> DCPS_IR_Publication_Set;
+typedef std::vector<DCPS_IR_Publication*> DCPS_IR_Publication_Vec;
+
+class DCPS_IR_Subscription;
+typedef std::vector<DCPS_IR_Subscription*> DCPS_IR_Subscription_Vec;
 
 class DCPS_IR_Participant;
 class DCPS_IR_Topic_Description;
@@ -45,6 +51,7 @@ public:
                        DCPS_IR_Participant* participant,
                        DCPS_IR_Topic* topic,
                        OpenDDS::DCPS::DataReaderRemote_ptr reader,
+                       OpenDDS::DCPS::DataReaderRemoteBatch_ptr batch_reader,
                        const DDS::DataReaderQos& qos,
                        const OpenDDS::DCPS::TransportLocatorSeq& info,
                        ACE_CDR::ULong transportContext,
@@ -63,6 +70,25 @@ public:
   /// Returns 0 if added, 1 if already exists, -1 other failure
   int add_associated_publication(DCPS_IR_Publication* pub, bool active);
 
+  /// Associate with each of the publications
+  /// Same as add_associated_publication() for each publication, but
+  ///  the datareader is told about all of the added publications in
+  ///  a single call
+  /// This method can mark the participant dead
+  /// Returns 0 if successful, -1 if the datareader couldn't be told
+  int add_associated_publications(const DCPS_IR_Publication_Vec& pubs,
+                                  bool active);
+
+  /// Associate each of the subscriptions with the publication
+  /// Same as add_associated_publication() on each subscription, but
+  ///  the subscriptions all belong to one participant and their
+  ///  datareaders are told about the publication in a single call
+  /// This method can mark the participant dead
+  /// Returns 0 if successful, -1 if the datareaders couldn't be told
+  static int add_associated_publication(const DCPS_IR_Subscription_Vec& subs,
+                                        DCPS_IR_Publication* pub,
+                                        bool active);
+
   /// Remove the associated publication
   /// Removes the publication from the list of associated
   ///  publications if return successful
@@ -118,6 +144,10 @@ public:
   /// Subscription retains ownership
   const DDS::SubscriberQos* get_subscriber_qos();
 
+  /// Fill in what a datawriter needs to know to associate with
+  ///  this subscription
+  void get_reader_association(OpenDDS::DCPS::ReaderAssociation& association);
+
   /// Update the DataReader or Subscriber qos and also publish the qos
   /// changes to datereader BIT.
   bool set_qos(const DDS::DataReaderQos & qos,
@@ -191,6 +221,8 @@ private:
 
   /// the corresponding DataReaderRemote object
   OpenDDS::DCPS::DataReaderRemote_var reader_;
+  /// reader_ as a DataReaderRemoteBatch, or nil if the client doesn't support it
+  OpenDDS::DCPS::DataReaderRemoteBatch_var batch_reader_;
   DDS::DataReaderQos qos_;
   OpenDDS::DCPS::TransportLocatorSeq info_;
   ACE_CDR::ULong transportContext_;
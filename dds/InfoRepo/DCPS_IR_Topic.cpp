@@ -277,7 +277,8 @@ bool DCPS_IR_Topic::set_topic_qos(const DDS::TopicQos& qos)
   return true;
 }
 
-void DCPS_IR_Topic::try_associate(DCPS_IR_Subscription* subscription)
+void DCPS_IR_Topic::try_associate(DCPS_IR_Subscription* subscription,
+                                  DCPS_IR_Publication_Vec& compatible)
 {
   // check if we should ignore this subscription
   if (participant_->is_subscription_ignored(subscription->get_id()) ||
@@ -304,7 +305,11 @@ void DCPS_IR_Topic::try_associate(DCPS_IR_Subscription* subscription)
     while (iter != end) {
       pub = *iter;
       ++iter;
-      description_->try_associate(pub, subscription);
+
+      if (description_->is_compatible(pub, subscription)) {
+        compatible.push_back(pub);
+      }
+
       // Check the publications QOS status
       qosStatus = pub->get_incompatibleQosStatus();
 
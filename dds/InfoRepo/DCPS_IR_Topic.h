@@ -15,6 +15,7 @@
 #include /**/ "ace/Unbounded_Set.h"
 #include "dds/DCPS/unique_ptr.h"
 #include <string>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -25,6 +26,7 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 // forward declarations
 class DCPS_IR_Publication;
 typedef ACE_Unbounded_Set<DCPS_IR_Publication*> DCPS_IR_Publication_Set;
+typedef std::vector<DCPS_IR_Publication*> DCPS_IR_Publication_Vec;
 
 class DCPS_IR_Subscription;
 typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
@@ -81,12 +83,13 @@ public:
   int remove_subscription_reference(DCPS_IR_Subscription* subscription);
 
   /// Called by the DCPS_IR_Topic_Description
-  /// Find any compatible publications and associate
-  ///  them using the DCPS_IR_Topic_Description's
-  ///  associate method.
+  /// Find any compatible publications and append them to
+  ///  compatible so the DCPS_IR_Topic_Description can
+  ///  associate them with the subscription all at once.
   /// This method does not check the subscription's incompatible
   ///  qos status.
-  void try_associate(DCPS_IR_Subscription* subscription);
+  void try_associate(DCPS_IR_Subscription* subscription,
+                     DCPS_IR_Publication_Vec& compatible);
 
   /// Called by the DCPS_IR_Topic_Description to re-evaluate the
   /// association between the publications of this topic and the
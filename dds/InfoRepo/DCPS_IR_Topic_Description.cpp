@@ -15,13 +15,40 @@
 #include /**/ "DCPS_IR_Domain.h"
 
 #include /**/ "dds/DCPS/DCPS_Utils.h"
+#include /**/ "dds/DCPS/GuidUtils.h"
 
 #include /**/ "tao/debug.h"
 
 #include /**/ "dds/DCPS/RepoIdConverter.h"
 
+#include <map>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace {
+  /// Split the endpoints into one group per participant, keeping their
+  /// order, so each participant can be told about an association at once.
+  template <typename Endpoint>
+  void group_by_participant(const std::vector<Endpoint*>& endpoints,
+                            std::vector<std::vector<Endpoint*> >& groups)
+  {
+    typedef std::map<OpenDDS::DCPS::GUID_t, size_t,
+                     OpenDDS::DCPS::GUID_tKeyLessThan> GroupIndex;
+    GroupIndex index;
+
+    for (typename std::vector<Endpoint*>::const_iterator iter = endpoints.begin();
+         iter != endpoints.end(); ++iter) {
+      const std::pair<typename GroupIndex::iterator, bool> result =
+        index.insert(typename GroupIndex::value_type((*iter)->get_participant_id(),
+                                                     groups.size()));
+      if (result.second) {
+        groups.push_back(std::vector<Endpoint*>());
+      }
+      groups[result.first->second].push_back(*iter);
+    }
+  }
+}
+
 DCPS_IR_Topic_Description::DCPS_IR_Topic_Description(DCPS_IR_Domain* domain,
                                                      const char* name,
                                                      const char* dataTypeName)
@@ -207,8 +234,14 @@ DCPS_IR_Topic* DCPS_IR_Topic_Description::get_first_topic()
 void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* publication)
 {
   // for each subscription check for compatibility
+  /// @TODO: Index the subscriptions by the QoS policies that can be
+  ///  matched without checking each pair, and run matching under a
+  ///  per-topic lock instead of the lock of DCPSInfo_i.  The locking
+  ///  needs the participant, built-in topic, persistence, and federation
+  ///  updates made by associating to be moved out of the topic first.
   DCPS_IR_Subscription* subscription = 0;
   OpenDDS::DCPS::IncompatibleQosStatus* qosStatus = 0;
+  DCPS_IR_Subscription_Vec compatible;
 
   DCPS_IR_Subscription_Set::ITERATOR iter = subscriptionRefs_.begin();
   DCPS_IR_Subscription_Set::ITERATOR end = subscriptionRefs_.end();
@@ -216,7 +249,10 @@ void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* p
   while (iter != end) {
     subscription = *iter;
     ++iter;
-    try_associate(publication, subscription);
+
+    if (is_compatible(publication, subscription)) {
+      compatible.push_back(subscription);
+    }
 
     // Check the subscriptions QOS status
     qosStatus = subscription->get_incompatibleQosStatus();
@@ -226,6 +262,10 @@ void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* p
     }
   }
 
+  if (!compatible.empty()) {
+    associate(publication, compatible);
+  }
+
   // Check the publications QOS status
   qosStatus = publication->get_incompatibleQosStatus();
 
@@ -237,8 +277,10 @@ void DCPS_IR_Topic_Description::try_associate_publication(DCPS_IR_Publication* p
 void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription* subscription)
 {
   // check all topics for compatible publications
+  /// @TODO: See try_associate_publication().
 
   DCPS_IR_Topic* topic = 0;
+  DCPS_IR_Publication_Vec compatible;
 
   DCPS_IR_Topic_Set::ITERATOR iter = topics_.begin();
   DCPS_IR_Topic_Set::ITERATOR end = topics_.end();
@@ -247,7 +289,11 @@ void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription*
     topic = *iter;
     ++iter;
 
-    topic->try_associate(subscription);
+    topic->try_associate(subscription, compatible);
+  }
+
+  if (!compatible.empty()) {
+    associate(compatible, subscription);
   }
 
   // Check the subscriptions QOS status
@@ -273,6 +319,18 @@ void DCPS_IR_Topic_Description::try_associate_subscription(DCPS_IR_Subscription*
 bool
 DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
                                          DCPS_IR_Subscription* subscription)
+{
+  if (is_compatible(publication, subscription)) {
+    associate(publication, subscription);
+    return true;
+  }
+
+  return false;
+}
+
+bool
+DCPS_IR_Topic_Description::is_compatible(DCPS_IR_Publication* publication,
+                                         DCPS_IR_Subscription* subscription)
 {
   if (publication->is_subscription_ignored(subscription->get_participant_id(),
                                            subscription->get_topic_id(),
@@ -281,7 +339,7 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
       OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
       OpenDDS::DCPS::RepoIdConverter sub_converter(subscription->get_id());
       ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::try_associate: ")
+                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::is_compatible: ")
                  ACE_TEXT("topic description %C publication %C ignores subscription %C.\n"),
                  this->name_.c_str(),
                  std::string(pub_converter).c_str(),
@@ -296,7 +354,7 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
       OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
       OpenDDS::DCPS::RepoIdConverter sub_converter(subscription->get_id());
       ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::try_associate: ")
+                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::is_compatible: ")
                  ACE_TEXT("topic description %C subscription %C ignores publication %C.\n"),
                  this->name_.c_str(),
                  std::string(pub_converter).c_str(),
@@ -308,7 +366,7 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
       OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
       OpenDDS::DCPS::RepoIdConverter sub_converter(subscription->get_id());
       ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::try_associate: ")
+                 ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::is_compatible: ")
                  ACE_TEXT("topic description %C checking compatibility of ")
                  ACE_TEXT("publication %C with subscription %C.\n"),
                  this->name_.c_str(),
@@ -324,7 +382,6 @@ DCPS_IR_Topic_Description::try_associate(DCPS_IR_Publication* publication,
                                      subscription->get_datareader_qos(),
                                      publication->get_publisher_qos(),
                                      subscription->get_subscriber_qos())) {
-      associate(publication, subscription);
       return true;
     }
 
@@ -371,6 +428,75 @@ void DCPS_IR_Topic_Description::associate(DCPS_IR_Publication* publication,
   }
 }
 
+void DCPS_IR_Topic_Description::associate(DCPS_IR_Publication* publication,
+                                          const DCPS_IR_Subscription_Vec& subscriptions)
+{
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    OpenDDS::DCPS::RepoIdConverter pub_converter(publication->get_id());
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::associate: ")
+               ACE_TEXT("topic description %C associating ")
+               ACE_TEXT("publication %C with %B subscriptions.\n"),
+               this->name_.c_str(),
+               std::string(pub_converter).c_str(),
+               subscriptions.size()));
+  }
+
+  // The publication is told first for the same reason as above, and is
+  // told about all of the subscriptions at once.
+  if (publication->add_associated_subscriptions(subscriptions, true) == -1) {
+    ACE_DEBUG((LM_INFO, ACE_TEXT("Invalid publication detected, NOT notifying subscriptions of association\n")));
+    return;
+  }
+
+  // Then the subscriptions of each participant are told about the
+  // publication at once.
+  std::vector<DCPS_IR_Subscription_Vec> groups;
+  group_by_participant(subscriptions, groups);
+
+  for (std::vector<DCPS_IR_Subscription_Vec>::const_iterator iter = groups.begin();
+       iter != groups.end(); ++iter) {
+    DCPS_IR_Subscription::add_associated_publication(*iter, publication, false);
+  }
+}
+
+void DCPS_IR_Topic_Description::associate(const DCPS_IR_Publication_Vec& publications,
+                                          DCPS_IR_Subscription* subscription)
+{
+  if (OpenDDS::DCPS::DCPS_debug_level > 0) {
+    OpenDDS::DCPS::RepoIdConverter sub_converter(subscription->get_id());
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("(%P|%t) DCPS_IR_Topic_Description::associate: ")
+               ACE_TEXT("topic description %C associating ")
+               ACE_TEXT("%B publications with subscription %C.\n"),
+               this->name_.c_str(),
+               publications.size(),
+               std::string(sub_converter).c_str()));
+  }
+
+  // The publications are told first for the same reason as above, with
+  // the ones of each participant told at once.  Then the subscription is
+  // told about all of the ones that could be contacted at once.
+  std::vector<DCPS_IR_Publication_Vec> groups;
+  group_by_participant(publications, groups);
+
+  DCPS_IR_Publication_Vec added;
+  added.reserve(publications.size());
+
+  for (std::vector<DCPS_IR_Publication_Vec>::const_iterator iter = groups.begin();
+       iter != groups.end(); ++iter) {
+    if (DCPS_IR_Publication::add_associated_subscription(*iter, subscription, true) != -1) {
+      added.insert(added.end(), iter->begin(), iter->end());
+    } else {
+      ACE_DEBUG((LM_INFO, ACE_TEXT("Invalid publication detected, NOT notifying subscription of association\n")));
+    }
+  }
+
+  if (!added.empty()) {
+    subscription->add_associated_publications(added, false);
+  }
+}
+
 void DCPS_IR_Topic_Description::reevaluate_associations(DCPS_IR_Subscription* subscription)
 {
   DCPS_IR_Topic* topic = 0;
@@ -15,6 +15,7 @@
 #include "dds/DCPS/unique_ptr.h"
 
 #include <string>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -26,10 +27,13 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // forward declarations
 class DCPS_IR_Publication;
+typedef std::vector<DCPS_IR_Publication*> DCPS_IR_Publication_Vec;
+
 class DCPS_IR_Domain;
 
 class DCPS_IR_Subscription;
 typedef ACE_Unbounded_Set<DCPS_IR_Subscription*> DCPS_IR_Subscription_Set;
+typedef std::vector<DCPS_IR_Subscription*> DCPS_IR_Subscription_Vec;
 
 class DCPS_IR_Topic;
 typedef ACE_Unbounded_Set<DCPS_IR_Topic*> DCPS_IR_Topic_Set;
@@ -88,10 +92,27 @@ public:
   bool try_associate(DCPS_IR_Publication* publication,
                      DCPS_IR_Subscription* subscription);
 
+  /// Checks to see if the publication and subscription can
+  ///  be associated without associating them.
+  bool is_compatible(DCPS_IR_Publication* publication,
+                     DCPS_IR_Subscription* subscription);
+
   /// Associate the publication and subscription
   void associate(DCPS_IR_Publication* publication,
                  DCPS_IR_Subscription* subscription);
 
+  /// Associate the publication with each of the subscriptions
+  ///  telling the publication about all of them in one call, and
+  ///  the subscriptions of each participant about it in one call
+  void associate(DCPS_IR_Publication* publication,
+                 const DCPS_IR_Subscription_Vec& subscriptions);
+
+  /// Associate each of the publications with the subscription
+  ///  telling the publications of each participant about it in one
+  ///  call, and the subscription about all of them in one call
+  void associate(const DCPS_IR_Publication_Vec& publications,
+                 DCPS_IR_Subscription* subscription);
+
   /// Re-evaluate the association between the provided publication and
   /// the subscriptions it maintains.
   void reevaluate_associations(DCPS_IR_Publication* publication);
@@ -55,6 +55,7 @@ BE_GlobalData::BE_GlobalData()
   , generate_xtypes_complete_(false)
   , face_ts_(false)
   , generate_equality_(false)
+  , generate_json_encoder_(true)
   , filename_only_includes_(false)
   , sequence_suffix_("Seq")
   , language_mapping_(LANGMAP_NONE)
@@ -486,6 +487,8 @@ BE_GlobalData::parse_args(long& i, char** av)
       old_typeobject_encoding_ = true;
     } else if (!strcmp(av[i], "--old-typeobject-member-order")) {
       old_typeobject_member_order_ = true;
+    } else if (!strcmp(av[i], "--no-json-encoder")) {
+      generate_json_encoder_ = false;
     } else {
       invalid_option(av[i]);
     }
@@ -258,6 +258,8 @@ public:
   void generate_equality(bool flag) { generate_equality_ = flag; }
   bool generate_equality() const { return generate_equality_; }
 
+  bool generate_json_encoder() const { return generate_json_encoder_; }
+
 private:
   /// Name of the IDL file we are processing.
   const char* filename_;
@@ -265,7 +267,8 @@ private:
   bool java_, suppress_idl_, suppress_typecode_, suppress_xtypes_,
     no_default_gen_, generate_itl_,
     generate_value_reader_writer_,
-    generate_xtypes_complete_, face_ts_, generate_equality_;
+    generate_xtypes_complete_, face_ts_, generate_equality_,
+    generate_json_encoder_;
 
   bool filename_only_includes_;
 
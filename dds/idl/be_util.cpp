@@ -132,6 +132,8 @@ be_util::usage()
     "                                         member order for TypeObjects, which is\n"
     "                                         ordered by member id instead of\n"
     "                                         declared order\n"
+    " --no-json-encoder                       don't generate vwrite overloads for\n"
+    "                                         JsonEncoder\n"
     " -Wb,export_macro=<macro name>           set export macro for all files\n"
     " --export=<macro name>                   Alias for -Wb,export_macro\n"
     " -Wb,export_include=<include path>       set export include file for all files\n"
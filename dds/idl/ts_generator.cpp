@@ -421,13 +421,11 @@ bool ts_generator::generate_ts(AST_Type* node, UTL_ScopedName* name)
       "#if OPENDDS_HAS_JSON_VALUE_WRITER\n"
       "  OpenDDS::DCPS::JsonRepresentationFormat_var jrf = OpenDDS::DCPS::JsonRepresentationFormat::_narrow(format);\n"
       "  if (jrf) {\n"
-      "    rapidjson::StringBuffer buffer;\n"
-      "    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);\n"
-      "    OpenDDS::DCPS::JsonValueWriter<rapidjson::Writer<rapidjson::StringBuffer> > jvw(writer);\n"
-      "    if (!vwrite(jvw, in)) {\n"
+      "    OpenDDS::DCPS::JsonEncoder encoder;\n"
+      "    if (!encoder.encode(in)) {\n"
       "      return ::DDS::RETCODE_ERROR;\n"
       "    }\n"
-      "    out = buffer.GetString();\n"
+      "    out = encoder.c_str();\n"
       "    return ::DDS::RETCODE_OK;\n"
       "  }\n"
       "#else\n"
@@ -18,6 +18,20 @@ using namespace AstTypeClassification;
 
 namespace {
 
+  const char* const value_writer_type = "OpenDDS::DCPS::ValueWriter&";
+  const char* const json_encoder_type = "OpenDDS::DCPS::JsonEncoder&";
+
+  // The vwrite overloads for JsonEncoder have the same body as the
+  // ValueWriter ones, but the calls in them aren't virtual.
+  class JsonEncoderGuard : public PreprocessorIfGuard {
+  public:
+    JsonEncoderGuard()
+      : PreprocessorIfGuard(" OPENDDS_HAS_JSON_VALUE_WRITER")
+    {
+      be_global->add_cpp_include("dds/DCPS/JsonValueWriter.h");
+    }
+  };
+
   void generate_write(const std::string& expression, const std::string& field_name,
                       AST_Type* type, const std::string& idx, int level = 1,
                       FieldFilter field_filter = FieldFilter_All);
@@ -269,11 +283,12 @@ namespace {
   }
 
   bool gen_struct_i(AST_Structure* node, const std::string& type_name,
-                    bool use_cxx11, ExtensibilityKind ek, FieldFilter field_filter)
+                    bool use_cxx11, ExtensibilityKind ek, FieldFilter field_filter,
+                    const char* writer_type = value_writer_type)
   {
     const std::string wrapped_name = key_only_type_name(node, type_name, field_filter, true);
     Function write("vwrite", "bool");
-    write.addArg("value_writer", "OpenDDS::DCPS::ValueWriter&");
+    write.addArg("value_writer", writer_type);
     write.addArg("value", wrapped_name);
     write.endArgs();
 
@@ -320,11 +335,12 @@ namespace {
 
   bool gen_union_i(AST_Union* u, const std::string& type_name,
                    const std::vector<AST_UnionBranch*>& branches,
-                   AST_Type* discriminator, ExtensibilityKind ek, FieldFilter filter_kind)
+                   AST_Type* discriminator, ExtensibilityKind ek, FieldFilter filter_kind,
+                   const char* writer_type = value_writer_type)
   {
     const std::string wrapped_name = key_only_type_name(u, type_name, filter_kind, true);
     Function write("vwrite", "bool");
-    write.addArg("value_writer", "OpenDDS::DCPS::ValueWriter&");
+    write.addArg("value_writer", writer_type);
     write.addArg("value", wrapped_name);
     write.endArgs();
 
@@ -411,7 +427,12 @@ bool value_writer_generator::gen_struct(AST_Structure* node,
       return false;
     }
   }
-  return true;
+
+  if (!be_global->generate_json_encoder()) {
+    return true;
+  }
+  JsonEncoderGuard json_guard;
+  return gen_struct_i(node, type_name, use_cxx11, ek, FieldFilter_All, json_encoder_type);
 }
 
 bool value_writer_generator::gen_union(AST_Union* u,
@@ -436,5 +457,10 @@ bool value_writer_generator::gen_union(AST_Union* u,
       return false;
     }
   }
-  return true;
+
+  if (!be_global->generate_json_encoder()) {
+    return true;
+  }
+  JsonEncoderGuard json_guard;
+  return gen_union_i(u, type_name, branches, discriminator, ek, FieldFilter_All, json_encoder_type);
 }
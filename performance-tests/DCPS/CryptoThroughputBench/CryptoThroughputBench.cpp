@@ -0,0 +1,194 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/security/CryptoBuiltInImpl.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <dds/DdsSecurityCoreC.h>
+
+#include <ace/Log_Msg.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+#include <ace/Thread_Manager.h>
+
+using namespace OpenDDS::DCPS;
+using namespace OpenDDS::Security;
+using namespace DDS::Security;
+
+namespace {
+
+  struct SharedSecret : SharedSecretHandle {
+    DDS::OctetSeq* challenge1() { return 0; }
+    DDS::OctetSeq* challenge2() { return 0; }
+    DDS::OctetSeq* sharedSecret() { return 0; }
+  };
+
+  // A local writer and a local reader that has matched it as a remote writer,
+  // so everything the writer encodes can be decoded by the reader.
+  struct Channel {
+    DatawriterCryptoHandle local_writer;
+    DatareaderCryptoHandle local_reader;
+    DatawriterCryptoHandle remote_writer;
+
+    bool init(CryptoBuiltInImpl& crypto, SharedSecret& secret)
+    {
+      CryptoKeyFactory& factory = crypto;
+      CryptoKeyExchange& exchange = crypto;
+      DDS::PropertySeq no_properties;
+      const EndpointSecurityAttributes esa = {
+        {false, false, false, false}, true, true, false,
+        PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ENCRYPTED |
+        PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED,
+        no_properties};
+      SecurityException ex;
+      local_writer = factory.register_local_datawriter(0, no_properties, esa, ex);
+      local_reader = factory.register_local_datareader(0, no_properties, esa, ex);
+      const ParticipantCryptoHandle remote_participant =
+        factory.register_matched_remote_participant(0, 1, 2, &secret, ex);
+      remote_writer = factory.register_matched_remote_datawriter(local_reader, remote_participant, &secret, ex);
+      DatawriterCryptoTokenSeq tokens;
+      return exchange.create_local_datawriter_crypto_tokens(tokens, local_writer, 99, ex)
+        && exchange.set_remote_datawriter_crypto_tokens(local_reader, remote_writer, tokens, ex);
+    }
+  };
+
+  enum Mode { PLAINTEXT, PAYLOAD, SUBMESSAGE };
+  const char* const mode_names[] = {"plaintext", "payload", "submessage"};
+
+  // Encode then decode one message the way a writer and reader would.
+  bool round_trip(Mode mode, CryptoTransform& crypto, const Channel& channel,
+                  const DDS::OctetSeq& plain, DDS::OctetSeq& encoded, DDS::OctetSeq& decoded)
+  {
+    SecurityException ex;
+    switch (mode) {
+    case PLAINTEXT:
+      // Without protection the transform is a copy each way.
+      encoded = plain;
+      decoded = encoded;
+      return true;
+    case PAYLOAD: {
+      DDS::OctetSeq inline_qos;
+      return crypto.encode_serialized_payload(encoded, inline_qos, plain, channel.local_writer, ex)
+        && crypto.decode_serialized_payload(decoded, encoded, inline_qos, channel.local_reader, channel.remote_writer, ex);
+    }
+    case SUBMESSAGE: {
+      const DatareaderCryptoHandleSeq all_readers;
+      CORBA::Long index = 0;
+      return crypto.encode_datawriter_submessage(encoded, plain, channel.local_writer, all_readers, index, ex)
+        && crypto.decode_datawriter_submessage(decoded, encoded, channel.local_reader, channel.remote_writer, ex);
+    }
+    }
+    return false;
+  }
+
+  struct Worker {
+    CryptoTransform* crypto;
+    Channel channel;
+    Mode mode;
+    unsigned int size;
+    int iterations;
+    bool ok;
+  };
+
+  ACE_THR_FUNC_RETURN run_worker(void* arg)
+  {
+    Worker& worker = *static_cast<Worker*>(arg);
+    DDS::OctetSeq plain(worker.size);
+    plain.length(worker.size);
+    for (unsigned int i = 0; i < worker.size; ++i) {
+      plain[i] = static_cast<CORBA::Octet>(i * 7);
+    }
+
+    DDS::OctetSeq encoded, decoded;
+    worker.ok = round_trip(worker.mode, *worker.crypto, worker.channel, plain, encoded, decoded)
+      && decoded == plain;
+    for (int i = 1; worker.ok && i < worker.iterations; ++i) {
+      worker.ok = round_trip(worker.mode, *worker.crypto, worker.channel, plain, encoded, decoded);
+    }
+    return 0;
+  }
+
+  bool run(CryptoTransform& crypto, Worker* workers, int threads, Mode mode,
+           unsigned int size, int iterations, double& mb_per_sec)
+  {
+    for (int t = 0; t < threads; ++t) {
+      workers[t].mode = mode;
+      workers[t].size = size;
+      workers[t].iterations = iterations;
+      workers[t].crypto = &crypto;
+      workers[t].ok = false;
+    }
+
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    if (threads == 1) {
+      run_worker(&workers[0]);
+    } else {
+      ACE_Thread_Manager tm;
+      for (int t = 0; t < threads; ++t) {
+        tm.spawn(run_worker, &workers[t], THR_NEW_LWP | THR_JOINABLE);
+      }
+      tm.wait();
+    }
+    const double elapsed = (MonotonicTimePoint::now() - start).to_double();
+
+    bool ok = true;
+    for (int t = 0; t < threads; ++t) {
+      ok = ok && workers[t].ok;
+    }
+    mb_per_sec = elapsed > 0 ? double(size) * iterations * threads / elapsed / 1e6 : 0.0;
+    return ok;
+  }
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int iterations = 20000;
+  int threads = 4;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == ACE_OS::strcmp(argv[i], ACE_TEXT("-i")) && i + 1 < argc) {
+      iterations = ACE_OS::atoi(argv[++i]);
+    } else if (0 == ACE_OS::strcmp(argv[i], ACE_TEXT("-t")) && i + 1 < argc) {
+      threads = ACE_OS::atoi(argv[++i]);
+    }
+  }
+  if (iterations <= 0 || threads <= 0) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: iterations and threads must be positive\n"), 1);
+  }
+
+  CryptoBuiltInImpl crypto;
+  SharedSecret secret;
+  Worker* const workers = new Worker[threads];
+  for (int t = 0; t < threads; ++t) {
+    if (!workers[t].channel.init(crypto, secret)) {
+      delete[] workers;
+      ACE_ERROR_RETURN((LM_ERROR, "ERROR: failed to set up crypto handles\n"), 1);
+    }
+  }
+
+  static const unsigned int sizes[] = {64, 1024, 8192, 60000};
+  const int thread_counts[] = {1, threads};
+
+  int status = 0;
+  for (size_t s = 0; s < sizeof sizes / sizeof sizes[0]; ++s) {
+    for (size_t tc = 0; tc < (threads > 1 ? 2u : 1u); ++tc) {
+      double results[3];
+      for (int m = PLAINTEXT; m <= SUBMESSAGE; ++m) {
+        if (!run(crypto, workers, thread_counts[tc], Mode(m), sizes[s], iterations, results[m])) {
+          ACE_ERROR((LM_ERROR, "ERROR: %C round trip failed for %u bytes\n", mode_names[m], sizes[s]));
+          status = 1;
+        }
+      }
+      ACE_DEBUG((LM_INFO, "%6u bytes %2d thread(s): plaintext %9.1f MB/s  payload %8.1f MB/s (%4.1f%%)"
+                 "  submessage %8.1f MB/s (%4.1f%%)\n",
+                 sizes[s], thread_counts[tc], results[PLAINTEXT],
+                 results[PAYLOAD], results[PLAINTEXT] > 0 ? 100 * results[PAYLOAD] / results[PLAINTEXT] : 0.0,
+                 results[SUBMESSAGE], results[PLAINTEXT] > 0 ? 100 * results[SUBMESSAGE] / results[PLAINTEXT] : 0.0));
+    }
+  }
+
+  delete[] workers;
+  return status;
+}
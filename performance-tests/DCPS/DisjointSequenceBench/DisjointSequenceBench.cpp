@@ -0,0 +1,244 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Log_Msg.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace OpenDDS::DCPS;
+
+/// The bitmap insert of DisjointSequence before it scanned a word at a
+/// time.  insert() and insert_bitmap_range() are copied verbatim from the
+/// library as it was before that change, only the class name differs.
+class BaselineSequence {
+public:
+  bool insert(SequenceNumber value)
+  {
+    return sequences_.ranges_.insert(SequenceRange(value, value)).second;
+  }
+
+  bool insert(SequenceNumber value, ACE_CDR::ULong num_bits,
+              const ACE_CDR::Long bits[]);
+
+  OPENDDS_VECTOR(SequenceRange) present_sequence_ranges() const
+  {
+    return OPENDDS_VECTOR(SequenceRange)(sequences_.ranges_.begin(), sequences_.ranges_.end());
+  }
+
+private:
+  typedef DisjointSequence::OrderedRanges<SequenceNumber> OrderedRanges;
+
+  struct RangeSet {
+    typedef OrderedRanges::Container Container;
+    RangeSet() : ranges_(OrderedRanges::range_less) {}
+    bool empty() const { return ranges_.empty(); }
+    Container ranges_;
+  };
+
+  RangeSet sequences_;
+
+  bool insert_bitmap_range(RangeSet::Container::iterator& iter,
+                           const SequenceRange& range);
+};
+
+bool
+BaselineSequence::insert(SequenceNumber value, ACE_CDR::ULong num_bits,
+                         const ACE_CDR::Long bits[])
+{
+  bool inserted = false;
+  RangeSet::Container::iterator iter = sequences_.ranges_.end();
+  bool range_start_is_valid = false;
+  SequenceNumber::Value range_start = 0;
+  const SequenceNumber::Value val = value.getValue();
+
+  // See RTPS v2.1 section 9.4.2.6 SequenceNumberSet
+  for (ACE_CDR::ULong i = 0, x = 0, bit = 0; i < num_bits; ++i, ++bit) {
+
+    if (bit == 32) bit = 0;
+
+    if (bit == 0) {
+      x = static_cast<ACE_CDR::ULong>(bits[i / 32]);
+      if (x == 0) {
+        // skip an entire Long if it's all 0's (adds 32 due to ++i)
+        i += 31;
+        bit = 31;
+        //FUTURE: this could be generalized with something like the x86 "bsr"
+        //        instruction using compiler intrinsics, VC++ _BitScanReverse()
+        //        and GCC __builtin_clz()
+        continue;
+      }
+    }
+
+    if (x & (1 << (31 - bit))) {
+      if (!range_start_is_valid) {
+        range_start = val + i;
+        range_start_is_valid = true;
+      }
+    } else if (range_start_is_valid) {
+      // this is a "0" bit and we've previously seen a "1": insert a range
+      const SequenceNumber::Value to_insert = val + i - 1;
+      if (insert_bitmap_range(iter, SequenceRange(range_start, to_insert))) {
+        inserted = true;
+      }
+      range_start = 0;
+      range_start_is_valid = false;
+
+      if (iter != sequences_.ranges_.end() && iter->second.getValue() != to_insert) {
+        // skip ahead: next gap in sequence must be past iter->second
+        ACE_CDR::ULong next_i = ACE_CDR::ULong(iter->second.getValue() - val);
+        bit = next_i % 32;
+        if (next_i / 32 != i / 32 && next_i < num_bits) {
+          x = static_cast<ACE_CDR::ULong>(bits[next_i / 32]);
+        }
+        i = next_i;
+      }
+    }
+  }
+
+  if (range_start_is_valid) {
+    // iteration finished before we saw a "0" (inside a range)
+    SequenceNumber range_end = (value + num_bits).previous();
+    if (insert_bitmap_range(iter, SequenceRange(range_start, range_end))) {
+      return true;
+    }
+  }
+  return inserted;
+}
+
+bool
+BaselineSequence::insert_bitmap_range(RangeSet::Container::iterator& iter,
+                                      const SequenceRange& range)
+{
+  // This is similar to insert_i(), except it doesn't need an O(log(n)) search
+  // of sequences_ every time to find the starting point, and it doesn't
+  // compute the 'gaps'.
+
+  const SequenceNumber::Value previous = range.first.getValue() - 1,
+    next = range.second.getValue() + 1;
+
+  if (!sequences_.empty()) {
+    if (iter == sequences_.ranges_.end()) {
+      iter = sequences_.ranges_.lower_bound(SequenceRange(0 /*ignored*/, previous));
+    } else {
+      // start where we left off last time and get the lower_bound(previous)
+      for (; iter != sequences_.ranges_.end() && iter->second < previous; ++iter) ;
+    }
+  }
+
+  if (iter == sequences_.ranges_.end() || iter->first > next) {
+    // can't combine on either side, insert a new range
+    iter = sequences_.ranges_.insert(iter, range);
+    return true;
+  }
+
+  if (iter->first <= range.first && iter->second >= range.second) {
+    // range is already covered by this DisjointSet
+    return false;
+  }
+
+  // find the right-most (highest) range we can use
+  RangeSet::Container::iterator right = iter;
+  for (; right != sequences_.ranges_.end() && right->second < next; ++right) ;
+
+  SequenceNumber high = range.second;
+  if (right != sequences_.ranges_.end()
+      && right->first <= next && right->first > range.first) {
+    high = right->second;
+    ++right;
+  }
+
+  const SequenceNumber low = (std::min)(iter->first, range.first);
+  sequences_.ranges_.erase(iter, right);
+
+  iter = sequences_.ranges_.insert(SequenceRange(low, high)).first;
+  return true;
+}
+
+namespace {
+
+  const ACE_CDR::ULong NUM_BITS = 256;
+  const ACE_CDR::ULong NUM_LONGS = NUM_BITS / 32;
+
+  struct Pattern {
+    const char* name;
+    ACE_CDR::Long bits[NUM_LONGS];
+  };
+
+  void make_patterns(Pattern patterns[4])
+  {
+    patterns[0].name = "sparse";
+    patterns[1].name = "dense";
+    patterns[2].name = "alternating";
+    patterns[3].name = "random";
+    for (ACE_CDR::ULong i = 0; i < NUM_LONGS; ++i) {
+      patterns[0].bits[i] = (i % 3 == 0) ? 0x00010000 : 0;
+      patterns[1].bits[i] = static_cast<ACE_CDR::Long>(0xFFFFFF0F);
+      patterns[2].bits[i] = static_cast<ACE_CDR::Long>(0xAAAAAAAA);
+      patterns[3].bits[i] = static_cast<ACE_CDR::Long>(
+        (static_cast<ACE_CDR::ULong>(std::rand()) << 16) ^ static_cast<ACE_CDR::ULong>(std::rand()));
+    }
+  }
+
+  template <typename Sequence>
+  double run(const Pattern& pattern, int iterations)
+  {
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    for (int i = 0; i < iterations; ++i) {
+      Sequence seq;
+      seq.insert(SequenceNumber(1));
+      seq.insert(3, NUM_BITS, pattern.bits);
+    }
+    const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+    return elapsed.to_double() * 1e9 / iterations;
+  }
+
+  bool same_result(const Pattern& pattern)
+  {
+    BaselineSequence a;
+    DisjointSequence b;
+    a.insert(SequenceNumber(1));
+    b.insert(SequenceNumber(1));
+    a.insert(3, NUM_BITS, pattern.bits);
+    b.insert(3, NUM_BITS, pattern.bits);
+    return a.present_sequence_ranges() == b.present_sequence_ranges();
+  }
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int iterations = 100000;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == ACE_OS::strcmp(argv[i], ACE_TEXT("-i")) && i + 1 < argc) {
+      iterations = ACE_OS::atoi(argv[++i]);
+    }
+  }
+  if (iterations <= 0) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: iterations must be positive\n"), 1);
+  }
+
+  Pattern patterns[4];
+  make_patterns(patterns);
+
+  int status = 0;
+  for (int p = 0; p < 4; ++p) {
+    if (!same_result(patterns[p])) {
+      ACE_ERROR((LM_ERROR, "ERROR: %C: results differ\n", patterns[p].name));
+      status = 1;
+      continue;
+    }
+    const double per_bit = run<BaselineSequence>(patterns[p], iterations);
+    const double word = run<DisjointSequence>(patterns[p], iterations);
+    ACE_DEBUG((LM_INFO, "%-12C per-bit %8.1f ns  word-parallel %8.1f ns  speedup %.2fx\n",
+               patterns[p].name, per_bit, word, word > 0 ? per_bit / word : 0.0));
+  }
+  return status;
+}
@@ -0,0 +1,146 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/GuidUtils.h>
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Log_Msg.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+
+#include <cstdlib>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+  // Per-reader state touched by an ACKNACK after the reader has been found.
+  struct Reader {
+    SequenceNumber acked;
+    DisjointSequence requests;
+  };
+
+  // Same container as RtpsUdpDataLink::ReaderInfoMap
+#ifdef ACE_HAS_CPP11
+  typedef OPENDDS_UNORDERED_MAP(GUID_t, Reader*) ReaderMap;
+#else
+  typedef OPENDDS_MAP_CMP(GUID_t, Reader*, GUID_tKeyLessThan) ReaderMap;
+#endif
+
+  // Same shape as RtpsUdpDataLink::SNRIS
+  typedef OPENDDS_SET(Reader*) ReaderSet;
+  typedef OPENDDS_MAP(SequenceNumber, ReaderSet) AckedMap;
+
+  GUID_t make_reader_guid(int i)
+  {
+    GUID_t guid = GUID_UNKNOWN;
+    for (int b = 0; b < 12; ++b) {
+      guid.guidPrefix[b] = static_cast<CORBA::Octet>(std::rand());
+    }
+    guid.entityId = ENTITYID_UNKNOWN;
+    guid.entityId.entityKey[0] = static_cast<CORBA::Octet>(i >> 8);
+    guid.entityId.entityKey[1] = static_cast<CORBA::Octet>(i);
+    guid.entityId.entityKind = ENTITYKIND_USER_READER_WITH_KEY;
+    return guid;
+  }
+
+  // One ACKNACK per reader per round, in a shuffled order.
+  void make_order(OPENDDS_VECTOR(int)& order, int readers, int rounds)
+  {
+    order.clear();
+    for (int r = 0; r < rounds; ++r) {
+      for (int i = 0; i < readers; ++i) {
+        order.push_back(i);
+      }
+    }
+    for (size_t i = order.size(); i > 1; --i) {
+      std::swap(order[i - 1], order[static_cast<size_t>(std::rand()) % i]);
+    }
+  }
+
+  double lookup(const ReaderMap& map, const OPENDDS_VECTOR(GUID_t)& guids,
+                const OPENDDS_VECTOR(int)& order, size_t& found)
+  {
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    for (size_t i = 0; i < order.size(); ++i) {
+      found += map.find(guids[order[i]]) != map.end();
+    }
+    const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+    return elapsed.to_double() * 1e9 / order.size();
+  }
+
+  // What process_acknack does with a found reader: record the NACKed
+  // sequence numbers and move the reader to its new acked sequence number.
+  double update(OPENDDS_VECTOR(Reader)& readers, AckedMap& acked,
+                const OPENDDS_VECTOR(int)& order)
+  {
+    const ACE_CDR::Long bits[1] = { static_cast<ACE_CDR::Long>(0xA0000000) };
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    for (size_t i = 0; i < order.size(); ++i) {
+      Reader& reader = readers[order[i]];
+      const SequenceNumber previous = reader.acked;
+      reader.acked = previous + 1;
+      reader.requests.insert(reader.acked + 1, 8, bits);
+      reader.requests.reset();
+      const AckedMap::iterator pos = acked.find(previous);
+      pos->second.erase(&reader);
+      if (pos->second.empty()) {
+        acked.erase(pos);
+      }
+      acked[reader.acked].insert(&reader);
+    }
+    const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+    return elapsed.to_double() * 1e9 / order.size();
+  }
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int rounds = 1000;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == ACE_OS::strcmp(argv[i], ACE_TEXT("-i")) && i + 1 < argc) {
+      rounds = ACE_OS::atoi(argv[++i]);
+    }
+  }
+  if (rounds <= 0) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: iterations must be positive\n"), 1);
+  }
+
+  static const int reader_counts[] = { 10, 100, 800, 4000 };
+  int status = 0;
+  for (size_t c = 0; c < sizeof reader_counts / sizeof reader_counts[0]; ++c) {
+    const int count = reader_counts[c];
+
+    OPENDDS_VECTOR(GUID_t) guids;
+    OPENDDS_VECTOR(Reader) readers(count);
+    ReaderMap map;
+    AckedMap acked;
+    for (int i = 0; i < count; ++i) {
+      guids.push_back(make_reader_guid(i));
+      map[guids.back()] = &readers[i];
+      readers[i].acked = SequenceNumber(1);
+      acked[readers[i].acked].insert(&readers[i]);
+    }
+
+    OPENDDS_VECTOR(int) order;
+    make_order(order, count, rounds);
+
+    size_t found = 0;
+    const double lookup_ns = lookup(map, guids, order, found);
+    const double update_ns = update(readers, acked, order);
+    if (found != order.size()) {
+      ACE_ERROR((LM_ERROR, "ERROR: %d readers: lookup failed\n", count));
+      status = 1;
+      continue;
+    }
+    ACE_DEBUG((LM_INFO, "%5d readers  lookup %7.1f ns  update %7.1f ns  lookup share %4.1f%%\n",
+               count, lookup_ns, update_ns,
+               lookup_ns + update_ns > 0 ? 100 * lookup_ns / (lookup_ns + update_ns) : 0.0));
+  }
+  return status;
+}
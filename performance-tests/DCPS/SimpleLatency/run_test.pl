@@ -16,14 +16,28 @@ $dcpsrepo_ior = "repo.ior";
 $repo_bit_conf = "-NOBITS";
 $app_bit_conf = "-DCPSBit 0";
 
+# Transport selection: tcp (default), udp, rtps, or busy_poll (rtps_udp with
+# the busy-poll receive thread).  Compare rtps and busy_poll to see the
+# latency difference of the receive modes.
+%transport_opts = ("tcp" => "", "udp" => "-u", "rtps" => "-r", "busy_poll" => "-b");
+$transport = "tcp";
+if ($#ARGV >= 0) {
+    $transport = $ARGV[0];
+}
+if (!exists $transport_opts{$transport}) {
+    print STDERR "ERROR: unknown transport $transport\n";
+    exit 1;
+}
+$transport_opt = $transport_opts{$transport};
+
 unlink $dcpsrepo_ior;
 
 $DCPSREPO = PerlDDS::create_process ("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
                                   "$repo_bit_conf -o $dcpsrepo_ior ");
 
-$Subscriber = PerlDDS::create_process ("dds_sub", "$app_bit_conf");
+$Subscriber = PerlDDS::create_process ("dds_sub", "$app_bit_conf $transport_opt");
 
-$Publisher = PerlDDS::create_process ("dds_pub", "$app_bit_conf -s 200 -c 10000");
+$Publisher = PerlDDS::create_process ("dds_pub", "$app_bit_conf $transport_opt -s 200 -c 10000");
 
 $DCPSREPO->Spawn ();
 if (PerlACE::waitforfile_timed ($dcpsrepo_ior, 30) == -1) {
@@ -12,6 +12,11 @@
 #include <dds/DCPS/SubscriberImpl.h>
 #include <dds/DCPS/transport/framework/TransportRegistry.h>
 #include <dds/DCPS/transport/framework/TransportExceptions.h>
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpInst.h>
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpInst_rch.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
 #include <ace/streams.h>
 
 #include "ace/Get_Opt.h"
@@ -65,6 +70,8 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
     TheParticipantFactoryWithArgs(argc, argv);
 
   bool useTCP = true;
+  bool useRtps = false;
+  bool busyPoll = false;
   bool useZeroCopyRead = false;
   DomainId_t myDomain = 111;
 
@@ -72,7 +79,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
   std::setbuf( stdout, NULL ); /* no buffering for standard-out */
   #endif
 
-  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("c:ut"));
+  ACE_Get_Opt get_opts(argc, argv, ACE_TEXT("c:utrb"));
   int ich;
   while ((ich = get_opts()) != EOF) {
     switch (ich) {
@@ -86,6 +93,15 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
       case 'u': /* u specifies that UDP should be used */
         useTCP = false;
         break;
+      case 'r': /* r specifies that RTPS/UDP should be used */
+        useTCP = false;
+        useRtps = true;
+        break;
+      case 'b': /* b specifies RTPS/UDP with busy-poll receive */
+        useTCP = false;
+        useRtps = true;
+        busyPoll = true;
+        break;
       case 't': /* t specifies that zero copy read should be used */
         useZeroCopyRead = true;
         break;
@@ -122,6 +138,13 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
   if (useTCP) {
     transport->instances_.push_back(
       TheTransportRegistry->create_inst("tcp", "tcp"));
+  } else if (useRtps) {
+    OpenDDS::DCPS::TransportInst_rch inst =
+      TheTransportRegistry->create_inst("rtps_udp", "rtps_udp");
+    OpenDDS::DCPS::RtpsUdpInst_rch rtps_inst =
+      OpenDDS::DCPS::static_rchandle_cast<OpenDDS::DCPS::RtpsUdpInst>(inst);
+    rtps_inst->busy_poll(busyPoll);
+    transport->instances_.push_back(inst);
   } else {
     transport->instances_.push_back(
       TheTransportRegistry->create_inst("udp", "udp"));
@@ -10,6 +10,7 @@
 #include <dds/DCPS/XTypes/DynamicDataImpl.h>
 
 #include <fstream>
+#include <string>
 
 #if OPENDDS_HAS_JSON_VALUE_WRITER
 TEST(VreadVwriteTest, ParseTest)
@@ -294,6 +295,42 @@ TEST(VreadVwriteTest, StaticSerializeTest)
   //std::cout << output << std::endl;
 }
 
+TEST(VreadVwriteTest, JsonEncoderOverload)
+{
+  Mod::Sample sample;
+  initialize_sample(sample);
+
+  // Only compiles if opendds_idl generated the overloads for JsonEncoder.
+  bool (*const encoder_vwrite)(OpenDDS::DCPS::JsonEncoder&, const Mod::Sample&) =
+    &OpenDDS::DCPS::vwrite;
+  bool (*const union_vwrite)(OpenDDS::DCPS::JsonEncoder&, const Mod::NoExplicitKeyUnion&) =
+    &OpenDDS::DCPS::vwrite;
+
+  OpenDDS::DCPS::JsonEncoder encoder;
+  ASSERT_TRUE(encoder_vwrite(encoder, sample));
+  const std::string from_encoder = encoder.c_str();
+
+  // Same output as the ValueWriter overload
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  OpenDDS::DCPS::JsonValueWriter<rapidjson::Writer<rapidjson::StringBuffer> > jvw(writer);
+  ASSERT_TRUE(vwrite(static_cast<OpenDDS::DCPS::ValueWriter&>(jvw), sample));
+  EXPECT_EQ(std::string(buffer.GetString()), from_encoder);
+
+  rapidjson::Document document;
+  document.Parse(from_encoder.c_str());
+  verify_parse_result(document);
+
+  Mod::NoExplicitKeyUnion u;
+  u.c('x');
+  encoder.clear();
+  ASSERT_TRUE(union_vwrite(encoder, u));
+  buffer.Clear();
+  writer.Reset(buffer);
+  ASSERT_TRUE(vwrite(static_cast<OpenDDS::DCPS::ValueWriter&>(jvw), u));
+  EXPECT_STREQ(buffer.GetString(), encoder.c_str());
+}
+
 template <typename T>
 void write_helper(const T& sample, CORBA::String_out out)
 {
@@ -429,6 +429,162 @@ bool pubsub(OpenDDS::DCPS::Discovery_rch disc, CORBA::ORB_var orb)
   return true;
 }
 
+/// Add several DataReaders and then DataWriters that match all of them, and
+/// then another DataReader.  The InfoRepo tells each new endpoint about all of
+/// the existing ones in one add_associations() call, and the existing
+/// endpoints of each participant about the new one in one call.  One of the
+/// DataReaders is in another participant.
+void batched_associations(OpenDDS::DCPS::Discovery_rch disc, CORBA::ORB_var orb)
+{
+  ACE_DEBUG((LM_DEBUG,
+             ACE_TEXT("batched associations test\n")));
+
+  static const size_t COUNT = 3;
+  const CORBA::Long domain = 10;
+  const unsigned int max_delay = 10;
+
+  ::DDS::DomainParticipantQos_var partQos = new ::DDS::DomainParticipantQos;
+  *partQos = TheServiceParticipant->initial_DomainParticipantQos();
+  const OpenDDS::DCPS::GUID_t pubPartId =
+    disc->add_domain_participant(domain, partQos, OpenDDS::DCPS::make_rch<OpenDDS::XTypes::TypeLookupService>()).id;
+  const OpenDDS::DCPS::GUID_t subPartId =
+    disc->add_domain_participant(domain, partQos, OpenDDS::DCPS::make_rch<OpenDDS::XTypes::TypeLookupService>()).id;
+  const OpenDDS::DCPS::GUID_t otherPartId =
+    disc->add_domain_participant(domain, partQos, OpenDDS::DCPS::make_rch<OpenDDS::XTypes::TypeLookupService>()).id;
+  if (OpenDDS::DCPS::GUID_UNKNOWN == pubPartId || OpenDDS::DCPS::GUID_UNKNOWN == subPartId ||
+      OpenDDS::DCPS::GUID_UNKNOWN == otherPartId) {
+    failed = true;
+    ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: batched_associations: add_domain_participant failed!\n")));
+    return;
+  }
+
+  struct Callbacks : public OpenDDS::DCPS::TopicCallbacks {
+    void inconsistent_topic(int /*count*/) {}
+  } callbacks;
+
+  ::DDS::TopicQos_var topicQos = new ::DDS::TopicQos;
+  *topicQos = TheServiceParticipant->initial_TopicQos();
+  OpenDDS::DCPS::GUID_t pubTopicId = OpenDDS::DCPS::GUID_UNKNOWN;
+  OpenDDS::DCPS::GUID_t subTopicId = OpenDDS::DCPS::GUID_UNKNOWN;
+  OpenDDS::DCPS::GUID_t otherTopicId = OpenDDS::DCPS::GUID_UNKNOWN;
+  if (disc->assert_topic(pubTopicId, domain, pubPartId, "BatchTopic", "BatchType",
+                         topicQos.in(), false, &callbacks) != OpenDDS::DCPS::CREATED ||
+      disc->assert_topic(subTopicId, domain, subPartId, "BatchTopic", "BatchType",
+                         topicQos.in(), false, &callbacks) != OpenDDS::DCPS::CREATED ||
+      disc->assert_topic(otherTopicId, domain, otherPartId, "BatchTopic", "BatchType",
+                         topicQos.in(), false, &callbacks) != OpenDDS::DCPS::CREATED) {
+    failed = true;
+    ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: batched_associations: topic creation failed!\n")));
+    return;
+  }
+
+  OpenDDS::DCPS::TransportLocatorSeq tii;
+  tii.length(1);
+  tii[0].transport_type = "fake transport for test";
+
+  OpenDDS::XTypes::TypeInformation type_info;
+  type_info.minimal.typeid_with_size.typeobject_serialized_size = 0;
+  type_info.minimal.dependent_typeid_count = 0;
+  type_info.complete.dependent_typeid_count = 0;
+
+  ::DDS::DataReaderQos_var drQos = new ::DDS::DataReaderQos;
+  *drQos = TheServiceParticipant->initial_DataReaderQos();
+  drQos->reliability.kind = ::DDS::RELIABLE_RELIABILITY_QOS;
+  drQos->representation.value.length(1);
+  drQos->representation.value[0] = OpenDDS::DCPS::UNALIGNED_CDR_DATA_REPRESENTATION;
+  ::DDS::SubscriberQos_var subQos = new ::DDS::SubscriberQos;
+  *subQos = TheServiceParticipant->initial_SubscriberQos();
+
+  ::DDS::DataWriterQos_var dwQos = new ::DDS::DataWriterQos;
+  *dwQos = TheServiceParticipant->initial_DataWriterQos();
+  dwQos->reliability.kind = ::DDS::RELIABLE_RELIABILITY_QOS;
+  dwQos->representation.value.length(1);
+  dwQos->representation.value[0] = OpenDDS::DCPS::UNALIGNED_CDR_DATA_REPRESENTATION;
+  ::DDS::PublisherQos_var pQos = new ::DDS::PublisherQos;
+  *pQos = TheServiceParticipant->initial_PublisherQos();
+
+  TAO_DDS_DCPSDataReader_i readers[COUNT + 1];
+  for (size_t i = 0; i < COUNT + 1; ++i) {
+    readers[i].domainId_ = domain;
+    readers[i].participantId_ = subPartId;
+  }
+  TAO_DDS_DCPSDataReader_i other;
+  other.domainId_ = domain;
+  other.participantId_ = otherPartId;
+  TAO_DDS_DCPSDataWriter_i writers[COUNT];
+
+  for (size_t i = 0; i < COUNT; ++i) {
+    disc->add_subscription(domain, subPartId, subTopicId, rchandle_from(&readers[i]),
+                           drQos.in(), tii, subQos.in(), "", "", DDS::StringSeq(), type_info);
+    if (OpenDDS::DCPS::GUID_UNKNOWN == readers[i].guid()) {
+      failed = true;
+      ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: batched_associations: add_subscription failed!\n")));
+    }
+  }
+  disc->add_subscription(domain, otherPartId, otherTopicId, rchandle_from(&other),
+                         drQos.in(), tii, subQos.in(), "", "", DDS::StringSeq(), type_info);
+  if (OpenDDS::DCPS::GUID_UNKNOWN == other.guid()) {
+    failed = true;
+    ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: batched_associations: add_subscription failed!\n")));
+  }
+
+  const std::vector<DiscReceivedCalls::Called> one(1, DiscReceivedCalls::ADD_ASSOC);
+  const std::vector<DiscReceivedCalls::Called> all(COUNT, DiscReceivedCalls::ADD_ASSOC);
+  const std::vector<DiscReceivedCalls::Called> all_readers(COUNT + 1, DiscReceivedCalls::ADD_ASSOC);
+
+  for (size_t w = 0; w < COUNT; ++w) {
+    ACE_DEBUG((LM_DEBUG,
+               ACE_TEXT("adding publication matching %u subscriptions\n"), static_cast<unsigned int>(COUNT + 1)));
+    disc->add_publication(domain, pubPartId, pubTopicId, rchandle_from(&writers[w]),
+                          dwQos.in(), tii, pQos.in(), type_info);
+    if (OpenDDS::DCPS::GUID_UNKNOWN == writers[w].guid()) {
+      failed = true;
+      ACE_ERROR((LM_ERROR, ACE_TEXT("ERROR: batched_associations: add_publication failed!\n")));
+    }
+
+    // The writer is told about every reader, and each reader about the writer.
+    if (!writers[w].received().expect(orb, max_delay, all_readers)) {
+      failed = true;
+    }
+    for (size_t r = 0; r < COUNT; ++r) {
+      if (!readers[r].received().expect(orb, max_delay, one)) {
+        failed = true;
+      }
+    }
+    if (!other.received().expect(orb, max_delay, one)) {
+      failed = true;
+    }
+  }
+
+  ACE_DEBUG((LM_DEBUG,
+             ACE_TEXT("adding subscription matching %u publications\n"), static_cast<unsigned int>(COUNT)));
+  TAO_DDS_DCPSDataReader_i& late = readers[COUNT];
+  disc->add_subscription(domain, subPartId, subTopicId, rchandle_from(&late),
+                         drQos.in(), tii, subQos.in(), "", "", DDS::StringSeq(), type_info);
+  if (!late.received().expect(orb, max_delay, all)) {
+    failed = true;
+  }
+  for (size_t w = 0; w < COUNT; ++w) {
+    if (!writers[w].received().expect(orb, max_delay, one)) {
+      failed = true;
+    }
+  }
+
+  for (size_t w = 0; w < COUNT; ++w) {
+    disc->remove_publication(domain, pubPartId, writers[w].guid());
+  }
+  for (size_t r = 0; r < COUNT + 1; ++r) {
+    disc->remove_subscription(domain, subPartId, readers[r].guid());
+  }
+  disc->remove_subscription(domain, otherPartId, other.guid());
+  disc->remove_topic(domain, pubPartId, pubTopicId);
+  disc->remove_topic(domain, subPartId, subTopicId);
+  disc->remove_topic(domain, otherPartId, otherTopicId);
+  disc->remove_domain_participant(domain, otherPartId);
+  disc->remove_domain_participant(domain, subPartId);
+  disc->remove_domain_participant(domain, pubPartId);
+}
+
 int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
 {
   if (parse_args(argc, argv) != 0)
@@ -488,6 +644,11 @@ int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           return 1;
         }
 
+      if (!use_rtps)
+        {
+          batched_associations(disc, orb);
+        }
+
       disc.reset();
       obj = 0;
       poa = 0;
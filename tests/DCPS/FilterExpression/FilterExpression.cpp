@@ -163,6 +163,65 @@ bool testEval() {
 
 }
 
+bool testBatchEval()
+{
+  using namespace OpenDDS::DCPS;
+  static const Encoding enc_xcdr2(Encoding::KIND_XCDR2);
+  static const char* names[] = {"Adam", "Bob", "Carol", "Dave"};
+  static const size_t count = 12;
+
+  TBTD samples[count];
+  const void* data[count];
+  Message_Block_Ptr serialized[count];
+  ACE_Message_Block* serialized_data[count];
+  for (size_t i = 0; i < count; ++i) {
+    samples[i].name = names[i % 4];
+    samples[i].durability.kind = i % 2 ? DDS::PERSISTENT_DURABILITY_QOS : DDS::VOLATILE_DURABILITY_QOS;
+    samples[i].durability_service.history_depth = static_cast<CORBA::Long>(i);
+    samples[i].durability_service.service_cleanup_delay.sec = static_cast<CORBA::Long>(count - i);
+    samples[i].durability_service.service_cleanup_delay.nanosec = static_cast<CORBA::ULong>(i * 10);
+    data[i] = &samples[i];
+    serialized[i].reset(serialize(enc_xcdr2, samples[i]));
+    serialized_data[i] = serialized[i].get();
+  }
+
+  DDS::StringSeq params;
+  params.length(1);
+  params[0] = "3";
+
+  static const char* filters[] = {"durability_service.history_depth > %0",
+                                  "%0 >= durability_service.history_depth",
+                                  "durability_service.history_depth BETWEEN 2 AND 5",
+                                  "durability_service.history_depth NOT BETWEEN 2 AND %0",
+                                  "name LIKE 'A%' OR durability_service.history_depth < 2",
+                                  "NOT (durability.kind = 'PERSISTENT_DURABILITY_QOS') AND durability_service.service_cleanup_delay.nanosec <> 40",
+                                  "durability_service.service_cleanup_delay.sec < durability_service.service_cleanup_delay.nanosec",
+                                  "durability_service.history_depth > 1 AND MOD(durability_service.history_depth, 3) = 0"};
+
+  TBTDTypeSupportImpl tsStat;
+  bool ok = true;
+  for (size_t f = 0; f < sizeof filters / sizeof filters[0]; ++f) {
+    try {
+      FilterEvaluator fe(filters[f], false);
+      FilterEvaluator::BatchResults results;
+      fe.eval(data, count, getMetaStruct<TBTD>(), params, results);
+      FilterEvaluator::BatchResults serialized_results;
+      fe.eval(serialized_data, count, enc_xcdr2, tsStat, params, serialized_results);
+      for (size_t i = 0; i < count; ++i) {
+        const bool expected = fe.eval(samples[i], params);
+        if (results[i] != expected || serialized_results[i] != expected) {
+          std::cout << filters[f] << " =batch=> wrong result for sample " << i << std::endl;
+          ok = false;
+        }
+      }
+    } catch (const std::exception& e) {
+      std::cout << filters[f] << " =batch=> exception " << e.what() << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
 // parsing test helpers
 namespace yard_test {
 
@@ -321,6 +380,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 
   bool ok = testParsing();
   ok &= testEval();
+  ok &= testBatchEval();
 
   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -142,9 +142,6 @@ public:
                              bool&,
                              bool&,
                              OpenDDS::DCPS::MarshalingType) {}
-  bool contains_sample_filtered(DDS::SampleStateMask, DDS::ViewStateMask,
-    DDS::InstanceStateMask, const OpenDDS::DCPS::FilterEvaluator&,
-    const DDS::StringSeq&) { return true; }
   virtual void lookup_instance(const OpenDDS::DCPS::ReceivedDataSample&,
                                OpenDDS::DCPS::SubscriptionInstance_rch&) {}
 
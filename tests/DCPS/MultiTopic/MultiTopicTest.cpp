@@ -4,6 +4,7 @@
 #include <dds/DCPS/BuiltInTopicUtils.h>
 #include <dds/DCPS/Service_Participant.h>
 #include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/MultiTopicDataReaderBase.h>
 #include <dds/DCPS/PublisherImpl.h>
 #include <dds/DCPS/SubscriberImpl.h>
 #include <dds/DCPS/WaitSet.h>
@@ -578,6 +579,20 @@ bool run_multitopic_test(const Publisher_var& pub, const Subscriber_var& sub)
       return false;
     }
 
+    // More is joined with Location and FlightPlan on departure_date, which
+    // is only part of their key, so those joins use an index.
+    MultiTopicDataReaderBase* mtdr = dynamic_cast<MultiTopicDataReaderBase*>(dr.in());
+    if (!mtdr) {
+      throw std::runtime_error("failed to get MultiTopicDataReaderBase");
+    }
+    const MultiTopicDataReaderBase::JoinStats join_stats = mtdr->join_stats();
+    if (join_stats.indexes != 2 || join_stats.index_lookups == 0) {
+      std::cerr << "ERROR: expected 2 join indexes and lookups in them, got "
+        << join_stats.indexes << " indexes and " << join_stats.index_lookups
+        << " lookups" << std::endl;
+      return false;
+    }
+
     // Check return get_key_value
     // Regression Test for https://github.com/OpenDDS/OpenDDS/issues/592
     {
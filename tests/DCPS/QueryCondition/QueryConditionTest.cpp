@@ -19,6 +19,7 @@
 #endif
 
 #include <ace/Argv_Type_Converter.h>
+#include <ace/OS_NS_unistd.h>
 
 #include <cstdlib>
 #include <iostream>
@@ -76,18 +77,40 @@ struct Readers {
     return msg_reader_->read_w_condition(data, infoseq, LENGTH_UNLIMITED, cond);
   }
 
-  DDS::ReturnCode_t take(MessageSeq& data, DDS::SampleInfoSeq& info, DDS::ReadCondition* cond)
+  DDS::ReturnCode_t read(MessageSeq& data, DDS::SampleInfoSeq& info, DDS::ReadCondition* cond,
+                         CORBA::Long max_samples = LENGTH_UNLIMITED)
   {
+    // Sequences that own buffers would limit the samples to their maximum.
+    data = MessageSeq();
+    info = DDS::SampleInfoSeq();
     if (dynamic) {
       DynamicDataSeq dyn_data;
-      const DDS::ReturnCode_t ret = dyn_reader_->take_w_condition(dyn_data, info, LENGTH_UNLIMITED, cond);
+      const DDS::ReturnCode_t ret = dyn_reader_->read_w_condition(dyn_data, info, max_samples, cond);
       if (ret == RETCODE_OK) {
         copy(data, dyn_data, info);
       }
       return ret;
     }
 
-    return msg_reader_->take_w_condition(data, info, LENGTH_UNLIMITED, cond);
+    return msg_reader_->read_w_condition(data, info, max_samples, cond);
+  }
+
+  DDS::ReturnCode_t take(MessageSeq& data, DDS::SampleInfoSeq& info, DDS::ReadCondition* cond,
+                         CORBA::Long max_samples = LENGTH_UNLIMITED)
+  {
+    // Sequences that own buffers would limit the samples to their maximum.
+    data = MessageSeq();
+    info = DDS::SampleInfoSeq();
+    if (dynamic) {
+      DynamicDataSeq dyn_data;
+      const DDS::ReturnCode_t ret = dyn_reader_->take_w_condition(dyn_data, info, max_samples, cond);
+      if (ret == RETCODE_OK) {
+        copy(data, dyn_data, info);
+      }
+      return ret;
+    }
+
+    return msg_reader_->take_w_condition(data, info, max_samples, cond);
   }
 
   DDS::ReturnCode_t take_next_sample(Message& data, DDS::SampleInfo& info)
@@ -833,6 +856,212 @@ bool run_change_parameter_test(const MessageTypeSupport_var& ts, const Publisher
   return true;
 }
 
+bool write_named(const MessageDataWriter_var& mdw, CORBA::Long key, CORBA::Long iteration, char letter)
+{
+  Message sample;
+  sample.key = key;
+  sample.iteration = iteration;
+  sample.name = "data_X";
+  sample.name.inout()[5] = letter;
+  sample.nest.value = B;
+  return mdw->write(sample, HANDLE_NIL) == RETCODE_OK;
+}
+
+/// Read with cond until it returns expected samples, which are then in data.
+bool read_until(Readers& readers, ReadCondition* cond, CORBA::ULong expected, MessageSeq& data)
+{
+  for (int i = 0; i < 100; ++i) {
+    SampleInfoSeq info;
+    const ReturnCode_t ret = readers.read(data, info, cond);
+    if (ret != RETCODE_OK && ret != RETCODE_NO_DATA) {
+      cerr << "ERROR: read_until: read_w_condition returned " << retcode_to_string(ret) << endl;
+      return false;
+    }
+    if (ret == RETCODE_OK && data.length() == expected) {
+      return true;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  }
+  cerr << "ERROR: read_until: expected " << expected << " samples, got " << data.length() << endl;
+  return false;
+}
+
+/// Check that data has the samples with the names ending in the letters of
+/// expected, in that order.
+bool check_names(const char* test, const MessageSeq& data, const std::string& expected)
+{
+  std::string actual;
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    actual += data[i].name.in()[5];
+  }
+  if (actual != expected) {
+    cerr << "ERROR: " << test << ": expected samples " << expected << " got " << actual << endl;
+    return false;
+  }
+  return true;
+}
+
+bool run_order_index_test(const MessageTypeSupport_var& ts, const Publisher_var& pub,
+  const Subscriber_var& sub)
+{
+  DataWriter_var dw;
+  DataReader_var dr;
+  if (!test_setup(ts, pub, sub, "MyTopic4", dw, dr)) {
+    cerr << "ERROR: run_order_index_test: setup failed" << endl;
+    return false;
+  }
+
+  // Created before there are samples so that they're added to the ORDER BY
+  // index as they arrive.
+  DDS::StringSeq params(1);
+  params.length(1);
+  params[0] = "0";
+  ReadCondition_var dr_qc = dr->create_querycondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ALIVE_INSTANCE_STATE, "iteration >= %0 ORDER BY name", params);
+  if (!dr_qc) {
+    cerr << "ERROR: run_order_index_test: failed to create QueryCondition" << endl;
+    return false;
+  }
+  QueryCondition_var query_cond = QueryCondition::_narrow(dr_qc);
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Readers readers(dr);
+  const char letters[] = "HCJAFDIBGE";
+  bool passed = true;
+
+  for (CORBA::Long i = 0; i < 5; ++i) {
+    if (!write_named(mdw, i, i, letters[i])) return false;
+  }
+  MessageSeq data;
+  passed &= read_until(readers, dr_qc, 5, data) && check_names("first read", data, "ACFHJ");
+
+  for (CORBA::Long i = 5; i < 10; ++i) {
+    if (!write_named(mdw, i, i, letters[i])) return false;
+  }
+  passed &= read_until(readers, dr_qc, 10, data) && check_names("added", data, "ABCDEFGHIJ");
+
+  // The results kept with the samples are the same on the next read.
+  SampleInfoSeq info;
+  passed &= readers.read(data, info, dr_qc) == RETCODE_OK
+    && check_names("read again", data, "ABCDEFGHIJ");
+  if (!query_cond->get_trigger_value()) {
+    cerr << "ERROR: run_order_index_test: trigger value should be true" << endl;
+    passed = false;
+  }
+
+  // New parameters replace the kept results and the index.
+  params[0] = "5";
+  if (query_cond->set_query_parameters(params) != RETCODE_OK) {
+    cerr << "ERROR: run_order_index_test: set_query_parameters failed" << endl;
+    return false;
+  }
+  passed &= readers.read(data, info, dr_qc) == RETCODE_OK
+    && check_names("new parameters", data, "BDEGI");
+
+  params[0] = "10";
+  query_cond->set_query_parameters(params);
+  if (query_cond->get_trigger_value()) {
+    cerr << "ERROR: run_order_index_test: trigger value should be false" << endl;
+    passed = false;
+  }
+  if (readers.read(data, info, dr_qc) != RETCODE_NO_DATA) {
+    cerr << "ERROR: run_order_index_test: no sample should match" << endl;
+    passed = false;
+  }
+
+  params[0] = "0";
+  query_cond->set_query_parameters(params);
+
+  // Fewer than the matching samples are taken from the start of the index.
+  passed &= readers.read(data, info, dr_qc, 3) == RETCODE_OK
+    && check_names("max_samples", data, "ABC");
+  passed &= readers.take(data, info, dr_qc, 3) == RETCODE_OK
+    && check_names("take", data, "ABC");
+
+  // Taken samples are removed from the index and new ones are put in order.
+  passed &= readers.read(data, info, dr_qc) == RETCODE_OK
+    && check_names("after take", data, "DEFGHIJ");
+  if (!write_named(mdw, 10, 10, 'A')) return false;
+  passed &= read_until(readers, dr_qc, 8, data) && check_names("after write", data, "ADEFGHIJ");
+
+  dr->delete_readcondition(dr_qc);
+  if (!test_cleanup(pub, sub, dw, dr)) {
+    cerr << "ERROR: run_order_index_test: cleanup failed" << endl;
+    return false;
+  }
+  return passed;
+}
+
+bool run_order_sort_fallback_test(const MessageTypeSupport_var& ts, const Publisher_var& pub,
+  const Subscriber_var& sub)
+{
+  DataWriter_var dw;
+  DataReader_var dr;
+  if (!test_setup(ts, pub, sub, "MyTopic5", dw, dr)) {
+    cerr << "ERROR: run_order_sort_fallback_test: setup failed" << endl;
+    return false;
+  }
+
+  DDS::StringSeq empty_query_params;
+  ReadCondition_var all_qc = dr->create_querycondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ALIVE_INSTANCE_STATE, "iteration >= 0 ORDER BY name", empty_query_params);
+  ReadCondition_var not_read_qc = dr->create_querycondition(NOT_READ_SAMPLE_STATE,
+    ANY_VIEW_STATE, ALIVE_INSTANCE_STATE, "iteration >= 0 ORDER BY name", empty_query_params);
+  ReadCondition_var sentinel_qc = dr->create_querycondition(ANY_SAMPLE_STATE,
+    ANY_VIEW_STATE, ALIVE_INSTANCE_STATE, "iteration < 0", empty_query_params);
+  if (!all_qc || !not_read_qc || !sentinel_qc) {
+    cerr << "ERROR: run_order_sort_fallback_test: failed to create QueryCondition" << endl;
+    return false;
+  }
+
+  MessageDataWriter_var mdw = MessageDataWriter::_narrow(dw);
+  Readers readers(dr);
+  bool passed = true;
+
+  // Mark 20 samples as read.
+  for (CORBA::Long i = 0; i < 20; ++i) {
+    if (!write_named(mdw, i, i, static_cast<char>('C' + i))) return false;
+  }
+  MessageSeq data;
+  passed &= read_until(readers, all_qc, 20, data)
+    && check_names("all", data, "CDEFGHIJKLMNOPQRSTUV");
+
+  // The sentinel doesn't match the ORDER BY conditions and arrives after
+  // the other samples, so waiting for it doesn't read them.
+  if (!write_named(mdw, 20, 20, 'Z')
+      || !write_named(mdw, 21, 21, 'B')
+      || !write_named(mdw, 22, -1, 'A')) {
+    return false;
+  }
+  WaitSet_var ws = new WaitSet;
+  ws->attach_condition(sentinel_qc);
+  ConditionSeq active;
+  if (ws->wait(active, max_wait_time) != RETCODE_OK) {
+    cerr << "ERROR: run_order_sort_fallback_test: sentinel wasn't received" << endl;
+    passed = false;
+  }
+  ws->detach_condition(sentinel_qc);
+
+  // The 2 unread samples are few compared to the 22 in the ORDER BY index,
+  // so they're sorted instead of found by walking the index.
+  SampleInfoSeq info;
+  passed &= readers.read(data, info, not_read_qc, 1) == RETCODE_OK
+    && check_names("unread max_samples", data, "B");
+  passed &= readers.read(data, info, not_read_qc) == RETCODE_OK
+    && check_names("unread", data, "Z");
+  passed &= readers.read(data, info, all_qc) == RETCODE_OK
+    && check_names("all after unread", data, "BCDEFGHIJKLMNOPQRSTUVZ");
+
+  dr->delete_readcondition(all_qc);
+  dr->delete_readcondition(not_read_qc);
+  dr->delete_readcondition(sentinel_qc);
+  if (!test_cleanup(pub, sub, dw, dr)) {
+    cerr << "ERROR: run_order_sort_fallback_test: cleanup failed" << endl;
+    return false;
+  }
+  return passed;
+}
+
 bool run_single_dispose_filter_test(const MessageTypeSupport_var& ts, const Publisher_var& pub,
   const Subscriber_var& sub,
   const char* query, bool expect_dispose)
@@ -1002,6 +1231,8 @@ int run_test(int argc, ACE_TCHAR* argv[])
   passed &= run_change_parameter_test(ts, pub, sub);
   passed &= run_complex_filtering_test(ts, pub, sub);
   passed &= run_dispose_filter_tests(ts, pub, sub);
+  passed &= run_order_index_test(ts, pub, sub);
+  passed &= run_order_sort_fallback_test(ts, pub, sub);
 
   pub = 0;
   ts = 0;
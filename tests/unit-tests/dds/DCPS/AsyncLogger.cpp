@@ -0,0 +1,203 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/AsyncLogger.h>
+
+#ifdef ACE_HAS_CPP11
+
+#include <dds/DCPS/GuidConverter.h>
+#include <dds/DCPS/LogAddr.h>
+
+#include <ace/Log_Msg_Callback.h>
+#include <ace/Log_Record.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  String format(const AsyncLogRecord& record)
+  {
+    String out;
+    record.format_to(out, "42");
+    return out;
+  }
+
+  class Capture : public ACE_Log_Msg_Callback {
+  public:
+    Capture()
+    {
+      ACE_LOG_MSG->msg_callback(this);
+      ACE_LOG_MSG->set_flags(ACE_Log_Msg::MSG_CALLBACK);
+    }
+
+    ~Capture()
+    {
+      ACE_LOG_MSG->clr_flags(ACE_Log_Msg::MSG_CALLBACK);
+      ACE_LOG_MSG->msg_callback(0);
+    }
+
+    void log(ACE_Log_Record& log_record)
+    {
+      messages.push_back(ACE_TEXT_ALWAYS_CHAR(log_record.msg_data()));
+    }
+
+    OPENDDS_VECTOR(String) messages;
+  };
+}
+
+TEST(dds_DCPS_AsyncLogger, format_numbers)
+{
+  AsyncLogRecord record;
+  record.start(LM_DEBUG, "%d %5u %-4x| %q %B %.2f %c %% %ld %Lu");
+  record.add(-3);
+  record.add(7u);
+  record.add(255);
+  record.add(ACE_INT64(-1234567890123LL));
+  record.add(size_t(12));
+  record.add(3.14159);
+  record.add('z');
+  record.add(-9L);
+  record.add(10ul);
+  EXPECT_EQ(format(record), "-3     7 ff  | -1234567890123 12 3.14 z % -9 10");
+}
+
+TEST(dds_DCPS_AsyncLogger, format_strings)
+{
+  AsyncLogRecord record;
+  record.start(LM_DEBUG, "(%t) %C|%-5s|%.3C|%C");
+  const String temporary("copied");
+  record.add(temporary.c_str());
+  record.add("ab");
+  record.add("truncate");
+  record.add(static_cast<const char*>(0));
+  EXPECT_EQ(format(record), "(42) copied|ab   |tru|(null)");
+}
+
+TEST(dds_DCPS_AsyncLogger, format_missing_and_unknown)
+{
+  AsyncLogRecord record;
+  record.start(LM_DEBUG, "%d %C %N %");
+  EXPECT_EQ(format(record), "0 (null) %N %");
+}
+
+TEST(dds_DCPS_AsyncLogger, format_long_string_is_truncated)
+{
+  AsyncLogRecord record;
+  record.start(LM_DEBUG, "%C %C");
+  const String long_string(AsyncLogRecord::TEXT_SIZE * 2, 'x');
+  record.add(long_string.c_str());
+  record.add("lost");
+  const String out = format(record);
+  EXPECT_EQ(out, String(AsyncLogRecord::TEXT_SIZE - 1, 'x') + " ");
+}
+
+TEST(dds_DCPS_AsyncLogger, format_guids_and_addresses)
+{
+  GUID_t guid = GUID_UNKNOWN;
+  guid.guidPrefix[0] = 1;
+  guid.entityId = ENTITYID_PARTICIPANT;
+  const ACE_INET_Addr addr(7400, "127.0.0.1");
+
+  AsyncLogRecord record;
+  record.start(LM_DEBUG, "%C -> %C at %C");
+  record.add(guid);
+  record.add(GUID_UNKNOWN);
+  record.add(addr);
+  EXPECT_EQ(format(record), String(LogGuid(guid).c_str()) + " -> " +
+            LogGuid(GUID_UNKNOWN).c_str() + " at " + LogAddr(addr).str());
+
+  record.start(LM_DEBUG, "%C %C %C %C %C");
+  for (size_t i = 0; i <= AsyncLogRecord::MAX_GUIDS; ++i) {
+    record.add(guid);
+  }
+  const String conv = LogGuid(guid).c_str();
+  EXPECT_EQ(format(record), conv + " " + conv + " " + conv + " " + conv + " (null)");
+}
+
+TEST(dds_DCPS_AsyncLogger, ring_drops_when_full)
+{
+  AsyncLogRing ring(3, "1");
+  EXPECT_EQ(ring.capacity(), 4u);
+
+  for (int i = 0; i < 4; ++i) {
+    AsyncLogRecord* const record = ring.begin_write();
+    ASSERT_TRUE(record);
+    record->start(LM_DEBUG, "%d");
+    record->add(i);
+    ring.end_write();
+  }
+  EXPECT_FALSE(ring.begin_write());
+  EXPECT_EQ(ring.dropped(), 1u);
+
+  size_t first = 0;
+  ASSERT_EQ(ring.available(first), 4u);
+  EXPECT_EQ(ring.at(first + 2).args[0].signed_value, 2);
+  ring.release(4);
+  EXPECT_EQ(ring.available(first), 0u);
+  EXPECT_TRUE(ring.begin_write());
+}
+
+TEST(dds_DCPS_AsyncLogger, flush_writes_in_order)
+{
+  AsyncLogger logger;
+  logger.log(LM_INFO, "first %d\n", 1);
+  logger.log(LM_INFO, "second %C\n", String("two").c_str());
+
+  Capture capture;
+  logger.flush();
+  ASSERT_EQ(capture.messages.size(), 2u);
+  EXPECT_EQ(capture.messages[0], "first 1\n");
+  EXPECT_EQ(capture.messages[1], "second two\n");
+
+  const AsyncLogger::Stats stats = logger.stats();
+  EXPECT_EQ(stats.logged, 2u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.threads, 1u);
+}
+
+TEST(dds_DCPS_AsyncLogger, log_checks_calling_thread_priority)
+{
+  AsyncLogger logger;
+  const u_long process_mask = ACE_LOG_MSG->priority_mask(ACE_Log_Msg::PROCESS);
+  const u_long thread_mask = ACE_LOG_MSG->priority_mask(ACE_Log_Msg::THREAD);
+  ACE_LOG_MSG->priority_mask(process_mask & ~LM_DEBUG, ACE_Log_Msg::PROCESS);
+  ACE_LOG_MSG->priority_mask(thread_mask & ~LM_DEBUG, ACE_Log_Msg::THREAD);
+  logger.log(LM_DEBUG, "disabled\n");
+  logger.log(LM_INFO, "enabled\n");
+  ACE_LOG_MSG->priority_mask(process_mask, ACE_Log_Msg::PROCESS);
+  ACE_LOG_MSG->priority_mask(thread_mask, ACE_Log_Msg::THREAD);
+
+  Capture capture;
+  logger.flush();
+  ASSERT_EQ(capture.messages.size(), 1u);
+  EXPECT_EQ(capture.messages[0], "enabled\n");
+}
+
+TEST(dds_DCPS_AsyncLogger, log_now)
+{
+  GUID_t guid = GUID_UNKNOWN;
+  guid.guidPrefix[0] = 2;
+
+  Capture capture;
+  AsyncLogger::log_now(LM_INFO, "now %C %d\n", guid, 3);
+  ASSERT_EQ(capture.messages.size(), 1u);
+  EXPECT_EQ(capture.messages[0], String("now ") + LogGuid(guid).c_str() + " 3\n");
+}
+
+TEST(dds_DCPS_AsyncLogger, start_stop)
+{
+  AsyncLogger logger;
+  EXPECT_FALSE(logger.running());
+  EXPECT_TRUE(logger.start(16, TimeDuration::from_msec(1)));
+  EXPECT_TRUE(logger.running());
+  EXPECT_FALSE(logger.start());
+  logger.log(LM_DEBUG, "async logger test %d\n", 1);
+  logger.stop();
+  EXPECT_FALSE(logger.running());
+  EXPECT_EQ(logger.stats().logged, 1u);
+}
+
+#endif
@@ -1100,6 +1100,69 @@ TEST(dds_DCPS_DisjointSequence, OrderedRanges_insert_ranges)
   EXPECT_EQ(ir.size(), 2UL);
 }
 
+TEST(dds_DCPS_DisjointSequence, leading_zeros)
+{
+  EXPECT_EQ(DisjointSequence::leading_zeros(0), 32U);
+  EXPECT_EQ(DisjointSequence::leading_zeros(1), 31U);
+  EXPECT_EQ(DisjointSequence::leading_zeros(0x80000000), 0U);
+  EXPECT_EQ(DisjointSequence::leading_zeros(0x00010000), 15U);
+  EXPECT_EQ(DisjointSequence::leading_zeros(0x0000FFFF), 16U);
+}
+
+TEST(dds_DCPS_DisjointSequence, insert_bitmap_runs_across_words)
+{
+  DisjointSequence sequence;
+  sequence.insert(SequenceRange(1, 9));
+  // bits 28-35 and 63 set: (38,45) and (73,73)
+  const ACE_CDR::Long bits[] = {0x0000000F, static_cast<ACE_CDR::Long>(0xF0000001)};
+  EXPECT_TRUE(sequence.insert(10, 64, bits));
+  const OPENDDS_VECTOR(SequenceRange) ranges = sequence.present_sequence_ranges();
+  ASSERT_EQ(ranges.size(), 3U);
+  EXPECT_EQ(ranges[0], SequenceRange(1, 9));
+  EXPECT_EQ(ranges[1], SequenceRange(38, 45));
+  EXPECT_EQ(ranges[2], SequenceRange(73, 73));
+  EXPECT_FALSE(sequence.insert(10, 64, bits));
+}
+
+TEST(dds_DCPS_DisjointSequence, insert_bitmap_run_before_zero_word)
+{
+  DisjointSequence sequence;
+  // a run ending at the last bit of a word followed by an all-zero word
+  const ACE_CDR::Long bits[] = {0x00000001, 0, static_cast<ACE_CDR::Long>(0x80000000)};
+  EXPECT_TRUE(sequence.insert(1, 96, bits));
+  const OPENDDS_VECTOR(SequenceRange) ranges = sequence.present_sequence_ranges();
+  ASSERT_EQ(ranges.size(), 2U);
+  EXPECT_EQ(ranges[0], SequenceRange(32, 32));
+  EXPECT_EQ(ranges[1], SequenceRange(65, 65));
+}
+
+TEST(dds_DCPS_DisjointSequence, insert_bitmap_partial_word)
+{
+  DisjointSequence sequence;
+  // only the first 36 bits are valid, the trailing bits must be ignored
+  const ACE_CDR::Long bits[] = {static_cast<ACE_CDR::Long>(0x80000003), static_cast<ACE_CDR::Long>(0xFFFFFFFF)};
+  EXPECT_TRUE(sequence.insert(1, 36, bits));
+  const OPENDDS_VECTOR(SequenceRange) ranges = sequence.present_sequence_ranges();
+  ASSERT_EQ(ranges.size(), 2U);
+  EXPECT_EQ(ranges[0], SequenceRange(1, 1));
+  EXPECT_EQ(ranges[1], SequenceRange(31, 36));
+}
+
+TEST(dds_DCPS_DisjointSequence, insert_bitmap_all_ones_and_zeros)
+{
+  const ACE_CDR::Long ones[] = {-1, -1, -1, -1, -1, -1, -1, -1};
+  const ACE_CDR::Long zeros[] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+  DisjointSequence sequence;
+  EXPECT_FALSE(sequence.insert(5, 256, zeros));
+  EXPECT_TRUE(sequence.empty());
+
+  EXPECT_TRUE(sequence.insert(5, 256, ones));
+  EXPECT_FALSE(sequence.disjoint());
+  EXPECT_EQ(sequence.low(), SequenceNumber(5));
+  EXPECT_EQ(sequence.high(), SequenceNumber(260));
+}
+
 typedef DisjointSequence::OrderedRanges<char> CharRanges;
 typedef DisjointSequence::OrderedRanges<unsigned char> UCharRanges;
 
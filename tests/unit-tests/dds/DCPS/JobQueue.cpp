@@ -0,0 +1,197 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/JobQueue.h>
+
+#include <dds/DCPS/ThreadPool.h>
+
+#include <ace/Reactor.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct Record {
+    Record() : count(0) {}
+    Atomic<size_t> count;
+    OPENDDS_VECTOR(int) order;
+  };
+
+  class RecordingJob : public Job {
+  public:
+    RecordingJob(Record& record, int id)
+      : record_(record)
+      , id_(id)
+    {}
+
+    void execute()
+    {
+      record_.order.push_back(id_);
+      ++record_.count;
+    }
+
+  private:
+    Record& record_;
+    const int id_;
+  };
+
+  class CountingJob : public Job {
+  public:
+    explicit CountingJob(Atomic<size_t>& count)
+      : count_(count)
+    {}
+
+    void execute()
+    {
+      ++count_;
+    }
+
+  private:
+    Atomic<size_t>& count_;
+  };
+
+  void run_until(ACE_Reactor& reactor, const Atomic<size_t>& count, size_t target)
+  {
+    const MonotonicTimePoint deadline = MonotonicTimePoint::now() + TimeDuration(10);
+    while (count < target && MonotonicTimePoint::now() < deadline) {
+      ACE_Time_Value tv(0, 10000);
+      reactor.handle_events(tv);
+    }
+  }
+
+  struct Producers {
+    Producers(JobQueue_rch queue, size_t jobs)
+      : queue_(queue)
+      , jobs_(jobs)
+      , count_(0)
+    {}
+
+    static ACE_THR_FUNC_RETURN run(void* arg)
+    {
+      Producers& self = *static_cast<Producers*>(arg);
+      for (size_t i = 0; i < self.jobs_; ++i) {
+        self.queue_->enqueue(make_rch<CountingJob>(self.count_));
+      }
+      return 0;
+    }
+
+    JobQueue_rch queue_;
+    const size_t jobs_;
+    Atomic<size_t> count_;
+  };
+}
+
+TEST(dds_DCPS_JobQueue, runs_jobs_in_order)
+{
+  ACE_Reactor reactor;
+  JobQueue_rch job_queue = make_rch<JobQueue>(&reactor);
+  job_queue->latency_stats(true);
+  Record record;
+
+  for (int i = 0; i < 10; ++i) {
+    job_queue->enqueue(make_rch<RecordingJob>(record, i));
+  }
+  EXPECT_EQ(job_queue->stats().depth, 10u);
+
+  run_until(reactor, record.count, 10);
+
+  ASSERT_EQ(record.order.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(record.order[i], i);
+  }
+
+  const JobQueue::Stats stats = job_queue->stats();
+  EXPECT_EQ(stats.depth, 0u);
+  EXPECT_EQ(stats.max_depth, 10u);
+  EXPECT_EQ(stats.executed, 10u);
+  EXPECT_EQ(stats.wakeups, 1u);
+  EXPECT_EQ(stats.latency.count(), 10u);
+}
+
+TEST(dds_DCPS_JobQueue, latency_stats_off_by_default)
+{
+  ACE_Reactor reactor;
+  JobQueue_rch job_queue = make_rch<JobQueue>(&reactor);
+  EXPECT_FALSE(job_queue->latency_stats());
+  Record record;
+
+  for (int i = 0; i < 3; ++i) {
+    job_queue->enqueue(make_rch<RecordingJob>(record, i));
+  }
+  run_until(reactor, record.count, 3);
+
+  const JobQueue::Stats stats = job_queue->stats();
+  EXPECT_EQ(stats.executed, 3u);
+  EXPECT_EQ(stats.latency.count(), 0u);
+}
+
+TEST(dds_DCPS_JobQueue, reuses_nodes)
+{
+  ACE_Reactor reactor;
+  JobQueue_rch job_queue = make_rch<JobQueue>(&reactor);
+  Record record;
+
+  for (int i = 0; i < 10; ++i) {
+    job_queue->enqueue(make_rch<RecordingJob>(record, i));
+  }
+  run_until(reactor, record.count, 10);
+  // One node per job plus the list's stub.
+  const size_t nodes = job_queue->stats().nodes;
+  EXPECT_EQ(nodes, 11u);
+
+  for (int round = 1; round < 5; ++round) {
+    for (int i = 0; i < 10; ++i) {
+      job_queue->enqueue(make_rch<RecordingJob>(record, i));
+    }
+    run_until(reactor, record.count, 10 * (round + 1));
+  }
+  EXPECT_EQ(record.count.load(), 50u);
+  EXPECT_EQ(job_queue->stats().nodes, nodes);
+}
+
+TEST(dds_DCPS_JobQueue, budget_limits_jobs_per_wakeup)
+{
+  ACE_Reactor reactor;
+  JobQueue_rch job_queue = make_rch<JobQueue>(&reactor, 2);
+  EXPECT_EQ(job_queue->budget(), 2u);
+  job_queue->latency_stats(true);
+  Record record;
+
+  for (int i = 0; i < 5; ++i) {
+    job_queue->enqueue(make_rch<RecordingJob>(record, i));
+  }
+
+  run_until(reactor, record.count, 5);
+
+  EXPECT_EQ(record.order.size(), 5u);
+  const JobQueue::Stats stats = job_queue->stats();
+  EXPECT_EQ(stats.executed, 5u);
+  EXPECT_EQ(stats.wakeups, 3u);
+
+  job_queue->reset_stats();
+  EXPECT_EQ(job_queue->stats().executed, 0u);
+  EXPECT_EQ(job_queue->stats().latency.count(), 0u);
+}
+
+TEST(dds_DCPS_JobQueue, multiple_producers)
+{
+  ACE_Reactor reactor;
+  JobQueue_rch job_queue = make_rch<JobQueue>(&reactor);
+  const size_t threads = 4;
+  const size_t jobs = 1000;
+  Producers producers(job_queue, jobs);
+
+  {
+    ThreadPool pool(threads, Producers::run, &producers);
+    run_until(reactor, producers.count_, threads * jobs);
+  }
+  run_until(reactor, producers.count_, threads * jobs);
+
+  EXPECT_EQ(producers.count_.load(), threads * jobs);
+  const JobQueue::Stats stats = job_queue->stats();
+  EXPECT_EQ(stats.executed, threads * jobs);
+  EXPECT_EQ(stats.depth, 0u);
+}
@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <vector>
+
 #if OPENDDS_HAS_JSON_VALUE_READER
 
 using namespace rapidjson;
@@ -639,6 +642,42 @@ TEST(dds_DCPS_JsonValueReader, from_json)
   EXPECT_TRUE(from_json(s, ss));
 }
 
+TEST(dds_DCPS_JsonValueReader, from_json_lines)
+{
+  const char json[] = "{\"bool\":true}\n{\"bool\":false}\n  {\"bool\":true}\n";
+  StringStream ss(json);
+  std::vector<MyStruct> values;
+  EXPECT_TRUE(from_json_lines<MyStruct>(ss, std::back_inserter(values)));
+  ASSERT_EQ(3u, values.size());
+  EXPECT_TRUE(values[0].value);
+  EXPECT_FALSE(values[1].value);
+  EXPECT_TRUE(values[2].value);
+}
+
+TEST(dds_DCPS_JsonValueReader, from_json_lines_error)
+{
+  const char json[] = "{\"bool\":true}\n{\"bool\":3}\n";
+  StringStream ss(json);
+  std::vector<MyStruct> values;
+  EXPECT_FALSE(from_json_lines<MyStruct>(ss, std::back_inserter(values)));
+  EXPECT_EQ(1u, values.size());
+}
+
+TEST(dds_DCPS_JsonValueReader, float_from_negative_int)
+{
+  const char json[] = "[-1,-2]";
+  StringStream ss(json);
+  JsonValueReader<> jvr(ss);
+  ACE_CDR::Float float32_value = 0;
+  ACE_CDR::Double float64_value = 0;
+  EXPECT_TRUE(jvr.begin_array());
+  EXPECT_TRUE(jvr.read_float32(float32_value));
+  EXPECT_EQ(-1.0f, float32_value);
+  EXPECT_TRUE(jvr.read_float64(float64_value));
+  EXPECT_EQ(-2.0, float64_value);
+  EXPECT_TRUE(jvr.end_array());
+}
+
 void check_members(JsonValueReader<>& jvr)
 {
   MemberId member_id;
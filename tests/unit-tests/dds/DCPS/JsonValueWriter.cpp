@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <vector>
+
 #if OPENDDS_HAS_JSON_VALUE_WRITER
 
 using namespace OpenDDS::DCPS;
@@ -604,4 +607,62 @@ TEST(dds_DCPS_JsonValueWriter, write_bitmask)
   EXPECT_STREQ(buffer.GetString(), "\"flag1|flag3|flag5\"");
 }
 
+struct EncoderSample {
+  ACE_CDR::Long x;
+  ACE_CDR::Short values[3];
+};
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+namespace OpenDDS {
+namespace DCPS {
+
+bool vwrite(ValueWriter& writer, const EncoderSample& sample)
+{
+  return writer.begin_struct(FINAL)
+    && writer.begin_struct_member(MemberParam("x"))
+    && writer.write_int32(sample.x)
+    && writer.end_struct_member()
+    && writer.begin_struct_member(MemberParam("values"))
+    && writer.begin_array(OpenDDS::XTypes::TK_INT16)
+    && writer.write_int16_array(sample.values, 3)
+    && writer.end_array()
+    && writer.end_struct_member()
+    && writer.end_struct();
+}
+
+}
+}
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+TEST(dds_DCPS_JsonValueWriter, encoder_reuses_output)
+{
+  JsonEncoder encoder;
+  EncoderSample sample = {1, {2, 3, 4}};
+  EXPECT_TRUE(encoder.encode(sample));
+  EXPECT_STREQ(encoder.c_str(), "{\"x\":1,\"values\":[2,3,4]}");
+
+  sample.x = -5;
+  EXPECT_TRUE(encoder.encode(sample));
+  EXPECT_STREQ(encoder.c_str(), "{\"x\":-5,\"values\":[2,3,4]}");
+  EXPECT_EQ(std::strlen(encoder.c_str()), encoder.size());
+}
+
+TEST(dds_DCPS_JsonValueWriter, encoder_lines)
+{
+  std::vector<EncoderSample> samples(3);
+  DDS::SampleInfoSeq infos(3);
+  infos.length(3);
+  for (ACE_CDR::ULong i = 0; i != 3; ++i) {
+    samples[i].x = static_cast<ACE_CDR::Long>(i);
+    samples[i].values[0] = samples[i].values[1] = samples[i].values[2] = 0;
+    infos[i].valid_data = i != 1;
+  }
+
+  JsonEncoder encoder;
+  EXPECT_TRUE(encoder.encode_lines(samples, infos));
+  EXPECT_STREQ(encoder.c_str(),
+               "{\"x\":0,\"values\":[0,0,0]}\n"
+               "{\"x\":2,\"values\":[0,0,0]}\n");
+}
+
 #endif
@@ -0,0 +1,83 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include "dds/DCPS/Definitions.h"
+#include "dds/DCPS/LatencyHistogram.h"
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_LatencyHistogram, initially_empty)
+{
+  LatencyHistogram h;
+  EXPECT_EQ(h.count(), 0u);
+  EXPECT_EQ(h.mean(), TimeDuration::zero_value);
+  EXPECT_EQ(h.percentile(50), TimeDuration::zero_value);
+}
+
+TEST(dds_DCPS_LatencyHistogram, buckets)
+{
+  LatencyHistogram h;
+  h.record(TimeDuration::zero_value);
+  h.record(TimeDuration(0, 1));
+  h.record(TimeDuration(0, 3));
+  h.record(TimeDuration(0, 1000));
+  EXPECT_EQ(h.count(), 4u);
+  EXPECT_EQ(h.bucket_count(0), 1u);
+  EXPECT_EQ(h.bucket_count(1), 1u);
+  EXPECT_EQ(h.bucket_count(2), 1u);
+  // 512 <= 1000 < 1024
+  EXPECT_EQ(h.bucket_count(10), 1u);
+  EXPECT_EQ(h.min(), TimeDuration::zero_value);
+  EXPECT_EQ(h.max(), TimeDuration(0, 1000));
+  EXPECT_EQ(h.mean(), TimeDuration(0, 251));
+}
+
+TEST(dds_DCPS_LatencyHistogram, long_durations)
+{
+  LatencyHistogram h;
+  h.record(TimeDuration(100000));
+  EXPECT_EQ(h.bucket_count(LatencyHistogram::BUCKET_COUNT - 1), 1u);
+  EXPECT_EQ(h.max(), TimeDuration(100000));
+  EXPECT_EQ(h.percentile(100), TimeDuration(100000));
+}
+
+TEST(dds_DCPS_LatencyHistogram, percentile)
+{
+  LatencyHistogram h;
+  for (int i = 0; i < 90; ++i) {
+    h.record(TimeDuration(0, 10));
+  }
+  for (int i = 0; i < 10; ++i) {
+    h.record(TimeDuration(0, 5000));
+  }
+  EXPECT_EQ(h.percentile(50), TimeDuration(0, 16));
+  EXPECT_EQ(h.percentile(90), TimeDuration(0, 16));
+  EXPECT_EQ(h.percentile(99), TimeDuration(0, 5000));
+}
+
+TEST(dds_DCPS_LatencyHistogram, merge_and_reset)
+{
+  LatencyHistogram a, b;
+  a.record(TimeDuration(0, 100));
+  b.record(TimeDuration(0, 50));
+  b.record(TimeDuration(0, 300));
+  a += b;
+  EXPECT_EQ(a.count(), 3u);
+  EXPECT_EQ(a.min(), TimeDuration(0, 50));
+  EXPECT_EQ(a.max(), TimeDuration(0, 300));
+  a.reset();
+  EXPECT_EQ(a.count(), 0u);
+  EXPECT_EQ(a.max(), TimeDuration::zero_value);
+}
+
+TEST(dds_DCPS_LatencyHistogram, clamps_negative)
+{
+  LatencyHistogram h;
+  h.record(-TimeDuration(0, 1000));
+  EXPECT_EQ(h.count(), 1u);
+  EXPECT_EQ(h.bucket_count(0), 1u);
+}
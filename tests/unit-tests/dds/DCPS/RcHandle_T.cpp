@@ -87,6 +87,36 @@ TEST(dds_DCPS_RcHandle_T, assign)
   EXPECT_EQ(h.get(), h5.get());
 }
 
+#ifdef ACE_HAS_CPP11
+TEST(dds_DCPS_RcHandle_T, moves)
+{
+  Handle h1(new Count, OpenDDS::DCPS::keep_count());
+  Count* const c = h1.get();
+  Handle h2(std::move(h1));
+  EXPECT_TRUE(h1.is_nil());
+  EXPECT_EQ(h2.get(), c);
+  EXPECT_EQ(c->c_, 1);
+
+  Handle h3;
+  h3 = std::move(h2);
+  EXPECT_TRUE(h2.is_nil());
+  EXPECT_EQ(h3.get(), c);
+  EXPECT_EQ(c->c_, 1);
+
+  OpenDDS::DCPS::RcHandle<Derived> hd(new Derived, OpenDDS::DCPS::keep_count());
+  Count* const d = hd.get();
+  Handle h4(std::move(hd));
+  EXPECT_TRUE(hd.is_nil());
+  EXPECT_EQ(h4.get(), d);
+  EXPECT_EQ(d->c_, 1);
+
+  hd.reset(new Derived, OpenDDS::DCPS::keep_count());
+  h3 = std::move(hd);
+  EXPECT_TRUE(hd.is_nil());
+  EXPECT_EQ(h3->c_, 1);
+}
+#endif
+
 TEST(dds_DCPS_RcHandle_T, swaps)
 {
   Handle h1(new Count, OpenDDS::DCPS::keep_count());
@@ -162,6 +192,30 @@ TEST(dds_DCPS_RcHandle_T, casts)
   EXPECT_TRUE(hc);
 }
 
+#ifdef ACE_HAS_CPP11
+TEST(dds_DCPS_RcHandle_T, move_casts)
+{
+  Handle hc(new Derived, OpenDDS::DCPS::keep_count());
+  OpenDDS::DCPS::RcHandle<Derived> hd = OpenDDS::DCPS::static_rchandle_cast<Derived>(std::move(hc));
+  EXPECT_TRUE(hc.is_nil());
+  ASSERT_TRUE(hd);
+  EXPECT_EQ(hd->c_, 1);
+
+  hc = hd;
+  hd = OpenDDS::DCPS::dynamic_rchandle_cast<Derived>(std::move(hc));
+  EXPECT_TRUE(hc.is_nil());
+  ASSERT_TRUE(hd);
+  EXPECT_EQ(hd->c_, 1);
+
+  // A failed cast leaves the source alone.
+  hc.reset(new Count, OpenDDS::DCPS::keep_count());
+  hd = OpenDDS::DCPS::dynamic_rchandle_cast<Derived>(std::move(hc));
+  EXPECT_FALSE(hd);
+  ASSERT_TRUE(hc);
+  EXPECT_EQ(hc->c_, 1);
+}
+#endif
+
 TEST(dds_DCPS_RcHandle_T, make_rch)
 {
   Handle h = OpenDDS::DCPS::make_rch<Count>();
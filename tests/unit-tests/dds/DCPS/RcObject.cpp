@@ -1,5 +1,7 @@
 #include <dds/DCPS/RcHandle_T.h>
 #include <dds/DCPS/RcObject.h>
+#include <dds/DCPS/ThreadPool.h>
+#include <dds/DCPS/TimeTypes.h>
 
 #include <gtest/gtest.h>
 
@@ -70,6 +72,37 @@ TEST(dds_DCPS_RcObject, lock_failed)
   EXPECT_TRUE(locked.is_nil());
 }
 
+TEST(dds_DCPS_RcObject, ref_count_weak)
+{
+  RcHandle<Counted> h1 = make_rch<Counted>();
+  WeakRcHandle<Counted> w1(h1);
+  EXPECT_EQ(h1->ref_count(), 1);
+  {
+    RcHandle<Counted> h2 = w1.lock();
+    EXPECT_EQ(h1->ref_count(), 2);
+  }
+  EXPECT_EQ(h1->ref_count(), 1);
+  h1.reset();
+  EXPECT_TRUE(w1.lock().is_nil());
+}
+
+#ifdef ACE_HAS_CPP11
+TEST(dds_DCPS_RcObject, move_weak)
+{
+  RcHandle<Counted> h1 = make_rch<Counted>();
+  WeakRcHandle<Counted> w1(h1);
+  WeakRcHandle<Counted> w2(std::move(w1));
+  EXPECT_FALSE(w1);
+  EXPECT_EQ(h1, w2);
+
+  WeakRcHandle<Counted> w3;
+  w3 = std::move(w2);
+  EXPECT_FALSE(w2);
+  EXPECT_EQ(h1, w3);
+  EXPECT_EQ(h1->ref_count(), 1);
+}
+#endif
+
 TEST(dds_DCPS_RcObject, compare_weak)
 {
   RcHandle<Counted> h1 = make_rch<Counted>();
@@ -80,3 +113,80 @@ TEST(dds_DCPS_RcObject, compare_weak)
   EXPECT_FALSE(w1 < w2);
   EXPECT_FALSE(w2 < w1);
 }
+
+namespace {
+  struct Contended {
+    Contended(const RcHandle<Counted>& handle, size_t iterations)
+      : handle_(handle)
+      , weak_(handle)
+      , iterations_(iterations)
+    {}
+
+    static ACE_THR_FUNC_RETURN run(void* arg)
+    {
+      Contended& self = *static_cast<Contended*>(arg);
+      for (size_t i = 0; i < self.iterations_; ++i) {
+        RcHandle<Counted> copy(self.handle_);
+        RcHandle<Counted> locked = self.weak_.lock();
+      }
+      return 0;
+    }
+
+    const RcHandle<Counted> handle_;
+    const WeakRcHandle<Counted> weak_;
+    const size_t iterations_;
+  };
+
+  double ns_per_op(const MonotonicTimePoint& start, size_t ops)
+  {
+    return (MonotonicTimePoint::now() - start).to_double() * 1e9 / ops;
+  }
+}
+
+// Not a pass/fail test, reports the reference counting cost that a sample
+// pays as handles to its instance, writer, and links are copied around.
+TEST(dds_DCPS_RcObject, Benchmark)
+{
+  const size_t samples = 1000000;
+  const size_t threads = 4;
+  RcHandle<Counted> handle = make_rch<Counted>();
+  WeakRcHandle<Counted> weak(handle);
+
+  MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    RcHandle<Counted> copy(handle);
+  }
+  const double copy_ns = ns_per_op(start, samples);
+
+  start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    RcHandle<Counted> locked = weak.lock();
+  }
+  const double lock_ns = ns_per_op(start, samples);
+
+#ifdef ACE_HAS_CPP11
+  start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    RcHandle<Counted> moved(std::move(handle));
+    handle = std::move(moved);
+  }
+  const double move_ns = ns_per_op(start, samples);
+#else
+  const double move_ns = 0;
+#endif
+
+  Contended contended(handle, samples / threads);
+  start = MonotonicTimePoint::now();
+  {
+    ThreadPool pool(threads, Contended::run, &contended);
+  }
+  const double contended_ns = ns_per_op(start, samples);
+
+  EXPECT_EQ(handle->ref_count(), 2);
+
+  ACE_DEBUG((LM_INFO, "RcObject Benchmark: %B samples\n", samples));
+  ACE_DEBUG((LM_INFO, "  copy and release      %.2f ns/sample\n", copy_ns));
+  ACE_DEBUG((LM_INFO, "  weak lock and release %.2f ns/sample\n", lock_ns));
+  ACE_DEBUG((LM_INFO, "  move and move back    %.2f ns/sample\n", move_ns));
+  ACE_DEBUG((LM_INFO, "  copy and lock, %B threads %.2f ns/sample\n", threads, contended_ns));
+}
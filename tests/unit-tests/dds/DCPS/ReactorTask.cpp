@@ -0,0 +1,94 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/ReactorTask.h>
+#include <dds/DCPS/ReactorTask_rch.h>
+
+#include <dds/DCPS/Service_Participant.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_ReactorTask, parse_cpu_list)
+{
+  OPENDDS_VECTOR(size_t) cpus;
+  EXPECT_TRUE(ReactorTask::parse_cpu_list("", cpus));
+  EXPECT_TRUE(cpus.empty());
+
+  EXPECT_TRUE(ReactorTask::parse_cpu_list("3", cpus));
+  ASSERT_EQ(cpus.size(), 1u);
+  EXPECT_EQ(cpus[0], 3u);
+
+  EXPECT_TRUE(ReactorTask::parse_cpu_list("0, 2,4-6", cpus));
+  ASSERT_EQ(cpus.size(), 5u);
+  EXPECT_EQ(cpus[0], 0u);
+  EXPECT_EQ(cpus[1], 2u);
+  EXPECT_EQ(cpus[2], 4u);
+  EXPECT_EQ(cpus[3], 5u);
+  EXPECT_EQ(cpus[4], 6u);
+
+  EXPECT_FALSE(ReactorTask::parse_cpu_list("a", cpus));
+  EXPECT_FALSE(ReactorTask::parse_cpu_list("6-4", cpus));
+  EXPECT_FALSE(ReactorTask::parse_cpu_list("1-", cpus));
+}
+
+TEST(dds_DCPS_ReactorTask, parse_scheduler)
+{
+  long flags = -1;
+  EXPECT_TRUE(ReactorTask::parse_scheduler("", flags));
+  EXPECT_EQ(flags, 0);
+  EXPECT_TRUE(ReactorTask::parse_scheduler("SCHED_OTHER", flags));
+  EXPECT_EQ(flags, THR_SCHED_DEFAULT);
+  EXPECT_TRUE(ReactorTask::parse_scheduler("SCHED_RR", flags));
+  EXPECT_EQ(flags, THR_SCHED_RR);
+  EXPECT_TRUE(ReactorTask::parse_scheduler("SCHED_FIFO", flags));
+  EXPECT_EQ(flags, THR_SCHED_FIFO);
+  EXPECT_FALSE(ReactorTask::parse_scheduler("SCHED_IDLE", flags));
+}
+
+TEST(dds_DCPS_ReactorTask, open_with_thread_options)
+{
+  // Affinity to CPU 0 exists everywhere and an unprivileged process falls
+  // back to the default scheduling class, so this always runs.
+  ReactorTask::ThreadOptions options;
+  options.cpus.push_back(0);
+  ReactorTask::parse_scheduler("SCHED_FIFO", options.sched_flags);
+
+  ReactorTask_rch task = make_rch<ReactorTask>(false);
+  ASSERT_EQ(task->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(),
+                                    "ReactorTaskTest", options), 0);
+  EXPECT_NE(task->get_reactor_owner(), ACE_OS::NULL_thread);
+  EXPECT_FALSE(task->is_shut_down());
+  task->stop();
+  EXPECT_TRUE(task->is_shut_down());
+}
+
+TEST(dds_DCPS_ReactorTask, pool_round_robin)
+{
+  ReactorTaskPool pool;
+  EXPECT_EQ(pool.size(), 0u);
+  EXPECT_TRUE(pool.next().is_nil());
+
+  ReactorTask_rch tasks[3];
+  for (size_t i = 0; i < 3; ++i) {
+    tasks[i] = make_rch<ReactorTask>(false);
+    ASSERT_EQ(tasks[i]->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(),
+                                          "ReactorTaskPoolTest"), 0);
+    pool.add(tasks[i]);
+  }
+  EXPECT_EQ(pool.size(), 3u);
+
+  // Links are spread over every thread, in order, and wrap around.
+  for (size_t i = 0; i < 7; ++i) {
+    EXPECT_EQ(pool.next(), tasks[i % 3]);
+  }
+  EXPECT_NE(tasks[0]->get_reactor_owner(), tasks[1]->get_reactor_owner());
+
+  pool.stop();
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_TRUE(tasks[i]->is_shut_down());
+  }
+}
@@ -0,0 +1,391 @@
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <dds/DCPS/Atomic.h>
+#include <dds/DCPS/RecordLog.h>
+#include <dds/DCPS/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const char directory[] = "RecordLogTest";
+
+  void remove_log()
+  {
+    for (unsigned i = 0; ; ++i) {
+      char path[64];
+      ACE_OS::snprintf(path, sizeof path, "%s/record-%06u.rlog", directory, i);
+      if (ACE_OS::unlink(path) != 0) {
+        break;
+      }
+    }
+    ACE_OS::rmdir(directory);
+  }
+
+  GUID_t make_writer(unsigned char id)
+  {
+    GUID_t guid = GUID_UNKNOWN;
+    guid.guidPrefix[0] = 1;
+    guid.entityId.entityKey[2] = id;
+    guid.entityId.entityKind = ENTITYKIND_USER_WRITER_WITH_KEY;
+    return guid;
+  }
+
+  RecordLogWriterInfo make_info(const GUID_t& writer, const char* topic_name)
+  {
+    RecordLogWriterInfo info;
+    info.writer = writer;
+    info.topic_name = topic_name;
+    info.type_name = "Test::Message";
+    info.writer_qos.history.depth = 7;
+    return info;
+  }
+
+  RawDataSample make_sample(const GUID_t& writer, ACE_INT32 sec, const char* data)
+  {
+    const size_t length = ACE_OS::strlen(data);
+    Message_Block_Ptr mb(new ACE_Message_Block(length));
+    mb->copy(data, length);
+    DataSampleHeader header;
+    header.message_id_ = SAMPLE_DATA;
+    header.byte_order_ = true;
+    header.message_length_ = static_cast<ACE_UINT32>(length);
+    header.sequence_ = SequenceNumber(sec);
+    header.source_timestamp_sec_ = sec;
+    header.publication_id_ = writer;
+    return RawDataSample(header, SAMPLE_DATA, sec, 0, writer, true, mb.get(),
+                         Encoding::KIND_XCDR2);
+  }
+
+  SystemTimePoint at(ACE_INT32 sec, ACE_UINT32 nanosec = 0)
+  {
+    DDS::Time_t time = {sec, nanosec};
+    return SystemTimePoint(time);
+  }
+
+  struct Recording {
+    explicit Recording(RecordLogWriter& writer)
+      : log(writer)
+      , next_writer(0)
+      , failures(0)
+    {}
+
+    RecordLogWriter& log;
+    Atomic<size_t> next_writer;
+    Atomic<size_t> failures;
+  };
+
+  const ACE_INT32 samples_per_thread = 500;
+
+  ACE_THR_FUNC_RETURN record(void* arg)
+  {
+    Recording& recording = *static_cast<Recording*>(arg);
+    const GUID_t writer = make_writer(static_cast<unsigned char>(++recording.next_writer));
+    for (ACE_INT32 i = 0; i < samples_per_thread; ++i) {
+      if (!recording.log.write_sample(make_sample(writer, i, "0123456789"), at(i))) {
+        ++recording.failures;
+      }
+    }
+    return 0;
+  }
+
+  class RecordingReplayer : public virtual Replayer {
+  public:
+    DDS::ReturnCode_t write(const RawDataSample&)
+    {
+      times.push_back(MonotonicTimePoint::now());
+      return DDS::RETCODE_OK;
+    }
+
+    DDS::ReturnCode_t write(const RawDataSample& sample, DDS::DynamicType_ptr)
+    {
+      return write(sample);
+    }
+
+    DDS::ReturnCode_t write_to_reader(DDS::InstanceHandle_t, const RawDataSample&)
+    {
+      return DDS::RETCODE_UNSUPPORTED;
+    }
+
+    DDS::ReturnCode_t write_to_reader(DDS::InstanceHandle_t, const RawDataSampleList&)
+    {
+      return DDS::RETCODE_UNSUPPORTED;
+    }
+
+    DDS::ReturnCode_t set_qos(const DDS::PublisherQos&, const DDS::DataWriterQos&)
+    {
+      return DDS::RETCODE_UNSUPPORTED;
+    }
+
+    DDS::ReturnCode_t get_qos(DDS::PublisherQos&, DDS::DataWriterQos&)
+    {
+      return DDS::RETCODE_UNSUPPORTED;
+    }
+
+    DDS::ReturnCode_t set_listener(const ReplayerListener_rch&, DDS::StatusMask)
+    {
+      return DDS::RETCODE_UNSUPPORTED;
+    }
+
+    ReplayerListener_rch get_listener()
+    {
+      return ReplayerListener_rch();
+    }
+
+    OPENDDS_VECTOR(MonotonicTimePoint) times;
+  };
+
+  class dds_DCPS_RecordLog : public testing::Test {
+  protected:
+    void SetUp()
+    {
+      remove_log();
+      config_.directory = directory;
+    }
+
+    void TearDown()
+    {
+      remove_log();
+    }
+
+    RecordLogWriter::Config config_;
+  };
+}
+
+TEST_F(dds_DCPS_RecordLog, write_and_read)
+{
+  const GUID_t writer1 = make_writer(1);
+  const GUID_t writer2 = make_writer(2);
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    EXPECT_TRUE(log.write_writer(make_info(writer1, "A")));
+    EXPECT_TRUE(log.write_writer(make_info(writer2, "B")));
+    // Recorded out of order by different transport threads
+    EXPECT_TRUE(log.write_sample(make_sample(writer1, 10, "a10"), at(10)));
+    EXPECT_TRUE(log.write_sample(make_sample(writer2, 30, "b30"), at(30)));
+    EXPECT_TRUE(log.write_sample(make_sample(writer1, 20, "a20"), at(20)));
+    EXPECT_TRUE(log.write_sample(make_sample(writer2, 40, "b40"), at(40)));
+    const RecordLogWriter::Stats stats = log.stats();
+    EXPECT_EQ(4u, stats.samples);
+    EXPECT_EQ(2u, stats.writers);
+    EXPECT_EQ(0u, stats.commits);
+    log.close();
+    EXPECT_EQ(1u, log.stats().commits);
+  }
+
+  RecordLogReader reader(directory);
+  ASSERT_TRUE(reader.open());
+  ASSERT_EQ(4u, reader.size());
+  ASSERT_EQ(2u, reader.topics().size());
+  EXPECT_EQ(at(10), reader[0].recorded);
+  EXPECT_EQ(at(20), reader[1].recorded);
+  EXPECT_EQ(at(30), reader[2].recorded);
+
+  const RecordLogWriterInfo* const info = reader.writer_info(writer2);
+  ASSERT_TRUE(info);
+  EXPECT_EQ("B", info->topic_name);
+  EXPECT_EQ("Test::Message", info->type_name);
+  EXPECT_EQ(7, info->writer_qos.history.depth);
+
+  RawDataSample sample;
+  ASSERT_TRUE(reader.read(1, sample));
+  EXPECT_EQ(writer1, sample.publication_id_);
+  EXPECT_EQ(20, sample.source_timestamp_.sec);
+  EXPECT_EQ(SAMPLE_DATA, sample.message_id_);
+  EXPECT_EQ(Encoding::KIND_XCDR2, sample.encoding_kind_);
+  EXPECT_EQ(SequenceNumber(20), sample.header_.sequence_);
+  ASSERT_EQ(3u, sample.sample_->length());
+  EXPECT_EQ(0, ACE_OS::memcmp("a20", sample.sample_->rd_ptr(), 3));
+}
+
+TEST_F(dds_DCPS_RecordLog, index)
+{
+  const GUID_t writer1 = make_writer(1);
+  const GUID_t writer2 = make_writer(2);
+  const GUID_t writer3 = make_writer(3);
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    log.write_writer(make_info(writer1, "A"));
+    log.write_writer(make_info(writer2, "A"));
+    log.write_writer(make_info(writer3, "B"));
+    for (ACE_INT32 i = 0; i < 30; ++i) {
+      const GUID_t& writer = i % 3 == 0 ? writer1 : i % 3 == 1 ? writer2 : writer3;
+      log.write_sample(make_sample(writer, i, "x"), at(i));
+    }
+  }
+
+  RecordLogReader reader(directory);
+  ASSERT_TRUE(reader.open());
+  EXPECT_EQ(30u, reader.size());
+  EXPECT_EQ(12u, reader.seek(at(12)));
+  EXPECT_EQ(30u, reader.seek(at(100)));
+
+  const size_t a = reader.topic("A");
+  ASSERT_NE(RecordLogReader::npos, a);
+  EXPECT_EQ(RecordLogReader::npos, reader.topic("C"));
+  const RecordLogReader::Positions& positions = reader.topic_positions(a);
+  EXPECT_EQ(20u, positions.size());
+  // 12 is writer1 so it's in topic A at index 8.
+  const size_t found = reader.seek(positions, at(12));
+  ASSERT_EQ(8u, found);
+  EXPECT_EQ(12u, positions[found]);
+  EXPECT_EQ(at(13), reader[positions[found + 1]].recorded);
+
+  const RecordLogReader::Positions& by_writer = reader.writer_positions(writer3);
+  ASSERT_EQ(10u, by_writer.size());
+  for (size_t i = 0; i < by_writer.size(); ++i) {
+    EXPECT_EQ(writer3, reader[by_writer[i]].writer);
+  }
+  EXPECT_TRUE(reader.writer_positions(make_writer(4)).empty());
+}
+
+TEST_F(dds_DCPS_RecordLog, segments)
+{
+  const GUID_t writer = make_writer(1);
+  config_.segment_size = 1024;
+  config_.batch_size = 256;
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    log.write_writer(make_info(writer, "A"));
+    for (ACE_INT32 i = 0; i < 100; ++i) {
+      EXPECT_TRUE(log.write_sample(make_sample(writer, i, "0123456789"), at(i)));
+    }
+    const RecordLogWriter::Stats stats = log.stats();
+    EXPECT_GT(stats.segments, 1u);
+    EXPECT_GT(stats.commits, stats.segments);
+  }
+
+  // Reopening starts a new segment after the existing ones.
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    EXPECT_TRUE(log.write_sample(make_sample(writer, 100, "0123456789"), at(100)));
+  }
+
+  RecordLogReader reader(directory);
+  ASSERT_TRUE(reader.open());
+  ASSERT_EQ(101u, reader.size());
+  for (size_t i = 0; i < reader.size(); ++i) {
+    EXPECT_EQ(at(static_cast<ACE_INT32>(i)), reader[i].recorded);
+  }
+  // The second log didn't write the writer, but it's known from the first.
+  EXPECT_EQ(101u, reader.topic_positions(reader.topic("A")).size());
+
+  RawDataSample sample;
+  ASSERT_TRUE(reader.read(99, sample));
+  EXPECT_EQ(99, sample.source_timestamp_.sec);
+}
+
+TEST_F(dds_DCPS_RecordLog, flush_if_due)
+{
+  config_.flush_interval = TimeDuration::from_msec(100);
+  RecordLogWriter log(config_);
+  ASSERT_TRUE(log.open());
+  log.write_writer(make_info(make_writer(1), "A"));
+  EXPECT_TRUE(log.write_sample(make_sample(make_writer(1), 1, "x"), at(1)));
+
+  EXPECT_TRUE(log.flush_if_due(MonotonicTimePoint::now()));
+  EXPECT_EQ(0u, log.stats().commits);
+  EXPECT_TRUE(log.flush_if_due(MonotonicTimePoint::now() + TimeDuration(1)));
+  EXPECT_EQ(1u, log.stats().commits);
+
+  // Nothing is buffered.
+  EXPECT_TRUE(log.flush_if_due(MonotonicTimePoint::now() + TimeDuration(2)));
+  EXPECT_EQ(1u, log.stats().commits);
+}
+
+TEST_F(dds_DCPS_RecordLog, concurrent_writes)
+{
+  static const size_t threads = 4;
+  config_.segment_size = 16 * 1024;
+  config_.batch_size = 512;
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    for (unsigned char i = 1; i <= threads; ++i) {
+      log.write_writer(make_info(make_writer(i), "A"));
+    }
+
+    // Recording threads add records while another commit is writing.
+    Recording recording(log);
+    {
+      ThreadPool pool(threads, record, &recording);
+    }
+    EXPECT_EQ(0u, recording.failures.load());
+    EXPECT_EQ(threads * samples_per_thread, log.stats().samples);
+  }
+
+  RecordLogReader reader(directory);
+  ASSERT_TRUE(reader.open());
+  ASSERT_EQ(threads * samples_per_thread, reader.size());
+  for (unsigned char i = 1; i <= threads; ++i) {
+    const RecordLogReader::Positions& positions = reader.writer_positions(make_writer(i));
+    ASSERT_EQ(static_cast<size_t>(samples_per_thread), positions.size());
+    RawDataSample sample;
+    ASSERT_TRUE(reader.read(positions.back(), sample));
+    EXPECT_EQ(make_writer(i), sample.publication_id_);
+  }
+}
+
+TEST_F(dds_DCPS_RecordLog, play_rates)
+{
+  // Samples recorded 100ms apart
+  const GUID_t writer = make_writer(1);
+  {
+    RecordLogWriter log(config_);
+    ASSERT_TRUE(log.open());
+    log.write_writer(make_info(writer, "A"));
+    for (ACE_INT32 i = 0; i < 3; ++i) {
+      log.write_sample(make_sample(writer, i, "x"), at(0, i * 100000000));
+    }
+  }
+
+  RecordLogReader reader(directory);
+  ASSERT_TRUE(reader.open());
+  ASSERT_EQ(3u, reader.size());
+
+  // At the recorded rate
+  {
+    RecordLogPlayer player(reader);
+    RecordingReplayer* const replayer = new RecordingReplayer;
+    const Replayer_var var = replayer;
+    player.add_replayer("A", replayer);
+    EXPECT_EQ(3u, player.play(1.0));
+    ASSERT_EQ(3u, replayer->times.size());
+    EXPECT_GE(replayer->times[2] - replayer->times[0], TimeDuration::from_msec(190));
+  }
+
+  // Twice as fast
+  {
+    RecordLogPlayer player(reader);
+    RecordingReplayer* const replayer = new RecordingReplayer;
+    const Replayer_var var = replayer;
+    player.add_replayer("A", replayer);
+    EXPECT_EQ(3u, player.play(2.0));
+    ASSERT_EQ(3u, replayer->times.size());
+    const TimeDuration elapsed = replayer->times[2] - replayer->times[0];
+    EXPECT_GE(elapsed, TimeDuration::from_msec(90));
+    EXPECT_LT(elapsed, TimeDuration::from_msec(190));
+  }
+
+  // As fast as possible
+  {
+    RecordLogPlayer player(reader);
+    RecordingReplayer* const replayer = new RecordingReplayer;
+    const Replayer_var var = replayer;
+    player.add_replayer("A", replayer);
+    EXPECT_EQ(3u, player.play(0.0));
+    ASSERT_EQ(3u, replayer->times.size());
+    EXPECT_LT(replayer->times[2] - replayer->times[0], TimeDuration::from_msec(90));
+  }
+}
+
+#endif // OPENDDS_SAFETY_PROFILE
@@ -0,0 +1,63 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include "dds/DCPS/Definitions.h"
+#include "dds/DCPS/RoundTripTimeEstimator.h"
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_RoundTripTimeEstimator, initially_invalid)
+{
+  RoundTripTimeEstimator e;
+  EXPECT_FALSE(e.valid());
+}
+
+TEST(dds_DCPS_RoundTripTimeEstimator, first_sample)
+{
+  RoundTripTimeEstimator e;
+  e.sample(TimeDuration(0, 100000));
+  EXPECT_TRUE(e.valid());
+  EXPECT_EQ(e.srtt(), TimeDuration(0, 100000));
+  EXPECT_EQ(e.rttvar(), TimeDuration(0, 50000));
+  EXPECT_EQ(e.rto(), TimeDuration(0, 300000));
+}
+
+TEST(dds_DCPS_RoundTripTimeEstimator, smoothing)
+{
+  RoundTripTimeEstimator e;
+  e.sample(TimeDuration(0, 100000));
+  e.sample(TimeDuration(0, 180000));
+  // rttvar = 0.75 * 50ms + 0.25 * 80ms, srtt = 0.875 * 100ms + 0.125 * 180ms
+  EXPECT_NEAR(e.rttvar().to_double(), 0.0575, 1e-6);
+  EXPECT_NEAR(e.srtt().to_double(), 0.110, 1e-6);
+}
+
+TEST(dds_DCPS_RoundTripTimeEstimator, converges)
+{
+  RoundTripTimeEstimator e;
+  e.sample(TimeDuration(1));
+  for (int i = 0; i < 100; ++i) {
+    e.sample(TimeDuration(0, 2000));
+  }
+  EXPECT_LT(e.srtt(), TimeDuration(0, 3000));
+  EXPECT_LT(e.rto(), TimeDuration(0, 4000));
+}
+
+TEST(dds_DCPS_RoundTripTimeEstimator, ignores_negative)
+{
+  RoundTripTimeEstimator e;
+  e.sample(-TimeDuration(0, 1000));
+  EXPECT_FALSE(e.valid());
+}
+
+TEST(dds_DCPS_RoundTripTimeEstimator, reset)
+{
+  RoundTripTimeEstimator e;
+  e.sample(TimeDuration(0, 1000));
+  e.reset();
+  EXPECT_FALSE(e.valid());
+}
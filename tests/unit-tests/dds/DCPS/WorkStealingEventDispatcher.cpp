@@ -0,0 +1,431 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/WorkStealingEventDispatcher.h>
+
+#include <dds/DCPS/ServiceEventDispatcher.h>
+#include <dds/DCPS/ConditionVariable.h>
+#include <dds/DCPS/ThreadStatusManager.h>
+
+#include <ace/OS_NS_unistd.h>
+
+#include <gtest/gtest.h>
+
+using OpenDDS::DCPS::Atomic;
+using OpenDDS::DCPS::ConditionVariable;
+using OpenDDS::DCPS::EventBase;
+using OpenDDS::DCPS::EventDispatcher;
+using OpenDDS::DCPS::MonotonicTimePoint;
+using OpenDDS::DCPS::RcHandle;
+using OpenDDS::DCPS::ServiceEventDispatcher;
+using OpenDDS::DCPS::ThreadStatusManager;
+using OpenDDS::DCPS::TimeDuration;
+using OpenDDS::DCPS::WeakRcHandle;
+using OpenDDS::DCPS::WorkStealingEventDispatcher;
+using OpenDDS::DCPS::make_rch;
+
+namespace {
+
+class TestEventBase : public EventBase {
+public:
+  TestEventBase() : cv_(mutex_), call_count_(0), cancel_count_(0) {}
+
+  size_t increment_call_count()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++call_count_;
+    cv_.notify_all();
+    return call_count_;
+  }
+
+  size_t call_count()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return call_count_;
+  }
+
+  size_t cancel_count()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return cancel_count_;
+  }
+
+  void handle_cancel()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++cancel_count_;
+  }
+
+  void wait(size_t target)
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    while (call_count_ < target) {
+      cv_.wait(tsm_);
+    }
+  }
+
+private:
+  ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> cv_;
+  ThreadStatusManager tsm_;
+  size_t call_count_;
+  size_t cancel_count_;
+};
+
+struct SimpleTestEvent : public TestEventBase {
+  void handle_event() { increment_call_count(); }
+};
+
+struct SlowTestEvent : public TestEventBase {
+  void handle_event()
+  {
+    ACE_OS::sleep(ACE_Time_Value(0, 20000));
+    increment_call_count();
+  }
+};
+
+struct RecursiveTestEvent : public TestEventBase {
+  RecursiveTestEvent(RcHandle<EventDispatcher> dispatcher, size_t dispatch_scale) : dispatcher_(dispatcher), dispatch_scale_(dispatch_scale) {}
+
+  void handle_event()
+  {
+    increment_call_count();
+    const size_t scale = dispatch_scale_;
+    RcHandle<EventDispatcher> dispatcher = dispatcher_.lock();
+    if (dispatcher) {
+      for (size_t i = 0; i < scale; ++i) {
+        dispatcher->dispatch(OpenDDS::DCPS::rchandle_from(this));
+      }
+    }
+  }
+
+  WeakRcHandle<EventDispatcher> dispatcher_;
+  Atomic<size_t> dispatch_scale_;
+};
+
+/// Records how many copies of the event ran at the same time.
+struct ConcurrencyTestEvent : public TestEventBase {
+  ConcurrencyTestEvent() : active_(0), max_active_(0) {}
+
+  void handle_event()
+  {
+    const size_t active = ++active_;
+    if (active > max_active_) {
+      max_active_ = active;
+    }
+    ACE_OS::sleep(ACE_Time_Value(0, 1000));
+    --active_;
+    increment_call_count();
+  }
+
+  Atomic<size_t> active_;
+  Atomic<size_t> max_active_;
+};
+
+/// Dispatches several slow events from a pool thread.
+struct BurstTestEvent : public EventBase {
+  BurstTestEvent(RcHandle<EventDispatcher> dispatcher, RcHandle<SlowTestEvent> event) : dispatcher_(dispatcher), event_(event) {}
+
+  void handle_event()
+  {
+    RcHandle<EventDispatcher> dispatcher = dispatcher_.lock();
+    if (dispatcher) {
+      for (size_t i = 0; i < 8; ++i) {
+        dispatcher->dispatch(event_);
+      }
+    }
+  }
+
+  WeakRcHandle<EventDispatcher> dispatcher_;
+  RcHandle<SlowTestEvent> event_;
+};
+
+/// Cheap event for measuring dispatch overhead.
+struct CountingEvent : public EventBase {
+  explicit CountingEvent(size_t target) : cv_(mutex_), count_(0), target_(target), done_(false) {}
+
+  void handle_event()
+  {
+    if (++count_ == target_) {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      done_ = true;
+      cv_.notify_all();
+    }
+  }
+
+  void wait()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    while (!done_) {
+      cv_.wait(tsm_);
+    }
+  }
+
+  ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> cv_;
+  ThreadStatusManager tsm_;
+  Atomic<size_t> count_;
+  const size_t target_;
+  bool done_;
+};
+
+/// Each call dispatches the next one so every event is queued from a pool thread.
+struct ChainEvent : public EventBase {
+  ChainEvent(RcHandle<EventDispatcher> dispatcher, RcHandle<CountingEvent> counter, size_t remaining)
+    : dispatcher_(dispatcher), counter_(counter), remaining_(remaining) {}
+
+  void handle_event()
+  {
+    RcHandle<EventDispatcher> dispatcher = dispatcher_.lock();
+    if (dispatcher && remaining_ > 0) {
+      dispatcher->dispatch(make_rch<ChainEvent>(dispatcher, counter_, remaining_ - 1));
+    }
+    counter_->handle_event();
+  }
+
+  WeakRcHandle<EventDispatcher> dispatcher_;
+  RcHandle<CountingEvent> counter_;
+  const size_t remaining_;
+};
+
+double dispatch_many(RcHandle<EventDispatcher> dispatcher, size_t events)
+{
+  RcHandle<CountingEvent> counter = make_rch<CountingEvent>(events);
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < events; ++i) {
+    dispatcher->dispatch(counter);
+  }
+  counter->wait();
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+  dispatcher->shutdown();
+  return elapsed.to_double();
+}
+
+double dispatch_chains(RcHandle<EventDispatcher> dispatcher, size_t chains, size_t length)
+{
+  RcHandle<CountingEvent> counter = make_rch<CountingEvent>(chains * length);
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < chains; ++i) {
+    dispatcher->dispatch(make_rch<ChainEvent>(dispatcher, counter, length - 1));
+  }
+  counter->wait();
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+  dispatcher->shutdown();
+  return elapsed.to_double();
+}
+
+} // (anonymous) namespace
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, DefaultConstructor)
+{
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>();
+  EXPECT_EQ(dispatcher->thread_count(), 1u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, ZeroThreads)
+{
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(0);
+  EXPECT_EQ(dispatcher->thread_count(), 1u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, SimpleDispatch)
+{
+  RcHandle<SimpleTestEvent> test_event = make_rch<SimpleTestEvent>();
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_TRUE(dispatcher->dispatch(test_event));
+  }
+
+  test_event->wait(5u);
+  dispatcher->shutdown();
+
+  EXPECT_EQ(test_event->call_count(), 5u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, RecursiveDispatch)
+{
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+  RcHandle<RecursiveTestEvent> test_event = make_rch<RecursiveTestEvent>(dispatcher, 2);
+
+  dispatcher->dispatch(test_event);
+
+  test_event->wait(1000u);
+  test_event->dispatch_scale_ = 0;
+  dispatcher->shutdown();
+
+  EXPECT_GE(test_event->call_count(), 1000u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, RecursiveDispatch_ImmediateShutdown)
+{
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+  RcHandle<RecursiveTestEvent> test_event = make_rch<RecursiveTestEvent>(dispatcher, 1);
+
+  dispatcher->dispatch(test_event);
+  dispatcher->dispatch(test_event);
+
+  test_event->wait(1000u);
+  dispatcher->shutdown(true);
+
+  EXPECT_GE(test_event->call_count(), 1000u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, IdleThreadsSteal)
+{
+  RcHandle<SlowTestEvent> test_event = make_rch<SlowTestEvent>();
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+
+  // Events dispatched from a pool thread start on that thread's queue.
+  dispatcher->dispatch(make_rch<BurstTestEvent>(dispatcher, test_event));
+
+  test_event->wait(8u);
+  EXPECT_GT(dispatcher->steal_count(), 0u);
+  dispatcher->shutdown();
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, AffinitySerializes)
+{
+  RcHandle<ConcurrencyTestEvent> test_event = make_rch<ConcurrencyTestEvent>();
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+
+  for (size_t i = 0; i < 20; ++i) {
+    EXPECT_TRUE(dispatcher->dispatch(test_event, 7));
+  }
+  test_event->wait(20u);
+  dispatcher->shutdown();
+
+  EXPECT_EQ(test_event->max_active_, 1u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, TestShutdown)
+{
+  RcHandle<SimpleTestEvent> test_event = make_rch<SimpleTestEvent>();
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(2);
+
+  dispatcher->dispatch(test_event);
+  const long id = dispatcher->schedule(test_event, MonotonicTimePoint::now() + TimeDuration(60));
+  EXPECT_GT(id, 0);
+
+  test_event->wait(1u);
+  dispatcher->shutdown();
+
+  EXPECT_FALSE(dispatcher->dispatch(test_event));
+  EXPECT_EQ(-1, dispatcher->schedule(test_event, MonotonicTimePoint::now()));
+  EXPECT_EQ(0u, dispatcher->cancel(id));
+
+  EXPECT_EQ(test_event->call_count(), 1u);
+  EXPECT_EQ(test_event->cancel_count(), 1u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, ShutdownDrainsQueue)
+{
+  RcHandle<SlowTestEvent> test_event = make_rch<SlowTestEvent>();
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(2);
+
+  for (size_t i = 0; i < 6; ++i) {
+    dispatcher->dispatch(test_event);
+  }
+  dispatcher->shutdown();
+
+  EXPECT_EQ(test_event->call_count(), 6u);
+  EXPECT_EQ(test_event->cancel_count(), 0u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, ImmediateShutdownCancelsQueue)
+{
+  RcHandle<SlowTestEvent> test_event = make_rch<SlowTestEvent>();
+  RcHandle<EventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(1);
+
+  for (size_t i = 0; i < 6; ++i) {
+    dispatcher->dispatch(test_event);
+  }
+  test_event->wait(1u);
+  dispatcher->shutdown(true);
+
+  EXPECT_EQ(test_event->call_count() + test_event->cancel_count(), 6u);
+  EXPECT_LT(test_event->call_count(), 6u);
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, TimedDispatch)
+{
+  RcHandle<SimpleTestEvent> test_event = make_rch<SimpleTestEvent>();
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+
+  dispatcher->schedule(test_event, now + TimeDuration::from_double(0.06), 1);
+  dispatcher->schedule(test_event, now + TimeDuration::from_double(0.04), 1);
+  dispatcher->schedule(test_event, now + TimeDuration::from_double(0.05));
+  dispatcher->dispatch(test_event);
+
+  test_event->wait(1u);
+  const MonotonicTimePoint after1 = MonotonicTimePoint::now();
+  test_event->wait(2u);
+  const MonotonicTimePoint after2 = MonotonicTimePoint::now();
+  test_event->wait(3u);
+  const MonotonicTimePoint after3 = MonotonicTimePoint::now();
+  test_event->wait(4u);
+  const MonotonicTimePoint after4 = MonotonicTimePoint::now();
+
+  dispatcher->shutdown();
+
+  EXPECT_LT(after1, now + TimeDuration::from_double(0.04));
+  EXPECT_GE(after2, now + TimeDuration::from_double(0.04));
+  EXPECT_GE(after3, now + TimeDuration::from_double(0.05));
+  EXPECT_GE(after4, now + TimeDuration::from_double(0.06));
+}
+
+TEST(dds_DCPS_WorkStealingEventDispatcher, CancelDispatch)
+{
+  RcHandle<SimpleTestEvent> test_event = make_rch<SimpleTestEvent>();
+  RcHandle<WorkStealingEventDispatcher> dispatcher = make_rch<WorkStealingEventDispatcher>(4);
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+
+  const long t1 = dispatcher->schedule(test_event, now + TimeDuration::from_double(0.09));
+  const long t2 = dispatcher->schedule(test_event, now + TimeDuration::from_double(0.05));
+  const long t3 = dispatcher->schedule(test_event, now + TimeDuration::from_double(0.08), 3);
+  /*long t4 =*/ dispatcher->schedule(test_event, now + TimeDuration::from_double(0.07));
+  /*long t5 =*/ dispatcher->schedule(test_event, now + TimeDuration::from_double(0.06), 3);
+  const long t6 = dispatcher->schedule(test_event, now + TimeDuration::from_double(0.04));
+
+  EXPECT_EQ(dispatcher->cancel(t6), 1u);
+  EXPECT_EQ(dispatcher->cancel(t1), 1u);
+  EXPECT_EQ(dispatcher->cancel(t2), 1u);
+  EXPECT_EQ(dispatcher->cancel(t3), 1u);
+  EXPECT_EQ(dispatcher->cancel(t3), 0u);
+
+  test_event->wait(2u);
+  const MonotonicTimePoint after2 = MonotonicTimePoint::now();
+
+  dispatcher->shutdown();
+
+  EXPECT_GE(after2, now + TimeDuration::from_double(0.07));
+  EXPECT_EQ(test_event->call_count(), 2u);
+  EXPECT_EQ(test_event->cancel_count(), 4u);
+}
+
+// Not a pass/fail test, compares dispatch throughput with ServiceEventDispatcher.
+TEST(dds_DCPS_WorkStealingEventDispatcher, Benchmark)
+{
+  const size_t threads = 4;
+  const size_t events = 100000;
+  const size_t chains = 64;
+  const size_t chain_length = 1000;
+
+  const double service_flat = dispatch_many(make_rch<ServiceEventDispatcher>(threads), events);
+  const double stealing_flat = dispatch_many(make_rch<WorkStealingEventDispatcher>(threads), events);
+  const double service_chain = dispatch_chains(make_rch<ServiceEventDispatcher>(threads), chains, chain_length);
+  const double stealing_chain = dispatch_chains(make_rch<WorkStealingEventDispatcher>(threads), chains, chain_length);
+
+  ACE_DEBUG((LM_INFO, "WorkStealingEventDispatcher Benchmark: %B threads\n", threads));
+  ACE_DEBUG((LM_INFO, "  external dispatch  %B events: service %.3f s, work-stealing %.3f s\n",
+             events, service_flat, stealing_flat));
+  ACE_DEBUG((LM_INFO, "  chained dispatch   %B events: service %.3f s, work-stealing %.3f s\n",
+             chains * chain_length, service_chain, stealing_chain));
+}
@@ -4348,4 +4348,171 @@ TEST(dds_DCPS_XTypes_DynamicDataImpl, String_As_Enum)
   EXPECT_EQ(DDS::RETCODE_OK, data.get_int32_value(eval, MID_my_enum));
   EXPECT_EQ(static_cast<int>(E_UINT64), eval);
 }
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, Mutable_WriteValueToStructOutOfOrder)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_MutableSingleValueStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_MutableSingleValueStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+
+  // Members are stored sorted by ID regardless of the order they are set in.
+  XTypes::DynamicDataImpl in_order(dt);
+  EXPECT_EQ(DDS::RETCODE_OK, in_order.set_int32_value(1, 10));
+  EXPECT_EQ(DDS::RETCODE_OK, in_order.set_uint32_value(2, 11));
+  EXPECT_EQ(DDS::RETCODE_OK, in_order.set_int16_value(5, 0x1111));
+  EXPECT_EQ(DDS::RETCODE_OK, in_order.set_int64_value(7, 0x7fffffffffffffff));
+  EXPECT_EQ(DDS::RETCODE_OK, in_order.set_string_value(17, "abc"));
+
+  XTypes::DynamicDataImpl out_of_order(dt);
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_string_value(17, "abc"));
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_int16_value(5, 0x2222));
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_int64_value(7, 0x7fffffffffffffff));
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_int32_value(1, 10));
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_uint32_value(2, 11));
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.set_int16_value(5, 0x1111));
+
+  CORBA::Short int16_val = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.get_int16_value(int16_val, 5));
+  EXPECT_EQ(0x1111, int16_val);
+  CORBA::Long int32_val = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, out_of_order.get_int32_value(int32_val, 1));
+  EXPECT_EQ(10, int32_val);
+
+  ACE_Message_Block expected(512);
+  DCPS::Serializer ser(&expected, xcdr2);
+  ASSERT_TRUE(ser << &in_order);
+  assert_serialized_data(512, out_of_order, expected);
+
+  XTypes::DynamicDataImpl copy(out_of_order);
+  assert_serialized_data(512, copy, expected);
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, Mutable_RemoveSequenceElement)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_MutableSequenceStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_MutableSequenceStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+
+  XTypes::DynamicDataImpl data(dt);
+  DDS::DynamicData_var int32s;
+  ASSERT_EQ(DDS::RETCODE_OK, data.get_complex_value(int32s, 1));
+
+  // Elements set from the back are still kept in index order.
+  for (CORBA::ULong i = 5; i > 0; --i) {
+    EXPECT_EQ(DDS::RETCODE_OK, int32s->set_int32_value(i - 1, static_cast<CORBA::Long>(10 * (i - 1))));
+  }
+  EXPECT_EQ(5u, int32s->get_item_count());
+
+  // Removing an element shifts the following ones down.
+  EXPECT_EQ(DDS::RETCODE_OK, int32s->clear_value(1));
+  EXPECT_EQ(4u, int32s->get_item_count());
+  const CORBA::Long expected[] = {0, 20, 30, 40};
+  for (CORBA::ULong i = 0; i < 4; ++i) {
+    CORBA::Long value = -1;
+    EXPECT_EQ(DDS::RETCODE_OK, int32s->get_int32_value(value, i));
+    EXPECT_EQ(expected[i], value);
+  }
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, Appendable_WriteValueToStructFlatLayout)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_AppendableSingleValueStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_AppendableSingleValueStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_TRUE(it != type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  XTypes::DynamicTypeImpl* const dt_impl = dynamic_cast<XTypes::DynamicTypeImpl*>(dt.in());
+  ASSERT_TRUE(dt_impl);
+  dt_impl->use_flat_data_layout();
+  EXPECT_TRUE(dt_impl->flat_data_layout().in());
+
+  // The type of the nested struct member opts in with the outer type.
+  DDS::DynamicTypeMember_var dtm;
+  ASSERT_EQ(DDS::RETCODE_OK, dt->get_member(dtm, 16));
+  DDS::MemberDescriptor_var md;
+  ASSERT_EQ(DDS::RETCODE_OK, dtm->get_descriptor(md));
+  const DDS::DynamicType_var nested_dt = XTypes::get_base_type(md->type());
+  XTypes::DynamicTypeImpl* const nested_impl = dynamic_cast<XTypes::DynamicTypeImpl*>(nested_dt.in());
+  ASSERT_TRUE(nested_impl);
+  EXPECT_TRUE(nested_impl->flat_data_layout().in());
+
+  // Same as Appendable_WriteValueToStruct, the member IDs skip 11.
+  unsigned char single_value_struct[] = {
+    0x00,0x00,0x00,0x4e,  // +4=4 dheader
+    0x00,0x00,0x00,0x03, // +4=8 my_enum
+    0x00,0x00,0x00,0x0a, // +4=12 int_32
+    0x00,0x00,0x00,0x0b, // +4=16 uint_32
+    0x05, // +1=17 int_8
+    0x06, // +1=18 uint_8
+    0x11,0x11, // +2=20 int_16
+    0x22,0x22, // +2=22 uint_16
+    (0),(0),0x7f,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // +(2)+8=32 int_64
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // +8=40 uint_64
+    0x3f,0x80,0x00,0x00, // +4=44 float_32
+    0x3f,0xf0,0x00,0x00,0x00,0x00,0x00,0x00, // +8=52 float_64
+    'a',  // +1=53 char_8
+    (0),0x00,0x61, // +(1)+2=56 char_16
+    0xff, // +1=57 byte
+    0x01, // +1=58 bool
+    (0), (0), 0x00,0x00,0x00,0x0c, // +(2)+4=64 nested_struct
+    0x00,0x00,0x00,0x04, 'a','b','c','\0', // +8=72 str
+    0x00,0x00,0x00,0x06, 0,0x61,0,0x62,0,0x63 // +10=82 wstr
+  };
+  verify_single_value_struct<AppendableSingleValueStruct>(dt, single_value_struct);
+
+  // Read-only from the backing store.
+  ACE_Message_Block bs_msg(128);
+  bs_msg.copy((const char*)single_value_struct, sizeof single_value_struct);
+  DDS::DynamicData_var backstore = new XTypes::DynamicDataXcdrReadImpl(&bs_msg, xcdr2, dt);
+  XTypes::DynamicDataImpl ddi(dt, backstore);
+  AppendableSingleValueStruct input;
+  set_single_value_struct(input);
+  verify_reading_single_value_struct(input, ddi);
+  verify_modified_single_value_struct(ddi);
+
+  // Members set out of order, and a string that moves between the small buffer
+  // and the heap, serialize the same as with the default storage.
+  XTypes::TypeLookupService default_tls;
+  default_tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var default_dt = default_tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  XTypes::DynamicDataImpl expected_data(default_dt);
+  XTypes::DynamicDataImpl flat_data(dt);
+  const char* const long_str = "longer than the small string buffer";
+  XTypes::DynamicDataImpl* const datas[] = {&expected_data, &flat_data};
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_string_value(17, "abc"));
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_uint64_value(8, 0xffffffffffffffff));
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_string_value(17, long_str));
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_int16_value(5, 0x1111));
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_int32_value(1, 10));
+    EXPECT_EQ(DDS::RETCODE_OK, datas[i]->set_int32_value(0, E_UINT8));
+  }
+  CORBA::String_var str;
+  EXPECT_EQ(DDS::RETCODE_OK, flat_data.get_string_value(str, 17));
+  EXPECT_STREQ(long_str, str.in());
+  CORBA::Short int16_val = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, flat_data.get_int16_value(int16_val, 5));
+  EXPECT_EQ(0x1111, int16_val);
+
+  ACE_Message_Block expected(512);
+  DCPS::Serializer ser(&expected, xcdr2);
+  ASSERT_TRUE(ser << &expected_data);
+  assert_serialized_data(512, flat_data, expected);
+
+  XTypes::DynamicDataImpl copy(flat_data);
+  assert_serialized_data(512, copy, expected);
+}
 #endif // OPENDDS_SAFETY_PROFILE
@@ -7,6 +7,7 @@
 #include <dds/DCPS/XTypes/TypeLookupService.h>
 #include <dds/DCPS/XTypes/DynamicTypeImpl.h>
 #include <dds/DCPS/XTypes/DynamicDataXcdrReadImpl.h>
+#include <dds/DCPS/TimeTypes.h>
 
 #include <gtest/gtest.h>
 
@@ -3361,4 +3362,225 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Enum_As_String)
   EXPECT_EQ(DDS::RETCODE_OK, data.get_string_value(strVal, MID_my_enum));
   EXPECT_STREQ("E_UINT64", strVal.in());
 }
+
+template<typename Xtag>
+DDS::DynamicType_var get_dynamic_type(XTypes::TypeLookupService& tls)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<Xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<Xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_TRUE(it != type_map.end());
+  tls.add(type_map.begin(), type_map.end());
+  return tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+}
+
+const ACE_CDR::ULong wide_member_count = 16;
+const XTypes::MemberId wide_inner_id = 16;
+const XTypes::MemberId wide_inners_id = 17;
+const XTypes::MemberId wide_name_id = 18;
+
+template<typename WideType>
+void set_wide_members(WideType& w, ACE_CDR::Long base)
+{
+  w.m0 = base + 0;
+  w.m1 = base + 1;
+  w.m2 = base + 2;
+  w.m3 = base + 3;
+  w.m4 = base + 4;
+  w.m5 = base + 5;
+  w.m6 = base + 6;
+  w.m7 = base + 7;
+  w.m8 = base + 8;
+  w.m9 = base + 9;
+  w.m10 = base + 10;
+  w.m11 = base + 11;
+  w.m12 = base + 12;
+  w.m13 = base + 13;
+  w.m14 = base + 14;
+  w.m15 = base + 15;
+}
+
+template<typename OuterType>
+void set_wide_outer(OuterType& outer, ACE_CDR::ULong elements)
+{
+  set_wide_members(outer, 0);
+  set_wide_members(outer.inner, 100);
+  outer.inners.length(elements);
+  for (ACE_CDR::ULong i = 0; i < elements; ++i) {
+    set_wide_members(outer.inners[i], static_cast<ACE_CDR::Long>(1000 * (i + 1)));
+  }
+  outer.name = "wide";
+}
+
+template<typename Type>
+void serialize_sample(ACE_Message_Block& msg, const Type& sample)
+{
+  msg.init(DCPS::serialized_size(xcdr2, sample));
+  DCPS::Serializer ser(&msg, xcdr2);
+  ASSERT_TRUE(ser << sample);
+}
+
+void verify_wide_members(DDS::DynamicData_ptr data, ACE_CDR::Long base, bool reverse)
+{
+  for (ACE_CDR::ULong n = 0; n < wide_member_count; ++n) {
+    const XTypes::MemberId id = reverse ? wide_member_count - 1 - n : n;
+    ACE_CDR::Long value = 0;
+    ASSERT_RC_OK(data->get_int32_value(value, id));
+    EXPECT_EQ(base + static_cast<ACE_CDR::Long>(id), value);
+  }
+}
+
+void verify_wide_outer(DDS::DynamicData_ptr data, ACE_CDR::ULong elements, bool reverse)
+{
+  verify_wide_members(data, 0, reverse);
+
+  DDS::DynamicData_var inner;
+  ASSERT_RC_OK(data->get_complex_value(inner, wide_inner_id));
+  verify_wide_members(inner, 100, reverse);
+
+  DDS::DynamicData_var inners;
+  ASSERT_RC_OK(data->get_complex_value(inners, wide_inners_id));
+  EXPECT_EQ(elements, inners->get_item_count());
+  for (ACE_CDR::ULong n = 0; n < elements; ++n) {
+    const ACE_CDR::ULong i = reverse ? elements - 1 - n : n;
+    DDS::DynamicData_var element;
+    ASSERT_RC_OK(inners->get_complex_value(element, i));
+    verify_wide_members(element, static_cast<ACE_CDR::Long>(1000 * (i + 1)), reverse);
+  }
+  DDS::DynamicData_var past_end;
+  EXPECT_NE(DDS::RETCODE_OK, inners->get_complex_value(past_end, elements));
+
+  DDS::String8_var name;
+  ASSERT_RC_OK(data->get_string_value(name, wide_name_id));
+  EXPECT_STREQ("wide", name.in());
+}
+
+template<typename OuterType, typename Xtag>
+void test_offset_index_any_order()
+{
+  XTypes::TypeLookupService tls;
+  DDS::DynamicType_var dt = get_dynamic_type<Xtag>(tls);
+
+  const ACE_CDR::ULong elements = 5;
+  OuterType outer;
+  set_wide_outer(outer, elements);
+  ACE_Message_Block msg;
+  serialize_sample(msg, outer);
+
+  // Later reads resume from positions recorded by earlier ones, so read the
+  // same data in different orders and through a copy.
+  XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
+  verify_wide_outer(&data, elements, true);
+  verify_wide_outer(&data, elements, false);
+  verify_wide_outer(&data, elements, true);
+
+  DDS::DynamicData_var copy = data.clone();
+  verify_wide_outer(copy, elements, false);
+
+  XTypes::DynamicDataXcdrReadImpl fresh(&msg, xcdr2, dt);
+  verify_wide_outer(&fresh, elements, false);
+  verify_wide_outer(&fresh, elements, true);
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, OffsetIndex_Mutable)
+{
+  test_offset_index_any_order<WideMutableOuter, DCPS::WideMutableOuter_xtag>();
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, OffsetIndex_Appendable)
+{
+  test_offset_index_any_order<WideAppendableOuter, DCPS::WideAppendableOuter_xtag>();
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, OffsetIndex_MutableMissingMember)
+{
+  XTypes::TypeLookupService tls;
+  DDS::DynamicType_var dt = get_dynamic_type<DCPS::WideMutableInner_xtag>(tls);
+
+  const unsigned char partial_struct[] = {
+    0x00,0x00,0x00,0x10, // +4=4 dheader
+    0x20,0x00,0x00,0x03, 0x00,0x00,0x00,0x03, // +4+4=12 m3
+    0x20,0x00,0x00,0x01, 0x00,0x00,0x00,0x01 // +4+4=20 m1
+  };
+  ACE_Message_Block msg(64);
+  msg.copy((const char*)partial_struct, sizeof partial_struct);
+  XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
+
+  ACE_CDR::Long value = 0;
+  EXPECT_RC_OK(data.get_int32_value(value, 1));
+  EXPECT_EQ(1, value);
+  EXPECT_RC_OK(data.get_int32_value(value, 3));
+  EXPECT_EQ(3, value);
+  EXPECT_EQ(DDS::RETCODE_NO_DATA, data.get_int32_value(value, 0));
+  EXPECT_EQ(DDS::RETCODE_NO_DATA, data.get_int32_value(value, 0));
+  EXPECT_RC_OK(data.get_int32_value(value, 3));
+  EXPECT_EQ(3, value);
+  EXPECT_EQ(DDS::RETCODE_NO_DATA, data.get_int32_value(value, 15));
+}
+
+ACE_CDR::Long read_wide_members(DDS::DynamicData_ptr data)
+{
+  ACE_CDR::Long sum = 0;
+  for (ACE_CDR::ULong i = 0; i < wide_member_count; ++i) {
+    ACE_CDR::Long value = 0;
+    data->get_int32_value(value, i);
+    sum += value;
+  }
+  return sum;
+}
+
+ACE_CDR::Long read_wide_outer(DDS::DynamicData_ptr data)
+{
+  ACE_CDR::Long sum = read_wide_members(data);
+  DDS::DynamicData_var inner;
+  data->get_complex_value(inner, wide_inner_id);
+  sum += read_wide_members(inner);
+  DDS::DynamicData_var inners;
+  data->get_complex_value(inners, wide_inners_id);
+  const ACE_CDR::ULong elements = inners->get_item_count();
+  for (ACE_CDR::ULong i = 0; i < elements; ++i) {
+    DDS::DynamicData_var element;
+    inners->get_complex_value(element, i);
+    sum += read_wide_members(element);
+  }
+  return sum;
+}
+
+template<typename OuterType, typename Xtag>
+double benchmark_wide_outer(size_t samples, ACE_CDR::ULong elements)
+{
+  XTypes::TypeLookupService tls;
+  DDS::DynamicType_var dt = get_dynamic_type<Xtag>(tls);
+  OuterType outer;
+  set_wide_outer(outer, elements);
+  ACE_Message_Block msg;
+  serialize_sample(msg, outer);
+
+  ACE_CDR::Long sum = 0;
+  const DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
+    sum += read_wide_outer(&data);
+  }
+  const double sample_ns = (DCPS::MonotonicTimePoint::now() - start).to_double() * 1e9 / samples;
+  EXPECT_NE(0, sum);
+  return sample_ns;
+}
+
+// Not a pass/fail test, reports the cost of reading every member of a
+// deep sample, which is linear in the number of members with the offset index.
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Benchmark)
+{
+  const size_t samples = 100;
+  const ACE_CDR::ULong elements = 64;
+  const double mutable_ns = benchmark_wide_outer<WideMutableOuter, DCPS::WideMutableOuter_xtag>(samples, elements);
+  const double appendable_ns =
+    benchmark_wide_outer<WideAppendableOuter, DCPS::WideAppendableOuter_xtag>(samples, elements);
+
+  ACE_DEBUG((LM_INFO, "DynamicDataXcdrReadImpl Benchmark: %B samples of %u inner structs\n",
+             samples, elements));
+  ACE_DEBUG((LM_INFO, "  mutable    %.0f ns/sample\n", mutable_ns));
+  ACE_DEBUG((LM_INFO, "  appendable %.0f ns/sample\n", appendable_ns));
+}
+
 #endif // OPENDDS_SAFETY_PROFILE
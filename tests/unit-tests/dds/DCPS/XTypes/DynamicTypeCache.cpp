@@ -0,0 +1,161 @@
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <XcdrTranscoderTypeSupportImpl.h>
+
+#include <dds/DCPS/XTypes/DynamicTypeCache.h>
+#include <dds/DCPS/XTypes/DynamicTypeImpl.h>
+#include <dds/DCPS/XTypes/TypeLookupService.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS;
+using namespace OpenDDS::XTypes;
+
+namespace {
+  DCPS::GUID_t make_guid(unsigned char participant)
+  {
+    DCPS::GUID_t guid = DCPS::GUID_UNKNOWN;
+    guid.guidPrefix[0] = participant;
+    guid.entityId = DCPS::ENTITYID_PARTICIPANT;
+    return guid;
+  }
+
+  template <typename Xtag>
+  DDS::DynamicType_var get_type(TypeLookupService& tls, const DCPS::GUID_t& guid)
+  {
+    const TypeMap& type_map = DCPS::getCompleteTypeMap<Xtag>();
+    tls.add(type_map.begin(), type_map.end());
+    return tls.type_identifier_to_dynamic(DCPS::getCompleteTypeIdentifier<Xtag>(), guid);
+  }
+
+  DDS::MemberDescriptor_var get_member_descriptor(DDS::DynamicType_ptr type, const char* name)
+  {
+    DDS::DynamicTypeMember_var dtm;
+    EXPECT_EQ(DDS::RETCODE_OK, type->get_member_by_name(dtm, name));
+    DDS::MemberDescriptor_var md;
+    EXPECT_EQ(DDS::RETCODE_OK, dtm->get_descriptor(md));
+    return md;
+  }
+}
+
+TEST(dds_DCPS_XTypes_DynamicTypeCache, shared_by_participants)
+{
+  const DynamicTypeCache_rch cache = DCPS::make_rch<DynamicTypeCache>();
+  TypeLookupService tls1(cache);
+  TypeLookupService tls2(cache);
+  const DCPS::GUID_t guid1 = make_guid(1);
+  const DCPS::GUID_t guid2 = make_guid(2);
+
+  const DDS::DynamicType_var type1 = get_type<DCPS::TranscoderTest_AllKinds_xtag>(tls1, guid1);
+  const DynamicTypeCache::Stats after_first = cache->stats();
+  EXPECT_GT(after_first.types, 1u);
+  EXPECT_EQ(after_first.types, after_first.misses);
+  EXPECT_GT(after_first.bytes, 0u);
+
+  const DDS::DynamicType_var type2 = get_type<DCPS::TranscoderTest_AllKinds_xtag>(tls2, guid2);
+  EXPECT_EQ(type1.in(), type2.in());
+  const DynamicTypeCache::Stats after_second = cache->stats();
+  EXPECT_EQ(after_first.types, after_second.types);
+  EXPECT_EQ(after_first.misses, after_second.misses);
+  EXPECT_EQ(after_first.hits + 1, after_second.hits);
+  EXPECT_EQ(after_first.bytes, after_second.bytes);
+  EXPECT_EQ(2u, after_second.users);
+
+  // The type stays cached until its last user is released.
+  tls1.remove_guid_from_dynamic_map(guid1);
+  EXPECT_EQ(after_first.types, cache->stats().types);
+  EXPECT_EQ(23u, type2->get_member_count());
+
+  tls2.remove_guid_from_dynamic_map(guid2);
+  const DynamicTypeCache::Stats after_release = cache->stats();
+  EXPECT_EQ(0u, after_release.types);
+  EXPECT_EQ(0u, after_release.users);
+  EXPECT_EQ(0u, after_release.member_descriptors);
+  EXPECT_EQ(0u, after_release.bytes);
+  EXPECT_EQ(after_first.types, after_release.evictions);
+}
+
+TEST(dds_DCPS_XTypes_DynamicTypeCache, dependencies_are_kept)
+{
+  const DynamicTypeCache_rch cache = DCPS::make_rch<DynamicTypeCache>();
+  TypeLookupService tls(cache);
+  const DCPS::GUID_t guid1 = make_guid(1);
+  const DCPS::GUID_t guid2 = make_guid(2);
+
+  const DDS::DynamicType_var all = get_type<DCPS::TranscoderTest_AllKinds_xtag>(tls, guid1);
+  const DDS::DynamicType_var point = get_type<DCPS::TranscoderTest_Point_xtag>(tls, guid2);
+  const size_t types = cache->stats().types;
+
+  // Point is also used by guid2, so it's not evicted with AllKinds.
+  tls.remove_guid_from_dynamic_map(guid1);
+  const DynamicTypeCache::Stats stats = cache->stats();
+  EXPECT_LT(stats.types, types);
+  EXPECT_GT(stats.types, 0u);
+  EXPECT_EQ(2u, point->get_member_count());
+  EXPECT_EQ(0u, all->get_member_count());
+
+  const DDS::DynamicType_var point2 = get_type<DCPS::TranscoderTest_Point_xtag>(tls, guid1);
+  EXPECT_EQ(point.in(), point2.in());
+}
+
+TEST(dds_DCPS_XTypes_DynamicTypeCache, find_built)
+{
+  const DynamicTypeCache_rch cache = DCPS::make_rch<DynamicTypeCache>();
+  const TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::TranscoderTest_Point_xtag>();
+  const DynamicTypeCache::User user(cache->new_owner(), make_guid(1));
+  EXPECT_FALSE(DDS::DynamicType_var(cache->find_built(ti, user)));
+
+  // A type that's still being built is only returned while holding the
+  // build lock.
+  const DDS::DynamicType_var candidate = new DynamicTypeImpl();
+  EXPECT_FALSE(DDS::DynamicType_var(cache->find_or_insert(ti, user, candidate)));
+  EXPECT_FALSE(DDS::DynamicType_var(cache->find_built(ti, user)));
+
+  cache->built(ti);
+  const DynamicTypeCache::User user2(cache->new_owner(), make_guid(2));
+  const DDS::DynamicType_var found = cache->find_built(ti, user2);
+  EXPECT_EQ(candidate.in(), found.in());
+  EXPECT_EQ(2u, cache->stats().users);
+  EXPECT_EQ(1u, cache->stats().hits);
+
+  cache->release(user);
+  cache->release(user2);
+  EXPECT_EQ(0u, cache->stats().types);
+}
+
+TEST(dds_DCPS_XTypes_DynamicTypeCache, released_with_type_lookup_service)
+{
+  const DynamicTypeCache_rch cache = DCPS::make_rch<DynamicTypeCache>();
+  DDS::DynamicType_var type;
+  {
+    TypeLookupService tls(cache);
+    type = get_type<DCPS::TranscoderTest_Shape_xtag>(tls, make_guid(1));
+    EXPECT_GT(cache->stats().types, 0u);
+  }
+  EXPECT_EQ(0u, cache->stats().types);
+  EXPECT_EQ(0u, cache->stats().users);
+}
+
+TEST(dds_DCPS_XTypes_DynamicTypeCache, member_descriptors_are_interned)
+{
+  const DynamicTypeCache_rch cache = DCPS::make_rch<DynamicTypeCache>();
+  TypeLookupService tls(cache);
+  const DCPS::GUID_t guid = make_guid(1);
+
+  const DDS::DynamicType_var v1 = get_type<DCPS::TranscoderTest_MutableV1_xtag>(tls, guid);
+  const DDS::DynamicType_var v2 = get_type<DCPS::TranscoderTest_MutableV2_xtag>(tls, guid);
+  const size_t shared = cache->stats().shared_member_descriptors;
+
+  // Same name, ID, type, and index
+  EXPECT_EQ(get_member_descriptor(v1, "a").in(), get_member_descriptor(v2, "a").in());
+  // Different index
+  EXPECT_NE(get_member_descriptor(v1, "values").in(), get_member_descriptor(v2, "values").in());
+
+  const DDS::DynamicType_var a1 = get_type<DCPS::TranscoderTest_AppendableV1_xtag>(tls, guid);
+  const DDS::DynamicType_var a2 = get_type<DCPS::TranscoderTest_AppendableV2_xtag>(tls, guid);
+  EXPECT_EQ(get_member_descriptor(a1, "a").in(), get_member_descriptor(a2, "a").in());
+  EXPECT_EQ(get_member_descriptor(a1, "b").in(), get_member_descriptor(a2, "b").in());
+  EXPECT_EQ(shared + 2, cache->stats().shared_member_descriptors);
+}
+
+#endif // OPENDDS_SAFETY_PROFILE
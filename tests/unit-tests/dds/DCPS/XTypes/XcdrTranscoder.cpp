@@ -0,0 +1,468 @@
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <XcdrTranscoderTypeSupportImpl.h>
+
+#include <dds/DCPS/XTypes/XcdrTranscoder.h>
+#include <dds/DCPS/XTypes/DynamicDataImpl.h>
+#include <dds/DCPS/XTypes/DynamicDataXcdrReadImpl.h>
+#include <dds/DCPS/XTypes/TypeLookupService.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace OpenDDS;
+using namespace TranscoderTest;
+
+namespace {
+  const DCPS::Encoding xcdr2_be(DCPS::Encoding::KIND_XCDR2, DCPS::ENDIAN_BIG);
+  const DCPS::Encoding xcdr2_le(DCPS::Encoding::KIND_XCDR2, DCPS::ENDIAN_LITTLE);
+  const DCPS::Encoding xcdr1_le(DCPS::Encoding::KIND_XCDR1, DCPS::ENDIAN_LITTLE);
+  const DCPS::Encoding xcdr1_be(DCPS::Encoding::KIND_XCDR1, DCPS::ENDIAN_BIG);
+
+  template <typename Xtag>
+  DDS::DynamicType_var get_dynamic_type(XTypes::TypeLookupService& tls)
+  {
+    const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<Xtag>();
+    const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<Xtag>();
+    const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+    EXPECT_TRUE(it != type_map.end());
+    tls.add(type_map.begin(), type_map.end());
+    return tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  }
+
+  template <typename Type>
+  void serialize_sample(DCPS::Message_Block_Ptr& msg, const DCPS::Encoding& encoding, const Type& sample)
+  {
+    msg.reset(new ACE_Message_Block(DCPS::serialized_size(encoding, sample)));
+    DCPS::Serializer ser(msg.get(), encoding);
+    ASSERT_TRUE(ser << sample);
+  }
+
+  template <typename Type>
+  void deserialize_sample(const DCPS::Message_Block_Ptr& msg, const DCPS::Encoding& encoding, Type& sample)
+  {
+    DCPS::Message_Block_Ptr dup(msg->duplicate());
+    DCPS::Serializer ser(dup.get(), encoding);
+    ASSERT_TRUE(ser >> sample);
+  }
+
+  void init(AllKinds& sample, ACE_CDR::ULong elements)
+  {
+    sample.id = 7;
+    sample.b = true;
+    sample.o = 0x12;
+    sample.i8 = -3;
+    sample.u8 = 250;
+    sample.s = -1234;
+    sample.us = 54321;
+    sample.ul = 0x12345678;
+    sample.ll = -0x123456789LL;
+    sample.ull = 0x123456789ABCDEFULL;
+    sample.f = 1.5f;
+    sample.d = -2.25;
+    sample.c = 'q';
+    sample.wc = 0x263A;
+    sample.color = BLUE;
+    sample.str = "hello";
+    sample.wstr = L"wide";
+    sample.longs.length(elements);
+    sample.strs.length(elements);
+    sample.points.length(elements);
+    for (ACE_CDR::ULong i = 0; i < elements; ++i) {
+      sample.longs[i] = static_cast<ACE_CDR::Long>(i * 3);
+      sample.strs[i] = i % 2 ? "odd" : "even";
+      sample.points[i].x = static_cast<ACE_CDR::Long>(i);
+      sample.points[i].y = -static_cast<ACE_CDR::Long>(i);
+    }
+    for (ACE_CDR::ULong i = 0; i < 4; ++i) {
+      sample.doubles[i] = i * 0.5;
+    }
+    sample.point.x = 10;
+    sample.point.y = 20;
+    Point p;
+    p.x = 30;
+    p.y = 40;
+    sample.shape.point(p);
+  }
+
+  void check_equal(const AllKinds& a, const AllKinds& b)
+  {
+    EXPECT_EQ(a.id, b.id);
+    EXPECT_EQ(a.b, b.b);
+    EXPECT_EQ(a.o, b.o);
+    EXPECT_EQ(a.i8, b.i8);
+    EXPECT_EQ(a.u8, b.u8);
+    EXPECT_EQ(a.s, b.s);
+    EXPECT_EQ(a.us, b.us);
+    EXPECT_EQ(a.ul, b.ul);
+    EXPECT_EQ(a.ll, b.ll);
+    EXPECT_EQ(a.ull, b.ull);
+    EXPECT_EQ(a.f, b.f);
+    EXPECT_EQ(a.d, b.d);
+    EXPECT_EQ(a.c, b.c);
+    EXPECT_EQ(a.wc, b.wc);
+    EXPECT_EQ(a.color, b.color);
+    EXPECT_STREQ(a.str.in(), b.str.in());
+    EXPECT_STREQ(a.wstr.in(), b.wstr.in());
+    ASSERT_EQ(a.longs.length(), b.longs.length());
+    ASSERT_EQ(a.strs.length(), b.strs.length());
+    ASSERT_EQ(a.points.length(), b.points.length());
+    for (ACE_CDR::ULong i = 0; i < a.longs.length(); ++i) {
+      EXPECT_EQ(a.longs[i], b.longs[i]);
+      EXPECT_STREQ(a.strs[i].in(), b.strs[i].in());
+      EXPECT_EQ(a.points[i].x, b.points[i].x);
+      EXPECT_EQ(a.points[i].y, b.points[i].y);
+    }
+    for (ACE_CDR::ULong i = 0; i < 4; ++i) {
+      EXPECT_EQ(a.doubles[i], b.doubles[i]);
+    }
+    EXPECT_EQ(a.point.x, b.point.x);
+    EXPECT_EQ(a.point.y, b.point.y);
+    ASSERT_EQ(a.shape._d(), b.shape._d());
+    EXPECT_EQ(a.shape.point().x, b.shape.point().x);
+    EXPECT_EQ(a.shape.point().y, b.shape.point().y);
+  }
+
+  /// Transcode msg and check that the result has the size serialized_size
+  /// predicted.
+  void transcode(const XTypes::XcdrTranscoder& transcoder,
+                 const DCPS::Message_Block_Ptr& msg, const DCPS::Encoding& from,
+                 const DCPS::Encoding& to, DCPS::Message_Block_Ptr& out)
+  {
+    DCPS::Message_Block_Ptr dup(msg->duplicate());
+    DCPS::Serializer in(dup.get(), from);
+    size_t size = 0;
+    ASSERT_TRUE(transcoder.serialized_size(in, to, size));
+    EXPECT_EQ(msg->total_length(), dup->total_length());
+
+    ASSERT_TRUE(transcoder.transcode(*msg, from, to, out));
+    EXPECT_EQ(size, out->total_length());
+  }
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, all_kinds_round_trip)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var type = get_dynamic_type<DCPS::TranscoderTest_AllKinds_xtag>(tls);
+  const XTypes::XcdrTranscoder transcoder(type, type);
+  ASSERT_TRUE(transcoder.is_valid());
+
+  AllKinds sample;
+  init(sample, 5);
+  DCPS::Message_Block_Ptr original;
+  serialize_sample(original, xcdr2_be, sample);
+
+  // XCDR2 big endian to XCDR1 little endian
+  DCPS::Message_Block_Ptr xcdr1;
+  transcode(transcoder, original, xcdr2_be, xcdr1_le, xcdr1);
+  EXPECT_EQ(DCPS::serialized_size(xcdr1_le, sample), xcdr1->total_length());
+  AllKinds from_xcdr1;
+  deserialize_sample(xcdr1, xcdr1_le, from_xcdr1);
+  check_equal(sample, from_xcdr1);
+
+  // And back again
+  DCPS::Message_Block_Ptr xcdr2;
+  transcode(transcoder, xcdr1, xcdr1_le, xcdr2_le, xcdr2);
+  EXPECT_EQ(DCPS::serialized_size(xcdr2_le, sample), xcdr2->total_length());
+  AllKinds from_xcdr2;
+  deserialize_sample(xcdr2, xcdr2_le, from_xcdr2);
+  check_equal(sample, from_xcdr2);
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, empty_collections)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var type = get_dynamic_type<DCPS::TranscoderTest_AllKinds_xtag>(tls);
+  const XTypes::XcdrTranscoder transcoder(type, type);
+
+  AllKinds sample;
+  init(sample, 0);
+  sample.str = "";
+  sample.wstr = L"";
+  DCPS::Message_Block_Ptr original;
+  serialize_sample(original, xcdr1_be, sample);
+
+  DCPS::Message_Block_Ptr xcdr2;
+  transcode(transcoder, original, xcdr1_be, xcdr2_be, xcdr2);
+  AllKinds result;
+  deserialize_sample(xcdr2, xcdr2_be, result);
+  check_equal(sample, result);
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, key_only)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var type = get_dynamic_type<DCPS::TranscoderTest_AllKinds_xtag>(tls);
+  const XTypes::XcdrTranscoder transcoder(type, type);
+
+  AllKinds sample;
+  init(sample, 2);
+  DCPS::Message_Block_Ptr original;
+  original.reset(new ACE_Message_Block(DCPS::serialized_size(xcdr2_be, DCPS::KeyOnly<const AllKinds>(sample))));
+  {
+    DCPS::Serializer ser(original.get(), xcdr2_be);
+    ASSERT_TRUE(ser << DCPS::KeyOnly<const AllKinds>(sample));
+  }
+
+  DCPS::Message_Block_Ptr xcdr1;
+  ASSERT_TRUE(transcoder.transcode(*original, xcdr2_be, xcdr1_le, xcdr1, DCPS::Sample::KeyOnly));
+  EXPECT_EQ(DCPS::serialized_size(xcdr1_le, DCPS::KeyOnly<const AllKinds>(sample)), xcdr1->total_length());
+
+  AllKinds result;
+  DCPS::Serializer ser(xcdr1.get(), xcdr1_le);
+  ASSERT_TRUE(ser >> DCPS::KeyOnly<AllKinds>(result));
+  EXPECT_EQ(sample.id, result.id);
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, mutable_versions)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var v1 = get_dynamic_type<DCPS::TranscoderTest_MutableV1_xtag>(tls);
+  const DDS::DynamicType_var v2 = get_dynamic_type<DCPS::TranscoderTest_MutableV2_xtag>(tls);
+
+  MutableV1 sample_v1;
+  sample_v1.a = 42;
+  sample_v1.dropped = "gone";
+  sample_v1.values.length(3);
+  for (ACE_CDR::ULong i = 0; i < 3; ++i) {
+    sample_v1.values[i] = static_cast<ACE_CDR::Long>(i + 1);
+  }
+  DCPS::Message_Block_Ptr msg_v1;
+  serialize_sample(msg_v1, xcdr2_be, sample_v1);
+
+  // dropped is skipped and added gets the default value.
+  const XTypes::XcdrTranscoder upgrade(v1, v2);
+  ASSERT_TRUE(upgrade.is_valid());
+  DCPS::Message_Block_Ptr msg_v2;
+  transcode(upgrade, msg_v1, xcdr2_be, xcdr1_le, msg_v2);
+  MutableV2 sample_v2;
+  sample_v2.added = BLUE;
+  deserialize_sample(msg_v2, xcdr1_le, sample_v2);
+  EXPECT_EQ(sample_v1.a, sample_v2.a);
+  ASSERT_EQ(3u, sample_v2.values.length());
+  EXPECT_EQ(3, sample_v2.values[2]);
+  EXPECT_EQ(RED, sample_v2.added);
+
+  // added is skipped and dropped gets the default value.
+  sample_v2.added = GREEN;
+  serialize_sample(msg_v2, xcdr1_le, sample_v2);
+  const XTypes::XcdrTranscoder downgrade(v2, v1);
+  ASSERT_TRUE(downgrade.is_valid());
+  DCPS::Message_Block_Ptr back;
+  transcode(downgrade, msg_v2, xcdr1_le, xcdr2_le, back);
+  MutableV1 result;
+  deserialize_sample(back, xcdr2_le, result);
+  EXPECT_EQ(sample_v1.a, result.a);
+  EXPECT_STREQ("", result.dropped.in());
+  ASSERT_EQ(3u, result.values.length());
+  EXPECT_EQ(1, result.values[0]);
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, appendable_versions)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var v1 = get_dynamic_type<DCPS::TranscoderTest_AppendableV1_xtag>(tls);
+  const DDS::DynamicType_var v2 = get_dynamic_type<DCPS::TranscoderTest_AppendableV2_xtag>(tls);
+
+  AppendableV2 sample_v2;
+  sample_v2.a = -5;
+  sample_v2.b = 6;
+  sample_v2.extra.length(2);
+  sample_v2.extra[0] = 7;
+  sample_v2.extra[1] = 8;
+  DCPS::Message_Block_Ptr msg_v2;
+  serialize_sample(msg_v2, xcdr2_le, sample_v2);
+
+  // The appended member is skipped using the delimiter.
+  const XTypes::XcdrTranscoder downgrade(v2, v1);
+  ASSERT_TRUE(downgrade.is_valid());
+  DCPS::Message_Block_Ptr msg_v1;
+  transcode(downgrade, msg_v2, xcdr2_le, xcdr2_be, msg_v1);
+  AppendableV1 sample_v1;
+  deserialize_sample(msg_v1, xcdr2_be, sample_v1);
+  EXPECT_EQ(sample_v2.a, sample_v1.a);
+  EXPECT_EQ(sample_v2.b, sample_v1.b);
+
+  // The appended member is written as an empty sequence.
+  const XTypes::XcdrTranscoder upgrade(v1, v2);
+  ASSERT_TRUE(upgrade.is_valid());
+  DCPS::Message_Block_Ptr back;
+  transcode(upgrade, msg_v1, xcdr2_be, xcdr2_le, back);
+  AppendableV2 result;
+  deserialize_sample(back, xcdr2_le, result);
+  EXPECT_EQ(sample_v2.a, result.a);
+  EXPECT_EQ(sample_v2.b, result.b);
+  EXPECT_EQ(0u, result.extra.length());
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, incompatible_types)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var mutable_type = get_dynamic_type<DCPS::TranscoderTest_MutableV1_xtag>(tls);
+  const DDS::DynamicType_var appendable_type = get_dynamic_type<DCPS::TranscoderTest_AppendableV1_xtag>(tls);
+  EXPECT_FALSE(XTypes::XcdrTranscoder(mutable_type, appendable_type).is_valid());
+  EXPECT_FALSE(XTypes::XcdrTranscoder(0, appendable_type).is_valid());
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, dynamic_data_serialize)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var type = get_dynamic_type<DCPS::TranscoderTest_AllKinds_xtag>(tls);
+
+  AllKinds sample;
+  init(sample, 3);
+  DCPS::Message_Block_Ptr original;
+  serialize_sample(original, xcdr2_be, sample);
+
+  XTypes::DynamicDataXcdrReadImpl* const read_impl =
+    new XTypes::DynamicDataXcdrReadImpl(original.get(), xcdr2_be, type);
+  DDS::DynamicData_var read_data = read_impl;
+
+  // Unmodified DynamicDataImpl serializes its backing store directly.
+  const XTypes::DynamicDataImpl data(type, read_data);
+  size_t size = 0;
+  ASSERT_TRUE(data.serialized_size(xcdr1_le, size, DCPS::Sample::Full));
+  DCPS::Message_Block_Ptr out(new ACE_Message_Block(size));
+  DCPS::Serializer ser(out.get(), xcdr1_le);
+  ASSERT_TRUE(data.serialize(ser, DCPS::Sample::Full));
+  EXPECT_EQ(size, out->total_length());
+
+  AllKinds result;
+  deserialize_sample(out, xcdr1_le, result);
+  check_equal(sample, result);
+
+  // So does DynamicDataXcdrReadImpl
+  size = 0;
+  ASSERT_TRUE(read_impl->serialized_size(xcdr2_le, size, DCPS::Sample::Full));
+  out.reset(new ACE_Message_Block(size));
+  DCPS::Serializer ser2(out.get(), xcdr2_le);
+  ASSERT_TRUE(read_impl->serialize(ser2, DCPS::Sample::Full));
+  AllKinds result2;
+  deserialize_sample(out, xcdr2_le, result2);
+  check_equal(sample, result2);
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, reuse_sizes)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var v1 = get_dynamic_type<DCPS::TranscoderTest_MutableV1_xtag>(tls);
+  const DDS::DynamicType_var v2 = get_dynamic_type<DCPS::TranscoderTest_MutableV2_xtag>(tls);
+  const XTypes::XcdrTranscoder transcoder(v1, v2);
+  ASSERT_TRUE(transcoder.is_valid());
+
+  MutableV1 sample;
+  sample.a = 7;
+  sample.dropped = "gone";
+  sample.values.length(2);
+  sample.values[0] = 1;
+  sample.values[1] = 2;
+  DCPS::Message_Block_Ptr msg;
+  serialize_sample(msg, xcdr2_be, sample);
+
+  DCPS::Message_Block_Ptr expected;
+  ASSERT_TRUE(transcoder.transcode(*msg, xcdr2_be, xcdr2_le, expected));
+
+  DCPS::Message_Block_Ptr dup(msg->duplicate());
+  DCPS::Serializer size_in(dup.get(), xcdr2_be);
+  XTypes::XcdrTranscoder::Sizes sizes;
+  size_t size = 0;
+  ASSERT_TRUE(transcoder.serialized_size(size_in, xcdr2_le, size, DCPS::Sample::Full, &sizes));
+  ASSERT_EQ(expected->total_length(), size);
+
+  // The write uses the stored sizes and gives the same bytes.
+  DCPS::Message_Block_Ptr out(new ACE_Message_Block(size));
+  DCPS::Serializer in(dup.get(), xcdr2_be);
+  DCPS::Serializer ser(out.get(), xcdr2_le);
+  ASSERT_TRUE(transcoder.transcode(in, ser, DCPS::Sample::Full, &sizes));
+  ASSERT_EQ(size, out->length());
+  EXPECT_EQ(0, std::memcmp(expected->rd_ptr(), out->rd_ptr(), size));
+
+  // Sizes from another transcoder are ignored.
+  const XTypes::XcdrTranscoder other(v1, v2);
+  DCPS::Message_Block_Ptr dup2(msg->duplicate());
+  DCPS::Serializer other_in(dup2.get(), xcdr2_be);
+  ASSERT_TRUE(other.serialized_size(other_in, xcdr2_le, size, DCPS::Sample::Full, &sizes));
+  DCPS::Message_Block_Ptr out2(new ACE_Message_Block(size));
+  DCPS::Serializer in2(dup2.get(), xcdr2_be);
+  DCPS::Serializer ser2(out2.get(), xcdr2_le);
+  ASSERT_TRUE(transcoder.transcode(in2, ser2, DCPS::Sample::Full, &sizes));
+  EXPECT_EQ(0, std::memcmp(expected->rd_ptr(), out2->rd_ptr(), size));
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, cache)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var v1 = get_dynamic_type<DCPS::TranscoderTest_MutableV1_xtag>(tls);
+  const DDS::DynamicType_var v2 = get_dynamic_type<DCPS::TranscoderTest_MutableV2_xtag>(tls);
+
+  XTypes::XcdrTranscoderCache cache;
+  const XTypes::XcdrTranscoder_rch upgrade = cache.get(v1, v2);
+  ASSERT_TRUE(upgrade);
+  EXPECT_TRUE(upgrade->is_valid());
+  EXPECT_EQ(upgrade, cache.get(v1, v2));
+  EXPECT_NE(upgrade, cache.get(v2, v1));
+
+  // Erasing a type forgets the transcoders to and from it.
+  cache.erase(v2);
+  EXPECT_NE(upgrade, cache.get(v1, v2));
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+
+  // A bounded cache drops the least recently used transcoder.
+  XTypes::XcdrTranscoderCache bounded(2);
+  const XTypes::XcdrTranscoder_rch v1_v2 = bounded.get(v1, v2);
+  const XTypes::XcdrTranscoder_rch v2_v1 = bounded.get(v2, v1);
+  EXPECT_EQ(v1_v2, bounded.get(v1, v2));
+  bounded.get(v1, v1);
+  EXPECT_EQ(2u, bounded.size());
+  EXPECT_EQ(v1_v2, bounded.get(v1, v2));
+  EXPECT_NE(v2_v1, bounded.get(v2, v1));
+
+  // The identity transcoder is compiled once per type.
+  const XTypes::XcdrTranscoder_rch identity = XTypes::identity_transcoder(v1);
+  ASSERT_TRUE(identity);
+  EXPECT_TRUE(identity->is_valid());
+  EXPECT_EQ(identity, XTypes::identity_transcoder(v1));
+  EXPECT_NE(identity, XTypes::identity_transcoder(v2));
+}
+
+TEST(dds_DCPS_XTypes_XcdrTranscoder, Benchmark)
+{
+  XTypes::TypeLookupService tls;
+  const DDS::DynamicType_var type = get_dynamic_type<DCPS::TranscoderTest_AllKinds_xtag>(tls);
+  const XTypes::XcdrTranscoder transcoder(type, type);
+
+  AllKinds sample;
+  init(sample, 256);
+  DCPS::Message_Block_Ptr original;
+  serialize_sample(original, xcdr2_be, sample);
+
+  const size_t samples = 200;
+  DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    DCPS::Message_Block_Ptr out;
+    ASSERT_TRUE(transcoder.transcode(*original, xcdr2_be, xcdr1_le, out));
+  }
+  const double transcode_us = (DCPS::MonotonicTimePoint::now() - start).to_double() * 1e6 / samples;
+
+  start = DCPS::MonotonicTimePoint::now();
+  for (size_t i = 0; i < samples; ++i) {
+    DDS::DynamicData_var dd = new XTypes::DynamicDataXcdrReadImpl(original.get(), xcdr2_be, type);
+    const DDS::DynamicData_ptr ptr = dd.in();
+    size_t size = 0;
+    ASSERT_TRUE(DCPS::serialized_size(xcdr1_le, size, ptr));
+    DCPS::Message_Block_Ptr out(new ACE_Message_Block(size));
+    DCPS::Serializer ser(out.get(), xcdr1_le);
+    ASSERT_TRUE(ser << ptr);
+  }
+  const double dynamic_data_us = (DCPS::MonotonicTimePoint::now() - start).to_double() * 1e6 / samples;
+
+  ACE_DEBUG((LM_INFO, "XcdrTranscoder Benchmark: %B samples of %B bytes\n",
+             samples, original->total_length()));
+  ACE_DEBUG((LM_INFO, "  XcdrTranscoder          %.2f us/sample\n", transcode_us));
+  ACE_DEBUG((LM_INFO, "  DynamicData serializer  %.2f us/sample\n", dynamic_data_us));
+}
+
+#endif // OPENDDS_SAFETY_PROFILE
@@ -98,4 +98,95 @@ TEST(dds_DCPS_security_AccessControl_Permissions, Permissions_load)
   EXPECT_EQ(action.validity, Permissions::Validity_t(1444870800, 1760490000));
 }
 
+TEST(dds_DCPS_security_AccessControl_Permissions, Permissions_Grant_find_actions)
+{
+  Permissions p;
+  OpenDDS::Security::SSL::SignedDocument sd;
+  sd.content(
+             "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+             "<dds xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"http://www.omg.org/spec/DDS-SECURITY/20170901/omg_shared_ca_permissions.xsd\">"
+             "  <permissions>"
+             "    <grant name=\"TheGrant\">"
+             "      <subject_name>CN=Ozzie Ozmann,O=Internet Widgits Pty Ltd,ST=Some-State,C=AU</subject_name>"
+             "      <validity>"
+             "        <not_before>2015-09-15T01:00:00</not_before>"
+             "        <not_after>2025-09-15T01:00:00</not_after>"
+             "      </validity>"
+             "      <deny_rule>"
+             "        <domains>"
+             "          <id>0</id>"
+             "        </domains>"
+             "        <publish>"
+             "          <topics>"
+             "            <topic>Secret*</topic>"
+             "          </topics>"
+             "        </publish>"
+             "      </deny_rule>"
+             "      <allow_rule>"
+             "        <domains>"
+             "          <id>0</id>"
+             "        </domains>"
+             "        <publish>"
+             "          <topics>"
+             "            <topic>*</topic>"
+             "          </topics>"
+             "          <partitions>"
+             "            <partition>P?</partition>"
+             "          </partitions>"
+             "        </publish>"
+             "        <subscribe>"
+             "          <topics>"
+             "            <topic>Square</topic>"
+             "          </topics>"
+             "        </subscribe>"
+             "      </allow_rule>"
+             "      <default>DENY</default>"
+             "    </grant>"
+             "  </permissions>"
+             "</dds>"
+             );
+  ASSERT_EQ(p.load(sd), 0);
+  ASSERT_EQ(p.grants_.size(), 1U);
+  const Permissions::Grant_rch grant = p.grants_[0];
+
+  DDS::StringSeq partitions;
+  partitions.length(1);
+  partitions[0] = "P1";
+
+  for (int pass = 0; pass < 2; ++pass) {
+    // The second pass is answered from the decision cache.
+    TopicIndex::Matches actions;
+    grant->find_actions("SecretSquare", 0, Permissions::PUBLISH, partitions, actions);
+    ASSERT_EQ(actions.size(), 2U);
+    EXPECT_EQ(grant->rule_of(actions[0]).ad_type, Permissions::DENY);
+    EXPECT_EQ(grant->rule_of(actions[1]).ad_type, Permissions::ALLOW);
+
+    actions.clear();
+    grant->find_actions("Circle", 0, Permissions::PUBLISH, partitions, actions);
+    ASSERT_EQ(actions.size(), 1U);
+    EXPECT_EQ(grant->action(actions[0]).ps_type, Permissions::PUBLISH);
+
+    actions.clear();
+    grant->find_actions("Circle", 1, Permissions::PUBLISH, partitions, actions);
+    EXPECT_TRUE(actions.empty());
+
+    actions.clear();
+    grant->find_actions("Circle", 0, Permissions::SUBSCRIBE, partitions, actions);
+    EXPECT_TRUE(actions.empty());
+  }
+
+  DDS::StringSeq other;
+  other.length(1);
+  other[0] = "Q1";
+  TopicIndex::Matches actions;
+  grant->find_actions("Circle", 0, Permissions::PUBLISH, other, actions);
+  EXPECT_TRUE(actions.empty());
+
+  actions.clear();
+  grant->find_topic_actions("Square", actions);
+  ASSERT_EQ(actions.size(), 2U);
+  EXPECT_EQ(grant->action(actions[0]).ps_type, Permissions::PUBLISH);
+  EXPECT_EQ(grant->action(actions[1]).ps_type, Permissions::SUBSCRIBE);
+}
+
 #endif
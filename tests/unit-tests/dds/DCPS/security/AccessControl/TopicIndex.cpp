@@ -0,0 +1,99 @@
+#include <dds/OpenDDSConfigWrapper.h>
+
+#if OPENDDS_CONFIG_SECURITY
+
+#include <dds/DCPS/security/AccessControl/TopicIndex.h>
+#include <dds/DCPS/security/AccessControlBuiltInImpl.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::Security;
+
+namespace {
+  TopicIndex::Matches find(const TopicIndex& index, const char* name)
+  {
+    TopicIndex::Matches m;
+    index.find(name, m);
+    return m;
+  }
+}
+
+TEST(dds_DCPS_security_AccessControl_TopicIndex, empty)
+{
+  TopicIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(find(index, "Square").empty());
+}
+
+TEST(dds_DCPS_security_AccessControl_TopicIndex, exact_prefix_and_glob)
+{
+  TopicIndex index;
+  index.insert("Square", 0);
+  index.insert("Sq*", 1);
+  index.insert("*", 2);
+  index.insert("S?uare", 3);
+  index.insert("[CS]ircle", 4);
+  index.insert("Circle", 5);
+  EXPECT_EQ(index.size(), 6u);
+
+  TopicIndex::Matches m = find(index, "Square");
+  ASSERT_EQ(m.size(), 4u);
+  EXPECT_EQ(m[0], 0u);
+  EXPECT_EQ(m[1], 1u);
+  EXPECT_EQ(m[2], 2u);
+  EXPECT_EQ(m[3], 3u);
+
+  m = find(index, "Circle");
+  ASSERT_EQ(m.size(), 3u);
+  EXPECT_EQ(m[0], 2u);
+  EXPECT_EQ(m[1], 4u);
+  EXPECT_EQ(m[2], 5u);
+
+  m = find(index, "Sq");
+  ASSERT_EQ(m.size(), 2u);
+  EXPECT_EQ(m[0], 1u);
+  EXPECT_EQ(m[1], 2u);
+
+  m = find(index, "");
+  ASSERT_EQ(m.size(), 1u);
+  EXPECT_EQ(m[0], 2u);
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(find(index, "Square").empty());
+}
+
+TEST(dds_DCPS_security_AccessControl_TopicIndex, matches_pattern_match)
+{
+  const char* const expressions[] = { "A", "AB*", "A*C", "*B", "?", "A[BC]D", "ABC", "AB**" };
+  const char* const names[] = { "", "A", "AB", "ABC", "ABD", "ACD", "B", "XB", "ABCD" };
+  const size_t n_expr = sizeof expressions / sizeof expressions[0];
+  const size_t n_names = sizeof names / sizeof names[0];
+
+  TopicIndex index;
+  for (size_t i = 0; i < n_expr; ++i) {
+    index.insert(expressions[i], i);
+  }
+
+  for (size_t n = 0; n < n_names; ++n) {
+    TopicIndex::Matches expected;
+    for (size_t i = 0; i < n_expr; ++i) {
+      if (OpenDDS::Security::AccessControlBuiltInImpl::pattern_match(names[n], expressions[i])) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(find(index, names[n]), expected) << names[n];
+  }
+}
+
+TEST(dds_DCPS_security_AccessControl_TopicIndex, duplicate_ids)
+{
+  TopicIndex index;
+  index.insert("Square", 7);
+  index.insert("Sq*", 7);
+  const TopicIndex::Matches m = find(index, "Square");
+  ASSERT_EQ(m.size(), 1u);
+  EXPECT_EQ(m[0], 7u);
+}
+
+#endif
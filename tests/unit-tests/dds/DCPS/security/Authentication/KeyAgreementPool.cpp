@@ -0,0 +1,74 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#if OPENDDS_CONFIG_SECURITY
+
+#include <dds/DCPS/security/Authentication/KeyAgreementPool.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::Security;
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct CountingJob : Job {
+    CountingJob(ACE_Thread_Mutex& mutex, ConditionVariable<ACE_Thread_Mutex>& cv, int& count)
+      : mutex_(mutex), cv_(cv), count_(count)
+    {}
+
+    void execute()
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      ++count_;
+      cv_.notify_all();
+    }
+
+    ACE_Thread_Mutex& mutex_;
+    ConditionVariable<ACE_Thread_Mutex>& cv_;
+    int& count_;
+  };
+}
+
+TEST(dds_DCPS_security_Authentication_KeyAgreementPool, post_not_running)
+{
+  KeyAgreementPool pool;
+  ACE_Thread_Mutex mutex;
+  ConditionVariable<ACE_Thread_Mutex> cv(mutex);
+  int count = 0;
+  EXPECT_FALSE(pool.running());
+  EXPECT_FALSE(pool.post(make_rch<CountingJob>(ref(mutex), ref(cv), ref(count))));
+  EXPECT_EQ(0, count);
+}
+
+TEST(dds_DCPS_security_Authentication_KeyAgreementPool, post_runs_jobs)
+{
+  KeyAgreementPool pool;
+  pool.start(2, 1);
+  ASSERT_TRUE(pool.running());
+
+  ACE_Thread_Mutex mutex;
+  ConditionVariable<ACE_Thread_Mutex> cv(mutex);
+  ThreadStatusManager tsm;
+  int count = 0;
+  static const int JOBS = 10;
+  for (int i = 0; i < JOBS; ++i) {
+    EXPECT_TRUE(pool.post(make_rch<CountingJob>(ref(mutex), ref(cv), ref(count))));
+  }
+
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex);
+    while (count < JOBS) {
+      cv.wait(tsm);
+    }
+  }
+  EXPECT_EQ(JOBS, count);
+
+  pool.shutdown();
+  EXPECT_FALSE(pool.running());
+}
+
+#endif
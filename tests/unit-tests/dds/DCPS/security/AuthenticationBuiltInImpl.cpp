@@ -1097,4 +1097,91 @@ TEST_F(dds_DCPS_security_AuthenticationBuiltInImpl, GetSharedSecret_InitiatorAnd
   ASSERT_EQ(secret1_data.in(), secret2_data.in());
 }
 
+TEST_F(dds_DCPS_security_AuthenticationBuiltInImpl, HandshakeThreads_FullHandshake_RecordsLatency)
+{
+  SecurityException ex;
+
+  Property_t threads;
+  threads.name = AuthenticationBuiltInImpl::PROPERTY_HANDSHAKE_THREADS;
+  threads.value = "2";
+  threads.propagate = false;
+  mp1.add_property(threads);
+  mp2.add_property(threads);
+
+  ValidationResult_t r = mp2.auth.validate_local_identity(mp2.id_handle, mp2.guid_adjusted, mp2.domain_id, mp2.qos, mp2.guid, mp2.ex);
+  ASSERT_EQ(DDS::Security::VALIDATION_OK, r);
+  ASSERT_EQ(true, mp2.auth.get_identity_token(mp2.id_token, mp2.id_handle, mp2.ex));
+
+  r = mp1.auth.validate_local_identity(mp1.id_handle, mp1.guid_adjusted, mp1.domain_id, mp1.qos, mp1.guid, mp1.ex);
+  ASSERT_EQ(DDS::Security::VALIDATION_OK, r);
+  ASSERT_EQ(true, mp1.auth.get_identity_token(mp1.id_token, mp1.id_handle, mp1.ex));
+
+  r = mp1.auth.validate_remote_identity(mp1.id_handle_remote,
+                                        mp1.auth_request_message_token,
+                                        mp1.auth_request_message_token_remote,
+                                        mp1.id_handle,
+                                        mp2.id_token,
+                                        mp2.guid_adjusted,
+                                        ex);
+  ASSERT_EQ(DDS::Security::VALIDATION_PENDING_HANDSHAKE_REQUEST, r);
+
+  DDS::Security::HandshakeMessageToken request_token;
+  r = mp1.auth.begin_handshake_request(mp1.handshake_handle,
+                                       request_token,
+                                       mp1.id_handle,
+                                       mp1.id_handle_remote,
+                                       mp1.mock_participant_builtin_topic_data,
+                                       ex);
+  ASSERT_EQ(r, DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE);
+
+  mp2.auth_request_message_token_remote = mp1.auth_request_message_token;
+  r = mp2.auth.validate_remote_identity(mp2.id_handle_remote,
+                                        mp2.auth_request_message_token,
+                                        mp2.auth_request_message_token_remote,
+                                        mp2.id_handle,
+                                        mp1.id_token,
+                                        mp1.guid_adjusted,
+                                        ex);
+  ASSERT_EQ(DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE, r);
+
+  DDS::Security::HandshakeMessageToken reply_token(request_token);
+  r = mp2.auth.begin_handshake_reply(mp2.handshake_handle,
+                                     reply_token,
+                                     mp2.id_handle_remote,
+                                     mp2.id_handle,
+                                     mp2.mock_participant_builtin_topic_data,
+                                     ex);
+  ASSERT_EQ(r, DDS::Security::VALIDATION_PENDING_HANDSHAKE_MESSAGE);
+
+  DDS::Security::HandshakeMessageToken final_token;
+  r = mp1.auth.process_handshake(final_token, reply_token, mp1.handshake_handle, ex);
+  ASSERT_EQ(r, DDS::Security::VALIDATION_OK_FINAL_MESSAGE);
+
+  DDS::Security::HandshakeMessageToken unused_token;
+  r = mp2.auth.process_handshake(unused_token, final_token, mp2.handshake_handle, ex);
+  ASSERT_EQ(r, DDS::Security::VALIDATION_OK);
+
+  SharedSecretHandle_var secret1 = mp1.auth.get_shared_secret(mp1.handshake_handle, ex);
+  SharedSecretHandle_var secret2 = mp2.auth.get_shared_secret(mp2.handshake_handle, ex);
+  ASSERT_NE((void*)0, secret1);
+  ASSERT_NE((void*)0, secret2);
+  DDS::OctetSeq_var secret1_data = secret1->sharedSecret();
+  DDS::OctetSeq_var secret2_data = secret2->sharedSecret();
+  ASSERT_EQ(secret1_data.in(), secret2_data.in());
+
+  const AuthenticationBuiltInImpl::HandshakeLatency initiator = mp1.auth.handshake_latency();
+  EXPECT_EQ(1u, initiator.begin_request.count());
+  EXPECT_EQ(0u, initiator.begin_reply.count());
+  EXPECT_EQ(1u, initiator.process_reply.count());
+  EXPECT_EQ(1u, initiator.complete.count());
+
+  const AuthenticationBuiltInImpl::HandshakeLatency replier = mp2.auth.handshake_latency();
+  EXPECT_EQ(1u, replier.begin_reply.count());
+  EXPECT_EQ(1u, replier.process_final.count());
+  EXPECT_EQ(1u, replier.complete.count());
+
+  mp1.auth.reset_handshake_latency();
+  EXPECT_EQ(0u, mp1.auth.handshake_latency().complete.count());
+}
+
 #endif
@@ -9,6 +9,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 using namespace OpenDDS::Security;
 using namespace testing;
 
@@ -1101,4 +1103,73 @@ TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, decode_serialize
   EXPECT_EQ(get_buffer(), output);
 }
 
+TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_decode_serialized_payload_Repeated)
+{
+  using namespace DDS::Security;
+  CryptoKeyFactory& kef = dynamic_cast<CryptoKeyFactory&>(get_inst());
+  CryptoKeyExchange& kex = dynamic_cast<CryptoKeyExchange&>(get_inst());
+
+  DDS::PropertySeq no_properties;
+  EndpointSecurityAttributes esa = {{false, false, false, false}, false, true, false,
+                                    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED, no_properties};
+  SecurityException ex;
+  const DatawriterCryptoHandle ldwch = kef.register_local_datawriter(0, no_properties, esa, ex);
+  const DatareaderCryptoHandle drch = kef.register_local_datareader(0, no_properties, esa, ex);
+  const ParticipantCryptoHandle rpch = kef.register_matched_remote_participant(0, 1, 2, &shared_secret_, ex);
+  const DatawriterCryptoHandle dwch = kef.register_matched_remote_datawriter(drch, rpch, &shared_secret_, ex);
+
+  DatawriterCryptoTokenSeq dwct;
+  EXPECT_TRUE(kex.create_local_datawriter_crypto_tokens(dwct, ldwch, 99, ex));
+  EXPECT_TRUE(kex.set_remote_datawriter_crypto_tokens(drch, dwch, dwct, ex));
+
+  // Each message uses a new IV with the same session key, so cached cipher
+  // contexts are reused on both sides.
+  DDS::OctetSeq inline_qos;
+  for (CORBA::Octet i = 1; i <= 5; ++i) {
+    init_buffer(100 * i, i);
+    DDS::OctetSeq encoded;
+    ASSERT_TRUE(get_inst().encode_serialized_payload(encoded, inline_qos, get_buffer(), ldwch, ex));
+    EXPECT_FALSE(get_buffer() == encoded);
+    DDS::OctetSeq decoded;
+    ASSERT_TRUE(get_inst().decode_serialized_payload(decoded, encoded, inline_qos, drch, dwch, ex));
+    EXPECT_EQ(get_buffer(), decoded);
+  }
+}
+
+TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_decode_serialized_payload_Aliased)
+{
+  using namespace DDS::Security;
+  CryptoKeyFactory& kef = dynamic_cast<CryptoKeyFactory&>(get_inst());
+  CryptoKeyExchange& kex = dynamic_cast<CryptoKeyExchange&>(get_inst());
+
+  DDS::PropertySeq no_properties;
+  EndpointSecurityAttributes esa = {{false, false, false, false}, false, true, false,
+                                    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED, no_properties};
+  SecurityException ex;
+  const DatawriterCryptoHandle ldwch = kef.register_local_datawriter(0, no_properties, esa, ex);
+  const DatareaderCryptoHandle drch = kef.register_local_datareader(0, no_properties, esa, ex);
+  const ParticipantCryptoHandle rpch = kef.register_matched_remote_participant(0, 1, 2, &shared_secret_, ex);
+  const DatawriterCryptoHandle dwch = kef.register_matched_remote_datawriter(drch, rpch, &shared_secret_, ex);
+
+  DatawriterCryptoTokenSeq dwct;
+  EXPECT_TRUE(kex.create_local_datawriter_crypto_tokens(dwct, ldwch, 99, ex));
+  EXPECT_TRUE(kex.set_remote_datawriter_crypto_tokens(drch, dwch, dwct, ex));
+
+  // The transport hands the plugin a view of its own buffer to encode.
+  init_buffer(200, 3);
+  DDS::OctetSeq plain;
+  plain.replace(get_buffer().length(), get_buffer().length(), get_buffer().get_buffer(), false);
+  DDS::OctetSeq encoded, inline_qos;
+  ASSERT_TRUE(get_inst().encode_serialized_payload(encoded, inline_qos, plain, ldwch, ex));
+  EXPECT_EQ(get_buffer().get_buffer(), plain.get_buffer());
+
+  // and decodes into a buffer it owns, which has room for the cipher output.
+  std::vector<CORBA::Octet> storage(encoded.length() + 32);
+  DDS::OctetSeq decoded;
+  decoded.replace(static_cast<CORBA::ULong>(storage.size()), 0, &storage[0], false);
+  ASSERT_TRUE(get_inst().decode_serialized_payload(decoded, encoded, inline_qos, drch, dwch, ex));
+  EXPECT_EQ(&storage[0], decoded.get_buffer());
+  EXPECT_EQ(get_buffer(), decoded);
+}
+
 #endif
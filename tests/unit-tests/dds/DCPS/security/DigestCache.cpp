@@ -0,0 +1,65 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#if OPENDDS_CONFIG_SECURITY
+
+#include <dds/DCPS/security/DigestCache.h>
+
+#include <gtest/gtest.h>
+
+#include <ace/OS_NS_unistd.h>
+
+using namespace OpenDDS::Security;
+using OpenDDS::DCPS::TimeDuration;
+
+TEST(dds_DCPS_security_DigestCache, find_insert)
+{
+  DigestCache<int> cache(2, TimeDuration(60));
+  int value = 0;
+  EXPECT_FALSE(cache.find("a", value));
+  cache.insert("a", 1);
+  EXPECT_TRUE(cache.find("a", value));
+  EXPECT_EQ(1, value);
+  cache.insert("a", 2);
+  EXPECT_TRUE(cache.find("a", value));
+  EXPECT_EQ(2, value);
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(dds_DCPS_security_DigestCache, evicts_oldest)
+{
+  DigestCache<int> cache(2, TimeDuration(60));
+  cache.insert("a", 1);
+  cache.insert("b", 2);
+  cache.insert("c", 3);
+  int value = 0;
+  EXPECT_FALSE(cache.find("a", value));
+  EXPECT_TRUE(cache.find("b", value));
+  EXPECT_TRUE(cache.find("c", value));
+  EXPECT_EQ(2u, cache.size());
+}
+
+TEST(dds_DCPS_security_DigestCache, reinserted_after_expiry)
+{
+  DigestCache<int> cache(2, TimeDuration::from_msec(50));
+  cache.insert("a", 1);
+  ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  cache.insert("x", 2);
+
+  int value = 0;
+  EXPECT_FALSE(cache.find("a", value));
+  cache.insert("a", 3);
+  cache.insert("b", 4);
+
+  // The key queued for the expired "a" must not evict the new one.
+  EXPECT_TRUE(cache.find("a", value));
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(cache.find("x", value));
+  EXPECT_TRUE(cache.find("b", value));
+}
+
+#endif
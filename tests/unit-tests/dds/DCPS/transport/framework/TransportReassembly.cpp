@@ -1188,3 +1188,115 @@ TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Fill_Overlapping_Inp
   EXPECT_EQ(0u, base);
   EXPECT_EQ(0u, gaps.result_bits);
 }
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Out_Of_Order)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024);
+  SequenceNumber msg_seq(3);
+  GUID_t pub_id = create_pub_id();
+  const ACE_UINT32 sample_size = 1024 * 3 + 100;
+  Sample data1(pub_id, msg_seq, true, 1024, 1);
+  Sample data2(pub_id, msg_seq, true, 1024, 2);
+  Sample data3(pub_id, msg_seq, true, 1024, 3);
+  Sample data4(pub_id, msg_seq, false, 100, 4);
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(4, 4), data4.sample, 4, sample_size)); // 4
+  EXPECT_FALSE(tr.reassemble(FragmentRange(2, 2), data2.sample, 4, sample_size)); // 2, 4
+  EXPECT_TRUE(tr.has_frags(msg_seq, pub_id));
+
+  Gaps gaps;
+  CORBA::ULong base = gaps.get(tr, msg_seq, pub_id);
+  EXPECT_EQ(1u, base);
+  EXPECT_EQ(3u, gaps.result_bits);
+  EXPECT_TRUE(gaps.check_gap(1));
+  EXPECT_FALSE(gaps.check_gap(2));
+  EXPECT_TRUE(gaps.check_gap(3));
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(3, 3), data3.sample, 4, sample_size)); // 2-4
+  EXPECT_TRUE(tr.reassemble(FragmentRange(1, 1), data1.sample, 4, sample_size)); // 1-4
+
+  EXPECT_FALSE(tr.has_frags(msg_seq, pub_id));
+  EXPECT_EQ(size_t(sample_size), data1.sample.data_length());
+  EXPECT_EQ(sample_size, data1.sample.header_.message_length_);
+  EXPECT_FALSE(data1.sample.header_.more_fragments_);
+  EXPECT_EQ(1, data1.sample.peek(0));
+  EXPECT_EQ(1, data1.sample.peek(1023));
+  EXPECT_EQ(2, data1.sample.peek(1024));
+  EXPECT_EQ(3, data1.sample.peek(2048));
+  EXPECT_EQ(4, data1.sample.peek(3072));
+  EXPECT_EQ(4, data1.sample.peek(sample_size - 1));
+
+  Message_Block_Ptr mb(data1.sample.data());
+  EXPECT_TRUE(mb->cont() == 0);
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Header_From_First)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024);
+  SequenceNumber msg_seq(6);
+  GUID_t pub_id = create_pub_id();
+  const ACE_UINT32 sample_size = 1024 * 3;
+  Sample data1(pub_id, msg_seq, true, 1024, 1);
+  Sample data2(pub_id, msg_seq, true, 1024, 2);
+  Sample data3(pub_id, msg_seq, false, 1024, 3);
+  data1.sample.header_.source_timestamp_sec_ = 1;
+  data2.sample.header_.source_timestamp_sec_ = 2;
+  data3.sample.header_.source_timestamp_sec_ = 3;
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(3, 3), data3.sample, 3, sample_size));
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), data1.sample, 3, sample_size));
+  EXPECT_TRUE(tr.reassemble(FragmentRange(2, 2), data2.sample, 3, sample_size));
+
+  EXPECT_EQ(1, data2.sample.header_.source_timestamp_sec_);
+  EXPECT_EQ(sample_size, data2.sample.header_.message_length_);
+  EXPECT_FALSE(data2.sample.header_.more_fragments_);
+  EXPECT_EQ(1, data2.sample.peek(0));
+  EXPECT_EQ(3, data2.sample.peek(2048));
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Duplicates_And_Late)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024);
+  SequenceNumber msg_seq(4);
+  GUID_t pub_id = create_pub_id();
+  const ACE_UINT32 sample_size = 1024 * 3;
+  Sample data1(pub_id, msg_seq, true, 1024 * 2, 1);
+  Sample dup(pub_id, msg_seq, true, 1024, 1);
+  Sample bad(pub_id, msg_seq, true, 1024, 5);
+  Sample data3(pub_id, msg_seq, false, 1024, 3);
+  Sample late(pub_id, msg_seq, false, 1024, 3);
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 2), data1.sample, 3, sample_size)); // 1-2
+  EXPECT_FALSE(tr.reassemble(FragmentRange(2, 2), dup.sample, 3, sample_size)); // duplicate
+  EXPECT_FALSE(tr.reassemble(FragmentRange(4, 4), bad.sample, 3, sample_size)); // out of range
+
+  Gaps gaps;
+  CORBA::ULong base = gaps.get(tr, msg_seq, pub_id);
+  EXPECT_EQ(3u, base);
+  EXPECT_EQ(1u, gaps.result_bits);
+  EXPECT_TRUE(gaps.check_gap(3));
+
+  EXPECT_TRUE(tr.reassemble(FragmentRange(3, 3), data3.sample, 3, sample_size)); // 1-3
+  EXPECT_EQ(size_t(sample_size), data3.sample.data_length());
+  EXPECT_EQ(1, data3.sample.peek(2047));
+  EXPECT_EQ(3, data3.sample.peek(2048));
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(3, 3), late.sample, 3, sample_size));
+  EXPECT_FALSE(tr.has_frags(msg_seq, pub_id));
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Over_Max_Size)
+{
+  TransportReassembly tr(TimeDuration(300), 1024);
+  SequenceNumber msg_seq(5);
+  GUID_t pub_id = create_pub_id();
+  Sample data1(pub_id, msg_seq, true, 1024, 1);
+  Sample data2(pub_id, msg_seq, false, 1024, 2);
+
+  // larger than the maximum: reassembled by joining fragments
+  EXPECT_FALSE(tr.reassemble(FragmentRange(2, 2), data2.sample, 2, 2048));
+  EXPECT_TRUE(tr.reassemble(FragmentRange(1, 1), data1.sample, 2, 2048));
+  EXPECT_EQ(size_t(2048), data1.sample.data_length());
+  EXPECT_EQ(1, data1.sample.peek(0));
+  EXPECT_EQ(2, data1.sample.peek(1024));
+}
@@ -0,0 +1,72 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/AckNackBatch.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  typedef AckNackBatch<int> Batch;
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AckNackBatch, not_in_batch)
+{
+  Batch batch;
+  EXPECT_FALSE(batch.defer(1));
+  Batch::WriterSet writers;
+  EXPECT_FALSE(batch.end(writers));
+  EXPECT_FALSE(batch.active());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AckNackBatch, coalesces)
+{
+  Batch batch;
+  batch.begin();
+  // Many ACKNACKs for two writers in one message
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(batch.defer(i % 2));
+  }
+  Batch::WriterSet writers;
+  EXPECT_TRUE(batch.end(writers));
+  // Each writer computes "acked by all" once instead of 50 times.
+  EXPECT_EQ(2u, writers.size());
+  EXPECT_FALSE(batch.active());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AckNackBatch, nested)
+{
+  Batch batch;
+  batch.begin();
+  batch.defer(1);
+  batch.begin();
+  batch.defer(2);
+  Batch::WriterSet writers;
+  EXPECT_FALSE(batch.end(writers));
+  EXPECT_TRUE(writers.empty());
+  EXPECT_TRUE(batch.end(writers));
+  EXPECT_EQ(2u, writers.size());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AckNackBatch, reused)
+{
+  Batch batch;
+  batch.begin();
+  EXPECT_TRUE(batch.active());
+  batch.defer(1);
+  Batch::WriterSet writers;
+  EXPECT_TRUE(batch.end(writers));
+  EXPECT_FALSE(batch.active());
+
+  // The next message starts with an empty batch.
+  batch.begin();
+  batch.defer(2);
+  writers.clear();
+  EXPECT_TRUE(batch.end(writers));
+  ASSERT_EQ(1u, writers.size());
+  EXPECT_EQ(2, *writers.begin());
+  EXPECT_FALSE(batch.defer(3));
+}
@@ -0,0 +1,91 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/AdaptiveTiming.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const TimeDuration configured(1);
+  const TimeDuration min_delay(0, 1000);
+
+  void round_trip(AdaptiveTiming& timing, MonotonicTimePoint& now, const TimeDuration& rtt)
+  {
+    timing.heartbeat_sent(now);
+    now += rtt;
+    timing.acknack_received(now);
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AdaptiveTiming, configured_without_measurement)
+{
+  AdaptiveTiming timing;
+  EXPECT_EQ(configured, timing.heartbeat_interval(configured, min_delay));
+  EXPECT_EQ(configured, timing.nack_response_delay(configured, min_delay));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AdaptiveTiming, follows_round_trip_time)
+{
+  AdaptiveTiming timing;
+  MonotonicTimePoint now(ACE_Time_Value(100));
+  for (int i = 0; i < 50; ++i) {
+    round_trip(timing, now, TimeDuration(0, 10000));
+  }
+  // Close to 2 * RTO and RTT / 2 once the variation has settled
+  EXPECT_NEAR(timing.heartbeat_interval(configured, min_delay).to_double(), 0.020, 0.002);
+  EXPECT_NEAR(timing.nack_response_delay(configured, min_delay).to_double(), 0.005, 0.0005);
+
+  // A slower path increases the intervals again.
+  for (int i = 0; i < 50; ++i) {
+    round_trip(timing, now, TimeDuration(0, 100000));
+  }
+  EXPECT_NEAR(timing.heartbeat_interval(configured, min_delay).to_double(), 0.200, 0.02);
+  EXPECT_NEAR(timing.nack_response_delay(configured, min_delay).to_double(), 0.050, 0.005);
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AdaptiveTiming, bounded_without_congestion)
+{
+  AdaptiveTiming fast;
+  MonotonicTimePoint now(ACE_Time_Value(100));
+  round_trip(fast, now, TimeDuration(0, 10));
+  EXPECT_EQ(min_delay, fast.heartbeat_interval(configured, min_delay));
+  EXPECT_EQ(min_delay, fast.nack_response_delay(configured, min_delay));
+
+  AdaptiveTiming slow;
+  round_trip(slow, now, TimeDuration(5));
+  EXPECT_EQ(configured, slow.heartbeat_interval(configured, min_delay));
+  EXPECT_EQ(configured, slow.nack_response_delay(configured, min_delay));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_AdaptiveTiming, backs_off_when_unanswered)
+{
+  AdaptiveTiming timing;
+  MonotonicTimePoint now(ACE_Time_Value(100));
+  round_trip(timing, now, TimeDuration(0, 100000));
+  const TimeDuration interval = timing.heartbeat_interval(configured, min_delay);
+  const TimeDuration delay = timing.nack_response_delay(configured, min_delay);
+
+  timing.heartbeat_sent(now);
+  timing.heartbeat_sent(now);
+  EXPECT_EQ(2u, timing.backoff());
+  EXPECT_EQ(2.0 * interval, timing.heartbeat_interval(configured, min_delay));
+  EXPECT_EQ(2.0 * delay, timing.nack_response_delay(configured, min_delay));
+
+  // The backoff is limited but can go past the configured interval.
+  for (int i = 0; i < 10; ++i) {
+    timing.heartbeat_sent(now);
+  }
+  EXPECT_EQ(8u, timing.backoff());
+  EXPECT_EQ(8.0 * interval, timing.heartbeat_interval(configured, min_delay));
+  EXPECT_GT(timing.heartbeat_interval(configured, min_delay), configured);
+
+  // An answer clears the backoff.
+  now += TimeDuration(0, 100000);
+  timing.acknack_received(now);
+  EXPECT_EQ(1u, timing.backoff());
+  EXPECT_LT(timing.heartbeat_interval(configured, min_delay), configured);
+}
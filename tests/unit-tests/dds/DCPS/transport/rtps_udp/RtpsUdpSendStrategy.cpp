@@ -0,0 +1,50 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#if OPENDDS_CONFIG_SECURITY
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpSendStrategy.h>
+
+#include <cstring>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, to_octets_single_block)
+{
+  ACE_Message_Block mb(16);
+  mb.copy("0123456789abcdef", 16);
+  mb.rd_ptr(4);
+
+  DDS::OctetSeq out;
+  RtpsUdpSendStrategy::to_octets(out, &mb);
+
+  // Aliased, not copied
+  ASSERT_EQ(12u, out.length());
+  EXPECT_EQ(reinterpret_cast<CORBA::Octet*>(mb.rd_ptr()), out.get_buffer());
+  EXPECT_FALSE(out.release());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, to_octets_chain)
+{
+  ACE_Message_Block first(4);
+  first.copy("abcd", 4);
+  ACE_Message_Block second(4);
+  second.copy("efgh", 4);
+  first.cont(&second);
+
+  DDS::OctetSeq out;
+  RtpsUdpSendStrategy::to_octets(out, &first);
+  first.cont(0);
+
+  ASSERT_EQ(8u, out.length());
+  EXPECT_TRUE(out.release());
+  EXPECT_EQ(0, std::memcmp(out.get_buffer(), "abcdefgh", 8));
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifdef OPENDDS_HAS_CXX11
+
+#include <dds/rtpsrelaylib/ForwardingTable.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace RtpsRelay;
+
+namespace {
+  OpenDDS::DCPS::GUID_t make_guid(unsigned char id)
+  {
+    OpenDDS::DCPS::GUID_t guid = make_part_guid(OpenDDS::DCPS::GUID_UNKNOWN);
+    guid.guidPrefix[0] = id;
+    guid.guidPrefix[11] = id;
+    return guid;
+  }
+
+  ForwardingTable::AddrList make_addrs(u_short port, size_t count)
+  {
+    ForwardingTable::AddrList addrs;
+    for (size_t i = 0; i != count; ++i) {
+      addrs.push_back(ACE_INET_Addr(port, "127.0.0.1"));
+    }
+    return addrs;
+  }
+}
+
+TEST(tools_dds_rtpsrelaylib_ForwardingTable, set_lookup_remove)
+{
+  ForwardingTable table;
+  const auto guid = make_guid(1);
+
+  EXPECT_FALSE(table.lookup(guid, DATA));
+
+  table.set(guid, DATA, make_addrs(7400, 2));
+  table.set(guid, SPDP, make_addrs(7401, 1));
+  const auto data = table.lookup(guid, DATA);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(2u, data->size());
+  EXPECT_EQ(7400, data->front().get_port_number());
+  EXPECT_FALSE(table.lookup(guid, SEDP));
+  EXPECT_EQ(1u, table.size());
+
+  // Removing the data addresses keeps the SPDP addresses.
+  table.set(guid, DATA, ForwardingTable::AddrList());
+  EXPECT_FALSE(table.lookup(guid, DATA));
+  EXPECT_TRUE(table.lookup(guid, SPDP));
+
+  // A list that was looked up stays valid.
+  table.remove(guid);
+  EXPECT_FALSE(table.lookup(guid, SPDP));
+  EXPECT_EQ(0u, table.size());
+  EXPECT_EQ(2u, data->size());
+}
+
+TEST(tools_dds_rtpsrelaylib_ForwardingTable, concurrent_forwarding)
+{
+  static const unsigned char PARTICIPANTS = 64;
+  static const int FORWARDERS = 4;
+  static const int ROUNDS = 2000;
+
+  ForwardingTable table;
+  for (unsigned char i = 0; i != PARTICIPANTS; ++i) {
+    table.set(make_guid(i), DATA, make_addrs(static_cast<u_short>(7000 + i), 1));
+  }
+
+  std::atomic<bool> done(false);
+  std::atomic<size_t> bad(0);
+  std::atomic<size_t> forwarded(0);
+
+  // Participants change addresses and come and go while data is forwarded.
+  std::thread updater([&]() {
+      for (int round = 0; round != ROUNDS; ++round) {
+        const unsigned char i = static_cast<unsigned char>(round % PARTICIPANTS);
+        const auto guid = make_guid(i);
+        if (round % 3 == 0) {
+          table.remove(guid);
+        } else {
+          table.set(guid, DATA, make_addrs(static_cast<u_short>(7000 + i), 1 + round % 4));
+        }
+      }
+      done = true;
+    });
+
+  std::vector<std::thread> forwarders;
+  for (int t = 0; t != FORWARDERS; ++t) {
+    forwarders.push_back(std::thread([&]() {
+          do {
+            for (unsigned char i = 0; i != PARTICIPANTS; ++i) {
+              const auto addrs = table.lookup(make_guid(i), DATA);
+              if (!addrs) {
+                continue;
+              }
+              // Each list is a consistent snapshot of one participant.
+              if (addrs->empty() || addrs->size() > 4) {
+                ++bad;
+              }
+              for (const auto& addr : *addrs) {
+                if (addr.get_port_number() != 7000 + i) {
+                  ++bad;
+                }
+                ++forwarded;
+              }
+            }
+          } while (!done);
+        }));
+  }
+
+  updater.join();
+  for (auto& f : forwarders) {
+    f.join();
+  }
+
+  EXPECT_EQ(0u, bad.load());
+  EXPECT_LT(0u, forwarded.load());
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef OPENDDS_RTPSRELAYLIB_FORWARDING_TABLE_H
+#define OPENDDS_RTPSRELAYLIB_FORWARDING_TABLE_H
+
+#include "Utility.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace RtpsRelay {
+
+/// Read-mostly copy of the addresses of each local participant used to
+/// forward messages.
+///
+/// The table is sharded by GUID prefix hash and each entry holds immutable
+/// address lists, so a lookup only takes its shard lock long enough to copy
+/// a shared_ptr.  Threads forwarding to different participants don't contend
+/// and none of them need the lock of the table that owns the addresses.
+class ForwardingTable {
+public:
+  typedef std::vector<ACE_INET_Addr> AddrList;
+  typedef std::shared_ptr<const AddrList> AddrListPtr;
+
+  static const size_t SHARDS = 16;
+
+  /// Replace the addresses of guid for port.  An empty list removes them.
+  void set(const OpenDDS::DCPS::GUID_t& guid, Port port, const AddrList& addrs)
+  {
+    const AddrListPtr list = addrs.empty() ? AddrListPtr() : std::make_shared<const AddrList>(addrs);
+    Shard& s = shard(guid);
+    ACE_GUARD(ACE_Thread_Mutex, g, s.mutex);
+    if (list) {
+      s.map[guid][port] = list;
+      return;
+    }
+    const auto pos = s.map.find(guid);
+    if (pos == s.map.end()) {
+      return;
+    }
+    pos->second[port].reset();
+    for (const auto& p : pos->second) {
+      if (p) {
+        return;
+      }
+    }
+    s.map.erase(pos);
+  }
+
+  void remove(const OpenDDS::DCPS::GUID_t& guid)
+  {
+    Shard& s = shard(guid);
+    ACE_GUARD(ACE_Thread_Mutex, g, s.mutex);
+    s.map.erase(guid);
+  }
+
+  /// Addresses of guid for port or null if there are none.  The list stays
+  /// valid after the table changes.
+  AddrListPtr lookup(const OpenDDS::DCPS::GUID_t& guid, Port port) const
+  {
+    Shard& s = shard(guid);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, s.mutex, AddrListPtr());
+    const auto pos = s.map.find(guid);
+    return pos == s.map.end() ? AddrListPtr() : pos->second[port];
+  }
+
+  size_t size() const
+  {
+    size_t total = 0;
+    for (const auto& s : shards_) {
+      ACE_GUARD_RETURN(ACE_Thread_Mutex, g, s.mutex, total);
+      total += s.map.size();
+    }
+    return total;
+  }
+
+private:
+  // Indexed by Port.
+  typedef std::array<AddrListPtr, 3> PortAddrs;
+  typedef std::unordered_map<OpenDDS::DCPS::GUID_t, PortAddrs, GuidHash> Map;
+
+  struct Shard {
+    mutable ACE_Thread_Mutex mutex;
+    Map map;
+  };
+
+  mutable Shard shards_[SHARDS];
+
+  Shard& shard(const OpenDDS::DCPS::GUID_t& guid) const
+  {
+    return shards_[GuidHash()(guid) % SHARDS];
+  }
+};
+
+}
+
+#endif // OPENDDS_RTPSRELAYLIB_FORWARDING_TABLE_H
@@ -34,6 +34,7 @@ public:
     , restart_detection_(false)
     , admission_control_queue_size_(0)
     , max_ips_per_client_(0)
+    , data_threads_(1)
   {}
 
   void relay_id(const std::string& value)
@@ -316,6 +317,16 @@ public:
     rejected_address_duration_ = value;
   }
 
+  void data_threads(size_t value)
+  {
+    data_threads_ = value;
+  }
+
+  size_t data_threads() const
+  {
+    return data_threads_;
+  }
+
 private:
   std::string relay_id_;
   OpenDDS::DCPS::GUID_t application_participant_guid_;
@@ -345,6 +356,7 @@ private:
   OpenDDS::DCPS::TimeDuration run_time_;
   size_t max_ips_per_client_;
   OpenDDS::DCPS::TimeDuration rejected_address_duration_;
+  size_t data_threads_;
 };
 
 }
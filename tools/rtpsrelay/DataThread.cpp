@@ -0,0 +1,78 @@
+#include "DataThread.h"
+
+#include <dds/DCPS/Service_Participant.h>
+
+#include <ace/Select_Reactor.h>
+#include <ace/Thread.h>
+
+namespace RtpsRelay {
+
+DataThread::DataThread(const Config& config,
+                       size_t index,
+                       const ACE_INET_Addr& horizontal_address,
+                       const GuidPartitionTable& guid_partition_table,
+                       const RelayPartitionTable& relay_partition_table,
+                       GuidAddrSet& guid_addr_set,
+                       const OpenDDS::RTPS::RtpsDiscovery_rch& rtps_discovery,
+                       const DDS::Security::CryptoTransform_var& crypto,
+                       HandlerStatisticsReporter& stats_reporter,
+                       HorizontalHandler* horizontal_handler)
+  : thread_name_("RtpsRelay Data " + std::to_string(index))
+  , reactor_(new ACE_Select_Reactor, true)
+  // Messages received here are also queued by the horizontal handler on the main thread.
+  , handler_(config, VDATA, horizontal_address, &reactor_, guid_partition_table, relay_partition_table, guid_addr_set,
+             rtps_discovery, crypto, stats_reporter, OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy::Use_Lock)
+{
+  handler_.horizontal_handler(horizontal_handler);
+}
+
+int DataThread::open_socket(const ACE_INET_Addr& address)
+{
+  return handler_.open(address, true);
+}
+
+int DataThread::start()
+{
+  if (activate(THR_NEW_LWP | THR_JOINABLE, 1) != 0) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataThread::start Failed to activate %C\n", thread_name_.c_str()));
+    return -1;
+  }
+
+  return 0;
+}
+
+void DataThread::stop()
+{
+  reactor_.end_reactor_event_loop();
+
+  OpenDDS::DCPS::ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
+  OpenDDS::DCPS::ThreadStatusManager::Sleeper s(thread_status_manager);
+  wait();
+
+  handler_.stop();
+}
+
+int DataThread::svc()
+{
+  reactor_.owner(ACE_Thread::self());
+
+  OpenDDS::DCPS::ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
+  if (thread_status_manager.update_thread_status()) {
+    // Report like the main thread so RelayThreadMonitor sees each data thread's utilization.
+    OpenDDS::DCPS::ThreadStatusManager::Start s(thread_status_manager, thread_name_);
+
+    while (!reactor_.reactor_event_loop_done()) {
+      ACE_Time_Value t = thread_status_manager.thread_status_interval().value();
+      OpenDDS::DCPS::ThreadStatusManager::Sleeper sleeper(thread_status_manager);
+      if (reactor_.run_reactor_event_loop(t, 0) != 0) {
+        break;
+      }
+    }
+  } else {
+    reactor_.run_reactor_event_loop();
+  }
+
+  return 0;
+}
+
+}
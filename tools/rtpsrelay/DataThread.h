@@ -0,0 +1,43 @@
+#ifndef RTPSRELAY_DATA_THREAD_H_
+#define RTPSRELAY_DATA_THREAD_H_
+
+#include "RelayHandler.h"
+
+#include <ace/Reactor.h>
+#include <ace/Task.h>
+
+#include <string>
+
+namespace RtpsRelay {
+
+// Runs an additional vertical data handler with its own reactor and thread.
+// All data threads bind the same address with SO_REUSEPORT so the kernel
+// distributes clients across them.
+class DataThread : public ACE_Task_Base {
+public:
+  DataThread(const Config& config,
+             size_t index,
+             const ACE_INET_Addr& horizontal_address,
+             const GuidPartitionTable& guid_partition_table,
+             const RelayPartitionTable& relay_partition_table,
+             GuidAddrSet& guid_addr_set,
+             const OpenDDS::RTPS::RtpsDiscovery_rch& rtps_discovery,
+             const DDS::Security::CryptoTransform_var& crypto,
+             HandlerStatisticsReporter& stats_reporter,
+             HorizontalHandler* horizontal_handler);
+
+  int open_socket(const ACE_INET_Addr& address);
+  int start();
+  void stop();
+
+private:
+  int svc() override;
+
+  const std::string thread_name_;
+  ACE_Reactor reactor_;
+  DataHandler handler_;
+};
+
+}
+
+#endif // RTPSRELAY_DATA_THREAD_H_
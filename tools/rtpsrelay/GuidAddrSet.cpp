@@ -85,6 +85,7 @@ GuidAddrSet::record_activity(const AddrPort& remote_address,
                  admission_control_queue_.size()));
     }
     relay_stats_reporter_.new_address(now);
+    update_forwarding(src_guid, addr_set_stats, remote_address.port);
     const GuidAddr ga(src_guid, remote_address);
     expiration_guid_addr_queue_.push_back(std::make_pair(expiration, ga));
   }
@@ -153,6 +154,7 @@ void GuidAddrSet::process_expirations(const OpenDDS::DCPS::MonotonicTimePoint& n
     bool ip_now_unused = false;
     OpenDDS::DCPS::MonotonicTimePoint updated_expiration;
     if (addr_stats.remove_if_expired(ga.address, now, ip_now_unused, updated_expiration)) {
+      update_forwarding(ga.guid, addr_stats, ga.address.port);
       if (ip_now_unused) {
         const auto remote_iter = remote_map_.find(Remote(ga.address.addr, ga.guid));
         if (remote_iter != remote_map_.end() && OpenDDS::DCPS::equal_guid_prefixes(remote_iter->second, ga.guid)) {
@@ -278,6 +280,7 @@ void GuidAddrSet::remove(const OpenDDS::DCPS::GUID_t& guid,
   }
 
   guid_addr_set_map_.erase(it);
+  forwarding_table_.remove(guid);
   relay_stats_reporter_.local_active_participants(guid_addr_set_map_.size(), now);
 
   if (config_.log_activity()) {
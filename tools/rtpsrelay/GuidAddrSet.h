@@ -5,6 +5,7 @@
 #include "RelayStatisticsReporter.h"
 #include "RelayThreadMonitor.h"
 
+#include <dds/rtpsrelaylib/ForwardingTable.h>
 #include <dds/rtpsrelaylib/Utility.h>
 
 #include <dds/DCPS/TimeTypes.h>
@@ -269,6 +270,12 @@ public:
     data_vertical_handler_ = data_vertical_handler;
   }
 
+  /// Addresses for forwarding.  Safe to use without a Proxy.
+  const ForwardingTable& forwarding_table() const
+  {
+    return forwarding_table_;
+  }
+
   using CreatedAddrSetStats = std::pair<bool, AddrSetStats&>;
 
   class Proxy {
@@ -421,6 +428,15 @@ private:
 
   bool check_address(const ACE_INET_Addr& addr);
 
+  void update_forwarding(const OpenDDS::DCPS::GUID_t& guid,
+                         const AddrSetStats& addr_set_stats,
+                         Port port)
+  {
+    ForwardingTable::AddrList addrs;
+    addr_set_stats.foreach_addr(port, [&addrs](const ACE_INET_Addr& addr) { addrs.push_back(addr); });
+    forwarding_table_.set(guid, port, addrs);
+  }
+
   OpenDDS::DCPS::TimeDuration get_session_time(const OpenDDS::DCPS::GUID_t& guid,
                                                const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
@@ -461,6 +477,8 @@ private:
   RejectedAddressMapType rejected_address_map_;
   typedef std::list<RejectedAddressMapType::iterator> RejectedAddressExpirationQueue;
   RejectedAddressExpirationQueue rejected_address_expiration_queue_;
+  // Updated under mutex_ whenever the addresses in guid_addr_set_map_ change.
+  ForwardingTable forwarding_table_;
   mutable ACE_Thread_Mutex mutex_;
 };
 
@@ -78,29 +78,37 @@ public:
   // Look up the partitions for the participant from.
   void lookup(StringSet& partitions, const OpenDDS::DCPS::GUID_t& from) const
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-
     // Match on the prefix.
     const OpenDDS::DCPS::GUID_t prefix = make_id(from, OpenDDS::DCPS::ENTITYID_UNKNOWN);
+    CacheShard& shard = cache_shard(prefix);
 
-    const auto p = guid_to_partitions_cache_.find(prefix);
-    if (p != guid_to_partitions_cache_.end()) {
-      partitions.insert(p->second.begin(), p->second.end());
-      return;
+    {
+      // Hits only take the shard lock so that data threads don't contend on mutex_.
+      ACE_GUARD(ACE_Thread_Mutex, g, shard.mutex);
+      const auto p = shard.cache.find(prefix);
+      if (p != shard.cache.end()) {
+        partitions.insert(p->second.begin(), p->second.end());
+        return;
+      }
     }
 
-    auto& c = guid_to_partitions_cache_[prefix];
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
 
+    StringSet c;
     for (auto pos = guid_to_partitions_.lower_bound(prefix), limit = guid_to_partitions_.end();
          pos != limit && std::memcmp(pos->first.guidPrefix, prefix.guidPrefix, sizeof(prefix.guidPrefix)) == 0; ++pos) {
-      partitions.insert(pos->second.begin(), pos->second.end());
       c.insert(pos->second.begin(), pos->second.end());
     }
 
     if (!config_.allow_empty_partition()) {
-      partitions.erase("");
       c.erase("");
     }
+
+    partitions.insert(c.begin(), c.end());
+
+    // Lock order is mutex_ then the shard.
+    ACE_GUARD(ACE_Thread_Mutex, g2, shard.mutex);
+    shard.cache[prefix].swap(c);
   }
 
   /// Add to 'guids' the GUIDs of participants that should receive messages based on 'partitions'.
@@ -123,7 +131,9 @@ private:
   {
     // Invalidate the cache.
     const OpenDDS::DCPS::GUID_t prefix = make_id(guid, OpenDDS::DCPS::ENTITYID_UNKNOWN);
-    guid_to_partitions_cache_.erase(prefix);
+    CacheShard& shard = cache_shard(prefix);
+    ACE_GUARD(ACE_Thread_Mutex, g, shard.mutex);
+    shard.cache.erase(prefix);
   }
 
   void populate_replay(SpdpReplay& spdp_replay,
@@ -257,7 +267,17 @@ private:
   typedef std::map<OpenDDS::DCPS::GUID_t, StringSet, OpenDDS::DCPS::GUID_tKeyLessThan> GuidToPartitions;
   GuidToPartitions guid_to_partitions_;
   typedef std::unordered_map<OpenDDS::DCPS::GUID_t, StringSet, GuidHash> GuidToPartitionsCache;
-  mutable GuidToPartitionsCache guid_to_partitions_cache_;
+  struct CacheShard {
+    ACE_Thread_Mutex mutex;
+    GuidToPartitionsCache cache;
+  };
+  static const size_t CACHE_SHARDS = 16;
+  mutable CacheShard guid_to_partitions_cache_[CACHE_SHARDS];
+
+  CacheShard& cache_shard(const OpenDDS::DCPS::GUID_t& prefix) const
+  {
+    return guid_to_partitions_cache_[GuidHash()(prefix) % CACHE_SHARDS];
+  }
 
   typedef std::set<OpenDDS::DCPS::GUID_t, OpenDDS::DCPS::GUID_tKeyLessThan> OrderedGuidSet;
   typedef std::unordered_map<std::string, OrderedGuidSet> PartitionToGuid;
@@ -9,6 +9,8 @@
 
 #include <dds/DCPS/JsonValueWriter.h>
 
+#include <ace/Thread_Mutex.h>
+
 namespace RtpsRelay {
 
 class HandlerStatisticsReporter {
@@ -34,6 +36,7 @@ public:
                      const OpenDDS::DCPS::MonotonicTimePoint& now,
                      MessageType type)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.input_message(byte_count, time, now, type);
     log_helper_.input_message(log_handler_statistics_, byte_count, time, type);
     publish_helper_.input_message(publish_handler_statistics_, byte_count, time, type);
@@ -44,6 +47,7 @@ public:
                        const OpenDDS::DCPS::MonotonicTimePoint& now,
                        MessageType type)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.ignored_message(byte_count, now, type);
     log_helper_.ignored_message(log_handler_statistics_, byte_count, type);
     publish_helper_.ignored_message(publish_handler_statistics_, byte_count, type);
@@ -56,6 +60,7 @@ public:
                       const OpenDDS::DCPS::MonotonicTimePoint& now,
                       MessageType type)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.output_message(byte_count, time, queue_latency, now, type);
     log_helper_.output_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.output_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
@@ -68,6 +73,7 @@ public:
                        const OpenDDS::DCPS::MonotonicTimePoint& now,
                        MessageType type)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.dropped_message(byte_count, time, queue_latency, now, type);
     log_helper_.dropped_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.dropped_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
@@ -76,6 +82,7 @@ public:
 
   void max_gain(size_t value, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.max_gain(value, now);
     log_helper_.max_gain(log_handler_statistics_, value);
     publish_helper_.max_gain(publish_handler_statistics_, value);
@@ -84,6 +91,7 @@ public:
 
   void error(const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.error(now);
     log_helper_.error(log_handler_statistics_);
     publish_helper_.error(publish_handler_statistics_);
@@ -92,6 +100,7 @@ public:
 
   void max_queue_size(size_t size, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     relay_statistics_reporter_.max_queue_size(size, now);
     log_helper_.max_queue_size(log_handler_statistics_, size);
     publish_helper_.max_queue_size(publish_handler_statistics_, size);
@@ -100,6 +109,7 @@ public:
 
   void report()
   {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
     report(OpenDDS::DCPS::MonotonicTimePoint::now(), true);
   }
 
@@ -154,6 +164,9 @@ private:
   HandlerStatisticsDataWriter_var writer_;
   CORBA::String_var topic_name_;
   RelayStatisticsReporter& relay_statistics_reporter_;
+
+  // Handlers for the same port may run on several data threads.
+  mutable ACE_Thread_Mutex mutex_;
 };
 
 }
@@ -11,6 +11,7 @@
 #include <dds/DdsDcpsGuidTypeSupportImpl.h>
 
 #include <ace/Global_Macros.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 
 #include <array>
@@ -70,9 +71,26 @@ RelayHandler::RelayHandler(const Config& config,
 {
 }
 
-int RelayHandler::open(const ACE_INET_Addr& address)
+int RelayHandler::open(const ACE_INET_Addr& address, bool reuse_port)
 {
-  if (socket_.open(address) != 0) {
+  if (reuse_port) {
+    // Several data threads bind the same address and the kernel spreads clients across them.
+#ifdef SO_REUSEPORT
+    int one = 1;
+    if (socket_.ACE_SOCK::open(SOCK_DGRAM, address.get_type(), 0, 0) != 0 ||
+        socket_.set_option(SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0 ||
+        ACE_OS::bind(socket_.get_handle(), static_cast<sockaddr*>(address.get_addr()), address.get_size()) != 0) {
+      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RelayHandler::open %C failed to open shared socket on '%C' errno %m\n"),
+                 name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
+      socket_.close();
+      return -1;
+    }
+#else
+    ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RelayHandler::open %C SO_REUSEPORT is not supported on this platform\n"),
+               name_.c_str()));
+    return -1;
+#endif
+  } else if (socket_.open(address) != 0) {
     ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: RelayHandler::open %C failed to open socket on '%C'\n"),
                name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
     return -1;
@@ -310,32 +328,37 @@ CORBA::ULong VerticalHandler::process_message(const ACE_INET_Addr& remote_addres
       return 0;
     }
 
-    GuidAddrSet::Proxy proxy(guid_addr_set_);
-    record_activity(proxy, addr_port, now, src_guid, type, msg_len);
+    CORBA::ULong sent = 0;
+    bool normal_processing = false;
+    bool send_to_application_participant = false;
+    {
+      GuidAddrSet::Proxy proxy(guid_addr_set_);
+      record_activity(proxy, addr_port, now, src_guid, type, msg_len);
 
-    cache_message(proxy, src_guid, to, msg, now);
+      cache_message(proxy, src_guid, to, msg, now);
 
-    const bool from_application_participant =
-      (remote_address == application_participant_addr_) &&
-      (src_guid == config_.application_participant_guid());
+      const bool from_application_participant =
+        (remote_address == application_participant_addr_) &&
+        (src_guid == config_.application_participant_guid());
 
-    bool admitted = false;
-    if (proxy.ignore_rtps(from_application_participant, src_guid, now, admitted)) {
-      stats_reporter_.ignored_message(msg_len, now, type);
-      return 0;
-    }
+      bool admitted = false;
+      if (proxy.ignore_rtps(from_application_participant, src_guid, now, admitted)) {
+        stats_reporter_.ignored_message(msg_len, now, type);
+        return 0;
+      }
 
-    CORBA::ULong sent = 0;
+      if (admitted && spdp_handler_) {
+        sent += spdp_handler_->send_to_application_participant(proxy, src_guid, now);
+      }
 
-    if (admitted && spdp_handler_) {
-      sent += spdp_handler_->send_to_application_participant(proxy, src_guid, now);
+      normal_processing = do_normal_processing(proxy, remote_address, src_guid, to, admitted, send_to_application_participant, msg, now, sent);
     }
 
-    bool send_to_application_participant = false;
-    if (do_normal_processing(proxy, remote_address, src_guid, to, admitted, send_to_application_participant, msg, now, sent)) {
+    if (normal_processing) {
+      // Forward without the GuidAddrSet lock so that data threads don't serialize.
       StringSet to_partitions;
       guid_partition_table_.lookup(to_partitions, src_guid);
-      sent += send(proxy, src_guid, to_partitions, to, send_to_application_participant, msg, now);
+      sent += forward(src_guid, to_partitions, to, send_to_application_participant, msg, now);
     }
     return sent;
   } else {
@@ -627,6 +650,87 @@ CORBA::ULong VerticalHandler::send(GuidAddrSet::Proxy& proxy,
   return sent;
 }
 
+CORBA::ULong VerticalHandler::forward(const OpenDDS::DCPS::GUID_t& src_guid,
+                                      const StringSet& to_partitions,
+                                      const GuidSet& to_guids,
+                                      bool send_to_application_participant,
+                                      const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                                      const OpenDDS::DCPS::MonotonicTimePoint& now)
+{
+  AddressSet address_set;
+  populate_address_set(address_set, to_partitions);
+  const auto type = MessageType::Rtps;
+
+  CORBA::ULong sent = 0;
+  GuidVec recipients;
+  for (const auto& addr : address_set) {
+    if (addr != horizontal_address_) {
+      horizontal_handler_->enqueue_message(addr, to_partitions, to_guids, msg, now);
+      ++sent;
+    } else {
+      // Local recipients.
+      GuidSet guids;
+      guid_partition_table_.lookup(guids, to_partitions, to_guids);
+      for (const auto& guid : guids) {
+        if (guid == src_guid) {
+          continue;
+        }
+        sent += forward_to(guid, msg, now, recipients);
+      }
+    }
+  }
+
+  if (send_to_application_participant) {
+    enqueue_message(application_participant_addr_, msg, now, type);
+    ++sent;
+  }
+
+  record_output(recipients, send_to_application_participant, msg->length(), now);
+
+  return sent;
+}
+
+CORBA::ULong VerticalHandler::forward_to(const OpenDDS::DCPS::GUID_t& guid,
+                                         const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                                         const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                         GuidVec& recipients)
+{
+  const auto addrs = guid_addr_set_.forwarding_table().lookup(guid, port());
+  if (!addrs) {
+    return 0;
+  }
+
+  for (const auto& addr : *addrs) {
+    enqueue_message(addr, msg, now, MessageType::Rtps);
+    recipients.push_back(guid);
+  }
+  return static_cast<CORBA::ULong>(addrs->size());
+}
+
+void VerticalHandler::record_output(const GuidVec& recipients,
+                                    bool to_application_participant,
+                                    size_t length,
+                                    const OpenDDS::DCPS::MonotonicTimePoint& now)
+{
+  if (recipients.empty() && !to_application_participant) {
+    return;
+  }
+
+  const auto type = MessageType::Rtps;
+  GuidAddrSet::Proxy proxy(guid_addr_set_);
+  for (const auto& guid : recipients) {
+    // The participant may have been removed while forwarding.
+    const auto p = proxy.find(guid);
+    if (p != proxy.end()) {
+      p->second.select_stats_reporter(port())->output_message(length, type);
+    }
+  }
+
+  if (to_application_participant) {
+    proxy.participant_statistics_reporter(config_.application_participant_guid(), now, port()).output_message(length, type);
+  }
+}
+
 size_t VerticalHandler::send(const ACE_INET_Addr& addr,
                              OpenDDS::STUN::Message message,
                              const OpenDDS::DCPS::MonotonicTimePoint& now)
@@ -719,24 +823,16 @@ CORBA::ULong HorizontalHandler::process_message(const ACE_INET_Addr& from,
 
   msg->rd_ptr(size_before_header - size_after_header);
 
-  GuidAddrSet::Proxy proxy(vertical_handler_->guid_addr_set());
-
   CORBA::ULong sent = 0;
 
   GuidSet guids;
   const auto to_guids = relay_guids_to_set(relay_header.to_guids());
   guid_partition_table_.lookup(guids, relay_header.to_partitions(), to_guids);
+  VerticalHandler::GuidVec recipients;
   for (const auto& guid : guids) {
-    const auto p = proxy.find(guid);
-    if (p != proxy.end()) {
-      p->second.foreach_addr(port(),
-                             [=, &sent, &msg](const ACE_INET_Addr& addr) {
-                               vertical_handler_->venqueue_message(addr,
-                                                                   *p->second.select_stats_reporter(port()), msg, now, type);
-                               ++sent;
-                             });
-    }
+    sent += vertical_handler_->forward_to(guid, msg, now, recipients);
   }
+  vertical_handler_->record_output(recipients, false, msg->length(), now);
 
   return sent;
 }
@@ -1085,8 +1181,9 @@ DataHandler::DataHandler(const Config& config,
                          GuidAddrSet& guid_addr_set,
                          const OpenDDS::RTPS::RtpsDiscovery_rch& rtps_discovery,
                          const DDS::Security::CryptoTransform_var& crypto,
-                         HandlerStatisticsReporter& stats_reporter)
-: VerticalHandler(config, name, DATA, address, reactor, guid_partition_table, relay_partition_table, guid_addr_set, rtps_discovery, crypto, ACE_INET_Addr(), stats_reporter)
+                         HandlerStatisticsReporter& stats_reporter,
+                         OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy message_block_locking)
+: VerticalHandler(config, name, DATA, address, reactor, guid_partition_table, relay_partition_table, guid_addr_set, rtps_discovery, crypto, ACE_INET_Addr(), stats_reporter, message_block_locking)
 {}
 
 }
@@ -27,7 +27,7 @@ namespace RtpsRelay {
 
 class RelayHandler : public ACE_Event_Handler {
 public:
-  int open(const ACE_INET_Addr& address);
+  int open(const ACE_INET_Addr& address, bool reuse_port = false);
 
   const std::string& name() const { return name_; }
 
@@ -123,6 +123,22 @@ public:
                         const OpenDDS::DCPS::MonotonicTimePoint& now,
                         MessageType type);
 
+  typedef std::vector<OpenDDS::DCPS::GUID_t> GuidVec;
+
+  /// Enqueue msg to each address of the local participant guid using the
+  /// forwarding table, so no GuidAddrSet::Proxy is needed.  guid is added to
+  /// recipients once per address.
+  CORBA::ULong forward_to(const OpenDDS::DCPS::GUID_t& guid,
+                          const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                          const OpenDDS::DCPS::MonotonicTimePoint& now,
+                          GuidVec& recipients);
+
+  /// Count the messages enqueued by forward_to in the participant statistics.
+  void record_output(const GuidVec& recipients,
+                     bool to_application_participant,
+                     size_t length,
+                     const OpenDDS::DCPS::MonotonicTimePoint& now);
+
 protected:
   virtual void cache_message(GuidAddrSet::Proxy& /*proxy*/,
                              const OpenDDS::DCPS::GUID_t& /*src_guid*/,
@@ -160,6 +176,14 @@ protected:
                     const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
                     const OpenDDS::DCPS::MonotonicTimePoint& now);
 
+  /// Like send but without a GuidAddrSet::Proxy held.
+  CORBA::ULong forward(const OpenDDS::DCPS::GUID_t& src_guid,
+                       const StringSet& to_partitions,
+                       const GuidSet& to_guids,
+                       bool send_to_application_participant,
+                       const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                       const OpenDDS::DCPS::MonotonicTimePoint& now);
+
   size_t send(const ACE_INET_Addr& addr,
               OpenDDS::STUN::Message message,
               const OpenDDS::DCPS::MonotonicTimePoint& now);
@@ -297,7 +321,8 @@ public:
               GuidAddrSet& guid_addr_set,
               const OpenDDS::RTPS::RtpsDiscovery_rch& rtps_discovery,
               const DDS::Security::CryptoTransform_var& crypto,
-              HandlerStatisticsReporter& stats_reporter);
+              HandlerStatisticsReporter& stats_reporter,
+              OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy message_block_locking = OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy::No_Lock);
 };
 
 }
@@ -5,6 +5,7 @@
  * See: http://www.opendds.org/license.html
  */
 
+#include "DataThread.h"
 #include "GuidPartitionTable.h"
 #include "ParticipantListener.h"
 #include "ParticipantStatisticsReporter.h"
@@ -42,6 +43,8 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 using namespace RtpsRelay;
 
@@ -212,6 +215,9 @@ int run(int argc, ACE_TCHAR* argv[])
     } else if ((arg = args.get_the_parameter("-RejectedAddressDuration"))) {
       config.rejected_address_duration(OpenDDS::DCPS::TimeDuration(ACE_OS::atoi(arg)));
       args.consume_arg();
+    } else if ((arg = args.get_the_parameter("-DataThreads"))) {
+      config.data_threads(static_cast<size_t>(std::max(1, ACE_OS::atoi(arg))));
+      args.consume_arg();
     } else if ((arg = args.get_the_parameter("-IdentityCA"))) {
       identity_ca_file = file + arg;
       secure = true;
@@ -756,6 +762,12 @@ int run(int argc, ACE_TCHAR* argv[])
   spdp_vertical_handler.spdp_handler(&spdp_vertical_handler);
   sedp_vertical_handler.spdp_handler(&spdp_vertical_handler);
 
+  // Additional data handlers share the vertical data address and run on their own threads.
+  std::vector<std::unique_ptr<DataThread>> data_threads;
+  for (size_t idx = 1; idx < config.data_threads(); ++idx) {
+    data_threads.emplace_back(new DataThread(config, idx, data_horizontal_addr, guid_partition_table, relay_partition_table, guid_addr_set, rtps_discovery, crypto, data_vertical_reporter, &data_horizontal_handler));
+  }
+
   DDS::Subscriber_var bit_subscriber = application_participant->get_builtin_subscriber();
 
   DDS::DataReader_var thread_status_reader_var = bit_subscriber->lookup_datareader(OpenDDS::DCPS::BUILT_IN_INTERNAL_THREAD_TOPIC);
@@ -857,17 +869,24 @@ int run(int argc, ACE_TCHAR* argv[])
       data_horizontal_handler.open(data_horizontal_addr) == -1 ||
       spdp_vertical_handler.open(spdp_vertical_addr) == -1 ||
       sedp_vertical_handler.open(sedp_vertical_addr) == -1 ||
-      data_vertical_handler.open(data_vertical_addr) == -1) {
+      data_vertical_handler.open(data_vertical_addr, !data_threads.empty()) == -1) {
     return EXIT_FAILURE;
   }
 
+  for (const auto& data_thread : data_threads) {
+    if (data_thread->open_socket(data_vertical_addr) == -1 ||
+        data_thread->start() == -1) {
+      return EXIT_FAILURE;
+    }
+  }
+
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: Application Participant GUID %C\n"), OpenDDS::DCPS::LogGuid(config.application_participant_guid()).c_str()));
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: SPDP Horizontal listening on %C\n"), OpenDDS::DCPS::LogAddr(spdp_horizontal_addr).c_str()));
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: SEDP Horizontal listening on %C\n"), OpenDDS::DCPS::LogAddr(sedp_horizontal_addr).c_str()));
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: Data Horizontal listening on %C\n"), OpenDDS::DCPS::LogAddr(data_horizontal_addr).c_str()));
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: SPDP Vertical listening on %C\n"), OpenDDS::DCPS::LogAddr(spdp_vertical_addr).c_str()));
   ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: SEDP Vertical listening on %C\n"), OpenDDS::DCPS::LogAddr(sedp_vertical_addr).c_str()));
-  ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: Data Vertical listening on %C\n"), OpenDDS::DCPS::LogAddr(data_vertical_addr).c_str()));
+  ACE_DEBUG((LM_INFO, ACE_TEXT("(%P|%t) INFO: Data Vertical listening on %C with %B thread(s)\n"), OpenDDS::DCPS::LogAddr(data_vertical_addr).c_str(), config.data_threads()));
 
   // Write about the relay.
   DDS::DataWriterListener_var relay_address_writer_listener =
@@ -976,6 +995,10 @@ int run(int argc, ACE_TCHAR* argv[])
     reactor->run_reactor_event_loop();
   }
 
+  for (const auto& data_thread : data_threads) {
+    data_thread->stop();
+  }
+
   application_participant->delete_contained_entities();
   factory->delete_participant(application_participant);
 